@@ -1 +1 @@
-APP_DEPS := com_util
+APP_DEPS := com_util struct-meta
@@ -4,7 +4,8 @@ OUTPUT_DIR := $(MYAPP_DIR)/prod/cbin
 # ライブラリの指定
 # systemd / Windows SCM から起動できるように、実行時ライブラリは prod/cbin へ同梱する。
 # see: app/com_util/docs/link-policy.md
-LIBS += com_util
+# struct_meta は設定の読み込みと版の公開 (struct_meta_snapshot) に使う。
+LIBS += com_util struct_meta
 ifdef PLATFORM_LINUX
     LDFLAGS += -Wl,-z,origin -Wl,-rpath,'$$ORIGIN'
 endif
@@ -6,19 +6,157 @@
  *  @date           2026/06/09
  *  @version        1.0.0
  *
- *  サービス定義と、ライフサイクル コールバックを実装します。
+ *  サービス定義と、ライフサイクル コールバックを実装します。\n
+ *  設定は struct_meta の版 (struct_meta_snapshot) として公開します。
+ *  on_reload は新しい版を読み込んで公開し、on_run は周期ごとに pin した版をロックなしで参照します。
  *
  *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
  *
  *******************************************************************************
  */
 
+#include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
+#include <com_util/base/result.h>
 #include <com_util/crt/stdio.h>
+#include <com_util/runtime/process.h>
+
+#include <struct_meta/snapshot/snapshot.h>
 
 #include "service-sample.h"
 
+/* ============================================================
+ *  設定
+ * ============================================================ */
+
+/** 設定ファイルの名前。実行ファイルと同じディレクトリから読み込む。 */
+#define CONFIG_FILE_NAME "service-sample.json"
+
+/** 設定ファイルのパスの最大長。 */
+#define CONFIG_PATH_MAX 4096
+
+/** 周期処理の既定の間隔 (ミリ秒)。 */
+#define CONFIG_DEFAULT_INTERVAL_MS 1000
+
+/** 設定の版を参照する読み手の数。on_run のスレッドだけが参照する。 */
+#define CONFIG_READER_CAPACITY 1U
+
+/** 設定ファイル (CONFIG_FILE_NAME) から読み込む設定。 */
+typedef struct svc_sample_config
+{
+    int interval_ms;  /**< 周期処理の間隔 (ミリ秒)。0 以下の場合は既定値を使う。 */
+    char message[64]; /**< 状態テキストへ出力する文言。 */
+} svc_sample_config;
+
+/** svc_sample_config のフィールド。 */
+static const struct_meta_field s_config_fields[] = {
+    {"interval_ms", STRUCT_META_FIELD_INT, STRUCT_META_STORAGE_INLINE, offsetof(svc_sample_config, interval_ms),
+     sizeof(int), 1, 0, NULL, "周期処理の間隔 (ミリ秒)", NULL, 0},
+    {"message", STRUCT_META_FIELD_CHAR_ARRAY, STRUCT_META_STORAGE_INLINE, offsetof(svc_sample_config, message),
+     sizeof(char), 1, sizeof(((svc_sample_config *)NULL)->message), NULL, "状態テキストへ出力する文言", NULL, 0},
+};
+
+/** svc_sample_config の記述子。 */
+static const struct_meta_descriptor s_config_descriptor = {
+    "svc_sample_config", sizeof(svc_sample_config), s_config_fields,
+    sizeof(s_config_fields) / sizeof(s_config_fields[0]), NULL};
+
+/** 公開中の設定の版。on_start で初期化し、on_stop で解放する。 */
+static struct_meta_snapshot s_config;
+/** s_config を初期化済みかどうか。1 = 初期化済み。on_start / on_stop / on_reload だけが参照する。 */
+static int s_config_ready = 0;
+/** 設定ファイルのパス。 */
+static char s_config_path[CONFIG_PATH_MAX];
+
+/**
+ *  @brief          設定ファイルのパスを、実行ファイルと同じディレクトリの CONFIG_FILE_NAME に決定します。
+ *  @return         成功時は 0、失敗時は 0 以外を返します。
+ */
+static int config_resolve_path(void)
+{
+    char exec_path[CONFIG_PATH_MAX];
+    const char *separator;
+    const char *backslash;
+    int written;
+
+    if (com_util_process_get_executable_path(exec_path, sizeof(exec_path)) != COM_UTIL_OK)
+    {
+        return -1;
+    }
+    /* Windows のパスは '\\' と '/' のどちらも区切りになり得るため、後ろにある方を採る */
+    separator = strrchr(exec_path, '/');
+    backslash = strrchr(exec_path, '\\');
+    if (backslash != NULL && (separator == NULL || backslash > separator))
+    {
+        separator = backslash;
+    }
+    if (separator == NULL)
+    {
+        return -1;
+    }
+    written = com_util_snprintf(s_config_path, sizeof(s_config_path), "%.*s%s",
+                                (int)(separator - exec_path + 1), exec_path, CONFIG_FILE_NAME);
+    if (written < 0 || (size_t)written >= sizeof(s_config_path))
+    {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ *  @brief          既定値の設定を新しい版として公開します。
+ *  @return         成功時は COM_UTIL_OK、失敗時はエラー コードを返します。
+ */
+static int config_publish_default(void)
+{
+    svc_sample_config *config;
+    int ret;
+
+    config = (svc_sample_config *)calloc(1U, sizeof(*config));
+    if (config == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    config->interval_ms = CONFIG_DEFAULT_INTERVAL_MS;
+    (void)com_util_snprintf(config->message, sizeof(config->message), "%s", "動作中");
+    ret = struct_meta_snapshot_publish(&s_config, config);
+    if (ret != COM_UTIL_OK)
+    {
+        free(config);
+    }
+    return ret;
+}
+
+/**
+ *  @brief          設定ファイルを読み込み、新しい版として公開します。
+ *  @return         成功時は COM_UTIL_OK、失敗時はエラー コードを返します。失敗した場合、公開中の版は変わりません。
+ */
+static int config_load(void)
+{
+    int ret;
+
+    if (s_config_path[0] == '\0')
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    ret = struct_meta_snapshot_load_file(&s_config, s_config_path);
+    if (ret == COM_UTIL_OK)
+    {
+        com_util_tracer_writef(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_INFO, NULL,
+                               "設定ファイルを読み込みました (%s、回収待ちの旧版: %zu 個)。", s_config_path,
+                               s_config.retired_count);
+    }
+    else
+    {
+        com_util_tracer_writef(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_WARNING, NULL,
+                               "設定ファイルを読み込めませんでした (%s、結果: %d)。", s_config_path, ret);
+    }
+    return ret;
+}
+
 /* ============================================================
  *  サービス コールバック
  * ============================================================ */
@@ -33,6 +171,27 @@ static int on_start(void *user_data)
     (void)user_data;
     com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_INFO, NULL, "起動処理 開始");
     /* TODO: ここに初期化処理を書く */
+
+    /* 設定の版を用意する。設定ファイルを読み込めない場合は既定値で動作する。 */
+    if (struct_meta_snapshot_init(&s_config, &s_config_descriptor, CONFIG_READER_CAPACITY) != COM_UTIL_OK)
+    {
+        com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_ERROR, NULL, "設定の初期化に失敗しました。");
+        return 1;
+    }
+    if (config_resolve_path() != 0)
+    {
+        s_config_path[0] = '\0';
+        com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_WARNING, NULL,
+                              "設定ファイルのパスを決定できませんでした。");
+    }
+    if (config_load() != COM_UTIL_OK && config_publish_default() != COM_UTIL_OK)
+    {
+        com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_ERROR, NULL, "設定の公開に失敗しました。");
+        struct_meta_snapshot_dispose(&s_config);
+        return 1;
+    }
+    s_config_ready = 1;
+
     com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_INFO, NULL, "起動処理 終了");
     return 0;
 }
@@ -40,32 +199,50 @@ static int on_start(void *user_data)
 /**
  *  @brief          サービス メイン ループの雛形。
  *  @param[in]      user_data 未使用。
- *  @return         成功時は 0、失敗時は 0 以外を返します。この雛形では失敗する処理がないため 0 固定で返します。
+ *  @return         成功時は 0、失敗時は 0 以外を返します。設定の読み手を確保できない場合は失敗します。
  *
- *  1 秒ごとに動作ログを出力し、停止要求を受け取るとループを抜けます。\n
+ *  設定の間隔ごとに動作ログを出力し、停止要求を受け取るとループを抜けます。\n
+ *  周期ごとに設定の版を pin して参照し、参照を終えたら unpin します。
+ *  on_reload が公開した新しい版は、次の周期から使われます。\n
  *  svc_set_status_text() による状態テキスト通知の利用例を含みます。
  */
 static int on_run(void *user_data)
 {
-    char status_text[64];
+    char status_text[128];
     unsigned long cycle_count;
+    int interval_ms;
+    struct_meta_snapshot_reader *reader;
+    const svc_sample_config *config;
 
     (void)user_data;
+    if (struct_meta_snapshot_reader_attach(&s_config, &reader) != COM_UTIL_OK)
+    {
+        com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_ERROR, NULL, "設定の読み手を確保できません。");
+        return 1;
+    }
     com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_INFO, NULL,
                           "動作中です。Ctrl+C または停止コマンドで終了します。");
 
     com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_INFO, NULL, "サービス処理 開始");
     cycle_count = 0;
-    while (svc_wait_for_stop(1000) == 0)
+    interval_ms = CONFIG_DEFAULT_INTERVAL_MS;
+    while (svc_wait_for_stop(interval_ms) == 0)
     {
         /* TODO: ここに周期処理を書く (現状は何もしない雛形) */
         com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_VERBOSE, NULL, "動作中...");
 
+        /* pin から unpin までの間は、再読込で置き換えられても同じ版を参照できる */
+        config = (const svc_sample_config *)struct_meta_snapshot_pin(reader);
+        interval_ms = (config->interval_ms > 0) ? config->interval_ms : CONFIG_DEFAULT_INTERVAL_MS;
+
         /* 状態テキストの通知例 (Linux では systemctl status に表示される) */
         cycle_count++;
-        (void)com_util_snprintf(status_text, sizeof(status_text), "動作中 (周期処理 %lu 回目)", cycle_count);
+        (void)com_util_snprintf(status_text, sizeof(status_text), "%s (周期処理 %lu 回目)", config->message,
+                                cycle_count);
+        struct_meta_snapshot_unpin(reader);
         svc_set_status_text(status_text);
     }
+    struct_meta_snapshot_reader_detach(reader);
     com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_INFO, NULL, "サービス処理 終了");
     return 0;
 }
@@ -74,12 +251,16 @@ static int on_run(void *user_data)
  *  @brief          サービス停止処理の雛形。
  *  @param[in]      user_data 未使用。
  *  @return         成功時は 0、失敗時は 0 以外を返します。この雛形では失敗する処理がないため 0 固定で返します。
+ *
+ *  on_run が読み手を返却した後に呼ばれるため、公開中の版と回収待ちの旧版をまとめて解放します。
  */
 static int on_stop(void *user_data)
 {
     (void)user_data;
     com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_INFO, NULL, "停止処理 開始");
     /* TODO: ここに停止処理を書く */
+    s_config_ready = 0;
+    struct_meta_snapshot_dispose(&s_config);
     com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_INFO, NULL, "停止処理 終了");
     return 0;
 }
@@ -131,13 +312,26 @@ static void on_event(const svc_event_info *info, void *user_data)
  *  @brief          設定再読込処理の雛形。
  *  @param[in]      user_data   未使用。
  *
- *  on_run() とは別のスレッドから呼ばれます。短時間で戻るように実装します。
+ *  on_run() とは別のスレッドから呼ばれます。短時間で戻るように実装します。\n
+ *  設定ファイルを新しい版として読み込み、公開中の版と置き換えます。on_run() を待たずに戻り、
+ *  on_run() が pin している旧版は unpin の後の再読込または on_stop() で解放されます。\n
+ *  on_start() / on_stop() とは並行して呼ばれないため、版の書き込みは直列化されています。
  */
 static void on_reload(void *user_data)
 {
     (void)user_data;
     com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_INFO, NULL, "設定再読込 開始");
     /* TODO: ここに設定再読込処理を書く */
+    if (s_config_ready == 0)
+    {
+        /* Linux では on_start より前や on_stop より後にも SIGHUP を受け付ける */
+        com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_WARNING, NULL,
+                              "起動処理の前または停止処理の後のため、設定を再読込しません。");
+    }
+    else
+    {
+        (void)config_load();
+    }
     com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_INFO, NULL, "設定再読込 終了");
 }
 
@@ -110,6 +110,8 @@ static int s_stop_requested = 0;
 static com_util_local_lock *s_stop_lock = NULL;
 /** 停止要求を on_run に通知するための条件変数。 */
 static com_util_condvar *s_stop_cv = NULL;
+/** on_start / on_stop と on_reload が並行して動かないように直列化するミューテックス。 */
+static com_util_local_lock *s_lifecycle_lock = NULL;
 
 void svc_request_stop(void)
 {
@@ -178,6 +180,26 @@ void svc_set_status_text(const char *text)
 
 /* Doxygen コメントは、ヘッダーに記載 */
 
+void svc_lifecycle_lock(void)
+{
+    if (s_lifecycle_lock != NULL)
+    {
+        com_util_local_lock_lock(s_lifecycle_lock, COM_UTIL_SYNC_WAIT_FOREVER);
+    }
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void svc_lifecycle_unlock(void)
+{
+    if (s_lifecycle_lock != NULL)
+    {
+        com_util_local_lock_unlock(s_lifecycle_lock);
+    }
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
 void svc_dispatch_event(const svc_definition *def, const svc_event_info *info)
 {
     if (def == NULL || info == NULL || def->on_event == NULL)
@@ -197,7 +219,9 @@ void svc_dispatch_reload(const svc_definition *def)
     }
     com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_INFO, NULL, "設定再読込要求を配送します。");
     svc_os_notify_reloading();
+    svc_lifecycle_lock();
     def->on_reload(def->user_data);
+    svc_lifecycle_unlock();
     svc_os_notify_ready();
 }
 
@@ -237,7 +261,9 @@ int svc_run_lifecycle(const svc_definition *def)
     rc = EXIT_SUCCESS;
     if (def->on_start != NULL)
     {
+        svc_lifecycle_lock();
         rc = def->on_start(def->user_data);
+        svc_lifecycle_unlock();
         if (rc != EXIT_SUCCESS)
         {
             com_util_tracer_writef(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_ERROR, NULL,
@@ -265,7 +291,9 @@ int svc_run_lifecycle(const svc_definition *def)
         stop_rc = EXIT_SUCCESS;
         if (def->on_stop != NULL)
         {
+            svc_lifecycle_lock();
             stop_rc = def->on_stop(def->user_data);
+            svc_lifecycle_unlock();
             if (stop_rc != EXIT_SUCCESS)
             {
                 com_util_tracer_writef(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_ERROR, NULL,
@@ -367,6 +395,17 @@ int main(int argc, char *argv[])
         tracer_close();
         return EXIT_FAILURE;
     }
+    if (com_util_local_lock_create(&s_lifecycle_lock) != COM_UTIL_OK)
+    {
+        com_util_tracer_write(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_ERROR, NULL,
+                              "ミューテックスの生成に失敗しました。");
+        com_util_condvar_dispose(s_stop_cv);
+        s_stop_cv = NULL;
+        com_util_local_lock_dispose(s_stop_lock);
+        s_stop_lock = NULL;
+        tracer_close();
+        return EXIT_FAILURE;
+    }
 
     int rc = EXIT_FAILURE;
 
@@ -387,6 +426,8 @@ int main(int argc, char *argv[])
         rc = svc_run_lifecycle(&g_service_def);
     }
 
+    com_util_local_lock_dispose(s_lifecycle_lock);
+    s_lifecycle_lock = NULL;
     com_util_condvar_dispose(s_stop_cv);
     s_stop_cv = NULL;
     com_util_local_lock_dispose(s_stop_lock);
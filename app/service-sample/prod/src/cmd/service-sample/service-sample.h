@@ -163,7 +163,9 @@ extern "C"
      *  Linux では呼び出しの前後で RELOADING=1 / READY=1 の通知を
      *  フレームワーク側が自動で行います。\n
      *  on_run() とは別のスレッドから呼ばれるため、共有データへの
-     *  アクセスには同期が必要です。短時間で戻るように実装してください。
+     *  アクセスには同期が必要です。短時間で戻るように実装してください。\n
+     *  on_start() / on_stop() とは並行して呼ばれません。ただし Linux では SIGHUP を
+     *  on_start() より前や on_stop() より後にも受け付けるため、初期化の有無を確認してください。
      *
      *  @param[in]      user_data   svc_definition に登録した任意ポインター。
      */
@@ -409,10 +411,25 @@ extern "C"
      *  各プラットフォーム ファイルが再読込要求を検出したときに呼びます。\n
      *  def->on_reload が NULL の場合は何もしません。\n
      *  svc_os_notify_reloading() → on_reload() → svc_os_notify_ready() の順に
-     *  呼び出し、Type=notify の reload 契約 (RELOADING=1 → READY=1) を満たします。
+     *  呼び出し、Type=notify の reload 契約 (RELOADING=1 → READY=1) を満たします。\n
+     *  on_reload() は svc_lifecycle_lock() で on_start() / on_stop() と直列化して呼びます。
      */
     void svc_dispatch_reload(const svc_definition *def);
 
+    /**
+     *  @brief          on_start / on_stop / on_reload の呼び出しを直列化するロックを取得します (内部共有関数)。
+     *
+     *  svc_run_lifecycle() と Windows の ServiceMain が on_start() / on_stop() の前後で、
+     *  svc_dispatch_reload() が on_reload() の前後で呼びます。\n
+     *  main() がミューテックスを生成する前は何もしません。
+     */
+    void svc_lifecycle_lock(void);
+
+    /**
+     *  @brief          svc_lifecycle_lock() で取得したロックを解放します (内部共有関数)。
+     */
+    void svc_lifecycle_unlock(void);
+
     /**
      *  @brief          サービス共通の tracer ハンドルを取得します (内部共有関数)。
      *  @return         process-global の tracer ハンドル。\n
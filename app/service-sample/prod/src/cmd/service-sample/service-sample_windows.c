@@ -398,7 +398,9 @@ static VOID WINAPI service_main(DWORD argc, LPWSTR *argv)
     /* on_start を呼ぶ */
     if (s_def->on_start != NULL)
     {
+        svc_lifecycle_lock();
         rc = s_def->on_start(s_def->user_data);
+        svc_lifecycle_unlock();
         if (rc != 0)
         {
             com_util_tracer_writef(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_ERROR, NULL,
@@ -427,7 +429,9 @@ static VOID WINAPI service_main(DWORD argc, LPWSTR *argv)
     {
         int stop_rc;
 
+        svc_lifecycle_lock();
         stop_rc = s_def->on_stop(s_def->user_data);
+        svc_lifecycle_unlock();
         if (stop_rc != 0)
         {
             com_util_tracer_writef(svc_get_tracer(), COM_UTIL_TRACE_LEVEL_ERROR, NULL,
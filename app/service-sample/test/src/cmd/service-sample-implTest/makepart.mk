@@ -0,0 +1,11 @@
+# テスト対象のソース ファイル
+TEST_SRCS := \
+	$(MYAPP_DIR)/prod/src/cmd/service-sample/service-sample-impl.c
+
+# テスト対象ソースのローカル ヘッダーを参照する
+INCDIR += \
+	$(MYAPP_DIR)/prod/src/cmd/service-sample
+
+# ライブラリの指定
+# 設定の版 (struct_meta_snapshot) は実装をそのまま使う。
+LIBS += mock_com_util mock_libc struct_meta
@@ -0,0 +1,138 @@
+#include <testfw.h>
+#include <mock_com_util.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "service-sample.h"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::NiceMock;
+using testing::Return;
+
+/* ============================================================
+ *  記録用の内部状態
+ * ============================================================ */
+
+/** svc_set_status_text() に渡されたテキストを記録する。 */
+static std::vector<std::string> g_status_texts;
+/** svc_wait_for_stop() が停止要求なし (0) を返す残り回数 (テストごとに設定する)。 */
+static int g_cycles_before_stop = 0;
+
+/* ============================================================
+ *  共通処理スタブ (service-sample.c の代替)
+ * ============================================================ */
+
+extern "C"
+{
+    extern const svc_definition g_service_def;
+
+    com_util_tracer *svc_get_tracer(void)
+    {
+        return NULL;
+    }
+
+    int svc_wait_for_stop(int timeout_ms)
+    {
+        (void)timeout_ms;
+        if (g_cycles_before_stop > 0)
+        {
+            g_cycles_before_stop--;
+            return 0;
+        }
+        return 1;
+    }
+
+    void svc_set_status_text(const char *text)
+    {
+        g_status_texts.push_back(text);
+    }
+}
+
+/* ============================================================
+ *  テスト フィクスチャ
+ * ============================================================ */
+
+class service_sample_implTest : public Test
+{
+  protected:
+    NiceMock<Mock_com_util> mock_com_util_;
+
+    void SetUp() override
+    {
+        g_status_texts.clear();
+        g_cycles_before_stop = 0;
+
+        ON_CALL(mock_com_util_, com_util_tracer_write_at(_, _, _, _)).WillByDefault(Return(0));
+        ON_CALL(mock_com_util_, com_util_tracer_writef_at(_, _, _, _)).WillByDefault(Return(0));
+        /* 警告の回数だけを各テストで検証するため、他のレベルの出力は回数を問わない */
+        EXPECT_CALL(mock_com_util_, com_util_tracer_write_at(_, _, _, _)).Times(AnyNumber());
+        /* 設定ファイルのパスを決定できない状態とし、既定値の設定で起動させる */
+        ON_CALL(mock_com_util_, com_util_process_get_executable_path(_, _))
+            .WillByDefault(Return(COM_UTIL_ERR_INVALID_ARGUMENT));
+    }
+};
+
+/* ============================================================
+ *  on_reload のテスト
+ * ============================================================ */
+
+// on_start より前の on_reload が設定を再読込せずに警告だけを出すことの確認
+TEST_F(service_sample_implTest, reload_before_on_start_is_skipped)
+{
+    // Arrange
+    // [状態] - on_start を呼んでいない (設定の版が未初期化の) 状態とする。
+
+    // Pre-Assert
+    EXPECT_CALL(mock_com_util_, com_util_tracer_write_at(_, COM_UTIL_TRACE_LEVEL_WARNING, _, _))
+        .Times(1); // [Pre-Assert確認_異常系] - 再読込しない旨の警告を 1 回だけ出すこと。
+
+    // Act
+    g_service_def.on_reload(g_service_def.user_data); // [手順] - on_start より前に on_reload を呼び出す。
+
+    // Assert
+    // [確認_異常系] - 未初期化の版へ触れずに戻ること (ASan / 警告回数で確認する)。
+}
+
+// on_stop より後の on_reload が、解放済みの設定を再読込せずに警告だけを出すことの確認
+TEST_F(service_sample_implTest, reload_after_on_stop_is_skipped)
+{
+    // Arrange
+    ASSERT_EQ(0, g_service_def.on_start(g_service_def.user_data)); // [状態] - 起動処理を済ませる。
+    ASSERT_EQ(0, g_service_def.on_stop(g_service_def.user_data));  // [状態] - 停止処理で設定の版を解放する。
+
+    // Pre-Assert
+    EXPECT_CALL(mock_com_util_, com_util_tracer_write_at(_, COM_UTIL_TRACE_LEVEL_WARNING, _, _))
+        .Times(1); // [Pre-Assert確認_異常系] - 再読込しない旨の警告を 1 回だけ出すこと。
+
+    // Act
+    g_service_def.on_reload(g_service_def.user_data); // [手順] - on_stop より後に on_reload を呼び出す。
+
+    // Assert
+    // [確認_異常系] - 解放済みの版へ触れずに戻ること (ASan / 警告回数で確認する)。
+}
+
+// on_start と on_stop の間の on_reload が警告を出さず、公開中の設定を保つことの確認
+TEST_F(service_sample_implTest, reload_while_running_keeps_config)
+{
+    // Arrange
+    g_cycles_before_stop = 1;                                      // [状態] - on_run の周期処理を 1 回だけ行う。
+    ASSERT_EQ(0, g_service_def.on_start(g_service_def.user_data)); // [状態] - 既定値の設定で起動する。
+
+    // Pre-Assert
+    EXPECT_CALL(mock_com_util_, com_util_tracer_write_at(_, COM_UTIL_TRACE_LEVEL_WARNING, _, _))
+        .Times(0); // [Pre-Assert確認_正常系] - 起動済みのため、再読込を省く警告を出さないこと。
+
+    // Act
+    g_service_def.on_reload(g_service_def.user_data);         // [手順] - 起動中に on_reload を呼び出す。
+    int run_ret = g_service_def.on_run(g_service_def.user_data); // [手順] - on_run で設定を参照する。
+    int stop_ret = g_service_def.on_stop(g_service_def.user_data);
+
+    // Assert
+    EXPECT_EQ(0, run_ret);  // [確認_正常系] - on_run が成功すること。
+    EXPECT_EQ(0, stop_ret); // [確認_正常系] - on_stop が成功すること。
+    ASSERT_EQ(1U, g_status_texts.size());
+    EXPECT_EQ("動作中 (周期処理 1 回目)", g_status_texts[0]); // [確認_正常系] - 公開中の既定値の設定が参照されること。
+}
@@ -9,8 +9,13 @@
 #include "service-sample.h"
 
 using testing::_;
+using testing::AnyNumber;
+using testing::DoAll;
+using testing::InSequence;
+using testing::MockFunction;
 using testing::NiceMock;
 using testing::Return;
+using testing::SetArgPointee;
 
 /* ============================================================
  *  記録用の内部状態
@@ -30,6 +35,19 @@ static int g_on_start_rc = 0;
 static int g_on_run_rc = 0;
 /** on_stop の戻り値 (テストごとに設定する)。 */
 static int g_on_stop_rc = 0;
+/** 1 の場合、on_run の中から svc_dispatch_reload() を呼ぶ (テストごとに設定する)。 */
+static int g_reload_in_run = 0;
+/** コールバックの呼び出しをロック操作と同じ順序で検証するためのチェックポイント。NULL の場合は使わない。 */
+static MockFunction<void(std::string)> *g_checkpoint = nullptr;
+
+/** チェックポイントへコールバック名を通知する。 */
+static void checkpoint(const char *name)
+{
+    if (g_checkpoint != nullptr)
+    {
+        g_checkpoint->Call(name);
+    }
+}
 
 /* ============================================================
  *  サービス コールバック スタブ
@@ -37,10 +55,13 @@ static int g_on_stop_rc = 0;
 
 extern "C"
 {
+    extern const svc_definition g_service_def;
+
     static int test_on_start(void *user_data)
     {
         (void)user_data;
         g_calls.push_back("on_start");
+        checkpoint("on_start");
         return g_on_start_rc;
     }
 
@@ -48,6 +69,11 @@ extern "C"
     {
         (void)user_data;
         g_calls.push_back("on_run");
+        checkpoint("on_run");
+        if (g_reload_in_run != 0)
+        {
+            svc_dispatch_reload(&g_service_def);
+        }
         return g_on_run_rc;
     }
 
@@ -55,6 +81,7 @@ extern "C"
     {
         (void)user_data;
         g_calls.push_back("on_stop");
+        checkpoint("on_stop");
         return g_on_stop_rc;
     }
 
@@ -77,13 +104,13 @@ extern "C"
     {
         (void)user_data;
         g_calls.push_back("on_reload");
+        checkpoint("on_reload");
     }
 
     /* ============================================================
      *  サービス定義 (service-sample.c の main() が参照する)
      * ============================================================ */
 
-    extern const svc_definition g_service_def;
     const svc_definition g_service_def = {"service-sample-test",
                                           "Service Sample Test",
                                           "service-sample の単体テスト用定義です。",
@@ -150,6 +177,10 @@ class service_sampleTest : public Test
   protected:
     NiceMock<Mock_com_util> mock_com_util_;
     com_util_tracer *tracer_handle_ = reinterpret_cast<com_util_tracer *>(static_cast<uintptr_t>(0x1234));
+    com_util_local_lock *stop_lock_handle_ = reinterpret_cast<com_util_local_lock *>(static_cast<uintptr_t>(0x2345));
+    com_util_condvar *stop_cv_handle_ = reinterpret_cast<com_util_condvar *>(static_cast<uintptr_t>(0x3456));
+    com_util_local_lock *lifecycle_lock_handle_ =
+        reinterpret_cast<com_util_local_lock *>(static_cast<uintptr_t>(0x4567));
 
     void SetUp() override
     {
@@ -160,6 +191,8 @@ class service_sampleTest : public Test
         g_on_start_rc = 0;
         g_on_run_rc = 0;
         g_on_stop_rc = 0;
+        g_reload_in_run = 0;
+        g_checkpoint = nullptr;
 
         ON_CALL(mock_com_util_, com_util_tracer_create(COM_UTIL_TRACER_CONCURRENCY_TRACER_MANAGED))
             .WillByDefault(Return(tracer_handle_));
@@ -172,6 +205,25 @@ class service_sampleTest : public Test
         ON_CALL(mock_com_util_, com_util_tracer_dispose(_)).WillByDefault(Return());
         ON_CALL(mock_com_util_, com_util_tracer_write_at(_, _, _, _)).WillByDefault(Return(0));
         ON_CALL(mock_com_util_, com_util_tracer_writef_at(_, _, _, _)).WillByDefault(Return(0));
+
+        /* 停止抽象とライフサイクルのロックを実際に生成した状態で main() を動かす (NULL のままでは素通りになる) */
+        ON_CALL(mock_com_util_, com_util_local_lock_create(_))
+            .WillByDefault(DoAll(SetArgPointee<0>(stop_lock_handle_), Return(COM_UTIL_OK)));
+        ON_CALL(mock_com_util_, com_util_condvar_create(_))
+            .WillByDefault(DoAll(SetArgPointee<0>(stop_cv_handle_), Return(COM_UTIL_OK)));
+    }
+
+    void TearDown() override
+    {
+        g_checkpoint = nullptr;
+    }
+
+    /** 1 回目の生成で停止抽象のロックを、2 回目の生成でライフサイクルのロックを返すように設定する。 */
+    void expect_lock_creation()
+    {
+        EXPECT_CALL(mock_com_util_, com_util_local_lock_create(_))
+            .WillOnce(DoAll(SetArgPointee<0>(stop_lock_handle_), Return(COM_UTIL_OK)))
+            .WillOnce(DoAll(SetArgPointee<0>(lifecycle_lock_handle_), Return(COM_UTIL_OK)));
     }
 };
 
@@ -387,6 +439,72 @@ TEST_F(service_sampleTest, console_on_stop_failure)
     ASSERT_EQ(5U, g_calls.size()); // [確認_異常系] - ライフサイクル全体が実行されること。
 }
 
+// on_start / on_reload / on_stop がライフサイクルのロックの内側で呼ばれることの確認
+TEST_F(service_sampleTest, console_lifecycle_lock_order)
+{
+    // Arrange
+    MockFunction<void(std::string)> callback;
+    g_checkpoint = &callback;
+    g_reload_in_run = 1; // [状態] - on_run の中から設定再読込を配送する。
+    int argc = 2;
+    const char *argv[] = {"service-sampleTest", "console"};
+    expect_lock_creation(); // [状態] - 停止抽象とライフサイクルに別のロックを生成させる。
+
+    // Pre-Assert
+    EXPECT_CALL(mock_com_util_, com_util_local_lock_lock(_, _)).Times(AnyNumber());
+    EXPECT_CALL(mock_com_util_, com_util_local_lock_unlock(_)).Times(AnyNumber());
+    {
+        InSequence sequence;
+        EXPECT_CALL(mock_com_util_, com_util_local_lock_lock(lifecycle_lock_handle_, _));
+        EXPECT_CALL(callback, Call("on_start")); // [Pre-Assert確認_正常系] - on_start をロックの内側で呼ぶこと。
+        EXPECT_CALL(mock_com_util_, com_util_local_lock_unlock(lifecycle_lock_handle_));
+        EXPECT_CALL(callback, Call("on_run")); // [Pre-Assert確認_正常系] - on_run はロックの外側で呼ぶこと。
+        EXPECT_CALL(mock_com_util_, com_util_local_lock_lock(lifecycle_lock_handle_, _));
+        EXPECT_CALL(callback, Call("on_reload")); // [Pre-Assert確認_正常系] - on_reload をロックの内側で呼ぶこと。
+        EXPECT_CALL(mock_com_util_, com_util_local_lock_unlock(lifecycle_lock_handle_));
+        EXPECT_CALL(mock_com_util_, com_util_local_lock_lock(lifecycle_lock_handle_, _));
+        EXPECT_CALL(callback, Call("on_stop")); // [Pre-Assert確認_正常系] - on_stop をロックの内側で呼ぶこと。
+        EXPECT_CALL(mock_com_util_, com_util_local_lock_unlock(lifecycle_lock_handle_));
+    }
+    EXPECT_CALL(mock_com_util_, com_util_local_lock_dispose(_)).Times(AnyNumber());
+    EXPECT_CALL(mock_com_util_, com_util_local_lock_dispose(lifecycle_lock_handle_))
+        .Times(1); // [Pre-Assert確認_正常系] - 終了時にライフサイクルのロックを解放すること。
+
+    // Act
+    int actual_ret = __real_main(argc, (char **)&argv); // [手順] - main() に引数を与えて呼び出す。
+
+    // Assert
+    EXPECT_EQ(EXIT_SUCCESS, actual_ret); // [確認_正常系] - main() の戻り値が EXIT_SUCCESS であること。
+}
+
+// ライフサイクルのロックを生成できない場合に、生成済みの資源を解放して失敗終了することの確認
+TEST_F(service_sampleTest, lifecycle_lock_create_failure)
+{
+    // Arrange
+    int argc = 2;
+    const char *argv[] = {"service-sampleTest", "console"};
+    EXPECT_CALL(mock_com_util_, com_util_local_lock_create(_))
+        .WillOnce(DoAll(SetArgPointee<0>(stop_lock_handle_), Return(COM_UTIL_OK)))
+        .WillOnce(Return(COM_UTIL_ERR_OUT_OF_MEMORY)); // [状態] - 2 回目のロック生成だけを失敗させる。
+
+    // Pre-Assert
+    EXPECT_CALL(mock_com_util_, com_util_condvar_dispose(stop_cv_handle_))
+        .Times(1); // [Pre-Assert確認_異常系] - 生成済みの条件変数を解放すること。
+    EXPECT_CALL(mock_com_util_, com_util_local_lock_dispose(stop_lock_handle_))
+        .Times(1); // [Pre-Assert確認_異常系] - 生成済みの停止抽象のロックを解放すること。
+
+    // Act
+    int actual_ret = __real_main(argc, (char **)&argv); // [手順] - main() に引数を与えて呼び出す。
+
+    // Assert
+    EXPECT_EQ(EXIT_FAILURE, actual_ret); // [確認_異常系] - main() の戻り値が EXIT_FAILURE であること。
+    EXPECT_TRUE(g_calls.empty());        // [確認_異常系] - OS フックもコールバックも呼ばれないこと。
+
+    // [確認_異常系] - 失敗の後も停止抽象が未初期化の状態へ戻っていること。
+    EXPECT_EQ(0, svc_stop_requested());
+    EXPECT_EQ(1, svc_wait_for_stop(10));
+}
+
 /* ============================================================
  *  svc_dispatch_event のテスト
  * ============================================================ */
@@ -489,6 +607,33 @@ TEST_F(service_sampleTest, dispatch_reload_null_safety)
     EXPECT_TRUE(g_calls.empty()); // [確認_異常系] - コールバックも通知も行われないこと。
 }
 
+// main() の外 (on_start より前と on_stop より後) では、ロックを取らずに設定再読込を配送することの確認
+TEST_F(service_sampleTest, dispatch_reload_outside_lifecycle)
+{
+    // Arrange
+    int argc = 2;
+    const char *argv[] = {"service-sampleTest", "console"}; // [状態] - 1 回目の配送は main() より前に行う。
+
+    // Pre-Assert
+    EXPECT_CALL(mock_com_util_, com_util_local_lock_lock(_, _))
+        .Times(0); // [Pre-Assert確認_正常系] - ロックの生成前はロック操作を行わないこと。
+
+    // Act
+    svc_dispatch_reload(&g_service_def); // [手順] - on_start より前に svc_dispatch_reload() を呼び出す。
+    testing::Mock::VerifyAndClearExpectations(&mock_com_util_);
+    (void)__real_main(argc, (char **)&argv); // [手順] - ライフサイクルを一巡させる。
+    size_t calls_after_lifecycle = g_calls.size();
+    EXPECT_CALL(mock_com_util_, com_util_local_lock_lock(_, _))
+        .Times(0); // [Pre-Assert確認_正常系] - ロックの解放後はロック操作を行わないこと。
+    svc_dispatch_reload(&g_service_def); // [手順] - on_stop より後に svc_dispatch_reload() を呼び出す。
+
+    // Assert
+    ASSERT_EQ(3U + 5U + 3U, g_calls.size());
+    EXPECT_EQ("on_reload", g_calls[1]); // [確認_正常系] - on_start より前の on_reload が呼ばれること。
+    EXPECT_EQ("on_start", g_calls[3]);  // [確認_正常系] - 再読込の後にライフサイクルが始まること。
+    EXPECT_EQ("on_reload", g_calls[calls_after_lifecycle + 1U]); // [確認_正常系] - on_stop より後も呼ばれること。
+}
+
 /* ============================================================
  *  svc_set_status_text のテスト
  * ============================================================ */
@@ -11,6 +11,8 @@
 #ifndef STRUCT_META_ACCESS_H
 #define STRUCT_META_ACCESS_H
 
+#include <stdint.h>
+
 #include <struct_meta/meta/meta.h>
 
 /**
@@ -34,24 +36,102 @@ extern "C"
     /** @brief 属性を検索します。@param[in] field フィールドです。@param[in] key 属性キーです。@param[out] attribute_out 取得結果です。@return 結果コードです。@par スレッド セーフ 共有状態を変更しません。 */
     STRUCT_META_EXPORT int STRUCT_META_API struct_meta_field_find_attribute(
         const struct_meta_field *field, const char *key, const struct_meta_attribute **attribute_out);
-    /** @brief 配列要素を取得します。@param[in] field フィールドです。@param[in,out] instance 親構造体です。@param[in] index 添字です。@param[out] element_out 取得結果です。@return 結果コードです。@par スレッド セーフ 同じインスタンスを並行変更しない場合に限ります。 */
+    /** @brief 配列要素を取得します。可変長配列では count を上限として items の要素を返します。@param[in] field フィールドです。@param[in,out] instance 親構造体です。@param[in] index 添字です。@param[out] element_out 取得結果です。@return 結果コードです。@par スレッド セーフ 同じインスタンスを並行変更しない場合に限ります。 */
     STRUCT_META_EXPORT int STRUCT_META_API struct_meta_field_get_element(const struct_meta_field *field, void *instance,
                                                                          size_t index, void **element_out);
-    /** @brief 読み取り専用の配列要素を取得します。@param[in] field フィールドです。@param[in] instance 親構造体です。@param[in] index 添字です。@param[out] element_out 取得結果です。@return 結果コードです。@par スレッド セーフ 同じインスタンスを並行変更しない場合に限ります。 */
+    /** @brief 読み取り専用の配列要素を取得します。可変長配列では count を上限として items の要素を返します。@param[in] field フィールドです。@param[in] instance 親構造体です。@param[in] index 添字です。@param[out] element_out 取得結果です。@return 結果コードです。@par スレッド セーフ 同じインスタンスを並行変更しない場合に限ります。 */
     STRUCT_META_EXPORT int STRUCT_META_API struct_meta_field_get_const_element(const struct_meta_field *field,
                                                                                const void *instance, size_t index,
                                                                                const void **element_out);
-    /** @brief パスを変更可能な値へ解決します。@param[in] descriptor 記述子です。@param[in,out] instance 構造体です。@param[in] path パスです。@param[out] field_out 終端フィールドです。@param[out] value_out 終端値です。@return 結果コードです。@par スレッド セーフ 同じインスタンスを並行変更しない場合に限ります。 */
+    /** @brief パスを変更可能な値へ解決します。可変長配列の添字は count を上限とし、超える場合は @c COM_UTIL_ERR_OUT_OF_RANGE です。@param[in] descriptor 記述子です。@param[in,out] instance 構造体です。@param[in] path パスです。@param[out] field_out 終端フィールドです。@param[out] value_out 終端値です。@return 結果コードです。@par スレッド セーフ 同じインスタンスを並行変更しない場合に限ります。 */
     STRUCT_META_EXPORT int STRUCT_META_API struct_meta_path_resolve(const struct_meta_descriptor *descriptor,
                                                                     void *instance, const char *path,
                                                                     const struct_meta_field **field_out,
                                                                     void **value_out);
-    /** @brief パスを読み取り専用の値へ解決します。@param[in] descriptor 記述子です。@param[in] instance 構造体です。@param[in] path パスです。@param[out] field_out 終端フィールドです。@param[out] value_out 終端値です。@return 結果コードです。@par スレッド セーフ 同じインスタンスを並行変更しない場合に限ります。 */
+    /** @brief パスを読み取り専用の値へ解決します。可変長配列の添字は struct_meta_path_resolve() と同じく扱います。@param[in] descriptor 記述子です。@param[in] instance 構造体です。@param[in] path パスです。@param[out] field_out 終端フィールドです。@param[out] value_out 終端値です。@return 結果コードです。@par スレッド セーフ 同じインスタンスを並行変更しない場合に限ります。 */
     STRUCT_META_EXPORT int STRUCT_META_API struct_meta_path_resolve_const(const struct_meta_descriptor *descriptor,
                                                                           const void *instance, const char *path,
                                                                           const struct_meta_field **field_out,
                                                                           const void **value_out);
 
+    /**
+     *  @brief          解決済みのパスです。
+     *
+     *  struct_meta_path_compile() で一度だけ解析し、ルート構造体の先頭からのオフセットと終端フィールドを保持します。\n
+     *  動的確保を伴わないため、呼び出し側の変数や配列へそのまま格納でき、解放は不要です。
+     */
+    typedef struct struct_meta_path_handle
+    {
+        const struct_meta_descriptor *descriptor; /**< パスを解決したルートの記述子です。 */
+        const struct_meta_field *field;           /**< 終端フィールドです。 */
+        size_t offset;                            /**< ルート構造体の先頭から終端値までのバイト オフセットです。 */
+        size_t size;                              /**< 終端値のバイト数です。添字のない配列では配列全体です。 */
+        struct_meta_field_kind kind;              /**< 終端フィールドの種別です。 */
+        unsigned int pad;                         /**< 明示的アラインメントです。 */
+    } struct_meta_path_handle;
+
+    /** @brief パスを解決済みハンドルへ変換します。可変長配列の要素、文字列、可変長配列を指すパスは @c COM_UTIL_ERR_UNSUPPORTED です。@param[in] descriptor 記述子です。@param[in] path パスです。@param[out] handle_out 解決結果です。@return 結果コードです。@par スレッド セーフ 共有状態を変更しません。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_path_compile(const struct_meta_descriptor *descriptor,
+                                                                    const char *path,
+                                                                    struct_meta_path_handle *handle_out);
+    /** @brief 解決済みハンドルを変更可能な値へ適用します。@param[in] handle ハンドルです。@param[in,out] instance ハンドルの記述子が表す構造体です。@param[out] value_out 終端値です。@return 結果コードです。@par スレッド セーフ 同じインスタンスを並行変更しない場合に限ります。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_path_apply(const struct_meta_path_handle *handle,
+                                                                  void *instance, void **value_out);
+    /** @brief 解決済みハンドルを読み取り専用の値へ適用します。@param[in] handle ハンドルです。@param[in] instance ハンドルの記述子が表す構造体です。@param[out] value_out 終端値です。@return 結果コードです。@par スレッド セーフ 同じインスタンスを並行変更しない場合に限ります。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_path_apply_const(const struct_meta_path_handle *handle,
+                                                                        const void *instance,
+                                                                        const void **value_out);
+    /** @brief 解決済みハンドルを構造体配列の各要素へ適用します。@param[in] handle ハンドルです。@param[in,out] instances 構造体配列の先頭です。@param[in] count 要素数です。@param[in] stride 要素間のバイト数です。0 の場合は記述子のサイズです。より大きな構造体に埋め込まれた要素を歩く場合は、外側の構造体のサイズを指定します。@param[out] values_out 要素ごとの終端値を格納する count 個の配列です。@return 結果コードです。@par スレッド セーフ 同じインスタンスを並行変更しない場合に限ります。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_path_apply_batch(const struct_meta_path_handle *handle,
+                                                                        void *instances, size_t count, size_t stride,
+                                                                        void **values_out);
+    /**
+     *  @brief          解決済みハンドルの終端値を、符号付き 64 ビット整数として読み取ります。
+     *
+     *  終端値は整数、bool、列挙の値 1 個でなければなりません。値は double を経由せずに変換します。
+     *
+     *  @param[in]      handle ハンドルです。
+     *  @param[in]      instance ハンドルの記述子が表す構造体です。
+     *  @param[out]     value_out 値です。bool は 0 または 1 です。
+     *  @return         @c COM_UTIL_OK、@c COM_UTIL_ERR_INVALID_ARGUMENT、
+     *                  整数として扱えない終端値では @c COM_UTIL_ERR_UNSUPPORTED、
+     *                  int64_t に収まらない値では @c COM_UTIL_ERR_OUT_OF_RANGE を返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じインスタンスを並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_path_get_int64(const struct_meta_path_handle *handle,
+                                                                      const void *instance, int64_t *value_out);
+    /** @brief 終端値を符号なし 64 ビット整数として読み取ります。負の値では @c COM_UTIL_ERR_OUT_OF_RANGE を返します。その他は struct_meta_path_get_int64() と同じです。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_path_get_uint64(const struct_meta_path_handle *handle,
+                                                                       const void *instance, uint64_t *value_out);
+    /**
+     *  @brief          解決済みハンドルの終端値へ、符号付き 64 ビット整数を書き込みます。
+     *
+     *  値が終端値の型に収まらない場合は、何も書き込まずに @c COM_UTIL_ERR_OUT_OF_RANGE を返します。
+     *  bool へは 0 または 1 だけを書き込めます。
+     *
+     *  @param[in]      handle ハンドルです。
+     *  @param[in,out]  instance ハンドルの記述子が表す構造体です。
+     *  @param[in]      value 値です。
+     *  @return         struct_meta_path_get_int64() と同じ結果コードを返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じインスタンスを並行して読み書きしない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_path_set_int64(const struct_meta_path_handle *handle,
+                                                                      void *instance, int64_t value);
+    /** @brief 終端値へ符号なし 64 ビット整数を書き込みます。その他は struct_meta_path_set_int64() と同じです。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_path_set_uint64(const struct_meta_path_handle *handle,
+                                                                       void *instance, uint64_t value);
+    /** @brief 構造体配列の各要素から解決済みハンドルの終端値を集め、列へ詰めて複写します。@param[in] handle ハンドルです。@param[in] base 構造体配列の先頭です。@param[in] count 要素数です。@param[in] stride 要素間のバイト数です。0 の場合は記述子のサイズです。@param[out] column_out 終端値を handle の size バイトずつ count 個並べる列です。@return 結果コードです。@par スレッド セーフ 同じ列を並行変更しない場合に限ります。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_gather(const struct_meta_path_handle *handle, const void *base,
+                                                              size_t count, size_t stride, void *column_out);
+    /** @brief 列の値を、構造体配列の各要素の解決済みハンドルの終端値へ書き戻します。@param[in] handle ハンドルです。@param[in] column 終端値を handle の size バイトずつ count 個並べた列です。@param[in] count 要素数です。@param[in] stride 要素間のバイト数です。0 の場合は記述子のサイズです。@param[in,out] base 構造体配列の先頭です。列と重なってはなりません。@return 結果コードです。@par スレッド セーフ 同じ配列を並行変更しない場合に限ります。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_scatter(const struct_meta_path_handle *handle,
+                                                               const void *column, size_t count, size_t stride,
+                                                               void *base);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
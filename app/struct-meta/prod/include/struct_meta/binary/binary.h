@@ -0,0 +1,133 @@
+/**
+ *******************************************************************************
+ *  @file           binary.h
+ *  @brief          記述子に従って、構造体を固定長のバイナリー形式へ変換します。
+ *
+ *  1 レコードは、ヘッダーとペイロードからなります。
+ *
+ *  | オフセット | バイト数 | 内容                                                   |
+ *  | ---------: | -------: | ------------------------------------------------------ |
+ *  |          0 |        3 | マジック `SMB`                                         |
+ *  |          3 |        1 | 形式の版 (STRUCT_META_BINARY_VERSION)                  |
+ *  |          4 |        4 | ペイロードのバイト数 (リトル エンディアン)             |
+ *  |          8 |        8 | スキーマ指紋 (リトル エンディアン)                     |
+ *  |         16 |        - | ペイロード                                             |
+ *
+ *  ペイロードはフィールドを記述子の順に、パディングなしで並べます。
+ *  int と unsigned int は 4 バイト、float は IEEE 754 単精度 4 バイト、double は IEEE 754 倍精度 8 バイトの
+ *  リトル エンディアンです。固定幅整数と列挙は要素サイズのリトル エンディアン、bool は 0 または 1 の 1 バイトです。
+ *  char 配列は配列全体のバイト数をそのまま使い、NUL の後ろを 0 で埋めます。
+ *  ネストした構造体は要素ごとに同じ規則で展開します。
+ *
+ *  スキーマ指紋は、フィールド名、種別、要素サイズ、要素数、char 配列の大きさから求めます。
+ *  読み込み側は指紋が異なるデータを拒否します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_BINARY_H
+#define STRUCT_META_BINARY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <struct_meta/memory/buffer.h>
+#include <struct_meta/meta/meta.h>
+
+/**
+ *  @addtogroup STRUCT_META_PUBLIC_API
+ *  @{
+ */
+
+/** バイナリー形式の版です。 */
+#define STRUCT_META_BINARY_VERSION 1U
+
+/** ヘッダーのバイト数です。 */
+#define STRUCT_META_BINARY_HEADER_SIZE 16U
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /**
+     *  @brief          記述子のスキーマ指紋を返します。
+     *  @param[in]      descriptor 記述子です。
+     *  @param[out]     fingerprint_out スキーマ指紋です。
+     *  @return         @c COM_UTIL_OK、または struct_meta_descriptor_validate() と同じ結果コードを返します。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_binary_fingerprint(const struct_meta_descriptor *descriptor,
+                                                                          uint64_t *fingerprint_out);
+
+    /**
+     *  @brief          1 レコードのバイト数 (ヘッダーを含む) を返します。
+     *
+     *  バイト数は記述子だけで決まり、インスタンスの内容には依存しません。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[out]     size_out 1 レコードのバイト数です。
+     *  @return         @c COM_UTIL_OK、struct_meta_descriptor_validate() と同じ結果コード、
+     *                  または要素サイズがバイナリー形式の幅と異なる場合と文字列または可変長配列を含む場合は
+     *                  @c COM_UTIL_ERR_UNSUPPORTED を返します。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_binary_encoded_size(const struct_meta_descriptor *descriptor,
+                                                                           size_t *size_out);
+
+    /**
+     *  @brief          構造体をバイナリー形式へ変換し、バッファーの末尾へ追記します。
+     *
+     *  失敗した場合、バッファーの内容は呼び出し前に戻します。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      instance 構造体です。
+     *  @param[in,out]  buffer 追記先です。
+     *  @return         @c COM_UTIL_OK、struct_meta_binary_encoded_size() と同じ結果コード、
+     *                  char 配列に NUL がない場合は @c COM_UTIL_ERR_INVALID_ARGUMENT、
+     *                  または @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じバッファーを並行して使わず、同じインスタンスを並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_binary_encode(const struct_meta_descriptor *descriptor,
+                                                                     const void *instance,
+                                                                     struct_meta_buffer *buffer);
+
+    /**
+     *  @brief          バイナリー形式の 1 レコードを構造体へ書き戻します。
+     *
+     *  ヘッダー、指紋、ペイロードの長さ、char 配列の NUL 終端をすべて検査してから書き込むため、
+     *  エラーの場合は構造体を変更しません。フィールド以外の領域 (パディング) も変更しません。\n
+     *  指紋が一致し、ホストがリトル エンディアンの場合、パディングで区切られた範囲ごとの memcpy で書き戻します。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      data レコードの先頭です。
+     *  @param[in]      length @p data から読めるバイト数です。レコードより長くても構いません。
+     *  @param[out]     instance_out 書き戻し先です。
+     *  @param[out]     consumed_out 読み込んだレコードのバイト数です。不要な場合は NULL を指定します。
+     *  @return         @c COM_UTIL_OK、struct_meta_binary_encoded_size() と同じ結果コード、
+     *                  レコードの途中でデータが終わる場合は @c COM_UTIL_ERR_EOF、
+     *                  版または指紋が異なる場合は @c COM_UTIL_ERR_UNSUPPORTED、
+     *                  マジック、ペイロードの長さ、char 配列が不正な場合は @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じインスタンスを並行して書き戻さない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_binary_decode(const struct_meta_descriptor *descriptor,
+                                                                     const void *data, size_t length,
+                                                                     void *instance_out, size_t *consumed_out);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/** @} */
+
+#endif /* STRUCT_META_BINARY_H */
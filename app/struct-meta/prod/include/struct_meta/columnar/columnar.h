@@ -0,0 +1,138 @@
+/**
+ *******************************************************************************
+ *  @file           columnar.h
+ *  @brief          構造体配列 (AoS) と、末端の値ごとの列の集まり (SoA) を相互変換します。
+ *
+ *  列は記述子の末端の値ごとに 1 個作ります。ネストした構造体は展開し、数値の固定長配列は要素ごとに別の列とします。
+ *  char 配列は配列全体を 1 個の値とします。\n
+ *  列の名前は `id`、`scores[2]`、`addresses[1].city` のように struct_meta_path_compile() が受け付けるパスです。
+ *  各列の値は行の順に隙間なく並び、列の先頭は @c STRUCT_META_COLUMNAR_ALIGNMENT バイト境界に置きます。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_COLUMNAR_COLUMNAR_H
+#define STRUCT_META_COLUMNAR_COLUMNAR_H
+
+#include <stddef.h>
+
+#include <struct_meta/access/access.h>
+#include <struct_meta/meta/meta.h>
+
+/**
+ *  @addtogroup STRUCT_META_PUBLIC_API
+ *  @{
+ */
+
+/** 列の先頭アドレスのアラインメント (バイト) です。 */
+#define STRUCT_META_COLUMNAR_ALIGNMENT 64U
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /** 列 1 個です。 */
+    typedef struct struct_meta_columnar_column
+    {
+        const char *path;               /**< 列の名前 (ルートからのパス) です。 */
+        struct_meta_path_handle handle; /**< 行の中の値を指す解決済みハンドルです。値のバイト数は handle.size です。 */
+        unsigned char *data;            /**< 列の先頭です。handle.size バイトの値が行数分並びます。 */
+    } struct_meta_columnar_column;
+
+    /**
+     *  @brief          列の集まり (SoA ブロック) です。
+     *
+     *  struct_meta_columnar_init() で作り、struct_meta_columnar_dispose() で解放します。
+     */
+    typedef struct struct_meta_columnar
+    {
+        const struct_meta_descriptor *descriptor; /**< 行の記述子です。 */
+        size_t row_count;                         /**< 行数です。 */
+        size_t column_count;                      /**< @p columns の要素数です。 */
+        struct_meta_columnar_column *columns;     /**< 列の配列です。記述子のフィールド順に並びます。 */
+        void *storage;                            /**< 列の値と名前を置く領域です (内部用)。 */
+    } struct_meta_columnar;
+
+    /**
+     *  @brief          記述子から列を決め、行数分の領域を 0 で初期化して確保します。
+     *  @param[in]      descriptor 行の記述子です。
+     *  @param[in]      row_count 行数です。
+     *  @param[out]     block_out 作成したブロックです。失敗した場合は空のブロックを格納します。
+     *  @return         @c COM_UTIL_OK、struct_meta_descriptor_validate() と同じ結果コード、
+     *                  文字列または可変長配列を含む場合は @c COM_UTIL_ERR_UNSUPPORTED、
+     *                  または @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_columnar_init(const struct_meta_descriptor *descriptor,
+                                                                     size_t row_count,
+                                                                     struct_meta_columnar *block_out);
+
+    /**
+     *  @brief          構造体配列の値を、ブロックの各列へ複写します。
+     *
+     *  行を一定数ずつの区間に分け、区間ごとに全列を埋めます。区間の行はキャッシュに載ったまま各列へ複写されます。\n
+     *  @p thread_count が 1 以外の場合は、行を連続した範囲に分けて複数スレッドで複写します。
+     *  行が少ない場合は、1 スレッドあたり一定数以上の行を受け持つようスレッド数を減らします。
+     *
+     *  @param[in,out]  block 複写先です。行数は struct_meta_columnar_init() で指定した値です。
+     *  @param[in]      base 構造体配列の先頭です。行数が 0 の場合に限り NULL を指定できます。
+     *  @param[in]      stride 要素間のバイト数です。0 の場合は記述子の size を使います。
+     *  @param[in]      thread_count 使用するスレッド数の上限です。0 の場合はオンラインの CPU 数です。
+     *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じブロックを並行して使わず、配列を並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_columnar_from_rows(struct_meta_columnar *block,
+                                                                          const void *base, size_t stride,
+                                                                          size_t thread_count);
+
+    /**
+     *  @brief          ブロックの各列の値を、構造体配列へ書き戻します。
+     *
+     *  フィールドの値だけを書き込み、パディングは変更しません。分割の方法は struct_meta_columnar_from_rows() と同じです。
+     *
+     *  @param[in]      block 複写元です。
+     *  @param[in,out]  base 構造体配列の先頭です。行数が 0 の場合に限り NULL を指定できます。
+     *  @param[in]      stride 要素間のバイト数です。0 の場合は記述子の size を使います。
+     *  @param[in]      thread_count 使用するスレッド数の上限です。0 の場合はオンラインの CPU 数です。
+     *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じブロックを並行変更せず、配列を並行して使わない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_columnar_to_rows(const struct_meta_columnar *block, void *base,
+                                                                        size_t stride, size_t thread_count);
+
+    /**
+     *  @brief          名前で列を検索します。
+     *  @param[in]      block 対象です。
+     *  @param[in]      path 列の名前です。
+     *  @param[out]     column_out 見つかった列です。
+     *  @return         @c COM_UTIL_OK、@c COM_UTIL_ERR_INVALID_ARGUMENT、または @c COM_UTIL_ERR_NOT_FOUND を返します。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_columnar_find(const struct_meta_columnar *block,
+                                                                     const char *path,
+                                                                     const struct_meta_columnar_column **column_out);
+
+    /**
+     *  @brief          ブロックが確保した領域を解放し、空のブロックへ戻します。
+     *  @param[in,out]  block 対象です。NULL の場合は何もしません。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_columnar_dispose(struct_meta_columnar *block);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/** @} */
+
+#endif /* STRUCT_META_COLUMNAR_COLUMNAR_H */
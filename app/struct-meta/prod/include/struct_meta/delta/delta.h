@@ -0,0 +1,114 @@
+/**
+ *******************************************************************************
+ *  @file           delta.h
+ *  @brief          同じ型の 2 個の構造体の差分を、変更された末端の値のパスと値の一覧として求め、適用します。
+ *
+ *  末端の値の単位は struct_meta_columnar と同じです。ネストした構造体は展開し、数値の固定長配列は要素ごとに、
+ *  char 配列は配列全体で 1 個の値とします。パスは struct_meta_path_compile() が受け付ける書式です。\n
+ *  差分の大きさは変更された値の数に比例し、構造体全体の大きさには依存しません。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_DELTA_DELTA_H
+#define STRUCT_META_DELTA_DELTA_H
+
+#include <stddef.h>
+
+#include <struct_meta/meta/meta.h>
+
+/**
+ *  @addtogroup STRUCT_META_PUBLIC_API
+ *  @{
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /** 変更された値 1 個です。 */
+    typedef struct struct_meta_delta_entry
+    {
+        const char *path;            /**< 値のパス (`addresses[1].city` など) です。 */
+        const void *value;           /**< 新しい値のバイト列です。先頭は 8 バイト境界です。 */
+        size_t size;                 /**< @p value のバイト数です。char 配列では NUL 終端を含む文字列の長さです。 */
+        struct_meta_field_kind kind; /**< 値の種別です。 */
+        unsigned int pad;            /**< 明示的アラインメントです。 */
+    } struct_meta_delta_entry;
+
+    /**
+     *  @brief          差分です。
+     *
+     *  struct_meta_diff() で作り、struct_meta_delta_dispose() で解放します。
+     *  値の一覧、パス、値は 1 個の領域にまとめて確保します。
+     */
+    typedef struct struct_meta_delta
+    {
+        const struct_meta_descriptor *descriptor; /**< 差分を求めた記述子です。 */
+        size_t count;                             /**< @p entries の要素数です。 */
+        struct_meta_delta_entry *entries;         /**< 変更された値の一覧です。記述子のフィールド順に並びます。 */
+        void *storage;                            /**< 一覧、パス、値を置く領域です (内部用)。 */
+    } struct_meta_delta;
+
+    /**
+     *  @brief          2 個の構造体を比較し、値が異なる末端の値を差分として求めます。
+     *
+     *  値はバイト列として比較します。float と double では -0.0 と 0.0 を別の値とし、同じビット列の NaN は同じ値とします。
+     *  char 配列は最初の NUL までを比較します。\n
+     *  フィールド、ネストした構造体、配列の全体がバイト単位で一致する場合は、その内側を走査しません。
+     *  構造体全体が一致する場合は、記述子の検査だけで終わります。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      old_instance 変更前の構造体です。
+     *  @param[in]      new_instance 変更後の構造体です。
+     *  @param[out]     delta_out 差分です。変更がない場合は要素数 0 の差分です。失敗した場合は空の差分を格納します。
+     *  @return         @c COM_UTIL_OK、struct_meta_descriptor_validate() と同じ結果コード、
+     *                  @c COM_UTIL_ERR_INVALID_ARGUMENT、文字列または可変長配列を含む場合は
+     *                  @c COM_UTIL_ERR_UNSUPPORTED、または @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。
+     *
+     *  @par            スレッド セーフ
+     *  両方の構造体を並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_diff(const struct_meta_descriptor *descriptor,
+                                                            const void *old_instance, const void *new_instance,
+                                                            struct_meta_delta *delta_out);
+
+    /**
+     *  @brief          差分を構造体へ適用します。
+     *
+     *  各値のパスは @p descriptor で解決します。差分を求めた記述子と同じ構造を持つ記述子であれば、
+     *  別のプロセスの記述子やレイアウトの異なる記述子にも適用できます。\n
+     *  先にすべての値のパス、種別、バイト数を検査し、すべて適用できる場合に限り書き込みます。
+     *  各パスの解決は 1 回だけで、検査で解決したハンドルを書き込みに使います。
+     *  char 配列は @c size バイトだけを書き込み、文字列の後ろのバイトは変更しません。
+     *
+     *  @param[in]      descriptor 適用先の記述子です。
+     *  @param[in]      delta 差分です。
+     *  @param[in,out]  instance 適用先の構造体です。
+     *  @return         @c COM_UTIL_OK、struct_meta_path_compile() と同じ結果コード、
+     *                  値の種別やバイト数がパスの値と合わない場合は @c COM_UTIL_ERR_INVALID_ARGUMENT、
+     *                  または @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。
+     *                  エラーの場合、@p instance は変更しません。
+     *
+     *  @par            スレッド セーフ
+     *  同じ構造体を並行して使わない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_delta_apply(const struct_meta_descriptor *descriptor,
+                                                                   const struct_meta_delta *delta, void *instance);
+
+    /**
+     *  @brief          差分が確保した領域を解放し、空の差分へ戻します。
+     *  @param[in,out]  delta 対象です。NULL の場合は何もしません。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_delta_dispose(struct_meta_delta *delta);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/** @} */
+
+#endif /* STRUCT_META_DELTA_DELTA_H */
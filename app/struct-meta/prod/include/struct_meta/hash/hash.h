@@ -0,0 +1,80 @@
+/**
+ *******************************************************************************
+ *  @file           hash.h
+ *  @brief          記述子に従って、構造体の意味のあるバイトだけからハッシュ値を求め、等価性を判定します。
+ *
+ *  パディングと char 配列の NUL より後ろのバイトは、ハッシュ値にも等価性にも影響しません。
+ *  float と double は -0.0 を 0.0 に、すべての NaN を 1 個の NaN にそろえてから扱います。
+ *  bool は 0 以外の値を、バイト列によらず同じ真として扱います。\n
+ *  struct_meta_equal() が等しいと判定する 2 個の構造体は、struct_meta_hash() が同じ値を返します。
+ *  構造体をキーとするハッシュ表に使えます。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_HASH_HASH_H
+#define STRUCT_META_HASH_HASH_H
+
+#include <stdint.h>
+
+#include <struct_meta/meta/meta.h>
+
+/**
+ *  @addtogroup STRUCT_META_PUBLIC_API
+ *  @{
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /**
+     *  @brief          構造体のハッシュ値を求めます。
+     *
+     *  記述子ごとの走査手順 (ハッシュ対象の範囲の一覧) は初回利用時に作り、以降の呼び出しで共有します。\n
+     *  値はプロセス内のハッシュ表での利用を想定しています。ホストのバイト順や版により変わりうるため、
+     *  ファイルへの保存やプロセス間の比較には使いません。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      instance 構造体です。
+     *  @param[out]     hash_out ハッシュ値です。
+     *  @return         @c COM_UTIL_OK、struct_meta_descriptor_validate() と同じ結果コード、
+     *                  @c COM_UTIL_ERR_INVALID_ARGUMENT、float または double の要素サイズがホストの型と異なる場合と
+     *                  文字列または可変長配列を含む場合は @c COM_UTIL_ERR_UNSUPPORTED、
+     *                  または @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。
+     *
+     *  @par            スレッド セーフ
+     *  構造体を並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_hash(const struct_meta_descriptor *descriptor,
+                                                            const void *instance, uint64_t *hash_out);
+
+    /**
+     *  @brief          2 個の構造体の値が等しいかを判定します。
+     *
+     *  数値はバイト列として比較し、bool は 0 以外の値をすべて等しい真とし、char 配列は最初の NUL までを比較します。
+     *  float と double は、-0.0 と 0.0 を等しく、NaN どうしを等しいとします (ハッシュ表のキーとして反射律を保つため)。\n
+     *  構造体全体がバイト単位で一致する場合は、走査せずに等しいと判定します。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      left 比較する構造体です。
+     *  @param[in]      right 比較する構造体です。
+     *  @param[out]     equal_out 等しい場合は 1、異なる場合は 0 です。
+     *  @return         struct_meta_hash() と同じ結果コードを返します。
+     *
+     *  @par            スレッド セーフ
+     *  両方の構造体を並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_equal(const struct_meta_descriptor *descriptor,
+                                                             const void *left, const void *right, int *equal_out);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/** @} */
+
+#endif /* STRUCT_META_HASH_HASH_H */
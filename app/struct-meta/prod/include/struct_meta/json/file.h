@@ -11,6 +11,7 @@
 #ifndef STRUCT_META_JSON_FILE_H
 #define STRUCT_META_JSON_FILE_H
 
+#include <struct_meta/memory/arena.h>
 #include <struct_meta/meta/meta.h>
 
 /**
@@ -27,6 +28,9 @@ extern "C"
                                                                       const void *instance, const char *path);
     STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_file_load(const struct_meta_descriptor *descriptor,
                                                                       const char *path, void *instance_out);
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_file_load_arena(const struct_meta_descriptor *descriptor,
+                                                                            const char *path, void *instance_out,
+                                                                            struct_meta_arena *arena);
 
 #ifdef __cplusplus
 }
@@ -3,6 +3,13 @@
  *  @file           json.h
  *  @brief          構造体と cJSON オブジェクトを相互変換します。
  *
+ *  cJSON は数値を double で保持し、16 桁以上の整数を指数表記で出力するため、
+ *  絶対値が 10^15 以上の 64 ビット整数は 10 進表記の Raw アイテムとして出力します。
+ *  書き戻しでは、数値アイテムは正確に表せる整数だけを受け付け、Raw アイテムと文字列の整数表記も受け付けます。
+ *  cJSON_Parse() で読み込んだテキストの大きな整数は精度が失われているため、
+ *  正確に読み取るには struct_meta_json_decode_text() を使ってください。\n
+ *  文字列 (char *) は JSON の文字列 (NULL は null)、可変長配列は要素数 count の JSON 配列と対応します。
+ *
  *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
  *
  *******************************************************************************
@@ -11,8 +18,12 @@
 #ifndef STRUCT_META_JSON_H
 #define STRUCT_META_JSON_H
 
+#include <stddef.h>
+
 #include <cJSON.h>
 
+#include <struct_meta/memory/allocator.h>
+#include <struct_meta/memory/buffer.h>
 #include <struct_meta/meta/meta.h>
 
 /**
@@ -30,6 +41,90 @@ extern "C"
     STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_decode(const struct_meta_descriptor *descriptor,
                                                                    const cJSON *json, void *instance_out);
 
+    /**
+     *  @brief          cJSON オブジェクトの内容を構造体へ書き戻し、動的フィールドの領域をアロケーターから確保します。
+     *
+     *  struct_meta_json_decode() と同じ値を書き戻します。
+     *  struct_meta_json_decode() は、アロケーターに NULL を指定した場合と同じです。\n
+     *  文字列と可変長配列は JSON の値の長さちょうどの領域を確保し、書き戻す前の領域を同じアロケーターで解放します。
+     *  JSON の null は、文字列では NULL、可変長配列では要素数 0 として書き戻します。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      json cJSON オブジェクトです。
+     *  @param[in,out]  instance 書き戻し先です。
+     *                  文字列と可変長配列は NULL (要素数 0) か、@p allocator で確保した値でなければなりません。
+     *  @param[in]      allocator アロケーターです。NULL の場合は malloc() と free() を使います。
+     *  @return         struct_meta_json_decode() と同じ結果コード、または @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。
+     *                  エラーの場合も、書き戻した文字列と可変長配列は struct_meta_instance_release() で解放できます。
+     *
+     *  @par            スレッド セーフ
+     *  同じインスタンスを並行して参照、変更せず、アロケーターを並行して使わない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_decode_alloc(const struct_meta_descriptor *descriptor,
+                                                                         const cJSON *json, void *instance,
+                                                                         const struct_meta_allocator *allocator);
+
+    /**
+     *  @brief          cJSON オブジェクトの内容を構造体へ書き戻し、エラーの場合は書き戻す前の内容へ戻します。
+     *
+     *  struct_meta_json_decode() と同じ値を書き戻します。
+     *  フィールドへ書き込む前に、そのフィールドが占める範囲の内容を取り消しログへ記録し、
+     *  エラーの場合は記録を逆順に書き戻します。構造体全体の複写は行いません。\n
+     *  文字列と可変長配列は書き戻す前の領域を解放するため取り消せません。JSON がこれらの値を含む場合は
+     *  @c COM_UTIL_ERR_UNSUPPORTED を返し、それまでの書き込みを取り消します。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      json cJSON オブジェクトです。
+     *  @param[in,out]  instance 書き戻し先です。エラーの場合は呼び出し前の内容のままです。
+     *  @param[in,out]  undo 取り消しログの作業領域です。NULL の場合は関数内で確保して解放します。
+     *                  同じバッファーを繰り返し渡すと、確保済みの領域を再利用します。戻った時点の内容は空です。
+     *  @return         struct_meta_json_decode() と同じ結果コード、@c COM_UTIL_ERR_OUT_OF_MEMORY、
+     *                  または @c COM_UTIL_ERR_UNSUPPORTED を返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じ作業領域を並行して使わず、同じインスタンスを並行して参照、変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_decode_atomic(const struct_meta_descriptor *descriptor,
+                                                                          const cJSON *json, void *instance,
+                                                                          struct_meta_buffer *undo);
+
+    /**
+     *  @brief          構造体配列を cJSON 配列へ変換します。
+     *
+     *  各要素は struct_meta_json_encode() と同じ規則で変換します。
+     *  記述子の検査と JSON キーの解決は、配列全体で 1 回だけ行います。
+     *
+     *  @param[in]      descriptor 要素の記述子です。
+     *  @param[in]      base 配列の先頭です。@p count が 0 の場合に限り NULL を指定できます。
+     *  @param[in]      count 要素数です。
+     *  @param[in]      stride 要素間のバイト数です。0 の場合は記述子の size を使います。
+     *  @param[out]     json_out 作成した cJSON 配列です。呼び出し側が cJSON_Delete() で解放します。
+     *  @return         @c COM_UTIL_OK、または struct_meta_json_encode() と同じ結果コードを返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_encode_array(const struct_meta_descriptor *descriptor,
+                                                                         const void *base, size_t count,
+                                                                         size_t stride, cJSON **json_out);
+
+    /**
+     *  @brief          cJSON 配列の内容を構造体配列へ書き戻します。
+     *
+     *  各要素は struct_meta_json_decode() と同じ規則で書き戻します。
+     *  配列の要素数が @p capacity を超える場合は、何も書き込まずに @c COM_UTIL_ERR_BUFFER_TOO_SMALL を返します。
+     *
+     *  @param[in]      descriptor 要素の記述子です。
+     *  @param[in]      json cJSON 配列です。
+     *  @param[out]     base 書き戻し先の配列の先頭です。@p capacity が 0 の場合に限り NULL を指定できます。
+     *  @param[in]      capacity 書き戻し先の要素数です。
+     *  @param[in]      stride 要素間のバイト数です。0 の場合は記述子の size を使います。
+     *  @param[out]     count_out 書き戻しを終えた要素数です。エラーの場合も、それまでに書き戻した要素数を格納します。
+     *  @return         @c COM_UTIL_OK、struct_meta_json_decode() と同じ結果コード、
+     *                  または @c COM_UTIL_ERR_BUFFER_TOO_SMALL を返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_decode_array(const struct_meta_descriptor *descriptor,
+                                                                         const cJSON *json, void *base,
+                                                                         size_t capacity, size_t stride,
+                                                                         size_t *count_out);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
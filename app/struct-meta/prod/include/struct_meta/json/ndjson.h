@@ -0,0 +1,189 @@
+/**
+ *******************************************************************************
+ *  @file           ndjson.h
+ *  @brief          構造体を 1 行 1 レコードの JSON テキスト (NDJSON) として順に読み書きします。
+ *
+ *  各行は struct_meta_json_write_buffer() の @c STRUCT_META_JSON_FORMAT_COMPACT と同じテキストに改行 (LF) を付けたものです。\n
+ *  読み書きともにストリームを先頭から 1 回だけ走査し、ファイル全体を保持しません。
+ *  使用するメモリーは、書き出しでは @c STRUCT_META_NDJSON_WRITER_CHUNK_SIZE と 1 レコード分のテキスト、
+ *  読み込みでは @c STRUCT_META_JSON_READER_CHUNK_SIZE と最も長い行 (上限は行の長さの上限) です。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_JSON_NDJSON_H
+#define STRUCT_META_JSON_NDJSON_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <struct_meta/json/reader.h>
+#include <struct_meta/memory/buffer.h>
+#include <struct_meta/meta/meta.h>
+
+/**
+ *  @addtogroup STRUCT_META_PUBLIC_API
+ *  @{
+ */
+
+/** 書き出し側がストリームへ書き出す前にためるバイト数の目安です。 */
+#define STRUCT_META_NDJSON_WRITER_CHUNK_SIZE 65536U
+
+/** 読み込み側の行の長さの上限に 0 を指定した場合に使うバイト数です。 */
+#define STRUCT_META_NDJSON_DEFAULT_LINE_LIMIT (1024U * 1024U)
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /**
+     *  @brief          NDJSON の書き出し状態です。
+     *
+     *  struct_meta_ndjson_writer_init() で初期化し、struct_meta_ndjson_writer_flush() で書き出した後、
+     *  struct_meta_ndjson_writer_dispose() で解放します。
+     */
+    typedef struct struct_meta_ndjson_writer
+    {
+        FILE *stream;               /**< 書き出し先のストリームです。 */
+        struct_meta_buffer pending; /**< ストリームへの書き出し待ちのテキストです。 */
+        size_t record_count;        /**< 追記したレコード数です。 */
+        int result;                 /**< 最初に発生した書き出しエラーです。エラーがなければ @c COM_UTIL_OK です。 */
+        int pad;                    /**< 明示的アラインメントです。 */
+    } struct_meta_ndjson_writer;
+
+    /**
+     *  @brief          ストリームへ書き出すように初期化します。
+     *  @param[out]     writer 対象です。
+     *  @param[in,out]  stream 書き出し先です。
+     *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_ndjson_writer_init(struct_meta_ndjson_writer *writer,
+                                                                          FILE *stream);
+
+    /**
+     *  @brief          構造体 1 個を 1 行として追記します。
+     *
+     *  テキストは書き出し待ちへ追記し、@c STRUCT_META_NDJSON_WRITER_CHUNK_SIZE バイト以上たまった時点で
+     *  ストリームへ書き出します。\n
+     *  変換に失敗したレコードは書き出し待ちへ何も残さないため、続けて次のレコードを追記できます。
+     *  ストリームへの書き出しに失敗した場合は、以降の追記も同じエラーを返します。
+     *
+     *  @param[in,out]  writer 対象です。
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      instance 構造体です。
+     *  @return         @c COM_UTIL_OK、struct_meta_json_encode() と同じ結果コード、
+     *                  またはストリームへの書き出しに失敗した場合は @c COM_UTIL_ERR_UNKNOWN を返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じ書き出し状態を並行して使わず、同じインスタンスを並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_ndjson_writer_append(struct_meta_ndjson_writer *writer,
+                                                                            const struct_meta_descriptor *descriptor,
+                                                                            const void *instance);
+
+    /**
+     *  @brief          書き出し待ちのテキストをストリームへ書き出します。
+     *  @param[in,out]  writer 対象です。
+     *  @return         @c COM_UTIL_OK、またはこれまでに発生した最初の書き出しエラーを返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_ndjson_writer_flush(struct_meta_ndjson_writer *writer);
+
+    /**
+     *  @brief          書き出し状態が確保した領域を解放します。
+     *
+     *  書き出し待ちのテキストは書き出さずに捨てます。
+     *
+     *  @param[in,out]  writer 対象です。NULL の場合は何もしません。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_ndjson_writer_dispose(struct_meta_ndjson_writer *writer);
+
+    /**
+     *  @brief          NDJSON の読み込み状態です。
+     *
+     *  struct_meta_ndjson_reader_init() で初期化し、struct_meta_ndjson_reader_dispose() で解放します。\n
+     *  チャンクの中で完結する行はチャンクから直接読み込み、チャンクをまたぐ行だけを @p line へ連結します。
+     */
+    typedef struct struct_meta_ndjson_reader
+    {
+        FILE *stream;            /**< 読み込み元のストリームです。 */
+        struct_meta_buffer line;  /**< チャンクをまたぐ行の読み込み済みの部分です。 */
+        struct_meta_arena *arena; /**< 行ごとの一時領域の確保元です。NULL の場合は malloc 系の関数で確保します。 */
+        size_t line_limit;        /**< 1 行のバイト数の上限です (改行を含みません)。 */
+        size_t line_number;       /**< 直前に処理した行の行番号 (1 始まり) です。 */
+        size_t chunk_position;    /**< @p chunk の次に処理する位置です。 */
+        size_t chunk_length;      /**< @p chunk に読み込んだバイト数です。 */
+        int at_end;               /**< ストリームの終端に達した場合は 0 以外です。 */
+        int overflow;             /**< 読み込み中の行が上限を超えた場合は 0 以外です。 */
+        unsigned char chunk[STRUCT_META_JSON_READER_CHUNK_SIZE]; /**< ストリームから読み込んだテキストです。 */
+    } struct_meta_ndjson_reader;
+
+    /**
+     *  @brief          ストリームから読み込むように初期化します。
+     *  @param[out]     reader 対象です。
+     *  @param[in,out]  stream 読み込み元です。
+     *  @param[in]      line_limit 1 行のバイト数の上限です。0 の場合は @c STRUCT_META_NDJSON_DEFAULT_LINE_LIMIT です。
+     *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_ndjson_reader_init(struct_meta_ndjson_reader *reader,
+                                                                          FILE *stream, size_t line_limit);
+
+    /**
+     *  @brief          行ごとの一時領域をアリーナから確保するように設定します。
+     *
+     *  各行の読み込みに使う一時領域 (エスケープを展開した文字列など) をアリーナから確保し、
+     *  行を読み終えるごとにアリーナの使用量を行の読み込み前へ戻します。
+     *  チャンクをまたぐ行の連結先は呼び出しをまたいで保持するため、アリーナからは確保しません。\n
+     *  行の連結先が最も長い行まで育ち、アリーナのブロックが必要な大きさまで育った後は、
+     *  struct_meta_ndjson_reader_next() は動的確保を行いません。
+     *
+     *  @param[in,out]  reader 対象です。
+     *  @param[in,out]  arena 確保元です。NULL の場合は malloc 系の関数へ戻します。
+     *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_ndjson_reader_use_arena(struct_meta_ndjson_reader *reader,
+                                                                               struct_meta_arena *arena);
+
+    /**
+     *  @brief          次の 1 行を構造体へ読み込みます。
+     *
+     *  空白 (0x20 以下のバイト) だけの行は読み飛ばします。行末の CR は空白として扱います。\n
+     *  読み込み先は毎回 0 で埋めてから struct_meta_json_reader_value() と同じ規則で読み込むため、
+     *  同じインスタンスを繰り返し渡しても前のレコードの値は残りません。
+     *  文字列と可変長配列は malloc() で確保し、呼び出し側が所有します。0 で埋める前の値は解放しないため、
+     *  次の呼び出しの前に struct_meta_instance_release() で解放するか、別の場所へ引き継いでください。
+     *  エラーの場合も、書き込んだ文字列と可変長配列は struct_meta_instance_release() で解放できます。
+     *  値の後ろに空白以外のテキストが続く行は構文エラーです。\n
+     *  成功、失敗のどちらの場合も、@p reader の line_number に処理した行の行番号を格納します。
+     *  変換エラーと行の長さの超過の後は、次の呼び出しで次の行から読み込みを続けられます。
+     *
+     *  @param[in,out]  reader 対象です。
+     *  @param[in]      descriptor 記述子です。
+     *  @param[out]     instance 読み込み先です。
+     *  @return         @c COM_UTIL_OK、レコードが残っていない場合は @c COM_UTIL_ERR_EOF、
+     *                  struct_meta_json_reader_value() と同じ結果コード、
+     *                  行が上限より長い場合は @c COM_UTIL_ERR_BUFFER_TOO_SMALL、
+     *                  ストリームの読み込みに失敗した場合は @c COM_UTIL_ERR_UNKNOWN を返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じ読み込み状態を並行して使わず、同じインスタンスを並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_ndjson_reader_next(struct_meta_ndjson_reader *reader,
+                                                                          const struct_meta_descriptor *descriptor,
+                                                                          void *instance);
+
+    /**
+     *  @brief          読み込み状態が確保した領域を解放します。
+     *  @param[in,out]  reader 対象です。NULL の場合は何もしません。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_ndjson_reader_dispose(struct_meta_ndjson_reader *reader);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/** @} */
+
+#endif /* STRUCT_META_JSON_NDJSON_H */
@@ -0,0 +1,389 @@
+/**
+ *******************************************************************************
+ *  @file           reader.h
+ *  @brief          JSON テキストを 1 回だけ走査し、トークンを順に取り出します。
+ *
+ *  cJSON のオブジェクトを作らずに、構造体へ直接読み込む用途に使います。
+ *  受理する文法は cJSON_Parse() に合わせています (空白の扱い、先頭の BOM、数値の書式、
+ *  入れ子の上限、最上位の値の後ろに続くテキストを無視する点など)。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_JSON_READER_H
+#define STRUCT_META_JSON_READER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <struct_meta/memory/allocator.h>
+#include <struct_meta/memory/buffer.h>
+#include <struct_meta/meta/meta.h>
+
+/**
+ *  @addtogroup STRUCT_META_PUBLIC_API
+ *  @{
+ */
+
+/** 入れ子の上限です。cJSON の CJSON_NESTING_LIMIT と同じ値です。 */
+#define STRUCT_META_JSON_NESTING_LIMIT 1000U
+
+/** ストリームから 1 回に読み込むバイト数です。 */
+#define STRUCT_META_JSON_READER_CHUNK_SIZE 4096U
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /** JSON トークンの種類です。 */
+    typedef enum struct_meta_json_token
+    {
+        STRUCT_META_JSON_TOKEN_END = 0,          /**< 最上位の値を読み終えました。 */
+        STRUCT_META_JSON_TOKEN_BEGIN_OBJECT = 1, /**< `{` です。 */
+        STRUCT_META_JSON_TOKEN_END_OBJECT = 2,   /**< `}` です。 */
+        STRUCT_META_JSON_TOKEN_BEGIN_ARRAY = 3,  /**< `[` です。 */
+        STRUCT_META_JSON_TOKEN_END_ARRAY = 4,    /**< `]` です。 */
+        STRUCT_META_JSON_TOKEN_KEY = 5,          /**< オブジェクトのキーです。内容は string です。 */
+        STRUCT_META_JSON_TOKEN_STRING = 6,       /**< 文字列値です。内容は string です。 */
+        STRUCT_META_JSON_TOKEN_NUMBER = 7,       /**< 数値です。値は number です。 */
+        STRUCT_META_JSON_TOKEN_TRUE = 8,         /**< `true` です。 */
+        STRUCT_META_JSON_TOKEN_FALSE = 9,        /**< `false` です。 */
+        STRUCT_META_JSON_TOKEN_NULL = 10         /**< `null` です。 */
+    } struct_meta_json_token;
+
+    /**
+     *  @brief          JSON テキストの読み取り状態です。
+     *
+     *  struct_meta_json_reader_init_text() または struct_meta_json_reader_init_stream() で初期化し、
+     *  struct_meta_json_reader_dispose() で解放します。\n
+     *  @p string が指す内容は、次に struct_meta_json_reader_next() を呼び出すまで有効です。
+     */
+    typedef struct struct_meta_json_reader
+    {
+        const unsigned char *text;  /**< 読み取り中のテキストです。 */
+        size_t length;              /**< @p text のバイト数です。 */
+        size_t position;            /**< 次に読み取る位置です。 */
+        size_t depth;               /**< 現在のコンテナーの入れ子の深さです。 */
+        FILE *stream;               /**< 読み込み元のストリームです。テキストから読み取る場合は NULL です。 */
+        struct_meta_buffer window;  /**< ストリームから読み込んだ未処理のテキストです。 */
+        struct_meta_buffer scratch; /**< エスケープを展開した文字列です。 */
+        struct_meta_arena *arena;   /**< 一時領域の確保元です。NULL の場合は malloc 系の関数で確保します。 */
+        struct_meta_buffer *undo;   /**< 上書き前の内容を記録する取り消しログです。NULL の場合は記録しません。 */
+        /** 構造体へ読み込む文字列と可変長配列の領域の確保元です。NULL の場合は malloc() と free() を使います。 */
+        const struct_meta_allocator *allocator;
+        const char *string;         /**< 直前のキーまたは文字列値です。NUL 終端とは限りません。 */
+        size_t string_length;       /**< @p string のバイト数です。 */
+        double number;              /**< 直前の数値です。 */
+        uint64_t integer;           /**< 直前の数値が整数表記の場合の絶対値です。 */
+        int integer_sign;           /**< 整数表記の値が @p integer に収まれば 1 (非負) か -1 (負)、他は 0 です。 */
+        int pad;                    /**< 明示的アラインメントです。 */
+        int state;                  /**< 次に期待する構文要素です。 */
+        int result;                 /**< 最初に発生したエラーです。エラーがなければ @c COM_UTIL_OK です。 */
+        unsigned char containers[(STRUCT_META_JSON_NESTING_LIMIT + 31U) / 32U * 4U]; /**< 深さごとのコンテナーの種類 (1 ビットずつ) です。 */
+    } struct_meta_json_reader;
+
+    /**
+     *  @brief          メモリー上のテキストから読み取るように初期化します。
+     *  @param[out]     reader 対象です。
+     *  @param[in]      text テキストです。NUL 終端は不要です。読み取りが終わるまで変更してはなりません。
+     *  @param[in]      length テキストのバイト数です。
+     *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_reader_init_text(struct_meta_json_reader *reader,
+                                                                             const char *text, size_t length);
+
+    /**
+     *  @brief          ストリームから読み取るように初期化します。
+     *
+     *  ストリームは @c STRUCT_META_JSON_READER_CHUNK_SIZE バイト単位で読み込み、
+     *  処理済みのテキストは保持しません。
+     *
+     *  @param[out]     reader 対象です。
+     *  @param[in,out]  stream 読み込み元です。
+     *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_reader_init_stream(struct_meta_json_reader *reader,
+                                                                               FILE *stream);
+
+    /**
+     *  @brief          読み取り中の一時領域をアリーナから確保するように設定します。
+     *
+     *  初期化の直後、最初に struct_meta_json_reader_next() を呼び出す前に設定します。
+     *  ストリームの窓、エスケープを展開した文字列、フィールド数の多い構造体の読み込み済みフィールドの記録を
+     *  アリーナから確保し、struct_meta_json_reader_dispose() は解放しません。
+     *  アリーナの使用量は、読み取り状態を使い終えるまで戻してはなりません。
+     *
+     *  @param[in,out]  reader 対象です。
+     *  @param[in,out]  arena 確保元です。NULL の場合は malloc 系の関数へ戻します。
+     *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     *                  読み取りを始めた後は @c COM_UTIL_ERR_INVALID_ARGUMENT です。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_reader_use_arena(struct_meta_json_reader *reader,
+                                                                             struct_meta_arena *arena);
+
+    /**
+     *  @brief          構造体へ読み込む文字列と可変長配列の領域を、アロケーターから確保するように設定します。
+     *
+     *  struct_meta_json_decode_alloc() と同じく、値の長さちょうどの領域を確保し、
+     *  書き込む前の領域を同じアロケーターで解放します。
+     *  読み取り中の一時領域 (struct_meta_json_reader_use_arena()) と異なり、確保した領域は呼び出し側が所有します。
+     *
+     *  @param[in,out]  reader 対象です。
+     *  @param[in]      allocator アロケーターです。NULL の場合は malloc() と free() を使います。
+     *                  読み取り状態を使い終えるまで有効でなければなりません。
+     *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_reader_use_allocator(
+        struct_meta_json_reader *reader, const struct_meta_allocator *allocator);
+
+    /**
+     *  @brief          読み取り状態が確保した領域を解放します。
+     *  @param[in,out]  reader 対象です。NULL の場合は何もしません。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_json_reader_dispose(struct_meta_json_reader *reader);
+
+    /**
+     *  @brief          次のトークンを読み取ります。
+     *  @param[in,out]  reader 対象です。
+     *  @param[out]     token_out トークンの種類です。
+     *  @return         @c COM_UTIL_OK、構文エラーの場合は @c COM_UTIL_ERR_INVALID_ARGUMENT、
+     *                  ストリームの読み込みに失敗した場合は @c COM_UTIL_ERR_UNKNOWN、
+     *                  メモリー不足の場合は @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。
+     *                  エラーの後は、同じエラーを返し続けます。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_reader_next(struct_meta_json_reader *reader,
+                                                                        struct_meta_json_token *token_out);
+
+    /**
+     *  @brief          直前に読み取ったトークンから始まる値を読み飛ばします。
+     *
+     *  @p token が `{` または `[` の場合は、対応する `}` または `]` まで読み進めます。
+     *  それ以外の値では何もしません。
+     *
+     *  @param[in,out]  reader 対象です。
+     *  @param[in]      token 直前に読み取ったトークンです。
+     *  @return         struct_meta_json_reader_next() と同じ結果コードを返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_reader_skip(struct_meta_json_reader *reader,
+                                                                        struct_meta_json_token token);
+
+    /**
+     *  @brief          直前に読み取った文字列値を、char 配列へ NUL 終端して複写します。
+     *
+     *  記述子の @c STRUCT_META_FIELD_CHAR_ARRAY と同じ扱いです。cJSON と同じく、`\u0000` 以降は値に含めません。
+     *  エラーの場合、@p buffer は変更しません。
+     *
+     *  @param[in]      reader 対象です。
+     *  @param[in]      token 直前に読み取ったトークンです。
+     *  @param[out]     buffer 複写先の char 配列です。
+     *  @param[in]      capacity @p buffer のバイト数です。
+     *  @return         @c COM_UTIL_OK、@p token が文字列値でない場合は @c COM_UTIL_ERR_INVALID_ARGUMENT、
+     *                  NUL 終端を含めて収まらない場合は @c COM_UTIL_ERR_BUFFER_TOO_SMALL を返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_reader_chars(const struct_meta_json_reader *reader,
+                                                                         struct_meta_json_token token, char *buffer,
+                                                                         size_t capacity);
+
+    /**
+     *  @brief          直前に読み取った数値を、符号付き 64 ビット整数として取り出します。
+     *
+     *  整数表記の数値は double を経由せずに変換するため、絶対値が 2^53 を超える値も丸めません。
+     *  小数点や指数を含む数値は、整数値で、かつ絶対値が 2^53 以下の場合だけ受け付けます。
+     *  エラーの場合、@p value_out は変更しません。
+     *
+     *  @param[in]      reader 対象です。
+     *  @param[in]      token 直前に読み取ったトークンです。
+     *  @param[in]      minimum 受け付ける最小値です。
+     *  @param[in]      maximum 受け付ける最大値です。
+     *  @param[out]     value_out 値です。
+     *  @return         @c COM_UTIL_OK、@p token が数値でない場合や、整数でない、または範囲外の場合は
+     *                  @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_reader_int64(const struct_meta_json_reader *reader,
+                                                                         struct_meta_json_token token, int64_t minimum,
+                                                                         int64_t maximum, int64_t *value_out);
+    /** @brief 直前に読み取った数値を、0 以上 @p maximum 以下の符号なし 64 ビット整数として取り出します。その他は struct_meta_json_reader_int64() と同じです。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_reader_uint64(const struct_meta_json_reader *reader,
+                                                                          struct_meta_json_token token,
+                                                                          uint64_t maximum, uint64_t *value_out);
+
+    /**
+     *  @brief          記述子に従って、次の値を構造体へ読み込みます。
+     *
+     *  struct_meta_json_decode() と同じく `json.name`、`json.ignore`、`json.required`、
+     *  配列の要素数、char 配列の容量 (@c COM_UTIL_ERR_BUFFER_TOO_SMALL) を検査します。\n
+     *  キーは記述子ごとの JSON キー索引で引き、値はテキストの出現順に構造体へ直接書き込みます。
+     *  同じキーが複数ある場合は、cJSON と同じく先頭の値を使います。\n
+     *  文字列と可変長配列は struct_meta_json_decode_alloc() と同じく、読み取り状態のアロケーターから
+     *  値の長さちょうどの領域を確保します。
+     *  エラーの場合、それまでに書き込んだフィールドは元へ戻しません。
+     *  書き込んだ文字列と可変長配列は struct_meta_instance_release() で解放できます。
+     *
+     *  @param[in,out]  reader 対象です。
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in,out]  instance 読み込み先です。JSON に含まれないフィールドは変更しません。
+     *                  文字列と可変長配列は NULL (要素数 0) か、
+     *                  読み取り状態のアロケーターで確保した値でなければなりません。
+     *  @return         @c COM_UTIL_OK、struct_meta_json_decode() と同じ結果コード、
+     *                  または struct_meta_json_reader_next() と同じ結果コードを返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じ読み取り状態を並行して使わず、同じインスタンスを並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_reader_value(struct_meta_json_reader *reader,
+                                                                         const struct_meta_descriptor *descriptor,
+                                                                         void *instance);
+
+    /**
+     *  @brief          JSON テキストを構造体へ直接読み込みます。
+     *
+     *  cJSON_Parse() と struct_meta_json_decode() を順に呼び出した場合と同じ値を読み込みますが、
+     *  cJSON のオブジェクトは作りません。
+     *  ただし、絶対値が 2^53 を超える 64 ビット整数は、cJSON では丸められるため読み込めませんが、
+     *  本関数は丸めずに読み込みます。エラー時の扱いは struct_meta_json_reader_value() と同じです。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      text テキストです。NUL 終端は不要です。
+     *  @param[in]      length テキストのバイト数です。
+     *  @param[in,out]  instance 読み込み先です。
+     *  @return         struct_meta_json_reader_value() と同じ結果コードを返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_decode_text(const struct_meta_descriptor *descriptor,
+                                                                        const char *text, size_t length,
+                                                                        void *instance);
+
+    /**
+     *  @brief          一時領域をアリーナから確保して、JSON テキストを構造体へ直接読み込みます。
+     *
+     *  struct_meta_json_decode_text() と同じ値を読み込みます。
+     *  読み込み中の一時領域はすべて @p arena から確保し、戻る前にアリーナの使用量を呼び出し前へ戻します。
+     *  アリーナのブロックが必要な大きさまで育った後は、記述子ごとの初回利用を除いて動的確保を行いません。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      text テキストです。NUL 終端は不要です。
+     *  @param[in]      length テキストのバイト数です。
+     *  @param[in,out]  instance 読み込み先です。
+     *  @param[in,out]  arena 一時領域の確保元です。
+     *  @return         struct_meta_json_reader_value() と同じ結果コードを返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じアリーナを並行して使わず、同じインスタンスを並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_decode_text_arena(
+        const struct_meta_descriptor *descriptor, const char *text, size_t length, void *instance,
+        struct_meta_arena *arena);
+
+    /**
+     *  @brief          JSON テキストを構造体へ読み込み、エラーの場合は読み込み前の内容へ戻します。
+     *
+     *  struct_meta_json_decode_text() と同じ値を読み込みます。
+     *  フィールドへ書き込む前に、そのフィールドが占める範囲の内容を取り消しログへ記録し、
+     *  エラーの場合は記録を逆順に書き戻します。構造体全体の複写は行わないため、
+     *  大きな構造体の一部のフィールドだけを更新するテキストでは、一時領域へ読み込んでから置き換えるより転送量が少なくなります。
+     *  文字列と可変長配列は、置き換える前の領域を成功した場合に限り解放し、
+     *  エラーの場合は新しく確保した領域を解放します。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      text テキストです。NUL 終端は不要です。
+     *  @param[in]      length テキストのバイト数です。
+     *  @param[in,out]  instance 読み込み先です。エラーの場合は呼び出し前の内容のままです。
+     *  @param[in,out]  undo 取り消しログの作業領域です。NULL の場合は関数内で確保して解放します。
+     *                  同じバッファーを繰り返し渡すと、確保済みの領域を再利用します。戻った時点の内容は空です。
+     *  @return         struct_meta_json_reader_value() と同じ結果コードを返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じ作業領域を並行して使わず、同じインスタンスを並行して参照、変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_decode_text_atomic(
+        const struct_meta_descriptor *descriptor, const char *text, size_t length, void *instance,
+        struct_meta_buffer *undo);
+
+    /**
+     *  @brief          現在のインスタンスの複写へ JSON テキストを読み込み、成功した場合だけポインターを置き換えます。
+     *
+     *  @p *current の内容を @p *shadow へ複写し、struct_meta_json_decode_text() と同じ規則で @p *shadow へ読み込みます。
+     *  成功した場合は @p *current を release 順序で @p *shadow へ置き換え、それまでのインスタンスを @p *shadow へ返します。
+     *  エラーの場合は @p *current も @p *shadow の指す先も変更しません (@p *shadow の内容は不定です)。
+     *  文字列と可変長配列を持つ記述子は、複写した領域を 2 個のインスタンスで共有してしまうため、
+     *  @c COM_UTIL_ERR_UNSUPPORTED を返します。
+
+     *  他のスレッドは @p *current を acquire 順序で読み取れば、読み込みを終えたインスタンスだけを参照します。
+     *  返されたそれまでのインスタンスを次の呼び出しで再利用する場合は、それを参照中のスレッドがないことを呼び出し側で保証します。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      text テキストです。NUL 終端は不要です。
+     *  @param[in]      length テキストのバイト数です。
+     *  @param[in,out]  current 公開中のインスタンスを指すポインターです。
+     *  @param[in,out]  shadow 読み込みに使う記述子の size バイトの領域を指すポインターです。
+     *                  成功した場合は、それまでのインスタンスを指します。
+     *  @return         struct_meta_json_reader_value() と同じ結果コード、
+     *                  または @c COM_UTIL_ERR_UNSUPPORTED を返します。
+     *
+     *  @par            スレッド セーフ
+     *  @p current を置き換える呼び出しが同時に 1 個だけの場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_decode_text_swap(const struct_meta_descriptor *descriptor,
+                                                                             const char *text, size_t length,
+                                                                             void **current, void **shadow);
+
+    /**
+     *  @brief          記述子に従って、次の JSON 配列を構造体配列へ読み込みます。
+     *
+     *  各要素は struct_meta_json_reader_value() と同じ規則で読み込みます。
+     *  記述子の検査と JSON キー索引の取得は、配列全体で 1 回だけ行います。\n
+     *  読み込み先は書き込む前の値を持たない領域として扱うため、文字列と可変長配列を持つ記述子は扱いません。
+     *
+     *  @param[in,out]  reader 対象です。
+     *  @param[in]      descriptor 要素の記述子です。
+     *  @param[out]     base 読み込み先の配列の先頭です。@p capacity が 0 の場合に限り NULL を指定できます。
+     *  @param[in]      capacity 読み込み先の要素数です。
+     *  @param[in]      stride 要素間のバイト数です。0 の場合は記述子の size を使います。
+     *  @param[out]     count_out 読み込みを終えた要素数です。エラーの場合も、それまでに読み込んだ要素数を格納します。
+     *  @return         @c COM_UTIL_OK、struct_meta_json_reader_value() と同じ結果コード、
+     *                  要素数が @p capacity を超える場合は @c COM_UTIL_ERR_BUFFER_TOO_SMALL、
+     *                  記述子が文字列か可変長配列を持つ場合は @c COM_UTIL_ERR_UNSUPPORTED を返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じ読み取り状態を並行して使わず、同じ配列を並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_reader_array(struct_meta_json_reader *reader,
+                                                                         const struct_meta_descriptor *descriptor,
+                                                                         void *base, size_t capacity, size_t stride,
+                                                                         size_t *count_out);
+
+    /**
+     *  @brief          JSON 配列のテキストを構造体配列へ直接読み込みます。
+     *
+     *  @p thread_count が 1 の場合は struct_meta_json_reader_array() と同じく先頭から順に読み込みます。
+     *  それ以外の場合は、先に最上位の要素の境界を走査し、要素を連続した範囲に分けて複数スレッドで読み込みます。
+     *  要素が少ない場合は、1 スレッドあたり一定数以上の要素を受け持つようスレッド数を減らします。\n
+     *  エラーの場合は要素の順で最初のエラーを返し、@p count_out にその要素の添字を格納します。
+     *  並行読み込みでは、それより後ろの要素も書き込まれていることがあります。
+     *
+     *  @param[in]      descriptor 要素の記述子です。
+     *  @param[in]      text テキストです。NUL 終端は不要です。
+     *  @param[in]      length テキストのバイト数です。
+     *  @param[out]     base 読み込み先の配列の先頭です。
+     *  @param[in]      capacity 読み込み先の要素数です。
+     *  @param[in]      stride 要素間のバイト数です。0 の場合は記述子の size を使います。
+     *  @param[in]      thread_count 使用するスレッド数の上限です。0 の場合はオンラインの CPU 数です。
+     *  @param[out]     count_out 読み込んだ要素数です。
+     *  @return         struct_meta_json_reader_array() と同じ結果コードを返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_decode_text_array(const struct_meta_descriptor *descriptor,
+                                                                              const char *text, size_t length,
+                                                                              void *base, size_t capacity,
+                                                                              size_t stride, size_t thread_count,
+                                                                              size_t *count_out);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/** @} */
+
+#endif /* STRUCT_META_JSON_READER_H */
@@ -0,0 +1,258 @@
+/**
+ *******************************************************************************
+ *  @file           writer.h
+ *  @brief          cJSON のオブジェクトを作らずに、構造体を JSON テキストへ直接書き出します。
+ *
+ *  出力は cJSON_Print() (整形) または cJSON_PrintUnformatted() (空白なし) と同じバイト列です。
+ *  int、unsigned、float、double の数値は cJSON と同じく double として書式化します。
+ *  固定幅の整数と列挙は double を経由せずに十進表記で書き出すため、64 ビットの値も丸めません。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_JSON_WRITER_H
+#define STRUCT_META_JSON_WRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <struct_meta/memory/buffer.h>
+#include <struct_meta/meta/meta.h>
+
+/**
+ *  @addtogroup STRUCT_META_PUBLIC_API
+ *  @{
+ */
+
+/** ストリームへ書き出す前にためるバイト数です。 */
+#define STRUCT_META_JSON_WRITER_CHUNK_SIZE 4096U
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /** JSON テキストの書式です。 */
+    typedef enum struct_meta_json_format
+    {
+        STRUCT_META_JSON_FORMAT_PRETTY = 0, /**< cJSON_Print() と同じく、タブと改行で整形します。 */
+        STRUCT_META_JSON_FORMAT_COMPACT = 1 /**< cJSON_PrintUnformatted() と同じく、空白を入れません。 */
+    } struct_meta_json_format;
+
+    /**
+     *  @brief          JSON テキストの書き出し状態です。
+     *
+     *  struct_meta_json_writer_init_buffer() または struct_meta_json_writer_init_stream() で初期化します。
+     *  動的確保を行わないため、呼び出し側のスタックへ置けます。\n
+     *  最初に発生したエラーを保持し、以降の書き出しは何もせずにそのエラーを返します。
+     */
+    typedef struct struct_meta_json_writer
+    {
+        struct_meta_buffer *buffer;     /**< 追記先のバッファーです。ストリームへ書き出す場合は NULL です。 */
+        FILE *stream;                   /**< 書き出し先のストリームです。バッファーへ追記する場合は NULL です。 */
+        size_t depth;                   /**< 現在のコンテナーの入れ子の深さです。 */
+        size_t chunk_length;            /**< @p chunk にためたバイト数です。 */
+        struct_meta_json_format format; /**< 書式です。 */
+        int result;                     /**< 最初に発生したエラーです。エラーがなければ @c COM_UTIL_OK です。 */
+        int first;                      /**< 現在のコンテナーへまだ値を書いていない場合は 0 以外です。 */
+        int after_key;                  /**< キーを書き、その値を待っている場合は 0 以外です。 */
+        unsigned char chunk[STRUCT_META_JSON_WRITER_CHUNK_SIZE]; /**< ストリーム向けの書き出し待ちです。 */
+    } struct_meta_json_writer;
+
+    /**
+     *  @brief          バッファーの末尾へ追記するように初期化します。
+     *  @param[out]     writer 対象です。
+     *  @param[in,out]  buffer 追記先です。既存の内容は保持します。
+     *  @param[in]      format 書式です。
+     *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_init_buffer(struct_meta_json_writer *writer,
+                                                                               struct_meta_buffer *buffer,
+                                                                               struct_meta_json_format format);
+
+    /**
+     *  @brief          ストリームへ書き出すように初期化します。
+     *
+     *  書き出しは @c STRUCT_META_JSON_WRITER_CHUNK_SIZE バイト単位でまとめます。
+     *  最後に struct_meta_json_writer_flush() を呼び出してください。
+     *
+     *  @param[out]     writer 対象です。
+     *  @param[in,out]  stream 書き出し先です。
+     *  @param[in]      format 書式です。
+     *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_init_stream(struct_meta_json_writer *writer,
+                                                                               FILE *stream,
+                                                                               struct_meta_json_format format);
+
+    /**
+     *  @brief          ためた出力をストリームへ書き出します。
+     *  @param[in,out]  writer 対象です。
+     *  @return         @c COM_UTIL_OK、またはこれまでに発生した最初のエラーを返します。
+     *                  ストリームへの書き出しに失敗した場合は @c COM_UTIL_ERR_UNKNOWN です。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_flush(struct_meta_json_writer *writer);
+
+    /** @brief オブジェクトを開始します。@param[in,out] writer 対象です。@return 結果コードです。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_begin_object(struct_meta_json_writer *writer);
+    /** @brief オブジェクトを終了します。@param[in,out] writer 対象です。@return 結果コードです。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_end_object(struct_meta_json_writer *writer);
+    /** @brief 配列を開始します。@param[in,out] writer 対象です。@return 結果コードです。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_begin_array(struct_meta_json_writer *writer);
+    /** @brief 配列を終了します。@param[in,out] writer 対象です。@return 結果コードです。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_end_array(struct_meta_json_writer *writer);
+    /** @brief オブジェクトのキーを書き出します。@param[in,out] writer 対象です。@param[in] key キーです。@return 結果コードです。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_key(struct_meta_json_writer *writer,
+                                                                       const char *key);
+    /** @brief 文字列値を書き出します。@param[in,out] writer 対象です。@param[in] text NUL 終端文字列です。@return 結果コードです。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_string(struct_meta_json_writer *writer,
+                                                                          const char *text);
+    /**
+     *  @brief          char 配列の値を文字列値として書き出します。
+     *
+     *  最初の NUL の手前までを書き出します。NUL がない場合は @p capacity バイトすべてを書き出し、
+     *  配列の外は読みません。記述子の @c STRUCT_META_FIELD_CHAR_ARRAY と同じ扱いです。
+     *
+     *  @param[in,out]  writer 対象です。
+     *  @param[in]      text char 配列の先頭です。@p capacity が 0 の場合に限り NULL を指定できます。
+     *  @param[in]      capacity char 配列のバイト数です。
+     *  @return         結果コードです。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_chars(struct_meta_json_writer *writer,
+                                                                         const char *text, size_t capacity);
+    /** @brief 数値を cJSON と同じ書式で書き出します。@param[in,out] writer 対象です。@param[in] value 値です。@return 結果コードです。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_number(struct_meta_json_writer *writer,
+                                                                          double value);
+    /**
+     *  @brief          符号付き 64 ビット整数を十進表記で書き出します。
+     *
+     *  struct_meta_json_writer_number() と異なり double を経由しないため、
+     *  絶対値が 2^53 を超える値も丸めずに書き出します。
+     *
+     *  @param[in,out]  writer 対象です。
+     *  @param[in]      value 値です。
+     *  @return         結果コードです。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_int64(struct_meta_json_writer *writer,
+                                                                         int64_t value);
+    /** @brief 符号なし 64 ビット整数を十進表記で書き出します。@param[in,out] writer 対象です。@param[in] value 値です。@return 結果コードです。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_uint64(struct_meta_json_writer *writer,
+                                                                          uint64_t value);
+    /** @brief `true` または `false` を書き出します。@param[in,out] writer 対象です。@param[in] value 0 以外なら `true` です。@return 結果コードです。 */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_bool(struct_meta_json_writer *writer, int value);
+
+    /**
+     *  @brief          記述子に従って構造体 1 個分を JSON オブジェクトとして書き出します。
+     *
+     *  struct_meta_json_encode() と同じく `json.name` と `json.ignore` を解釈します。
+     *  オブジェクトのキーの後や配列の中で呼び出すと、その値として書き出します。
+     *
+     *  @param[in,out]  writer 対象です。
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      instance 構造体です。
+     *  @return         @c COM_UTIL_OK、または struct_meta_json_encode() と同じ結果コードを返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じ書き出し状態を並行して使わず、同じインスタンスを並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_value(struct_meta_json_writer *writer,
+                                                                         const struct_meta_descriptor *descriptor,
+                                                                         const void *instance);
+
+    /**
+     *  @brief          構造体を JSON テキストへ変換し、バッファーの末尾へ追記します。
+     *
+     *  出力は struct_meta_json_encode() の結果を cJSON_Print() (または cJSON_PrintUnformatted()) した
+     *  テキストと同じです。失敗した場合、バッファーの内容は呼び出し前に戻します。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      instance 構造体です。
+     *  @param[in]      format 書式です。
+     *  @param[in,out]  buffer 追記先です。
+     *  @return         @c COM_UTIL_OK、または struct_meta_json_encode() と同じ結果コードを返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じバッファーを並行して使わず、同じインスタンスを並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_write_buffer(const struct_meta_descriptor *descriptor,
+                                                                         const void *instance,
+                                                                         struct_meta_json_format format,
+                                                                         struct_meta_buffer *buffer);
+
+    /**
+     *  @brief          構造体を JSON テキストへ変換し、ストリームへ書き出します。
+     *
+     *  失敗した場合、途中までのテキストがストリームへ書き出されていることがあります。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      instance 構造体です。
+     *  @param[in]      format 書式です。
+     *  @param[in,out]  stream 書き出し先です。
+     *  @return         @c COM_UTIL_OK、struct_meta_json_encode() と同じ結果コード、
+     *                  またはストリームへの書き出しに失敗した場合は @c COM_UTIL_ERR_UNKNOWN を返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じストリームを並行して使わず、同じインスタンスを並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_write_stream(const struct_meta_descriptor *descriptor,
+                                                                         const void *instance,
+                                                                         struct_meta_json_format format,
+                                                                         FILE *stream);
+
+    /**
+     *  @brief          記述子に従って構造体配列を JSON 配列として書き出します。
+     *
+     *  出力は、各要素を struct_meta_json_writer_value() で書き出した配列と同じです。
+     *  記述子の検査と JSON キー索引の取得は、配列全体で 1 回だけ行います。\n
+     *  @p thread_count が 1 以外の場合は、要素を連続した範囲に分けて複数スレッドで書き出し、要素の順に連結します。
+     *  要素が少ない場合は、1 スレッドあたり一定数以上の要素を受け持つようスレッド数を減らします。
+     *  並行書き出しでは、スレッドごとの書き出し結果を連結するまでメモリー上に保持します。
+     *
+     *  @param[in,out]  writer 対象です。
+     *  @param[in]      descriptor 要素の記述子です。
+     *  @param[in]      base 配列の先頭です。@p count が 0 の場合に限り NULL を指定できます。
+     *  @param[in]      count 要素数です。
+     *  @param[in]      stride 要素間のバイト数です。0 の場合は記述子の size を使います。
+     *  @param[in]      thread_count 使用するスレッド数の上限です。0 の場合はオンラインの CPU 数です。
+     *  @return         @c COM_UTIL_OK、または struct_meta_json_writer_value() と同じ結果コードを返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じ書き出し状態を並行して使わず、同じ配列を並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_writer_array(struct_meta_json_writer *writer,
+                                                                         const struct_meta_descriptor *descriptor,
+                                                                         const void *base, size_t count,
+                                                                         size_t stride, size_t thread_count);
+
+    /**
+     *  @brief          構造体配列を JSON 配列のテキストへ変換し、バッファーの末尾へ追記します。
+     *
+     *  出力は struct_meta_json_encode_array() の結果を cJSON_Print() (または cJSON_PrintUnformatted()) した
+     *  テキストと同じです。失敗した場合、バッファーの内容は呼び出し前に戻します。
+     *
+     *  @param[in]      descriptor 要素の記述子です。
+     *  @param[in]      base 配列の先頭です。
+     *  @param[in]      count 要素数です。
+     *  @param[in]      stride 要素間のバイト数です。0 の場合は記述子の size を使います。
+     *  @param[in]      format 書式です。
+     *  @param[in]      thread_count 使用するスレッド数の上限です。0 の場合はオンラインの CPU 数です。
+     *  @param[in,out]  buffer 追記先です。
+     *  @return         struct_meta_json_writer_array() と同じ結果コードを返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_json_write_array_buffer(const struct_meta_descriptor *descriptor,
+                                                                               const void *base, size_t count,
+                                                                               size_t stride,
+                                                                               struct_meta_json_format format,
+                                                                               size_t thread_count,
+                                                                               struct_meta_buffer *buffer);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/** @} */
+
+#endif /* STRUCT_META_JSON_WRITER_H */
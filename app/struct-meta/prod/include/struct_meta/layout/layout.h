@@ -0,0 +1,129 @@
+/**
+ *******************************************************************************
+ *  @file           layout.h
+ *  @brief          記述子のオフセットとサイズから、構造体のパディング、キャッシュ ラインの配置、並べ替え案を求めます。
+ *
+ *  構造体の先頭がキャッシュ ラインの境界にあるものとして、各フィールドが占めるライン番号を求めます。\n
+ *  境界 (アラインメント) は記述子に無いため、フィールド種別に対応するホストの型の境界から推定します。
+ *  ネスト構造体はフィールドの境界の最大値、char 配列は 1 とします。
+ *  記述子に含まれないメンバーの領域は、パディングとして数えます。
+ *
+ *  フィールドの拡張属性 `layout.hot` と `layout.cold` で、頻繁に参照する値とまれに参照する値を指定できます。
+ *  並べ替え案は hot、無指定、cold の順にまとめ、各グループ内を境界の大きい順に並べます。
+ *  グループ内の並びはパディングを最小にしますが、グループの境目には詰め物が入ることがあります。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_LAYOUT_LAYOUT_H
+#define STRUCT_META_LAYOUT_LAYOUT_H
+
+#include <stdio.h>
+
+#include <struct_meta/meta/meta.h>
+
+/**
+ *  @addtogroup STRUCT_META_PUBLIC_API
+ *  @{
+ */
+
+/** 配置の分析で仮定するキャッシュ ラインのバイト数です。 */
+#define STRUCT_META_LAYOUT_CACHE_LINE_SIZE 64U
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /**
+     *  @brief          参照頻度によるフィールドのグループです。
+     */
+    typedef enum struct_meta_layout_group
+    {
+        STRUCT_META_LAYOUT_HOT = 0,    /**< `layout.hot` 属性を持つフィールドです。 */
+        STRUCT_META_LAYOUT_NORMAL = 1, /**< 属性を持たないフィールドです。 */
+        STRUCT_META_LAYOUT_COLD = 2    /**< `layout.cold` 属性を持つフィールドです。 */
+    } struct_meta_layout_group;
+
+    /**
+     *  @brief          フィールド 1 個の配置です。
+     */
+    typedef struct struct_meta_layout_field
+    {
+        const struct_meta_field *field; /**< フィールド記述子です。 */
+        size_t offset;                  /**< 構造体の先頭からのバイト オフセットです。 */
+        size_t size;                    /**< 構造体内で占めるバイト数です。可変長配列では items と count の組です。 */
+        size_t alignment;               /**< 推定した境界のバイト数です。 */
+        size_t padding_before;          /**< 直前のフィールドの末尾からこのフィールドまでの未使用バイト数です。 */
+        size_t first_cache_line;        /**< 先頭バイトのキャッシュ ライン番号です。 */
+        size_t last_cache_line;         /**< 末尾バイトのキャッシュ ライン番号です。先頭と異なればまたぎます。 */
+        size_t suggested_offset;        /**< 並べ替え案でのオフセットです。 */
+        struct_meta_layout_group group; /**< 参照頻度のグループです。 */
+        unsigned int pad;               /**< 明示的アラインメントです。 */
+    } struct_meta_layout_field;
+
+    /**
+     *  @brief          構造体全体の配置の集計です。
+     */
+    typedef struct struct_meta_layout_report
+    {
+        size_t size;                      /**< 構造体のバイト数です。 */
+        size_t alignment;                 /**< 推定した構造体の境界のバイト数です。 */
+        size_t padding;                   /**< フィールド間と末尾の未使用バイト数の合計です。 */
+        size_t trailing_padding;          /**< 最後のフィールドより後ろの未使用バイト数です。 */
+        size_t cache_lines;               /**< 構造体が占めるキャッシュ ライン数です。 */
+        size_t hot_cache_lines;           /**< hot のフィールドが触れるキャッシュ ライン数です。 */
+        size_t suggested_size;            /**< 並べ替え案での構造体のバイト数です。 */
+        size_t suggested_padding;         /**< 並べ替え案での未使用バイト数の合計です。 */
+        size_t suggested_cache_lines;     /**< 並べ替え案で構造体が占めるキャッシュ ライン数です。 */
+        size_t suggested_hot_cache_lines; /**< 並べ替え案で hot のフィールドが触れるキャッシュ ライン数です。 */
+    } struct_meta_layout_report;
+
+    /**
+     *  @brief          構造体の配置を分析します。
+     *
+     *  @p fields_out には、フィールドをオフセットの昇順 (同じオフセットでは記述子の順) に格納します。
+     *  並べ替え案の順序は、suggested_offset の昇順です。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[out]     fields_out フィールドごとの配置です。NULL の場合は集計だけを求めます。
+     *  @param[in]      field_capacity @p fields_out の要素数です。
+     *                  NULL でない場合は記述子のフィールド数以上でなければなりません。
+     *  @param[out]     report_out 集計です。
+     *  @return         @c COM_UTIL_OK、@c COM_UTIL_ERR_INVALID_ARGUMENT、
+     *                  @p field_capacity が不足する場合は @c COM_UTIL_ERR_BUFFER_TOO_SMALL、
+     *                  @c COM_UTIL_ERR_OUT_OF_MEMORY、または記述子の検査エラーを返します。
+     *
+     *  @par            スレッド セーフ
+     *  共有状態を変更しません。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_layout_analyze(const struct_meta_descriptor *descriptor,
+                                                                      struct_meta_layout_field *fields_out,
+                                                                      size_t field_capacity,
+                                                                      struct_meta_layout_report *report_out);
+
+    /**
+     *  @brief          構造体と、そのネスト先の型ごとの配置をテキストで書き出します。
+     *
+     *  型ごとに、オフセット順のフィールド表 (サイズ、境界、直前のパディング、キャッシュ ライン、グループ)、
+     *  末尾のパディング、並べ替え案とその集計を書き出します。同じネスト先の型は 1 回だけ書き出します。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      stream 出力先です。
+     *  @return         struct_meta_layout_analyze() と同じ結果コードを返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じ出力先へ並行して書き出さない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_layout_write(const struct_meta_descriptor *descriptor,
+                                                                    FILE *stream);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/** @} */
+
+#endif /* STRUCT_META_LAYOUT_LAYOUT_H */
@@ -0,0 +1,70 @@
+/**
+ *******************************************************************************
+ *  @file           allocator.h
+ *  @brief          文字列 (char *) と可変長配列のフィールドが指す領域を確保、解放するアロケーターです。
+ *
+ *  書き戻しは、文字列と可変長配列の領域を値の長さちょうどで確保します。\n
+ *  アロケーターを省略 (NULL) した場合は malloc() と free() を使います。
+ *  struct_meta_arena_allocator() で作るアロケーターはアリーナから切り出し、個別には解放しません。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_MEMORY_ALLOCATOR_H
+#define STRUCT_META_MEMORY_ALLOCATOR_H
+
+#include <stddef.h>
+
+#include <struct_meta/meta/meta.h>
+#include <struct_meta/struct_meta_export.h>
+
+/**
+ *  @addtogroup STRUCT_META_PUBLIC_API
+ *  @{
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /**
+     *  @brief          動的フィールドの領域を確保、解放する関数の組です。
+     */
+    typedef struct struct_meta_allocator
+    {
+        /** @brief 任意の型に使える境界の領域を @p size バイト確保します。失敗時は NULL を返します。 */
+        void *(*allocate)(void *context, size_t size);
+        /** @brief @p allocate で確保した領域を解放します。NULL の場合は個別に解放しません。 */
+        void (*release)(void *context, void *data);
+        void *context; /**< 各関数へ渡す値です。 */
+    } struct_meta_allocator;
+
+    /**
+     *  @brief          構造体インスタンスの文字列と可変長配列の領域をすべて解放し、空の値へ戻します。
+     *
+     *  ネストした構造体と可変長配列の要素もたどります。
+     *  解放後の文字列は NULL、可変長配列は items が NULL で count が 0 です。その他のフィールドは変更しません。
+     *
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in,out]  instance 対象です。
+     *                  動的フィールドは NULL (要素数 0) か、@p allocator で確保した値でなければなりません。
+     *  @param[in]      allocator 領域を確保したアロケーターです。NULL の場合は free() で解放します。
+     *  @return         @c COM_UTIL_OK、@c COM_UTIL_ERR_INVALID_ARGUMENT、または記述子の検査エラーを返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じインスタンスを並行して参照、変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_instance_release(const struct_meta_descriptor *descriptor,
+                                                                        void *instance,
+                                                                        const struct_meta_allocator *allocator);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/** @} */
+
+#endif /* STRUCT_META_MEMORY_ALLOCATOR_H */
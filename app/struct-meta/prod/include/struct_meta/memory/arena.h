@@ -0,0 +1,155 @@
+/**
+ *******************************************************************************
+ *  @file           arena.h
+ *  @brief          一時領域をまとめて確保し、まとめて手放すバンプ アロケーターです。
+ *
+ *  要求ごとに多数のメッセージを読み込む処理で、読み込み中の一時領域 (ストリームの窓、
+ *  エスケープ展開用の領域など) を 1 個の領域から切り出すために使います。\n
+ *  確保は現在のブロックの使用量を進めるだけで、個別の解放はありません。
+ *  struct_meta_arena_reset() と struct_meta_arena_rewind() はブロックを保持したまま使用量を戻すため、
+ *  一度必要な大きさまで育った後は、システムのアロケーターを呼び出しません。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_MEMORY_ARENA_H
+#define STRUCT_META_MEMORY_ARENA_H
+
+#include <stddef.h>
+
+#include <struct_meta/memory/allocator.h>
+#include <struct_meta/struct_meta_export.h>
+
+/**
+ *  @addtogroup STRUCT_META_PUBLIC_API
+ *  @{
+ */
+
+/** ブロックの大きさを省略した場合の既定値です。 */
+#define STRUCT_META_ARENA_DEFAULT_BLOCK_SIZE 65536U
+
+/** struct_meta_arena_alloc() が返す領域の境界です。 */
+#define STRUCT_META_ARENA_ALIGNMENT 16U
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /** アリーナのブロックです。内容は実装で定義します。 */
+    typedef struct struct_meta_arena_block struct_meta_arena_block;
+
+    /**
+     *  @brief          バンプ アロケーターです。
+     *
+     *  struct_meta_arena_init() で初期化し、struct_meta_arena_dispose() で解放します。\n
+     *  ブロックは確保順に連結し、使用量を戻した後は先頭のブロックから再利用します。
+     */
+    typedef struct struct_meta_arena
+    {
+        struct_meta_arena_block *first;   /**< 最初のブロックです。未確保の場合は NULL です。 */
+        struct_meta_arena_block *current; /**< 確保中のブロックです。未確保の場合は NULL です。 */
+        size_t used;                      /**< @p current の使用済みバイト数です。 */
+        size_t block_size;                /**< 新しく確保するブロックの最小バイト数です。 */
+        size_t block_count;               /**< システムのアロケーターから確保したブロックの累計数です。 */
+    } struct_meta_arena;
+
+    /**
+     *  @brief          アリーナの使用位置です。
+     *
+     *  struct_meta_arena_save() で取得し、struct_meta_arena_rewind() でその時点へ戻します。
+     */
+    typedef struct struct_meta_arena_mark
+    {
+        struct_meta_arena_block *block; /**< 取得時の確保中のブロックです。 */
+        size_t used;                    /**< 取得時の使用済みバイト数です。 */
+    } struct_meta_arena_mark;
+
+    /**
+     *  @brief          空のアリーナとして初期化します。ブロックは最初の確保時に確保します。
+     *  @param[out]     arena 対象です。
+     *  @param[in]      block_size ブロックの最小バイト数です。0 の場合は @c STRUCT_META_ARENA_DEFAULT_BLOCK_SIZE です。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_arena_init(struct_meta_arena *arena, size_t block_size);
+
+    /**
+     *  @brief          領域を確保します。
+     *
+     *  領域は @c STRUCT_META_ARENA_ALIGNMENT バイト境界にそろえます。
+     *  現在のブロックに収まらない場合は、連結済みの次のブロックを使い、それにも収まらない場合だけ新しいブロックを確保します。
+     *
+     *  @param[in,out]  arena 対象です。
+     *  @param[in]      size バイト数です。0 の場合も有効なポインターを返します。
+     *  @return         確保した領域です。@p arena が NULL の場合やメモリー不足の場合は NULL です。
+     *
+     *  @par            スレッド セーフ
+     *  同じアリーナを並行して操作しない場合に限りスレッド セーフです。
+     */
+    STRUCT_META_EXPORT void *STRUCT_META_API struct_meta_arena_alloc(struct_meta_arena *arena, size_t size);
+
+    /**
+     *  @brief          確保済みの領域を広げます。
+     *
+     *  @p data が直前に確保した領域で、現在のブロックに余りがある場合はその場で広げます。
+     *  それ以外の場合は新しい領域を確保して内容を複写します。元の領域は使用量を戻すまで残ります。
+     *
+     *  @param[in,out]  arena 対象です。
+     *  @param[in]      data 広げる領域です。NULL の場合は struct_meta_arena_alloc() と同じです。
+     *  @param[in]      old_size @p data のバイト数です。
+     *  @param[in]      new_size 広げた後のバイト数です。
+     *  @return         広げた領域です。メモリー不足の場合は NULL を返し、@p data は変更しません。
+     */
+    STRUCT_META_EXPORT void *STRUCT_META_API struct_meta_arena_grow(struct_meta_arena *arena, void *data,
+                                                                    size_t old_size, size_t new_size);
+
+    /**
+     *  @brief          現在の使用位置を取得します。
+     *  @param[in]      arena 対象です。
+     *  @return         使用位置です。
+     */
+    STRUCT_META_EXPORT struct_meta_arena_mark STRUCT_META_API struct_meta_arena_save(const struct_meta_arena *arena);
+
+    /**
+     *  @brief          使用位置を struct_meta_arena_save() の時点へ戻します。
+     *
+     *  その後に確保した領域はすべて無効になります。ブロックは解放しません。
+     *
+     *  @param[in,out]  arena 対象です。
+     *  @param[in]      mark 戻す先の使用位置です。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_arena_rewind(struct_meta_arena *arena,
+                                                                     struct_meta_arena_mark mark);
+
+    /**
+     *  @brief          ブロックを保持したまま、確保した領域をすべて手放します。
+     *  @param[in,out]  arena 対象です。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_arena_reset(struct_meta_arena *arena);
+
+    /**
+     *  @brief          アリーナから領域を切り出すアロケーターを作成します。
+     *
+     *  書き戻しで確保する文字列と可変長配列の領域を、struct_meta_arena_alloc() で切り出します。
+     *  個別の解放は行わないため、領域はアリーナの使用量を戻すまで残ります。
+     *
+     *  @param[in]      arena 切り出し元です。アロケーターを使い終えるまで破棄してはなりません。
+     *  @param[out]     allocator_out 作成したアロケーターです。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_arena_allocator(struct_meta_arena *arena,
+                                                                        struct_meta_allocator *allocator_out);
+
+    /**
+     *  @brief          ブロックを解放し、空のアリーナへ戻します。
+     *  @param[in,out]  arena 対象です。NULL の場合は何もしません。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_arena_dispose(struct_meta_arena *arena);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/** @} */
+
+#endif /* STRUCT_META_MEMORY_ARENA_H */
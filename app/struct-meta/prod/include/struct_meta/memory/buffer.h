@@ -0,0 +1,110 @@
+/**
+ *******************************************************************************
+ *  @file           buffer.h
+ *  @brief          出力先に使う伸長可能なバイト バッファーです。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_MEMORY_BUFFER_H
+#define STRUCT_META_MEMORY_BUFFER_H
+
+#include <stddef.h>
+
+#include <struct_meta/memory/arena.h>
+#include <struct_meta/struct_meta_export.h>
+
+/**
+ *  @addtogroup STRUCT_META_PUBLIC_API
+ *  @{
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /**
+     *  @brief          伸長可能なバイト バッファーです。
+     *
+     *  追記した内容の直後には常に NUL を 1 バイト置くため、テキストを追記した場合は
+     *  @p data をそのまま C 文字列として参照できます。\n
+     *  struct_meta_buffer_reset() は確保済み領域を保持するため、同じバッファーを再利用すると再確保を避けられます。\n
+     *  struct_meta_buffer_init_arena() で初期化した場合は、領域をアリーナから確保し、解放はアリーナに任せます。
+     */
+    typedef struct struct_meta_buffer
+    {
+        unsigned char *data;      /**< 内容です。未確保の場合は NULL です。 */
+        size_t length;            /**< 内容のバイト数です。末尾の NUL は含みません。 */
+        size_t capacity;          /**< 確保済みのバイト数です。末尾の NUL を含みます。 */
+        struct_meta_arena *arena; /**< 領域の確保元です。NULL の場合は malloc 系の関数で確保します。 */
+    } struct_meta_buffer;
+
+    /**
+     *  @brief          空のバッファーとして初期化します。
+     *  @param[out]     buffer 対象です。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_buffer_init(struct_meta_buffer *buffer);
+
+    /**
+     *  @brief          領域をアリーナから確保する空のバッファーとして初期化します。
+     *
+     *  容量を伸ばす際は struct_meta_arena_grow() を使い、直前に確保した領域であればその場で広げます。
+     *  バッファーの内容は、アリーナの使用量を確保前へ戻すまで有効です。
+     *
+     *  @param[out]     buffer 対象です。
+     *  @param[in,out]  arena 確保元です。NULL の場合は struct_meta_buffer_init() と同じです。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_buffer_init_arena(struct_meta_buffer *buffer,
+                                                                          struct_meta_arena *arena);
+
+    /**
+     *  @brief          追記に備えて領域を確保します。
+     *  @param[in,out]  buffer 対象です。
+     *  @param[in]      additional 現在の内容に続けて追記するバイト数です。
+     *  @return         @c COM_UTIL_OK、@c COM_UTIL_ERR_INVALID_ARGUMENT、または
+     *                  @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じバッファーを並行して操作しない場合に限りスレッド セーフです。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_buffer_reserve(struct_meta_buffer *buffer, size_t additional);
+
+    /**
+     *  @brief          バイト列を末尾へ追記します。
+     *  @param[in,out]  buffer 対象です。
+     *  @param[in]      data 追記する内容です。@p length が 0 の場合は NULL を指定できます。
+     *  @param[in]      length 追記するバイト数です。
+     *  @return         @c COM_UTIL_OK、@c COM_UTIL_ERR_INVALID_ARGUMENT、または
+     *                  @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。失敗時は内容を変更しません。
+     *
+     *  @par            スレッド セーフ
+     *  同じバッファーを並行して操作しない場合に限りスレッド セーフです。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_buffer_append(struct_meta_buffer *buffer, const void *data,
+                                                                     size_t length);
+
+    /**
+     *  @brief          確保済み領域を保持したまま内容を空にします。
+     *  @param[in,out]  buffer 対象です。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_buffer_reset(struct_meta_buffer *buffer);
+
+    /**
+     *  @brief          確保済み領域を解放し、空のバッファーへ戻します。
+     *
+     *  アリーナから確保したバッファーは領域を解放せず、同じアリーナを使う空のバッファーへ戻します。
+     *
+     *  @param[in,out]  buffer 対象です。NULL の場合は何もしません。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_buffer_dispose(struct_meta_buffer *buffer);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/** @} */
+
+#endif /* STRUCT_META_MEMORY_BUFFER_H */
@@ -0,0 +1,119 @@
+/**
+ *******************************************************************************
+ *  @file           catalog.h
+ *  @brief          記述子の一覧 (カタログ) をまとめて検査し、登録します。
+ *
+ *  struct-meta-gen が生成する型一覧 (*_meta_get() / *_meta_count()) のように、
+ *  多数の記述子を起動時に一括で検査する用途を想定しています。\n
+ *  検査に成功した記述子とネスト先は struct_meta_descriptor_seal() と同じくプロセス内に登録するため、
+ *  複数の記述子が共有するネスト先は 1 回だけ検査します。\n
+ *  また、複数の型一覧の構造体名を 1 個の索引へ登録し、どの型一覧の記述子も同じ API で検索できます。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_META_CATALOG_H
+#define STRUCT_META_META_CATALOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <struct_meta/meta/meta.h>
+
+/**
+ *  @addtogroup STRUCT_META_PUBLIC_API
+ *  @{
+ */
+
+/** 型一覧をまたぐ名前索引へ登録できる構造体名の最大数です。 */
+#define STRUCT_META_CATALOG_NAME_CAPACITY 8192U
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /** struct_meta_catalog_validate_all() の実行結果です。 */
+    typedef struct struct_meta_catalog_report
+    {
+        size_t descriptor_count; /**< 一覧の記述子数です。 */
+        size_t validated_count;  /**< 今回の呼び出しで検査し、登録した記述子数です。ネスト先は含みません。 */
+        size_t skipped_count;    /**< 登録済みのため検査を省略した記述子数です。 */
+        size_t failed_index;     /**< 検査に失敗した最初の添字です。すべて成功した場合は @p descriptor_count です。 */
+        size_t thread_count;     /**< 検査に使ったスレッド数です。 */
+        uint64_t elapsed_ns;     /**< 呼び出し全体の所要時間 (ナノ秒) です。時刻を取得できない場合は 0 です。 */
+    } struct_meta_catalog_report;
+
+    /**
+     *  @brief          記述子の一覧をすべて検査し、検査済みとして登録します。
+     *
+     *  各要素に struct_meta_descriptor_seal() を適用するのと同じ結果になります。
+     *  登録済みの記述子とネスト先は検査を省略するため、共有されたネスト先は一覧全体で 1 回だけ検査します。\n
+     *  @p thread_count が 1 以外の場合は、一覧を連続した範囲に分けて複数スレッドで検査します。
+     *  要素数が少ない場合は、スレッド作成のコストを避けるため使うスレッド数を減らします。
+     *
+     *  1 個の記述子で失敗しても、他の範囲の検査は続けます。
+     *  失敗した記述子より前の要素は、すべて登録済みになります。
+     *
+     *  @param[in]      descriptors 記述子の配列です。@p count が 0 の場合は NULL を指定できます。
+     *  @param[in]      count @p descriptors の要素数です。
+     *  @param[in]      thread_count 使用するスレッド数の上限です。0 の場合はオンラインの CPU 数です。
+     *  @param[out]     report_out 実行結果です。不要な場合は NULL を指定します。エラーの場合も格納します。
+     *  @return         @c COM_UTIL_OK、または最初に失敗した記述子について
+     *                  struct_meta_descriptor_validate() と同じ結果コードを返します。
+     *                  配列の要素が NULL の場合は @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。同じ一覧を複数スレッドから並行して検査できます。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_catalog_validate_all(
+        const struct_meta_descriptor *const *descriptors, size_t count, size_t thread_count,
+        struct_meta_catalog_report *report_out);
+
+    /**
+     *  @brief          型一覧の記述子を、構造体名でプロセス内の名前索引へ登録します。
+     *
+     *  複数の型一覧を登録すると、struct_meta_catalog_find() はすべての型一覧から検索します。
+     *  記述子の検査は行いません。必要に応じて struct_meta_catalog_validate_all() を併用します。\n
+     *  登録した記述子と構造体名の文字列は、プロセス終了まで変更も解放もしてはなりません。
+     *
+     *  同じ記述子を再登録した場合は何もしません。
+     *  登録済みの構造体名を持つ別の記述子は登録せず、先に登録した記述子を検索結果として残します。
+     *
+     *  @param[in]      descriptors 記述子の配列です。@p count が 0 の場合は NULL を指定できます。
+     *  @param[in]      count @p descriptors の要素数です。
+     *  @return         すべて登録した場合は @c COM_UTIL_OK、
+     *                  構造体名の重複や @c STRUCT_META_CATALOG_NAME_CAPACITY の超過により
+     *                  登録しなかった記述子がある場合は @c COM_UTIL_SKIPPED、
+     *                  配列や要素、構造体名が NULL の場合は @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。検索と並行して登録できます。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_catalog_register(
+        const struct_meta_descriptor *const *descriptors, size_t count);
+
+    /**
+     *  @brief          登録済みの型一覧から、構造体名で記述子を検索します。
+     *
+     *  名前のハッシュ値で索引を引くため、登録した記述子の数によらずほぼ一定の時間で検索します。
+     *
+     *  @param[in]      name 構造体名です。NUL 終端は不要です。
+     *  @param[in]      name_length 構造体名のバイト数です。
+     *  @return         一致した記述子です。見つからない場合や @p name が NULL の場合は NULL です。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    STRUCT_META_EXPORT const struct_meta_descriptor *STRUCT_META_API struct_meta_catalog_find(const char *name,
+                                                                                             size_t name_length);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/** @} */
+
+#endif /* STRUCT_META_META_CATALOG_H */
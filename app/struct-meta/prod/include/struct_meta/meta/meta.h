@@ -25,12 +25,28 @@
  *  @{
  */
 
+/** 要素の型が @p type の可変長配列メンバーを宣言する型です (@ref struct_meta_sequence と同じ配置)。 */
+#define STRUCT_META_SEQUENCE(type)                                                                                   \
+    struct                                                                                                           \
+    {                                                                                                                \
+        type *items;                                                                                                 \
+        size_t count;                                                                                                \
+    }
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif /* __cplusplus */
 
-    /** フィールド値の種別です。 */
+    /**
+     *  @brief          フィールド値の種別です。
+     *
+     *  int32_t と uint32_t は、int と unsigned int が 32 ビットの環境を前提に
+     *  @c STRUCT_META_FIELD_INT と @c STRUCT_META_FIELD_UNSIGNED で表します。\n
+     *  固定幅の整数と bool の要素のバイト数は型の幅と一致しなければなりません。
+     *  列挙型の幅はコンパイラーが決めるため、1、2、4、8 バイトのいずれかを受け付けます。\n
+     *  文字列 (char *) の要素のバイト数は sizeof(char *) でなければなりません。
+     */
     typedef enum struct_meta_field_kind
     {
         STRUCT_META_FIELD_INT = 0,        /**< int 値です。 */
@@ -38,9 +54,45 @@ extern "C"
         STRUCT_META_FIELD_FLOAT = 2,      /**< float 値です。 */
         STRUCT_META_FIELD_DOUBLE = 3,     /**< double 値です。 */
         STRUCT_META_FIELD_CHAR_ARRAY = 4, /**< NUL 終端文字列として扱う char 配列です。 */
-        STRUCT_META_FIELD_STRUCT = 5      /**< ネストした構造体です。 */
+        STRUCT_META_FIELD_STRUCT = 5,     /**< ネストした構造体です。 */
+        STRUCT_META_FIELD_INT8 = 6,       /**< int8_t 値です。 */
+        STRUCT_META_FIELD_INT16 = 7,      /**< int16_t 値です。 */
+        STRUCT_META_FIELD_INT64 = 8,      /**< int64_t 値です。 */
+        STRUCT_META_FIELD_UINT8 = 9,      /**< uint8_t 値です。 */
+        STRUCT_META_FIELD_UINT16 = 10,    /**< uint16_t 値です。 */
+        STRUCT_META_FIELD_UINT64 = 11,    /**< uint64_t 値です。 */
+        STRUCT_META_FIELD_BOOL = 12,      /**< bool 値です。 */
+        STRUCT_META_FIELD_ENUM = 13,      /**< 列挙型の値です。符号付き整数として扱います。 */
+        STRUCT_META_FIELD_STRING = 14     /**< NUL 終端文字列を指す char * です。NULL は値なしです。 */
     } struct_meta_field_kind;
 
+    /**
+     *  @brief          フィールド値の格納方法です。
+     *
+     *  @c STRUCT_META_STORAGE_SEQUENCE のフィールドは、offset の位置に @ref struct_meta_sequence と同じ配置の
+     *  `{T *items; size_t count;}` を持ち、要素は items が指す別領域に count 個並びます。
+     *  kind、element_size、nested は要素 1 個を表し、element_count は 1 を指定します。
+     *  char 配列 (@c STRUCT_META_FIELD_CHAR_ARRAY) の要素は指定できません。文字列の列には
+     *  @c STRUCT_META_FIELD_STRING (`char **items`) を使います。
+     */
+    typedef enum struct_meta_field_storage
+    {
+        STRUCT_META_STORAGE_INLINE = 0,  /**< 構造体内に element_count 個の要素を並べます。 */
+        STRUCT_META_STORAGE_SEQUENCE = 1 /**< 要素数を実行時に持つ可変長配列です。 */
+    } struct_meta_field_storage;
+
+    /**
+     *  @brief          可変長配列フィールドの配置です。
+     *
+     *  構造体では STRUCT_META_SEQUENCE() で要素の型付きのメンバーを宣言します。
+     *  items は、count が 0 の場合に限り NULL にできます。
+     */
+    typedef struct struct_meta_sequence
+    {
+        void *items;  /**< 要素配列の先頭です。 */
+        size_t count; /**< 要素数です。 */
+    } struct_meta_sequence;
+
     typedef struct struct_meta_descriptor struct_meta_descriptor;
 
     /** フィールドへ付与する拡張属性です。 */
@@ -55,7 +107,7 @@ extern "C"
     {
         const char *name;                        /**< C フィールド名です。 */
         struct_meta_field_kind kind;             /**< フィールド値の種別です。 */
-        unsigned int pad;                        /**< 明示的アラインメントです。0 を指定します。 */
+        unsigned int storage;                    /**< 格納方法 (@ref struct_meta_field_storage) です。 */
         size_t offset;                           /**< 親構造体の先頭からのバイト オフセットです。 */
         size_t element_size;                     /**< 配列要素 1 個のバイト数です。 */
         size_t element_count;                    /**< 要素数です。スカラーでは 1 です。 */
@@ -88,6 +140,48 @@ extern "C"
      */
     STRUCT_META_EXPORT int STRUCT_META_API struct_meta_descriptor_validate(const struct_meta_descriptor *descriptor);
 
+    /**
+     *  @brief          記述子を検査し、検査済みとしてプロセス内に登録します。
+     *
+     *  登録済みの記述子は、公開 API の入口で再帰検査を省略します。\n
+     *  公開 API は未登録の記述子を初回利用時に自動登録するため、本関数の呼び出しは任意です。
+     *  起動時に呼び出すと、検査エラーを早期に検出し、初回呼び出しの検査コストを前倒しできます。
+     *
+     *  登録は記述子のアドレスで識別します。公開 API へ渡した記述子も、初回利用時に同じく登録されます。
+     *  登録した記述子、フィールド配列、属性配列、ネスト先は、検査した時点の内容から変更してはなりません。
+     *  登録は構造体名、サイズ、フィールド配列のアドレス、フィールド数だけを照合するため、
+     *  フィールド配列の内容をその場で書き換えても検出できず、古い検査結果を使います。
+     *  動的に作った記述子は、変更や解放の前に struct_meta_descriptor_unregister() で登録を削除します。
+     *  同じアドレスへ構造体名、サイズ、フィールド配列、フィールド数の異なる記述子が置かれた場合は、
+     *  登録済みとみなさず、呼び出しごとに検査します。
+     *
+     *  @param[in]      descriptor 登録対象です。
+     *  @return         @c COM_UTIL_OK、または struct_meta_descriptor_validate() と同じ結果コードを返します。
+     *                  登録数の上限を超えた場合も、検査に成功すれば @c COM_UTIL_OK を返します。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。同じ記述子を複数スレッドから並行して登録できます。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_descriptor_seal(const struct_meta_descriptor *descriptor);
+
+    /**
+     *  @brief          記述子の検査済みの登録を削除します。
+     *
+     *  ヒープやスタックに作った記述子を変更または解放する前に呼び、登録の枠と登録情報を解放します。
+     *  削除するのは @p descriptor の登録だけで、ネスト先の登録は残ります。
+     *  ネスト先も動的に作った場合は、それぞれ削除します。
+     *  struct_meta_catalog_register() による名前の登録は削除しません。
+     *
+     *  @param[in]      descriptor 削除対象です。
+     *  @return         削除した場合は @c COM_UTIL_OK、登録されていなかった場合は @c COM_UTIL_SKIPPED、
+     *                  @p descriptor が NULL の場合は @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+     *
+     *  @par            スレッド セーフ
+     *  他の記述子の利用とは並行して呼べます。
+     *  @p descriptor を公開 API へ渡している他のスレッドがある間は呼んではなりません。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_descriptor_unregister(const struct_meta_descriptor *descriptor);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
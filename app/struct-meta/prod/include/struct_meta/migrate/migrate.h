@@ -0,0 +1,150 @@
+/**
+ *******************************************************************************
+ *  @file           migrate.h
+ *  @brief          旧版の記述子の構造体を、新版の記述子の構造体へ変換する移行計画を作り、適用します。
+ *
+ *  移行先のフィールドは、C フィールド名が同じ移行元のフィールドへ対応付けます。
+ *  名前で対応しないフィールドは、JSON キー (`json.name` 属性、なければ C フィールド名) が同じフィールドへ
+ *  対応付けます。名前を変えて `json.name` に旧名を残したフィールドは、この規則で旧版の値を引き継ぎます。\n
+ *  対応する移行元が無いフィールドは 0 で初期化し、移行先に対応しない移行元のフィールドは読み捨てます。
+ *
+ *  計画は、ネストした構造体と配列を展開した操作の列です。種別と大きさが同じ値はバイト列のまま複写し、
+ *  移行元と移行先の両方で同じ間隔に並ぶ範囲は 1 回の memcpy へまとめます。
+ *  レイアウトが同じ記述子の間の移行は、構造体全体の memcpy 1 回です。\n
+ *  種別や幅の異なる数値は値を変換し、大きさの異なる char 配列は文字列として複写します。
+ *  要素数の異なる配列は、共通の要素数だけを移し、移行先の残りの要素は 0 とします。
+ *
+ *  計画は両方の記述子のスキーマ指紋 (struct_meta_binary_fingerprint() と同じ値) を持ちます。
+ *  旧版のバイナリー形式やレコード ファイルは、ヘッダーの指紋が一致する旧版の記述子で読み込み、計画で新版へ移します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_MIGRATE_MIGRATE_H
+#define STRUCT_META_MIGRATE_MIGRATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <struct_meta/meta/meta.h>
+
+/**
+ *  @addtogroup STRUCT_META_PUBLIC_API
+ *  @{
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /** 移行先のフィールド 1 個の移し方です。 */
+    typedef enum struct_meta_migration_action
+    {
+        STRUCT_META_MIGRATION_COPY = 0,    /**< 移行元の値を、同じレイアウトのままバイト列で複写します。 */
+        STRUCT_META_MIGRATION_CONVERT = 1, /**< 種別、幅、要素数、ネスト先の配置のいずれかが異なり、値を変換します。 */
+        STRUCT_META_MIGRATION_ADDED = 2    /**< 対応する移行元が無く、0 で初期化します。 */
+    } struct_meta_migration_action;
+
+    /** 移行先のフィールド 1 個の対応です。 */
+    typedef struct struct_meta_migration_field
+    {
+        const struct_meta_field *target;     /**< 移行先のフィールドです。 */
+        const struct_meta_field *source;     /**< 対応する移行元のフィールドです。追加されたフィールドは NULL です。 */
+        struct_meta_migration_action action; /**< 移し方です。 */
+        int renamed;                         /**< JSON キーで対応付け、C フィールド名が異なる場合は 1 です。 */
+    } struct_meta_migration_field;
+
+    /**
+     *  @brief          移行計画です。
+     *
+     *  struct_meta_migration_init() で作り、struct_meta_migration_dispose() で解放します。
+     *  対応の一覧は最上位の構造体のフィールドについて記録し、ネスト先の対応は操作の列だけに反映します。
+     */
+    typedef struct struct_meta_migration
+    {
+        const struct_meta_descriptor *source; /**< 移行元の記述子です。 */
+        const struct_meta_descriptor *target; /**< 移行先の記述子です。 */
+        uint64_t source_fingerprint;          /**< 移行元のスキーマ指紋です。 */
+        uint64_t target_fingerprint;          /**< 移行先のスキーマ指紋です。 */
+        size_t field_count;                   /**< @p fields の要素数です。移行先のフィールド数と同じです。 */
+        struct_meta_migration_field *fields;  /**< 移行先のフィールドの順に並んだ対応です。 */
+        size_t removed_count;                 /**< @p removed の要素数です。 */
+        const struct_meta_field **removed;    /**< 移行先に対応しない移行元のフィールドです。 */
+        size_t op_count;                      /**< 構造体 1 個あたりの複写と変換の操作数です。 */
+        void *plan;                           /**< 操作の列です (内部用)。 */
+    } struct_meta_migration;
+
+    /**
+     *  @brief          2 個の記述子の間の移行計画を作ります。
+     *
+     *  数値 (整数、bool、列挙、float、double) は互いに変換できます。
+     *  数値と char 配列、構造体とその他の種別の間は変換できません。
+     *
+     *  @param[in]      source 移行元の記述子です。
+     *  @param[in]      target 移行先の記述子です。
+     *  @param[out]     migration_out 移行計画です。失敗した場合は空の計画を格納します。
+     *  @return         @c COM_UTIL_OK、struct_meta_descriptor_validate() と同じ結果コード、
+     *                  @c COM_UTIL_ERR_INVALID_ARGUMENT、変換できない種別の組を対応付けた場合と、
+     *                  文字列または可変長配列を含む場合は @c COM_UTIL_ERR_UNSUPPORTED、
+     *                  または @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。
+     *
+     *  @par            スレッド セーフ
+     *  共有状態を変更しません。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_migration_init(const struct_meta_descriptor *source,
+                                                                      const struct_meta_descriptor *target,
+                                                                      struct_meta_migration *migration_out);
+
+    /**
+     *  @brief          移行元の構造体 1 個を、移行先の構造体へ変換します。
+     *
+     *  移行先のパディングと追加されたフィールドは 0 で初期化します。
+     *
+     *  @param[in]      migration 移行計画です。
+     *  @param[in]      source 移行元の記述子が表す構造体です。
+     *  @param[out]     target 移行先の記述子が表す構造体です。@p source と重なってはなりません。
+     *  @return         @c COM_UTIL_OK、@c COM_UTIL_ERR_INVALID_ARGUMENT、
+     *                  移行先の型に収まらない数値と、移行先の char 配列に収まらない文字列では
+     *                  @c COM_UTIL_ERR_OUT_OF_RANGE を返します。エラーの場合、@p target の内容は不定です。
+     *
+     *  @par            スレッド セーフ
+     *  同じ移行先を並行して使わない場合に限ります。移行計画は複数スレッドで共有できます。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_migration_apply(const struct_meta_migration *migration,
+                                                                       const void *source, void *target);
+
+    /**
+     *  @brief          移行元の構造体配列を、移行先の構造体配列へ変換します。
+     *
+     *  各要素は、それぞれの記述子のサイズ間隔で並んでいるものとします。
+     *
+     *  @param[in]      migration 移行計画です。
+     *  @param[in]      sources 移行元の構造体配列です。
+     *  @param[in]      count 要素数です。
+     *  @param[out]     targets 移行先の構造体配列です。@p sources と重なってはなりません。
+     *  @return         struct_meta_migration_apply() と同じ結果コードを返します。
+     *                  エラーの場合、エラーとなった要素と以降の要素の内容は不定です。
+     *
+     *  @par            スレッド セーフ
+     *  struct_meta_migration_apply() と同じです。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_migration_apply_array(const struct_meta_migration *migration,
+                                                                             const void *sources, size_t count,
+                                                                             void *targets);
+
+    /**
+     *  @brief          移行計画が確保した領域を解放し、空の計画へ戻します。
+     *  @param[in,out]  migration 対象です。NULL の場合は何もしません。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_migration_dispose(struct_meta_migration *migration);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/** @} */
+
+#endif /* STRUCT_META_MIGRATE_MIGRATE_H */
@@ -29,7 +29,8 @@ extern "C"
      *  @param[in,out]  instance 編集対象の構造体です。NULL は指定できません。
      *  @return         成功時は @c COM_UTIL_OK、失敗時はエラー コードを返します。
      *
-     *  メニューには現在位置と、パス指定に利用できる各候補の C フィールドパスを表示します。
+     *  メニューには現在位置と、パス指定に利用できる各候補の C フィールドパスを表示します。\n
+     *  文字列は値の表示だけを行います。可変長配列は既存の要素を編集し、要素数は変更しません。
      *
      *  @par            スレッド セーフ
      *  本関数はスレッド セーフではありません。\n
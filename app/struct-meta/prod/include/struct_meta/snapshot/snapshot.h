@@ -0,0 +1,180 @@
+/**
+ *******************************************************************************
+ *  @file           snapshot.h
+ *  @brief          構造体インスタンスの版を atomic に公開し、読み手がロックなしで参照できるようにします。
+ *
+ *  書き手は新しい版を別の領域へ作り、公開中のポインターを atomic に置き換えます (RCU 方式)。
+ *  読み手は struct_meta_snapshot_pin() で公開中の版を得て、struct_meta_snapshot_unpin() まで参照します。
+ *  pin と unpin は、ループも待機も伴わない数回の atomic 操作だけで終わります (wait-free)。
+ *
+ *  置き換えた旧版は、世代 (エポック) による回収で解放します。
+ *  公開のたびに世代を進め、旧版には置き換えた時点の世代を記録します。
+ *  読み手は pin した時点の世代を自分の枠に示し、旧版は、それ以前の世代を示す読み手がいなくなった時点で解放します。\n
+ *  長く pin し続ける読み手は、その間に置き換えた旧版の解放を遅らせます。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_SNAPSHOT_SNAPSHOT_H
+#define STRUCT_META_SNAPSHOT_SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <struct_meta/meta/meta.h>
+
+/**
+ *  @addtogroup STRUCT_META_PUBLIC_API
+ *  @{
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /** 読み手 1 個の枠です。struct_meta_snapshot_reader_attach() で得ます。 */
+    typedef struct struct_meta_snapshot_reader struct_meta_snapshot_reader;
+
+    /** 回収待ちの旧版です (内部用)。 */
+    typedef struct struct_meta_snapshot_retired struct_meta_snapshot_retired;
+
+    /**
+     *  @brief          公開中の版と、回収待ちの旧版を管理します。
+     *
+     *  struct_meta_snapshot_init() で初期化し、struct_meta_snapshot_dispose() で解放します。
+     *  読み手から参照されるため、初期化から解放まで移動してはなりません。
+     */
+    typedef struct struct_meta_snapshot
+    {
+        const struct_meta_descriptor *descriptor; /**< 版の記述子です。 */
+        void *current;                            /**< 公開中の版です (内部用)。読み手は pin で得ます。 */
+        uint64_t epoch;                           /**< 現在の世代です (内部用)。1 から始まります。 */
+        struct_meta_snapshot_reader *readers;     /**< 読み手の枠の配列です (内部用)。 */
+        size_t reader_capacity;                   /**< 読み手の枠の数です。 */
+        struct_meta_snapshot_retired *retired;    /**< 回収待ちの旧版の一覧です (内部用)。 */
+        size_t retired_count;                     /**< 回収待ちの旧版の数です。 */
+    } struct_meta_snapshot;
+
+    /**
+     *  @brief          版を公開していない状態で初期化します。
+     *
+     *  最初の公開までは、struct_meta_snapshot_pin() は NULL を返します。
+     *
+     *  @param[out]     snapshot 対象です。
+     *  @param[in]      descriptor 版の記述子です。
+     *  @param[in]      reader_capacity 同時に登録できる読み手の数です。1 以上でなければなりません。
+     *  @return         @c COM_UTIL_OK、@c COM_UTIL_ERR_INVALID_ARGUMENT、@c COM_UTIL_ERR_OUT_OF_MEMORY、
+     *                  または記述子の検査エラーを返します。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_snapshot_init(struct_meta_snapshot *snapshot,
+                                                                     const struct_meta_descriptor *descriptor,
+                                                                     size_t reader_capacity);
+
+    /**
+     *  @brief          インスタンスを新しい版として公開し、置き換えた版を回収待ちにします。
+     *
+     *  公開の後に struct_meta_snapshot_reclaim() を呼び、解放できる旧版を解放します。
+     *
+     *  @param[in,out]  snapshot 対象です。
+     *  @param[in]      instance 公開するインスタンスです。malloc() で確保した記述子の size バイトの領域で、
+     *                  文字列と可変長配列は NULL か malloc() で確保した領域でなければなりません。
+     *                  成功した場合は所有権が移り、不要になった時点で解放されます。
+     *  @return         @c COM_UTIL_OK、@c COM_UTIL_ERR_INVALID_ARGUMENT、
+     *                  または @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。
+     *                  エラーの場合、所有権は移りません。
+     *
+     *  @par            スレッド セーフ
+     *  読み手とは並行して呼べます。公開、読み込み、回収は、同じ対象へ並行して呼んではなりません。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_snapshot_publish(struct_meta_snapshot *snapshot, void *instance);
+
+    /**
+     *  @brief          JSON テキスト ファイルを新しい領域へ読み込み、新しい版として公開します。
+     *
+     *  0 で埋めた領域へ struct_meta_json_file_load() で読み込みます。ファイルに無いキーの値は 0 です。
+     *  読み込みに失敗した場合、公開中の版は変わりません。
+     *
+     *  @param[in,out]  snapshot 対象です。
+     *  @param[in]      path 読み込むファイルのパスです。
+     *  @return         @c COM_UTIL_OK、または struct_meta_json_file_load() と同じ結果コードを返します。
+     *
+     *  @par            スレッド セーフ
+     *  struct_meta_snapshot_publish() と同じです。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_snapshot_load_file(struct_meta_snapshot *snapshot,
+                                                                          const char *path);
+
+    /**
+     *  @brief          pin している読み手がいなくなった旧版を解放します。
+     *  @param[in,out]  snapshot 対象です。
+     *  @return         解放できずに残った旧版の数です。@p snapshot が NULL の場合は 0 を返します。
+     *
+     *  @par            スレッド セーフ
+     *  struct_meta_snapshot_publish() と同じです。
+     */
+    STRUCT_META_EXPORT size_t STRUCT_META_API struct_meta_snapshot_reclaim(struct_meta_snapshot *snapshot);
+
+    /**
+     *  @brief          読み手の枠を 1 個確保します。
+     *
+     *  枠は読み手のスレッドごとに確保し、そのスレッドだけが使います。
+     *  枠はキャッシュ ライン 1 本分の間隔で並べ、他の読み手の pin と書き込みが干渉しないようにします。
+     *
+     *  @param[in,out]  snapshot 対象です。
+     *  @param[out]     reader_out 確保した枠です。
+     *  @return         @c COM_UTIL_OK、@c COM_UTIL_ERR_INVALID_ARGUMENT、
+     *                  空きの枠が無い場合は @c COM_UTIL_ERR_BUFFER_TOO_SMALL を返します。
+     *
+     *  @par            スレッド セーフ
+     *  複数のスレッドから並行して呼べます。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_snapshot_reader_attach(struct_meta_snapshot *snapshot,
+                                                                              struct_meta_snapshot_reader **reader_out);
+
+    /**
+     *  @brief          読み手の枠を返却します。pin 中の場合は unpin してから返却します。
+     *  @param[in,out]  reader 対象です。NULL の場合は何もしません。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_snapshot_reader_detach(struct_meta_snapshot_reader *reader);
+
+    /**
+     *  @brief          公開中の版を得て、struct_meta_snapshot_unpin() まで解放されないようにします。
+     *
+     *  pin 中に公開された新しい版は、次の pin で得ます。pin 中に再度 pin してはなりません。
+     *
+     *  @param[in,out]  reader 読み手の枠です。
+     *  @return         公開中の版です。版を公開していない場合と、@p reader が NULL の場合は NULL を返します。
+     *
+     *  @par            スレッド セーフ
+     *  枠を確保したスレッドから呼びます。書き手と並行して呼べます。
+     */
+    STRUCT_META_EXPORT const void *STRUCT_META_API struct_meta_snapshot_pin(struct_meta_snapshot_reader *reader);
+
+    /**
+     *  @brief          pin を解除します。以降、pin で得た版を参照してはなりません。
+     *  @param[in,out]  reader 読み手の枠です。NULL の場合は何もしません。
+     *
+     *  @par            スレッド セーフ
+     *  struct_meta_snapshot_pin() と同じです。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_snapshot_unpin(struct_meta_snapshot_reader *reader);
+
+    /**
+     *  @brief          公開中の版、回収待ちの旧版、読み手の枠を解放し、空の状態へ戻します。
+     *
+     *  すべての読み手の枠を返却してから呼びます。
+     *
+     *  @param[in,out]  snapshot 対象です。NULL の場合は何もしません。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_snapshot_dispose(struct_meta_snapshot *snapshot);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/** @} */
+
+#endif /* STRUCT_META_SNAPSHOT_SNAPSHOT_H */
@@ -0,0 +1,148 @@
+/**
+ *******************************************************************************
+ *  @file           mmap_store.h
+ *  @brief          固定レイアウトのレコードをファイルへ並べ、メモリー マップで直接参照します。
+ *
+ *  ファイルはヘッダーと、ホストのメモリー表現のままのレコードの列からなります。
+ *
+ *  | オフセット | バイト数 | 内容                                                   |
+ *  | ---------: | -------: | ------------------------------------------------------ |
+ *  |          0 |        4 | マジック `SMMS`                                        |
+ *  |          4 |        4 | 形式の版 (STRUCT_META_MMAP_STORE_VERSION)              |
+ *  |          8 |        8 | レイアウト指紋                                         |
+ *  |         16 |        8 | レコード数                                             |
+ *  |         24 |        8 | レコード間のバイト数 (記述子の size)                   |
+ *  |         32 |        8 | 先頭レコードのオフセット (STRUCT_META_MMAP_STORE_HEADER_SIZE) |
+ *  |         40 |       24 | 予約 (0)                                               |
+ *
+ *  ヘッダーの数値はリトル エンディアンです。
+ *  レイアウト指紋は、struct_meta_binary_fingerprint() のスキーマ指紋に構造体サイズ、フィールドのオフセット、
+ *  ホストのバイト順を加えたものです。指紋が一致しないファイルは開きません。\n
+ *  開いたストアのレコードはマップした領域を直接指すため、開く時間はレコード数に依存しません。
+ *  読み取り専用でマップするため、同じファイルを開いた複数のプロセスはページ キャッシュを共有します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_STORE_MMAP_STORE_H
+#define STRUCT_META_STORE_MMAP_STORE_H
+
+#include <stddef.h>
+
+#include <struct_meta/meta/meta.h>
+
+/**
+ *  @addtogroup STRUCT_META_PUBLIC_API
+ *  @{
+ */
+
+/** ストア ファイルの形式の版です。 */
+#define STRUCT_META_MMAP_STORE_VERSION 1U
+
+/** ヘッダーのバイト数です。先頭レコードはこのオフセットから始まります。 */
+#define STRUCT_META_MMAP_STORE_HEADER_SIZE 64U
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /**
+     *  @brief          開いたストアです。
+     *
+     *  メンバーは struct_meta_mmap_store_open() が設定し、struct_meta_mmap_store_close() まで変更しません。
+     */
+    typedef struct struct_meta_mmap_store
+    {
+        const struct_meta_descriptor *descriptor; /**< レコードの記述子です。 */
+        const unsigned char *records;             /**< 先頭レコードです。レコードがない場合も NULL ではありません。 */
+        size_t count;                             /**< レコード数です。 */
+        size_t stride;                            /**< レコード間のバイト数です。 */
+        void *map_base;                           /**< マップした領域の先頭です (内部用)。 */
+        size_t map_size;                          /**< マップした領域のバイト数です (内部用)。 */
+    } struct_meta_mmap_store;
+
+    /**
+     *  @brief          構造体配列をストア ファイルへ書き出します。
+     *
+     *  各レコードはフィールド以外の領域 (パディング) と char 配列の NUL の後ろを 0 にして書き出すため、
+     *  同じ内容からは同じファイルができます。
+     *
+     *  @param[in]      descriptor 要素の記述子です。
+     *  @param[in]      base 配列の先頭です。@p count が 0 の場合に限り NULL を指定できます。
+     *  @param[in]      count 要素数です。
+     *  @param[in]      stride 要素間のバイト数です。0 の場合は記述子の size を使います。
+     *  @param[in]      path 出力先のパスです。既存のファイルは置き換えます。
+     *  @return         @c COM_UTIL_OK、struct_meta_descriptor_validate() と同じ結果コード、
+     *                  要素サイズがバイナリー形式の幅と異なる場合と文字列または可変長配列を含む場合は
+     *                  @c COM_UTIL_ERR_UNSUPPORTED、char 配列に NUL がない場合は @c COM_UTIL_ERR_INVALID_ARGUMENT、
+     *                  ファイルを作れない場合は @c COM_UTIL_ERR_NOT_FOUND、
+     *                  書き込みに失敗した場合は @c COM_UTIL_ERR_UNKNOWN を返します。
+     *
+     *  @par            スレッド セーフ
+     *  同じパスへ並行して書き出さず、配列を並行変更しない場合に限ります。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_mmap_store_write(const struct_meta_descriptor *descriptor,
+                                                                        const void *base, size_t count,
+                                                                        size_t stride, const char *path);
+
+    /**
+     *  @brief          ストア ファイルを読み取り専用でマップして開きます。
+     *
+     *  ヘッダーだけを検査し、レコードは読みません。
+     *
+     *  @param[in]      descriptor レコードの記述子です。
+     *  @param[in]      path ストア ファイルのパスです。
+     *  @param[out]     store_out 開いたストアです。失敗した場合は変更しません。
+     *  @return         @c COM_UTIL_OK、struct_meta_descriptor_validate() と同じ結果コード、
+     *                  ファイルを開けない場合は @c COM_UTIL_ERR_NOT_FOUND、
+     *                  マジックが異なる場合は @c COM_UTIL_ERR_INVALID_ARGUMENT、
+     *                  文字列または可変長配列を含む場合と、版、レイアウト指紋、レコード間のバイト数が異なる場合は
+     *                  @c COM_UTIL_ERR_UNSUPPORTED、
+     *                  ファイルがヘッダーの示すレコード数より短い場合は @c COM_UTIL_ERR_EOF、
+     *                  マップに失敗した場合は @c COM_UTIL_ERR_UNKNOWN を返します。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_mmap_store_open(const struct_meta_descriptor *descriptor,
+                                                                       const char *path,
+                                                                       struct_meta_mmap_store *store_out);
+
+    /**
+     *  @brief          レコードの先頭を返します。
+     *
+     *  返すポインターはマップした領域を直接指します。struct_meta_path_resolve_const() や
+     *  struct_meta_print_write() などの const インスタンスを受け取る API へそのまま渡せます。
+     *  ストアを閉じた後は使用してはなりません。
+     *
+     *  @param[in]      store 開いたストアです。
+     *  @param[in]      index レコードの添字です。
+     *  @param[out]     record_out レコードの先頭です。
+     *  @return         @c COM_UTIL_OK、@c COM_UTIL_ERR_INVALID_ARGUMENT、または
+     *                  @p index が範囲外の場合は @c COM_UTIL_ERR_OUT_OF_RANGE を返します。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    STRUCT_META_EXPORT int STRUCT_META_API struct_meta_mmap_store_record(const struct_meta_mmap_store *store,
+                                                                         size_t index, const void **record_out);
+
+    /**
+     *  @brief          ストアのマップを解除します。
+     *
+     *  閉じたストアは再度閉じても何もしません。
+     *
+     *  @param[in,out]  store 対象です。
+     */
+    STRUCT_META_EXPORT void STRUCT_META_API struct_meta_mmap_store_close(struct_meta_mmap_store *store);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/** @} */
+
+#endif /* STRUCT_META_STORE_MMAP_STORE_H */
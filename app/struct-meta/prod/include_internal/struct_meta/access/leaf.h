@@ -0,0 +1,58 @@
+/**
+ *******************************************************************************
+ *  @file           leaf.h
+ *  @brief          記述子を走査し、末端の値ごとにパスを組み立てて訪問します。
+ *
+ *  末端の値の単位とパスの書式は、列ブロック (columnar) と差分 (delta) で共通です。
+ *  ネストした構造体は展開し、数値の固定長配列は要素ごとに、char 配列は配列全体で 1 個の値とします。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_ACCESS_LEAF_H
+#define STRUCT_META_ACCESS_LEAF_H
+
+#include <stddef.h>
+
+#include <struct_meta/memory/buffer.h>
+#include <struct_meta/meta/meta.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /** 走査で呼び出す関数の組です。 */
+    typedef struct struct_meta_internal_leaf_visitor
+    {
+        /**
+         *  範囲を読み飛ばすかを返します。0 以外を返すと、その範囲のパスを組み立てずに次へ進みます。
+         *  フィールド全体と配列要素ごとに呼び出します。NULL の場合はすべて訪問します。
+         */
+        int (*skip)(void *context, size_t offset, size_t size);
+        /** 末端の値を訪問します。走査中のパスは、パスのバッファーの内容 (NUL 終端) です。 */
+        int (*leaf)(void *context, const struct_meta_field *field, size_t offset, size_t size);
+        void *context; /**< 各関数へ渡す値です。 */
+    } struct_meta_internal_leaf_visitor;
+
+    /**
+     *  @brief          記述子の末端の値を、構造体の上の順に訪問します。
+     *
+     *  オフセットは最上位の構造体の先頭からのバイト数です。
+     *
+     *  @param[in]      descriptor 検査済みの記述子です。
+     *  @param[in,out]  prefix 走査中のパスを組み立てるバッファーです。戻った時点の長さは呼び出し前と同じです。
+     *  @param[in]      visitor 呼び出す関数の組です。
+     *  @return         @c COM_UTIL_OK、文字列または可変長配列を含む場合は @c COM_UTIL_ERR_UNSUPPORTED、
+     *                  @c COM_UTIL_ERR_OUT_OF_MEMORY、または @p visitor の leaf が返したエラーを返します。
+     */
+    int struct_meta_internal_leaf_walk(const struct_meta_descriptor *descriptor, struct_meta_buffer *prefix,
+                                       const struct_meta_internal_leaf_visitor *visitor);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* STRUCT_META_ACCESS_LEAF_H */
@@ -0,0 +1,51 @@
+/**
+ *******************************************************************************
+ *  @file           array.h
+ *  @brief          構造体配列を扱う API の引数を検査します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_BASE_ARRAY_H
+#define STRUCT_META_BASE_ARRAY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <struct_meta/meta/meta.h>
+
+#include <com_util/base/result.h>
+
+/**
+ *  @brief          構造体配列の要素間隔を決定し、配列全体がアドレス空間に収まることを確認します。
+ *  @param[in]      descriptor 要素の記述子です。
+ *  @param[in]      base 配列の先頭です。@p count が 0 の場合に限り NULL を指定できます。
+ *  @param[in]      count 要素数です。
+ *  @param[in]      stride 要素間のバイト数です。0 の場合は記述子の size を使います。
+ *  @param[out]     stride_out 決定した要素間のバイト数です。
+ *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+ */
+static inline int struct_meta_internal_array_stride(const struct_meta_descriptor *descriptor, const void *base,
+                                                    size_t count, size_t stride, size_t *stride_out)
+{
+    if ((descriptor == NULL) || ((base == NULL) && (count > 0U)))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if (stride == 0U)
+    {
+        stride = descriptor->size;
+    }
+    /* 要素が重ならないこと、末尾の要素のアドレス計算が桁あふれしないことを確認する。 */
+    if ((stride < descriptor->size) || ((count > 0U) && (((count - 1U) > (SIZE_MAX / stride)) ||
+                                                         (((count - 1U) * stride) > (SIZE_MAX - descriptor->size)))))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    *stride_out = stride;
+    return COM_UTIL_OK;
+}
+
+#endif /* STRUCT_META_BASE_ARRAY_H */
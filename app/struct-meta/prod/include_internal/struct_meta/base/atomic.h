@@ -0,0 +1,172 @@
+/**
+ *******************************************************************************
+ *  @file           atomic.h
+ *  @brief          GCC と MSVC のメモリ順序を共通化したポインターと 64 ビット整数の atomic 操作です。
+ *
+ *  `<stdatomic.h>` は MSVC の C17 モードで利用できないため、GCC では `__atomic_*`、
+ *  MSVC では Interlocked 関数を使い、取得 (acquire) と公開 (release) の順序を揃えます。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_BASE_ATOMIC_H
+#define STRUCT_META_BASE_ATOMIC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <com_util/base/platform.h>
+
+#if defined(COMPILER_MSVC)
+    #include <com_util/base/windows_sdk.h>
+#endif /* COMPILER_MSVC */
+
+/**
+ *  @brief          ポインターを acquire 順序で読み取ります。
+ *  @param[in]      target 読み取り対象です。
+ *  @return         読み取った値です。
+ */
+static inline void *struct_meta_internal_atomic_load_ptr(void **target)
+{
+#if defined(COMPILER_MSVC)
+    /* Interlocked API が PVOID volatile * を要求するため volatile へ変換する。
+       see: https://learn.microsoft.com/windows/win32/api/winnt/nf-winnt-interlockedcompareexchangepointer */
+    return InterlockedCompareExchangePointer((PVOID volatile *)target, NULL, NULL);
+#else  /* !COMPILER_MSVC */
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+#endif /* COMPILER_MSVC */
+}
+
+/**
+ *  @brief          値が @p expected の場合に限り、@p desired を acq_rel 順序で書き込みます。
+ *  @param[in,out]  target 更新対象です。
+ *  @param[in]      expected 期待する現在値です。
+ *  @param[in]      desired 書き込む値です。
+ *  @return         書き込んだ場合は true です。
+ */
+static inline bool struct_meta_internal_atomic_cas_ptr(void **target, void *expected, void *desired)
+{
+#if defined(COMPILER_MSVC)
+    /* Interlocked API が PVOID volatile * を要求するため volatile へ変換する。
+       see: https://learn.microsoft.com/windows/win32/api/winnt/nf-winnt-interlockedcompareexchangepointer */
+    return InterlockedCompareExchangePointer((PVOID volatile *)target, desired, expected) == expected;
+#else  /* !COMPILER_MSVC */
+    return __atomic_compare_exchange_n(target, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif /* COMPILER_MSVC */
+}
+
+/**
+ *  @brief          @p desired を acq_rel 順序で書き込み、書き込む前の値を返します。
+ *  @param[in,out]  target 更新対象です。
+ *  @param[in]      desired 書き込む値です。
+ *  @return         書き込む前の値です。
+ */
+static inline void *struct_meta_internal_atomic_exchange_ptr(void **target, void *desired)
+{
+#if defined(COMPILER_MSVC)
+    /* Interlocked API が PVOID volatile * を要求するため volatile へ変換する。
+       see: https://learn.microsoft.com/windows/win32/api/winnt/nf-winnt-interlockedexchangepointer */
+    return InterlockedExchangePointer((PVOID volatile *)target, desired);
+#else  /* !COMPILER_MSVC */
+    return __atomic_exchange_n(target, desired, __ATOMIC_ACQ_REL);
+#endif /* COMPILER_MSVC */
+}
+
+/**
+ *  @brief          const 修飾したポインターを acquire 順序で読み取ります。
+ *  @param[in]      target 読み取り対象です。
+ *  @return         読み取った値です。
+ */
+static inline const void *struct_meta_internal_atomic_load_const_ptr(const void **target)
+{
+#if defined(COMPILER_MSVC)
+    /* Interlocked API が PVOID volatile * を要求するため volatile へ変換する。比較値が NULL のため書き込みは起きない。
+       see: https://learn.microsoft.com/windows/win32/api/winnt/nf-winnt-interlockedcompareexchangepointer */
+    return InterlockedCompareExchangePointer((PVOID volatile *)target, NULL, NULL);
+#else  /* !COMPILER_MSVC */
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+#endif /* COMPILER_MSVC */
+}
+
+/**
+ *  @brief          const 修飾したポインターの値が @p expected の場合に限り、@p desired を acq_rel 順序で書き込みます。
+ *  @param[in,out]  target 更新対象です。
+ *  @param[in]      expected 期待する現在値です。
+ *  @param[in]      desired 書き込む値です。指す先は変更しません。
+ *  @return         書き込んだ場合は true です。
+ */
+static inline bool struct_meta_internal_atomic_cas_const_ptr(const void **target, const void *expected,
+                                                             const void *desired)
+{
+#if defined(COMPILER_MSVC)
+    /* Interlocked API が PVOID を要求するため const を外す。値を格納するだけで、指す先へは書き込まない。
+       see: https://learn.microsoft.com/windows/win32/api/winnt/nf-winnt-interlockedcompareexchangepointer */
+    return InterlockedCompareExchangePointer((PVOID volatile *)target, (PVOID)desired, (PVOID)expected) == expected;
+#else  /* !COMPILER_MSVC */
+    return __atomic_compare_exchange_n(target, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif /* COMPILER_MSVC */
+}
+
+/**
+ *  @brief          64 ビット整数を acquire 順序で読み取ります。
+ *  @param[in]      target 読み取り対象です。
+ *  @return         読み取った値です。
+ */
+static inline uint64_t struct_meta_internal_atomic_load_u64(uint64_t *target)
+{
+#if defined(COMPILER_MSVC)
+    /* 32 ビット環境でも 64 ビット値を一度に読むため、比較交換で読み取る。 */
+    return (uint64_t)InterlockedCompareExchange64((LONG64 volatile *)target, 0, 0);
+#else  /* !COMPILER_MSVC */
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+#endif /* COMPILER_MSVC */
+}
+
+/**
+ *  @brief          64 ビット整数を release 順序で書き込みます。
+ *  @param[out]     target 更新対象です。
+ *  @param[in]      value 書き込む値です。
+ */
+static inline void struct_meta_internal_atomic_store_u64(uint64_t *target, uint64_t value)
+{
+#if defined(COMPILER_MSVC)
+    (void)InterlockedExchange64((LONG64 volatile *)target, (LONG64)value);
+#else  /* !COMPILER_MSVC */
+    __atomic_store_n(target, value, __ATOMIC_RELEASE);
+#endif /* COMPILER_MSVC */
+}
+
+/**
+ *  @brief          64 ビット整数へ @p value を seq_cst 順序で加え、加える前の値を返します。
+ *  @param[in,out]  target 更新対象です。
+ *  @param[in]      value 加える値です。
+ *  @return         加える前の値です。
+ */
+static inline uint64_t struct_meta_internal_atomic_fetch_add_u64(uint64_t *target, uint64_t value)
+{
+#if defined(COMPILER_MSVC)
+    return (uint64_t)InterlockedExchangeAdd64((LONG64 volatile *)target, (LONG64)value);
+#else  /* !COMPILER_MSVC */
+    return __atomic_fetch_add(target, value, __ATOMIC_SEQ_CST);
+#endif /* COMPILER_MSVC */
+}
+
+/**
+ *  @brief          前後の読み書きを入れ替えない seq_cst のフェンスです。
+ *
+ *  自分の書き込みの後に他スレッドの書き込みを読む組 (Dekker 型) で、
+ *  少なくとも一方が相手の書き込みを見ることを保証します。
+ */
+static inline void struct_meta_internal_atomic_fence(void)
+{
+#if defined(COMPILER_MSVC)
+    MemoryBarrier();
+#else  /* !COMPILER_MSVC */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif /* COMPILER_MSVC */
+}
+
+#endif /* STRUCT_META_BASE_ATOMIC_H */
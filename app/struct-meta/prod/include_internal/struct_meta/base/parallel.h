@@ -0,0 +1,68 @@
+/**
+ *******************************************************************************
+ *  @file           parallel.h
+ *  @brief          独立したタスクを複数スレッドへ割り振って実行します。
+ *
+ *  Linux では POSIX スレッド、Windows では Win32 スレッドを使います。
+ *  スレッド プールは持たず、呼び出しごとにスレッドを作成して終了を待ちます。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_BASE_PARALLEL_H
+#define STRUCT_META_BASE_PARALLEL_H
+
+#include <stddef.h>
+
+/** 1 タスクあたりの最小要素数です。スレッド作成のコストが要素の処理時間を上回らない大きさとします。 */
+#define STRUCT_META_PARALLEL_MIN_ITEMS 256U
+
+/** 1 回の呼び出しで使う最大スレッド数です。 */
+#define STRUCT_META_PARALLEL_MAX_THREADS 64U
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /**
+     *  @brief          タスク 1 個分の処理です。
+     *  @param[in,out]  context 呼び出し側の共有データです。
+     *  @param[in]      task_index タスクの添字です。
+     */
+    typedef void (*struct_meta_internal_task_fn)(void *context, size_t task_index);
+
+    /**
+     *  @brief          要素数と要求スレッド数から、タスク数を決めます。
+     *
+     *  @p requested が 0 の場合はオンラインの CPU 数を要求数とします。
+     *  各タスクが @c STRUCT_META_PARALLEL_MIN_ITEMS 個以上の要素を受け持つよう、タスク数を減らします。
+     *
+     *  @param[in]      requested 要求スレッド数です。
+     *  @param[in]      item_count 要素数です。
+     *  @return         タスク数です。1 以上 @c STRUCT_META_PARALLEL_MAX_THREADS 以下です。
+     */
+    size_t struct_meta_internal_parallel_tasks(size_t requested, size_t item_count);
+
+    /**
+     *  @brief          タスクを並行に実行し、すべての終了を待ちます。
+     *
+     *  タスク 0 は呼び出し元のスレッドで実行します。
+     *  スレッドを作成できなかったタスクは、呼び出し元のスレッドで順に実行します。
+     *
+     *  @param[in]      task_count タスク数です。
+     *  @param[in]      task 各タスクで呼び出す処理です。
+     *  @param[in,out]  context @p task へ渡す共有データです。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。@p task が共有データを保護する必要があります。
+     */
+    void struct_meta_internal_parallel_run(size_t task_count, struct_meta_internal_task_fn task, void *context);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* STRUCT_META_BASE_PARALLEL_H */
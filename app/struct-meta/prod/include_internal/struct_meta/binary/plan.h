@@ -0,0 +1,139 @@
+/**
+ *******************************************************************************
+ *  @file           plan.h
+ *  @brief          記述子からバイナリー形式の変換手順とスキーマ指紋を作ります。
+ *
+ *  変換手順は、ペイロードの範囲と構造体の範囲を対応付けた操作の列です。\n
+ *  ホストのレイアウトがペイロードと同じ並びの範囲は 1 個の複写操作へまとめるため、
+ *  パディングのないリトル エンディアンの構造体は memcpy 1 回で変換できます。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_BINARY_PLAN_H
+#define STRUCT_META_BINARY_PLAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <struct_meta/meta/meta.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /** 変換操作の種類です。 */
+    typedef enum struct_meta_internal_binary_op_kind
+    {
+        STRUCT_META_INTERNAL_BINARY_OP_COPY = 0,  /**< バイト列をそのまま複写します。 */
+        STRUCT_META_INTERNAL_BINARY_OP_SWAP4 = 1, /**< 4 バイト値を、バイト順を反転して複写します。 */
+        STRUCT_META_INTERNAL_BINARY_OP_SWAP8 = 2, /**< 8 バイト値を、バイト順を反転して複写します。 */
+        STRUCT_META_INTERNAL_BINARY_OP_CHARS = 3, /**< NUL 終端文字列として扱う char 配列です。 */
+        STRUCT_META_INTERNAL_BINARY_OP_SWAP2 = 4, /**< 2 バイト値を、バイト順を反転して複写します。 */
+        STRUCT_META_INTERNAL_BINARY_OP_BOOL = 5   /**< bool 値を、0 または 1 の 1 バイトとして複写します。 */
+    } struct_meta_internal_binary_op_kind;
+
+    /** 変換操作 1 個です。 */
+    typedef struct struct_meta_internal_binary_op
+    {
+        size_t host_offset;                       /**< 最上位の構造体の先頭からのバイト オフセットです。 */
+        size_t wire_offset;                       /**< ペイロードの先頭からのバイト オフセットです。 */
+        size_t length;                            /**< 範囲のバイト数です。 */
+        struct_meta_internal_binary_op_kind kind; /**< 操作の種類です。 */
+        unsigned int pad;                         /**< 明示的アラインメントです。 */
+    } struct_meta_internal_binary_op;
+
+    /** 記述子 1 個分の変換手順です。 */
+    typedef struct struct_meta_internal_binary_plan
+    {
+        uint64_t fingerprint;                /**< スキーマ指紋です。 */
+        size_t wire_size;                    /**< ペイロードのバイト数です。 */
+        size_t op_count;                     /**< @p ops の要素数です。 */
+        struct_meta_internal_binary_op *ops; /**< 変換操作の配列です。ペイロードの順に並びます。 */
+    } struct_meta_internal_binary_plan;
+
+    /**
+     *  @brief          記述子のスキーマ指紋を計算します。
+     *
+     *  フィールド名、種別、要素サイズ、要素数、char 配列の大きさを、ネスト先も含めて記述子の順に
+     *  64 ビット FNV-1a で要約します。オフセットや属性は含めません。
+     *
+     *  @param[in]      descriptor 検査済みの記述子です。
+     *  @return         スキーマ指紋です。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    uint64_t struct_meta_internal_binary_fingerprint(const struct_meta_descriptor *descriptor);
+
+    /**
+     *  @brief          記述子とホストのレイアウトを合わせた指紋を計算します。
+     *
+     *  スキーマ指紋に加え、構造体サイズ、各フィールドのオフセット (ネスト先を含む)、ホストのバイト順を要約します。
+     *  ホストのメモリー表現のまま保存したレコードを、そのまま参照してよいかの判定に使います。
+     *
+     *  @param[in]      descriptor 検査済みの記述子です。
+     *  @return         レイアウト指紋です。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    uint64_t struct_meta_internal_binary_layout_fingerprint(const struct_meta_descriptor *descriptor);
+
+    /**
+     *  @brief          変換手順を作ります。
+     *  @param[in]      descriptor 検査済みの記述子です。
+     *  @param[out]     plan_out 作成した変換手順です。struct_meta_internal_binary_plan_dispose() で解放します。
+     *  @return         @c COM_UTIL_OK、要素サイズがバイナリー形式の幅と異なる場合は @c COM_UTIL_ERR_UNSUPPORTED、
+     *                  または @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    int struct_meta_internal_binary_plan_build(const struct_meta_descriptor *descriptor,
+                                               struct_meta_internal_binary_plan *plan_out);
+
+    /**
+     *  @brief          変換手順を解放します。
+     *  @param[in,out]  plan 対象です。
+     */
+    void struct_meta_internal_binary_plan_dispose(struct_meta_internal_binary_plan *plan);
+
+    /**
+     *  @brief          記述子の変換手順を取得します。
+     *
+     *  登録済みの記述子では、初回利用時に作った変換手順を登録情報へ公開して全スレッドで共有します。
+     *  登録できなかった記述子では @p local へ作ります。
+     *  その場合、呼び出し側は使用後に struct_meta_internal_binary_plan_release() を呼び出します。
+     *
+     *  @param[in]      descriptor 検査済みの記述子です。
+     *  @param[out]     local 登録できなかった場合に使う作業領域です。
+     *  @param[out]     plan_out 変換手順です。
+     *  @return         struct_meta_internal_binary_plan_build() と同じ結果コードを返します。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    int struct_meta_internal_binary_plan_acquire(const struct_meta_descriptor *descriptor,
+                                                 struct_meta_internal_binary_plan *local,
+                                                 const struct_meta_internal_binary_plan **plan_out);
+
+    /**
+     *  @brief          struct_meta_internal_binary_plan_acquire() で取得した変換手順を返却します。
+     *
+     *  @p plan が @p local を指す場合に限り解放し、共有の変換手順は解放しません。
+     *
+     *  @param[in,out]  local struct_meta_internal_binary_plan_acquire() に渡した作業領域です。
+     *  @param[in]      plan 取得した変換手順です。
+     */
+    void struct_meta_internal_binary_plan_release(struct_meta_internal_binary_plan *local,
+                                                  const struct_meta_internal_binary_plan *plan);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* STRUCT_META_BINARY_PLAN_H */
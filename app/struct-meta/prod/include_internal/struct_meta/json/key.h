@@ -0,0 +1,70 @@
+/**
+ *******************************************************************************
+ *  @file           key.h
+ *  @brief          フィールドの JSON キーを属性から決定し、記述子ごとの JSON キー索引を管理します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_JSON_KEY_H
+#define STRUCT_META_JSON_KEY_H
+
+#include <stddef.h>
+
+#include <struct_meta/meta/meta.h>
+#include <struct_meta/meta/name_index.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /**
+     *  @brief          フィールドの JSON キーを返します。
+     *
+     *  `json.ignore` 属性を持つフィールドは JSON へ含めないため NULL を返します。
+     *  空でない `json.name` 属性があればその値を、なければ C フィールド名を返します。
+     *
+     *  @param[in]      field 対象フィールドです。
+     *  @return         JSON キーです。JSON へ含めないフィールドでは NULL です。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    const char *struct_meta_internal_json_key(const struct_meta_field *field);
+
+    /**
+     *  @brief          記述子の JSON キー索引を返します。
+     *
+     *  索引は struct_meta_internal_json_key() の結果を全フィールド分保持します。
+     *  初回呼び出し時に構築して記述子の登録情報へ公開し、以降は公開済みの索引を返します。
+     *
+     *  @param[in]      descriptor 検査済みの記述子です。
+     *  @return         索引です。登録されていない記述子やメモリー不足の場合は NULL です。
+     *                  NULL の場合、呼び出し側は struct_meta_internal_json_key() で代替します。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    const struct_meta_internal_name_index *struct_meta_internal_json_names(const struct_meta_descriptor *descriptor);
+
+    /**
+     *  @brief          フィールドの JSON キーを、索引があれば索引から返します。
+     *  @param[in]      names struct_meta_internal_json_names() の結果です。NULL を指定できます。
+     *  @param[in]      descriptor 記述子です。
+     *  @param[in]      field_index フィールドの添字です。
+     *  @return         struct_meta_internal_json_key() と同じ値です。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    const char *struct_meta_internal_json_field_key(const struct_meta_internal_name_index *names,
+                                                    const struct_meta_descriptor *descriptor, size_t field_index);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* STRUCT_META_JSON_KEY_H */
@@ -0,0 +1,74 @@
+/**
+ *******************************************************************************
+ *  @file           undo.h
+ *  @brief          JSON デコードが上書きする前の内容を記録し、エラー時に書き戻す取り消しログです。
+ *
+ *  ログは struct_meta_buffer へ、上書き前のバイト列と、その後ろに置く見出し (アドレスとバイト数) を順に追記します。
+ *  見出しを後ろに置くため、書き戻しは末尾から記録と逆順に辿れます。\n
+ *  文字列と可変長配列は、置き換える前の領域をログの確定まで解放せずに残し、
+ *  書き戻しでは新しく確保した領域を、確定では置き換えた領域を解放します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_JSON_UNDO_H
+#define STRUCT_META_JSON_UNDO_H
+
+#include <stddef.h>
+
+#include <struct_meta/memory/allocator.h>
+#include <struct_meta/memory/buffer.h>
+#include <struct_meta/meta/meta.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /**
+     *  @brief          フィールドの値が占める範囲を、上書き前の内容として記録します。
+     *
+     *  ネスト構造体のフィールドは記録しません。ネスト先の各フィールドを書き込む際に、それぞれ記録します。
+     *
+     *  @param[in,out]  log 取り消しログです。NULL の場合は何もしません。
+     *  @param[in]      field 書き込むフィールドです。
+     *  @param[in]      base フィールドを含む構造体の先頭です。ロールバックはこの領域へ書き戻します。
+     *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。
+     */
+    int struct_meta_internal_undo_record(struct_meta_buffer *log, const struct_meta_field *field,
+                                         unsigned char *base);
+
+    /**
+     *  @brief          文字列、または可変長配列のフィールドの値を、上書き前の内容として記録します。
+     *
+     *  記録した後は、置き換える前の領域を解放せずに新しい値を書き込みます。
+     *  可変長配列の新しい要素の中は記録しません。
+     *
+     *  @param[in,out]  log 取り消しログです。NULL の場合は何もしません。
+     *  @param[in]      field 書き込む動的フィールドです。
+     *  @param[in]      base フィールドを含む構造体の先頭です。
+     *  @param[in]      allocator 新旧の値の領域のアロケーターです。NULL の場合は free() で解放します。
+     *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。
+     */
+    int struct_meta_internal_undo_record_dynamic(struct_meta_buffer *log, const struct_meta_field *field,
+                                                 unsigned char *base, const struct_meta_allocator *allocator);
+
+    /**
+     *  @brief          記録した内容を逆順に書き戻し、ログを空にします。
+     *  @param[in,out]  log 取り消しログです。
+     */
+    void struct_meta_internal_undo_rollback(struct_meta_buffer *log);
+
+    /**
+     *  @brief          書き込みを確定し、置き換えた文字列と可変長配列の領域を解放して、ログを空にします。
+     *  @param[in,out]  log 取り消しログです。
+     */
+    void struct_meta_internal_undo_commit(struct_meta_buffer *log);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* STRUCT_META_JSON_UNDO_H */
@@ -0,0 +1,85 @@
+/**
+ *******************************************************************************
+ *  @file           dynamic.h
+ *  @brief          動的フィールド (文字列と可変長配列) の判定と、領域の確保、解放を行います。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_MEMORY_DYNAMIC_H
+#define STRUCT_META_MEMORY_DYNAMIC_H
+
+#include <stddef.h>
+
+#include <struct_meta/memory/allocator.h>
+#include <struct_meta/meta/meta.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /**
+     *  @brief          値が構造体の外の領域にあるフィールドかを返します。
+     *
+     *  バイト列の複写や比較で値を扱うモジュールは、このフィールドを @c COM_UTIL_ERR_UNSUPPORTED として拒否します。
+     *
+     *  @return         文字列、または可変長配列の場合は 0 以外です。
+     */
+    static inline int struct_meta_internal_field_is_dynamic(const struct_meta_field *field)
+    {
+        return (field->storage != STRUCT_META_STORAGE_INLINE) || (field->kind == STRUCT_META_FIELD_STRING);
+    }
+
+    /**
+     *  @brief          記述子がネストした構造体も含めて動的フィールドを持つかを返します。
+     *  @param[in]      descriptor 検査済みの記述子です。
+     *  @return         動的フィールドを持つ場合は 0 以外です。
+     */
+    int struct_meta_internal_descriptor_has_dynamic(const struct_meta_descriptor *descriptor);
+
+    /**
+     *  @brief          可変長配列フィールドの配置を返します。
+     *  @param[in]      field @c STRUCT_META_STORAGE_SEQUENCE のフィールドです。
+     *  @param[in]      base フィールドを含む構造体の先頭です。
+     */
+    static inline struct_meta_sequence *struct_meta_internal_sequence_of(const struct_meta_field *field,
+                                                                         unsigned char *base)
+    {
+        return (struct_meta_sequence *)(void *)(base + field->offset);
+    }
+
+    /**
+     *  @brief          領域を確保します。
+     *  @param[in]      allocator アロケーターです。NULL の場合は malloc() を使います。
+     *  @param[in]      size バイト数です。
+     *  @return         確保した領域です。メモリー不足の場合は NULL です。
+     */
+    void *struct_meta_internal_allocate(const struct_meta_allocator *allocator, size_t size);
+
+    /**
+     *  @brief          struct_meta_internal_allocate() で確保した領域を解放します。
+     *  @param[in]      allocator アロケーターです。NULL の場合は free() を使います。
+     *  @param[in]      data 解放する領域です。NULL の場合は何もしません。
+     */
+    void struct_meta_internal_release(const struct_meta_allocator *allocator, void *data);
+
+    /**
+     *  @brief          フィールドが指す領域を、要素の中の動的フィールドも含めて解放し、空の値へ戻します。
+     *
+     *  動的フィールドでない構造体フィールドは、ネスト先の動的フィールドを解放します。その他のフィールドは何もしません。
+     *
+     *  @param[in]      field フィールドです。
+     *  @param[in,out]  base フィールドを含む構造体の先頭です。
+     *  @param[in]      allocator 領域を確保したアロケーターです。NULL の場合は free() を使います。
+     */
+    void struct_meta_internal_release_field(const struct_meta_field *field, unsigned char *base,
+                                            const struct_meta_allocator *allocator);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* STRUCT_META_MEMORY_DYNAMIC_H */
@@ -0,0 +1,105 @@
+/**
+ *******************************************************************************
+ *  @file           name_index.h
+ *  @brief          フィールド名からフィールドを引くハッシュ索引です。
+ *
+ *  記述子ごとに 1 回だけ構築し、構築後は変更しません。\n
+ *  索引のキーは、フィールドから名前を取り出す関数で選びます (C フィールド名など)。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_META_NAME_INDEX_H
+#define STRUCT_META_META_NAME_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <struct_meta/meta/meta.h>
+
+/** 索引を構築する最小フィールド数です。これ未満の記述子は線形探索の方が速いため構築しません。 */
+#define STRUCT_META_NAME_INDEX_MIN_FIELDS 8U
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+    /**
+     *  @brief          フィールドから索引のキーを取り出す関数です。
+     *  @param[in]      field 対象フィールドです。
+     *  @return         キー文字列です。索引へ含めない場合は NULL です。
+     */
+    typedef const char *(*struct_meta_internal_name_key_fn)(const struct_meta_field *field);
+
+    /** フィールド名のハッシュ索引です。 */
+    typedef struct struct_meta_internal_name_index
+    {
+        uint32_t *slots; /**< フィールド添字 + 1 を格納するオープン アドレス表です。0 は空きです。NULL は索引なしです。 */
+        size_t mask;     /**< 表の要素数 - 1 です。要素数は 2 の累乗です。 */
+        const char **keys; /**< フィールドごとのキーです。キーを保持しない場合は NULL です。 */
+    } struct_meta_internal_name_index;
+
+    /**
+     *  @brief          名前のハッシュ値を求めます。
+     *  @param[in]      name 名前です。NUL 終端は不要です。
+     *  @param[in]      name_length 名前のバイト数です。
+     *  @return         ハッシュ値です。
+     */
+    uint32_t struct_meta_internal_name_hash(const char *name, size_t name_length);
+
+    /**
+     *  @brief          記述子のフィールドから索引を構築します。
+     *
+     *  フィールド数が @c STRUCT_META_NAME_INDEX_MIN_FIELDS 未満の場合は構築せず、
+     *  @p index_out の slots へ NULL を格納します。
+     *  同じキーを持つフィールドが複数ある場合は、先頭のフィールドを登録します。\n
+     *  キーの取り出しが高価な場合は @p cache_keys を指定すると、フィールド数にかかわらず
+     *  全フィールドのキーを保持し、検索時に @p key_fn を呼び出しません。
+     *
+     *  @param[in]      descriptor 検査済みの記述子です。
+     *  @param[in]      key_fn キーを取り出す関数です。
+     *  @param[in]      cache_keys キーを保持する場合は 0 以外を指定します。
+     *  @param[out]     index_out 構築した索引です。
+     *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    int struct_meta_internal_name_index_build(const struct_meta_descriptor *descriptor,
+                                              struct_meta_internal_name_key_fn key_fn, int cache_keys,
+                                              struct_meta_internal_name_index *index_out);
+
+    /**
+     *  @brief          索引を解放します。
+     *  @param[in,out]  index 対象です。
+     */
+    void struct_meta_internal_name_index_dispose(struct_meta_internal_name_index *index);
+
+    /**
+     *  @brief          名前に一致するフィールドを検索します。
+     *
+     *  索引がない場合 (@p index または slots が NULL) は、フィールド配列を先頭から線形に探索します。
+     *
+     *  @param[in]      index 索引です。
+     *  @param[in]      descriptor 索引を構築した記述子です。
+     *  @param[in]      key_fn 索引の構築に使った関数です。
+     *  @param[in]      name 名前です。NUL 終端は不要です。
+     *  @param[in]      name_length 名前のバイト数です。
+     *  @return         一致したフィールドです。見つからない場合は NULL です。
+     *
+     *  @par            スレッド セーフ
+     *  本関数はスレッド セーフです。
+     */
+    const struct_meta_field *struct_meta_internal_name_index_find(const struct_meta_internal_name_index *index,
+                                                                  const struct_meta_descriptor *descriptor,
+                                                                  struct_meta_internal_name_key_fn key_fn,
+                                                                  const char *name, size_t name_length);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* STRUCT_META_META_NAME_INDEX_H */
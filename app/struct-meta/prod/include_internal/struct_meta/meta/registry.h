@@ -0,0 +1,173 @@
+/**
+ *******************************************************************************
+ *  @file           registry.h
+ *  @brief          検査済み記述子のプロセス内レジストリです。
+ *
+ *  検査に成功した記述子をアドレスで登録し、公開 API の入口で再帰検査を省略します。\n
+ *  登録は struct_meta_descriptor_unregister() で削除するまで残ります。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_META_REGISTRY_H
+#define STRUCT_META_META_REGISTRY_H
+
+#include <stddef.h>
+
+#include <struct_meta/meta/meta.h>
+#include <struct_meta/meta/name_index.h>
+
+/** レジストリの最大登録数です。超過分は登録せず、呼び出しごとに検査します。 */
+#define STRUCT_META_REGISTRY_CAPACITY 4096U
+
+/**
+ *  検索と登録で調べる枠の最大数です。
+ *  表が混み合っても入口の検索がこの回数で終わるようにし、超えた記述子は登録せず呼び出しごとに検査します。
+ */
+#define STRUCT_META_REGISTRY_MAX_PROBE 64U
+
+/** 登録情報へ後から付加する派生データの種類です。 */
+typedef enum struct_meta_internal_extension_kind
+{
+    STRUCT_META_INTERNAL_EXTENSION_JSON_NAMES = 0,  /**< JSON キーの索引 (struct_meta_internal_name_index) です。 */
+    STRUCT_META_INTERNAL_EXTENSION_BINARY_PLAN = 1, /**< バイナリー形式の変換手順 (struct_meta_internal_binary_plan) です。 */
+    STRUCT_META_INTERNAL_EXTENSION_HASH_PLAN = 2,   /**< ハッシュと等価判定の走査手順 (hash/hash.c) です。 */
+    STRUCT_META_INTERNAL_EXTENSION_COUNT = 3        /**< 種類の数です。 */
+} struct_meta_internal_extension_kind;
+
+/**
+ *  @brief          派生データを解放する関数です。
+ *  @param[in,out]  data 公開した派生データです。
+ */
+typedef void (*struct_meta_internal_extension_dispose_fn)(void *data);
+
+/** 派生データ 1 種類分の公開先です。 */
+typedef struct struct_meta_internal_extension
+{
+    void *data;                                        /**< 公開した派生データです (atomic)。 */
+    struct_meta_internal_extension_dispose_fn dispose; /**< @p data を解放する関数です。 */
+} struct_meta_internal_extension;
+
+/**
+ *  @brief          登録済み記述子の情報です。
+ *
+ *  登録時の記述子メンバーを保持し、同じアドレスへ別の記述子が置かれた場合を検出します。\n
+ *  公開後は変更しないため、ロックなしで参照できます。
+ *  モジュール固有の派生データは、初回利用時に @p extensions へ compare-and-swap で公開します。
+ */
+typedef struct struct_meta_internal_descriptor_entry
+{
+    const struct_meta_descriptor *descriptor; /**< 登録した記述子です。 */
+    const char *name;                         /**< 登録時の構造体名です。 */
+    size_t size;                              /**< 登録時の構造体サイズです。 */
+    const struct_meta_field *fields;          /**< 登録時のフィールド配列です。 */
+    size_t field_count;                       /**< 登録時のフィールド数です。 */
+    struct_meta_internal_name_index field_names; /**< C フィールド名の索引です。 */
+    /** 派生データの公開先です。要素数は STRUCT_META_INTERNAL_EXTENSION_COUNT です。 */
+    struct_meta_internal_extension *extensions;
+} struct_meta_internal_descriptor_entry;
+
+/**
+ *  @brief          登録済みの記述子を検索します。
+ *  @param[in]      descriptor 検索対象です。
+ *  @return         登録済みで、登録時と同じ内容の場合はその情報、それ以外は NULL です。
+ *
+ *  @par            スレッド セーフ
+ *  本関数はスレッド セーフです。
+ */
+const struct_meta_internal_descriptor_entry *struct_meta_internal_registry_find(
+    const struct_meta_descriptor *descriptor);
+
+/**
+ *  @brief          検査済みの記述子を登録します。
+ *  @param[in]      descriptor 検査に成功した記述子です。
+ *  @return         登録済み、または登録した場合は @c COM_UTIL_OK、
+ *                  容量不足や同じアドレスの別内容により登録しなかった場合は @c COM_UTIL_SKIPPED、
+ *                  メモリー不足の場合は @c COM_UTIL_ERR_OUT_OF_MEMORY を返します。
+ *
+ *  @par            スレッド セーフ
+ *  本関数はスレッド セーフです。同じ記述子を並行登録しても、登録は 1 件だけです。
+ */
+int struct_meta_internal_registry_add(const struct_meta_descriptor *descriptor);
+
+/**
+ *  @brief          記述子の登録を削除し、登録情報と公開済みの派生データを解放します。
+ *  @param[in]      descriptor 削除対象です。
+ *  @return         削除した場合は @c COM_UTIL_OK、登録されていなかった場合は @c COM_UTIL_SKIPPED を返します。
+ *
+ *  @par            スレッド セーフ
+ *  他の記述子の検索、登録、削除とは並行して呼べます。
+ *  @p descriptor の登録情報を参照中のスレッドがある間は呼んではなりません。
+ */
+int struct_meta_internal_registry_remove(const struct_meta_descriptor *descriptor);
+
+/**
+ *  @brief          記述子を検査済みにし、登録情報を取得します。
+ *
+ *  登録済みの場合は検査を省略します。
+ *  未登録の場合は再帰検査し、成功した記述子とネスト先を登録します。
+ *
+ *  @param[in]      descriptor 対象の記述子です。
+ *  @param[out]     entry_out 登録情報です。不要な場合は NULL を指定します。
+ *                  登録できなかった場合は NULL を格納します。
+ *  @return         @c COM_UTIL_OK、または struct_meta_descriptor_validate() と同じ結果コードを返します。
+ *
+ *  @par            スレッド セーフ
+ *  本関数はスレッド セーフです。
+ */
+int struct_meta_internal_descriptor_acquire(const struct_meta_descriptor *descriptor,
+                                            const struct_meta_internal_descriptor_entry **entry_out);
+
+/**
+ *  @brief          C フィールド名でフィールドを検索します。
+ *
+ *  登録情報に索引があればハッシュ索引で、なければフィールド配列の線形探索で検索します。
+ *
+ *  @param[in]      descriptor 検査済みの記述子です。
+ *  @param[in]      entry @p descriptor の登録情報です。未登録の場合は NULL を指定します。
+ *  @param[in]      name フィールド名です。NUL 終端は不要です。
+ *  @param[in]      name_length フィールド名のバイト数です。
+ *  @return         一致したフィールドです。見つからない場合は NULL です。
+ *
+ *  @par            スレッド セーフ
+ *  本関数はスレッド セーフです。
+ */
+const struct_meta_field *struct_meta_internal_descriptor_find_field(const struct_meta_descriptor *descriptor,
+                                                                    const struct_meta_internal_descriptor_entry *entry,
+                                                                    const char *name, size_t name_length);
+
+/**
+ *  @brief          登録情報に公開済みの派生データを取得します。
+ *  @param[in]      entry 登録情報です。
+ *  @param[in]      kind 派生データの種類です。
+ *  @return         公開済みの派生データです。未公開の場合は NULL です。
+ *
+ *  @par            スレッド セーフ
+ *  本関数はスレッド セーフです。
+ */
+void *struct_meta_internal_extension_get(const struct_meta_internal_descriptor_entry *entry,
+                                         struct_meta_internal_extension_kind kind);
+
+/**
+ *  @brief          派生データを登録情報へ公開します。
+ *
+ *  他スレッドが先に公開していた場合は @p candidate を公開せず、公開済みのデータを返します。
+ *  その場合、@p candidate の解放は呼び出し側が行います。
+ *  公開したデータは、登録を削除する時点で @p dispose により解放します。
+ *
+ *  @param[in]      entry 登録情報です。
+ *  @param[in]      kind 派生データの種類です。
+ *  @param[in]      candidate 公開する派生データです。
+ *  @param[in]      dispose @p candidate を解放する関数です。
+ *  @return         公開された派生データです (@p candidate または先に公開されたデータ)。
+ *
+ *  @par            スレッド セーフ
+ *  本関数はスレッド セーフです。
+ */
+void *struct_meta_internal_extension_publish(const struct_meta_internal_descriptor_entry *entry,
+                                             struct_meta_internal_extension_kind kind, void *candidate,
+                                             struct_meta_internal_extension_dispose_fn dispose);
+
+#endif /* STRUCT_META_META_REGISTRY_H */
@@ -0,0 +1,424 @@
+/**
+ *******************************************************************************
+ *  @file           scalar.h
+ *  @brief          整数、bool、列挙のフィールド値を、要素のバイト数に応じて読み書きします。
+ *
+ *  値は 64 ビット整数を経由して受け渡し、double へは変換しません。\n
+ *  int と unsigned int も同じ関数で扱えますが、既存の処理との互換のため、各モジュールは従来の処理を残しています。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_META_SCALAR_H
+#define STRUCT_META_META_SCALAR_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <struct_meta/meta/meta.h>
+
+#include <com_util/base/result.h>
+
+/** 整数として扱うフィールド種別の分類です。 */
+typedef enum struct_meta_internal_integer_class
+{
+    STRUCT_META_INTERNAL_INTEGER_NONE = 0,     /**< 整数ではありません (浮動小数点、char 配列、構造体)。 */
+    STRUCT_META_INTERNAL_INTEGER_SIGNED = 1,   /**< 符号付き整数です (int、int8/16/64、列挙)。 */
+    STRUCT_META_INTERNAL_INTEGER_UNSIGNED = 2, /**< 符号なし整数です (unsigned int、uint8/16/64)。 */
+    STRUCT_META_INTERNAL_INTEGER_BOOL = 3      /**< bool です。 */
+} struct_meta_internal_integer_class;
+
+/**
+ *  @brief          フィールド種別を整数としての分類へ変換します。
+ */
+static inline struct_meta_internal_integer_class struct_meta_internal_integer_class_of(struct_meta_field_kind kind)
+{
+    switch (kind)
+    {
+    case STRUCT_META_FIELD_INT:
+    case STRUCT_META_FIELD_INT8:
+    case STRUCT_META_FIELD_INT16:
+    case STRUCT_META_FIELD_INT64:
+    case STRUCT_META_FIELD_ENUM:
+        return STRUCT_META_INTERNAL_INTEGER_SIGNED;
+    case STRUCT_META_FIELD_UNSIGNED:
+    case STRUCT_META_FIELD_UINT8:
+    case STRUCT_META_FIELD_UINT16:
+    case STRUCT_META_FIELD_UINT64:
+        return STRUCT_META_INTERNAL_INTEGER_UNSIGNED;
+    case STRUCT_META_FIELD_BOOL:
+        return STRUCT_META_INTERNAL_INTEGER_BOOL;
+    case STRUCT_META_FIELD_FLOAT:
+    case STRUCT_META_FIELD_DOUBLE:
+    case STRUCT_META_FIELD_CHAR_ARRAY:
+    case STRUCT_META_FIELD_STRUCT:
+    case STRUCT_META_FIELD_STRING:
+    default:
+        return STRUCT_META_INTERNAL_INTEGER_NONE;
+    }
+}
+
+/**
+ *  @brief          フィールド種別と要素のバイト数の組み合わせが正しいかを返します。
+ *
+ *  固定幅の整数と bool は型の幅と一致しなければなりません。
+ *  列挙の幅はコンパイラーが決めるため、1、2、4、8 バイトのいずれかを受け付けます。文字列はポインターの幅です。
+ *  従来からある種別は、各モジュールが扱える幅を個別に確認するため、ここでは検査しません。
+ *
+ *  @return         正しい場合は 1、それ以外は 0 です。
+ */
+static inline int struct_meta_internal_kind_size_valid(struct_meta_field_kind kind, size_t element_size)
+{
+    switch (kind)
+    {
+    case STRUCT_META_FIELD_INT8:
+    case STRUCT_META_FIELD_UINT8:
+        return element_size == 1U;
+    case STRUCT_META_FIELD_INT16:
+    case STRUCT_META_FIELD_UINT16:
+        return element_size == 2U;
+    case STRUCT_META_FIELD_INT64:
+    case STRUCT_META_FIELD_UINT64:
+        return element_size == 8U;
+    case STRUCT_META_FIELD_BOOL:
+        return element_size == sizeof(bool);
+    case STRUCT_META_FIELD_ENUM:
+        return (element_size == 1U) || (element_size == 2U) || (element_size == 4U) || (element_size == 8U);
+    case STRUCT_META_FIELD_STRING:
+        return element_size == sizeof(char *);
+    case STRUCT_META_FIELD_INT:
+    case STRUCT_META_FIELD_UNSIGNED:
+    case STRUCT_META_FIELD_FLOAT:
+    case STRUCT_META_FIELD_DOUBLE:
+    case STRUCT_META_FIELD_CHAR_ARRAY:
+    case STRUCT_META_FIELD_STRUCT:
+    default:
+        return 1;
+    }
+}
+
+/**
+ *  @brief          符号付き整数の値を読み取ります。
+ *  @param[in]      ptr 値の先頭です。アラインメントは不要です。
+ *  @param[in]      size 値のバイト数です。1、2、4、8 のいずれかです。
+ */
+static inline int64_t struct_meta_internal_load_signed(const void *ptr, size_t size)
+{
+    switch (size)
+    {
+    case 1U:
+    {
+        int8_t value;
+        memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+    case 2U:
+    {
+        int16_t value;
+        memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+    case 4U:
+    {
+        int32_t value;
+        memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+    default:
+    {
+        int64_t value;
+        memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+    }
+}
+
+/**
+ *  @brief          符号なし整数の値を読み取ります。bool は 0 以外を 1 として返します。
+ *  @param[in]      ptr 値の先頭です。アラインメントは不要です。
+ *  @param[in]      size 値のバイト数です。1、2、4、8 のいずれかです。
+ */
+static inline uint64_t struct_meta_internal_load_unsigned(const void *ptr, size_t size)
+{
+    switch (size)
+    {
+    case 1U:
+    {
+        uint8_t value;
+        memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+    case 2U:
+    {
+        uint16_t value;
+        memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+    case 4U:
+    {
+        uint32_t value;
+        memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+    default:
+    {
+        uint64_t value;
+        memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+    }
+}
+
+/**
+ *  @brief          符号付き整数の値を、範囲を確認して書き込みます。
+ *  @return         @c COM_UTIL_OK、または @p size バイトに収まらない場合は @c COM_UTIL_ERR_OUT_OF_RANGE を返します。
+ */
+static inline int struct_meta_internal_store_signed(void *ptr, size_t size, int64_t value)
+{
+    switch (size)
+    {
+    case 1U:
+    {
+        if ((value < INT8_MIN) || (value > INT8_MAX))
+        {
+            return COM_UTIL_ERR_OUT_OF_RANGE;
+        }
+        int8_t narrow = (int8_t)value;
+        memcpy(ptr, &narrow, sizeof(narrow));
+        return COM_UTIL_OK;
+    }
+    case 2U:
+    {
+        if ((value < INT16_MIN) || (value > INT16_MAX))
+        {
+            return COM_UTIL_ERR_OUT_OF_RANGE;
+        }
+        int16_t narrow = (int16_t)value;
+        memcpy(ptr, &narrow, sizeof(narrow));
+        return COM_UTIL_OK;
+    }
+    case 4U:
+    {
+        if ((value < INT32_MIN) || (value > INT32_MAX))
+        {
+            return COM_UTIL_ERR_OUT_OF_RANGE;
+        }
+        int32_t narrow = (int32_t)value;
+        memcpy(ptr, &narrow, sizeof(narrow));
+        return COM_UTIL_OK;
+    }
+    default:
+        memcpy(ptr, &value, sizeof(value));
+        return COM_UTIL_OK;
+    }
+}
+
+/**
+ *  @brief          符号なし整数の値を、範囲を確認して書き込みます。
+ *  @return         @c COM_UTIL_OK、または @p size バイトに収まらない場合は @c COM_UTIL_ERR_OUT_OF_RANGE を返します。
+ */
+static inline int struct_meta_internal_store_unsigned(void *ptr, size_t size, uint64_t value)
+{
+    switch (size)
+    {
+    case 1U:
+    {
+        if (value > UINT8_MAX)
+        {
+            return COM_UTIL_ERR_OUT_OF_RANGE;
+        }
+        uint8_t narrow = (uint8_t)value;
+        memcpy(ptr, &narrow, sizeof(narrow));
+        return COM_UTIL_OK;
+    }
+    case 2U:
+    {
+        if (value > UINT16_MAX)
+        {
+            return COM_UTIL_ERR_OUT_OF_RANGE;
+        }
+        uint16_t narrow = (uint16_t)value;
+        memcpy(ptr, &narrow, sizeof(narrow));
+        return COM_UTIL_OK;
+    }
+    case 4U:
+    {
+        if (value > UINT32_MAX)
+        {
+            return COM_UTIL_ERR_OUT_OF_RANGE;
+        }
+        uint32_t narrow = (uint32_t)value;
+        memcpy(ptr, &narrow, sizeof(narrow));
+        return COM_UTIL_OK;
+    }
+    default:
+        memcpy(ptr, &value, sizeof(value));
+        return COM_UTIL_OK;
+    }
+}
+
+/**
+ *  @brief          bool の値を書き込みます。
+ *  @return         @c COM_UTIL_OK、または @p value が 0 と 1 以外の場合は @c COM_UTIL_ERR_OUT_OF_RANGE を返します。
+ */
+static inline int struct_meta_internal_store_bool(void *ptr, uint64_t value)
+{
+    if (value > 1U)
+    {
+        return COM_UTIL_ERR_OUT_OF_RANGE;
+    }
+    bool flag = (value != 0U);
+    memcpy(ptr, &flag, sizeof(flag));
+    return COM_UTIL_OK;
+}
+
+/** double が連続する整数を正確に表せる上限 (2^53) です。 */
+#define STRUCT_META_INTERNAL_EXACT_INTEGER_LIMIT 9007199254740992.0
+
+/**
+ *  @brief          整数表記 (`-` と数字だけ) のテキストの絶対値を、double を経由せずに求めます。
+ *  @return         1 (非負)、-1 (負)、または整数表記でないか uint64_t に収まらない場合は 0 です。
+ */
+static inline int struct_meta_internal_integer_from_text(const char *text, size_t length, uint64_t *magnitude_out)
+{
+    size_t i = 0U;
+    int sign = 1;
+    if ((length > 0U) && (text[0] == '-'))
+    {
+        sign = -1;
+        i = 1U;
+    }
+    if (i == length)
+    {
+        return 0;
+    }
+    uint64_t magnitude = 0U;
+    for (; i < length; i++)
+    {
+        if ((text[i] < '0') || (text[i] > '9'))
+        {
+            return 0;
+        }
+        unsigned int digit = (unsigned int)(text[i] - '0');
+        if (magnitude > ((UINT64_MAX - digit) / 10U))
+        {
+            return 0;
+        }
+        magnitude = (magnitude * 10U) + digit;
+    }
+    *magnitude_out = magnitude;
+    return sign;
+}
+
+/**
+ *  @brief          double の値を、正確に表せる範囲の整数の符号と絶対値へ変換します。
+ *  @return         1 (非負)、-1 (負)、または整数でないか絶対値が 2^53 を超える場合は 0 です。
+ */
+static inline int struct_meta_internal_integer_from_double(double value, uint64_t *magnitude_out)
+{
+    double magnitude = (value < 0.0) ? -value : value;
+    if (!(magnitude <= STRUCT_META_INTERNAL_EXACT_INTEGER_LIMIT))
+    {
+        return 0;
+    }
+    uint64_t integer = (uint64_t)magnitude;
+    if ((double)integer != magnitude)
+    {
+        return 0;
+    }
+    *magnitude_out = integer;
+    return (value < 0.0) ? -1 : 1;
+}
+
+/**
+ *  @brief          符号と絶対値を int64_t へ変換します。
+ *  @return         @c COM_UTIL_OK、または int64_t に収まらない場合は @c COM_UTIL_ERR_OUT_OF_RANGE を返します。
+ */
+static inline int struct_meta_internal_signed_from_magnitude(int sign, uint64_t magnitude, int64_t *value_out)
+{
+    if (sign >= 0)
+    {
+        if (magnitude > (uint64_t)INT64_MAX)
+        {
+            return COM_UTIL_ERR_OUT_OF_RANGE;
+        }
+        *value_out = (int64_t)magnitude;
+        return COM_UTIL_OK;
+    }
+    if (magnitude > ((uint64_t)INT64_MAX + 1U))
+    {
+        return COM_UTIL_ERR_OUT_OF_RANGE;
+    }
+    /* INT64_MIN の絶対値は INT64_MAX を超えるため、1 を引いてから符号を反転する。 */
+    *value_out = (magnitude == 0U) ? 0 : (-(int64_t)(magnitude - 1U) - 1);
+    return COM_UTIL_OK;
+}
+
+/**
+ *  @brief          符号と絶対値で表した整数を、フィールド種別に応じて範囲を確認して書き込みます。
+ *  @return         @c COM_UTIL_OK、範囲外の場合は @c COM_UTIL_ERR_OUT_OF_RANGE、
+ *                  整数の種別でない場合は @c COM_UTIL_ERR_INVALID_ARGUMENT を返します。
+ */
+static inline int struct_meta_internal_store_integer(struct_meta_field_kind kind, void *ptr, size_t size, int sign,
+                                                     uint64_t magnitude)
+{
+    switch (struct_meta_internal_integer_class_of(kind))
+    {
+    case STRUCT_META_INTERNAL_INTEGER_SIGNED:
+    {
+        int64_t value;
+        int ret = struct_meta_internal_signed_from_magnitude(sign, magnitude, &value);
+        if (ret != COM_UTIL_OK)
+        {
+            return ret;
+        }
+        return struct_meta_internal_store_signed(ptr, size, value);
+    }
+    case STRUCT_META_INTERNAL_INTEGER_UNSIGNED:
+        /* -0 は 0 として受け付ける。 */
+        if ((sign < 0) && (magnitude != 0U))
+        {
+            return COM_UTIL_ERR_OUT_OF_RANGE;
+        }
+        return struct_meta_internal_store_unsigned(ptr, size, magnitude);
+    case STRUCT_META_INTERNAL_INTEGER_BOOL:
+    case STRUCT_META_INTERNAL_INTEGER_NONE:
+    default:
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+}
+
+/**
+ *  @brief          整数、bool、列挙の値 1 個を文字列へ整形します。
+ *
+ *  整数は 10 進数、bool は `true` または `false` です。
+ *
+ *  @return         整形した場合は 1、整数として扱わない種別の場合は 0 です。
+ */
+static inline int struct_meta_internal_format_integer(struct_meta_field_kind kind, const void *ptr, size_t size,
+                                                      char *dest, size_t dest_size)
+{
+    switch (struct_meta_internal_integer_class_of(kind))
+    {
+    case STRUCT_META_INTERNAL_INTEGER_SIGNED:
+        snprintf(dest, dest_size, "%" PRId64, struct_meta_internal_load_signed(ptr, size));
+        return 1;
+    case STRUCT_META_INTERNAL_INTEGER_UNSIGNED:
+        snprintf(dest, dest_size, "%" PRIu64, struct_meta_internal_load_unsigned(ptr, size));
+        return 1;
+    case STRUCT_META_INTERNAL_INTEGER_BOOL:
+        snprintf(dest, dest_size, "%s", (struct_meta_internal_load_unsigned(ptr, size) != 0U) ? "true" : "false");
+        return 1;
+    case STRUCT_META_INTERNAL_INTEGER_NONE:
+    default:
+        return 0;
+    }
+}
+
+#endif /* STRUCT_META_META_SCALAR_H */
@@ -9,9 +9,12 @@
  */
 
 #include <struct_meta/access/access.h>
+#include <struct_meta/memory/dynamic.h>
+#include <struct_meta/meta/registry.h>
 
 #include <com_util/base/result.h>
 
+#include <stdint.h>
 #include <string.h>
 
 /* Doxygen コメントは、ヘッダーに記載 */
@@ -25,7 +28,7 @@ int struct_meta_descriptor_get_field(const struct_meta_descriptor *descriptor, s
     }
     *field_out = NULL;
 
-    int ret = struct_meta_descriptor_validate(descriptor);
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
     if (ret != COM_UTIL_OK)
     {
         return ret;
@@ -50,21 +53,19 @@ int struct_meta_descriptor_find_field(const struct_meta_descriptor *descriptor,
     }
     *field_out = NULL;
 
-    int ret = struct_meta_descriptor_validate(descriptor);
+    const struct_meta_internal_descriptor_entry *entry = NULL;
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, &entry);
     if (ret != COM_UTIL_OK)
     {
         return ret;
     }
 
-    for (size_t i = 0; i < descriptor->field_count; i++)
+    *field_out = struct_meta_internal_descriptor_find_field(descriptor, entry, name, strlen(name));
+    if (*field_out == NULL)
     {
-        if (strcmp(descriptor->fields[i].name, name) == 0)
-        {
-            *field_out = &descriptor->fields[i];
-            return COM_UTIL_OK;
-        }
+        return COM_UTIL_ERR_NOT_FOUND;
     }
-    return COM_UTIL_ERR_NOT_FOUND;
+    return COM_UTIL_OK;
 }
 
 /* Doxygen コメントは、ヘッダーに記載 */
@@ -98,6 +99,16 @@ int struct_meta_field_get_element(const struct_meta_field *field, void *instance
         return COM_UTIL_ERR_INVALID_ARGUMENT;
     }
     *element_out = NULL;
+    if (field->storage == STRUCT_META_STORAGE_SEQUENCE)
+    {
+        const struct_meta_sequence *sequence = struct_meta_internal_sequence_of(field, (unsigned char *)instance);
+        if (index >= sequence->count)
+        {
+            return COM_UTIL_ERR_OUT_OF_RANGE;
+        }
+        *element_out = (unsigned char *)sequence->items + (index * field->element_size);
+        return COM_UTIL_OK;
+    }
     if (index >= field->element_count)
     {
         return COM_UTIL_ERR_OUT_OF_RANGE;
@@ -117,6 +128,17 @@ int struct_meta_field_get_const_element(const struct_meta_field *field, const vo
         return COM_UTIL_ERR_INVALID_ARGUMENT;
     }
     *element_out = NULL;
+    if (field->storage == STRUCT_META_STORAGE_SEQUENCE)
+    {
+        const struct_meta_sequence *sequence =
+            struct_meta_internal_sequence_of(field, (unsigned char *)(uintptr_t)instance);
+        if (index >= sequence->count)
+        {
+            return COM_UTIL_ERR_OUT_OF_RANGE;
+        }
+        *element_out = (const unsigned char *)sequence->items + (index * field->element_size);
+        return COM_UTIL_OK;
+    }
     if (index >= field->element_count)
     {
         return COM_UTIL_ERR_OUT_OF_RANGE;
@@ -0,0 +1,234 @@
+/**
+ *******************************************************************************
+ *  @file           column.c
+ *  @brief          構造体配列の 1 個の値を、密に並べた列との間で一括複写します。
+ *
+ *  引数の検査とオフセットの解決は呼び出しごとに 1 回だけ行い、要素ごとのループはアドレスの加算と複写だけです。\n
+ *  整数、bool、列挙、float、double の要素は 1、2、4、8 バイト固定の複写で処理し、
+ *  コンパイラーがロードとストアへ展開してベクトル化できる形にしています。
+ *  要素間隔が値のバイト数と等しい場合 (値だけの配列) は、列全体を memcpy 1 回で複写します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/access/access.h>
+#include <struct_meta/base/array.h>
+
+#include <com_util/base/result.h>
+
+#include <stdint.h>
+#include <string.h>
+
+static void gather_1(const unsigned char *source, size_t count, size_t stride, unsigned char *column)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        column[i] = source[i * stride];
+    }
+}
+
+static void gather_2(const unsigned char *source, size_t count, size_t stride, unsigned char *column)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        uint16_t value;
+        memcpy(&value, source + (i * stride), sizeof(value));
+        memcpy(column + (i * sizeof(value)), &value, sizeof(value));
+    }
+}
+
+static void gather_4(const unsigned char *source, size_t count, size_t stride, unsigned char *column)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t value;
+        memcpy(&value, source + (i * stride), sizeof(value));
+        memcpy(column + (i * sizeof(value)), &value, sizeof(value));
+    }
+}
+
+static void gather_8(const unsigned char *source, size_t count, size_t stride, unsigned char *column)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t value;
+        memcpy(&value, source + (i * stride), sizeof(value));
+        memcpy(column + (i * sizeof(value)), &value, sizeof(value));
+    }
+}
+
+static void scatter_1(const unsigned char *column, size_t count, size_t stride, unsigned char *target)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        target[i * stride] = column[i];
+    }
+}
+
+static void scatter_2(const unsigned char *column, size_t count, size_t stride, unsigned char *target)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        uint16_t value;
+        memcpy(&value, column + (i * sizeof(value)), sizeof(value));
+        memcpy(target + (i * stride), &value, sizeof(value));
+    }
+}
+
+static void scatter_4(const unsigned char *column, size_t count, size_t stride, unsigned char *target)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t value;
+        memcpy(&value, column + (i * sizeof(value)), sizeof(value));
+        memcpy(target + (i * stride), &value, sizeof(value));
+    }
+}
+
+static void scatter_8(const unsigned char *column, size_t count, size_t stride, unsigned char *target)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t value;
+        memcpy(&value, column + (i * sizeof(value)), sizeof(value));
+        memcpy(target + (i * stride), &value, sizeof(value));
+    }
+}
+
+/**
+ *  @brief          固定幅の複写を使える数値の要素かを判定し、その幅を返します。
+ *  @return         1、2、4、8 のいずれか、それ以外の値では 0 です。
+ */
+static size_t scalar_width(const struct_meta_path_handle *handle)
+{
+    switch (handle->kind)
+    {
+    case STRUCT_META_FIELD_INT:
+    case STRUCT_META_FIELD_UNSIGNED:
+    case STRUCT_META_FIELD_FLOAT:
+    case STRUCT_META_FIELD_DOUBLE:
+    case STRUCT_META_FIELD_INT8:
+    case STRUCT_META_FIELD_INT16:
+    case STRUCT_META_FIELD_INT64:
+    case STRUCT_META_FIELD_UINT8:
+    case STRUCT_META_FIELD_UINT16:
+    case STRUCT_META_FIELD_UINT64:
+    case STRUCT_META_FIELD_BOOL:
+    case STRUCT_META_FIELD_ENUM:
+        if ((handle->size == 1U) || (handle->size == 2U) || (handle->size == 4U) || (handle->size == 8U))
+        {
+            return handle->size;
+        }
+        return 0U;
+    case STRUCT_META_FIELD_CHAR_ARRAY:
+    case STRUCT_META_FIELD_STRUCT:
+    case STRUCT_META_FIELD_STRING:
+    default:
+        return 0U;
+    }
+}
+
+/**
+ *  @brief          引数を検査し、要素間隔を決定します。
+ */
+static int check_column(const struct_meta_path_handle *handle, const void *base, size_t count, size_t stride,
+                        const void *column, size_t *stride_out)
+{
+    if ((handle == NULL) || (handle->field == NULL) || ((column == NULL) && (count > 0U)))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if ((count > 0U) && (handle->size > (SIZE_MAX / count)))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    return struct_meta_internal_array_stride(handle->descriptor, base, count, stride, stride_out);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_gather(const struct_meta_path_handle *handle, const void *base, size_t count, size_t stride,
+                       void *column_out)
+{
+    int ret = check_column(handle, base, count, stride, column_out, &stride);
+    if ((ret != COM_UTIL_OK) || (count == 0U))
+    {
+        return ret;
+    }
+
+    const unsigned char *source = (const unsigned char *)base + handle->offset;
+    unsigned char *column = (unsigned char *)column_out;
+    size_t size = handle->size;
+    if (stride == size)
+    {
+        memcpy(column, source, size * count);
+        return COM_UTIL_OK;
+    }
+    switch (scalar_width(handle))
+    {
+    case 1U:
+        gather_1(source, count, stride, column);
+        break;
+    case 2U:
+        gather_2(source, count, stride, column);
+        break;
+    case 4U:
+        gather_4(source, count, stride, column);
+        break;
+    case 8U:
+        gather_8(source, count, stride, column);
+        break;
+    default:
+        for (size_t i = 0; i < count; i++)
+        {
+            memcpy(column + (i * size), source + (i * stride), size);
+        }
+        break;
+    }
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_scatter(const struct_meta_path_handle *handle, const void *column, size_t count, size_t stride,
+                        void *base)
+{
+    int ret = check_column(handle, base, count, stride, column, &stride);
+    if ((ret != COM_UTIL_OK) || (count == 0U))
+    {
+        return ret;
+    }
+
+    const unsigned char *values = (const unsigned char *)column;
+    unsigned char *target = (unsigned char *)base + handle->offset;
+    size_t size = handle->size;
+    if (stride == size)
+    {
+        memcpy(target, values, size * count);
+        return COM_UTIL_OK;
+    }
+    switch (scalar_width(handle))
+    {
+    case 1U:
+        scatter_1(values, count, stride, target);
+        break;
+    case 2U:
+        scatter_2(values, count, stride, target);
+        break;
+    case 4U:
+        scatter_4(values, count, stride, target);
+        break;
+    case 8U:
+        scatter_8(values, count, stride, target);
+        break;
+    default:
+        for (size_t i = 0; i < count; i++)
+        {
+            memcpy(target + (i * stride), values + (i * size), size);
+        }
+        break;
+    }
+    return COM_UTIL_OK;
+}
@@ -0,0 +1,127 @@
+/**
+ *******************************************************************************
+ *  @file           leaf.c
+ *  @brief          記述子を走査し、末端の値ごとにパスを組み立てて訪問します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/access/leaf.h>
+
+#include <struct_meta/memory/dynamic.h>
+
+#include <com_util/base/result.h>
+
+#include <stdio.h>
+#include <string.h>
+
+static void truncate_prefix(struct_meta_buffer *prefix, size_t length)
+{
+    prefix->length = length;
+    prefix->data[length] = '\0';
+}
+
+static int append_index(struct_meta_buffer *prefix, size_t index)
+{
+    char text[32];
+    int length = snprintf(text, sizeof(text), "[%zu]", index);
+    if ((length < 0) || ((size_t)length >= sizeof(text)))
+    {
+        return COM_UTIL_ERR_UNKNOWN;
+    }
+    return struct_meta_buffer_append(prefix, text, (size_t)length);
+}
+
+static int skips(const struct_meta_internal_leaf_visitor *visitor, size_t offset, size_t size)
+{
+    return (visitor->skip != NULL) && (visitor->skip(visitor->context, offset, size) != 0);
+}
+
+static int walk(const struct_meta_descriptor *desc, size_t base_offset, struct_meta_buffer *prefix,
+                const struct_meta_internal_leaf_visitor *visitor)
+{
+    int ret = COM_UTIL_OK;
+
+    for (size_t i = 0; (i < desc->field_count) && (ret == COM_UTIL_OK); i++)
+    {
+        const struct_meta_field *field = &desc->fields[i];
+        size_t offset = base_offset + field->offset;
+        size_t extent = field->element_size * field->element_count;
+        if (struct_meta_internal_field_is_dynamic(field) != 0)
+        {
+            /* 値が構造体の外にあるフィールドは、オフセットとバイト数で表せない。 */
+            ret = COM_UTIL_ERR_UNSUPPORTED;
+            break;
+        }
+        if (field->kind == STRUCT_META_FIELD_CHAR_ARRAY)
+        {
+            extent = field->char_buffer_size;
+        }
+        if (skips(visitor, offset, extent) != 0)
+        {
+            continue;
+        }
+
+        size_t mark = prefix->length;
+        ret = struct_meta_buffer_append(prefix, field->name, strlen(field->name));
+        if (ret != COM_UTIL_OK)
+        {
+            break;
+        }
+        if (field->kind == STRUCT_META_FIELD_CHAR_ARRAY)
+        {
+            ret = visitor->leaf(visitor->context, field, offset, extent);
+        }
+        else if ((field->kind != STRUCT_META_FIELD_STRUCT) && (field->element_count == 1U))
+        {
+            ret = visitor->leaf(visitor->context, field, offset, field->element_size);
+        }
+        else
+        {
+            size_t name_length = prefix->length;
+            for (size_t element = 0; (element < field->element_count) && (ret == COM_UTIL_OK); element++)
+            {
+                size_t element_offset = offset + (element * field->element_size);
+                if (skips(visitor, element_offset, field->element_size) != 0)
+                {
+                    continue;
+                }
+                if (field->element_count > 1U)
+                {
+                    ret = append_index(prefix, element);
+                }
+                if (field->kind != STRUCT_META_FIELD_STRUCT)
+                {
+                    if (ret == COM_UTIL_OK)
+                    {
+                        ret = visitor->leaf(visitor->context, field, element_offset, field->element_size);
+                    }
+                }
+                else
+                {
+                    if (ret == COM_UTIL_OK)
+                    {
+                        ret = struct_meta_buffer_append(prefix, ".", 1U);
+                    }
+                    if (ret == COM_UTIL_OK)
+                    {
+                        ret = walk(field->nested, element_offset, prefix, visitor);
+                    }
+                }
+                truncate_prefix(prefix, name_length);
+            }
+        }
+        truncate_prefix(prefix, mark);
+    }
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_internal_leaf_walk(const struct_meta_descriptor *descriptor, struct_meta_buffer *prefix,
+                                   const struct_meta_internal_leaf_visitor *visitor)
+{
+    return walk(descriptor, 0U, prefix, visitor);
+}
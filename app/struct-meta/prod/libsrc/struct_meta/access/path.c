@@ -3,12 +3,20 @@
  *  @file           path.c
  *  @brief          C フィールド名と配列添字からなる文字列パスを解決します。
  *
+ *  パスの終端値のオフセットは構造体の内容に依存しないため、
+ *  解決済みハンドルはアドレス 0 を起点に解決したオフセットを保持し、適用時に加算するだけです。\n
+ *  可変長配列の要素は items と count の値で決まるため、struct_meta_path_resolve() だけが解決します。
+ *
  *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
  *
  *******************************************************************************
  */
 
 #include <struct_meta/access/access.h>
+#include <struct_meta/base/array.h>
+#include <struct_meta/memory/dynamic.h>
+#include <struct_meta/meta/registry.h>
+#include <struct_meta/meta/scalar.h>
 
 #include <com_util/base/result.h>
 
@@ -16,20 +24,6 @@
 #include <stdint.h>
 #include <string.h>
 
-static const struct_meta_field *find_field_segment(const struct_meta_descriptor *descriptor, const char *name,
-                                                   size_t name_length)
-{
-    for (size_t i = 0; i < descriptor->field_count; i++)
-    {
-        const struct_meta_field *field = &descriptor->fields[i];
-        if ((strlen(field->name) == name_length) && (strncmp(field->name, name, name_length) == 0))
-        {
-            return field;
-        }
-    }
-    return NULL;
-}
-
 static int parse_index(const char **cursor_in_out, size_t *index_out)
 {
     const char *cursor = *cursor_in_out;
@@ -64,11 +58,23 @@ static int parse_index(const char **cursor_in_out, size_t *index_out)
     return COM_UTIL_OK;
 }
 
-static int resolve_path(const struct_meta_descriptor *descriptor, uintptr_t instance_address, const char *path,
-                        const struct_meta_field **field_out, uintptr_t *value_address_out)
+/**
+ *  @brief          パスを解決し、終端フィールド、終端値のアドレスとバイト数を返します。
+ *
+ *  終端値は、添字付きの配列要素または要素数 1 のフィールドでは要素 1 個、添字のない配列では配列全体です。
+ *  添字のない可変長配列では items と count の組、文字列では char * の値そのものです。\n
+ *  可変長配列の添字は count を上限とし、要素は items が指す領域から解決します。
+ *
+ *  @param[in]      dereference 0 の場合はインスタンスの内容を読まずに解決します (解決済みハンドル用)。
+ *                  その場合、可変長配列の要素と、文字列、可変長配列の終端値は @c COM_UTIL_ERR_UNSUPPORTED です。
+ */
+static int resolve_path(const struct_meta_descriptor *descriptor, const struct_meta_internal_descriptor_entry *entry,
+                        uintptr_t instance_address, int dereference, const char *path,
+                        const struct_meta_field **field_out, uintptr_t *value_address_out, size_t *value_size_out)
 {
     const char *cursor = path;
     const struct_meta_descriptor *current_descriptor = descriptor;
+    const struct_meta_internal_descriptor_entry *current_entry = entry;
     uintptr_t current_address = instance_address;
 
     while (*cursor != '\0')
@@ -88,7 +94,8 @@ static int resolve_path(const struct_meta_descriptor *descriptor, uintptr_t inst
             name_length++;
         } while ((isalnum((unsigned char)*cursor) != 0) || (*cursor == '_'));
 
-        const struct_meta_field *field = find_field_segment(current_descriptor, name, name_length);
+        const struct_meta_field *field =
+            struct_meta_internal_descriptor_find_field(current_descriptor, current_entry, name, name_length);
         if (field == NULL)
         {
             return COM_UTIL_ERR_NOT_FOUND;
@@ -98,11 +105,27 @@ static int resolve_path(const struct_meta_descriptor *descriptor, uintptr_t inst
         int ret = parse_index(&cursor, &index);
         if (ret == COM_UTIL_OK)
         {
-            if ((field->kind == STRUCT_META_FIELD_CHAR_ARRAY) || (index >= field->element_count))
+            if (field->storage == STRUCT_META_STORAGE_SEQUENCE)
+            {
+                if (dereference == 0)
+                {
+                    return COM_UTIL_ERR_UNSUPPORTED;
+                }
+                const struct_meta_sequence *sequence = (const struct_meta_sequence *)value_address;
+                if (index >= sequence->count)
+                {
+                    return COM_UTIL_ERR_OUT_OF_RANGE;
+                }
+                value_address = (uintptr_t)sequence->items + (index * field->element_size);
+            }
+            else if ((field->kind == STRUCT_META_FIELD_CHAR_ARRAY) || (index >= field->element_count))
             {
                 return COM_UTIL_ERR_OUT_OF_RANGE;
             }
-            value_address += index * field->element_size;
+            else
+            {
+                value_address += index * field->element_size;
+            }
             has_index = 1;
         }
         else if (ret != COM_UTIL_SKIPPED)
@@ -112,15 +135,36 @@ static int resolve_path(const struct_meta_descriptor *descriptor, uintptr_t inst
 
         if (*cursor == '\0')
         {
+            if ((dereference == 0) && (struct_meta_internal_field_is_dynamic(field) != 0))
+            {
+                return COM_UTIL_ERR_UNSUPPORTED;
+            }
             *field_out = field;
             *value_address_out = value_address;
+            if (field->kind == STRUCT_META_FIELD_CHAR_ARRAY)
+            {
+                *value_size_out = field->char_buffer_size;
+            }
+            else if ((field->storage == STRUCT_META_STORAGE_SEQUENCE) && (has_index == 0))
+            {
+                *value_size_out = sizeof(struct_meta_sequence);
+            }
+            else if (has_index != 0)
+            {
+                *value_size_out = field->element_size;
+            }
+            else
+            {
+                *value_size_out = field->element_size * field->element_count;
+            }
             return COM_UTIL_OK;
         }
         if (*cursor != '.')
         {
             return COM_UTIL_ERR_INVALID_ARGUMENT;
         }
-        if ((field->kind != STRUCT_META_FIELD_STRUCT) || ((field->element_count > 1U) && (has_index == 0)))
+        if ((field->kind != STRUCT_META_FIELD_STRUCT) ||
+            (((field->element_count > 1U) || (field->storage == STRUCT_META_STORAGE_SEQUENCE)) && (has_index == 0)))
         {
             return COM_UTIL_ERR_INVALID_ARGUMENT;
         }
@@ -131,6 +175,8 @@ static int resolve_path(const struct_meta_descriptor *descriptor, uintptr_t inst
             return COM_UTIL_ERR_INVALID_ARGUMENT;
         }
         current_descriptor = field->nested;
+        /* ネスト先は親の検査時に登録済みのため、登録情報から索引を引き継げる。 */
+        current_entry = struct_meta_internal_registry_find(current_descriptor);
         current_address = value_address;
     }
 
@@ -150,13 +196,15 @@ int struct_meta_path_resolve_const(const struct_meta_descriptor *descriptor, con
     *field_out = NULL;
     *value_out = NULL;
 
-    int ret = struct_meta_descriptor_validate(descriptor);
+    const struct_meta_internal_descriptor_entry *entry = NULL;
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, &entry);
     if (ret != COM_UTIL_OK)
     {
         return ret;
     }
     uintptr_t value_address = 0U;
-    ret = resolve_path(descriptor, (uintptr_t)instance, path, field_out, &value_address);
+    size_t value_size = 0U;
+    ret = resolve_path(descriptor, entry, (uintptr_t)instance, 1, path, field_out, &value_address, &value_size);
     if (ret == COM_UTIL_OK)
     {
         *value_out = (const void *)value_address;
@@ -181,16 +229,251 @@ int struct_meta_path_resolve(const struct_meta_descriptor *descriptor, void *ins
     }
     *field_out = NULL;
 
-    int ret = struct_meta_descriptor_validate(descriptor);
+    const struct_meta_internal_descriptor_entry *entry = NULL;
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, &entry);
     if (ret != COM_UTIL_OK)
     {
         return ret;
     }
     uintptr_t value_address = 0U;
-    ret = resolve_path(descriptor, (uintptr_t)instance, path, field_out, &value_address);
+    size_t value_size = 0U;
+    ret = resolve_path(descriptor, entry, (uintptr_t)instance, 1, path, field_out, &value_address, &value_size);
     if (ret == COM_UTIL_OK)
     {
         *value_out = (void *)value_address;
     }
     return ret;
 }
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_path_compile(const struct_meta_descriptor *descriptor, const char *path,
+                             struct_meta_path_handle *handle_out)
+{
+    if (handle_out == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    memset(handle_out, 0, sizeof(*handle_out));
+
+    if ((descriptor == NULL) || (path == NULL) || (path[0] == '\0'))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    const struct_meta_internal_descriptor_entry *entry = NULL;
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, &entry);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    const struct_meta_field *field = NULL;
+    uintptr_t offset = 0U;
+    size_t size = 0U;
+    ret = resolve_path(descriptor, entry, 0U, 0, path, &field, &offset, &size);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+
+    handle_out->descriptor = descriptor;
+    handle_out->field = field;
+    handle_out->offset = (size_t)offset;
+    handle_out->size = size;
+    handle_out->kind = field->kind;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_path_apply(const struct_meta_path_handle *handle, void *instance, void **value_out)
+{
+    if ((handle == NULL) || (handle->field == NULL) || (instance == NULL) || (value_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    *value_out = (void *)((uintptr_t)instance + handle->offset);
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_path_apply_const(const struct_meta_path_handle *handle, const void *instance, const void **value_out)
+{
+    if ((handle == NULL) || (handle->field == NULL) || (instance == NULL) || (value_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    *value_out = (const void *)((uintptr_t)instance + handle->offset);
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_path_apply_batch(const struct_meta_path_handle *handle, void *instances, size_t count, size_t stride,
+                                 void **values_out)
+{
+    if ((handle == NULL) || (handle->field == NULL) || ((count > 0U) && (values_out == NULL)))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    int ret = struct_meta_internal_array_stride(handle->descriptor, instances, count, stride, &stride);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+
+    uintptr_t address = (uintptr_t)instances + handle->offset;
+    for (size_t i = 0; i < count; i++)
+    {
+        values_out[i] = (void *)address;
+        address += stride;
+    }
+    return COM_UTIL_OK;
+}
+
+/**
+ *  @brief          整数として読み書きする終端値の分類を返します。
+ *  @return         @c COM_UTIL_OK、@c COM_UTIL_ERR_INVALID_ARGUMENT、または @c COM_UTIL_ERR_UNSUPPORTED を返します。
+ */
+static int integer_target(const struct_meta_path_handle *handle, const void *instance,
+                          struct_meta_internal_integer_class *class_out)
+{
+    if ((handle == NULL) || (handle->field == NULL) || (instance == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    struct_meta_internal_integer_class integer_class = struct_meta_internal_integer_class_of(handle->kind);
+    size_t size = handle->size;
+    if ((integer_class == STRUCT_META_INTERNAL_INTEGER_NONE) || (size != handle->field->element_size) ||
+        ((size != 1U) && (size != 2U) && (size != 4U) && (size != 8U)))
+    {
+        /* 添字のない配列は値 1 個ではないため扱わない。 */
+        return COM_UTIL_ERR_UNSUPPORTED;
+    }
+    *class_out = integer_class;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_path_get_int64(const struct_meta_path_handle *handle, const void *instance, int64_t *value_out)
+{
+    struct_meta_internal_integer_class integer_class;
+    int ret = integer_target(handle, instance, &integer_class);
+    if ((ret == COM_UTIL_OK) && (value_out == NULL))
+    {
+        ret = COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+
+    const void *value = (const void *)((uintptr_t)instance + handle->offset);
+    if (integer_class == STRUCT_META_INTERNAL_INTEGER_SIGNED)
+    {
+        *value_out = struct_meta_internal_load_signed(value, handle->size);
+        return COM_UTIL_OK;
+    }
+    uint64_t unsigned_value = struct_meta_internal_load_unsigned(value, handle->size);
+    if (integer_class == STRUCT_META_INTERNAL_INTEGER_BOOL)
+    {
+        unsigned_value = (unsigned_value != 0U) ? 1U : 0U;
+    }
+    if (unsigned_value > (uint64_t)INT64_MAX)
+    {
+        return COM_UTIL_ERR_OUT_OF_RANGE;
+    }
+    *value_out = (int64_t)unsigned_value;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_path_get_uint64(const struct_meta_path_handle *handle, const void *instance, uint64_t *value_out)
+{
+    struct_meta_internal_integer_class integer_class;
+    int ret = integer_target(handle, instance, &integer_class);
+    if ((ret == COM_UTIL_OK) && (value_out == NULL))
+    {
+        ret = COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+
+    const void *value = (const void *)((uintptr_t)instance + handle->offset);
+    if (integer_class == STRUCT_META_INTERNAL_INTEGER_SIGNED)
+    {
+        int64_t signed_value = struct_meta_internal_load_signed(value, handle->size);
+        if (signed_value < 0)
+        {
+            return COM_UTIL_ERR_OUT_OF_RANGE;
+        }
+        *value_out = (uint64_t)signed_value;
+        return COM_UTIL_OK;
+    }
+    uint64_t unsigned_value = struct_meta_internal_load_unsigned(value, handle->size);
+    if (integer_class == STRUCT_META_INTERNAL_INTEGER_BOOL)
+    {
+        unsigned_value = (unsigned_value != 0U) ? 1U : 0U;
+    }
+    *value_out = unsigned_value;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_path_set_int64(const struct_meta_path_handle *handle, void *instance, int64_t value)
+{
+    struct_meta_internal_integer_class integer_class;
+    int ret = integer_target(handle, instance, &integer_class);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+
+    void *target = (void *)((uintptr_t)instance + handle->offset);
+    if (integer_class == STRUCT_META_INTERNAL_INTEGER_SIGNED)
+    {
+        return struct_meta_internal_store_signed(target, handle->size, value);
+    }
+    if (value < 0)
+    {
+        return COM_UTIL_ERR_OUT_OF_RANGE;
+    }
+    if (integer_class == STRUCT_META_INTERNAL_INTEGER_BOOL)
+    {
+        return struct_meta_internal_store_bool(target, (uint64_t)value);
+    }
+    return struct_meta_internal_store_unsigned(target, handle->size, (uint64_t)value);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_path_set_uint64(const struct_meta_path_handle *handle, void *instance, uint64_t value)
+{
+    struct_meta_internal_integer_class integer_class;
+    int ret = integer_target(handle, instance, &integer_class);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+
+    void *target = (void *)((uintptr_t)instance + handle->offset);
+    if (integer_class == STRUCT_META_INTERNAL_INTEGER_SIGNED)
+    {
+        if (value > (uint64_t)INT64_MAX)
+        {
+            return COM_UTIL_ERR_OUT_OF_RANGE;
+        }
+        return struct_meta_internal_store_signed(target, handle->size, (int64_t)value);
+    }
+    if (integer_class == STRUCT_META_INTERNAL_INTEGER_BOOL)
+    {
+        return struct_meta_internal_store_bool(target, value);
+    }
+    return struct_meta_internal_store_unsigned(target, handle->size, value);
+}
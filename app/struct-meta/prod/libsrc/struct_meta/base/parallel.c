@@ -0,0 +1,140 @@
+/**
+ *******************************************************************************
+ *  @file           parallel.c
+ *  @brief          独立したタスクを複数スレッドへ割り振って実行します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/base/parallel.h>
+
+#include <com_util/base/platform.h>
+
+#if defined(PLATFORM_WINDOWS)
+    #include <com_util/base/windows_sdk.h>
+#else /* !PLATFORM_WINDOWS */
+    #include <pthread.h>
+    #include <unistd.h>
+#endif /* PLATFORM_WINDOWS */
+
+/** スレッドへ渡すタスク 1 個分の情報です。 */
+typedef struct parallel_slot
+{
+    struct_meta_internal_task_fn task;
+    void *context;
+    size_t task_index;
+#if defined(PLATFORM_WINDOWS)
+    HANDLE thread;
+#else  /* !PLATFORM_WINDOWS */
+    pthread_t thread;
+#endif /* PLATFORM_WINDOWS */
+    int started;
+    int pad;
+} parallel_slot;
+
+#if defined(PLATFORM_WINDOWS)
+static DWORD WINAPI slot_main(LPVOID argument)
+{
+    parallel_slot *slot = (parallel_slot *)argument;
+    slot->task(slot->context, slot->task_index);
+    return 0U;
+}
+#else  /* !PLATFORM_WINDOWS */
+static void *slot_main(void *argument)
+{
+    parallel_slot *slot = (parallel_slot *)argument;
+    slot->task(slot->context, slot->task_index);
+    return NULL;
+}
+#endif /* PLATFORM_WINDOWS */
+
+static size_t online_cpus(void)
+{
+#if defined(PLATFORM_WINDOWS)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (size_t)info.dwNumberOfProcessors;
+#else  /* !PLATFORM_WINDOWS */
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (count < 1L)
+    {
+        return 1U;
+    }
+    return (size_t)count;
+#endif /* PLATFORM_WINDOWS */
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+size_t struct_meta_internal_parallel_tasks(size_t requested, size_t item_count)
+{
+    size_t tasks = requested;
+    if (tasks == 0U)
+    {
+        tasks = online_cpus();
+    }
+    if (tasks > STRUCT_META_PARALLEL_MAX_THREADS)
+    {
+        tasks = STRUCT_META_PARALLEL_MAX_THREADS;
+    }
+    if (tasks > (item_count / STRUCT_META_PARALLEL_MIN_ITEMS))
+    {
+        tasks = item_count / STRUCT_META_PARALLEL_MIN_ITEMS;
+    }
+    if (tasks == 0U)
+    {
+        tasks = 1U;
+    }
+    return tasks;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_internal_parallel_run(size_t task_count, struct_meta_internal_task_fn task, void *context)
+{
+    parallel_slot slots[STRUCT_META_PARALLEL_MAX_THREADS];
+
+    if ((task == NULL) || (task_count == 0U))
+    {
+        return;
+    }
+    if (task_count > STRUCT_META_PARALLEL_MAX_THREADS)
+    {
+        task_count = STRUCT_META_PARALLEL_MAX_THREADS;
+    }
+
+    for (size_t i = 1; i < task_count; i++)
+    {
+        parallel_slot *slot = &slots[i];
+        slot->task = task;
+        slot->context = context;
+        slot->task_index = i;
+#if defined(PLATFORM_WINDOWS)
+        slot->thread = CreateThread(NULL, 0, slot_main, slot, 0, NULL);
+        slot->started = (slot->thread != NULL);
+#else  /* !PLATFORM_WINDOWS */
+        slot->started = (pthread_create(&slot->thread, NULL, slot_main, slot) == 0);
+#endif /* PLATFORM_WINDOWS */
+    }
+
+    task(context, 0U);
+
+    for (size_t i = 1; i < task_count; i++)
+    {
+        parallel_slot *slot = &slots[i];
+        if (slot->started == 0)
+        {
+            /* スレッドを作成できなかったタスクは、結果を欠かさないよう呼び出し元で実行する。 */
+            task(context, i);
+            continue;
+        }
+#if defined(PLATFORM_WINDOWS)
+        WaitForSingleObject(slot->thread, INFINITE);
+        CloseHandle(slot->thread);
+#else  /* !PLATFORM_WINDOWS */
+        pthread_join(slot->thread, NULL);
+#endif /* PLATFORM_WINDOWS */
+    }
+}
@@ -0,0 +1,320 @@
+/**
+ *******************************************************************************
+ *  @file           binary.c
+ *  @brief          記述子に従って、構造体を固定長のバイナリー形式へ変換します。
+ *
+ *  変換は記述子ごとの変換手順 (binary/plan) を順に適用するだけで、フィールド記述子を都度たどりません。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/binary/binary.h>
+
+#include <struct_meta/binary/plan.h>
+#include <struct_meta/meta/registry.h>
+
+#include <com_util/base/result.h>
+
+#include <string.h>
+
+/* ヘッダー内の各項目のオフセット。 */
+#define HEADER_VERSION_OFFSET 3U
+#define HEADER_LENGTH_OFFSET 4U
+#define HEADER_FINGERPRINT_OFFSET 8U
+
+static const unsigned char s_magic[3] = {'S', 'M', 'B'};
+
+static void store_le(unsigned char *out, uint64_t value, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        out[i] = (unsigned char)(value >> (i * 8U));
+    }
+}
+
+static uint64_t load_le(const unsigned char *in, size_t size)
+{
+    uint64_t value = 0U;
+    for (size_t i = 0; i < size; i++)
+    {
+        value |= (uint64_t)in[i] << (i * 8U);
+    }
+    return value;
+}
+
+static void copy_swapped(unsigned char *out, const unsigned char *in, size_t length, size_t width)
+{
+    for (size_t i = 0; i < length; i += width)
+    {
+        for (size_t j = 0; j < width; j++)
+        {
+            out[i + j] = in[i + width - 1U - j];
+        }
+    }
+}
+
+static void copy_bool(unsigned char *out, const unsigned char *in, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        out[i] = (unsigned char)(in[i] != 0U);
+    }
+}
+
+/**
+ *  @brief          記述子を検査し、変換手順を取得します。ペイロードが 32 ビットの長さに収まらない記述子は扱いません。
+ */
+static int acquire_plan(const struct_meta_descriptor *desc, struct_meta_internal_binary_plan *local,
+                        const struct_meta_internal_binary_plan **plan_out)
+{
+    int ret = struct_meta_internal_descriptor_acquire(desc, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    ret = struct_meta_internal_binary_plan_acquire(desc, local, plan_out);
+    if ((ret == COM_UTIL_OK) && ((uint64_t)(*plan_out)->wire_size > (uint64_t)UINT32_MAX))
+    {
+        struct_meta_internal_binary_plan_release(local, *plan_out);
+        ret = COM_UTIL_ERR_UNSUPPORTED;
+    }
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_binary_fingerprint(const struct_meta_descriptor *descriptor, uint64_t *fingerprint_out)
+{
+    if ((descriptor == NULL) || (fingerprint_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    *fingerprint_out = struct_meta_internal_binary_fingerprint(descriptor);
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_binary_encoded_size(const struct_meta_descriptor *descriptor, size_t *size_out)
+{
+    struct_meta_internal_binary_plan local;
+    const struct_meta_internal_binary_plan *plan = NULL;
+
+    if ((descriptor == NULL) || (size_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    int ret = acquire_plan(descriptor, &local, &plan);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    *size_out = STRUCT_META_BINARY_HEADER_SIZE + plan->wire_size;
+    struct_meta_internal_binary_plan_release(&local, plan);
+    return COM_UTIL_OK;
+}
+
+static int encode_payload(const struct_meta_internal_binary_plan *plan, const unsigned char *host,
+                          unsigned char *payload)
+{
+    for (size_t i = 0; i < plan->op_count; i++)
+    {
+        const struct_meta_internal_binary_op *op = &plan->ops[i];
+        const unsigned char *in = host + op->host_offset;
+        unsigned char *out = payload + op->wire_offset;
+
+        switch (op->kind)
+        {
+        case STRUCT_META_INTERNAL_BINARY_OP_COPY:
+            memcpy(out, in, op->length);
+            break;
+
+        case STRUCT_META_INTERNAL_BINARY_OP_SWAP2:
+            copy_swapped(out, in, op->length, 2U);
+            break;
+
+        case STRUCT_META_INTERNAL_BINARY_OP_SWAP4:
+            copy_swapped(out, in, op->length, 4U);
+            break;
+
+        case STRUCT_META_INTERNAL_BINARY_OP_SWAP8:
+            copy_swapped(out, in, op->length, 8U);
+            break;
+
+        case STRUCT_META_INTERNAL_BINARY_OP_BOOL:
+            copy_bool(out, in, op->length);
+            break;
+
+        case STRUCT_META_INTERNAL_BINARY_OP_CHARS:
+        {
+            /* NUL の後ろの内容は出力へ持ち出さず、同じ文字列は同じバイト列にする。 */
+            const unsigned char *terminator = (const unsigned char *)memchr(in, '\0', op->length);
+            if (terminator == NULL)
+            {
+                return COM_UTIL_ERR_INVALID_ARGUMENT;
+            }
+            size_t used = (size_t)(terminator - in);
+            memcpy(out, in, used);
+            memset(out + used, 0, op->length - used);
+            break;
+        }
+
+        default:
+            return COM_UTIL_ERR_CORRUPT_DESCRIPTOR;
+        }
+    }
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_binary_encode(const struct_meta_descriptor *descriptor, const void *instance,
+                              struct_meta_buffer *buffer)
+{
+    struct_meta_internal_binary_plan local;
+    const struct_meta_internal_binary_plan *plan = NULL;
+
+    if ((descriptor == NULL) || (instance == NULL) || (buffer == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    int ret = acquire_plan(descriptor, &local, &plan);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    size_t record_size = STRUCT_META_BINARY_HEADER_SIZE + plan->wire_size;
+    ret = struct_meta_buffer_reserve(buffer, record_size);
+    if (ret == COM_UTIL_OK)
+    {
+        unsigned char *record = buffer->data + buffer->length;
+        memcpy(record, s_magic, sizeof(s_magic));
+        record[HEADER_VERSION_OFFSET] = (unsigned char)STRUCT_META_BINARY_VERSION;
+        store_le(record + HEADER_LENGTH_OFFSET, (uint64_t)plan->wire_size, 4U);
+        store_le(record + HEADER_FINGERPRINT_OFFSET, plan->fingerprint, 8U);
+        ret = encode_payload(plan, (const unsigned char *)instance, record + STRUCT_META_BINARY_HEADER_SIZE);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        buffer->length += record_size;
+    }
+    if (buffer->data != NULL)
+    {
+        buffer->data[buffer->length] = '\0';
+    }
+    struct_meta_internal_binary_plan_release(&local, plan);
+    return ret;
+}
+
+static int check_header(const struct_meta_internal_binary_plan *plan, const unsigned char *record, size_t length)
+{
+    if (length < STRUCT_META_BINARY_HEADER_SIZE)
+    {
+        return COM_UTIL_ERR_EOF;
+    }
+    if (memcmp(record, s_magic, sizeof(s_magic)) != 0)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if ((record[HEADER_VERSION_OFFSET] != STRUCT_META_BINARY_VERSION) ||
+        (load_le(record + HEADER_FINGERPRINT_OFFSET, 8U) != plan->fingerprint))
+    {
+        return COM_UTIL_ERR_UNSUPPORTED;
+    }
+    if (load_le(record + HEADER_LENGTH_OFFSET, 4U) != (uint64_t)plan->wire_size)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if ((length - STRUCT_META_BINARY_HEADER_SIZE) < plan->wire_size)
+    {
+        return COM_UTIL_ERR_EOF;
+    }
+    return COM_UTIL_OK;
+}
+
+static void decode_payload(const struct_meta_internal_binary_plan *plan, const unsigned char *payload,
+                           unsigned char *host)
+{
+    for (size_t i = 0; i < plan->op_count; i++)
+    {
+        const struct_meta_internal_binary_op *op = &plan->ops[i];
+        const unsigned char *in = payload + op->wire_offset;
+        unsigned char *out = host + op->host_offset;
+
+        switch (op->kind)
+        {
+        case STRUCT_META_INTERNAL_BINARY_OP_SWAP2:
+            copy_swapped(out, in, op->length, 2U);
+            break;
+
+        case STRUCT_META_INTERNAL_BINARY_OP_SWAP4:
+            copy_swapped(out, in, op->length, 4U);
+            break;
+
+        case STRUCT_META_INTERNAL_BINARY_OP_SWAP8:
+            copy_swapped(out, in, op->length, 8U);
+            break;
+
+        case STRUCT_META_INTERNAL_BINARY_OP_BOOL:
+            /* 0 と 1 以外のバイトを bool として読まないよう、0 以外を 1 にそろえる。 */
+            copy_bool(out, in, op->length);
+            break;
+
+        case STRUCT_META_INTERNAL_BINARY_OP_COPY:
+        case STRUCT_META_INTERNAL_BINARY_OP_CHARS:
+        default:
+            memcpy(out, in, op->length);
+            break;
+        }
+    }
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_binary_decode(const struct_meta_descriptor *descriptor, const void *data, size_t length,
+                              void *instance_out, size_t *consumed_out)
+{
+    struct_meta_internal_binary_plan local;
+    const struct_meta_internal_binary_plan *plan = NULL;
+
+    if ((descriptor == NULL) || (data == NULL) || (instance_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    int ret = acquire_plan(descriptor, &local, &plan);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    const unsigned char *record = (const unsigned char *)data;
+    ret = check_header(plan, record, length);
+
+    /* 書き込む前に char 配列の NUL 終端を確かめ、エラーの場合に構造体を変更しないようにする。 */
+    const unsigned char *payload = record + STRUCT_META_BINARY_HEADER_SIZE;
+    for (size_t i = 0; (i < plan->op_count) && (ret == COM_UTIL_OK); i++)
+    {
+        const struct_meta_internal_binary_op *op = &plan->ops[i];
+        if ((op->kind == STRUCT_META_INTERNAL_BINARY_OP_CHARS) &&
+            (memchr(payload + op->wire_offset, '\0', op->length) == NULL))
+        {
+            ret = COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        decode_payload(plan, payload, (unsigned char *)instance_out);
+        if (consumed_out != NULL)
+        {
+            *consumed_out = STRUCT_META_BINARY_HEADER_SIZE + plan->wire_size;
+        }
+    }
+    struct_meta_internal_binary_plan_release(&local, plan);
+    return ret;
+}
@@ -0,0 +1,409 @@
+/**
+ *******************************************************************************
+ *  @file           plan.c
+ *  @brief          記述子からバイナリー形式の変換手順とスキーマ指紋を作ります。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/binary/plan.h>
+
+#include <struct_meta/memory/dynamic.h>
+#include <struct_meta/meta/registry.h>
+
+#include <com_util/base/result.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+/* 64 ビット FNV-1a の初期値と乗数。 */
+#define FINGERPRINT_OFFSET_BASIS 14695981039346656037ULL
+#define FINGERPRINT_PRIME 1099511628211ULL
+
+static uint64_t hash_bytes(uint64_t hash, const void *data, size_t length)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (uint64_t)bytes[i];
+        hash *= FINGERPRINT_PRIME;
+    }
+    return hash;
+}
+
+/**
+ *  @brief          整数をリトル エンディアンの 8 バイトとして要約へ加えます。ホストの語長に依存させません。
+ */
+static uint64_t hash_size(uint64_t hash, size_t value)
+{
+    unsigned char bytes[8];
+    uint64_t wide = (uint64_t)value;
+    for (size_t i = 0; i < sizeof(bytes); i++)
+    {
+        bytes[i] = (unsigned char)(wide >> (i * 8U));
+    }
+    return hash_bytes(hash, bytes, sizeof(bytes));
+}
+
+static uint64_t hash_descriptor(uint64_t hash, const struct_meta_descriptor *desc)
+{
+    hash = hash_size(hash, desc->field_count);
+    for (size_t i = 0; i < desc->field_count; i++)
+    {
+        const struct_meta_field *field = &desc->fields[i];
+        /* 名前は終端の NUL まで含め、隣のフィールド名との境界を区別する。 */
+        hash = hash_bytes(hash, field->name, strlen(field->name) + 1U);
+        hash = hash_size(hash, (size_t)field->kind);
+        hash = hash_size(hash, field->element_size);
+        hash = hash_size(hash, field->element_count);
+        hash = hash_size(hash, field->char_buffer_size);
+        if (field->kind == STRUCT_META_FIELD_STRUCT)
+        {
+            hash = hash_descriptor(hash, field->nested);
+        }
+    }
+    return hash;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+uint64_t struct_meta_internal_binary_fingerprint(const struct_meta_descriptor *descriptor)
+{
+    return hash_descriptor(FINGERPRINT_OFFSET_BASIS, descriptor);
+}
+
+static uint64_t hash_layout(uint64_t hash, const struct_meta_descriptor *desc)
+{
+    hash = hash_size(hash, desc->size);
+    for (size_t i = 0; i < desc->field_count; i++)
+    {
+        const struct_meta_field *field = &desc->fields[i];
+        hash = hash_size(hash, field->offset);
+        if (field->kind == STRUCT_META_FIELD_STRUCT)
+        {
+            hash = hash_layout(hash, field->nested);
+        }
+    }
+    return hash;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+uint64_t struct_meta_internal_binary_layout_fingerprint(const struct_meta_descriptor *descriptor)
+{
+    /* バイト順は、既知の値をホストの表現のまま要約へ加えて区別する。 */
+    const uint32_t byte_order = 0x01020304U;
+    uint64_t hash = hash_descriptor(FINGERPRINT_OFFSET_BASIS, descriptor);
+    hash = hash_bytes(hash, &byte_order, sizeof(byte_order));
+    return hash_layout(hash, descriptor);
+}
+
+/** 変換手順の作成中の状態です。 */
+typedef struct plan_builder
+{
+    struct_meta_internal_binary_op *ops;
+    size_t op_count;
+    size_t op_capacity;
+    size_t wire_size;
+    int little_endian; /* ホストがリトル エンディアンの場合は 0 以外です。 */
+    int pad;
+} plan_builder;
+
+static int host_is_little_endian(void)
+{
+    const uint16_t probe = 1U;
+    unsigned char first;
+    memcpy(&first, &probe, sizeof(first));
+    return first == 1U;
+}
+
+/**
+ *  @brief          変換操作を末尾へ加えます。
+ *
+ *  直前の操作と同じ複写で、構造体とペイロードの両方で連続する場合は、直前の操作を延ばします。
+ */
+static int append_op(plan_builder *builder, struct_meta_internal_binary_op_kind kind, size_t host_offset,
+                     size_t length)
+{
+    if (length > (SIZE_MAX - builder->wire_size))
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    if ((kind == STRUCT_META_INTERNAL_BINARY_OP_COPY) && (builder->op_count > 0U))
+    {
+        struct_meta_internal_binary_op *last = &builder->ops[builder->op_count - 1U];
+        if ((last->kind == STRUCT_META_INTERNAL_BINARY_OP_COPY) && ((last->host_offset + last->length) == host_offset) &&
+            ((last->wire_offset + last->length) == builder->wire_size))
+        {
+            last->length += length;
+            builder->wire_size += length;
+            return COM_UTIL_OK;
+        }
+    }
+
+    if (builder->op_count == builder->op_capacity)
+    {
+        size_t capacity = 16U;
+        if (builder->op_capacity > 0U)
+        {
+            if (builder->op_capacity > ((SIZE_MAX / sizeof(*builder->ops)) / 2U))
+            {
+                return COM_UTIL_ERR_OUT_OF_MEMORY;
+            }
+            capacity = builder->op_capacity * 2U;
+        }
+        struct_meta_internal_binary_op *ops =
+            (struct_meta_internal_binary_op *)realloc(builder->ops, capacity * sizeof(*ops));
+        if (ops == NULL)
+        {
+            return COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+        builder->ops = ops;
+        builder->op_capacity = capacity;
+    }
+
+    struct_meta_internal_binary_op *op = &builder->ops[builder->op_count];
+    op->host_offset = host_offset;
+    op->wire_offset = builder->wire_size;
+    op->length = length;
+    op->kind = kind;
+    op->pad = 0U;
+    builder->op_count++;
+    builder->wire_size += length;
+    return COM_UTIL_OK;
+}
+
+/**
+ *  @brief          数値フィールドのペイロード上の幅を返します。ホストの要素サイズと異なる場合は 0 を返します。
+ */
+static size_t numeric_width(const struct_meta_field *field)
+{
+    size_t width = 4U;
+    switch (field->kind)
+    {
+    case STRUCT_META_FIELD_INT8:
+    case STRUCT_META_FIELD_UINT8:
+        width = 1U;
+        break;
+    case STRUCT_META_FIELD_INT16:
+    case STRUCT_META_FIELD_UINT16:
+        width = 2U;
+        break;
+    case STRUCT_META_FIELD_DOUBLE:
+    case STRUCT_META_FIELD_INT64:
+    case STRUCT_META_FIELD_UINT64:
+        width = 8U;
+        break;
+    case STRUCT_META_FIELD_ENUM:
+        /* 列挙型の幅はコンパイラーが決める。記述子の検査で 1、2、4、8 バイトのいずれかであることを確認済み。 */
+        width = field->element_size;
+        break;
+    case STRUCT_META_FIELD_INT:
+    case STRUCT_META_FIELD_UNSIGNED:
+    case STRUCT_META_FIELD_FLOAT:
+    case STRUCT_META_FIELD_CHAR_ARRAY:
+    case STRUCT_META_FIELD_STRUCT:
+    case STRUCT_META_FIELD_BOOL:
+    case STRUCT_META_FIELD_STRING:
+    default:
+        break;
+    }
+    if (field->element_size != width)
+    {
+        return 0U;
+    }
+    return width;
+}
+
+static int build_descriptor(plan_builder *builder, const struct_meta_descriptor *desc, size_t host_base)
+{
+    int ret = COM_UTIL_OK;
+    for (size_t i = 0; (i < desc->field_count) && (ret == COM_UTIL_OK); i++)
+    {
+        const struct_meta_field *field = &desc->fields[i];
+        size_t host_offset = host_base + field->offset;
+        if (struct_meta_internal_field_is_dynamic(field) != 0)
+        {
+            /* ポインターの値はプロセスの外では意味を持たないため、ペイロードへ含めない。 */
+            return COM_UTIL_ERR_UNSUPPORTED;
+        }
+
+        switch (field->kind)
+        {
+        case STRUCT_META_FIELD_INT:
+        case STRUCT_META_FIELD_UNSIGNED:
+        case STRUCT_META_FIELD_FLOAT:
+        case STRUCT_META_FIELD_DOUBLE:
+        case STRUCT_META_FIELD_INT8:
+        case STRUCT_META_FIELD_INT16:
+        case STRUCT_META_FIELD_INT64:
+        case STRUCT_META_FIELD_UINT8:
+        case STRUCT_META_FIELD_UINT16:
+        case STRUCT_META_FIELD_UINT64:
+        case STRUCT_META_FIELD_ENUM:
+        {
+            size_t width = numeric_width(field);
+            if (width == 0U)
+            {
+                return COM_UTIL_ERR_UNSUPPORTED;
+            }
+            if ((builder->little_endian != 0) || (width == 1U))
+            {
+                ret = append_op(builder, STRUCT_META_INTERNAL_BINARY_OP_COPY, host_offset,
+                                width * field->element_count);
+            }
+            else if (width == 2U)
+            {
+                ret = append_op(builder, STRUCT_META_INTERNAL_BINARY_OP_SWAP2, host_offset,
+                                width * field->element_count);
+            }
+            else if (width == 4U)
+            {
+                ret = append_op(builder, STRUCT_META_INTERNAL_BINARY_OP_SWAP4, host_offset,
+                                width * field->element_count);
+            }
+            else
+            {
+                ret = append_op(builder, STRUCT_META_INTERNAL_BINARY_OP_SWAP8, host_offset,
+                                width * field->element_count);
+            }
+            break;
+        }
+
+        case STRUCT_META_FIELD_BOOL:
+            /* ペイロードでは 1 バイトの 0 または 1 とする。 */
+            if (field->element_size != 1U)
+            {
+                return COM_UTIL_ERR_UNSUPPORTED;
+            }
+            ret = append_op(builder, STRUCT_META_INTERNAL_BINARY_OP_BOOL, host_offset, field->element_count);
+            break;
+
+        case STRUCT_META_FIELD_CHAR_ARRAY:
+            ret = append_op(builder, STRUCT_META_INTERNAL_BINARY_OP_CHARS, host_offset, field->char_buffer_size);
+            break;
+
+        case STRUCT_META_FIELD_STRUCT:
+            for (size_t e = 0; (e < field->element_count) && (ret == COM_UTIL_OK); e++)
+            {
+                ret = build_descriptor(builder, field->nested, host_offset + (e * field->element_size));
+            }
+            break;
+
+        case STRUCT_META_FIELD_STRING:
+        default:
+            return COM_UTIL_ERR_CORRUPT_DESCRIPTOR;
+        }
+    }
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_internal_binary_plan_build(const struct_meta_descriptor *descriptor,
+                                           struct_meta_internal_binary_plan *plan_out)
+{
+    if ((descriptor == NULL) || (plan_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    plan_builder builder;
+    memset(&builder, 0, sizeof(builder));
+    builder.little_endian = host_is_little_endian();
+
+    int ret = build_descriptor(&builder, descriptor, 0U);
+    if (ret != COM_UTIL_OK)
+    {
+        free(builder.ops);
+        return ret;
+    }
+    plan_out->fingerprint = struct_meta_internal_binary_fingerprint(descriptor);
+    plan_out->wire_size = builder.wire_size;
+    plan_out->op_count = builder.op_count;
+    plan_out->ops = builder.ops;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_internal_binary_plan_dispose(struct_meta_internal_binary_plan *plan)
+{
+    if (plan == NULL)
+    {
+        return;
+    }
+    free(plan->ops);
+    plan->ops = NULL;
+    plan->op_count = 0U;
+    plan->wire_size = 0U;
+}
+
+/** 登録情報へ公開した変換手順を、登録の削除時に解放します。 */
+static void dispose_published_plan(void *data)
+{
+    struct_meta_internal_binary_plan_dispose((struct_meta_internal_binary_plan *)data);
+    free(data);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_internal_binary_plan_acquire(const struct_meta_descriptor *descriptor,
+                                             struct_meta_internal_binary_plan *local,
+                                             const struct_meta_internal_binary_plan **plan_out)
+{
+    if ((local == NULL) || (plan_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    memset(local, 0, sizeof(*local));
+    const struct_meta_internal_descriptor_entry *entry = struct_meta_internal_registry_find(descriptor);
+    if (entry != NULL)
+    {
+        void *published = struct_meta_internal_extension_get(entry, STRUCT_META_INTERNAL_EXTENSION_BINARY_PLAN);
+        if (published != NULL)
+        {
+            *plan_out = (const struct_meta_internal_binary_plan *)published;
+            return COM_UTIL_OK;
+        }
+    }
+
+    int ret = struct_meta_internal_binary_plan_build(descriptor, local);
+    if ((ret != COM_UTIL_OK) || (entry == NULL))
+    {
+        *plan_out = local;
+        return ret;
+    }
+
+    /* 公開に失敗した場合は、作業領域の変換手順をそのまま使う。 */
+    struct_meta_internal_binary_plan *candidate =
+        (struct_meta_internal_binary_plan *)malloc(sizeof(struct_meta_internal_binary_plan));
+    if (candidate == NULL)
+    {
+        *plan_out = local;
+        return COM_UTIL_OK;
+    }
+    *candidate = *local;
+    local->ops = NULL;
+    void *published = struct_meta_internal_extension_publish(entry, STRUCT_META_INTERNAL_EXTENSION_BINARY_PLAN,
+                                                             candidate, dispose_published_plan);
+    if (published != candidate)
+    {
+        struct_meta_internal_binary_plan_dispose(candidate);
+        free(candidate);
+    }
+    *plan_out = (const struct_meta_internal_binary_plan *)published;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_internal_binary_plan_release(struct_meta_internal_binary_plan *local,
+                                              const struct_meta_internal_binary_plan *plan)
+{
+    if ((local != NULL) && (plan == local))
+    {
+        struct_meta_internal_binary_plan_dispose(local);
+    }
+}
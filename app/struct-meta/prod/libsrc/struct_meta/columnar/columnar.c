@@ -0,0 +1,328 @@
+/**
+ *******************************************************************************
+ *  @file           columnar.c
+ *  @brief          構造体配列 (AoS) と、末端の値ごとの列の集まり (SoA) を相互変換します。
+ *
+ *  列の決定は記述子を 2 回走査します。1 回目で列数と名前の長さを数え、2 回目で 1 個の領域へ書き込みます。\n
+ *  値の複写は列ごとに struct_meta_gather() と struct_meta_scatter() を使います。
+ *  行を一定バイト数ずつの区間に分けて区間ごとに全列を処理するため、行は区間の中でキャッシュに載ったまま読まれます。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/columnar/columnar.h>
+
+#include <struct_meta/access/leaf.h>
+#include <struct_meta/base/array.h>
+#include <struct_meta/base/parallel.h>
+#include <struct_meta/memory/buffer.h>
+#include <struct_meta/meta/registry.h>
+
+#include <com_util/base/result.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* 1 区間に含める行のバイト数の目安。L1 データ キャッシュに収まる大きさとする。 */
+#define ROW_BLOCK_BYTES 16384U
+
+/** 列の決定に使う作業状態です。 */
+typedef struct layout_context
+{
+    const struct_meta_descriptor *root;
+    struct_meta_columnar_column *columns; /* NULL の場合は数えるだけです。 */
+    char *names;
+    size_t column_count;
+    size_t names_length;
+    struct_meta_buffer prefix; /* 走査中のフィールドのパスです。 */
+} layout_context;
+
+static int add_leaf(void *data, const struct_meta_field *field, size_t offset, size_t size)
+{
+    layout_context *context = (layout_context *)data;
+    if (context->columns != NULL)
+    {
+        struct_meta_columnar_column *column = &context->columns[context->column_count];
+        char *path = context->names + context->names_length;
+        memcpy(path, context->prefix.data, context->prefix.length + 1U);
+        column->path = path;
+        column->handle.descriptor = context->root;
+        column->handle.field = field;
+        column->handle.offset = offset;
+        column->handle.size = size;
+        column->handle.kind = field->kind;
+        column->handle.pad = 0U;
+        column->data = NULL;
+    }
+    context->column_count++;
+    context->names_length += context->prefix.length + 1U;
+    return COM_UTIL_OK;
+}
+
+/** 記述子の末端の値ごとに列を加えます。columns が NULL の場合は数えるだけです。 */
+static int add_columns(layout_context *context)
+{
+    struct_meta_internal_leaf_visitor visitor = {NULL, add_leaf, context};
+    return struct_meta_internal_leaf_walk(context->root, &context->prefix, &visitor);
+}
+
+static size_t align_up(size_t value)
+{
+    return (value + (STRUCT_META_COLUMNAR_ALIGNMENT - 1U)) & ~(size_t)(STRUCT_META_COLUMNAR_ALIGNMENT - 1U);
+}
+
+/**
+ *  @brief          列の値の領域のバイト数を求めます。
+ *  @return         @c COM_UTIL_OK、またはアドレス空間に収まらない場合は @c COM_UTIL_ERR_OUT_OF_MEMORY です。
+ */
+static int data_size(const layout_context *counted, size_t row_count, const struct_meta_columnar_column *columns,
+                     size_t *size_out)
+{
+    size_t total = 0U;
+    for (size_t i = 0; i < counted->column_count; i++)
+    {
+        size_t size = columns[i].handle.size;
+        if ((row_count > 0U) && (size > ((SIZE_MAX - STRUCT_META_COLUMNAR_ALIGNMENT) / row_count)))
+        {
+            return COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+        size_t bytes = align_up(size * row_count);
+        if (bytes > (SIZE_MAX - total))
+        {
+            return COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+        total += bytes;
+    }
+    *size_out = total;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_columnar_init(const struct_meta_descriptor *descriptor, size_t row_count,
+                              struct_meta_columnar *block_out)
+{
+    if (block_out == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    memset(block_out, 0, sizeof(*block_out));
+    if (descriptor == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+
+    layout_context context;
+    memset(&context, 0, sizeof(context));
+    context.root = descriptor;
+    struct_meta_buffer_init(&context.prefix);
+    ret = add_columns(&context);
+
+    /* 列の配列、名前、列の値の順に 1 個の領域へ置く。列の値は先頭をアラインメント境界へ合わせる。 */
+    unsigned char *storage = NULL;
+    size_t header_size = (context.column_count * sizeof(struct_meta_columnar_column)) + context.names_length;
+    if (ret == COM_UTIL_OK)
+    {
+        storage = (unsigned char *)calloc(1U, header_size);
+        if (storage == NULL)
+        {
+            ret = COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        context.columns = (struct_meta_columnar_column *)(void *)storage;
+        context.names = (char *)(storage + (context.column_count * sizeof(struct_meta_columnar_column)));
+        context.column_count = 0U;
+        context.names_length = 0U;
+        ret = add_columns(&context);
+    }
+    struct_meta_buffer_dispose(&context.prefix);
+
+    size_t values_size = 0U;
+    if (ret == COM_UTIL_OK)
+    {
+        ret = data_size(&context, row_count, context.columns, &values_size);
+    }
+    if ((ret == COM_UTIL_OK) && (values_size > (SIZE_MAX - header_size - STRUCT_META_COLUMNAR_ALIGNMENT)))
+    {
+        ret = COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        size_t total = header_size + STRUCT_META_COLUMNAR_ALIGNMENT + values_size;
+        unsigned char *grown = (unsigned char *)realloc(storage, total);
+        if (grown == NULL)
+        {
+            ret = COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+        else
+        {
+            storage = grown;
+            memset(storage + header_size, 0, total - header_size);
+        }
+    }
+    if (ret != COM_UTIL_OK)
+    {
+        free(storage);
+        return ret;
+    }
+
+    /* realloc で領域が移動しうるため、名前と列の値のアドレスはここで確定する。 */
+    struct_meta_columnar_column *columns = (struct_meta_columnar_column *)(void *)storage;
+    char *names = (char *)(storage + (context.column_count * sizeof(struct_meta_columnar_column)));
+    uintptr_t values = ((uintptr_t)(storage + header_size) + (STRUCT_META_COLUMNAR_ALIGNMENT - 1U)) &
+                       ~(uintptr_t)(STRUCT_META_COLUMNAR_ALIGNMENT - 1U);
+    size_t names_offset = 0U;
+    for (size_t i = 0; i < context.column_count; i++)
+    {
+        columns[i].path = names + names_offset;
+        names_offset += strlen(columns[i].path) + 1U;
+        columns[i].data = (unsigned char *)values;
+        values += align_up(columns[i].handle.size * row_count);
+    }
+
+    block_out->descriptor = descriptor;
+    block_out->row_count = row_count;
+    block_out->column_count = context.column_count;
+    block_out->columns = columns;
+    block_out->storage = storage;
+    return COM_UTIL_OK;
+}
+
+/** 行の区間ごとの複写で、タスク間で共有する情報です。 */
+typedef struct transpose_job
+{
+    const struct_meta_columnar *block;
+    const unsigned char *source; /* 行から列へ複写する場合の構造体配列です。 */
+    unsigned char *target;       /* 列から行へ複写する場合の構造体配列です。 */
+    size_t stride;
+    size_t task_count;
+} transpose_job;
+
+static void transpose_task(void *context, size_t task_index)
+{
+    const transpose_job *job = (const transpose_job *)context;
+    const struct_meta_columnar *block = job->block;
+    size_t begin = (block->row_count * task_index) / job->task_count;
+    size_t end = (block->row_count * (task_index + 1U)) / job->task_count;
+    size_t rows_per_block = ROW_BLOCK_BYTES / job->stride;
+
+    if (rows_per_block == 0U)
+    {
+        rows_per_block = 1U;
+    }
+    /* 引数は呼び出し元で検査済みのため、列ごとの複写は失敗しない。 */
+    for (size_t row = begin; row < end; row += rows_per_block)
+    {
+        size_t rows = end - row;
+        if (rows > rows_per_block)
+        {
+            rows = rows_per_block;
+        }
+        for (size_t i = 0; i < block->column_count; i++)
+        {
+            const struct_meta_columnar_column *column = &block->columns[i];
+            unsigned char *values = column->data + (row * column->handle.size);
+            if (job->source != NULL)
+            {
+                (void)struct_meta_gather(&column->handle, job->source + (row * job->stride), rows, job->stride,
+                                         values);
+            }
+            else
+            {
+                (void)struct_meta_scatter(&column->handle, values, rows, job->stride,
+                                          job->target + (row * job->stride));
+            }
+        }
+    }
+}
+
+static int transpose(transpose_job *job, const void *base, size_t stride, size_t thread_count)
+{
+    const struct_meta_columnar *block = job->block;
+    if ((block == NULL) || (block->descriptor == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    int ret = struct_meta_internal_array_stride(block->descriptor, base, block->row_count, stride, &job->stride);
+    if ((ret != COM_UTIL_OK) || (block->row_count == 0U))
+    {
+        return ret;
+    }
+
+    job->task_count = struct_meta_internal_parallel_tasks(thread_count, block->row_count);
+    if (job->task_count == 1U)
+    {
+        transpose_task(job, 0U);
+    }
+    else
+    {
+        struct_meta_internal_parallel_run(job->task_count, transpose_task, job);
+    }
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_columnar_from_rows(struct_meta_columnar *block, const void *base, size_t stride, size_t thread_count)
+{
+    transpose_job job;
+
+    memset(&job, 0, sizeof(job));
+    job.block = block;
+    job.source = (const unsigned char *)base;
+    return transpose(&job, base, stride, thread_count);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_columnar_to_rows(const struct_meta_columnar *block, void *base, size_t stride, size_t thread_count)
+{
+    transpose_job job;
+
+    memset(&job, 0, sizeof(job));
+    job.block = block;
+    job.target = (unsigned char *)base;
+    return transpose(&job, base, stride, thread_count);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_columnar_find(const struct_meta_columnar *block, const char *path,
+                              const struct_meta_columnar_column **column_out)
+{
+    if ((block == NULL) || (path == NULL) || (column_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    for (size_t i = 0; i < block->column_count; i++)
+    {
+        if (strcmp(block->columns[i].path, path) == 0)
+        {
+            *column_out = &block->columns[i];
+            return COM_UTIL_OK;
+        }
+    }
+    return COM_UTIL_ERR_NOT_FOUND;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_columnar_dispose(struct_meta_columnar *block)
+{
+    if (block == NULL)
+    {
+        return;
+    }
+    free(block->storage);
+    memset(block, 0, sizeof(*block));
+}
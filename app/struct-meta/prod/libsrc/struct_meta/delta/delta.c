@@ -0,0 +1,312 @@
+/**
+ *******************************************************************************
+ *  @file           delta.c
+ *  @brief          同じ型の 2 個の構造体の差分を求め、構造体へ適用します。
+ *
+ *  差分は記述子を 1 回走査して求めます。フィールドごとに領域全体を memcmp で比較し、一致する場合は
+ *  パスの組み立ても内側の走査も行いません。変更された値は、パスと値を 1 個のバイト列へ、
+ *  一覧をもう 1 個のバイト列へ追記し、最後に 1 個の領域へまとめます。
+ *  末端の値の走査とパスの組み立ては、列ブロックと共通の struct_meta_internal_leaf_walk() を使います。\n
+ *  適用は struct_meta_path_compile() でパスを解決するため、パスの書式は access/path.c と同じです。
+ *  各パスは検査で 1 回だけ解決し、そのハンドルで書き込みます。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/delta/delta.h>
+
+#include <struct_meta/access/access.h>
+#include <struct_meta/access/leaf.h>
+#include <struct_meta/memory/buffer.h>
+#include <struct_meta/memory/dynamic.h>
+#include <struct_meta/meta/registry.h>
+
+#include <com_util/base/result.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* 値の先頭を合わせる境界のバイト数。 */
+#define VALUE_ALIGNMENT 8U
+
+/** 走査中に記録する変更 1 個です。パスと値は bytes の先頭からのオフセットで持ちます。 */
+typedef struct pending_entry
+{
+    size_t path;
+    size_t value;
+    size_t size;
+    struct_meta_field_kind kind;
+    unsigned int pad;
+} pending_entry;
+
+/** 差分の走査に使う作業状態です。 */
+typedef struct diff_context
+{
+    const unsigned char *old_base;
+    const unsigned char *new_base;
+    struct_meta_buffer prefix;  /* 走査中のフィールドのパスです。 */
+    struct_meta_buffer records; /* pending_entry の並びです。 */
+    struct_meta_buffer bytes;   /* パスと値の並びです。 */
+    size_t count;
+} diff_context;
+
+static int add_entry(diff_context *context, struct_meta_field_kind kind, const void *value, size_t size)
+{
+    static const unsigned char zeros[VALUE_ALIGNMENT] = {0};
+    pending_entry entry;
+
+    memset(&entry, 0, sizeof(entry));
+    entry.path = context->bytes.length;
+    entry.size = size;
+    entry.kind = kind;
+    int ret = struct_meta_buffer_append(&context->bytes, context->prefix.data, context->prefix.length + 1U);
+    if (ret == COM_UTIL_OK)
+    {
+        size_t padding = (VALUE_ALIGNMENT - (context->bytes.length % VALUE_ALIGNMENT)) % VALUE_ALIGNMENT;
+        ret = struct_meta_buffer_append(&context->bytes, zeros, padding);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        entry.value = context->bytes.length;
+        ret = struct_meta_buffer_append(&context->bytes, value, size);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_buffer_append(&context->records, &entry, sizeof(entry));
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        context->count++;
+    }
+    return ret;
+}
+
+/** char 配列を最初の NUL まで比較し、異なる場合は NUL を含む新しい文字列を記録します。 */
+static int diff_chars(diff_context *context, const struct_meta_field *field, const unsigned char *old_value,
+                      const unsigned char *new_value)
+{
+    size_t capacity = field->char_buffer_size;
+    const unsigned char *old_end = (const unsigned char *)memchr(old_value, '\0', capacity);
+    const unsigned char *new_end = (const unsigned char *)memchr(new_value, '\0', capacity);
+    size_t old_length = capacity;
+    size_t new_length = capacity;
+
+    if (old_end != NULL)
+    {
+        old_length = (size_t)(old_end - old_value);
+    }
+    if (new_end != NULL)
+    {
+        new_length = (size_t)(new_end - new_value);
+    }
+    if ((old_length == new_length) && (memcmp(old_value, new_value, new_length) == 0))
+    {
+        return COM_UTIL_OK;
+    }
+    if (new_end != NULL)
+    {
+        new_length++;
+    }
+    return add_entry(context, field->kind, new_value, new_length);
+}
+
+/** 領域全体が一致する範囲は、パスを組み立てずに読み飛ばす。 */
+static int skip_unchanged(void *data, size_t offset, size_t size)
+{
+    const diff_context *context = (const diff_context *)data;
+    return memcmp(context->old_base + offset, context->new_base + offset, size) == 0;
+}
+
+static int diff_leaf(void *data, const struct_meta_field *field, size_t offset, size_t size)
+{
+    diff_context *context = (diff_context *)data;
+    if (field->kind == STRUCT_META_FIELD_CHAR_ARRAY)
+    {
+        return diff_chars(context, field, context->old_base + offset, context->new_base + offset);
+    }
+    return add_entry(context, field->kind, context->new_base + offset, size);
+}
+
+/**
+ *  @brief          記録した変更を、一覧、パス、値の順に 1 個の領域へまとめます。
+ *  @return         @c COM_UTIL_OK、または @c COM_UTIL_ERR_OUT_OF_MEMORY です。
+ */
+static int build_delta(const diff_context *context, struct_meta_delta *delta)
+{
+    /* 値の境界を保つため、パスと値の並びの先頭を境界へ合わせる。 */
+    size_t header_size = context->count * sizeof(struct_meta_delta_entry);
+    header_size = (header_size + (VALUE_ALIGNMENT - 1U)) & ~(size_t)(VALUE_ALIGNMENT - 1U);
+    if (context->bytes.length > (SIZE_MAX - header_size))
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    unsigned char *storage = (unsigned char *)malloc(header_size + context->bytes.length);
+    if (storage == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+
+    struct_meta_delta_entry *entries = (struct_meta_delta_entry *)(void *)storage;
+    unsigned char *bytes = storage + header_size;
+    memcpy(bytes, context->bytes.data, context->bytes.length);
+    for (size_t i = 0; i < context->count; i++)
+    {
+        pending_entry pending;
+        memcpy(&pending, context->records.data + (i * sizeof(pending)), sizeof(pending));
+        entries[i].path = (const char *)(bytes + pending.path);
+        entries[i].value = bytes + pending.value;
+        entries[i].size = pending.size;
+        entries[i].kind = pending.kind;
+        entries[i].pad = 0U;
+    }
+    delta->count = context->count;
+    delta->entries = entries;
+    delta->storage = storage;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_diff(const struct_meta_descriptor *descriptor, const void *old_instance, const void *new_instance,
+                     struct_meta_delta *delta_out)
+{
+    if (delta_out == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    memset(delta_out, 0, sizeof(*delta_out));
+    if ((descriptor == NULL) || (old_instance == NULL) || (new_instance == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    /* 差分はバイト列の比較で求めるため、構造体の外の領域を指す値は値の変化を検出できない。 */
+    if (struct_meta_internal_descriptor_has_dynamic(descriptor) != 0)
+    {
+        return COM_UTIL_ERR_UNSUPPORTED;
+    }
+    delta_out->descriptor = descriptor;
+    if (memcmp(old_instance, new_instance, descriptor->size) == 0)
+    {
+        return COM_UTIL_OK;
+    }
+
+    diff_context context;
+    memset(&context, 0, sizeof(context));
+    struct_meta_buffer_init(&context.prefix);
+    struct_meta_buffer_init(&context.records);
+    struct_meta_buffer_init(&context.bytes);
+    context.old_base = (const unsigned char *)old_instance;
+    context.new_base = (const unsigned char *)new_instance;
+    struct_meta_internal_leaf_visitor visitor = {skip_unchanged, diff_leaf, &context};
+    ret = struct_meta_internal_leaf_walk(descriptor, &context.prefix, &visitor);
+    if ((ret == COM_UTIL_OK) && (context.count > 0U))
+    {
+        ret = build_delta(&context, delta_out);
+    }
+    struct_meta_buffer_dispose(&context.prefix);
+    struct_meta_buffer_dispose(&context.records);
+    struct_meta_buffer_dispose(&context.bytes);
+    if (ret != COM_UTIL_OK)
+    {
+        memset(delta_out, 0, sizeof(*delta_out));
+    }
+    return ret;
+}
+
+/**
+ *  @brief          変更 1 個のパスを解決し、値の種別とバイト数が解決先と合うことを確かめます。
+ *  @return         @c COM_UTIL_OK、struct_meta_path_compile() の結果コード、または @c COM_UTIL_ERR_INVALID_ARGUMENT です。
+ */
+static int resolve_entry(const struct_meta_descriptor *descriptor, const struct_meta_delta_entry *entry,
+                         struct_meta_path_handle *handle_out)
+{
+    if ((entry->path == NULL) || ((entry->value == NULL) && (entry->size > 0U)))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    int ret = struct_meta_path_compile(descriptor, entry->path, handle_out);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    /* ネストした構造体は配置が記述子ごとに異なりうるため、まとめて複写しない。 */
+    if ((handle_out->kind != entry->kind) || (entry->kind == STRUCT_META_FIELD_STRUCT))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if (entry->kind == STRUCT_META_FIELD_CHAR_ARRAY)
+    {
+        if (entry->size > handle_out->size)
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+    }
+    else if (entry->size != handle_out->size)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_delta_apply(const struct_meta_descriptor *descriptor, const struct_meta_delta *delta, void *instance)
+{
+    if ((descriptor == NULL) || (delta == NULL) || (instance == NULL) ||
+        ((delta->entries == NULL) && (delta->count > 0U)))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    if (delta->count == 0U)
+    {
+        return COM_UTIL_OK;
+    }
+    if (delta->count > (SIZE_MAX / sizeof(struct_meta_path_handle)))
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    struct_meta_path_handle *handles =
+        (struct_meta_path_handle *)malloc(delta->count * sizeof(struct_meta_path_handle));
+    if (handles == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+
+    /* 途中で失敗して構造体が部分的に変わることのないよう、書き込む前にすべての変更を解決して検査する。 */
+    int ret = COM_UTIL_OK;
+    for (size_t i = 0; (i < delta->count) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = resolve_entry(descriptor, &delta->entries[i], &handles[i]);
+    }
+    for (size_t i = 0; (i < delta->count) && (ret == COM_UTIL_OK); i++)
+    {
+        const struct_meta_delta_entry *entry = &delta->entries[i];
+        if (entry->size > 0U)
+        {
+            memcpy((unsigned char *)instance + handles[i].offset, entry->value, entry->size);
+        }
+    }
+    free(handles);
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_delta_dispose(struct_meta_delta *delta)
+{
+    if (delta == NULL)
+    {
+        return;
+    }
+    free(delta->storage);
+    memset(delta, 0, sizeof(*delta));
+}
@@ -0,0 +1,471 @@
+/**
+ *******************************************************************************
+ *  @file           hash.c
+ *  @brief          記述子に従って、構造体のハッシュ値を求め、等価性を判定します。
+ *
+ *  記述子を 1 回走査して、値の扱いごとに分けた範囲の一覧 (走査手順) を作ります。
+ *  整数と列挙の範囲は、構造体の上で連続する場合に 1 個の範囲へまとめます。
+ *  bool は 0 以外のバイト列をすべて真として扱うため、バイト列の範囲には含めず 1 値ずつ真偽にそろえます。\n
+ *  ハッシュと比較は一覧ごとの単純なループで、呼び出しのたびにフィールド種別で分岐しません。
+ *  走査手順は JSON キー索引と同じく、記述子の登録情報の拡張スロットへ公開して全スレッドで共有します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/hash/hash.h>
+
+#include <struct_meta/memory/buffer.h>
+#include <struct_meta/memory/dynamic.h>
+#include <struct_meta/meta/registry.h>
+#include <struct_meta/meta/scalar.h>
+
+#include <com_util/base/result.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ハッシュの初期値と乗数。乗数は 2^64 を黄金比で割った奇数。 */
+#define HASH_SEED 0x243F6A8885A308D3ULL
+#define HASH_MULTIPLIER 0x9E3779B97F4A7C15ULL
+
+/* すべての NaN をそろえる先のビット列 (quiet NaN)。 */
+#define CANONICAL_FLOAT_NAN 0x7FC00000U
+#define CANONICAL_DOUBLE_NAN 0x7FF8000000000000ULL
+
+/** 構造体の先頭からの範囲です。 */
+typedef struct hash_span
+{
+    size_t offset;
+    size_t length; /* char 配列では配列全体のバイト数です。 */
+} hash_span;
+
+/**
+ *  @brief          記述子 1 個分の走査手順です。
+ *
+ *  各バッファーは値の扱いごとの一覧で、bytes、bools と chars は hash_span、
+ *  floats と doubles は値のオフセット (size_t) を並べます。
+ */
+typedef struct hash_plan
+{
+    struct_meta_buffer bytes;   /* バイト列のまま扱う範囲 (int、unsigned、列挙) です。 */
+    struct_meta_buffer bools;   /* bool 値 1 個ずつの範囲です。 */
+    struct_meta_buffer floats;  /* float 値のオフセットです。 */
+    struct_meta_buffer doubles; /* double 値のオフセットです。 */
+    struct_meta_buffer chars;   /* char 配列の範囲です。 */
+} hash_plan;
+
+static void plan_init(hash_plan *plan)
+{
+    struct_meta_buffer_init(&plan->bytes);
+    struct_meta_buffer_init(&plan->bools);
+    struct_meta_buffer_init(&plan->floats);
+    struct_meta_buffer_init(&plan->doubles);
+    struct_meta_buffer_init(&plan->chars);
+}
+
+static void plan_dispose(hash_plan *plan)
+{
+    struct_meta_buffer_dispose(&plan->bytes);
+    struct_meta_buffer_dispose(&plan->bools);
+    struct_meta_buffer_dispose(&plan->floats);
+    struct_meta_buffer_dispose(&plan->doubles);
+    struct_meta_buffer_dispose(&plan->chars);
+}
+
+/** 登録情報へ公開した走査手順を、登録の削除時に解放します。 */
+static void dispose_published_plan(void *data)
+{
+    plan_dispose((hash_plan *)data);
+    free(data);
+}
+
+/**
+ *  @brief          バイト列の範囲を加えます。直前の範囲と連続する場合は、直前の範囲を延ばします。
+ */
+static int add_bytes(hash_plan *plan, size_t offset, size_t length)
+{
+    if (plan->bytes.length >= sizeof(hash_span))
+    {
+        hash_span *last = (hash_span *)(void *)(plan->bytes.data + plan->bytes.length - sizeof(hash_span));
+        if ((last->offset + last->length) == offset)
+        {
+            last->length += length;
+            return COM_UTIL_OK;
+        }
+    }
+    hash_span span = {offset, length};
+    return struct_meta_buffer_append(&plan->bytes, &span, sizeof(span));
+}
+
+static int add_values(struct_meta_buffer *offsets, size_t offset, size_t width, size_t count)
+{
+    int ret = COM_UTIL_OK;
+    for (size_t i = 0; (i < count) && (ret == COM_UTIL_OK); i++)
+    {
+        size_t value_offset = offset + (i * width);
+        ret = struct_meta_buffer_append(offsets, &value_offset, sizeof(value_offset));
+    }
+    return ret;
+}
+
+static int add_bools(hash_plan *plan, size_t offset, size_t width, size_t count)
+{
+    int ret = COM_UTIL_OK;
+    for (size_t i = 0; (i < count) && (ret == COM_UTIL_OK); i++)
+    {
+        hash_span span = {offset + (i * width), width};
+        ret = struct_meta_buffer_append(&plan->bools, &span, sizeof(span));
+    }
+    return ret;
+}
+
+static int build_descriptor(hash_plan *plan, const struct_meta_descriptor *desc, size_t base)
+{
+    int ret = COM_UTIL_OK;
+    for (size_t i = 0; (i < desc->field_count) && (ret == COM_UTIL_OK); i++)
+    {
+        const struct_meta_field *field = &desc->fields[i];
+        size_t offset = base + field->offset;
+        if (struct_meta_internal_field_is_dynamic(field) != 0)
+        {
+            return COM_UTIL_ERR_UNSUPPORTED;
+        }
+
+        switch (field->kind)
+        {
+        case STRUCT_META_FIELD_INT:
+        case STRUCT_META_FIELD_UNSIGNED:
+        case STRUCT_META_FIELD_INT8:
+        case STRUCT_META_FIELD_INT16:
+        case STRUCT_META_FIELD_INT64:
+        case STRUCT_META_FIELD_UINT8:
+        case STRUCT_META_FIELD_UINT16:
+        case STRUCT_META_FIELD_UINT64:
+        case STRUCT_META_FIELD_ENUM:
+            ret = add_bytes(plan, offset, field->element_size * field->element_count);
+            break;
+
+        case STRUCT_META_FIELD_BOOL:
+            ret = add_bools(plan, offset, field->element_size, field->element_count);
+            break;
+
+        case STRUCT_META_FIELD_FLOAT:
+            if (field->element_size != sizeof(float))
+            {
+                return COM_UTIL_ERR_UNSUPPORTED;
+            }
+            ret = add_values(&plan->floats, offset, field->element_size, field->element_count);
+            break;
+
+        case STRUCT_META_FIELD_DOUBLE:
+            if (field->element_size != sizeof(double))
+            {
+                return COM_UTIL_ERR_UNSUPPORTED;
+            }
+            ret = add_values(&plan->doubles, offset, field->element_size, field->element_count);
+            break;
+
+        case STRUCT_META_FIELD_CHAR_ARRAY:
+        {
+            hash_span span = {offset, field->char_buffer_size};
+            ret = struct_meta_buffer_append(&plan->chars, &span, sizeof(span));
+            break;
+        }
+
+        case STRUCT_META_FIELD_STRUCT:
+            for (size_t e = 0; (e < field->element_count) && (ret == COM_UTIL_OK); e++)
+            {
+                ret = build_descriptor(plan, field->nested, offset + (e * field->element_size));
+            }
+            break;
+
+        case STRUCT_META_FIELD_STRING:
+        default:
+            return COM_UTIL_ERR_CORRUPT_DESCRIPTOR;
+        }
+    }
+    return ret;
+}
+
+/**
+ *  @brief          記述子の走査手順を取得します。
+ *
+ *  登録済みの記述子では、初回利用時に作った走査手順を登録情報へ公開して共有します。
+ *  登録できなかった記述子では @p local へ作ります。その場合、呼び出し側が @p local を解放します。
+ */
+static int acquire_plan(const struct_meta_descriptor *descriptor, hash_plan *local, const hash_plan **plan_out)
+{
+    const struct_meta_internal_descriptor_entry *entry = NULL;
+    plan_init(local);
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, &entry);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    void *published = struct_meta_internal_extension_get(entry, STRUCT_META_INTERNAL_EXTENSION_HASH_PLAN);
+    if (published != NULL)
+    {
+        *plan_out = (const hash_plan *)published;
+        return COM_UTIL_OK;
+    }
+
+    ret = build_descriptor(local, descriptor, 0U);
+    if ((ret != COM_UTIL_OK) || (entry == NULL))
+    {
+        *plan_out = local;
+        return ret;
+    }
+
+    /* 公開に失敗した場合は、作業領域の走査手順をそのまま使う。 */
+    hash_plan *candidate = (hash_plan *)malloc(sizeof(hash_plan));
+    if (candidate == NULL)
+    {
+        *plan_out = local;
+        return COM_UTIL_OK;
+    }
+    *candidate = *local;
+    plan_init(local);
+    published = struct_meta_internal_extension_publish(entry, STRUCT_META_INTERNAL_EXTENSION_HASH_PLAN, candidate,
+                                                      dispose_published_plan);
+    if (published != candidate)
+    {
+        plan_dispose(candidate);
+        free(candidate);
+    }
+    *plan_out = (const hash_plan *)published;
+    return COM_UTIL_OK;
+}
+
+static uint64_t mix(uint64_t hash, uint64_t word)
+{
+    hash ^= word;
+    hash *= HASH_MULTIPLIER;
+    return hash ^ (hash >> 29U);
+}
+
+/**
+ *  @brief          バイト列を 8 バイト単位で要約へ加えます。端数は長さと合わせて 1 語にします。
+ */
+static uint64_t mix_bytes(uint64_t hash, const unsigned char *data, size_t length)
+{
+    while (length >= sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        hash = mix(hash, word);
+        data += sizeof(word);
+        length -= sizeof(word);
+    }
+    if (length > 0U)
+    {
+        uint64_t word = 0U;
+        memcpy(&word, data, length);
+        hash = mix(hash, word ^ ((uint64_t)length << 56U));
+    }
+    return hash;
+}
+
+/** 最後に上位ビットを下位へ拡散し、ハッシュ表がマスクで下位ビットだけを使っても偏らないようにする。 */
+static uint64_t finish(uint64_t hash)
+{
+    hash ^= hash >> 33U;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33U;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    return hash ^ (hash >> 33U);
+}
+
+static uint32_t float_bits(const unsigned char *value)
+{
+    float number;
+    uint32_t bits;
+    memcpy(&number, value, sizeof(number));
+    if (number == 0.0F)
+    {
+        return 0U;
+    }
+    if (isnan(number))
+    {
+        return CANONICAL_FLOAT_NAN;
+    }
+    memcpy(&bits, &number, sizeof(bits));
+    return bits;
+}
+
+static uint64_t double_bits(const unsigned char *value)
+{
+    double number;
+    uint64_t bits;
+    memcpy(&number, value, sizeof(number));
+    if (number == 0.0)
+    {
+        return 0U;
+    }
+    if (isnan(number))
+    {
+        return CANONICAL_DOUBLE_NAN;
+    }
+    memcpy(&bits, &number, sizeof(bits));
+    return bits;
+}
+
+static uint64_t bool_bits(const unsigned char *base, const hash_span *span)
+{
+    return (struct_meta_internal_load_unsigned(base + span->offset, span->length) != 0U) ? 1U : 0U;
+}
+
+static size_t chars_length(const unsigned char *value, size_t capacity)
+{
+    const unsigned char *end = (const unsigned char *)memchr(value, '\0', capacity);
+    if (end == NULL)
+    {
+        return capacity;
+    }
+    return (size_t)(end - value);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_hash(const struct_meta_descriptor *descriptor, const void *instance, uint64_t *hash_out)
+{
+    if ((descriptor == NULL) || (instance == NULL) || (hash_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    hash_plan local;
+    const hash_plan *plan = NULL;
+    int ret = acquire_plan(descriptor, &local, &plan);
+    if (ret != COM_UTIL_OK)
+    {
+        plan_dispose(&local);
+        return ret;
+    }
+
+    const unsigned char *base = (const unsigned char *)instance;
+    const hash_span *bytes = (const hash_span *)(const void *)plan->bytes.data;
+    const hash_span *bools = (const hash_span *)(const void *)plan->bools.data;
+    const size_t *floats = (const size_t *)(const void *)plan->floats.data;
+    const size_t *doubles = (const size_t *)(const void *)plan->doubles.data;
+    const hash_span *chars = (const hash_span *)(const void *)plan->chars.data;
+    size_t byte_count = plan->bytes.length / sizeof(*bytes);
+    size_t bool_count = plan->bools.length / sizeof(*bools);
+    size_t float_count = plan->floats.length / sizeof(*floats);
+    size_t double_count = plan->doubles.length / sizeof(*doubles);
+    size_t char_count = plan->chars.length / sizeof(*chars);
+    uint64_t hash = HASH_SEED;
+
+    for (size_t i = 0; i < byte_count; i++)
+    {
+        hash = mix_bytes(hash, base + bytes[i].offset, bytes[i].length);
+    }
+    for (size_t i = 0; i < bool_count; i++)
+    {
+        hash = mix(hash, bool_bits(base, &bools[i]));
+    }
+    for (size_t i = 0; i < float_count; i++)
+    {
+        hash = mix(hash, (uint64_t)float_bits(base + floats[i]));
+    }
+    for (size_t i = 0; i < double_count; i++)
+    {
+        hash = mix(hash, double_bits(base + doubles[i]));
+    }
+    for (size_t i = 0; i < char_count; i++)
+    {
+        /* 長さを先に加え、隣の文字列との境界の違いを区別する。 */
+        size_t length = chars_length(base + chars[i].offset, chars[i].length);
+        hash = mix(hash, (uint64_t)length);
+        hash = mix_bytes(hash, base + chars[i].offset, length);
+    }
+
+    plan_dispose(&local);
+    *hash_out = finish(hash);
+    return COM_UTIL_OK;
+}
+
+static int plan_equal(const hash_plan *plan, const unsigned char *left, const unsigned char *right)
+{
+    const hash_span *bytes = (const hash_span *)(const void *)plan->bytes.data;
+    const hash_span *bools = (const hash_span *)(const void *)plan->bools.data;
+    const size_t *floats = (const size_t *)(const void *)plan->floats.data;
+    const size_t *doubles = (const size_t *)(const void *)plan->doubles.data;
+    const hash_span *chars = (const hash_span *)(const void *)plan->chars.data;
+    size_t byte_count = plan->bytes.length / sizeof(*bytes);
+    size_t bool_count = plan->bools.length / sizeof(*bools);
+    size_t float_count = plan->floats.length / sizeof(*floats);
+    size_t double_count = plan->doubles.length / sizeof(*doubles);
+    size_t char_count = plan->chars.length / sizeof(*chars);
+
+    for (size_t i = 0; i < byte_count; i++)
+    {
+        if (memcmp(left + bytes[i].offset, right + bytes[i].offset, bytes[i].length) != 0)
+        {
+            return 0;
+        }
+    }
+    for (size_t i = 0; i < bool_count; i++)
+    {
+        if (bool_bits(left, &bools[i]) != bool_bits(right, &bools[i]))
+        {
+            return 0;
+        }
+    }
+    for (size_t i = 0; i < float_count; i++)
+    {
+        if (float_bits(left + floats[i]) != float_bits(right + floats[i]))
+        {
+            return 0;
+        }
+    }
+    for (size_t i = 0; i < double_count; i++)
+    {
+        if (double_bits(left + doubles[i]) != double_bits(right + doubles[i]))
+        {
+            return 0;
+        }
+    }
+    for (size_t i = 0; i < char_count; i++)
+    {
+        const unsigned char *left_chars = left + chars[i].offset;
+        const unsigned char *right_chars = right + chars[i].offset;
+        size_t length = chars_length(left_chars, chars[i].length);
+        if ((length != chars_length(right_chars, chars[i].length)) || (memcmp(left_chars, right_chars, length) != 0))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_equal(const struct_meta_descriptor *descriptor, const void *left, const void *right, int *equal_out)
+{
+    if ((descriptor == NULL) || (left == NULL) || (right == NULL) || (equal_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    hash_plan local;
+    const hash_plan *plan = NULL;
+    int ret = acquire_plan(descriptor, &local, &plan);
+    if (ret != COM_UTIL_OK)
+    {
+        plan_dispose(&local);
+        return ret;
+    }
+
+    /* バイト単位で一致すれば、意味のあるバイトも一致する。 */
+    if ((left == right) || (memcmp(left, right, descriptor->size) == 0))
+    {
+        *equal_out = 1;
+    }
+    else
+    {
+        *equal_out = plan_equal(plan, (const unsigned char *)left, (const unsigned char *)right);
+    }
+    plan_dispose(&local);
+    return COM_UTIL_OK;
+}
@@ -14,12 +14,42 @@
 #include <struct_meta/json/json.h>
 
 #include <struct_meta/access/access.h>
+#include <struct_meta/base/array.h>
+#include <struct_meta/json/key.h>
+#include <struct_meta/json/undo.h>
+#include <struct_meta/memory/dynamic.h>
+#include <struct_meta/meta/registry.h>
+#include <struct_meta/meta/scalar.h>
 
 #include <com_util/base/result.h>
 
+#include <stdint.h>
 #include <string.h>
 
-static int struct_from_json(const struct_meta_descriptor *desc, const cJSON *json, unsigned char *base);
+static int struct_from_json(const struct_meta_descriptor *desc, const struct_meta_internal_name_index *names,
+                            const cJSON *json, unsigned char *base, struct_meta_buffer *undo,
+                            const struct_meta_allocator *allocator);
+
+/**
+ *  @brief          cJSON アイテムを整数の符号と絶対値へ変換します。
+ *
+ *  cJSON は数値を double で保持するため、数値アイテムは正確に表せる整数 (絶対値 2^53 以下) だけを受け付けます。
+ *  それを超える値は、エンコード時と同じく Raw アイテム、または文字列の整数表記として受け付けます。
+ *
+ *  @return         1 (非負)、-1 (負)、または整数として解釈できない場合は 0 です。
+ */
+static int integer_from_json(const cJSON *item, uint64_t *magnitude_out)
+{
+    if (cJSON_IsNumber(item))
+    {
+        return struct_meta_internal_integer_from_double(cJSON_GetNumberValue(item), magnitude_out);
+    }
+    if ((cJSON_IsRaw(item) || cJSON_IsString(item)) && (item->valuestring != NULL))
+    {
+        return struct_meta_internal_integer_from_text(item->valuestring, strlen(item->valuestring), magnitude_out);
+    }
+    return 0;
+}
 
 /**
  *  @brief          cJSON アイテム 1 個分をスカラー値としてメモリーへ書き戻します。
@@ -78,6 +108,32 @@ static int scalar_from_json(struct_meta_field_kind kind, const cJSON *item, unsi
         }
         break;
 
+    case STRUCT_META_FIELD_INT8:
+    case STRUCT_META_FIELD_INT16:
+    case STRUCT_META_FIELD_INT64:
+    case STRUCT_META_FIELD_UINT8:
+    case STRUCT_META_FIELD_UINT16:
+    case STRUCT_META_FIELD_UINT64:
+    case STRUCT_META_FIELD_ENUM:
+    {
+        uint64_t magnitude = 0U;
+        int sign = integer_from_json(item, &magnitude);
+        if ((sign == 0) ||
+            (struct_meta_internal_store_integer(kind, field_ptr, element_size, sign, magnitude) != COM_UTIL_OK))
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        break;
+    }
+
+    case STRUCT_META_FIELD_BOOL:
+        if (!cJSON_IsBool(item))
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        (void)struct_meta_internal_store_bool(field_ptr, cJSON_IsTrue(item) ? 1U : 0U);
+        break;
+
     case STRUCT_META_FIELD_CHAR_ARRAY:
         if (!cJSON_IsString(item))
         {
@@ -96,53 +152,142 @@ static int scalar_from_json(struct_meta_field_kind kind, const cJSON *item, unsi
         break;
 
     case STRUCT_META_FIELD_STRUCT:
+    case STRUCT_META_FIELD_STRING:
     default:
-        /* STRUCT_META_FIELD_STRUCT は element_from_json() が先に振り分けるため、ここには到達しない。 */
+        /* 構造体と文字列は element_from_json() が先に振り分けるため、ここには到達しない。 */
         return COM_UTIL_ERR_INVALID_ARGUMENT;
     }
 
     return COM_UTIL_OK;
 }
 
+/**
+ *  @brief          cJSON の文字列を、長さちょうどの領域へ複写して char * として書き戻します。
+ *
+ *  null は NULL として書き戻します。新しい領域を確保できた後に限り、書き戻す前の領域を解放します。
+ */
+static int string_from_json(const cJSON *item, unsigned char *slot, const struct_meta_allocator *allocator)
+{
+    char *text = NULL;
+    if (!cJSON_IsNull(item))
+    {
+        if (!cJSON_IsString(item))
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        const char *value = cJSON_GetStringValue(item);
+        size_t length = strlen(value);
+        text = (char *)struct_meta_internal_allocate(allocator, length + 1U);
+        if (text == NULL)
+        {
+            return COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+        memcpy(text, value, length + 1U);
+    }
+
+    char *previous = NULL;
+    memcpy((void *)&previous, slot, sizeof(previous));
+    struct_meta_internal_release(allocator, previous);
+    memcpy(slot, (const void *)&text, sizeof(text));
+    return COM_UTIL_OK;
+}
+
 /**
  *  @brief          cJSON アイテム 1 個分 (配列要素、またはネスト構造体 1 個) をメモリーへ書き戻します。
  */
-static int element_from_json(const struct_meta_field *field, const cJSON *item, unsigned char *elem_ptr)
+static int element_from_json(const struct_meta_field *field, const cJSON *item, unsigned char *elem_ptr,
+                             struct_meta_buffer *undo, const struct_meta_allocator *allocator)
 {
     if (field->kind == STRUCT_META_FIELD_STRUCT)
     {
-        return struct_from_json(field->nested, item, elem_ptr);
+        return struct_from_json(field->nested, struct_meta_internal_json_names(field->nested), item, elem_ptr,
+                                undo, allocator);
+    }
+    if (field->kind == STRUCT_META_FIELD_STRING)
+    {
+        return string_from_json(item, elem_ptr, allocator);
     }
     return scalar_from_json(field->kind, item, elem_ptr, field->element_size, field->char_buffer_size);
 }
 
 /**
- *  @brief          フィールド記述子 1 個分 (スカラー、char 配列、固定長配列のいずれか) を cJSON から書き戻します。
+ *  @brief          cJSON 配列を、要素数ちょうどの領域へ可変長配列として書き戻します。
+ *
+ *  null は要素数 0 として書き戻します。新しい領域はゼロで埋めてから items と count を置き換えるため、
+ *  要素の途中でエラーになっても、書き戻した内容は struct_meta_instance_release() で解放できます。
  */
-static const char *json_key(const struct_meta_field *field)
+static int sequence_from_json(const struct_meta_field *field, const cJSON *item, unsigned char *base,
+                              const struct_meta_allocator *allocator)
 {
-    const struct_meta_attribute *attribute = NULL;
-    int ret = struct_meta_field_find_attribute(field, "json.name", &attribute);
-    if ((ret == COM_UTIL_OK) && (attribute->value != NULL) && (attribute->value[0] != '\0'))
+    if (cJSON_IsNull(item))
+    {
+        struct_meta_internal_release_field(field, base, allocator);
+        return COM_UTIL_OK;
+    }
+    if (!cJSON_IsArray(item))
     {
-        return attribute->value;
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
     }
-    return field->name;
+    int array_size = cJSON_GetArraySize(item);
+    if (array_size < 0)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    size_t count = (size_t)array_size;
+    if (count > (SIZE_MAX / field->element_size))
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+
+    unsigned char *items = NULL;
+    if (count > 0U)
+    {
+        items = (unsigned char *)struct_meta_internal_allocate(allocator, count * field->element_size);
+        if (items == NULL)
+        {
+            return COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+        memset(items, 0, count * field->element_size);
+    }
+    struct_meta_internal_release_field(field, base, allocator);
+    struct_meta_sequence *sequence = struct_meta_internal_sequence_of(field, base);
+    sequence->items = items;
+    sequence->count = count;
+
+    size_t index = 0U;
+    const cJSON *elem = NULL;
+    cJSON_ArrayForEach(elem, item)
+    {
+        int ret = element_from_json(field, elem, items + (index * field->element_size), NULL, allocator);
+        if (ret != COM_UTIL_OK)
+        {
+            return ret;
+        }
+        index++;
+    }
+    return COM_UTIL_OK;
 }
 
-static int field_from_json(const struct_meta_field *field, const cJSON *json, unsigned char *base)
+/**
+ *  @brief          フィールド記述子 1 個分 (スカラー、char 配列、固定長配列、可変長配列) を cJSON から書き戻します。
+ *  @param[in]      key フィールドの JSON キーです。`json.ignore` 属性を持つフィールドでは NULL です。
+ *  @param[in,out]  undo 上書き前の内容を記録する取り消しログです。NULL の場合は記録しません。
+ *  @param[in]      allocator 文字列と可変長配列の領域のアロケーターです。
+ */
+static int field_from_json(const struct_meta_field *field, const char *key, const cJSON *json, unsigned char *base,
+                           struct_meta_buffer *undo, const struct_meta_allocator *allocator)
 {
     const cJSON *item;
 
-    const struct_meta_attribute *attribute = NULL;
-    if (struct_meta_field_find_attribute(field, "json.ignore", &attribute) == COM_UTIL_OK)
+    if (key == NULL)
     {
         return COM_UTIL_OK;
     }
 
-    item = cJSON_GetObjectItemCaseSensitive(json, json_key(field));
+    item = cJSON_GetObjectItemCaseSensitive(json, key);
     if (item == NULL)
     {
+        const struct_meta_attribute *attribute = NULL;
         if (struct_meta_field_find_attribute(field, "json.required", &attribute) == COM_UTIL_OK)
         {
             return COM_UTIL_ERR_MISSING_REQUIRED;
@@ -150,15 +295,30 @@ static int field_from_json(const struct_meta_field *field, const cJSON *json, un
         return COM_UTIL_OK;
     }
 
+    if ((undo != NULL) && (struct_meta_internal_field_is_dynamic(field) != 0))
+    {
+        /* 書き戻す前の領域は解放するため、取り消しログでは元へ戻せない。 */
+        return COM_UTIL_ERR_UNSUPPORTED;
+    }
+    if (field->storage == STRUCT_META_STORAGE_SEQUENCE)
+    {
+        return sequence_from_json(field, item, base, allocator);
+    }
+
+    int ret = struct_meta_internal_undo_record(undo, field, base);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
     if ((field->kind == STRUCT_META_FIELD_CHAR_ARRAY) || (field->element_count <= 1U))
     {
         void *element;
-        int ret = struct_meta_field_get_element(field, base, 0U, &element);
+        ret = struct_meta_field_get_element(field, base, 0U, &element);
         if (ret != COM_UTIL_OK)
         {
             return ret;
         }
-        return element_from_json(field, item, (unsigned char *)element);
+        return element_from_json(field, item, (unsigned char *)element, undo, allocator);
     }
 
     if (!cJSON_IsArray(item))
@@ -176,10 +336,10 @@ static int field_from_json(const struct_meta_field *field, const cJSON *json, un
     {
         const cJSON *elem = cJSON_GetArrayItem(item, (int)i);
         void *element;
-        int ret = struct_meta_field_get_element(field, base, i, &element);
+        ret = struct_meta_field_get_element(field, base, i, &element);
         if (ret == COM_UTIL_OK)
         {
-            ret = element_from_json(field, elem, (unsigned char *)element);
+            ret = element_from_json(field, elem, (unsigned char *)element, undo, allocator);
         }
         if (ret != COM_UTIL_OK)
         {
@@ -193,7 +353,9 @@ static int field_from_json(const struct_meta_field *field, const cJSON *json, un
 /**
  *  @brief          cJSON オブジェクト 1 個分を構造体インスタンスへ書き戻します。
  */
-static int struct_from_json(const struct_meta_descriptor *desc, const cJSON *json, unsigned char *base)
+static int struct_from_json(const struct_meta_descriptor *desc, const struct_meta_internal_name_index *names,
+                            const cJSON *json, unsigned char *base, struct_meta_buffer *undo,
+                            const struct_meta_allocator *allocator)
 {
     if (!cJSON_IsObject(json))
     {
@@ -202,7 +364,8 @@ static int struct_from_json(const struct_meta_descriptor *desc, const cJSON *jso
 
     for (size_t i = 0; i < desc->field_count; i++)
     {
-        int ret = field_from_json(&desc->fields[i], json, base);
+        int ret = field_from_json(&desc->fields[i], struct_meta_internal_json_field_key(names, desc, i), json, base,
+                                  undo, allocator);
         if (ret != COM_UTIL_OK)
         {
             return ret;
@@ -221,10 +384,115 @@ int struct_meta_json_decode(const struct_meta_descriptor *desc, const cJSON *jso
         return COM_UTIL_ERR_INVALID_ARGUMENT;
     }
 
-    int ret = struct_meta_descriptor_validate(desc);
+    int ret = struct_meta_internal_descriptor_acquire(desc, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    return struct_from_json(desc, struct_meta_internal_json_names(desc), json, (unsigned char *)instance, NULL,
+                            NULL);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_decode_alloc(const struct_meta_descriptor *desc, const cJSON *json, void *instance,
+                                  const struct_meta_allocator *allocator)
+{
+    if ((desc == NULL) || (json == NULL) || (instance == NULL) ||
+        ((allocator != NULL) && (allocator->allocate == NULL)))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    int ret = struct_meta_internal_descriptor_acquire(desc, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    return struct_from_json(desc, struct_meta_internal_json_names(desc), json, (unsigned char *)instance, NULL,
+                            allocator);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_decode_atomic(const struct_meta_descriptor *desc, const cJSON *json, void *instance,
+                                   struct_meta_buffer *undo)
+{
+    if ((desc == NULL) || (json == NULL) || (instance == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    int ret = struct_meta_internal_descriptor_acquire(desc, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    struct_meta_buffer local;
+    struct_meta_buffer *log = undo;
+    if (log == NULL)
+    {
+        struct_meta_buffer_init(&local);
+        log = &local;
+    }
+    struct_meta_buffer_reset(log);
+    ret = struct_from_json(desc, struct_meta_internal_json_names(desc), json, (unsigned char *)instance, log, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        struct_meta_internal_undo_rollback(log);
+    }
+    struct_meta_buffer_reset(log);
+    if (log == &local)
+    {
+        struct_meta_buffer_dispose(&local);
+    }
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_decode_array(const struct_meta_descriptor *desc, const cJSON *json, void *base, size_t capacity,
+                                  size_t stride, size_t *count_out)
+{
+    if ((json == NULL) || (count_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    *count_out = 0U;
+    int ret = struct_meta_internal_array_stride(desc, base, capacity, stride, &stride);
     if (ret != COM_UTIL_OK)
     {
         return ret;
     }
-    return struct_from_json(desc, json, (unsigned char *)instance);
+    ret = struct_meta_internal_descriptor_acquire(desc, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    if (!cJSON_IsArray(json))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    int array_size = cJSON_GetArraySize(json);
+    if ((array_size < 0) || ((size_t)array_size > capacity))
+    {
+        return COM_UTIL_ERR_BUFFER_TOO_SMALL;
+    }
+
+    /* 検査と JSON キー索引の取得は配列全体で 1 回だけ行う。要素は連結リストを先頭から 1 回だけたどる。 */
+    const struct_meta_internal_name_index *names = struct_meta_internal_json_names(desc);
+    size_t index = 0U;
+    const cJSON *elem = NULL;
+    cJSON_ArrayForEach(elem, json)
+    {
+        ret = struct_from_json(desc, names, elem, (unsigned char *)base + (index * stride), NULL, NULL);
+        if (ret != COM_UTIL_OK)
+        {
+            return ret;
+        }
+        index++;
+        *count_out = index;
+    }
+    return COM_UTIL_OK;
 }
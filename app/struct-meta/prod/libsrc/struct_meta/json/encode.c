@@ -14,12 +14,47 @@
 #include <struct_meta/json/json.h>
 
 #include <struct_meta/access/access.h>
+#include <struct_meta/base/array.h>
+#include <struct_meta/json/key.h>
+#include <struct_meta/meta/registry.h>
+#include <struct_meta/meta/scalar.h>
 
 #include <com_util/base/result.h>
 
+#include <stdint.h>
 #include <string.h>
 
-static int struct_to_json(const struct_meta_descriptor *desc, const unsigned char *base, cJSON **json_out);
+static int struct_to_json(const struct_meta_descriptor *desc, const struct_meta_internal_name_index *names,
+                          const unsigned char *base, cJSON **json_out);
+
+/**
+ *  @brief          整数の値から cJSON アイテムを作成します。
+ *
+ *  cJSON は数値を double で保持し、"%1.15g" で書き出すため、16 桁以上の整数は指数表記になります。
+ *  絶対値が 10^15 以上の値は 10 進表記の Raw アイテムとし、struct_meta_json_write_buffer() と同じ表記で出力します。
+ */
+static cJSON *integer_to_json(int negative, uint64_t magnitude)
+{
+    /* 10^15 未満の整数は "%1.15g" で指数を使わずに表せる。double へ変換せず整数のまま比較する。 */
+    if (magnitude < UINT64_C(1000000000000000))
+    {
+        double value = (double)magnitude;
+        return cJSON_CreateNumber(negative ? -value : value);
+    }
+    char text[24];
+    size_t pos = sizeof(text) - 1U;
+    text[pos] = '\0';
+    do
+    {
+        text[--pos] = (char)('0' + (int)(magnitude % 10U));
+        magnitude /= 10U;
+    } while (magnitude != 0U);
+    if (negative)
+    {
+        text[--pos] = '-';
+    }
+    return cJSON_CreateRaw(&text[pos]);
+}
 
 /**
  *  @brief          スカラー値 1 個分のメモリー内容から cJSON アイテムを作成します。
@@ -79,11 +114,41 @@ static int scalar_to_json(struct_meta_field_kind kind, const unsigned char *fiel
         }
         break;
 
+    case STRUCT_META_FIELD_INT8:
+    case STRUCT_META_FIELD_INT16:
+    case STRUCT_META_FIELD_INT64:
+    case STRUCT_META_FIELD_ENUM:
+    {
+        int64_t value = struct_meta_internal_load_signed(field_ptr, element_size);
+        /* INT64_MIN の絶対値は int64_t で表せないため、uint64_t で符号を反転する。 */
+        uint64_t magnitude = (value < 0) ? (0U - (uint64_t)value) : (uint64_t)value;
+        item = integer_to_json(value < 0, magnitude);
+        break;
+    }
+
+    case STRUCT_META_FIELD_UINT8:
+    case STRUCT_META_FIELD_UINT16:
+    case STRUCT_META_FIELD_UINT64:
+        item = integer_to_json(0, struct_meta_internal_load_unsigned(field_ptr, element_size));
+        break;
+
+    case STRUCT_META_FIELD_BOOL:
+        item = cJSON_CreateBool(struct_meta_internal_load_unsigned(field_ptr, element_size) != 0U);
+        break;
+
     case STRUCT_META_FIELD_CHAR_ARRAY:
         /* field_ptr は char[N] の先頭を指す。NUL 終端文字列として扱う。 */
         item = cJSON_CreateString((const char *)field_ptr);
         break;
 
+    case STRUCT_META_FIELD_STRING:
+    {
+        const char *text = NULL;
+        memcpy((void *)&text, field_ptr, sizeof(text));
+        item = (text != NULL) ? cJSON_CreateString(text) : cJSON_CreateNull();
+        break;
+    }
+
     case STRUCT_META_FIELD_STRUCT:
     default:
         /* STRUCT_META_FIELD_STRUCT は element_to_json() が先に振り分けるため、ここには到達しない。 */
@@ -105,18 +170,28 @@ static int element_to_json(const struct_meta_field *field, const unsigned char *
 {
     if (field->kind == STRUCT_META_FIELD_STRUCT)
     {
-        return struct_to_json(field->nested, elem_ptr, item_out);
+        return struct_to_json(field->nested, struct_meta_internal_json_names(field->nested), elem_ptr, item_out);
     }
     return scalar_to_json(field->kind, elem_ptr, field->element_size, item_out);
 }
 
 /**
- *  @brief          フィールド記述子 1 個分 (スカラー、char 配列、固定長配列のいずれか) を cJSON アイテムへ変換します。
+ *  @brief          フィールド記述子 1 個分 (スカラー、char 配列、固定長配列、可変長配列) を cJSON へ変換します。
  */
 static int field_to_json(const struct_meta_field *field, const unsigned char *base, cJSON **item_out)
 {
+    size_t count = field->element_count;
+    if (field->storage == STRUCT_META_STORAGE_SEQUENCE)
+    {
+        const struct_meta_sequence *sequence = (const struct_meta_sequence *)(const void *)(base + field->offset);
+        if ((sequence->items == NULL) && (sequence->count > 0U))
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        count = sequence->count;
+    }
     /* char[N] は配列ですが、単一の JSON 文字列として扱います。 */
-    if ((field->kind == STRUCT_META_FIELD_CHAR_ARRAY) || (field->element_count <= 1U))
+    else if ((field->kind == STRUCT_META_FIELD_CHAR_ARRAY) || (field->element_count <= 1U))
     {
         const void *element;
         int ret = struct_meta_field_get_const_element(field, base, 0U, &element);
@@ -133,7 +208,7 @@ static int field_to_json(const struct_meta_field *field, const unsigned char *ba
         return COM_UTIL_ERR_OUT_OF_MEMORY;
     }
 
-    for (size_t i = 0; i < field->element_count; i++)
+    for (size_t i = 0; i < count; i++)
     {
         cJSON *elem = NULL;
         const void *element;
@@ -162,18 +237,8 @@ static int field_to_json(const struct_meta_field *field, const unsigned char *ba
 /**
  *  @brief          構造体インスタンス 1 個分を cJSON オブジェクトへ変換します。
  */
-static const char *json_key(const struct_meta_field *field)
-{
-    const struct_meta_attribute *attribute = NULL;
-    int ret = struct_meta_field_find_attribute(field, "json.name", &attribute);
-    if ((ret == COM_UTIL_OK) && (attribute->value != NULL) && (attribute->value[0] != '\0'))
-    {
-        return attribute->value;
-    }
-    return field->name;
-}
-
-static int struct_to_json(const struct_meta_descriptor *desc, const unsigned char *base, cJSON **json_out)
+static int struct_to_json(const struct_meta_descriptor *desc, const struct_meta_internal_name_index *names,
+                          const unsigned char *base, cJSON **json_out)
 {
     cJSON *obj = cJSON_CreateObject();
     if (obj == NULL)
@@ -187,8 +252,8 @@ static int struct_to_json(const struct_meta_descriptor *desc, const unsigned cha
         cJSON *item = NULL;
         int ret;
 
-        const struct_meta_attribute *attribute = NULL;
-        if (struct_meta_field_find_attribute(field, "json.ignore", &attribute) == COM_UTIL_OK)
+        const char *key = struct_meta_internal_json_field_key(names, desc, i);
+        if (key == NULL)
         {
             continue;
         }
@@ -199,7 +264,7 @@ static int struct_to_json(const struct_meta_descriptor *desc, const unsigned cha
             cJSON_Delete(obj);
             return ret;
         }
-        if (!cJSON_AddItemToObject(obj, json_key(field), item))
+        if (!cJSON_AddItemToObject(obj, key, item))
         {
             cJSON_Delete(item);
             cJSON_Delete(obj);
@@ -221,10 +286,60 @@ int struct_meta_json_encode(const struct_meta_descriptor *desc, const void *inst
     }
 
     *json_out = NULL;
-    int ret = struct_meta_descriptor_validate(desc);
+    int ret = struct_meta_internal_descriptor_acquire(desc, NULL);
     if (ret != COM_UTIL_OK)
     {
         return ret;
     }
-    return struct_to_json(desc, (const unsigned char *)instance, json_out);
+    return struct_to_json(desc, struct_meta_internal_json_names(desc), (const unsigned char *)instance, json_out);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_encode_array(const struct_meta_descriptor *desc, const void *base, size_t count, size_t stride,
+                                  cJSON **json_out)
+{
+    if (json_out == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    *json_out = NULL;
+    int ret = struct_meta_internal_array_stride(desc, base, count, stride, &stride);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    ret = struct_meta_internal_descriptor_acquire(desc, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+
+    cJSON *array = cJSON_CreateArray();
+    if (array == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    /* 検査と JSON キー索引の取得は配列全体で 1 回だけ行う。 */
+    const struct_meta_internal_name_index *names = struct_meta_internal_json_names(desc);
+    for (size_t i = 0; i < count; i++)
+    {
+        cJSON *item = NULL;
+        ret = struct_to_json(desc, names, (const unsigned char *)base + (i * stride), &item);
+        if (ret != COM_UTIL_OK)
+        {
+            cJSON_Delete(array);
+            return ret;
+        }
+        if (!cJSON_AddItemToArray(array, item))
+        {
+            cJSON_Delete(item);
+            cJSON_Delete(array);
+            return COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    *json_out = array;
+    return COM_UTIL_OK;
 }
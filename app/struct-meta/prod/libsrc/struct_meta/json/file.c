@@ -17,15 +17,13 @@
  */
 
 #include <struct_meta/json/file.h>
-#include <struct_meta/json/json.h>
+#include <struct_meta/json/reader.h>
+#include <struct_meta/json/undo.h>
+#include <struct_meta/json/writer.h>
 
 #include <com_util/base/result.h>
 #include <com_util/crt/stdio.h>
 
-#include <stdint.h>
-#include <stdlib.h>
-#include <string.h>
-
 /* Doxygen コメントは、ヘッダーに記載 */
 
 int struct_meta_json_file_save(const struct_meta_descriptor *desc, const void *instance, const char *path)
@@ -35,108 +33,106 @@ int struct_meta_json_file_save(const struct_meta_descriptor *desc, const void *i
         return COM_UTIL_ERR_INVALID_ARGUMENT;
     }
 
-    cJSON *json = NULL;
-    int ret = struct_meta_json_encode(desc, instance, &json);
+    /* 記述子の誤りでは出力ファイルを作らないよう、開く前に検査する。 */
+    int ret = struct_meta_descriptor_seal(desc);
     if (ret != COM_UTIL_OK)
     {
         return ret;
     }
 
-    char *text = cJSON_Print(json);
-    cJSON_Delete(json);
-    if (text == NULL)
-    {
-        return COM_UTIL_ERR_OUT_OF_MEMORY;
-    }
-
     FILE *stream = com_util_fopen(path, "wb", NULL);
     if (stream == NULL)
     {
-        cJSON_free(text);
         return COM_UTIL_ERR_NOT_FOUND;
     }
 
-    size_t text_len = strlen(text);
-    int needs_newline = (text_len == 0U) || (text[text_len - 1U] != '\n');
-    if ((needs_newline != 0) && (text_len == SIZE_MAX))
-    {
-        (void)com_util_fclose(stream, NULL);
-        cJSON_free(text);
-        return COM_UTIL_ERR_OUT_OF_RANGE;
-    }
-
-    size_t expected_len = text_len + ((needs_newline != 0) ? 1U : 0U);
-    size_t written = com_util_fwrite(text, 1, text_len, stream, NULL);
-    if ((written == text_len) && (needs_newline != 0))
+    /* cJSON_Print() と同じテキストを直接書き出し、末尾に改行を 1 個付ける。 */
+    ret = struct_meta_json_write_stream(desc, instance, STRUCT_META_JSON_FORMAT_PRETTY, stream);
+    if (ret == COM_UTIL_OK)
     {
         static const char newline[] = "\n";
-        if (com_util_fwrite(newline, 1U, 1U, stream, NULL) == 1U)
+        if (com_util_fwrite(newline, 1U, 1U, stream, NULL) != 1U)
         {
-            written++;
+            ret = COM_UTIL_ERR_UNKNOWN;
         }
     }
-    com_util_fclose(stream, NULL);
-    cJSON_free(text);
-
-    if (written != expected_len)
+    if ((com_util_fclose(stream, NULL) != 0) && (ret == COM_UTIL_OK))
     {
-        return COM_UTIL_ERR_UNKNOWN;
+        ret = COM_UTIL_ERR_UNKNOWN;
     }
-    return COM_UTIL_OK;
+    return ret;
 }
 
-/* Doxygen コメントは、ヘッダーに記載 */
-
-int struct_meta_json_file_load(const struct_meta_descriptor *desc, const char *path, void *instance)
+/**
+ *  @brief          ファイルを開き、チャンク単位で読みながら構造体へ書き込みます。
+ *
+ *  @p arena を指定した場合は、読み取り中の一時領域をアリーナから確保し、戻る前に使用量を呼び出し前へ戻します。
+ *  読み取り状態の窓がチャンク単位で読み込むため、ストリーム側のバッファーは確保させません。\n
+ *  書き込むフィールドを取り消しログへ記録し、エラーの場合は書き戻すため、
+ *  切り詰められたファイルや構文の誤りでは @p instance を変更しません。
+ */
+static int load(const struct_meta_descriptor *desc, const char *path, void *instance, struct_meta_arena *arena)
 {
-    if ((desc == NULL) || (instance == NULL) || (path == NULL))
-    {
-        return COM_UTIL_ERR_INVALID_ARGUMENT;
-    }
-
     FILE *stream = com_util_fopen(path, "rb", NULL);
     if (stream == NULL)
     {
         return COM_UTIL_ERR_NOT_FOUND;
     }
 
-    if (com_util_fseek(stream, 0, SEEK_END) != 0)
+    /* cJSON の DOM もファイル全体のバッファーも作らず、チャンク単位で読みながら構造体へ書き込む。 */
+    struct_meta_json_reader reader;
+    struct_meta_buffer undo;
+    struct_meta_buffer_init(&undo);
+    struct_meta_arena_mark mark = struct_meta_arena_save(arena);
+    int ret = struct_meta_json_reader_init_stream(&reader, stream);
+    if ((ret == COM_UTIL_OK) && (arena != NULL))
     {
-        com_util_fclose(stream, NULL);
-        return COM_UTIL_ERR_UNKNOWN;
+        (void)setvbuf(stream, NULL, _IONBF, 0U);
+        ret = struct_meta_json_reader_use_arena(&reader, arena);
     }
-    int64_t file_size = com_util_ftell(stream);
-    if ((file_size < 0) || (com_util_fseek(stream, 0, SEEK_SET) != 0))
+    if (ret == COM_UTIL_OK)
     {
-        com_util_fclose(stream, NULL);
-        return COM_UTIL_ERR_UNKNOWN;
+        /* 構文の誤りはファイルの途中で見つかるため、それまでの書き込みを取り消せるよう記録しながら読む。 */
+        reader.undo = &undo;
+        ret = struct_meta_json_reader_value(&reader, desc, instance);
+        if (ret == COM_UTIL_OK)
+        {
+            struct_meta_internal_undo_commit(&undo);
+        }
+        else
+        {
+            struct_meta_internal_undo_rollback(&undo);
+        }
+        struct_meta_json_reader_dispose(&reader);
     }
-
-    /* JSON テキストのバイト列バッファー。要素型に対応しない生バイト確保のため sizeof(*p) は使わない。 */
-    char *text = (char *)malloc((size_t)file_size + 1U);
-    if (text == NULL)
+    struct_meta_buffer_dispose(&undo);
+    if (arena != NULL)
     {
-        com_util_fclose(stream, NULL);
-        return COM_UTIL_ERR_OUT_OF_MEMORY;
+        struct_meta_arena_rewind(arena, mark);
     }
-
-    size_t read_count = com_util_fread(text, 1, (size_t)file_size, stream, NULL);
     com_util_fclose(stream, NULL);
-    if (read_count != (size_t)file_size)
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_file_load(const struct_meta_descriptor *desc, const char *path, void *instance)
+{
+    if ((desc == NULL) || (instance == NULL) || (path == NULL))
     {
-        free(text);
-        return COM_UTIL_ERR_UNKNOWN;
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
     }
-    text[file_size] = '\0';
+    return load(desc, path, instance, NULL);
+}
 
-    cJSON *json = cJSON_Parse(text);
-    free(text);
-    if (json == NULL)
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_file_load_arena(const struct_meta_descriptor *desc, const char *path, void *instance,
+                                     struct_meta_arena *arena)
+{
+    if ((desc == NULL) || (instance == NULL) || (path == NULL) || (arena == NULL))
     {
         return COM_UTIL_ERR_INVALID_ARGUMENT;
     }
-
-    int ret = struct_meta_json_decode(desc, json, instance);
-    cJSON_Delete(json);
-    return ret;
+    return load(desc, path, instance, arena);
 }
@@ -0,0 +1,93 @@
+/**
+ *******************************************************************************
+ *  @file           key.c
+ *  @brief          フィールドの JSON キーを属性から決定し、記述子ごとの JSON キー索引を管理します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/json/key.h>
+
+#include <struct_meta/access/access.h>
+#include <struct_meta/meta/registry.h>
+
+#include <com_util/base/result.h>
+
+#include <stddef.h>
+#include <stdlib.h>
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+const char *struct_meta_internal_json_key(const struct_meta_field *field)
+{
+    const struct_meta_attribute *attribute = NULL;
+    if (struct_meta_field_find_attribute(field, "json.ignore", &attribute) == COM_UTIL_OK)
+    {
+        return NULL;
+    }
+    if ((struct_meta_field_find_attribute(field, "json.name", &attribute) == COM_UTIL_OK) &&
+        (attribute->value != NULL) && (attribute->value[0] != '\0'))
+    {
+        return attribute->value;
+    }
+    return field->name;
+}
+
+/** 登録情報へ公開した JSON キーの索引を、登録の削除時に解放します。 */
+static void dispose_names(void *data)
+{
+    struct_meta_internal_name_index_dispose((struct_meta_internal_name_index *)data);
+    free(data);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+const struct_meta_internal_name_index *struct_meta_internal_json_names(const struct_meta_descriptor *descriptor)
+{
+    const struct_meta_internal_descriptor_entry *entry = struct_meta_internal_registry_find(descriptor);
+    if (entry == NULL)
+    {
+        return NULL;
+    }
+    void *published = struct_meta_internal_extension_get(entry, STRUCT_META_INTERNAL_EXTENSION_JSON_NAMES);
+    if (published != NULL)
+    {
+        return (const struct_meta_internal_name_index *)published;
+    }
+
+    struct_meta_internal_name_index *candidate =
+        (struct_meta_internal_name_index *)malloc(sizeof(struct_meta_internal_name_index));
+    if (candidate == NULL)
+    {
+        return NULL;
+    }
+    /* json.name と json.ignore の解釈は属性の線形探索を伴うため、キーは全フィールド分を保持する。 */
+    if (struct_meta_internal_name_index_build(descriptor, struct_meta_internal_json_key, 1, candidate) !=
+        COM_UTIL_OK)
+    {
+        free(candidate);
+        return NULL;
+    }
+    published = struct_meta_internal_extension_publish(entry, STRUCT_META_INTERNAL_EXTENSION_JSON_NAMES, candidate,
+                                                      dispose_names);
+    if (published != candidate)
+    {
+        struct_meta_internal_name_index_dispose(candidate);
+        free(candidate);
+    }
+    return (const struct_meta_internal_name_index *)published;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+const char *struct_meta_internal_json_field_key(const struct_meta_internal_name_index *names,
+                                                const struct_meta_descriptor *descriptor, size_t field_index)
+{
+    if ((names != NULL) && (names->keys != NULL))
+    {
+        return names->keys[field_index];
+    }
+    return struct_meta_internal_json_key(&descriptor->fields[field_index]);
+}
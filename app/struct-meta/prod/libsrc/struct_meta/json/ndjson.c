@@ -0,0 +1,322 @@
+/**
+ *******************************************************************************
+ *  @file           ndjson.c
+ *  @brief          構造体を 1 行 1 レコードの JSON テキスト (NDJSON) として順に読み書きします。
+ *
+ *  1 行分の変換は struct_meta_json_write_buffer() と struct_meta_json_reader_value() に任せ、
+ *  本ファイルは行の切り出しと、ストリームとの間のバッファリングだけを扱います。\n
+ *  ファイル I/O は `com_util/crt/stdio.h` の stdio ラッパーを使用します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/json/ndjson.h>
+#include <struct_meta/json/writer.h>
+
+#include <struct_meta/meta/registry.h>
+
+#include <com_util/base/result.h>
+#include <com_util/crt/stdio.h>
+
+#include <string.h>
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_ndjson_writer_init(struct_meta_ndjson_writer *writer, FILE *stream)
+{
+    if ((writer == NULL) || (stream == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    memset(writer, 0, sizeof(*writer));
+    writer->stream = stream;
+    struct_meta_buffer_init(&writer->pending);
+    writer->result = COM_UTIL_OK;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_ndjson_writer_append(struct_meta_ndjson_writer *writer, const struct_meta_descriptor *descriptor,
+                                     const void *instance)
+{
+    if (writer == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if (writer->result != COM_UTIL_OK)
+    {
+        return writer->result;
+    }
+
+    /* 失敗した場合は struct_meta_json_write_buffer() が書き出し待ちを呼び出し前へ戻す。 */
+    size_t initial_length = writer->pending.length;
+    int ret = struct_meta_json_write_buffer(descriptor, instance, STRUCT_META_JSON_FORMAT_COMPACT, &writer->pending);
+    if (ret == COM_UTIL_OK)
+    {
+        static const char newline[] = "\n";
+        ret = struct_meta_buffer_append(&writer->pending, newline, 1U);
+        if (ret != COM_UTIL_OK)
+        {
+            writer->pending.length = initial_length;
+            writer->pending.data[initial_length] = '\0';
+        }
+    }
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    writer->record_count++;
+    if (writer->pending.length >= STRUCT_META_NDJSON_WRITER_CHUNK_SIZE)
+    {
+        return struct_meta_ndjson_writer_flush(writer);
+    }
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_ndjson_writer_flush(struct_meta_ndjson_writer *writer)
+{
+    if (writer == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if ((writer->result == COM_UTIL_OK) && (writer->pending.length > 0U))
+    {
+        if (com_util_fwrite(writer->pending.data, 1U, writer->pending.length, writer->stream, NULL) !=
+            writer->pending.length)
+        {
+            writer->result = COM_UTIL_ERR_UNKNOWN;
+        }
+        struct_meta_buffer_reset(&writer->pending);
+    }
+    return writer->result;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_ndjson_writer_dispose(struct_meta_ndjson_writer *writer)
+{
+    if (writer == NULL)
+    {
+        return;
+    }
+    struct_meta_buffer_dispose(&writer->pending);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_ndjson_reader_init(struct_meta_ndjson_reader *reader, FILE *stream, size_t line_limit)
+{
+    if ((reader == NULL) || (stream == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    memset(reader, 0, sizeof(*reader));
+    reader->stream = stream;
+    struct_meta_buffer_init(&reader->line);
+    reader->line_limit = line_limit;
+    if (reader->line_limit == 0U)
+    {
+        reader->line_limit = STRUCT_META_NDJSON_DEFAULT_LINE_LIMIT;
+    }
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_ndjson_reader_use_arena(struct_meta_ndjson_reader *reader, struct_meta_arena *arena)
+{
+    if (reader == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    reader->arena = arena;
+    return COM_UTIL_OK;
+}
+
+/**
+ *  @brief          cJSON と同じく、0x20 以下のバイトだけからなるかを判定します。
+ */
+static int is_blank(const unsigned char *text, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        if (text[i] > 32U)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ *  @brief          1 行を構造体へ読み込みます。値の後ろには空白だけを許します。
+ */
+static int decode_line(const struct_meta_descriptor *desc, const unsigned char *text, size_t length,
+                       void *instance, struct_meta_arena *arena)
+{
+    struct_meta_json_reader reader;
+
+    int ret = struct_meta_json_reader_init_text(&reader, (const char *)text, length);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    struct_meta_arena_mark mark = struct_meta_arena_save(arena);
+    (void)struct_meta_json_reader_use_arena(&reader, arena);
+    memset(instance, 0, desc->size);
+    ret = struct_meta_json_reader_value(&reader, desc, instance);
+    if ((ret == COM_UTIL_OK) && (is_blank(text + reader.position, length - reader.position) == 0))
+    {
+        ret = COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    struct_meta_json_reader_dispose(&reader);
+    if (arena != NULL)
+    {
+        struct_meta_arena_rewind(arena, mark);
+    }
+    return ret;
+}
+
+/**
+ *  @brief          読み込み中の行へ連結します。上限を超える場合は連結せずに超過を記録します。
+ */
+static int append_line(struct_meta_ndjson_reader *reader, const unsigned char *text, size_t length)
+{
+    if ((reader->overflow != 0) || (length > (reader->line_limit - reader->line.length)))
+    {
+        reader->overflow = 1;
+        return COM_UTIL_OK;
+    }
+    return struct_meta_buffer_append(&reader->line, text, length);
+}
+
+/**
+ *  @brief          行の終端まで読み進めた後、行を処理します。
+ *  @return         レコードを読み込んだ場合やエラーの場合は結果コード、空白だけの行の場合は @c COM_UTIL_SKIPPED です。
+ */
+static int finish_line(struct_meta_ndjson_reader *reader, const struct_meta_descriptor *desc,
+                       const unsigned char *text, size_t length, void *instance)
+{
+    int ret = COM_UTIL_SKIPPED;
+
+    reader->line_number++;
+    if (reader->overflow != 0)
+    {
+        ret = COM_UTIL_ERR_BUFFER_TOO_SMALL;
+    }
+    else if (is_blank(text, length) == 0)
+    {
+        ret = decode_line(desc, text, length, instance, reader->arena);
+    }
+    reader->overflow = 0;
+    struct_meta_buffer_reset(&reader->line);
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_ndjson_reader_next(struct_meta_ndjson_reader *reader, const struct_meta_descriptor *descriptor,
+                                   void *instance)
+{
+    if ((reader == NULL) || (descriptor == NULL) || (instance == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    /* 0 で埋める前に、記述子の size を信頼できることを確かめる。 */
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+
+    for (;;)
+    {
+        if (reader->chunk_position == reader->chunk_length)
+        {
+            if (reader->at_end != 0)
+            {
+                if ((reader->line.length == 0U) && (reader->overflow == 0))
+                {
+                    return COM_UTIL_ERR_EOF;
+                }
+                /* 改行で終わらない最後の行。 */
+                ret = finish_line(reader, descriptor, reader->line.data, reader->line.length, instance);
+            }
+            else
+            {
+                reader->chunk_position = 0U;
+                reader->chunk_length =
+                    com_util_fread(reader->chunk, 1U, sizeof(reader->chunk), reader->stream, NULL);
+                if (reader->chunk_length == 0U)
+                {
+                    if (ferror(reader->stream) != 0)
+                    {
+                        return COM_UTIL_ERR_UNKNOWN;
+                    }
+                    reader->at_end = 1;
+                }
+                continue;
+            }
+        }
+        else
+        {
+            const unsigned char *begin = reader->chunk + reader->chunk_position;
+            size_t rest = reader->chunk_length - reader->chunk_position;
+            const unsigned char *newline = (const unsigned char *)memchr(begin, '\n', rest);
+            if (newline == NULL)
+            {
+                reader->chunk_position = reader->chunk_length;
+                ret = append_line(reader, begin, rest);
+                if (ret != COM_UTIL_OK)
+                {
+                    return ret;
+                }
+                continue;
+            }
+
+            size_t length = (size_t)(newline - begin);
+            reader->chunk_position += length + 1U;
+            if ((reader->line.length == 0U) && (reader->overflow == 0))
+            {
+                /* チャンクの中で完結する行は、複写せずにチャンクから読み込む。 */
+                if (length > reader->line_limit)
+                {
+                    reader->overflow = 1;
+                }
+                ret = finish_line(reader, descriptor, begin, length, instance);
+            }
+            else
+            {
+                ret = append_line(reader, begin, length);
+                if (ret != COM_UTIL_OK)
+                {
+                    return ret;
+                }
+                ret = finish_line(reader, descriptor, reader->line.data, reader->line.length, instance);
+            }
+        }
+        if (ret != COM_UTIL_SKIPPED)
+        {
+            return ret;
+        }
+    }
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_ndjson_reader_dispose(struct_meta_ndjson_reader *reader)
+{
+    if (reader == NULL)
+    {
+        return;
+    }
+    struct_meta_buffer_dispose(&reader->line);
+    reader->chunk_position = 0U;
+    reader->chunk_length = 0U;
+}
@@ -0,0 +1,1645 @@
+/**
+ *******************************************************************************
+ *  @file           reader.c
+ *  @brief          JSON テキストを 1 回だけ走査し、cJSON のオブジェクトを作らずに構造体へ読み込みます。
+ *
+ *  字句と構文の規則は cJSON 1.7 系の parse_value()、parse_string()、parse_number()、
+ *  parse_array()、parse_object() と同じです。\n
+ *  キーと値はテキストの出現順に処理し、キーは記述子ごとの JSON キー索引で引きます。
+ *  索引は記述子の登録情報へ初回利用時に公開し、以降は全スレッドで共有します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/json/reader.h>
+
+#include <struct_meta/access/access.h>
+#include <struct_meta/base/array.h>
+#include <struct_meta/base/atomic.h>
+#include <struct_meta/base/parallel.h>
+#include <struct_meta/json/key.h>
+#include <struct_meta/json/undo.h>
+#include <struct_meta/memory/dynamic.h>
+#include <struct_meta/meta/name_index.h>
+#include <struct_meta/meta/registry.h>
+#include <struct_meta/meta/scalar.h>
+
+#include <com_util/base/result.h>
+#include <com_util/crt/stdio.h>
+
+#include <locale.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* cJSON の number_c_string と同じく、数値として読み取る最大文字数。 */
+#define NUMBER_MAX_LENGTH 63U
+
+/* 既読フィールドのビット列をスタックへ置けるフィールド数。超える記述子ではヒープへ確保する。 */
+#define SEEN_LOCAL_FIELDS 512U
+
+/* 次に期待する構文要素。 */
+enum
+{
+    STATE_START = 0,         /* 先頭の BOM を確認してから値を読む。 */
+    STATE_VALUE = 1,         /* 値。 */
+    STATE_VALUE_OR_END = 2,  /* 配列の最初の値、または ']'。 */
+    STATE_KEY_OR_END = 3,    /* オブジェクトの最初のキー、または '}'。 */
+    STATE_KEY = 4,           /* ',' の後のキー。 */
+    STATE_COLON = 5,         /* キーの後の ':'。 */
+    STATE_AFTER_VALUE = 6,   /* ','、またはコンテナーの終端。 */
+    STATE_DONE = 7           /* 最上位の値を読み終えた。 */
+};
+
+static int fail(struct_meta_json_reader *reader, int result)
+{
+    if (reader->result == COM_UTIL_OK)
+    {
+        reader->result = result;
+    }
+    return reader->result;
+}
+
+/**
+ *  @brief          ストリームから次のチャンクを読み込みます。
+ *
+ *  処理済みのテキスト (position より前) は捨てるため、読み取り中のトークンの先頭は保持されます。
+ *  @return         読み込んだ場合は 0 以外、テキストから読み取っている場合や終端、エラーの場合は 0 です。
+ */
+static int refill(struct_meta_json_reader *reader)
+{
+    if (reader->stream == NULL)
+    {
+        return 0;
+    }
+
+    struct_meta_buffer *window = &reader->window;
+    if (reader->position > 0U)
+    {
+        memmove(window->data, window->data + reader->position, window->length - reader->position);
+        window->length -= reader->position;
+        reader->position = 0U;
+    }
+    int ret = struct_meta_buffer_reserve(window, STRUCT_META_JSON_READER_CHUNK_SIZE);
+    if (ret != COM_UTIL_OK)
+    {
+        (void)fail(reader, ret);
+        return 0;
+    }
+    size_t read_length =
+        com_util_fread(window->data + window->length, 1U, STRUCT_META_JSON_READER_CHUNK_SIZE, reader->stream, NULL);
+    if (read_length == 0U)
+    {
+        if (ferror(reader->stream) != 0)
+        {
+            (void)fail(reader, COM_UTIL_ERR_UNKNOWN);
+        }
+        return 0;
+    }
+    window->length += read_length;
+    window->data[window->length] = '\0';
+    reader->text = window->data;
+    reader->length = window->length;
+    return 1;
+}
+
+/**
+ *  @brief          position から @p count バイトを参照できるようにします。
+ *  @return         参照できる場合は 0 以外です。
+ */
+static int available(struct_meta_json_reader *reader, size_t count)
+{
+    while ((reader->length - reader->position) < count)
+    {
+        if (refill(reader) == 0)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ *  @brief          cJSON の buffer_skip_whitespace() と同じく、0x20 以下のバイトを読み飛ばします。
+ *  @return         空白の後に文字がある場合は 0 以外です。
+ */
+static int skip_space(struct_meta_json_reader *reader)
+{
+    for (;;)
+    {
+        while ((reader->position < reader->length) && (reader->text[reader->position] <= 32U))
+        {
+            reader->position++;
+        }
+        if (reader->position < reader->length)
+        {
+            return 1;
+        }
+        if (refill(reader) == 0)
+        {
+            return 0;
+        }
+    }
+}
+
+static int push(struct_meta_json_reader *reader, int is_object)
+{
+    if (reader->depth >= STRUCT_META_JSON_NESTING_LIMIT)
+    {
+        return fail(reader, COM_UTIL_ERR_INVALID_ARGUMENT);
+    }
+    unsigned char bit = (unsigned char)(1U << (reader->depth % 8U));
+    if (is_object != 0)
+    {
+        reader->containers[reader->depth / 8U] |= bit;
+    }
+    else
+    {
+        reader->containers[reader->depth / 8U] &= (unsigned char)~bit;
+    }
+    reader->depth++;
+    /* '{' または '[' を読み進める。 */
+    reader->position++;
+    return COM_UTIL_OK;
+}
+
+static int top_is_object(const struct_meta_json_reader *reader)
+{
+    size_t top = reader->depth - 1U;
+    return (int)(((unsigned int)reader->containers[top / 8U] >> (top % 8U)) & 1U);
+}
+
+static int parse_hex4(const unsigned char *text, unsigned int *value_out)
+{
+    unsigned int value = 0U;
+    for (size_t i = 0; i < 4U; i++)
+    {
+        unsigned int digit;
+        if ((text[i] >= '0') && (text[i] <= '9'))
+        {
+            digit = (unsigned int)(text[i] - '0');
+        }
+        else if ((text[i] >= 'A') && (text[i] <= 'F'))
+        {
+            digit = (unsigned int)(text[i] - 'A') + 10U;
+        }
+        else if ((text[i] >= 'a') && (text[i] <= 'f'))
+        {
+            digit = (unsigned int)(text[i] - 'a') + 10U;
+        }
+        else
+        {
+            return 0;
+        }
+        value = (value << 4) | digit;
+    }
+    *value_out = value;
+    return 1;
+}
+
+/**
+ *  @brief          \\uXXXX (サロゲート ペアを含む) を UTF-8 へ変換します。
+ *  @return         読み取ったバイト数です。不正な場合は 0 です。
+ */
+static size_t utf16_to_utf8(const unsigned char *text, size_t length, unsigned char *output, size_t *written_out)
+{
+    unsigned int first;
+    unsigned long codepoint;
+    size_t consumed = 6U;
+
+    if ((length < 6U) || (parse_hex4(text + 2, &first) == 0) || ((first >= 0xDC00U) && (first <= 0xDFFFU)))
+    {
+        return 0U;
+    }
+    codepoint = first;
+    if ((first >= 0xD800U) && (first <= 0xDBFFU))
+    {
+        unsigned int second;
+        if ((length < 12U) || (text[6] != '\\') || (text[7] != 'u') || (parse_hex4(text + 8, &second) == 0) ||
+            (second < 0xDC00U) || (second > 0xDFFFU))
+        {
+            return 0U;
+        }
+        codepoint = 0x10000UL + ((((unsigned long)first & 0x3FFU) << 10) | ((unsigned long)second & 0x3FFU));
+        consumed = 12U;
+    }
+
+    if (codepoint < 0x80UL)
+    {
+        output[0] = (unsigned char)codepoint;
+        *written_out = 1U;
+    }
+    else if (codepoint < 0x800UL)
+    {
+        output[0] = (unsigned char)(0xC0UL | (codepoint >> 6));
+        output[1] = (unsigned char)(0x80UL | (codepoint & 0x3FUL));
+        *written_out = 2U;
+    }
+    else if (codepoint < 0x10000UL)
+    {
+        output[0] = (unsigned char)(0xE0UL | (codepoint >> 12));
+        output[1] = (unsigned char)(0x80UL | ((codepoint >> 6) & 0x3FUL));
+        output[2] = (unsigned char)(0x80UL | (codepoint & 0x3FUL));
+        *written_out = 3U;
+    }
+    else
+    {
+        output[0] = (unsigned char)(0xF0UL | (codepoint >> 18));
+        output[1] = (unsigned char)(0x80UL | ((codepoint >> 12) & 0x3FUL));
+        output[2] = (unsigned char)(0x80UL | ((codepoint >> 6) & 0x3FUL));
+        output[3] = (unsigned char)(0x80UL | (codepoint & 0x3FUL));
+        *written_out = 4U;
+    }
+    return consumed;
+}
+
+/**
+ *  @brief          エスケープを展開した文字列を scratch へ書き込みます。
+ *
+ *  展開後の長さは元の長さを超えないため、先に元の長さ分を確保します。
+ */
+static int unescape(struct_meta_json_reader *reader, const unsigned char *text, size_t length)
+{
+    struct_meta_buffer_reset(&reader->scratch);
+    int ret = struct_meta_buffer_reserve(&reader->scratch, length);
+    if (ret != COM_UTIL_OK)
+    {
+        return fail(reader, ret);
+    }
+
+    unsigned char *output = reader->scratch.data;
+    size_t written = 0U;
+    size_t i = 0U;
+    while (i < length)
+    {
+        if (text[i] != '\\')
+        {
+            output[written++] = text[i++];
+            continue;
+        }
+        switch (text[i + 1U])
+        {
+        case 'b':
+            output[written++] = '\b';
+            break;
+        case 'f':
+            output[written++] = '\f';
+            break;
+        case 'n':
+            output[written++] = '\n';
+            break;
+        case 'r':
+            output[written++] = '\r';
+            break;
+        case 't':
+            output[written++] = '\t';
+            break;
+        case '"':
+        case '\\':
+        case '/':
+            output[written++] = text[i + 1U];
+            break;
+        case 'u':
+        {
+            size_t sequence_written = 0U;
+            size_t consumed = utf16_to_utf8(text + i, length - i, output + written, &sequence_written);
+            if (consumed == 0U)
+            {
+                return fail(reader, COM_UTIL_ERR_INVALID_ARGUMENT);
+            }
+            written += sequence_written;
+            i += consumed;
+            continue;
+        }
+        default:
+            return fail(reader, COM_UTIL_ERR_INVALID_ARGUMENT);
+        }
+        i += 2U;
+    }
+
+    reader->scratch.length = written;
+    reader->scratch.data[written] = '\0';
+    reader->string = (const char *)reader->scratch.data;
+    reader->string_length = written;
+    return COM_UTIL_OK;
+}
+
+/**
+ *  @brief          position の '"' から始まる文字列を読み取ります。
+ *
+ *  エスケープを含まない場合は、テキストを直接指します。
+ */
+static int parse_string(struct_meta_json_reader *reader)
+{
+    size_t end = 1U;
+    int escaped = 0;
+    for (;;)
+    {
+        if (available(reader, end + 1U) == 0)
+        {
+            return fail(reader, COM_UTIL_ERR_INVALID_ARGUMENT);
+        }
+        unsigned char c = reader->text[reader->position + end];
+        if (c == '"')
+        {
+            break;
+        }
+        if (c == '\\')
+        {
+            /* エスケープされた文字は終端の '"' と見なさない。 */
+            escaped = 1;
+            end++;
+        }
+        end++;
+    }
+
+    /* available() がテキストを詰め直すため、ポインターは走査後に求める。 */
+    const unsigned char *content = reader->text + reader->position + 1U;
+    size_t content_length = end - 1U;
+    reader->position += end + 1U;
+    if (escaped != 0)
+    {
+        return unescape(reader, content, content_length);
+    }
+    reader->string = (const char *)content;
+    reader->string_length = content_length;
+    return COM_UTIL_OK;
+}
+
+static int parse_number(struct_meta_json_reader *reader)
+{
+    char number[NUMBER_MAX_LENGTH + 1U];
+    char decimal_point = localeconv()->decimal_point[0];
+    size_t length = 0U;
+
+    while ((length < NUMBER_MAX_LENGTH) && (available(reader, length + 1U) != 0))
+    {
+        char c = (char)reader->text[reader->position + length];
+        if (((c >= '0') && (c <= '9')) || (c == '+') || (c == '-') || (c == 'e') || (c == 'E'))
+        {
+            number[length++] = c;
+        }
+        else if (c == '.')
+        {
+            number[length++] = decimal_point;
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (reader->result != COM_UTIL_OK)
+    {
+        return reader->result;
+    }
+    number[length] = '\0';
+
+    char *after_end = NULL;
+    double value = strtod(number, &after_end);
+    if (after_end == number)
+    {
+        return fail(reader, COM_UTIL_ERR_INVALID_ARGUMENT);
+    }
+    reader->number = value;
+    reader->integer = 0U;
+    reader->integer_sign =
+        struct_meta_internal_integer_from_text(number, (size_t)(after_end - number), &reader->integer);
+    reader->position += (size_t)(after_end - number);
+    return COM_UTIL_OK;
+}
+
+static int parse_literal(struct_meta_json_reader *reader, const char *literal, size_t length)
+{
+    if ((available(reader, length) == 0) || (memcmp(reader->text + reader->position, literal, length) != 0))
+    {
+        return fail(reader, COM_UTIL_ERR_INVALID_ARGUMENT);
+    }
+    reader->position += length;
+    return COM_UTIL_OK;
+}
+
+static int read_key(struct_meta_json_reader *reader, struct_meta_json_token *token_out)
+{
+    if ((skip_space(reader) == 0) || (reader->text[reader->position] != '"'))
+    {
+        return fail(reader, COM_UTIL_ERR_INVALID_ARGUMENT);
+    }
+    int ret = parse_string(reader);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    reader->state = STATE_COLON;
+    *token_out = STRUCT_META_JSON_TOKEN_KEY;
+    return COM_UTIL_OK;
+}
+
+static int read_value(struct_meta_json_reader *reader, struct_meta_json_token *token_out)
+{
+    if (skip_space(reader) == 0)
+    {
+        return fail(reader, COM_UTIL_ERR_INVALID_ARGUMENT);
+    }
+
+    int ret;
+    unsigned char c = reader->text[reader->position];
+    switch (c)
+    {
+    case '{':
+        ret = push(reader, 1);
+        reader->state = STATE_KEY_OR_END;
+        *token_out = STRUCT_META_JSON_TOKEN_BEGIN_OBJECT;
+        return ret;
+    case '[':
+        ret = push(reader, 0);
+        reader->state = STATE_VALUE_OR_END;
+        *token_out = STRUCT_META_JSON_TOKEN_BEGIN_ARRAY;
+        return ret;
+    case '"':
+        ret = parse_string(reader);
+        *token_out = STRUCT_META_JSON_TOKEN_STRING;
+        break;
+    case 't':
+        ret = parse_literal(reader, "true", 4U);
+        *token_out = STRUCT_META_JSON_TOKEN_TRUE;
+        break;
+    case 'f':
+        ret = parse_literal(reader, "false", 5U);
+        *token_out = STRUCT_META_JSON_TOKEN_FALSE;
+        break;
+    case 'n':
+        ret = parse_literal(reader, "null", 4U);
+        *token_out = STRUCT_META_JSON_TOKEN_NULL;
+        break;
+    default:
+        if ((c != '-') && ((c < '0') || (c > '9')))
+        {
+            return fail(reader, COM_UTIL_ERR_INVALID_ARGUMENT);
+        }
+        ret = parse_number(reader);
+        *token_out = STRUCT_META_JSON_TOKEN_NUMBER;
+        break;
+    }
+    reader->state = STATE_AFTER_VALUE;
+    return ret;
+}
+
+/**
+ *  @brief          position の '}' または ']' で現在のコンテナーを閉じます。
+ */
+static int close_container(struct_meta_json_reader *reader, struct_meta_json_token *token_out)
+{
+    unsigned char c = reader->text[reader->position];
+    int is_object = top_is_object(reader);
+    if (((c == '}') && (is_object != 0)) || ((c == ']') && (is_object == 0)))
+    {
+        reader->position++;
+        reader->depth--;
+        reader->state = STATE_AFTER_VALUE;
+        if (is_object != 0)
+        {
+            *token_out = STRUCT_META_JSON_TOKEN_END_OBJECT;
+        }
+        else
+        {
+            *token_out = STRUCT_META_JSON_TOKEN_END_ARRAY;
+        }
+        return COM_UTIL_OK;
+    }
+    return fail(reader, COM_UTIL_ERR_INVALID_ARGUMENT);
+}
+
+static void reader_init(struct_meta_json_reader *reader, const unsigned char *text, size_t length, FILE *stream)
+{
+    memset(reader, 0, sizeof(*reader));
+    reader->text = text;
+    reader->length = length;
+    reader->stream = stream;
+    struct_meta_buffer_init(&reader->window);
+    struct_meta_buffer_init(&reader->scratch);
+    reader->string = "";
+    reader->state = STATE_START;
+    reader->result = COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_reader_init_text(struct_meta_json_reader *reader, const char *text, size_t length)
+{
+    if ((reader == NULL) || ((text == NULL) && (length > 0U)))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    reader_init(reader, (const unsigned char *)text, length, NULL);
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_reader_init_stream(struct_meta_json_reader *reader, FILE *stream)
+{
+    if ((reader == NULL) || (stream == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    reader_init(reader, NULL, 0U, stream);
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_reader_use_arena(struct_meta_json_reader *reader, struct_meta_arena *arena)
+{
+    if (reader == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    /* 確保済みの領域の確保元を取り違えないよう、読み取りを始める前に限る。 */
+    if ((reader->state != STATE_START) || (reader->window.data != NULL) || (reader->scratch.data != NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    reader->arena = arena;
+    struct_meta_buffer_init_arena(&reader->window, arena);
+    struct_meta_buffer_init_arena(&reader->scratch, arena);
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_reader_use_allocator(struct_meta_json_reader *reader, const struct_meta_allocator *allocator)
+{
+    if ((reader == NULL) || ((allocator != NULL) && (allocator->allocate == NULL)))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    reader->allocator = allocator;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_json_reader_dispose(struct_meta_json_reader *reader)
+{
+    if (reader == NULL)
+    {
+        return;
+    }
+    struct_meta_buffer_dispose(&reader->window);
+    struct_meta_buffer_dispose(&reader->scratch);
+    reader->text = NULL;
+    reader->length = 0U;
+    reader->position = 0U;
+    reader->string = "";
+    reader->string_length = 0U;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_reader_next(struct_meta_json_reader *reader, struct_meta_json_token *token_out)
+{
+    if ((reader == NULL) || (token_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if (reader->result != COM_UTIL_OK)
+    {
+        return reader->result;
+    }
+
+    switch (reader->state)
+    {
+    case STATE_START:
+        /* cJSON_ParseWithLengthOpts() と同じく、先頭の UTF-8 BOM を読み飛ばす。 */
+        if ((available(reader, 3U) != 0) && (memcmp(reader->text + reader->position, "\xEF\xBB\xBF", 3U) == 0))
+        {
+            reader->position += 3U;
+        }
+        return read_value(reader, token_out);
+
+    case STATE_VALUE:
+        return read_value(reader, token_out);
+
+    case STATE_VALUE_OR_END:
+        if (skip_space(reader) == 0)
+        {
+            return fail(reader, COM_UTIL_ERR_INVALID_ARGUMENT);
+        }
+        if (reader->text[reader->position] == ']')
+        {
+            return close_container(reader, token_out);
+        }
+        return read_value(reader, token_out);
+
+    case STATE_KEY_OR_END:
+        if (skip_space(reader) == 0)
+        {
+            return fail(reader, COM_UTIL_ERR_INVALID_ARGUMENT);
+        }
+        if (reader->text[reader->position] == '}')
+        {
+            return close_container(reader, token_out);
+        }
+        return read_key(reader, token_out);
+
+    case STATE_KEY:
+        return read_key(reader, token_out);
+
+    case STATE_COLON:
+        if ((skip_space(reader) == 0) || (reader->text[reader->position] != ':'))
+        {
+            return fail(reader, COM_UTIL_ERR_INVALID_ARGUMENT);
+        }
+        reader->position++;
+        return read_value(reader, token_out);
+
+    case STATE_AFTER_VALUE:
+        if (reader->depth == 0U)
+        {
+            /* cJSON_Parse() と同じく、最上位の値の後ろは読まない。 */
+            reader->state = STATE_DONE;
+            *token_out = STRUCT_META_JSON_TOKEN_END;
+            return COM_UTIL_OK;
+        }
+        if (skip_space(reader) == 0)
+        {
+            return fail(reader, COM_UTIL_ERR_INVALID_ARGUMENT);
+        }
+        if (reader->text[reader->position] != ',')
+        {
+            return close_container(reader, token_out);
+        }
+        reader->position++;
+        if (top_is_object(reader) != 0)
+        {
+            return read_key(reader, token_out);
+        }
+        return read_value(reader, token_out);
+
+    case STATE_DONE:
+        *token_out = STRUCT_META_JSON_TOKEN_END;
+        return COM_UTIL_OK;
+
+    default:
+        return fail(reader, COM_UTIL_ERR_INVALID_ARGUMENT);
+    }
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_reader_skip(struct_meta_json_reader *reader, struct_meta_json_token token)
+{
+    if (reader == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if ((token != STRUCT_META_JSON_TOKEN_BEGIN_OBJECT) && (token != STRUCT_META_JSON_TOKEN_BEGIN_ARRAY))
+    {
+        return reader->result;
+    }
+    if (reader->depth == 0U)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    size_t target = reader->depth - 1U;
+    while (reader->depth > target)
+    {
+        struct_meta_json_token ignored;
+        int ret = struct_meta_json_reader_next(reader, &ignored);
+        if (ret != COM_UTIL_OK)
+        {
+            return ret;
+        }
+    }
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_reader_chars(const struct_meta_json_reader *reader, struct_meta_json_token token, char *buffer,
+                                  size_t capacity)
+{
+    if ((reader == NULL) || (token != STRUCT_META_JSON_TOKEN_STRING))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    /* cJSON の文字列は NUL 終端のため、\u0000 以降は値に含まれない。 */
+    size_t text_len = reader->string_length;
+    const char *nul = (const char *)memchr(reader->string, '\0', text_len);
+    if (nul != NULL)
+    {
+        text_len = (size_t)(nul - reader->string);
+    }
+    if ((buffer == NULL) || (capacity == 0U) || (text_len >= capacity))
+    {
+        return COM_UTIL_ERR_BUFFER_TOO_SMALL;
+    }
+    memcpy(buffer, reader->string, text_len);
+    buffer[text_len] = '\0';
+    return COM_UTIL_OK;
+}
+
+/**
+ *  @brief          直前の数値の符号と絶対値を、double を経由せずに求めます。
+ */
+static int number_integer(const struct_meta_json_reader *reader, struct_meta_json_token token,
+                          uint64_t *magnitude_out)
+{
+    if ((reader == NULL) || (token != STRUCT_META_JSON_TOKEN_NUMBER))
+    {
+        return 0;
+    }
+    if (reader->integer_sign != 0)
+    {
+        *magnitude_out = reader->integer;
+        return reader->integer_sign;
+    }
+    /* 小数点や指数を含む数値は、double が正確に表せる整数の場合だけ受け付ける。 */
+    return struct_meta_internal_integer_from_double(reader->number, magnitude_out);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_reader_int64(const struct_meta_json_reader *reader, struct_meta_json_token token,
+                                  int64_t minimum, int64_t maximum, int64_t *value_out)
+{
+    uint64_t magnitude = 0U;
+    int sign = number_integer(reader, token, &magnitude);
+    int64_t value;
+    if ((sign == 0) || (value_out == NULL) ||
+        (struct_meta_internal_signed_from_magnitude(sign, magnitude, &value) != COM_UTIL_OK) || (value < minimum) ||
+        (value > maximum))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    *value_out = value;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_reader_uint64(const struct_meta_json_reader *reader, struct_meta_json_token token,
+                                   uint64_t maximum, uint64_t *value_out)
+{
+    uint64_t magnitude = 0U;
+    int sign = number_integer(reader, token, &magnitude);
+    /* -0 は 0 として受け付ける。 */
+    if ((sign == 0) || ((sign < 0) && (magnitude != 0U)) || (magnitude > maximum) || (value_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    *value_out = magnitude;
+    return COM_UTIL_OK;
+}
+
+static int read_object(struct_meta_json_reader *reader, const struct_meta_descriptor *desc,
+                       const struct_meta_internal_name_index *names, unsigned char *base);
+
+/**
+ *  @brief          直前に読み取ったトークン 1 個分をスカラー値としてメモリーへ書き込みます。
+ */
+static int read_scalar(const struct_meta_json_reader *reader, const struct_meta_field *field,
+                       struct_meta_json_token token, unsigned char *field_ptr)
+{
+    switch (field->kind)
+    {
+    case STRUCT_META_FIELD_INT:
+        if ((field->element_size != sizeof(int)) || (token != STRUCT_META_JSON_TOKEN_NUMBER))
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        {
+            int value = (int)reader->number;
+            memcpy(field_ptr, &value, sizeof(value));
+        }
+        break;
+
+    case STRUCT_META_FIELD_UNSIGNED:
+        if ((field->element_size != sizeof(unsigned int)) || (token != STRUCT_META_JSON_TOKEN_NUMBER) ||
+            (reader->number < 0.0))
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        {
+            unsigned int value = (unsigned int)reader->number;
+            memcpy(field_ptr, &value, sizeof(value));
+        }
+        break;
+
+    case STRUCT_META_FIELD_FLOAT:
+        if ((field->element_size != sizeof(float)) || (token != STRUCT_META_JSON_TOKEN_NUMBER))
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        {
+            float value = (float)reader->number;
+            memcpy(field_ptr, &value, sizeof(value));
+        }
+        break;
+
+    case STRUCT_META_FIELD_DOUBLE:
+        if ((field->element_size != sizeof(double)) || (token != STRUCT_META_JSON_TOKEN_NUMBER))
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        memcpy(field_ptr, &reader->number, sizeof(reader->number));
+        break;
+
+    case STRUCT_META_FIELD_INT8:
+    case STRUCT_META_FIELD_INT16:
+    case STRUCT_META_FIELD_INT64:
+    case STRUCT_META_FIELD_UINT8:
+    case STRUCT_META_FIELD_UINT16:
+    case STRUCT_META_FIELD_UINT64:
+    case STRUCT_META_FIELD_ENUM:
+    {
+        uint64_t magnitude = 0U;
+        int sign = number_integer(reader, token, &magnitude);
+        if ((sign == 0) || (struct_meta_internal_store_integer(field->kind, field_ptr, field->element_size, sign,
+                                                               magnitude) != COM_UTIL_OK))
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        break;
+    }
+
+    case STRUCT_META_FIELD_BOOL:
+        if ((token != STRUCT_META_JSON_TOKEN_TRUE) && (token != STRUCT_META_JSON_TOKEN_FALSE))
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        return struct_meta_internal_store_bool(field_ptr, (token == STRUCT_META_JSON_TOKEN_TRUE) ? 1U : 0U);
+
+    case STRUCT_META_FIELD_CHAR_ARRAY:
+        return struct_meta_json_reader_chars(reader, token, (char *)field_ptr, field->char_buffer_size);
+
+    case STRUCT_META_FIELD_STRUCT:
+    case STRUCT_META_FIELD_STRING:
+    default:
+        /* 構造体と文字列は read_element() が先に振り分けるため、ここには到達しない。 */
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    return COM_UTIL_OK;
+}
+
+/**
+ *  @brief          直前に読み取った文字列値を、長さちょうどの領域へ複写して char * として書き込みます。
+ *
+ *  null は NULL として書き込みます。新しい領域を確保できた後に限り、書き込む前の領域を解放します。
+ *  取り消しログへ記録している間は、書き込む前の領域をログの確定まで解放しません。
+ */
+static int read_string(const struct_meta_json_reader *reader, struct_meta_json_token token, unsigned char *slot)
+{
+    char *text = NULL;
+    if (token != STRUCT_META_JSON_TOKEN_NULL)
+    {
+        if (token != STRUCT_META_JSON_TOKEN_STRING)
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        /* cJSON の文字列は NUL 終端のため、\u0000 以降は値に含まれない。 */
+        size_t length = reader->string_length;
+        const char *nul = (const char *)memchr(reader->string, '\0', length);
+        if (nul != NULL)
+        {
+            length = (size_t)(nul - reader->string);
+        }
+        text = (char *)struct_meta_internal_allocate(reader->allocator, length + 1U);
+        if (text == NULL)
+        {
+            return COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+        memcpy(text, reader->string, length);
+        text[length] = '\0';
+    }
+
+    if (reader->undo == NULL)
+    {
+        char *previous = NULL;
+        memcpy((void *)&previous, slot, sizeof(previous));
+        struct_meta_internal_release(reader->allocator, previous);
+    }
+    memcpy(slot, (const void *)&text, sizeof(text));
+    return COM_UTIL_OK;
+}
+
+/**
+ *  @brief          値 1 個分 (配列要素、またはネスト構造体 1 個) をメモリーへ書き込みます。
+ */
+static int read_element(struct_meta_json_reader *reader, const struct_meta_field *field, struct_meta_json_token token,
+                        unsigned char *elem_ptr)
+{
+    if (field->kind == STRUCT_META_FIELD_STRUCT)
+    {
+        if (token != STRUCT_META_JSON_TOKEN_BEGIN_OBJECT)
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        return read_object(reader, field->nested, struct_meta_internal_json_names(field->nested), elem_ptr);
+    }
+    if (field->kind == STRUCT_META_FIELD_STRING)
+    {
+        return read_string(reader, token, elem_ptr);
+    }
+    return read_scalar(reader, field, token, elem_ptr);
+}
+
+/**
+ *  @brief          可変長配列の要素を、@p count 個分の大きさの新しい領域へ移します。
+ *
+ *  新しい領域の残りは 0 で埋め、確保できた後に限り元の領域を解放して @p sequence の items を置き換えます。
+ */
+static int resize_sequence(const struct_meta_json_reader *reader, const struct_meta_field *field,
+                         struct_meta_sequence *sequence, size_t count)
+{
+    if (count > (SIZE_MAX / field->element_size))
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    unsigned char *items =
+        (unsigned char *)struct_meta_internal_allocate(reader->allocator, count * field->element_size);
+    if (items == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    memset(items, 0, count * field->element_size);
+    if (sequence->count > 0U)
+    {
+        memcpy(items, sequence->items, sequence->count * field->element_size);
+    }
+    struct_meta_internal_release(reader->allocator, sequence->items);
+    sequence->items = items;
+    return COM_UTIL_OK;
+}
+
+/**
+ *  @brief          JSON 配列を可変長配列として書き込みます。
+ *
+ *  要素数は配列を読み終えるまで分からないため、領域を倍々に広げながら読み込みます。
+ *  null と空の配列は要素数 0 として書き込みます。
+ *  読み込んだ要素は要素数に含めてから書き込むため、途中でエラーになっても、
+ *  書き込んだ内容は struct_meta_instance_release() で解放できます。
+ */
+static int read_sequence(struct_meta_json_reader *reader, const struct_meta_field *field,
+                         struct_meta_json_token token, unsigned char *base)
+{
+    if ((token != STRUCT_META_JSON_TOKEN_NULL) && (token != STRUCT_META_JSON_TOKEN_BEGIN_ARRAY))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    struct_meta_sequence *sequence = struct_meta_internal_sequence_of(field, base);
+    if (reader->undo == NULL)
+    {
+        struct_meta_internal_release_field(field, base, reader->allocator);
+    }
+    sequence->items = NULL;
+    sequence->count = 0U;
+    if (token == STRUCT_META_JSON_TOKEN_NULL)
+    {
+        return COM_UTIL_OK;
+    }
+
+    /* 要素は新しく確保した領域にあり、取り消す場合は領域ごと解放するため、要素の中は記録しない。 */
+    struct_meta_buffer *undo = reader->undo;
+    reader->undo = NULL;
+    size_t capacity = 0U;
+    int ret;
+    for (;;)
+    {
+        ret = struct_meta_json_reader_next(reader, &token);
+        if ((ret != COM_UTIL_OK) || (token == STRUCT_META_JSON_TOKEN_END_ARRAY))
+        {
+            break;
+        }
+        if (sequence->count == capacity)
+        {
+            capacity = (capacity == 0U) ? 4U : (capacity * 2U);
+            ret = resize_sequence(reader, field, sequence, capacity);
+            if (ret != COM_UTIL_OK)
+            {
+                break;
+            }
+        }
+        sequence->count++;
+        ret = read_element(reader, field, token,
+                           (unsigned char *)sequence->items + ((sequence->count - 1U) * field->element_size));
+        if (ret != COM_UTIL_OK)
+        {
+            break;
+        }
+    }
+    if ((ret == COM_UTIL_OK) && (sequence->count < capacity))
+    {
+        /* struct_meta_json_decode_alloc() と同じく要素数ちょうどの領域へ移す。確保できなければ広い領域のまま使う。 */
+        (void)resize_sequence(reader, field, sequence, sequence->count);
+    }
+    reader->undo = undo;
+    return ret;
+}
+
+/**
+ *  @brief          フィールド 1 個分 (スカラー、char 配列、文字列、固定長配列、可変長配列) の値を読み込みます。
+ */
+static int read_field(struct_meta_json_reader *reader, const struct_meta_field *field, struct_meta_json_token token,
+                      unsigned char *base)
+{
+    void *element;
+    int ret;
+    if (struct_meta_internal_field_is_dynamic(field) != 0)
+    {
+        ret = struct_meta_internal_undo_record_dynamic(reader->undo, field, base, reader->allocator);
+    }
+    else
+    {
+        ret = struct_meta_internal_undo_record(reader->undo, field, base);
+    }
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    if (field->storage == STRUCT_META_STORAGE_SEQUENCE)
+    {
+        return read_sequence(reader, field, token, base);
+    }
+
+    if ((field->kind == STRUCT_META_FIELD_CHAR_ARRAY) || (field->element_count <= 1U))
+    {
+        ret = struct_meta_field_get_element(field, base, 0U, &element);
+        if (ret != COM_UTIL_OK)
+        {
+            return ret;
+        }
+        return read_element(reader, field, token, (unsigned char *)element);
+    }
+
+    if (token != STRUCT_META_JSON_TOKEN_BEGIN_ARRAY)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    /* 要素数は struct_meta_json_decode() と同じく、固定長配列の長さと一致しなければならない。 */
+    for (size_t i = 0; i < field->element_count; i++)
+    {
+        ret = struct_meta_json_reader_next(reader, &token);
+        if (ret != COM_UTIL_OK)
+        {
+            return ret;
+        }
+        if (token == STRUCT_META_JSON_TOKEN_END_ARRAY)
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        ret = struct_meta_field_get_element(field, base, i, &element);
+        if (ret == COM_UTIL_OK)
+        {
+            ret = read_element(reader, field, token, (unsigned char *)element);
+        }
+        if (ret != COM_UTIL_OK)
+        {
+            return ret;
+        }
+    }
+    ret = struct_meta_json_reader_next(reader, &token);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    if (token != STRUCT_META_JSON_TOKEN_END_ARRAY)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    return COM_UTIL_OK;
+}
+
+/**
+ *  @brief          JSON に現れなかったフィールドに `json.required` がないことを確認します。
+ */
+static int check_required(const struct_meta_descriptor *desc, const struct_meta_internal_name_index *names,
+                          const unsigned char *seen)
+{
+    for (size_t i = 0; i < desc->field_count; i++)
+    {
+        if ((seen[i / 8U] & (1U << (i % 8U))) != 0U)
+        {
+            continue;
+        }
+        const struct_meta_field *field = &desc->fields[i];
+        const struct_meta_attribute *attribute = NULL;
+        if ((struct_meta_internal_json_field_key(names, desc, i) != NULL) &&
+            (struct_meta_field_find_attribute(field, "json.required", &attribute) == COM_UTIL_OK))
+        {
+            return COM_UTIL_ERR_MISSING_REQUIRED;
+        }
+    }
+    return COM_UTIL_OK;
+}
+
+/**
+ *  @brief          '{' の後からオブジェクト 1 個分を構造体インスタンスへ読み込みます。
+ *
+ *  cJSON_GetObjectItemCaseSensitive() と同じく、同じキーが複数ある場合は先頭の値を使います。
+ */
+static int read_object(struct_meta_json_reader *reader, const struct_meta_descriptor *desc,
+                       const struct_meta_internal_name_index *names, unsigned char *base)
+{
+    unsigned char seen_local[SEEN_LOCAL_FIELDS / 8U];
+    unsigned char *seen = seen_local;
+    size_t seen_size = (desc->field_count + 7U) / 8U;
+    if (seen_size > sizeof(seen_local))
+    {
+        /* アリーナの領域は読み取り状態の使用後にまとめて手放すため、ここでは解放しない。 */
+        if (reader->arena != NULL)
+        {
+            seen = (unsigned char *)struct_meta_arena_alloc(reader->arena, seen_size);
+        }
+        else
+        {
+            seen = (unsigned char *)malloc(seen_size);
+        }
+        if (seen == NULL)
+        {
+            return COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+    }
+    memset(seen, 0, seen_size);
+
+    int ret;
+    struct_meta_json_token token;
+    for (;;)
+    {
+        ret = struct_meta_json_reader_next(reader, &token);
+        if ((ret != COM_UTIL_OK) || (token == STRUCT_META_JSON_TOKEN_END_OBJECT))
+        {
+            break;
+        }
+
+        const struct_meta_field *field = struct_meta_internal_name_index_find(
+            names, desc, struct_meta_internal_json_key, reader->string, reader->string_length);
+        ret = struct_meta_json_reader_next(reader, &token);
+        if (ret != COM_UTIL_OK)
+        {
+            break;
+        }
+        size_t field_index = 0U;
+        if (field != NULL)
+        {
+            field_index = (size_t)(field - desc->fields);
+        }
+        if ((field == NULL) || ((seen[field_index / 8U] & (1U << (field_index % 8U))) != 0U))
+        {
+            ret = struct_meta_json_reader_skip(reader, token);
+        }
+        else
+        {
+            seen[field_index / 8U] |= (unsigned char)(1U << (field_index % 8U));
+            ret = read_field(reader, field, token, base);
+        }
+        if (ret != COM_UTIL_OK)
+        {
+            break;
+        }
+    }
+
+    if (ret == COM_UTIL_OK)
+    {
+        ret = check_required(desc, names, seen);
+    }
+    if ((seen != seen_local) && (reader->arena == NULL))
+    {
+        free(seen);
+    }
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_reader_value(struct_meta_json_reader *reader, const struct_meta_descriptor *descriptor,
+                                  void *instance)
+{
+    if ((reader == NULL) || (descriptor == NULL) || (instance == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    struct_meta_json_token token;
+    ret = struct_meta_json_reader_next(reader, &token);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    if (token != STRUCT_META_JSON_TOKEN_BEGIN_OBJECT)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    return read_object(reader, descriptor, struct_meta_internal_json_names(descriptor), (unsigned char *)instance);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_decode_text(const struct_meta_descriptor *descriptor, const char *text, size_t length,
+                                 void *instance)
+{
+    struct_meta_json_reader reader;
+
+    int ret = struct_meta_json_reader_init_text(&reader, text, length);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    ret = struct_meta_json_reader_value(&reader, descriptor, instance);
+    struct_meta_json_reader_dispose(&reader);
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_decode_text_arena(const struct_meta_descriptor *descriptor, const char *text, size_t length,
+                                       void *instance, struct_meta_arena *arena)
+{
+    if (arena == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    struct_meta_json_reader reader;
+    int ret = struct_meta_json_reader_init_text(&reader, text, length);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    struct_meta_arena_mark mark = struct_meta_arena_save(arena);
+    (void)struct_meta_json_reader_use_arena(&reader, arena);
+    ret = struct_meta_json_reader_value(&reader, descriptor, instance);
+    struct_meta_json_reader_dispose(&reader);
+    struct_meta_arena_rewind(arena, mark);
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_decode_text_atomic(const struct_meta_descriptor *descriptor, const char *text, size_t length,
+                                        void *instance, struct_meta_buffer *undo)
+{
+    struct_meta_json_reader reader;
+
+    int ret = struct_meta_json_reader_init_text(&reader, text, length);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    struct_meta_buffer local;
+    struct_meta_buffer_init(&local);
+    reader.undo = &local;
+    if (undo != NULL)
+    {
+        reader.undo = undo;
+    }
+    struct_meta_buffer_reset(reader.undo);
+    ret = struct_meta_json_reader_value(&reader, descriptor, instance);
+    if (ret == COM_UTIL_OK)
+    {
+        struct_meta_internal_undo_commit(reader.undo);
+    }
+    else
+    {
+        struct_meta_internal_undo_rollback(reader.undo);
+    }
+    struct_meta_buffer_dispose(&local);
+    struct_meta_json_reader_dispose(&reader);
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_decode_text_swap(const struct_meta_descriptor *descriptor, const char *text, size_t length,
+                                      void **current, void **shadow)
+{
+    if ((descriptor == NULL) || (current == NULL) || (shadow == NULL) || (*current == NULL) || (*shadow == NULL) ||
+        (*current == *shadow))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    /* 複写の前に、記述子の size を信頼できることを確かめる。 */
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    if (struct_meta_internal_descriptor_has_dynamic(descriptor) != 0)
+    {
+        /* 複写した文字列と可変長配列を読み込みで解放すると、公開中のインスタンスの値も失われる。 */
+        return COM_UTIL_ERR_UNSUPPORTED;
+    }
+    memcpy(*shadow, struct_meta_internal_atomic_load_ptr(current), descriptor->size);
+    ret = struct_meta_json_decode_text(descriptor, text, length, *shadow);
+    if (ret == COM_UTIL_OK)
+    {
+        *shadow = struct_meta_internal_atomic_exchange_ptr(current, *shadow);
+    }
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_reader_array(struct_meta_json_reader *reader, const struct_meta_descriptor *descriptor,
+                                  void *base, size_t capacity, size_t stride, size_t *count_out)
+{
+    if ((reader == NULL) || (count_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    *count_out = 0U;
+    int ret = struct_meta_internal_array_stride(descriptor, base, capacity, stride, &stride);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    if (struct_meta_internal_descriptor_has_dynamic(descriptor) != 0)
+    {
+        /* 読み込み先は書き込み専用の領域のため、書き込む前の文字列と可変長配列を解放できない。 */
+        return COM_UTIL_ERR_UNSUPPORTED;
+    }
+
+    /* 検査と JSON キー索引の取得は配列全体で 1 回だけ行う。 */
+    const struct_meta_internal_name_index *names = struct_meta_internal_json_names(descriptor);
+    struct_meta_json_token token;
+    ret = struct_meta_json_reader_next(reader, &token);
+    if ((ret == COM_UTIL_OK) && (token != STRUCT_META_JSON_TOKEN_BEGIN_ARRAY))
+    {
+        ret = COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    for (size_t i = 0; ret == COM_UTIL_OK; i++)
+    {
+        ret = struct_meta_json_reader_next(reader, &token);
+        if ((ret != COM_UTIL_OK) || (token == STRUCT_META_JSON_TOKEN_END_ARRAY))
+        {
+            break;
+        }
+        if (i >= capacity)
+        {
+            ret = COM_UTIL_ERR_BUFFER_TOO_SMALL;
+        }
+        else if (token != STRUCT_META_JSON_TOKEN_BEGIN_OBJECT)
+        {
+            ret = COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        else
+        {
+            ret = read_object(reader, descriptor, names, (unsigned char *)base + (i * stride));
+        }
+        if (ret == COM_UTIL_OK)
+        {
+            *count_out = i + 1U;
+        }
+    }
+    return ret;
+}
+
+/** 並行読み込みで、タスク間で共有する情報です。 */
+typedef struct array_decode_job
+{
+    const struct_meta_descriptor *descriptor;
+    const struct_meta_internal_name_index *names;
+    const unsigned char *text;
+    const size_t *bounds; /* 要素 i は bounds[i] から bounds[i + 1] - 1 (区切り文字の手前) までです。 */
+    unsigned char *base;
+    size_t stride;
+    size_t count;
+    size_t task_count;
+    size_t *failed_index; /* タスクごとの最初に失敗した要素です。失敗がなければ count です。 */
+    int *results;         /* タスクごとの最初のエラーです。 */
+} array_decode_job;
+
+/**
+ *  @brief          区切られた要素 1 個分のテキストを読み込みます。値の後ろには空白だけを許します。
+ */
+static int decode_element(const array_decode_job *job, size_t index)
+{
+    struct_meta_json_reader reader;
+    size_t begin = job->bounds[index];
+    size_t length = job->bounds[index + 1U] - 1U - begin;
+
+    reader_init(&reader, job->text + begin, length, NULL);
+    reader.state = STATE_VALUE;
+    struct_meta_json_token token;
+    int ret = struct_meta_json_reader_next(&reader, &token);
+    if ((ret == COM_UTIL_OK) && (token != STRUCT_META_JSON_TOKEN_BEGIN_OBJECT))
+    {
+        ret = COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = read_object(&reader, job->descriptor, job->names, job->base + (index * job->stride));
+    }
+    if ((ret == COM_UTIL_OK) && (skip_space(&reader) != 0))
+    {
+        ret = COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    struct_meta_json_reader_dispose(&reader);
+    return ret;
+}
+
+static void decode_task(void *context, size_t task_index)
+{
+    const array_decode_job *job = (const array_decode_job *)context;
+    size_t begin = (job->count * task_index) / job->task_count;
+    size_t end = (job->count * (task_index + 1U)) / job->task_count;
+
+    job->failed_index[task_index] = job->count;
+    job->results[task_index] = COM_UTIL_OK;
+    for (size_t i = begin; i < end; i++)
+    {
+        int ret = decode_element(job, i);
+        if (ret != COM_UTIL_OK)
+        {
+            job->failed_index[task_index] = i;
+            job->results[task_index] = ret;
+            return;
+        }
+    }
+}
+
+/**
+ *  @brief          配列の '[' の後から対応する ']' までを走査し、最上位の区切り文字の位置を集めます。
+ *
+ *  文字列とエスケープ、入れ子の深さだけを追います。値の構文は各要素の読み込みで検査します。
+ *  bounds には各要素の先頭と、末尾の要素の区切り文字 (']') の次の位置を格納します。
+ */
+static int split_elements(const unsigned char *text, size_t length, size_t position, struct_meta_buffer *bounds,
+                          size_t *count_out)
+{
+    size_t depth = 0U;
+    size_t count = 0U;
+    int in_string = 0;
+    int has_content = 0;
+
+    int ret = struct_meta_buffer_append(bounds, &position, sizeof(position));
+    for (size_t i = position; (i < length) && (ret == COM_UTIL_OK); i++)
+    {
+        unsigned char c = text[i];
+        if (in_string != 0)
+        {
+            if (c == '\\')
+            {
+                i++;
+            }
+            else if (c == '"')
+            {
+                in_string = 0;
+            }
+            continue;
+        }
+        if (c <= 32U)
+        {
+            continue;
+        }
+        if ((depth == 0U) && (c == ']'))
+        {
+            /* "[ ]" は要素を持たない。"[ , ]" などの空の要素は、要素の読み込みで構文エラーになる。 */
+            if ((count > 0U) || (has_content != 0))
+            {
+                size_t end = i + 1U;
+                ret = struct_meta_buffer_append(bounds, &end, sizeof(end));
+                count++;
+            }
+            *count_out = count;
+            return ret;
+        }
+
+        has_content = 1;
+        if (c == '"')
+        {
+            in_string = 1;
+        }
+        else if ((c == '{') || (c == '['))
+        {
+            depth++;
+        }
+        else if (((c == '}') || (c == ']')) && (depth > 0U))
+        {
+            depth--;
+        }
+        else if ((depth == 0U) && (c == ','))
+        {
+            size_t next = i + 1U;
+            ret = struct_meta_buffer_append(bounds, &next, sizeof(next));
+            count++;
+        }
+    }
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    return COM_UTIL_ERR_INVALID_ARGUMENT;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_decode_text_array(const struct_meta_descriptor *descriptor, const char *text, size_t length,
+                                       void *base, size_t capacity, size_t stride, size_t thread_count,
+                                       size_t *count_out)
+{
+    struct_meta_json_reader reader;
+
+    int ret = struct_meta_json_reader_init_text(&reader, text, length);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    /* 使えるスレッドが 1 つだけの場合は、境界の事前走査を省いて逐次に読み込む。 */
+    if (struct_meta_internal_parallel_tasks(thread_count, SIZE_MAX) == 1U)
+    {
+        ret = struct_meta_json_reader_array(&reader, descriptor, base, capacity, stride, count_out);
+        struct_meta_json_reader_dispose(&reader);
+        return ret;
+    }
+
+    if (count_out == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    *count_out = 0U;
+    ret = struct_meta_internal_array_stride(descriptor, base, capacity, stride, &stride);
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    }
+    if ((ret == COM_UTIL_OK) && (struct_meta_internal_descriptor_has_dynamic(descriptor) != 0))
+    {
+        ret = COM_UTIL_ERR_UNSUPPORTED;
+    }
+    struct_meta_json_token token;
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_json_reader_next(&reader, &token);
+    }
+    if ((ret == COM_UTIL_OK) && (token != STRUCT_META_JSON_TOKEN_BEGIN_ARRAY))
+    {
+        ret = COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    size_t position = reader.position;
+    struct_meta_json_reader_dispose(&reader);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+
+    /* 要素の境界を先に求め、要素を連続した範囲ごとにタスクへ割り振る。 */
+    struct_meta_buffer bounds;
+    size_t count = 0U;
+    struct_meta_buffer_init(&bounds);
+    ret = split_elements((const unsigned char *)text, length, position, &bounds, &count);
+    if ((ret == COM_UTIL_OK) && (count > capacity))
+    {
+        ret = COM_UTIL_ERR_BUFFER_TOO_SMALL;
+    }
+    if ((ret != COM_UTIL_OK) || (count == 0U))
+    {
+        struct_meta_buffer_dispose(&bounds);
+        return ret;
+    }
+
+    size_t failed_index[STRUCT_META_PARALLEL_MAX_THREADS];
+    int results[STRUCT_META_PARALLEL_MAX_THREADS];
+    array_decode_job job;
+    job.descriptor = descriptor;
+    job.names = struct_meta_internal_json_names(descriptor);
+    job.text = (const unsigned char *)text;
+    job.bounds = (const size_t *)(const void *)bounds.data;
+    job.base = (unsigned char *)base;
+    job.stride = stride;
+    job.count = count;
+    job.task_count = struct_meta_internal_parallel_tasks(thread_count, count);
+    job.failed_index = failed_index;
+    job.results = results;
+    struct_meta_internal_parallel_run(job.task_count, decode_task, &job);
+
+    /* 要素の順で最初のエラーを返す。タスクは添字の昇順に連続した範囲を受け持つ。 */
+    *count_out = count;
+    for (size_t t = 0; t < job.task_count; t++)
+    {
+        if (results[t] != COM_UTIL_OK)
+        {
+            *count_out = failed_index[t];
+            ret = results[t];
+            break;
+        }
+    }
+    struct_meta_buffer_dispose(&bounds);
+    return ret;
+}
@@ -0,0 +1,185 @@
+/**
+ *******************************************************************************
+ *  @file           undo.c
+ *  @brief          JSON デコードの取り消しログを実装します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/json/undo.h>
+
+#include <struct_meta/memory/dynamic.h>
+
+#include <com_util/base/result.h>
+
+#include <string.h>
+
+/** 記録 1 件の見出しです。ログ上では上書き前のバイト列の直後に置きます。 */
+typedef struct undo_header
+{
+    unsigned char *address;                 /**< 書き戻し先です。 */
+    size_t length;                          /**< バイト数です。 */
+    const struct_meta_field *field;         /**< 動的フィールドの場合はそのフィールド、その他は NULL です。 */
+    const struct_meta_allocator *allocator; /**< 動的フィールドの領域のアロケーターです。 */
+} undo_header;
+
+/**
+ *  @brief          書き戻し先の現在の内容と見出しをログへ追記します。
+ */
+static int append(struct_meta_buffer *log, const undo_header *header)
+{
+    int ret = struct_meta_buffer_reserve(log, header->length + sizeof(*header));
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    (void)struct_meta_buffer_append(log, header->address, header->length);
+    (void)struct_meta_buffer_append(log, header, sizeof(*header));
+    return COM_UTIL_OK;
+}
+
+/**
+ *  @brief          文字列の並びのうち、@p kept と異なるポインターの領域を解放します。
+ */
+static void release_changed_strings(const undo_header *header, const unsigned char *released,
+                                    const unsigned char *kept)
+{
+    for (size_t offset = 0U; offset < header->length; offset += header->field->element_size)
+    {
+        char *text = NULL;
+        char *other = NULL;
+        memcpy((void *)&text, released + offset, sizeof(text));
+        memcpy((void *)&other, kept + offset, sizeof(other));
+        if (text != other)
+        {
+            struct_meta_internal_release(header->allocator, text);
+        }
+    }
+}
+
+/**
+ *  @brief          可変長配列の items が上書き前と異なるかを返します。
+ *
+ *  可変長配列は置き換えた時点で新しい領域になるため、items が異なれば要素を含めて全体が新しい値です。
+ */
+static int sequence_replaced(const undo_header *header, const unsigned char *previous)
+{
+    struct_meta_sequence current;
+    struct_meta_sequence replaced;
+    memcpy(&current, header->address, sizeof(current));
+    memcpy(&replaced, previous, sizeof(replaced));
+    return current.items != replaced.items;
+}
+
+/**
+ *  @brief          書き戻し先にある可変長配列を、要素の中の動的フィールドも含めて解放します。
+ */
+static void release_sequence(const undo_header *header)
+{
+    struct_meta_internal_release_field(header->field, header->address - header->field->offset, header->allocator);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_internal_undo_record(struct_meta_buffer *log, const struct_meta_field *field,
+                                     unsigned char *base)
+{
+    if ((log == NULL) || (field->kind == STRUCT_META_FIELD_STRUCT))
+    {
+        return COM_UTIL_OK;
+    }
+
+    undo_header header;
+    header.address = base + field->offset;
+    header.length = field->element_size * field->element_count;
+    if (field->kind == STRUCT_META_FIELD_CHAR_ARRAY)
+    {
+        header.length = field->char_buffer_size;
+    }
+    header.field = NULL;
+    header.allocator = NULL;
+    return append(log, &header);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_internal_undo_record_dynamic(struct_meta_buffer *log, const struct_meta_field *field,
+                                             unsigned char *base, const struct_meta_allocator *allocator)
+{
+    if (log == NULL)
+    {
+        return COM_UTIL_OK;
+    }
+
+    undo_header header;
+    header.address = base + field->offset;
+    header.length = field->element_size * field->element_count;
+    if (field->storage == STRUCT_META_STORAGE_SEQUENCE)
+    {
+        header.length = sizeof(struct_meta_sequence);
+    }
+    header.field = field;
+    header.allocator = allocator;
+    return append(log, &header);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_internal_undo_rollback(struct_meta_buffer *log)
+{
+    size_t end = log->length;
+    while (end >= sizeof(undo_header))
+    {
+        undo_header header;
+        memcpy(&header, log->data + end - sizeof(header), sizeof(header));
+        end -= sizeof(header) + header.length;
+        const unsigned char *previous = log->data + end;
+        if ((header.field != NULL) && (header.field->storage == STRUCT_META_STORAGE_SEQUENCE))
+        {
+            if (sequence_replaced(&header, previous))
+            {
+                release_sequence(&header);
+            }
+        }
+        else if (header.field != NULL)
+        {
+            release_changed_strings(&header, header.address, previous);
+        }
+        memcpy(header.address, previous, header.length);
+    }
+    struct_meta_buffer_reset(log);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_internal_undo_commit(struct_meta_buffer *log)
+{
+    size_t end = log->length;
+    while (end >= sizeof(undo_header))
+    {
+        undo_header header;
+        memcpy(&header, log->data + end - sizeof(header), sizeof(header));
+        end -= sizeof(header) + header.length;
+        const unsigned char *previous = log->data + end;
+        if (header.field == NULL)
+        {
+            continue;
+        }
+        if (header.field->storage != STRUCT_META_STORAGE_SEQUENCE)
+        {
+            release_changed_strings(&header, previous, header.address);
+        }
+        else if (sequence_replaced(&header, previous))
+        {
+            /* 置き換えた可変長配列をフィールドの位置へ一時的に戻して解放し、新しい値を戻す。 */
+            struct_meta_sequence current;
+            memcpy(&current, header.address, sizeof(current));
+            memcpy(header.address, previous, sizeof(current));
+            release_sequence(&header);
+            memcpy(header.address, &current, sizeof(current));
+        }
+    }
+    struct_meta_buffer_reset(log);
+}
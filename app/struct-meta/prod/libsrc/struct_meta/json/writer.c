@@ -0,0 +1,994 @@
+/**
+ *******************************************************************************
+ *  @file           writer.c
+ *  @brief          cJSON のオブジェクトを作らずに、構造体を JSON テキストへ直接書き出します。
+ *
+ *  区切り文字、インデント、数値と文字列の書式は cJSON 1.7 系の print_object()、print_array()、
+ *  print_number()、print_string_ptr() と同じ規則で出力します。\n
+ *  整形時の深さはオブジェクトと配列の両方で 1 段ずつ増え、オブジェクトのメンバーだけがタブでインデントされます。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/json/writer.h>
+
+#include <struct_meta/access/access.h>
+#include <struct_meta/base/array.h>
+#include <struct_meta/base/parallel.h>
+#include <struct_meta/json/key.h>
+#include <struct_meta/meta/registry.h>
+#include <struct_meta/meta/scalar.h>
+
+#include <com_util/base/result.h>
+#include <com_util/crt/stdio.h>
+
+#include <float.h>
+#include <limits.h>
+#include <locale.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* cJSON の number_buffer と同じ大きさ。%1.17g の最大長を収める。 */
+#define NUMBER_BUFFER_SIZE 26U
+
+static int emit(struct_meta_json_writer *writer, const void *data, size_t length)
+{
+    if (writer->result != COM_UTIL_OK)
+    {
+        return writer->result;
+    }
+    if (writer->buffer != NULL)
+    {
+        writer->result = struct_meta_buffer_append(writer->buffer, data, length);
+        return writer->result;
+    }
+
+    if (length > (STRUCT_META_JSON_WRITER_CHUNK_SIZE - writer->chunk_length))
+    {
+        if (struct_meta_json_writer_flush(writer) != COM_UTIL_OK)
+        {
+            return writer->result;
+        }
+        if (length >= STRUCT_META_JSON_WRITER_CHUNK_SIZE)
+        {
+            if (com_util_fwrite(data, 1U, length, writer->stream, NULL) != length)
+            {
+                writer->result = COM_UTIL_ERR_UNKNOWN;
+            }
+            return writer->result;
+        }
+    }
+    memcpy(writer->chunk + writer->chunk_length, data, length);
+    writer->chunk_length += length;
+    return COM_UTIL_OK;
+}
+
+static int emit_tabs(struct_meta_json_writer *writer, size_t count)
+{
+    static const char tabs[] = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+    while (count > 0U)
+    {
+        size_t length = count;
+        if (length > (sizeof(tabs) - 1U))
+        {
+            length = sizeof(tabs) - 1U;
+        }
+        if (emit(writer, tabs, length) != COM_UTIL_OK)
+        {
+            return writer->result;
+        }
+        count -= length;
+    }
+    return COM_UTIL_OK;
+}
+
+/**
+ *  @brief          値の前の区切りを書き出します。キーの直後では何も書きません。
+ */
+static int begin_value(struct_meta_json_writer *writer)
+{
+    if (writer->after_key != 0)
+    {
+        writer->after_key = 0;
+        return writer->result;
+    }
+    if (writer->first == 0)
+    {
+        if (writer->format == STRUCT_META_JSON_FORMAT_PRETTY)
+        {
+            (void)emit(writer, ", ", 2U);
+        }
+        else
+        {
+            (void)emit(writer, ",", 1U);
+        }
+    }
+    writer->first = 0;
+    return writer->result;
+}
+
+/**
+ *  @brief          文字列をエスケープして引用符付きで書き出します。
+ *
+ *  cJSON と同じく、制御文字以外の非 ASCII バイトはそのまま出力します。
+ */
+static int emit_string(struct_meta_json_writer *writer, const char *text, size_t length)
+{
+    static const char hex[] = "0123456789abcdef";
+    size_t run_start = 0U;
+
+    (void)emit(writer, "\"", 1U);
+    for (size_t i = 0; i < length; i++)
+    {
+        unsigned char c = (unsigned char)text[i];
+        char escape[6] = {'\\', 'u', '0', '0', '0', '0'};
+        size_t escape_length = 2U;
+
+        switch (c)
+        {
+        case '\"':
+        case '\\':
+            escape[1] = (char)c;
+            break;
+        case '\b':
+            escape[1] = 'b';
+            break;
+        case '\f':
+            escape[1] = 'f';
+            break;
+        case '\n':
+            escape[1] = 'n';
+            break;
+        case '\r':
+            escape[1] = 'r';
+            break;
+        case '\t':
+            escape[1] = 't';
+            break;
+        default:
+            if (c >= 32U)
+            {
+                continue;
+            }
+            escape[4] = hex[c >> 4U];
+            escape[5] = hex[c & 0x0FU];
+            escape_length = sizeof(escape);
+            break;
+        }
+
+        (void)emit(writer, text + run_start, i - run_start);
+        (void)emit(writer, escape, escape_length);
+        run_start = i + 1U;
+    }
+    (void)emit(writer, text + run_start, length - run_start);
+    return emit(writer, "\"", 1U);
+}
+
+static double absolute(double value)
+{
+    if (value < 0.0)
+    {
+        return -value;
+    }
+    return value;
+}
+
+/* cJSON の compare_double() と同じ許容誤差で比較する。 */
+static int doubles_equal(double a, double b)
+{
+    double max_value = absolute(a);
+    if (absolute(b) > max_value)
+    {
+        max_value = absolute(b);
+    }
+    return absolute(a - b) <= (max_value * DBL_EPSILON);
+}
+
+/**
+ *  @brief          整数を snprintf() の "%d" と同じ十進表記にします。
+ *
+ *  JSON の数値の大半は整数であるため、書式文字列の解釈を省きます。
+ */
+static size_t format_integer(int value, char *text, size_t text_size)
+{
+    char digits[16];
+    size_t count = 0U;
+    size_t length = 0U;
+    unsigned int magnitude = (unsigned int)value;
+
+    if (value < 0)
+    {
+        /* INT_MIN も表せるよう、符号なしの 2 の補数で絶対値を求める。 */
+        magnitude = 0U - magnitude;
+        text[length++] = '-';
+    }
+    do
+    {
+        digits[count++] = (char)('0' + (magnitude % 10U));
+        magnitude /= 10U;
+    } while (magnitude > 0U);
+    if ((length + count) >= text_size)
+    {
+        return 0U;
+    }
+    while (count > 0U)
+    {
+        text[length++] = digits[--count];
+    }
+    text[length] = '\0';
+    return length;
+}
+
+/**
+ *  @brief          64 ビット整数の絶対値と符号を十進表記にします。
+ *
+ *  double の仮数部 (53 ビット) を超える値も丸めずに書き出すため、浮動小数点数を経由しません。
+ */
+static size_t format_magnitude(uint64_t magnitude, int negative, char *text, size_t text_size)
+{
+    char digits[24];
+    size_t count = 0U;
+    size_t length = 0U;
+
+    if (negative != 0)
+    {
+        text[length++] = '-';
+    }
+    do
+    {
+        digits[count++] = (char)('0' + (magnitude % 10U));
+        magnitude /= 10U;
+    } while (magnitude > 0U);
+    if ((length + count) >= text_size)
+    {
+        return 0U;
+    }
+    while (count > 0U)
+    {
+        text[length++] = digits[--count];
+    }
+    text[length] = '\0';
+    return length;
+}
+
+/**
+ *  @brief          数値を cJSON_CreateNumber() と print_number() の組み合わせと同じ書式にします。
+ *  @return         書式化した文字数です。
+ */
+static size_t format_number(double value, char *text, size_t text_size)
+{
+    int length;
+
+    if ((isnan(value) != 0) || (isinf(value) != 0))
+    {
+        length = snprintf(text, text_size, "null");
+        return (size_t)length;
+    }
+
+    /* cJSON の valueint は int の範囲へ飽和させた値。これと一致する場合だけ整数表記になる。 */
+    int integer;
+    if (value >= (double)INT_MAX)
+    {
+        integer = INT_MAX;
+    }
+    else if (value <= (double)INT_MIN)
+    {
+        integer = INT_MIN;
+    }
+    else
+    {
+        integer = (int)value;
+    }
+
+    if (value == (double)integer)
+    {
+        return format_integer(integer, text, text_size);
+    }
+    else
+    {
+        /* 15 桁で往復できなければ 17 桁で書式化する。 */
+        length = snprintf(text, text_size, "%1.15g", value);
+        char *end = NULL;
+        double parsed = strtod(text, &end);
+        if ((end == text) || (doubles_equal(parsed, value) == 0))
+        {
+            length = snprintf(text, text_size, "%1.17g", value);
+        }
+    }
+    if ((length < 0) || ((size_t)length >= text_size))
+    {
+        return 0U;
+    }
+
+    /* ロケールの小数点を '.' へ置き換える。 */
+    char decimal_point = localeconv()->decimal_point[0];
+    for (int i = 0; i < length; i++)
+    {
+        if (text[i] == decimal_point)
+        {
+            text[i] = '.';
+        }
+    }
+    return (size_t)length;
+}
+
+static int write_struct(struct_meta_json_writer *writer, const struct_meta_descriptor *desc,
+                        const struct_meta_internal_name_index *names, const unsigned char *base);
+
+/**
+ *  @brief          値のない文字列 (NULL) を null として書き出します。
+ */
+static int write_null(struct_meta_json_writer *writer)
+{
+    if (begin_value(writer) != COM_UTIL_OK)
+    {
+        return writer->result;
+    }
+    return emit(writer, "null", 4U);
+}
+
+/**
+ *  @brief          フィールド 1 要素分 (配列要素、またはネスト構造体 1 個) を書き出します。
+ */
+static int write_element(struct_meta_json_writer *writer, const struct_meta_field *field,
+                         const unsigned char *elem_ptr)
+{
+    switch (field->kind)
+    {
+    case STRUCT_META_FIELD_INT:
+        if (field->element_size != sizeof(int))
+        {
+            return COM_UTIL_ERR_UNSUPPORTED;
+        }
+        {
+            int value;
+            memcpy(&value, elem_ptr, sizeof(value));
+            return struct_meta_json_writer_number(writer, (double)value);
+        }
+
+    case STRUCT_META_FIELD_UNSIGNED:
+        if (field->element_size != sizeof(unsigned int))
+        {
+            return COM_UTIL_ERR_UNSUPPORTED;
+        }
+        {
+            unsigned int value;
+            memcpy(&value, elem_ptr, sizeof(value));
+            return struct_meta_json_writer_number(writer, (double)value);
+        }
+
+    case STRUCT_META_FIELD_FLOAT:
+        if (field->element_size != sizeof(float))
+        {
+            return COM_UTIL_ERR_UNSUPPORTED;
+        }
+        {
+            float value;
+            memcpy(&value, elem_ptr, sizeof(value));
+            return struct_meta_json_writer_number(writer, (double)value);
+        }
+
+    case STRUCT_META_FIELD_DOUBLE:
+        if (field->element_size != sizeof(double))
+        {
+            return COM_UTIL_ERR_UNSUPPORTED;
+        }
+        {
+            double value;
+            memcpy(&value, elem_ptr, sizeof(value));
+            return struct_meta_json_writer_number(writer, value);
+        }
+
+    case STRUCT_META_FIELD_INT8:
+    case STRUCT_META_FIELD_INT16:
+    case STRUCT_META_FIELD_INT64:
+    case STRUCT_META_FIELD_ENUM:
+        return struct_meta_json_writer_int64(writer, struct_meta_internal_load_signed(elem_ptr, field->element_size));
+
+    case STRUCT_META_FIELD_UINT8:
+    case STRUCT_META_FIELD_UINT16:
+    case STRUCT_META_FIELD_UINT64:
+        return struct_meta_json_writer_uint64(writer,
+                                              struct_meta_internal_load_unsigned(elem_ptr, field->element_size));
+
+    case STRUCT_META_FIELD_BOOL:
+        return struct_meta_json_writer_bool(writer,
+                                            struct_meta_internal_load_unsigned(elem_ptr, field->element_size) != 0U);
+
+    case STRUCT_META_FIELD_CHAR_ARRAY:
+        return struct_meta_json_writer_chars(writer, (const char *)elem_ptr, field->char_buffer_size);
+
+    case STRUCT_META_FIELD_STRING:
+    {
+        const char *text;
+        memcpy((void *)&text, elem_ptr, sizeof(text));
+        if (text == NULL)
+        {
+            return write_null(writer);
+        }
+        return struct_meta_json_writer_string(writer, text);
+    }
+
+    case STRUCT_META_FIELD_STRUCT:
+        return write_struct(writer, field->nested, struct_meta_internal_json_names(field->nested), elem_ptr);
+
+    default:
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+}
+
+/**
+ *  @brief          フィールド記述子 1 個分 (スカラー、char 配列、固定長配列、可変長配列) を書き出します。
+ */
+static int write_field(struct_meta_json_writer *writer, const struct_meta_field *field, const unsigned char *base)
+{
+    const void *element;
+    int ret;
+    size_t count = field->element_count;
+
+    if (field->storage == STRUCT_META_STORAGE_SEQUENCE)
+    {
+        /* 可変長配列は、要素数 1 でも常に JSON 配列として書き出す。 */
+        const struct_meta_sequence *sequence = (const struct_meta_sequence *)(const void *)(base + field->offset);
+        if ((sequence->items == NULL) && (sequence->count > 0U))
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        count = sequence->count;
+    }
+    /* char[N] は配列ですが、単一の JSON 文字列として扱います。 */
+    else if ((field->kind == STRUCT_META_FIELD_CHAR_ARRAY) || (field->element_count <= 1U))
+    {
+        ret = struct_meta_field_get_const_element(field, base, 0U, &element);
+        if (ret != COM_UTIL_OK)
+        {
+            return ret;
+        }
+        return write_element(writer, field, (const unsigned char *)element);
+    }
+
+    ret = struct_meta_json_writer_begin_array(writer);
+    for (size_t i = 0; (i < count) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = struct_meta_field_get_const_element(field, base, i, &element);
+        if (ret == COM_UTIL_OK)
+        {
+            ret = write_element(writer, field, (const unsigned char *)element);
+        }
+    }
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    return struct_meta_json_writer_end_array(writer);
+}
+
+/**
+ *  @brief          構造体インスタンス 1 個分を JSON オブジェクトとして書き出します。
+ */
+static int write_struct(struct_meta_json_writer *writer, const struct_meta_descriptor *desc,
+                        const struct_meta_internal_name_index *names, const unsigned char *base)
+{
+    int ret = struct_meta_json_writer_begin_object(writer);
+    for (size_t i = 0; (i < desc->field_count) && (ret == COM_UTIL_OK); i++)
+    {
+        const struct_meta_field *field = &desc->fields[i];
+        const char *key = struct_meta_internal_json_field_key(names, desc, i);
+        if (key == NULL)
+        {
+            continue;
+        }
+        ret = struct_meta_json_writer_key(writer, key);
+        if (ret == COM_UTIL_OK)
+        {
+            ret = write_field(writer, field, base);
+        }
+    }
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    return struct_meta_json_writer_end_object(writer);
+}
+
+static void writer_init(struct_meta_json_writer *writer, struct_meta_buffer *buffer, FILE *stream,
+                        struct_meta_json_format format)
+{
+    writer->buffer = buffer;
+    writer->stream = stream;
+    writer->depth = 0U;
+    writer->chunk_length = 0U;
+    writer->format = format;
+    writer->result = COM_UTIL_OK;
+    writer->first = 1;
+    writer->after_key = 0;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_init_buffer(struct_meta_json_writer *writer, struct_meta_buffer *buffer,
+                                        struct_meta_json_format format)
+{
+    if ((writer == NULL) || (buffer == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    writer_init(writer, buffer, NULL, format);
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_init_stream(struct_meta_json_writer *writer, FILE *stream, struct_meta_json_format format)
+{
+    if ((writer == NULL) || (stream == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    writer_init(writer, NULL, stream, format);
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_flush(struct_meta_json_writer *writer)
+{
+    if (writer == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if ((writer->stream != NULL) && (writer->chunk_length > 0U))
+    {
+        if ((writer->result == COM_UTIL_OK) &&
+            (com_util_fwrite(writer->chunk, 1U, writer->chunk_length, writer->stream, NULL) != writer->chunk_length))
+        {
+            writer->result = COM_UTIL_ERR_UNKNOWN;
+        }
+        writer->chunk_length = 0U;
+    }
+    return writer->result;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_begin_object(struct_meta_json_writer *writer)
+{
+    if (writer == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if (begin_value(writer) != COM_UTIL_OK)
+    {
+        return writer->result;
+    }
+    writer->depth++;
+    writer->first = 1;
+    return emit(writer, "{", 1U);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_end_object(struct_meta_json_writer *writer)
+{
+    if ((writer == NULL) || (writer->depth == 0U))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    /* cJSON は空のオブジェクトでも開き括弧の後に改行を出力する。 */
+    if (writer->format == STRUCT_META_JSON_FORMAT_PRETTY)
+    {
+        (void)emit(writer, "\n", 1U);
+        (void)emit_tabs(writer, writer->depth - 1U);
+    }
+    writer->depth--;
+    writer->first = 0;
+    return emit(writer, "}", 1U);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_begin_array(struct_meta_json_writer *writer)
+{
+    if (writer == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if (begin_value(writer) != COM_UTIL_OK)
+    {
+        return writer->result;
+    }
+    writer->depth++;
+    writer->first = 1;
+    return emit(writer, "[", 1U);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_end_array(struct_meta_json_writer *writer)
+{
+    if ((writer == NULL) || (writer->depth == 0U))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    writer->depth--;
+    writer->first = 0;
+    return emit(writer, "]", 1U);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_key(struct_meta_json_writer *writer, const char *key)
+{
+    if ((writer == NULL) || (key == NULL) || (writer->depth == 0U) || (writer->after_key != 0))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if (writer->first == 0)
+    {
+        (void)emit(writer, ",", 1U);
+    }
+    writer->first = 0;
+    if (writer->format == STRUCT_META_JSON_FORMAT_PRETTY)
+    {
+        (void)emit(writer, "\n", 1U);
+        (void)emit_tabs(writer, writer->depth);
+    }
+    (void)emit_string(writer, key, strlen(key));
+    if (writer->format == STRUCT_META_JSON_FORMAT_PRETTY)
+    {
+        (void)emit(writer, ":\t", 2U);
+    }
+    else
+    {
+        (void)emit(writer, ":", 1U);
+    }
+    writer->after_key = 1;
+    return writer->result;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_string(struct_meta_json_writer *writer, const char *text)
+{
+    if ((writer == NULL) || (text == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if (begin_value(writer) != COM_UTIL_OK)
+    {
+        return writer->result;
+    }
+    return emit_string(writer, text, strlen(text));
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_chars(struct_meta_json_writer *writer, const char *text, size_t capacity)
+{
+    if ((writer == NULL) || ((text == NULL) && (capacity > 0U)))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    /* char[N] を NUL 終端文字列として扱い、N バイトを超えて読まない。 */
+    size_t length = capacity;
+    if (capacity > 0U)
+    {
+        const void *terminator = memchr(text, '\0', capacity);
+        if (terminator != NULL)
+        {
+            length = (size_t)((const char *)terminator - text);
+        }
+    }
+    if (begin_value(writer) != COM_UTIL_OK)
+    {
+        return writer->result;
+    }
+    return emit_string(writer, text, length);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_number(struct_meta_json_writer *writer, double value)
+{
+    char text[NUMBER_BUFFER_SIZE];
+
+    if (writer == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    size_t length = format_number(value, text, sizeof(text));
+    if (length == 0U)
+    {
+        return COM_UTIL_ERR_UNKNOWN;
+    }
+    if (begin_value(writer) != COM_UTIL_OK)
+    {
+        return writer->result;
+    }
+    return emit(writer, text, length);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_int64(struct_meta_json_writer *writer, int64_t value)
+{
+    char text[NUMBER_BUFFER_SIZE];
+
+    if (writer == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    /* INT64_MIN も表せるよう、符号なしの 2 の補数で絶対値を求める。 */
+    uint64_t magnitude = (uint64_t)value;
+    if (value < 0)
+    {
+        magnitude = 0U - magnitude;
+    }
+    size_t length = format_magnitude(magnitude, value < 0, text, sizeof(text));
+    if (length == 0U)
+    {
+        return COM_UTIL_ERR_UNKNOWN;
+    }
+    if (begin_value(writer) != COM_UTIL_OK)
+    {
+        return writer->result;
+    }
+    return emit(writer, text, length);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_uint64(struct_meta_json_writer *writer, uint64_t value)
+{
+    char text[NUMBER_BUFFER_SIZE];
+
+    if (writer == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    size_t length = format_magnitude(value, 0, text, sizeof(text));
+    if (length == 0U)
+    {
+        return COM_UTIL_ERR_UNKNOWN;
+    }
+    if (begin_value(writer) != COM_UTIL_OK)
+    {
+        return writer->result;
+    }
+    return emit(writer, text, length);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_bool(struct_meta_json_writer *writer, int value)
+{
+    if (writer == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if (begin_value(writer) != COM_UTIL_OK)
+    {
+        return writer->result;
+    }
+    if (value != 0)
+    {
+        return emit(writer, "true", 4U);
+    }
+    return emit(writer, "false", 5U);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_value(struct_meta_json_writer *writer, const struct_meta_descriptor *descriptor,
+                                  const void *instance)
+{
+    if ((writer == NULL) || (descriptor == NULL) || (instance == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    return write_struct(writer, descriptor, struct_meta_internal_json_names(descriptor),
+                        (const unsigned char *)instance);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_write_buffer(const struct_meta_descriptor *descriptor, const void *instance,
+                                  struct_meta_json_format format, struct_meta_buffer *buffer)
+{
+    struct_meta_json_writer writer;
+
+    int ret = struct_meta_json_writer_init_buffer(&writer, buffer, format);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    size_t initial_length = buffer->length;
+    ret = struct_meta_json_writer_value(&writer, descriptor, instance);
+    if ((ret != COM_UTIL_OK) && (buffer->data != NULL))
+    {
+        buffer->length = initial_length;
+        buffer->data[initial_length] = '\0';
+    }
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_write_stream(const struct_meta_descriptor *descriptor, const void *instance,
+                                  struct_meta_json_format format, FILE *stream)
+{
+    struct_meta_json_writer writer;
+
+    int ret = struct_meta_json_writer_init_stream(&writer, stream, format);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    ret = struct_meta_json_writer_value(&writer, descriptor, instance);
+    int flushed = struct_meta_json_writer_flush(&writer);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    return flushed;
+}
+
+/** 並行書き出しで、タスク間で共有する情報です。 */
+typedef struct array_write_job
+{
+    const struct_meta_descriptor *descriptor;
+    const struct_meta_internal_name_index *names;
+    const unsigned char *base;
+    size_t stride;
+    size_t count;
+    size_t task_count;
+    size_t depth;                  /* 配列の中の深さです。 */
+    struct_meta_buffer *fragments; /* タスクごとの書き出し結果です。 */
+    int *results;                  /* タスクごとの最初のエラーです。 */
+    struct_meta_json_format format;
+    int first;                     /* 配列へまだ値を書いていない場合は 0 以外です。 */
+} array_write_job;
+
+static void write_task(void *context, size_t task_index)
+{
+    const array_write_job *job = (const array_write_job *)context;
+    size_t begin = (job->count * task_index) / job->task_count;
+    size_t end = (job->count * (task_index + 1U)) / job->task_count;
+    struct_meta_json_writer writer;
+
+    /* 配列の途中から書き出す状態を作る。2 番目以降のタスクは要素の区切りから始まる。 */
+    writer_init(&writer, &job->fragments[task_index], NULL, job->format);
+    writer.depth = job->depth;
+    writer.first = 0;
+    if (task_index == 0U)
+    {
+        writer.first = job->first;
+    }
+    int ret = COM_UTIL_OK;
+    for (size_t i = begin; (i < end) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = write_struct(&writer, job->descriptor, job->names, job->base + (i * job->stride));
+    }
+    job->results[task_index] = ret;
+}
+
+/**
+ *  @brief          配列の要素を複数スレッドで書き出し、要素の順に連結します。
+ */
+static int write_elements_parallel(struct_meta_json_writer *writer, array_write_job *job)
+{
+    struct_meta_buffer fragments[STRUCT_META_PARALLEL_MAX_THREADS];
+    int results[STRUCT_META_PARALLEL_MAX_THREADS];
+
+    for (size_t t = 0; t < job->task_count; t++)
+    {
+        struct_meta_buffer_init(&fragments[t]);
+    }
+    job->depth = writer->depth;
+    job->first = writer->first;
+    job->fragments = fragments;
+    job->results = results;
+    struct_meta_internal_parallel_run(job->task_count, write_task, job);
+
+    int ret = COM_UTIL_OK;
+    for (size_t t = 0; t < job->task_count; t++)
+    {
+        if (ret == COM_UTIL_OK)
+        {
+            ret = results[t];
+        }
+        if (ret == COM_UTIL_OK)
+        {
+            ret = emit(writer, fragments[t].data, fragments[t].length);
+        }
+        struct_meta_buffer_dispose(&fragments[t]);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        writer->first = 0;
+    }
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_writer_array(struct_meta_json_writer *writer, const struct_meta_descriptor *descriptor,
+                                  const void *base, size_t count, size_t stride, size_t thread_count)
+{
+    if (writer == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    int ret = struct_meta_internal_array_stride(descriptor, base, count, stride, &stride);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+
+    /* 検査と JSON キー索引の取得は配列全体で 1 回だけ行う。 */
+    array_write_job job;
+    memset(&job, 0, sizeof(job));
+    job.descriptor = descriptor;
+    job.names = struct_meta_internal_json_names(descriptor);
+    job.base = (const unsigned char *)base;
+    job.stride = stride;
+    job.count = count;
+    job.task_count = struct_meta_internal_parallel_tasks(thread_count, count);
+    job.format = writer->format;
+
+    ret = struct_meta_json_writer_begin_array(writer);
+    if ((ret == COM_UTIL_OK) && (job.task_count > 1U))
+    {
+        ret = write_elements_parallel(writer, &job);
+    }
+    else
+    {
+        for (size_t i = 0; (i < count) && (ret == COM_UTIL_OK); i++)
+        {
+            ret = write_struct(writer, descriptor, job.names, job.base + (i * stride));
+        }
+    }
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    return struct_meta_json_writer_end_array(writer);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_json_write_array_buffer(const struct_meta_descriptor *descriptor, const void *base, size_t count,
+                                        size_t stride, struct_meta_json_format format, size_t thread_count,
+                                        struct_meta_buffer *buffer)
+{
+    struct_meta_json_writer writer;
+
+    int ret = struct_meta_json_writer_init_buffer(&writer, buffer, format);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    size_t initial_length = buffer->length;
+    ret = struct_meta_json_writer_array(&writer, descriptor, base, count, stride, thread_count);
+    if ((ret != COM_UTIL_OK) && (buffer->data != NULL))
+    {
+        buffer->length = initial_length;
+        buffer->data[initial_length] = '\0';
+    }
+    return ret;
+}
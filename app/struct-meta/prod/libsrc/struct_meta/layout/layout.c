@@ -0,0 +1,485 @@
+/**
+ *******************************************************************************
+ *  @file           layout.c
+ *  @brief          記述子のオフセットとサイズから、構造体の配置を分析し、並べ替え案を求めます。
+ *
+ *  フィールドをオフセット順に並べ、直前の末尾との隙間をパディングとして数えます。\n
+ *  並べ替え案は、グループ、境界の大きい順、元のオフセット順の順で整列した列へ、境界に合わせて詰めて置きます。
+ *  C の型はサイズが境界の倍数であるため、グループ内にはパディングが生じません。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/layout/layout.h>
+
+#include <struct_meta/access/access.h>
+#include <struct_meta/meta/registry.h>
+
+#include <com_util/base/result.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** 書き出し済みの型の一覧です。 */
+typedef struct written_types
+{
+    const struct_meta_descriptor **items;
+    size_t count;
+    size_t capacity;
+} written_types;
+
+static size_t align_up(size_t value, size_t alignment)
+{
+    return ((value + alignment - 1U) / alignment) * alignment;
+}
+
+static size_t count_cache_lines(size_t size)
+{
+    return (size + STRUCT_META_LAYOUT_CACHE_LINE_SIZE - 1U) / STRUCT_META_LAYOUT_CACHE_LINE_SIZE;
+}
+
+static size_t integer_alignment(size_t size)
+{
+    switch (size)
+    {
+    case 1U:
+        return _Alignof(int8_t);
+    case 2U:
+        return _Alignof(int16_t);
+    case 4U:
+        return _Alignof(int32_t);
+    default:
+        return _Alignof(int64_t);
+    }
+}
+
+static size_t descriptor_alignment(const struct_meta_descriptor *descriptor);
+
+static size_t field_alignment(const struct_meta_field *field)
+{
+    if (field->storage == STRUCT_META_STORAGE_SEQUENCE)
+    {
+        return _Alignof(struct_meta_sequence);
+    }
+
+    switch (field->kind)
+    {
+    case STRUCT_META_FIELD_INT:
+        return _Alignof(int);
+    case STRUCT_META_FIELD_UNSIGNED:
+        return _Alignof(unsigned int);
+    case STRUCT_META_FIELD_FLOAT:
+        return _Alignof(float);
+    case STRUCT_META_FIELD_DOUBLE:
+        return _Alignof(double);
+    case STRUCT_META_FIELD_INT8:
+    case STRUCT_META_FIELD_INT16:
+    case STRUCT_META_FIELD_INT64:
+    case STRUCT_META_FIELD_UINT8:
+    case STRUCT_META_FIELD_UINT16:
+    case STRUCT_META_FIELD_UINT64:
+    case STRUCT_META_FIELD_ENUM:
+        return integer_alignment(field->element_size);
+    case STRUCT_META_FIELD_BOOL:
+        return _Alignof(bool);
+    case STRUCT_META_FIELD_STRING:
+        return _Alignof(char *);
+    case STRUCT_META_FIELD_STRUCT:
+        return descriptor_alignment(field->nested);
+    case STRUCT_META_FIELD_CHAR_ARRAY:
+    default:
+        return 1U;
+    }
+}
+
+/**
+ *  @brief          構造体の境界を、フィールドの境界の最大値から推定します。
+ *
+ *  構造体のサイズは境界の倍数であるため、割り切れない推定値はサイズを割り切る値まで下げます。
+ */
+static size_t descriptor_alignment(const struct_meta_descriptor *descriptor)
+{
+    size_t alignment = 1U;
+    for (size_t i = 0; i < descriptor->field_count; i++)
+    {
+        size_t field_align = field_alignment(&descriptor->fields[i]);
+        if (field_align > alignment)
+        {
+            alignment = field_align;
+        }
+    }
+    while ((alignment > 1U) && ((descriptor->size % alignment) != 0U))
+    {
+        alignment /= 2U;
+    }
+    return alignment;
+}
+
+static size_t field_size(const struct_meta_field *field)
+{
+    if (field->storage == STRUCT_META_STORAGE_SEQUENCE)
+    {
+        return sizeof(struct_meta_sequence);
+    }
+    if (field->kind == STRUCT_META_FIELD_CHAR_ARRAY)
+    {
+        return field->char_buffer_size;
+    }
+    return field->element_size * field->element_count;
+}
+
+static struct_meta_layout_group field_group(const struct_meta_field *field)
+{
+    const struct_meta_attribute *attribute;
+    if (struct_meta_field_find_attribute(field, "layout.hot", &attribute) == COM_UTIL_OK)
+    {
+        return STRUCT_META_LAYOUT_HOT;
+    }
+    if (struct_meta_field_find_attribute(field, "layout.cold", &attribute) == COM_UTIL_OK)
+    {
+        return STRUCT_META_LAYOUT_COLD;
+    }
+    return STRUCT_META_LAYOUT_NORMAL;
+}
+
+/** 並べ替え案で @p left を @p right より前に置く場合は 1 を返します。オフセット順の添字で同順位を決めます。 */
+static int suggested_before(const struct_meta_layout_field *entries, size_t left, size_t right)
+{
+    if (entries[left].group != entries[right].group)
+    {
+        return (entries[left].group < entries[right].group) ? 1 : 0;
+    }
+    if (entries[left].alignment != entries[right].alignment)
+    {
+        return (entries[left].alignment > entries[right].alignment) ? 1 : 0;
+    }
+    return (left < right) ? 1 : 0;
+}
+
+/** @p entries をオフセット順 (同じオフセットでは記述子の順) に並べます。フィールド数は小さいため挿入ソートとする。 */
+static void sort_by_offset(struct_meta_layout_field *entries, size_t count)
+{
+    for (size_t i = 1U; i < count; i++)
+    {
+        struct_meta_layout_field entry = entries[i];
+        size_t j = i;
+        while ((j > 0U) && (entries[j - 1U].offset > entry.offset))
+        {
+            entries[j] = entries[j - 1U];
+            j--;
+        }
+        entries[j] = entry;
+    }
+}
+
+static void measure_current(const struct_meta_descriptor *descriptor, struct_meta_layout_field *entries,
+                            struct_meta_layout_report *report)
+{
+    size_t end = 0U;
+    size_t padding = 0U;
+    size_t next_hot_line = 0U;
+    size_t hot_lines = 0U;
+
+    for (size_t i = 0; i < descriptor->field_count; i++)
+    {
+        struct_meta_layout_field *entry = &entries[i];
+        entry->padding_before = (entry->offset > end) ? (entry->offset - end) : 0U;
+        entry->first_cache_line = entry->offset / STRUCT_META_LAYOUT_CACHE_LINE_SIZE;
+        entry->last_cache_line = (entry->offset + entry->size - 1U) / STRUCT_META_LAYOUT_CACHE_LINE_SIZE;
+        padding += entry->padding_before;
+        if ((entry->offset + entry->size) > end)
+        {
+            end = entry->offset + entry->size;
+        }
+
+        /* オフセット順に見るため、触れたラインの重複は直前までに数えた最後のラインとの比較で除ける。 */
+        if (entry->group == STRUCT_META_LAYOUT_HOT)
+        {
+            size_t first = (entry->first_cache_line > next_hot_line) ? entry->first_cache_line : next_hot_line;
+            if (first <= entry->last_cache_line)
+            {
+                hot_lines += (entry->last_cache_line - first) + 1U;
+                next_hot_line = entry->last_cache_line + 1U;
+            }
+        }
+    }
+
+    report->size = descriptor->size;
+    report->alignment = descriptor_alignment(descriptor);
+    report->trailing_padding = descriptor->size - end;
+    report->padding = padding + report->trailing_padding;
+    report->cache_lines = count_cache_lines(descriptor->size);
+    report->hot_cache_lines = hot_lines;
+}
+
+static void measure_suggested(const struct_meta_descriptor *descriptor, struct_meta_layout_field *entries,
+                              size_t *order, struct_meta_layout_report *report)
+{
+    size_t count = descriptor->field_count;
+    if (count == 0U)
+    {
+        /* 並べ替えるフィールドが無いため、記述子に無いメンバーの分も含めて現状のままとする。 */
+        report->suggested_size = report->size;
+        report->suggested_padding = report->padding;
+        report->suggested_cache_lines = report->cache_lines;
+        report->suggested_hot_cache_lines = report->hot_cache_lines;
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t index = i;
+        while ((index > 0U) && (suggested_before(entries, i, order[index - 1U]) != 0))
+        {
+            order[index] = order[index - 1U];
+            index--;
+        }
+        order[index] = i;
+    }
+
+    size_t offset = 0U;
+    size_t used = 0U;
+    size_t hot_end = 0U;
+    for (size_t i = 0; i < count; i++)
+    {
+        struct_meta_layout_field *entry = &entries[order[i]];
+        offset = align_up(offset, entry->alignment);
+        entry->suggested_offset = offset;
+        offset += entry->size;
+        used += entry->size;
+        if (entry->group == STRUCT_META_LAYOUT_HOT)
+        {
+            hot_end = offset;
+        }
+    }
+
+    report->suggested_size = align_up(offset, report->alignment);
+    report->suggested_padding = report->suggested_size - used;
+    report->suggested_cache_lines = count_cache_lines(report->suggested_size);
+    /* hot は先頭に連続して置くため、触れるラインは先頭から hot の末尾までである。 */
+    report->suggested_hot_cache_lines = count_cache_lines(hot_end);
+}
+
+static int analyze(const struct_meta_descriptor *descriptor, struct_meta_layout_field *entries,
+                   struct_meta_layout_report *report)
+{
+    size_t count = descriptor->field_count;
+    size_t *order = NULL;
+    if (count > 0U)
+    {
+        order = (size_t *)malloc(count * sizeof(*order));
+        if (order == NULL)
+        {
+            return COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const struct_meta_field *field = &descriptor->fields[i];
+        struct_meta_layout_field *entry = &entries[i];
+        memset(entry, 0, sizeof(*entry));
+        entry->field = field;
+        entry->offset = field->offset;
+        entry->size = field_size(field);
+        entry->alignment = field_alignment(field);
+        entry->group = field_group(field);
+    }
+    sort_by_offset(entries, count);
+
+    memset(report, 0, sizeof(*report));
+    measure_current(descriptor, entries, report);
+    measure_suggested(descriptor, entries, order, report);
+    free(order);
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_layout_analyze(const struct_meta_descriptor *descriptor, struct_meta_layout_field *fields_out,
+                               size_t field_capacity, struct_meta_layout_report *report_out)
+{
+    if ((descriptor == NULL) || (report_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    if ((fields_out != NULL) && (field_capacity < descriptor->field_count))
+    {
+        return COM_UTIL_ERR_BUFFER_TOO_SMALL;
+    }
+
+    struct_meta_layout_field *entries = fields_out;
+    if ((entries == NULL) && (descriptor->field_count > 0U))
+    {
+        entries = (struct_meta_layout_field *)malloc(descriptor->field_count * sizeof(*entries));
+        if (entries == NULL)
+        {
+            return COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    ret = analyze(descriptor, entries, report_out);
+    if (entries != fields_out)
+    {
+        free(entries);
+    }
+    return ret;
+}
+
+static const char *group_label(struct_meta_layout_group group)
+{
+    switch (group)
+    {
+    case STRUCT_META_LAYOUT_HOT:
+        return "hot";
+    case STRUCT_META_LAYOUT_COLD:
+        return "cold";
+    case STRUCT_META_LAYOUT_NORMAL:
+    default:
+        return "";
+    }
+}
+
+static void write_report(const struct_meta_descriptor *descriptor, const struct_meta_layout_field *entries,
+                         const struct_meta_layout_report *report, FILE *out)
+{
+    size_t count = descriptor->field_count;
+
+    fprintf(out, "%s: size %zu, align %zu, padding %zu, cache lines %zu, hot cache lines %zu\n", descriptor->name,
+            report->size, report->alignment, report->padding, report->cache_lines, report->hot_cache_lines);
+    fprintf(out, "  %8s %8s %5s %5s %7s %-5s %s\n", "offset", "size", "align", "pad", "line", "group", "field");
+    for (size_t i = 0; i < count; i++)
+    {
+        const struct_meta_layout_field *entry = &entries[i];
+        char line[48];
+        if (entry->first_cache_line == entry->last_cache_line)
+        {
+            snprintf(line, sizeof(line), "%zu", entry->first_cache_line);
+        }
+        else
+        {
+            snprintf(line, sizeof(line), "%zu-%zu", entry->first_cache_line, entry->last_cache_line);
+        }
+        fprintf(out, "  %8zu %8zu %5zu %5zu %7s %-5s %s\n", entry->offset, entry->size, entry->alignment,
+                entry->padding_before, line, group_label(entry->group), entry->field->name);
+    }
+    fprintf(out, "  trailing padding %zu\n", report->trailing_padding);
+
+    fprintf(out, "  suggested: size %zu, padding %zu, cache lines %zu, hot cache lines %zu\n", report->suggested_size,
+            report->suggested_padding, report->suggested_cache_lines, report->suggested_hot_cache_lines);
+    /* 並べ替え案の offset は重ならず増えるため、次に大きい offset を順に探して書き出す。 */
+    size_t next = 0U;
+    for (size_t written = 0U; written < count; written++)
+    {
+        const struct_meta_layout_field *entry = NULL;
+        for (size_t i = 0; i < count; i++)
+        {
+            if ((entries[i].suggested_offset >= next) &&
+                ((entry == NULL) || (entries[i].suggested_offset < entry->suggested_offset)))
+            {
+                entry = &entries[i];
+            }
+        }
+        fprintf(out, "  %8zu %8zu %5zu %5s %7s %-5s %s\n", entry->suggested_offset, entry->size, entry->alignment, "",
+                "", group_label(entry->group), entry->field->name);
+        next = entry->suggested_offset + entry->size;
+    }
+}
+
+static int mark_written(written_types *written, const struct_meta_descriptor *descriptor)
+{
+    for (size_t i = 0; i < written->count; i++)
+    {
+        if (written->items[i] == descriptor)
+        {
+            return 0;
+        }
+    }
+    if (written->count == written->capacity)
+    {
+        size_t capacity = (written->capacity > 0U) ? (written->capacity * 2U) : 8U;
+        const struct_meta_descriptor **items = (const struct_meta_descriptor **)realloc(
+            (void *)written->items, capacity * sizeof(*items));
+        if (items == NULL)
+        {
+            return -1;
+        }
+        written->items = items;
+        written->capacity = capacity;
+    }
+    written->items[written->count] = descriptor;
+    written->count++;
+    return 1;
+}
+
+static int write_type(const struct_meta_descriptor *descriptor, FILE *out, written_types *written)
+{
+    int marked = mark_written(written, descriptor);
+    if (marked <= 0)
+    {
+        return (marked == 0) ? COM_UTIL_OK : COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+
+    struct_meta_layout_field *entries = NULL;
+    if (descriptor->field_count > 0U)
+    {
+        entries = (struct_meta_layout_field *)malloc(descriptor->field_count * sizeof(*entries));
+        if (entries == NULL)
+        {
+            return COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    struct_meta_layout_report report;
+    int ret = analyze(descriptor, entries, &report);
+    if (ret == COM_UTIL_OK)
+    {
+        if (written->count > 1U)
+        {
+            fputc('\n', out);
+        }
+        write_report(descriptor, entries, &report, out);
+    }
+    free(entries);
+
+    for (size_t i = 0; (ret == COM_UTIL_OK) && (i < descriptor->field_count); i++)
+    {
+        const struct_meta_field *field = &descriptor->fields[i];
+        if (field->kind == STRUCT_META_FIELD_STRUCT)
+        {
+            ret = write_type(field->nested, out, written);
+        }
+    }
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_layout_write(const struct_meta_descriptor *descriptor, FILE *stream)
+{
+    if ((descriptor == NULL) || (stream == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+
+    written_types written = {NULL, 0U, 0U};
+    ret = write_type(descriptor, stream, &written);
+    free((void *)written.items);
+    return ret;
+}
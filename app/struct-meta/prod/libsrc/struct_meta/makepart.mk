@@ -1,14 +1,45 @@
 # ライブラリの指定
 LIBS += com_util cjson
+ifdef PLATFORM_LINUX
+    # 配列の並行変換 (base/parallel.c) で POSIX スレッドを使う
+    LIBS += pthread
+endif
+
+# ライブラリ内共有ヘッダー (struct_meta_internal_*) を参照する
+INCDIR += \
+    $(MYAPP_DIR)/prod/include_internal
 
 # 責務別のサブディレクトリに置いた実装を、1 個の共有ライブラリへまとめる。
 ADD_SRCS += \
+    base/parallel.c \
     meta/validate.c \
+    meta/registry.c \
+    meta/name_index.c \
+    meta/catalog.c \
     access/access.c \
+    access/column.c \
+    access/leaf.c \
     access/path.c \
+    columnar/columnar.c \
+    delta/delta.c \
+    hash/hash.c \
+    layout/layout.c \
+    memory/allocator.c \
+    memory/arena.c \
+    memory/buffer.c \
+    binary/plan.c \
+    binary/binary.c \
+    store/mmap_store.c \
+    migrate/migrate.c \
+    snapshot/snapshot.c \
+    json/key.c \
     json/encode.c \
     json/decode.c \
     json/file.c \
+    json/ndjson.c \
+    json/writer.c \
+    json/reader.c \
+    json/undo.c \
     patch/patch.c \
     print/print.c
 
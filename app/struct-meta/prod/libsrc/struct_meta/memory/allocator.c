@@ -0,0 +1,144 @@
+/**
+ *******************************************************************************
+ *  @file           allocator.c
+ *  @brief          動的フィールド (文字列と可変長配列) の領域を確保、解放します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/memory/allocator.h>
+
+#include <struct_meta/memory/dynamic.h>
+#include <struct_meta/meta/registry.h>
+
+#include <com_util/base/result.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+static void release_struct(const struct_meta_descriptor *desc, unsigned char *base,
+                           const struct_meta_allocator *allocator)
+{
+    for (size_t i = 0; i < desc->field_count; i++)
+    {
+        struct_meta_internal_release_field(&desc->fields[i], base, allocator);
+    }
+}
+
+/**
+ *  @brief          @p count 個並んだ要素の中の文字列とネスト構造体の領域を解放します。
+ */
+static void release_elements(const struct_meta_field *field, unsigned char *items, size_t count,
+                             const struct_meta_allocator *allocator)
+{
+    if (field->kind == STRUCT_META_FIELD_STRING)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            unsigned char *slot = items + (i * field->element_size);
+            char *text = NULL;
+            memcpy((void *)&text, slot, sizeof(text));
+            struct_meta_internal_release(allocator, text);
+            text = NULL;
+            memcpy(slot, (const void *)&text, sizeof(text));
+        }
+    }
+    else if (field->kind == STRUCT_META_FIELD_STRUCT)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            release_struct(field->nested, items + (i * field->element_size), allocator);
+        }
+    }
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_internal_descriptor_has_dynamic(const struct_meta_descriptor *descriptor)
+{
+    for (size_t i = 0; i < descriptor->field_count; i++)
+    {
+        const struct_meta_field *field = &descriptor->fields[i];
+        if (struct_meta_internal_field_is_dynamic(field) != 0)
+        {
+            return 1;
+        }
+        if ((field->kind == STRUCT_META_FIELD_STRUCT) &&
+            (struct_meta_internal_descriptor_has_dynamic(field->nested) != 0))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void *struct_meta_internal_allocate(const struct_meta_allocator *allocator, size_t size)
+{
+    if (allocator == NULL)
+    {
+        /* malloc(0) は NULL を返しうるため、失敗と区別できるよう 1 バイト以上を確保する。 */
+        return malloc((size > 0U) ? size : 1U);
+    }
+    return allocator->allocate(allocator->context, size);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_internal_release(const struct_meta_allocator *allocator, void *data)
+{
+    if (data == NULL)
+    {
+        return;
+    }
+    if (allocator == NULL)
+    {
+        free(data);
+    }
+    else if (allocator->release != NULL)
+    {
+        allocator->release(allocator->context, data);
+    }
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_internal_release_field(const struct_meta_field *field, unsigned char *base,
+                                        const struct_meta_allocator *allocator)
+{
+    if (field->storage == STRUCT_META_STORAGE_SEQUENCE)
+    {
+        struct_meta_sequence *sequence = struct_meta_internal_sequence_of(field, base);
+        if (sequence->items != NULL)
+        {
+            release_elements(field, (unsigned char *)sequence->items, sequence->count, allocator);
+            struct_meta_internal_release(allocator, sequence->items);
+        }
+        sequence->items = NULL;
+        sequence->count = 0U;
+        return;
+    }
+    release_elements(field, base + field->offset, field->element_count, allocator);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_instance_release(const struct_meta_descriptor *descriptor, void *instance,
+                                 const struct_meta_allocator *allocator)
+{
+    if ((descriptor == NULL) || (instance == NULL) || ((allocator != NULL) && (allocator->allocate == NULL)))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    release_struct(descriptor, (unsigned char *)instance, allocator);
+    return COM_UTIL_OK;
+}
@@ -0,0 +1,241 @@
+/**
+ *******************************************************************************
+ *  @file           arena.c
+ *  @brief          バンプ アロケーターを実装します。
+ *
+ *  ブロックは単方向リストで連結し、使用量を戻した後は同じ順に再利用します。
+ *  収まらない要求では、次のブロックの前へ新しいブロックを挿入します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/memory/arena.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** アリーナのブロックです。ヘッダーの直後から、境界をそろえた内容が続きます。 */
+struct struct_meta_arena_block
+{
+    struct_meta_arena_block *next; /**< 次のブロックです。 */
+    size_t size;                   /**< 内容のバイト数です。 */
+};
+
+/* ヘッダーを境界の倍数へ切り上げたバイト数。 */
+#define BLOCK_HEADER_SIZE                                                                                              \
+    ((sizeof(struct_meta_arena_block) + STRUCT_META_ARENA_ALIGNMENT - 1U) & ~(size_t)(STRUCT_META_ARENA_ALIGNMENT - 1U))
+
+static unsigned char *block_data(struct_meta_arena_block *block)
+{
+    return (unsigned char *)block + BLOCK_HEADER_SIZE;
+}
+
+/**
+ *  @brief          ブロックの使用済み位置から、境界をそろえて @p size バイトを切り出します。
+ *  @return         切り出した領域です。収まらない場合は NULL です。
+ */
+static void *take(struct_meta_arena_block *block, size_t *used, size_t size)
+{
+    unsigned char *cursor = block_data(block) + *used;
+    size_t padding = (size_t)(0U - (uintptr_t)cursor) & (size_t)(STRUCT_META_ARENA_ALIGNMENT - 1U);
+    size_t rest = block->size - *used;
+    if ((padding > rest) || (size > (rest - padding)))
+    {
+        return NULL;
+    }
+    *used += padding + size;
+    return cursor + padding;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_arena_init(struct_meta_arena *arena, size_t block_size)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->used = 0U;
+    arena->block_size = block_size;
+    if (arena->block_size == 0U)
+    {
+        arena->block_size = STRUCT_META_ARENA_DEFAULT_BLOCK_SIZE;
+    }
+    arena->block_count = 0U;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void *struct_meta_arena_alloc(struct_meta_arena *arena, size_t size)
+{
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+
+    void *data;
+    if (arena->current != NULL)
+    {
+        data = take(arena->current, &arena->used, size);
+        if (data != NULL)
+        {
+            return data;
+        }
+        struct_meta_arena_block *next = arena->current->next;
+        size_t next_used = 0U;
+        if ((next != NULL) && ((data = take(next, &next_used, size)) != NULL))
+        {
+            arena->current = next;
+            arena->used = next_used;
+            return data;
+        }
+    }
+
+    /* 境界合わせの余白を含めても収まる大きさで確保する。 */
+    if (size > (SIZE_MAX - BLOCK_HEADER_SIZE - STRUCT_META_ARENA_ALIGNMENT))
+    {
+        return NULL;
+    }
+    size_t capacity = size + STRUCT_META_ARENA_ALIGNMENT - 1U;
+    if (capacity < arena->block_size)
+    {
+        capacity = arena->block_size;
+    }
+    struct_meta_arena_block *block = (struct_meta_arena_block *)malloc(BLOCK_HEADER_SIZE + capacity);
+    if (block == NULL)
+    {
+        return NULL;
+    }
+    block->size = capacity;
+    if (arena->current == NULL)
+    {
+        block->next = arena->first;
+        arena->first = block;
+    }
+    else
+    {
+        block->next = arena->current->next;
+        arena->current->next = block;
+    }
+    arena->block_count++;
+    arena->current = block;
+    arena->used = 0U;
+    return take(block, &arena->used, size);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void *struct_meta_arena_grow(struct_meta_arena *arena, void *data, size_t old_size, size_t new_size)
+{
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+    if (data == NULL)
+    {
+        return struct_meta_arena_alloc(arena, new_size);
+    }
+    if (new_size <= old_size)
+    {
+        return data;
+    }
+
+    /* 直前に確保した領域なら、ブロックの余りへそのまま広げる。 */
+    struct_meta_arena_block *current = arena->current;
+    if ((current != NULL) && ((unsigned char *)data + old_size == block_data(current) + arena->used) &&
+        ((new_size - old_size) <= (current->size - arena->used)))
+    {
+        arena->used += new_size - old_size;
+        return data;
+    }
+
+    void *grown = struct_meta_arena_alloc(arena, new_size);
+    if (grown != NULL)
+    {
+        memcpy(grown, data, old_size);
+    }
+    return grown;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+struct_meta_arena_mark struct_meta_arena_save(const struct_meta_arena *arena)
+{
+    struct_meta_arena_mark mark = {NULL, 0U};
+    if (arena != NULL)
+    {
+        mark.block = arena->current;
+        mark.used = arena->used;
+    }
+    return mark;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_arena_rewind(struct_meta_arena *arena, struct_meta_arena_mark mark)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+    if (mark.block == NULL)
+    {
+        struct_meta_arena_reset(arena);
+        return;
+    }
+    arena->current = mark.block;
+    arena->used = mark.used;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_arena_reset(struct_meta_arena *arena)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+    arena->current = arena->first;
+    arena->used = 0U;
+}
+
+static void *arena_allocate(void *context, size_t size)
+{
+    return struct_meta_arena_alloc((struct_meta_arena *)context, size);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_arena_allocator(struct_meta_arena *arena, struct_meta_allocator *allocator_out)
+{
+    if (allocator_out == NULL)
+    {
+        return;
+    }
+    allocator_out->allocate = arena_allocate;
+    allocator_out->release = NULL;
+    allocator_out->context = arena;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_arena_dispose(struct_meta_arena *arena)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+    struct_meta_arena_block *block = arena->first;
+    while (block != NULL)
+    {
+        struct_meta_arena_block *next = block->next;
+        free(block);
+        block = next;
+    }
+    struct_meta_arena_init(arena, arena->block_size);
+}
@@ -0,0 +1,158 @@
+/**
+ *******************************************************************************
+ *  @file           buffer.c
+ *  @brief          伸長可能なバイト バッファーを実装します。
+ *
+ *  容量は 2 倍ずつ伸ばし、追記の償却コストを定数に抑えます。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/memory/buffer.h>
+
+#include <com_util/base/result.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* 最初の確保量。短いテキストでも数回の再確保で済む大きさとする。 */
+#define BUFFER_INITIAL_CAPACITY 256U
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_buffer_init(struct_meta_buffer *buffer)
+{
+    if (buffer == NULL)
+    {
+        return;
+    }
+    buffer->data = NULL;
+    buffer->length = 0U;
+    buffer->capacity = 0U;
+    buffer->arena = NULL;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_buffer_init_arena(struct_meta_buffer *buffer, struct_meta_arena *arena)
+{
+    if (buffer == NULL)
+    {
+        return;
+    }
+    struct_meta_buffer_init(buffer);
+    buffer->arena = arena;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_buffer_reserve(struct_meta_buffer *buffer, size_t additional)
+{
+    if (buffer == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    /* 末尾の NUL 1 バイトを含めた必要量。 */
+    if (additional > (SIZE_MAX - buffer->length - 1U))
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    size_t required = buffer->length + additional + 1U;
+    if (required <= buffer->capacity)
+    {
+        return COM_UTIL_OK;
+    }
+
+    size_t capacity = buffer->capacity;
+    if (capacity < BUFFER_INITIAL_CAPACITY)
+    {
+        capacity = BUFFER_INITIAL_CAPACITY;
+    }
+    while (capacity < required)
+    {
+        if (capacity > (SIZE_MAX / 2U))
+        {
+            capacity = required;
+            break;
+        }
+        capacity *= 2U;
+    }
+
+    unsigned char *data;
+    if (buffer->arena != NULL)
+    {
+        data = (unsigned char *)struct_meta_arena_grow(buffer->arena, buffer->data, buffer->capacity, capacity);
+    }
+    else
+    {
+        data = (unsigned char *)realloc(buffer->data, capacity);
+    }
+    if (data == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    if (buffer->data == NULL)
+    {
+        data[0] = '\0';
+    }
+    buffer->data = data;
+    buffer->capacity = capacity;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_buffer_append(struct_meta_buffer *buffer, const void *data, size_t length)
+{
+    if ((buffer == NULL) || ((data == NULL) && (length > 0U)))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    int ret = struct_meta_buffer_reserve(buffer, length);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    if (length > 0U)
+    {
+        memcpy(buffer->data + buffer->length, data, length);
+        buffer->length += length;
+    }
+    buffer->data[buffer->length] = '\0';
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_buffer_reset(struct_meta_buffer *buffer)
+{
+    if (buffer == NULL)
+    {
+        return;
+    }
+    buffer->length = 0U;
+    if (buffer->data != NULL)
+    {
+        buffer->data[0] = '\0';
+    }
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_buffer_dispose(struct_meta_buffer *buffer)
+{
+    if (buffer == NULL)
+    {
+        return;
+    }
+    struct_meta_arena *arena = buffer->arena;
+    if (arena == NULL)
+    {
+        free(buffer->data);
+    }
+    struct_meta_buffer_init_arena(buffer, arena);
+}
@@ -0,0 +1,258 @@
+/**
+ *******************************************************************************
+ *  @file           catalog.c
+ *  @brief          記述子の一覧をまとめて検査し、登録します。
+ *
+ *  検査と登録は struct_meta_internal_descriptor_acquire() に任せます。
+ *  登録済みの記述子は検査を省略するため、共有されたネスト先の検査は最初の 1 回だけです。\n
+ *  複数スレッドで検査する場合は、一覧を連続した範囲に分け、タスクごとに件数と最初のエラーを記録します。\n
+ *  型一覧をまたぐ名前索引は、検査済みレジストリと同じ挿入のみのロックフリー表です。
+ *  枠には記述子へのポインターを置き、構造体名は記述子から読み出して比較します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/meta/catalog.h>
+
+#include <struct_meta/base/atomic.h>
+#include <struct_meta/base/parallel.h>
+#include <struct_meta/meta/name_index.h>
+#include <struct_meta/meta/registry.h>
+
+#include <com_util/base/result.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/* 表の大きさは 2 の累乗とし、添字をマスクで求める。 */
+#define NAME_MASK (STRUCT_META_CATALOG_NAME_CAPACITY - 1U)
+
+static const void *s_names[STRUCT_META_CATALOG_NAME_CAPACITY];
+
+/** タスク 1 個分の検査結果です。 */
+typedef struct catalog_task_result
+{
+    size_t validated; /* 検査して登録した記述子数です。 */
+    size_t skipped;   /* 登録済みだった記述子数です。 */
+    size_t failed;    /* 最初に失敗した添字です。失敗がなければ一覧の要素数です。 */
+    int ret;          /* 最初のエラーです。 */
+    int pad;
+} catalog_task_result;
+
+typedef struct catalog_job
+{
+    const struct_meta_descriptor *const *descriptors;
+    size_t count;
+    size_t task_count;
+    catalog_task_result *results;
+} catalog_job;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    if (timespec_get(&ts, TIME_UTC) == 0)
+    {
+        return 0U;
+    }
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ *  @brief          一覧の [@p begin, @p end) を順に検査します。範囲内で最初に失敗した時点で止めます。
+ */
+static void validate_range(const catalog_job *job, size_t begin, size_t end, catalog_task_result *result)
+{
+    result->validated = 0U;
+    result->skipped = 0U;
+    result->failed = job->count;
+    result->ret = COM_UTIL_OK;
+    for (size_t i = begin; i < end; i++)
+    {
+        const struct_meta_descriptor *descriptor = job->descriptors[i];
+        if (struct_meta_internal_registry_find(descriptor) != NULL)
+        {
+            result->skipped++;
+            continue;
+        }
+        int ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+        if (ret != COM_UTIL_OK)
+        {
+            result->failed = i;
+            result->ret = ret;
+            return;
+        }
+        result->validated++;
+    }
+}
+
+static void validate_task(void *context, size_t task_index)
+{
+    const catalog_job *job = (const catalog_job *)context;
+    size_t begin = (job->count * task_index) / job->task_count;
+    size_t end = (job->count * (task_index + 1U)) / job->task_count;
+    validate_range(job, begin, end, &job->results[task_index]);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_catalog_validate_all(const struct_meta_descriptor *const *descriptors, size_t count,
+                                     size_t thread_count, struct_meta_catalog_report *report_out)
+{
+    if (report_out != NULL)
+    {
+        memset(report_out, 0, sizeof(*report_out));
+        report_out->descriptor_count = count;
+        report_out->failed_index = count;
+    }
+    if ((descriptors == NULL) && (count > 0U))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    uint64_t start = now_ns();
+    catalog_task_result results[STRUCT_META_PARALLEL_MAX_THREADS];
+    catalog_job job;
+    job.descriptors = descriptors;
+    job.count = count;
+    job.task_count = struct_meta_internal_parallel_tasks(thread_count, count);
+    job.results = results;
+    if (job.task_count > 1U)
+    {
+        struct_meta_internal_parallel_run(job.task_count, validate_task, &job);
+    }
+    else
+    {
+        validate_range(&job, 0U, count, &results[0]);
+    }
+    uint64_t end = now_ns();
+
+    /* 範囲は添字の順に並ぶため、先頭のタスクから見て最初に見つかったエラーが一覧で最初のエラーとなる。 */
+    int ret = COM_UTIL_OK;
+    size_t failed = count;
+    size_t validated = 0U;
+    size_t skipped = 0U;
+    for (size_t t = 0; t < job.task_count; t++)
+    {
+        validated += results[t].validated;
+        skipped += results[t].skipped;
+        if ((ret == COM_UTIL_OK) && (results[t].ret != COM_UTIL_OK))
+        {
+            ret = results[t].ret;
+            failed = results[t].failed;
+        }
+    }
+
+    if (report_out != NULL)
+    {
+        report_out->validated_count = validated;
+        report_out->skipped_count = skipped;
+        report_out->failed_index = failed;
+        report_out->thread_count = job.task_count;
+        if ((start != 0U) && (end >= start))
+        {
+            report_out->elapsed_ns = end - start;
+        }
+    }
+    return ret;
+}
+
+/**
+ *  @brief          記述子の名前が @p name の先頭 @p name_length バイトと一致するかを返します。
+ *
+ *  @p name は NUL を含む場合があるため、記述子の名前の長さを先に確かめてから比較し、名前の終端より先を読みません。
+ */
+static int name_equals(const struct_meta_descriptor *descriptor, const char *name, size_t name_length)
+{
+    return (strnlen(descriptor->name, name_length + 1U) == name_length) &&
+           (memcmp(descriptor->name, name, name_length) == 0);
+}
+
+/**
+ *  @brief          1 個の記述子を名前索引へ登録します。
+ */
+static int register_name(const struct_meta_descriptor *descriptor)
+{
+    size_t name_length = strlen(descriptor->name);
+    size_t slot = (size_t)struct_meta_internal_name_hash(descriptor->name, name_length);
+    for (size_t probe = 0; probe < STRUCT_META_CATALOG_NAME_CAPACITY; probe++)
+    {
+        const void **target = &s_names[(slot + probe) & NAME_MASK];
+        const struct_meta_descriptor *entry =
+            (const struct_meta_descriptor *)struct_meta_internal_atomic_load_const_ptr(target);
+        if (entry == NULL)
+        {
+            if (struct_meta_internal_atomic_cas_const_ptr(target, NULL, descriptor))
+            {
+                return COM_UTIL_OK;
+            }
+            /* 他スレッドが同じ枠へ先に公開した。公開された記述子を読み直す。 */
+            entry = (const struct_meta_descriptor *)struct_meta_internal_atomic_load_const_ptr(target);
+        }
+        if (entry == descriptor)
+        {
+            return COM_UTIL_OK;
+        }
+        if (name_equals(entry, descriptor->name, name_length))
+        {
+            return COM_UTIL_SKIPPED;
+        }
+    }
+    return COM_UTIL_SKIPPED;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_catalog_register(const struct_meta_descriptor *const *descriptors, size_t count)
+{
+    if ((descriptors == NULL) && (count > 0U))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        if ((descriptors[i] == NULL) || (descriptors[i]->name == NULL))
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+    }
+
+    int ret = COM_UTIL_OK;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (register_name(descriptors[i]) != COM_UTIL_OK)
+        {
+            ret = COM_UTIL_SKIPPED;
+        }
+    }
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+const struct_meta_descriptor *struct_meta_catalog_find(const char *name, size_t name_length)
+{
+    if (name == NULL)
+    {
+        return NULL;
+    }
+
+    size_t slot = (size_t)struct_meta_internal_name_hash(name, name_length);
+    for (size_t probe = 0; probe < STRUCT_META_CATALOG_NAME_CAPACITY; probe++)
+    {
+        const void **target = &s_names[(slot + probe) & NAME_MASK];
+        const struct_meta_descriptor *entry =
+            (const struct_meta_descriptor *)struct_meta_internal_atomic_load_const_ptr(target);
+        if (entry == NULL)
+        {
+            return NULL;
+        }
+        if (name_equals(entry, name, name_length))
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,175 @@
+/**
+ *******************************************************************************
+ *  @file           name_index.c
+ *  @brief          フィールド名のハッシュ索引を構築し、検索します。
+ *
+ *  表はフィールド数の 2 倍以上の 2 の累乗とし、線形探索で衝突を解決します。\n
+ *  ハッシュ値は FNV-1a (32 ビット) です。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/meta/name_index.h>
+
+#include <com_util/base/result.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+static const char *key_of(const struct_meta_internal_name_index *index, const struct_meta_descriptor *descriptor,
+                          struct_meta_internal_name_key_fn key_fn, size_t field_index)
+{
+    if ((index != NULL) && (index->keys != NULL))
+    {
+        return index->keys[field_index];
+    }
+    return key_fn(&descriptor->fields[field_index]);
+}
+
+static int key_equals(const char *key, const char *name, size_t name_length)
+{
+    return (strncmp(key, name, name_length) == 0) && (key[name_length] == '\0');
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+uint32_t struct_meta_internal_name_hash(const char *name, size_t name_length)
+{
+    uint32_t hash = 2166136261U;
+    for (size_t i = 0; i < name_length; i++)
+    {
+        hash ^= (uint32_t)(unsigned char)name[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_internal_name_index_build(const struct_meta_descriptor *descriptor,
+                                          struct_meta_internal_name_key_fn key_fn, int cache_keys,
+                                          struct_meta_internal_name_index *index_out)
+{
+    if ((descriptor == NULL) || (key_fn == NULL) || (index_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    index_out->slots = NULL;
+    index_out->mask = 0U;
+    index_out->keys = NULL;
+
+    if ((cache_keys != 0) && (descriptor->field_count > 0U))
+    {
+        if (descriptor->field_count > (SIZE_MAX / sizeof(*index_out->keys)))
+        {
+            return COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+        const char **keys = (const char **)malloc(descriptor->field_count * sizeof(*keys));
+        if (keys == NULL)
+        {
+            return COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+        for (size_t i = 0; i < descriptor->field_count; i++)
+        {
+            keys[i] = key_fn(&descriptor->fields[i]);
+        }
+        index_out->keys = keys;
+    }
+
+    /* 表の添字 + 1 を uint32_t へ格納するため、それを超えるフィールド数は線形探索に任せる。 */
+    if ((descriptor->field_count < STRUCT_META_NAME_INDEX_MIN_FIELDS) || (descriptor->field_count >= UINT32_MAX) ||
+        (descriptor->field_count > (SIZE_MAX / 4U)))
+    {
+        return COM_UTIL_OK;
+    }
+
+    size_t capacity = 16U;
+    while (capacity < (descriptor->field_count * 2U))
+    {
+        capacity *= 2U;
+    }
+    uint32_t *slots = (uint32_t *)calloc(capacity, sizeof(*slots));
+    if (slots == NULL)
+    {
+        struct_meta_internal_name_index_dispose(index_out);
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+
+    size_t mask = capacity - 1U;
+    for (size_t i = 0; i < descriptor->field_count; i++)
+    {
+        const char *key = key_of(index_out, descriptor, key_fn, i);
+        if (key == NULL)
+        {
+            continue;
+        }
+        size_t key_length = strlen(key);
+        size_t slot = (size_t)struct_meta_internal_name_hash(key, key_length) & mask;
+        while (slots[slot] != 0U)
+        {
+            if (strcmp(key_of(index_out, descriptor, key_fn, slots[slot] - 1U), key) == 0)
+            {
+                break;
+            }
+            slot = (slot + 1U) & mask;
+        }
+        if (slots[slot] == 0U)
+        {
+            slots[slot] = (uint32_t)(i + 1U);
+        }
+    }
+
+    index_out->slots = slots;
+    index_out->mask = mask;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_internal_name_index_dispose(struct_meta_internal_name_index *index)
+{
+    if (index == NULL)
+    {
+        return;
+    }
+    free(index->slots);
+    free(index->keys);
+    index->slots = NULL;
+    index->mask = 0U;
+    index->keys = NULL;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+const struct_meta_field *struct_meta_internal_name_index_find(const struct_meta_internal_name_index *index,
+                                                              const struct_meta_descriptor *descriptor,
+                                                              struct_meta_internal_name_key_fn key_fn,
+                                                              const char *name, size_t name_length)
+{
+    if ((index == NULL) || (index->slots == NULL))
+    {
+        for (size_t i = 0; i < descriptor->field_count; i++)
+        {
+            const char *key = key_of(index, descriptor, key_fn, i);
+            if ((key != NULL) && (key_equals(key, name, name_length) != 0))
+            {
+                return &descriptor->fields[i];
+            }
+        }
+        return NULL;
+    }
+
+    size_t slot = (size_t)struct_meta_internal_name_hash(name, name_length) & index->mask;
+    while (index->slots[slot] != 0U)
+    {
+        size_t field_index = index->slots[slot] - 1U;
+        if (key_equals(key_of(index, descriptor, key_fn, field_index), name, name_length) != 0)
+        {
+            return &descriptor->fields[field_index];
+        }
+        slot = (slot + 1U) & index->mask;
+    }
+    return NULL;
+}
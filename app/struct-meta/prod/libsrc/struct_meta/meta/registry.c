@@ -0,0 +1,264 @@
+/**
+ *******************************************************************************
+ *  @file           registry.c
+ *  @brief          検査済み記述子をアドレスで登録します。
+ *
+ *  固定長のオープン アドレス表へ、記述子アドレスをキーとする登録情報を
+ *  compare-and-swap で公開します。登録情報は公開前にすべて設定し、公開後は変更しません。\n
+ *  フィールド名の索引も公開前に構築するため、索引の参照にもロックは不要です。\n
+ *  削除した枠は削除済みの印に置き換え、後ろの枠へ続く探索を途切れさせません。印の枠は登録で再利用します。
+ *  探索は STRUCT_META_REGISTRY_MAX_PROBE 個の枠で打ち切ります。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/base/atomic.h>
+#include <struct_meta/meta/registry.h>
+
+#include <com_util/base/result.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* 表の大きさは 2 の累乗とし、添字をマスクで求める。 */
+#define REGISTRY_MASK (STRUCT_META_REGISTRY_CAPACITY - 1U)
+
+static void *s_entries[STRUCT_META_REGISTRY_CAPACITY];
+
+/** 削除済みの枠を示す印の実体です。アドレスだけを使います。 */
+static char s_removed_mark;
+
+/** 削除済みの枠に置く値です。登録情報のアドレスとは重なりません。 */
+#define REGISTRY_REMOVED ((void *)&s_removed_mark)
+
+static size_t slot_of(const struct_meta_descriptor *descriptor)
+{
+    /* 記述子はポインター境界に整列するため、下位ビットを捨ててから攪拌する。 */
+    uint64_t key = (uint64_t)(uintptr_t)descriptor >> 3U;
+    key *= 0x9E3779B97F4A7C15ULL;
+    return (size_t)(key >> 32U) & REGISTRY_MASK;
+}
+
+static const char *field_name_key(const struct_meta_field *field)
+{
+    return field->name;
+}
+
+static void discard_entry(struct_meta_internal_descriptor_entry *entry)
+{
+    for (size_t i = 0; i < STRUCT_META_INTERNAL_EXTENSION_COUNT; i++)
+    {
+        if ((entry->extensions[i].data != NULL) && (entry->extensions[i].dispose != NULL))
+        {
+            entry->extensions[i].dispose(entry->extensions[i].data);
+        }
+    }
+    struct_meta_internal_name_index_dispose(&entry->field_names);
+    free(entry->extensions);
+    free(entry);
+}
+
+static int entry_matches(const struct_meta_internal_descriptor_entry *entry,
+                         const struct_meta_descriptor *descriptor)
+{
+    return (entry->name == descriptor->name) && (entry->size == descriptor->size) &&
+           (entry->fields == descriptor->fields) && (entry->field_count == descriptor->field_count);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+const struct_meta_internal_descriptor_entry *struct_meta_internal_registry_find(
+    const struct_meta_descriptor *descriptor)
+{
+    if (descriptor == NULL)
+    {
+        return NULL;
+    }
+
+    size_t slot = slot_of(descriptor);
+    for (size_t probe = 0; probe < STRUCT_META_REGISTRY_MAX_PROBE; probe++)
+    {
+        void *value = struct_meta_internal_atomic_load_ptr(&s_entries[(slot + probe) & REGISTRY_MASK]);
+        if (value == NULL)
+        {
+            return NULL;
+        }
+        if (value == REGISTRY_REMOVED)
+        {
+            continue;
+        }
+        const struct_meta_internal_descriptor_entry *entry = (const struct_meta_internal_descriptor_entry *)value;
+        if (entry->descriptor == descriptor)
+        {
+            if (entry_matches(entry, descriptor) == 0)
+            {
+                return NULL;
+            }
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_internal_registry_add(const struct_meta_descriptor *descriptor)
+{
+    if (descriptor == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    struct_meta_internal_descriptor_entry *candidate =
+        (struct_meta_internal_descriptor_entry *)malloc(sizeof(*candidate));
+    if (candidate == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    candidate->descriptor = descriptor;
+    candidate->name = descriptor->name;
+    candidate->size = descriptor->size;
+    candidate->fields = descriptor->fields;
+    candidate->field_count = descriptor->field_count;
+    candidate->extensions = (struct_meta_internal_extension *)calloc(STRUCT_META_INTERNAL_EXTENSION_COUNT,
+                                                                     sizeof(*candidate->extensions));
+    if (candidate->extensions == NULL)
+    {
+        free(candidate);
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    int ret = struct_meta_internal_name_index_build(descriptor, field_name_key, 0, &candidate->field_names);
+    if (ret != COM_UTIL_OK)
+    {
+        free(candidate->extensions);
+        free(candidate);
+        return ret;
+    }
+
+    size_t slot = slot_of(descriptor);
+    for (;;)
+    {
+        /* 登録済みでないことを空の枠まで確かめてから、最初の空きか削除済みの枠へ公開する。 */
+        void **free_target = NULL;
+        void *free_value = NULL;
+        for (size_t probe = 0; probe < STRUCT_META_REGISTRY_MAX_PROBE; probe++)
+        {
+            void **target = &s_entries[(slot + probe) & REGISTRY_MASK];
+            void *value = struct_meta_internal_atomic_load_ptr(target);
+            if ((value == NULL) || (value == REGISTRY_REMOVED))
+            {
+                if (free_target == NULL)
+                {
+                    free_target = target;
+                    free_value = value;
+                }
+                if (value == NULL)
+                {
+                    break;
+                }
+                continue;
+            }
+            const struct_meta_internal_descriptor_entry *entry = (const struct_meta_internal_descriptor_entry *)value;
+            if (entry->descriptor == descriptor)
+            {
+                discard_entry(candidate);
+                if (entry_matches(entry, descriptor) == 0)
+                {
+                    return COM_UTIL_SKIPPED;
+                }
+                return COM_UTIL_OK;
+            }
+        }
+        if (free_target == NULL)
+        {
+            discard_entry(candidate);
+            return COM_UTIL_SKIPPED;
+        }
+        if (struct_meta_internal_atomic_cas_ptr(free_target, free_value, candidate))
+        {
+            return COM_UTIL_OK;
+        }
+        /* 他スレッドが同じ枠へ先に公開した。同じ記述子かもしれないため、探索をやり直す。 */
+    }
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_internal_registry_remove(const struct_meta_descriptor *descriptor)
+{
+    if (descriptor == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    int ret = COM_UTIL_SKIPPED;
+    size_t slot = slot_of(descriptor);
+    for (size_t probe = 0; probe < STRUCT_META_REGISTRY_MAX_PROBE; probe++)
+    {
+        void **target = &s_entries[(slot + probe) & REGISTRY_MASK];
+        void *value = struct_meta_internal_atomic_load_ptr(target);
+        if (value == NULL)
+        {
+            break;
+        }
+        if (value == REGISTRY_REMOVED)
+        {
+            continue;
+        }
+        struct_meta_internal_descriptor_entry *entry = (struct_meta_internal_descriptor_entry *)value;
+        /* 並行登録の競合で同じ記述子が 2 か所に公開された場合も、すべて削除する。 */
+        if ((entry->descriptor == descriptor) && struct_meta_internal_atomic_cas_ptr(target, value, REGISTRY_REMOVED))
+        {
+            discard_entry(entry);
+            ret = COM_UTIL_OK;
+        }
+    }
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+const struct_meta_field *struct_meta_internal_descriptor_find_field(const struct_meta_descriptor *descriptor,
+                                                                    const struct_meta_internal_descriptor_entry *entry,
+                                                                    const char *name, size_t name_length)
+{
+    const struct_meta_internal_name_index *index = NULL;
+    if (entry != NULL)
+    {
+        index = &entry->field_names;
+    }
+    return struct_meta_internal_name_index_find(index, descriptor, field_name_key, name, name_length);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void *struct_meta_internal_extension_get(const struct_meta_internal_descriptor_entry *entry,
+                                         struct_meta_internal_extension_kind kind)
+{
+    if ((entry == NULL) || ((size_t)kind >= STRUCT_META_INTERNAL_EXTENSION_COUNT))
+    {
+        return NULL;
+    }
+    return struct_meta_internal_atomic_load_ptr(&entry->extensions[kind].data);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void *struct_meta_internal_extension_publish(const struct_meta_internal_descriptor_entry *entry,
+                                             struct_meta_internal_extension_kind kind, void *candidate,
+                                             struct_meta_internal_extension_dispose_fn dispose)
+{
+    if ((entry == NULL) || ((size_t)kind >= STRUCT_META_INTERNAL_EXTENSION_COUNT) || (candidate == NULL))
+    {
+        return NULL;
+    }
+    if (struct_meta_internal_atomic_cas_ptr(&entry->extensions[kind].data, NULL, candidate))
+    {
+        /* 解放関数は登録の削除時だけ読む。削除は登録情報の利用者がいない間に行うため、公開後の書き込みでよい。 */
+        entry->extensions[kind].dispose = dispose;
+        return candidate;
+    }
+    return struct_meta_internal_atomic_load_ptr(&entry->extensions[kind].data);
+}
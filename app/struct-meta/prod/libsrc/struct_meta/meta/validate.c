@@ -9,6 +9,8 @@
  */
 
 #include <struct_meta/meta/meta.h>
+#include <struct_meta/meta/registry.h>
+#include <struct_meta/meta/scalar.h>
 
 #include <com_util/base/result.h>
 
@@ -16,13 +18,39 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* ネストの深さがこの値までは、探索中の記述子をヒープを使わずに保持する。 */
+#define VALIDATION_INLINE_DEPTH 16U
+
+/* 属性数がこの値を超えるフィールドは、キーを整列してから重複を調べる。 */
+#define VALIDATION_SORT_ATTRIBUTES 8U
+
 typedef struct validation_context
 {
     const struct_meta_descriptor **stack;
     size_t depth;
     size_t capacity;
+    int use_registry; /* 0 以外の場合、登録済みの記述子を省略し、検査に成功した記述子を登録する。 */
+    int pad;
+    const struct_meta_descriptor *inline_stack[VALIDATION_INLINE_DEPTH];
 } validation_context;
 
+static void context_init(validation_context *context, int use_registry)
+{
+    context->stack = context->inline_stack;
+    context->depth = 0U;
+    context->capacity = VALIDATION_INLINE_DEPTH;
+    context->use_registry = use_registry;
+    context->pad = 0;
+}
+
+static void context_dispose(validation_context *context)
+{
+    if (context->stack != context->inline_stack)
+    {
+        free((void *)context->stack);
+    }
+}
+
 static int push_descriptor(validation_context *context, const struct_meta_descriptor *descriptor)
 {
     for (size_t i = 0; i < context->depth; i++)
@@ -35,13 +63,25 @@ static int push_descriptor(validation_context *context, const struct_meta_descri
 
     if (context->depth == context->capacity)
     {
-        size_t capacity = (context->capacity == 0U) ? 8U : context->capacity * 2U;
+        size_t capacity = context->capacity * 2U;
         if (capacity < context->capacity || capacity > (SIZE_MAX / sizeof(*context->stack)))
         {
             return COM_UTIL_ERR_OUT_OF_MEMORY;
         }
-        const struct_meta_descriptor **stack =
-            (const struct_meta_descriptor **)realloc(context->stack, capacity * sizeof(*context->stack));
+        const struct_meta_descriptor **stack;
+        if (context->stack == context->inline_stack)
+        {
+            stack = (const struct_meta_descriptor **)malloc(capacity * sizeof(*context->stack));
+            if (stack != NULL)
+            {
+                memcpy((void *)stack, (const void *)context->stack, context->depth * sizeof(*context->stack));
+            }
+        }
+        else
+        {
+            stack = (const struct_meta_descriptor **)realloc((void *)context->stack,
+                                                             capacity * sizeof(*context->stack));
+        }
         if (stack == NULL)
         {
             return COM_UTIL_ERR_OUT_OF_MEMORY;
@@ -55,6 +95,40 @@ static int push_descriptor(validation_context *context, const struct_meta_descri
     return COM_UTIL_OK;
 }
 
+static int compare_keys(const void *left, const void *right)
+{
+    return strcmp(*(const char *const *)left, *(const char *const *)right);
+}
+
+/**
+ *  @brief          属性キーの重複を、キーの複写を整列して隣同士の比較で調べます。
+ */
+static int find_duplicate_sorted(const struct_meta_field *field)
+{
+    const char **keys = (const char **)malloc(field->attribute_count * sizeof(*keys));
+    if (keys == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    for (size_t i = 0; i < field->attribute_count; i++)
+    {
+        keys[i] = field->attributes[i].key;
+    }
+    qsort((void *)keys, field->attribute_count, sizeof(*keys), compare_keys);
+
+    int ret = COM_UTIL_OK;
+    for (size_t i = 1; i < field->attribute_count; i++)
+    {
+        if (strcmp(keys[i - 1U], keys[i]) == 0)
+        {
+            ret = COM_UTIL_ERR_CORRUPT_DESCRIPTOR;
+            break;
+        }
+    }
+    free((void *)keys);
+    return ret;
+}
+
 static int validate_attributes(const struct_meta_field *field)
 {
     if ((field->attribute_count > 0U) && (field->attributes == NULL))
@@ -71,6 +145,10 @@ static int validate_attributes(const struct_meta_field *field)
         }
     }
 
+    if (field->attribute_count > VALIDATION_SORT_ATTRIBUTES)
+    {
+        return find_duplicate_sorted(field);
+    }
     for (size_t i = 0; i < field->attribute_count; i++)
     {
         const struct_meta_attribute *attribute = &field->attributes[i];
@@ -93,6 +171,11 @@ static int validate_descriptor(validation_context *context, const struct_meta_de
         return COM_UTIL_ERR_CORRUPT_DESCRIPTOR;
     }
 
+    if ((context->use_registry != 0) && (struct_meta_internal_registry_find(descriptor) != NULL))
+    {
+        return COM_UTIL_OK;
+    }
+
     int ret = push_descriptor(context, descriptor);
     if (ret != COM_UTIL_OK)
     {
@@ -105,13 +188,26 @@ static int validate_descriptor(validation_context *context, const struct_meta_de
         size_t field_size;
 
         if ((field->name == NULL) || (field->name[0] == '\0') || (field->kind < STRUCT_META_FIELD_INT) ||
-            (field->kind > STRUCT_META_FIELD_STRUCT) || (field->element_size == 0U) || (field->element_count == 0U))
+            (field->kind > STRUCT_META_FIELD_STRING) || (field->storage > STRUCT_META_STORAGE_SEQUENCE) ||
+            (field->element_size == 0U) || (field->element_count == 0U) ||
+            (struct_meta_internal_kind_size_valid(field->kind, field->element_size) == 0))
         {
             ret = COM_UTIL_ERR_CORRUPT_DESCRIPTOR;
             break;
         }
 
-        if (field->kind == STRUCT_META_FIELD_CHAR_ARRAY)
+        if (field->storage == STRUCT_META_STORAGE_SEQUENCE)
+        {
+            /* 要素は別領域にあるため、構造体内で占めるのは items と count の組だけである。 */
+            if ((field->kind == STRUCT_META_FIELD_CHAR_ARRAY) || (field->element_count != 1U) ||
+                (field->char_buffer_size != 0U))
+            {
+                ret = COM_UTIL_ERR_CORRUPT_DESCRIPTOR;
+                break;
+            }
+            field_size = sizeof(struct_meta_sequence);
+        }
+        else if (field->kind == STRUCT_META_FIELD_CHAR_ARRAY)
         {
             if ((field->char_buffer_size == 0U) || (field->element_count != 1U) || (field->nested != NULL))
             {
@@ -163,6 +259,12 @@ static int validate_descriptor(validation_context *context, const struct_meta_de
     }
 
     context->depth--;
+
+    if ((ret == COM_UTIL_OK) && (context->use_registry != 0))
+    {
+        /* 登録できなくても検査結果は変わらないため、呼び出しごとの検査へ戻るだけとする。 */
+        (void)struct_meta_internal_registry_add(descriptor);
+    }
     return ret;
 }
 
@@ -175,9 +277,67 @@ int struct_meta_descriptor_validate(const struct_meta_descriptor *descriptor)
         return COM_UTIL_ERR_INVALID_ARGUMENT;
     }
 
-    validation_context context = {0};
+    validation_context context;
+    context_init(&context, 0);
     int ret = validate_descriptor(&context, descriptor);
 
-    free(context.stack);
+    context_dispose(&context);
     return ret;
 }
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_descriptor_seal(const struct_meta_descriptor *descriptor)
+{
+    if (descriptor == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    return struct_meta_internal_descriptor_acquire(descriptor, NULL);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_descriptor_unregister(const struct_meta_descriptor *descriptor)
+{
+    if (descriptor == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    return struct_meta_internal_registry_remove(descriptor);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_internal_descriptor_acquire(const struct_meta_descriptor *descriptor,
+                                            const struct_meta_internal_descriptor_entry **entry_out)
+{
+    if (entry_out != NULL)
+    {
+        *entry_out = NULL;
+    }
+    if (descriptor == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    const struct_meta_internal_descriptor_entry *entry = struct_meta_internal_registry_find(descriptor);
+    if (entry == NULL)
+    {
+        validation_context context;
+        context_init(&context, 1);
+        int ret = validate_descriptor(&context, descriptor);
+        context_dispose(&context);
+        if (ret != COM_UTIL_OK)
+        {
+            return ret;
+        }
+        entry = struct_meta_internal_registry_find(descriptor);
+    }
+
+    if (entry_out != NULL)
+    {
+        *entry_out = entry;
+    }
+    return COM_UTIL_OK;
+}
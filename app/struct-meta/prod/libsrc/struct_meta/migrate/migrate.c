@@ -0,0 +1,640 @@
+/**
+ *******************************************************************************
+ *  @file           migrate.c
+ *  @brief          2 個の記述子のフィールドを対応付けて移行計画を作り、構造体を変換します。
+ *
+ *  計画の作成は、移行先の記述子を再帰的に辿り、ネスト先と配列の要素ごとに移行元の範囲と対応付けた操作を作ります。
+ *  操作を移行先のオフセット順に並べ、両方で同じ間隔に並ぶ複写を 1 個の複写へまとめます。\n
+ *  追加されたフィールドは、まとめる複写がその範囲を上書きしないよう、整列とまとめの間だけ区切りの操作として置きます。
+ *  適用は、移行先を 0 で埋めてから操作の列を順に実行するだけで、フィールド名や種別を調べません。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/migrate/migrate.h>
+
+#include <struct_meta/binary/plan.h>
+#include <struct_meta/json/key.h>
+#include <struct_meta/memory/dynamic.h>
+#include <struct_meta/meta/registry.h>
+#include <struct_meta/meta/scalar.h>
+
+#include <com_util/base/result.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** 移行操作の種類です。 */
+typedef enum migration_op_kind
+{
+    MIGRATION_OP_COPY = 0,    /**< バイト列をそのまま複写します。 */
+    MIGRATION_OP_CHARS = 1,   /**< 大きさの異なる char 配列へ、NUL 終端文字列として複写します。 */
+    MIGRATION_OP_CONVERT = 2, /**< 数値 1 個を、種別と幅を変換して書き込みます。 */
+    MIGRATION_OP_ZERO = 3     /**< 追加された範囲です。計画の作成中の区切りにだけ使います。 */
+} migration_op_kind;
+
+/** 移行操作 1 個です。 */
+typedef struct migration_op
+{
+    size_t source_offset;               /**< 移行元の最上位の構造体の先頭からのバイト オフセットです。 */
+    size_t target_offset;               /**< 移行先の最上位の構造体の先頭からのバイト オフセットです。 */
+    size_t source_length;               /**< 移行元の範囲のバイト数です。 */
+    size_t target_length;               /**< 移行先の範囲のバイト数です。 */
+    struct_meta_field_kind source_kind; /**< 変換する値の移行元の種別です。 */
+    struct_meta_field_kind target_kind; /**< 変換する値の移行先の種別です。 */
+    migration_op_kind kind;             /**< 操作の種類です。 */
+    unsigned int pad;                   /**< 明示的アラインメントです。 */
+} migration_op;
+
+/** 操作の列です。struct_meta_migration の plan が指します。 */
+typedef struct migration_plan
+{
+    migration_op *ops;
+    size_t op_count;
+    size_t op_capacity;
+    int full_copy; /* 構造体全体の複写 1 回で移せる場合は 1 です。移行先を 0 で埋めません。 */
+    int pad;
+} migration_plan;
+
+/** 数値 1 個の、種別によらない表現です。 */
+typedef struct scalar_value
+{
+    double real;        /**< 浮動小数点の値です。 */
+    uint64_t magnitude; /**< 整数の絶対値です。 */
+    int sign;           /**< 整数の符号です。負の場合は -1、その他は 1 です。 */
+    int is_real;        /**< 浮動小数点の値の場合は 1 です。 */
+} scalar_value;
+
+static int is_real_kind(struct_meta_field_kind kind)
+{
+    return ((kind == STRUCT_META_FIELD_FLOAT) || (kind == STRUCT_META_FIELD_DOUBLE)) ? 1 : 0;
+}
+
+static int append_op(migration_plan *plan, migration_op_kind kind, size_t source_offset, size_t target_offset,
+                     size_t source_length, size_t target_length)
+{
+    if (plan->op_count == plan->op_capacity)
+    {
+        size_t capacity = 16U;
+        if (plan->op_capacity > 0U)
+        {
+            if (plan->op_capacity > ((SIZE_MAX / sizeof(*plan->ops)) / 2U))
+            {
+                return COM_UTIL_ERR_OUT_OF_MEMORY;
+            }
+            capacity = plan->op_capacity * 2U;
+        }
+        migration_op *ops = (migration_op *)realloc(plan->ops, capacity * sizeof(*ops));
+        if (ops == NULL)
+        {
+            return COM_UTIL_ERR_OUT_OF_MEMORY;
+        }
+        plan->ops = ops;
+        plan->op_capacity = capacity;
+    }
+
+    migration_op *op = &plan->ops[plan->op_count];
+    memset(op, 0, sizeof(*op));
+    op->source_offset = source_offset;
+    op->target_offset = target_offset;
+    op->source_length = source_length;
+    op->target_length = target_length;
+    op->kind = kind;
+    plan->op_count++;
+    return COM_UTIL_OK;
+}
+
+/** フィールドの JSON キーを返します。JSON へ含めないフィールドは C フィールド名です。 */
+static const char *field_key(const struct_meta_field *field)
+{
+    const char *key = struct_meta_internal_json_key(field);
+    return (key != NULL) ? key : field->name;
+}
+
+/**
+ *  @brief          移行先の各フィールドに対応する移行元のフィールドの添字を求めます。
+ *
+ *  先に C フィールド名で対応付けてから、残りを JSON キーで対応付けます。
+ *  名前の一致を先に確定するため、別のフィールドの旧名を JSON キーに持つフィールドが、名前の一致を奪いません。
+ *
+ *  @param[out]     source_of 移行先のフィールドごとの移行元の添字です。対応が無い場合は SIZE_MAX です。
+ *  @param[out]     used 移行元のフィールドごとの、対応付け済みなら 1 です。
+ */
+static void match_fields(const struct_meta_descriptor *source, const struct_meta_descriptor *target, size_t *source_of,
+                         unsigned char *used)
+{
+    memset(used, 0, source->field_count);
+    for (size_t i = 0; i < target->field_count; i++)
+    {
+        source_of[i] = SIZE_MAX;
+        for (size_t j = 0; j < source->field_count; j++)
+        {
+            if ((used[j] == 0U) && (strcmp(target->fields[i].name, source->fields[j].name) == 0))
+            {
+                source_of[i] = j;
+                used[j] = 1U;
+                break;
+            }
+        }
+    }
+    for (size_t i = 0; i < target->field_count; i++)
+    {
+        if (source_of[i] != SIZE_MAX)
+        {
+            continue;
+        }
+        const char *key = field_key(&target->fields[i]);
+        for (size_t j = 0; j < source->field_count; j++)
+        {
+            if ((used[j] == 0U) && (strcmp(key, field_key(&source->fields[j])) == 0))
+            {
+                source_of[i] = j;
+                used[j] = 1U;
+                break;
+            }
+        }
+    }
+}
+
+static size_t inline_size(const struct_meta_field *field)
+{
+    if (field->kind == STRUCT_META_FIELD_CHAR_ARRAY)
+    {
+        return field->char_buffer_size;
+    }
+    return field->element_size * field->element_count;
+}
+
+static int plan_struct(migration_plan *plan, const struct_meta_descriptor *source, size_t source_base,
+                       const struct_meta_descriptor *target, size_t target_base, struct_meta_migration *top,
+                       int *converted_out);
+
+/**
+ *  @brief          対応付けた 2 個のフィールドの操作を加えます。
+ *  @param[out]     converted_out 値をバイト列のまま複写できない場合は 1 です。
+ */
+static int plan_field(migration_plan *plan, const struct_meta_field *source, size_t source_base,
+                      const struct_meta_field *target, size_t target_base, int *converted_out)
+{
+    int source_struct = (source->kind == STRUCT_META_FIELD_STRUCT) ? 1 : 0;
+    int source_chars = (source->kind == STRUCT_META_FIELD_CHAR_ARRAY) ? 1 : 0;
+    if ((source_struct != ((target->kind == STRUCT_META_FIELD_STRUCT) ? 1 : 0)) ||
+        (source_chars != ((target->kind == STRUCT_META_FIELD_CHAR_ARRAY) ? 1 : 0)))
+    {
+        return COM_UTIL_ERR_UNSUPPORTED;
+    }
+
+    size_t source_offset = source_base + source->offset;
+    size_t target_offset = target_base + target->offset;
+    if (source_chars != 0)
+    {
+        *converted_out = (source->char_buffer_size != target->char_buffer_size) ? 1 : 0;
+        return append_op(plan, (*converted_out != 0) ? MIGRATION_OP_CHARS : MIGRATION_OP_COPY, source_offset,
+                         target_offset, source->char_buffer_size, target->char_buffer_size);
+    }
+
+    size_t count = (source->element_count < target->element_count) ? source->element_count : target->element_count;
+    int converted = (source->element_count != target->element_count) ? 1 : 0;
+    int ret = COM_UTIL_OK;
+    if (source_struct != 0)
+    {
+        for (size_t i = 0; (ret == COM_UTIL_OK) && (i < count); i++)
+        {
+            int nested_converted = 0;
+            ret = plan_struct(plan, source->nested, source_offset + (i * source->element_size), target->nested,
+                              target_offset + (i * target->element_size), NULL, &nested_converted);
+            converted |= nested_converted;
+        }
+    }
+    else if ((source->kind == target->kind) && (source->element_size == target->element_size))
+    {
+        ret = append_op(plan, MIGRATION_OP_COPY, source_offset, target_offset, count * source->element_size,
+                        count * target->element_size);
+    }
+    else
+    {
+        converted = 1;
+        for (size_t i = 0; (ret == COM_UTIL_OK) && (i < count); i++)
+        {
+            ret = append_op(plan, MIGRATION_OP_CONVERT, source_offset + (i * source->element_size),
+                            target_offset + (i * target->element_size), source->element_size, target->element_size);
+            if (ret == COM_UTIL_OK)
+            {
+                plan->ops[plan->op_count - 1U].source_kind = source->kind;
+                plan->ops[plan->op_count - 1U].target_kind = target->kind;
+            }
+        }
+    }
+
+    if ((ret == COM_UTIL_OK) && (count < target->element_count))
+    {
+        size_t rest = (target->element_count - count) * target->element_size;
+        ret = append_op(plan, MIGRATION_OP_ZERO, 0U, target_offset + (count * target->element_size), 0U, rest);
+    }
+    *converted_out = converted;
+    return ret;
+}
+
+/**
+ *  @brief          移行先の構造体 1 個の操作を加えます。
+ *  @param[in,out]  top 最上位の構造体の場合は、フィールドの対応を記録する計画です。ネスト先では NULL です。
+ *  @param[out]     converted_out バイト列のまま複写できないフィールドがある場合は 1 です。
+ */
+static int plan_struct(migration_plan *plan, const struct_meta_descriptor *source, size_t source_base,
+                       const struct_meta_descriptor *target, size_t target_base, struct_meta_migration *top,
+                       int *converted_out)
+{
+    size_t *source_of = NULL;
+    unsigned char *used = NULL;
+    if (target->field_count > 0U)
+    {
+        source_of = (size_t *)malloc(target->field_count * sizeof(*source_of));
+    }
+    if (source->field_count > 0U)
+    {
+        used = (unsigned char *)malloc(source->field_count);
+    }
+    if (((target->field_count > 0U) && (source_of == NULL)) || ((source->field_count > 0U) && (used == NULL)))
+    {
+        free(source_of);
+        free(used);
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    match_fields(source, target, source_of, used);
+
+    int ret = COM_UTIL_OK;
+    int converted = (source->size != target->size) ? 1 : 0;
+    for (size_t i = 0; (ret == COM_UTIL_OK) && (i < target->field_count); i++)
+    {
+        const struct_meta_field *target_field = &target->fields[i];
+        const struct_meta_field *source_field = (source_of[i] != SIZE_MAX) ? &source->fields[source_of[i]] : NULL;
+        struct_meta_migration_action action = STRUCT_META_MIGRATION_ADDED;
+        if (source_field == NULL)
+        {
+            ret = append_op(plan, MIGRATION_OP_ZERO, 0U, target_base + target_field->offset, 0U,
+                            inline_size(target_field));
+            converted = 1;
+        }
+        else
+        {
+            int field_converted = 0;
+            ret = plan_field(plan, source_field, source_base, target_field, target_base, &field_converted);
+            action = (field_converted != 0) ? STRUCT_META_MIGRATION_CONVERT : STRUCT_META_MIGRATION_COPY;
+            if ((field_converted != 0) || (source_field->offset != target_field->offset))
+            {
+                converted = 1;
+            }
+        }
+        if (top != NULL)
+        {
+            top->fields[i].target = target_field;
+            top->fields[i].source = source_field;
+            top->fields[i].action = action;
+            top->fields[i].renamed =
+                ((source_field != NULL) && (strcmp(source_field->name, target_field->name) != 0)) ? 1 : 0;
+        }
+    }
+
+    for (size_t j = 0; (ret == COM_UTIL_OK) && (j < source->field_count); j++)
+    {
+        if (used[j] != 0U)
+        {
+            continue;
+        }
+        converted = 1;
+        if (top != NULL)
+        {
+            top->removed[top->removed_count] = &source->fields[j];
+            top->removed_count++;
+        }
+    }
+
+    free(source_of);
+    free(used);
+    *converted_out = converted;
+    return ret;
+}
+
+static int compare_ops(const void *left, const void *right)
+{
+    const migration_op *a = (const migration_op *)left;
+    const migration_op *b = (const migration_op *)right;
+    if (a->target_offset != b->target_offset)
+    {
+        return (a->target_offset < b->target_offset) ? -1 : 1;
+    }
+    if (a->source_offset != b->source_offset)
+    {
+        return (a->source_offset < b->source_offset) ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ *  @brief          操作を移行先のオフセット順に並べ、複写をまとめ、区切りの操作を除きます。
+ *
+ *  隣り合う 2 個の複写は、移行元と移行先で同じ間隔にある場合に 1 個へまとめます。
+ *  間の範囲は移行先のフィールドを含まない (含めば区切りの操作が間に並ぶ) ため、パディングの複写だけが増えます。
+ */
+static void compact_ops(migration_plan *plan, const struct_meta_descriptor *target, int converted)
+{
+    if (plan->op_count > 1U)
+    {
+        qsort(plan->ops, plan->op_count, sizeof(*plan->ops), compare_ops);
+    }
+
+    size_t count = 0U;
+    for (size_t i = 0; i < plan->op_count; i++)
+    {
+        migration_op op = plan->ops[i];
+        if (count > 0U)
+        {
+            migration_op *last = &plan->ops[count - 1U];
+            if ((last->kind == MIGRATION_OP_COPY) && (op.kind == MIGRATION_OP_COPY) &&
+                (op.source_offset >= (last->source_offset + last->source_length)) &&
+                ((op.target_offset - last->target_offset) == (op.source_offset - last->source_offset)))
+            {
+                last->source_length = (op.source_offset + op.source_length) - last->source_offset;
+                last->target_length = last->source_length;
+                continue;
+            }
+            if (last->kind == MIGRATION_OP_ZERO)
+            {
+                /* 区切りの役目を終えたため、次の操作で上書きする。 */
+                count--;
+            }
+        }
+        plan->ops[count] = op;
+        count++;
+    }
+    if ((count > 0U) && (plan->ops[count - 1U].kind == MIGRATION_OP_ZERO))
+    {
+        count--;
+    }
+    plan->op_count = count;
+
+    /*
+     * 同じレイアウトの移行は、末尾のパディングまで含めた 1 回の複写とし、0 で埋める手間も省く。
+     * 追加や削除があると、まとめた複写が 1 個でも、その外側を 0 で埋める必要がある。
+     */
+    if ((converted == 0) && (count == 1U) && (plan->ops[0].kind == MIGRATION_OP_COPY) &&
+        (plan->ops[0].source_offset == 0U) && (plan->ops[0].target_offset == 0U))
+    {
+        plan->ops[0].source_length = target->size;
+        plan->ops[0].target_length = target->size;
+        plan->full_copy = 1;
+    }
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_migration_init(const struct_meta_descriptor *source, const struct_meta_descriptor *target,
+                               struct_meta_migration *migration_out)
+{
+    if (migration_out == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    memset(migration_out, 0, sizeof(*migration_out));
+    if ((source == NULL) || (target == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    int ret = struct_meta_internal_descriptor_acquire(source, NULL);
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_internal_descriptor_acquire(target, NULL);
+    }
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    /* 文字列と可変長配列は別領域を指すため、バイト列の複写では移せない。 */
+    if ((struct_meta_internal_descriptor_has_dynamic(source) != 0) ||
+        (struct_meta_internal_descriptor_has_dynamic(target) != 0))
+    {
+        return COM_UTIL_ERR_UNSUPPORTED;
+    }
+
+    migration_plan *plan = (migration_plan *)calloc(1U, sizeof(*plan));
+    if (plan == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    migration_out->source = source;
+    migration_out->target = target;
+    migration_out->source_fingerprint = struct_meta_internal_binary_fingerprint(source);
+    migration_out->target_fingerprint = struct_meta_internal_binary_fingerprint(target);
+    migration_out->field_count = target->field_count;
+    migration_out->plan = plan;
+    if (target->field_count > 0U)
+    {
+        migration_out->fields =
+            (struct_meta_migration_field *)calloc(target->field_count, sizeof(*migration_out->fields));
+    }
+    if (source->field_count > 0U)
+    {
+        migration_out->removed =
+            (const struct_meta_field **)calloc(source->field_count, sizeof(*migration_out->removed));
+    }
+    if (((target->field_count > 0U) && (migration_out->fields == NULL)) ||
+        ((source->field_count > 0U) && (migration_out->removed == NULL)))
+    {
+        struct_meta_migration_dispose(migration_out);
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+
+    int converted = 0;
+    ret = plan_struct(plan, source, 0U, target, 0U, migration_out, &converted);
+    if (ret != COM_UTIL_OK)
+    {
+        struct_meta_migration_dispose(migration_out);
+        return ret;
+    }
+    compact_ops(plan, target, converted);
+    migration_out->op_count = plan->op_count;
+    return COM_UTIL_OK;
+}
+
+static void load_scalar(struct_meta_field_kind kind, const unsigned char *ptr, size_t size, scalar_value *value)
+{
+    value->is_real = is_real_kind(kind);
+    value->sign = 1;
+    value->magnitude = 0U;
+    value->real = 0.0;
+    if (kind == STRUCT_META_FIELD_FLOAT)
+    {
+        float real;
+        memcpy(&real, ptr, sizeof(real));
+        value->real = (double)real;
+        return;
+    }
+    if (kind == STRUCT_META_FIELD_DOUBLE)
+    {
+        memcpy(&value->real, ptr, sizeof(value->real));
+        return;
+    }
+    if (struct_meta_internal_integer_class_of(kind) == STRUCT_META_INTERNAL_INTEGER_SIGNED)
+    {
+        int64_t integer = struct_meta_internal_load_signed(ptr, size);
+        if (integer < 0)
+        {
+            /* INT64_MIN の絶対値は int64_t で表せないため、1 を足してから符号を反転する。 */
+            value->sign = -1;
+            value->magnitude = (uint64_t)(-(integer + 1)) + 1U;
+        }
+        else
+        {
+            value->magnitude = (uint64_t)integer;
+        }
+        return;
+    }
+    value->magnitude = struct_meta_internal_load_unsigned(ptr, size);
+}
+
+static int store_scalar(struct_meta_field_kind kind, unsigned char *ptr, size_t size, const scalar_value *value)
+{
+    if (is_real_kind(kind) != 0)
+    {
+        double real = value->real;
+        if (value->is_real == 0)
+        {
+            real = (value->sign < 0) ? -(double)value->magnitude : (double)value->magnitude;
+        }
+        if (kind == STRUCT_META_FIELD_FLOAT)
+        {
+            float narrowed = (float)real;
+            memcpy(ptr, &narrowed, sizeof(narrowed));
+        }
+        else
+        {
+            memcpy(ptr, &real, sizeof(real));
+        }
+        return COM_UTIL_OK;
+    }
+
+    int sign = value->sign;
+    uint64_t magnitude = value->magnitude;
+    if (value->is_real != 0)
+    {
+        /* 小数部を持つ値と、正確に表せる範囲を超える値は、整数へ移すと値が変わるため拒否する。 */
+        sign = struct_meta_internal_integer_from_double(value->real, &magnitude);
+        if (sign == 0)
+        {
+            return COM_UTIL_ERR_OUT_OF_RANGE;
+        }
+    }
+    if (struct_meta_internal_integer_class_of(kind) == STRUCT_META_INTERNAL_INTEGER_BOOL)
+    {
+        if ((sign < 0) && (magnitude != 0U))
+        {
+            return COM_UTIL_ERR_OUT_OF_RANGE;
+        }
+        return struct_meta_internal_store_bool(ptr, magnitude);
+    }
+    return struct_meta_internal_store_integer(kind, ptr, size, sign, magnitude);
+}
+
+static int run_op(const migration_op *op, const unsigned char *source, unsigned char *target)
+{
+    switch (op->kind)
+    {
+    case MIGRATION_OP_COPY:
+        memcpy(target + op->target_offset, source + op->source_offset, op->source_length);
+        return COM_UTIL_OK;
+    case MIGRATION_OP_CHARS:
+    {
+        const unsigned char *text = source + op->source_offset;
+        const unsigned char *terminator = (const unsigned char *)memchr(text, '\0', op->source_length);
+        size_t length = (terminator != NULL) ? (size_t)(terminator - text) : op->source_length;
+        if (length >= op->target_length)
+        {
+            return COM_UTIL_ERR_OUT_OF_RANGE;
+        }
+        /* 移行先は 0 で埋めてあるため、NUL 終端は書き込み済みである。 */
+        memcpy(target + op->target_offset, text, length);
+        return COM_UTIL_OK;
+    }
+    case MIGRATION_OP_CONVERT:
+    {
+        scalar_value value;
+        load_scalar(op->source_kind, source + op->source_offset, op->source_length, &value);
+        return store_scalar(op->target_kind, target + op->target_offset, op->target_length, &value);
+    }
+    case MIGRATION_OP_ZERO:
+    default:
+        return COM_UTIL_OK;
+    }
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_migration_apply(const struct_meta_migration *migration, const void *source, void *target)
+{
+    if ((migration == NULL) || (migration->plan == NULL) || (source == NULL) || (target == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    const migration_plan *plan = (const migration_plan *)migration->plan;
+    if (plan->full_copy == 0)
+    {
+        memset(target, 0, migration->target->size);
+    }
+    for (size_t i = 0; i < plan->op_count; i++)
+    {
+        int ret = run_op(&plan->ops[i], (const unsigned char *)source, (unsigned char *)target);
+        if (ret != COM_UTIL_OK)
+        {
+            return ret;
+        }
+    }
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_migration_apply_array(const struct_meta_migration *migration, const void *sources, size_t count,
+                                      void *targets)
+{
+    if ((migration == NULL) || (migration->plan == NULL) || ((count > 0U) && ((sources == NULL) || (targets == NULL))))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    const unsigned char *source = (const unsigned char *)sources;
+    unsigned char *target = (unsigned char *)targets;
+    for (size_t i = 0; i < count; i++)
+    {
+        int ret = struct_meta_migration_apply(migration, source + (i * migration->source->size),
+                                              target + (i * migration->target->size));
+        if (ret != COM_UTIL_OK)
+        {
+            return ret;
+        }
+    }
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_migration_dispose(struct_meta_migration *migration)
+{
+    if (migration == NULL)
+    {
+        return;
+    }
+    migration_plan *plan = (migration_plan *)migration->plan;
+    if (plan != NULL)
+    {
+        free(plan->ops);
+        free(plan);
+    }
+    free(migration->fields);
+    free((void *)migration->removed);
+    memset(migration, 0, sizeof(*migration));
+}
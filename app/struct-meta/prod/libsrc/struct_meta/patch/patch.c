@@ -18,6 +18,8 @@
 #include <struct_meta/patch/patch.h>
 
 #include <struct_meta/access/access.h>
+#include <struct_meta/meta/registry.h>
+#include <struct_meta/meta/scalar.h>
 
 #include <com_util/base/result.h>
 #include <com_util/prompt/prompt.h>
@@ -91,10 +93,10 @@ static int append_index_path(const char *path, size_t index, char **path_out)
 /**
  *  @brief          フィールド 1 個分の現在値を、一覧表示用に短く整形します。
  */
-static void format_scalar_value(struct_meta_field_kind kind, const unsigned char *field_ptr, char *dest,
+static void format_scalar_value(const struct_meta_field *field, const unsigned char *field_ptr, char *dest,
                                 size_t dest_size)
 {
-    switch (kind)
+    switch (field->kind)
     {
     case STRUCT_META_FIELD_INT:
     {
@@ -124,9 +126,33 @@ static void format_scalar_value(struct_meta_field_kind kind, const unsigned char
         snprintf(dest, dest_size, "%g", value);
         break;
     }
+    case STRUCT_META_FIELD_INT8:
+    case STRUCT_META_FIELD_INT16:
+    case STRUCT_META_FIELD_INT64:
+    case STRUCT_META_FIELD_UINT8:
+    case STRUCT_META_FIELD_UINT16:
+    case STRUCT_META_FIELD_UINT64:
+    case STRUCT_META_FIELD_BOOL:
+    case STRUCT_META_FIELD_ENUM:
+        (void)struct_meta_internal_format_integer(field->kind, field_ptr, field->element_size, dest, dest_size);
+        break;
     case STRUCT_META_FIELD_CHAR_ARRAY:
         snprintf(dest, dest_size, "\"%s\"", (const char *)field_ptr);
         break;
+    case STRUCT_META_FIELD_STRING:
+    {
+        const char *text;
+        memcpy((void *)&text, field_ptr, sizeof(text));
+        if (text == NULL)
+        {
+            snprintf(dest, dest_size, "(null)");
+        }
+        else
+        {
+            snprintf(dest, dest_size, "\"%s\"", text);
+        }
+        break;
+    }
     case STRUCT_META_FIELD_STRUCT:
     default:
         snprintf(dest, dest_size, "{...}");
@@ -175,6 +201,62 @@ static int parse_unsigned(const char *text, unsigned int *value_out)
     return COM_UTIL_OK;
 }
 
+/**
+ *  @brief          入力行を整数、bool、列挙の値へ変換し、範囲を確認して書き込みます。
+ *
+ *  64 ビットの値も double を経由せずに変換します。bool は `true`、`false`、`1`、`0` を受け付けます。
+ */
+static int parse_integer(const struct_meta_field *field, const char *text, unsigned char *field_ptr)
+{
+    if (text[0] == '\0')
+    {
+        return COM_UTIL_ERR_EOF;
+    }
+    char *end = NULL;
+    switch (struct_meta_internal_integer_class_of(field->kind))
+    {
+    case STRUCT_META_INTERNAL_INTEGER_SIGNED:
+    {
+        errno = 0;
+        long long value = strtoll(text, &end, 10);
+        if ((end == text) || (*end != '\0') || (errno != 0) ||
+            (struct_meta_internal_store_signed(field_ptr, field->element_size, (int64_t)value) != COM_UTIL_OK))
+        {
+            return COM_UTIL_ERR_INVALID_INTEGER;
+        }
+        return COM_UTIL_OK;
+    }
+    case STRUCT_META_INTERNAL_INTEGER_UNSIGNED:
+    {
+        if (text[0] == '-')
+        {
+            return COM_UTIL_ERR_INVALID_INTEGER;
+        }
+        errno = 0;
+        unsigned long long value = strtoull(text, &end, 10);
+        if ((end == text) || (*end != '\0') || (errno != 0) ||
+            (struct_meta_internal_store_unsigned(field_ptr, field->element_size, (uint64_t)value) != COM_UTIL_OK))
+        {
+            return COM_UTIL_ERR_INVALID_INTEGER;
+        }
+        return COM_UTIL_OK;
+    }
+    case STRUCT_META_INTERNAL_INTEGER_BOOL:
+        if ((strcmp(text, "true") == 0) || (strcmp(text, "1") == 0))
+        {
+            return struct_meta_internal_store_bool(field_ptr, 1U);
+        }
+        if ((strcmp(text, "false") == 0) || (strcmp(text, "0") == 0))
+        {
+            return struct_meta_internal_store_bool(field_ptr, 0U);
+        }
+        return COM_UTIL_ERR_INVALID_INTEGER;
+    case STRUCT_META_INTERNAL_INTEGER_NONE:
+    default:
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+}
+
 static int parse_double(const char *text, double *value_out)
 {
     if (text[0] == '\0')
@@ -203,7 +285,7 @@ static int patch_scalar(com_util_prompt *prompt, const struct_meta_field *field,
     char line[STRUCT_META_PATCH_LINE_BYTES];
     char current[64];
 
-    format_scalar_value(field->kind, field_ptr, current, sizeof(current));
+    format_scalar_value(field, field_ptr, current, sizeof(current));
 
     for (;;)
     {
@@ -270,6 +352,26 @@ static int patch_scalar(com_util_prompt *prompt, const struct_meta_field *field,
             printf("数値として解釈できません: %s\n", line);
             break;
         }
+        case STRUCT_META_FIELD_INT8:
+        case STRUCT_META_FIELD_INT16:
+        case STRUCT_META_FIELD_INT64:
+        case STRUCT_META_FIELD_UINT8:
+        case STRUCT_META_FIELD_UINT16:
+        case STRUCT_META_FIELD_UINT64:
+        case STRUCT_META_FIELD_ENUM:
+            if (parse_integer(field, line, field_ptr) == COM_UTIL_OK)
+            {
+                return COM_UTIL_OK;
+            }
+            printf("整数として解釈できないか、範囲外です: %s\n", line);
+            break;
+        case STRUCT_META_FIELD_BOOL:
+            if (parse_integer(field, line, field_ptr) == COM_UTIL_OK)
+            {
+                return COM_UTIL_OK;
+            }
+            printf("true または false を入力してください: %s\n", line);
+            break;
         case STRUCT_META_FIELD_CHAR_ARRAY:
         {
             size_t text_len = strlen(line);
@@ -282,8 +384,9 @@ static int patch_scalar(com_util_prompt *prompt, const struct_meta_field *field,
             return COM_UTIL_OK;
         }
         case STRUCT_META_FIELD_STRUCT:
+        case STRUCT_META_FIELD_STRING:
         default:
-            /* ここには到達しない (呼び出し元がスカラーだけを渡す)。 */
+            /* ここには到達しない (呼び出し元が編集できるスカラーだけを渡す)。 */
             return COM_UTIL_ERR_INVALID_ARGUMENT;
         }
     }
@@ -299,6 +402,12 @@ static int patch_element(com_util_prompt *prompt, const struct_meta_field *field
     {
         return patch_struct(prompt, field->nested, elem_ptr, path);
     }
+    if (field->kind == STRUCT_META_FIELD_STRING)
+    {
+        /* 文字列の領域を確保したアロケーターが分からないため、値は置き換えない。 */
+        printf("%s は文字列のため、対話編集では変更できません。\n", path);
+        return COM_UTIL_OK;
+    }
     int ret = patch_scalar(prompt, field, elem_ptr, path);
     if (ret == COM_UTIL_ERR_EOF)
     {
@@ -308,18 +417,52 @@ static int patch_element(com_util_prompt *prompt, const struct_meta_field *field
     return ret;
 }
 
+/**
+ *  @brief          要素選択を表示する配列フィールド (char 配列以外の固定長配列、または可変長配列) かを返します。
+ */
+static int is_array_field(const struct_meta_field *field)
+{
+    return (field->storage == STRUCT_META_STORAGE_SEQUENCE) ||
+           ((field->kind != STRUCT_META_FIELD_CHAR_ARRAY) && (field->element_count > 1U));
+}
+
+/**
+ *  @brief          配列フィールドの要素の先頭と要素数を返します。可変長配列では items と count です。
+ *  @param[in]      field 配列フィールドです。
+ *  @param[in]      field_ptr フィールドの先頭です。
+ *  @param[out]     count_out 要素数です。
+ */
+static unsigned char *array_items(const struct_meta_field *field, unsigned char *field_ptr, size_t *count_out)
+{
+    if (field->storage == STRUCT_META_STORAGE_SEQUENCE)
+    {
+        const struct_meta_sequence *sequence = (const struct_meta_sequence *)(void *)field_ptr;
+        *count_out = sequence->count;
+        return (unsigned char *)sequence->items;
+    }
+    *count_out = field->element_count;
+    return field_ptr;
+}
+
 /**
  *  @brief          配列フィールドの要素インデックスをメニュー形式で選択させ、選択した要素を編集します。
+ *
+ *  可変長配列は既存の要素だけを編集し、要素数は変更しません。
  */
-static int patch_array_field(com_util_prompt *prompt, const struct_meta_field *field, unsigned char *field_ptr,
-                             const char *path)
+static int patch_array_field(com_util_prompt *prompt, const struct_meta_field *field, unsigned char *items,
+                             size_t count, const char *path)
 {
     char line[STRUCT_META_PATCH_LINE_BYTES];
 
+    if (count == 0U)
+    {
+        printf("%s は要素がありません。\n", path);
+        return COM_UTIL_OK;
+    }
     for (;;)
     {
-        printf("-- %s (現在位置: %s、配列、要素数 %zu) --\n", field->name, path, field->element_count);
-        for (size_t i = 0; i < field->element_count; i++)
+        printf("-- %s (現在位置: %s、配列、要素数 %zu) --\n", field->name, path, count);
+        for (size_t i = 0; i < count; i++)
         {
             char *element_path;
             int path_ret = append_index_path(path, i, &element_path);
@@ -342,13 +485,13 @@ static int patch_array_field(com_util_prompt *prompt, const struct_meta_field *f
         }
 
         int index;
-        if ((parse_int(line, &index) != COM_UTIL_OK) || (index < 0) || ((size_t)index >= field->element_count))
+        if ((parse_int(line, &index) != COM_UTIL_OK) || (index < 0) || ((size_t)index >= count))
         {
-            printf("0 から %zu の範囲で入力してください。\n", field->element_count - 1U);
+            printf("0 から %zu の範囲で入力してください。\n", count - 1U);
             continue;
         }
 
-        unsigned char *element = field_ptr + ((size_t)index * field->element_size);
+        unsigned char *element = items + ((size_t)index * field->element_size);
         char *element_path;
         ret = append_index_path(path, (size_t)index, &element_path);
         if (ret == COM_UTIL_OK)
@@ -390,14 +533,6 @@ static int patch_struct(com_util_prompt *prompt, const struct_meta_descriptor *d
             {
                 return path_ret;
             }
-            void *element;
-            int access_ret = struct_meta_field_get_element(field, base, 0U, &element);
-            if (access_ret != COM_UTIL_OK)
-            {
-                free(field_path);
-                return access_ret;
-            }
-            unsigned char *field_ptr = (unsigned char *)element;
             const char *brief = "";
             const char *brief_sep = "";
 
@@ -407,7 +542,13 @@ static int patch_struct(com_util_prompt *prompt, const struct_meta_descriptor *d
                 brief = field->brief;
             }
 
-            if (field->kind == STRUCT_META_FIELD_STRUCT)
+            if (field->storage == STRUCT_META_STORAGE_SEQUENCE)
+            {
+                size_t count;
+                (void)array_items(field, base + field->offset, &count);
+                printf("  %zu) %s [可変長配列 %zu 件]%s%s\n", i + 1U, field_path, count, brief_sep, brief);
+            }
+            else if (field->kind == STRUCT_META_FIELD_STRUCT)
             {
                 if (field->element_count > 1U)
                 {
@@ -424,8 +565,15 @@ static int patch_struct(com_util_prompt *prompt, const struct_meta_descriptor *d
             }
             else
             {
+                void *element;
+                int access_ret = struct_meta_field_get_element(field, base, 0U, &element);
+                if (access_ret != COM_UTIL_OK)
+                {
+                    free(field_path);
+                    return access_ret;
+                }
                 char current[64];
-                format_scalar_value(field->kind, field_ptr, current, sizeof(current));
+                format_scalar_value(field, (const unsigned char *)element, current, sizeof(current));
                 printf("  %zu) %s = %s%s%s\n", i + 1U, field_path, current, brief_sep, brief);
             }
             free(field_path);
@@ -455,14 +603,11 @@ static int patch_struct(com_util_prompt *prompt, const struct_meta_descriptor *d
         {
             return ret;
         }
-        if ((field->kind != STRUCT_META_FIELD_CHAR_ARRAY) && (field->element_count > 1U))
+        if (is_array_field(field) != 0)
         {
-            void *element;
-            ret = struct_meta_field_get_element(field, base, 0U, &element);
-            if (ret == COM_UTIL_OK)
-            {
-                ret = patch_array_field(prompt, field, (unsigned char *)element, field_path);
-            }
+            size_t count;
+            unsigned char *items = array_items(field, base + field->offset, &count);
+            ret = patch_array_field(prompt, field, items, count, field_path);
         }
         else
         {
@@ -503,6 +648,13 @@ static int path_has_terminal_index(const char *path)
  */
 static int patch_target(const struct_meta_field *field, unsigned char *value, const char *path, int edit_array)
 {
+    size_t count = 0U;
+    unsigned char *items = NULL;
+    if (edit_array != 0)
+    {
+        items = array_items(field, value, &count);
+    }
+
     com_util_prompt *prompt = com_util_prompt_create(NULL);
     if (prompt == NULL)
     {
@@ -512,7 +664,7 @@ static int patch_target(const struct_meta_field *field, unsigned char *value, co
     int ret;
     if (edit_array != 0)
     {
-        ret = patch_array_field(prompt, field, value, path);
+        ret = patch_array_field(prompt, field, items, count, path);
     }
     else
     {
@@ -536,7 +688,7 @@ int struct_meta_patch_interactive(const struct_meta_descriptor *desc, void *inst
         return COM_UTIL_ERR_INVALID_ARGUMENT;
     }
 
-    int ret = struct_meta_descriptor_validate(desc);
+    int ret = struct_meta_internal_descriptor_acquire(desc, NULL);
     if (ret != COM_UTIL_OK)
     {
         return ret;
@@ -575,8 +727,7 @@ int struct_meta_patch_path_interactive(const struct_meta_descriptor *desc, void
         return ret;
     }
 
-    int edit_array = (field->kind != STRUCT_META_FIELD_CHAR_ARRAY) && (field->element_count > 1U) &&
-                     (path_has_terminal_index(path) == 0);
+    int edit_array = (is_array_field(field) != 0) && (path_has_terminal_index(path) == 0);
     ret = patch_target(field, (unsigned char *)value, path, edit_array);
     return ret;
 }
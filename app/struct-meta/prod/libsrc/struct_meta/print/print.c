@@ -14,6 +14,8 @@
 #include <struct_meta/print/print.h>
 
 #include <struct_meta/access/access.h>
+#include <struct_meta/meta/registry.h>
+#include <struct_meta/meta/scalar.h>
 
 #include <com_util/base/result.h>
 
@@ -29,10 +31,10 @@ static void print_indent(FILE *out, int indent)
     }
 }
 
-static void format_scalar_value(struct_meta_field_kind kind, const unsigned char *field_ptr, char *dest,
+static void format_scalar_value(const struct_meta_field *field, const unsigned char *field_ptr, char *dest,
                                 size_t dest_size)
 {
-    switch (kind)
+    switch (field->kind)
     {
     case STRUCT_META_FIELD_INT:
     {
@@ -62,9 +64,33 @@ static void format_scalar_value(struct_meta_field_kind kind, const unsigned char
         snprintf(dest, dest_size, "%g", value);
         break;
     }
+    case STRUCT_META_FIELD_INT8:
+    case STRUCT_META_FIELD_INT16:
+    case STRUCT_META_FIELD_INT64:
+    case STRUCT_META_FIELD_UINT8:
+    case STRUCT_META_FIELD_UINT16:
+    case STRUCT_META_FIELD_UINT64:
+    case STRUCT_META_FIELD_BOOL:
+    case STRUCT_META_FIELD_ENUM:
+        (void)struct_meta_internal_format_integer(field->kind, field_ptr, field->element_size, dest, dest_size);
+        break;
     case STRUCT_META_FIELD_CHAR_ARRAY:
         snprintf(dest, dest_size, "\"%s\"", (const char *)field_ptr);
         break;
+    case STRUCT_META_FIELD_STRING:
+    {
+        const char *text = NULL;
+        memcpy((void *)&text, field_ptr, sizeof(text));
+        if (text != NULL)
+        {
+            snprintf(dest, dest_size, "\"%s\"", text);
+        }
+        else
+        {
+            snprintf(dest, dest_size, "(null)");
+        }
+        break;
+    }
     case STRUCT_META_FIELD_STRUCT:
     default:
         snprintf(dest, dest_size, "{...}");
@@ -90,7 +116,7 @@ static int print_element(const struct_meta_field *field, const unsigned char *el
 
     {
         char current[64];
-        format_scalar_value(field->kind, elem_ptr, current, sizeof(current));
+        format_scalar_value(field, elem_ptr, current, sizeof(current));
         print_indent(out, indent);
         fprintf(out, "%s = %s\n", label, current);
     }
@@ -99,7 +125,23 @@ static int print_element(const struct_meta_field *field, const unsigned char *el
 
 static int print_field(const struct_meta_field *field, const unsigned char *base, FILE *out, int indent)
 {
-    if ((field->kind == STRUCT_META_FIELD_CHAR_ARRAY) || (field->element_count <= 1U))
+    size_t count = field->element_count;
+    if (field->storage == STRUCT_META_STORAGE_SEQUENCE)
+    {
+        const struct_meta_sequence *sequence = (const struct_meta_sequence *)(const void *)(base + field->offset);
+        if ((sequence->items == NULL) && (sequence->count > 0U))
+        {
+            return COM_UTIL_ERR_INVALID_ARGUMENT;
+        }
+        count = sequence->count;
+        if (count == 0U)
+        {
+            print_indent(out, indent);
+            fprintf(out, "%s = []\n", field->name);
+            return COM_UTIL_OK;
+        }
+    }
+    else if ((field->kind == STRUCT_META_FIELD_CHAR_ARRAY) || (field->element_count <= 1U))
     {
         const void *element;
         int ret = struct_meta_field_get_const_element(field, base, 0U, &element);
@@ -113,7 +155,7 @@ static int print_field(const struct_meta_field *field, const unsigned char *base
     {
         size_t i;
         char label[128];
-        for (i = 0; i < field->element_count; i++)
+        for (i = 0; i < count; i++)
         {
             int ret;
             snprintf(label, sizeof(label), "%s[%zu]", field->name, i);
@@ -155,7 +197,7 @@ int struct_meta_print_write(const struct_meta_descriptor *desc, const void *inst
         return COM_UTIL_ERR_INVALID_ARGUMENT;
     }
 
-    int ret = struct_meta_descriptor_validate(desc);
+    int ret = struct_meta_internal_descriptor_acquire(desc, NULL);
     if (ret != COM_UTIL_OK)
     {
         return ret;
@@ -0,0 +1,318 @@
+/**
+ *******************************************************************************
+ *  @file           snapshot.c
+ *  @brief          公開中の版の atomic な置き換えと、世代による旧版の回収を実装します。
+ *
+ *  読み手は、世代を読んで自分の枠へ書き、フェンスの後に公開中のポインターを読みます。
+ *  書き手は、ポインターを置き換え、フェンスの後に世代を進め、旧版に進める前の世代を記録します。
+ *  両者のフェンスにより、書き手が枠の書き込みを見逃した読み手は、必ず置き換え後のポインターを読みます。
+ *  置き換えより後に世代を読んだ読み手も、置き換え後のポインターを読みます。\n
+ *  したがって旧版を参照し得るのは、旧版の世代以下の値を枠に示す読み手だけで、そのような読み手がいなければ解放できます。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/snapshot/snapshot.h>
+
+#include <struct_meta/base/atomic.h>
+#include <struct_meta/json/file.h>
+#include <struct_meta/memory/allocator.h>
+#include <struct_meta/meta/registry.h>
+
+#include <com_util/base/platform.h>
+#include <com_util/base/result.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(COMPILER_MSVC)
+    #include <malloc.h>
+#endif /* COMPILER_MSVC */
+
+/** 読み手の枠の間隔のバイト数です。隣の枠の書き込みで、キャッシュ ラインを奪い合わないようにします。 */
+#define SNAPSHOT_READER_STRIDE 64U
+
+/** 読み手 1 個の枠です。 */
+struct struct_meta_snapshot_reader
+{
+    struct_meta_snapshot *snapshot; /**< 枠が属する対象です。 */
+    void *owner;                    /**< 確保済みの場合は枠自身を指します (atomic)。 */
+    uint64_t epoch;                 /**< pin した時点の世代です。pin していない場合は 0 です (atomic)。 */
+    /** 枠の大きさを SNAPSHOT_READER_STRIDE へ揃えます。 */
+    unsigned char pad[SNAPSHOT_READER_STRIDE - (2U * sizeof(void *)) - sizeof(uint64_t)];
+};
+
+/** 回収待ちの旧版です。 */
+struct struct_meta_snapshot_retired
+{
+    void *instance;                     /**< 旧版のインスタンスです。 */
+    struct_meta_snapshot_retired *next; /**< 次の旧版です。 */
+    uint64_t epoch;                     /**< 置き換えた時点の世代です。 */
+};
+
+/**
+ *  @brief          読み手の枠の配列を、0 で埋めて SNAPSHOT_READER_STRIDE バイト境界に確保します。
+ *
+ *  枠の先頭をキャッシュ ラインの先頭へそろえ、1 個の枠が 2 本のキャッシュ ラインにまたがらないようにします。
+ *  解放には free_readers() を使います。
+ */
+static struct_meta_snapshot_reader *allocate_readers(size_t capacity)
+{
+    if (capacity > (SIZE_MAX / sizeof(struct_meta_snapshot_reader)))
+    {
+        return NULL;
+    }
+    size_t size = capacity * sizeof(struct_meta_snapshot_reader);
+#if defined(COMPILER_MSVC)
+    /* MSVC の C ランタイムは aligned_alloc() を提供しないため、_aligned_malloc() を使う。 */
+    void *readers = _aligned_malloc(size, SNAPSHOT_READER_STRIDE);
+#else  /* !COMPILER_MSVC */
+    /* 枠の大きさは SNAPSHOT_READER_STRIDE と等しいため、size は aligned_alloc() が要求する境界の倍数になる。 */
+    void *readers = aligned_alloc(SNAPSHOT_READER_STRIDE, size);
+#endif /* COMPILER_MSVC */
+    if (readers != NULL)
+    {
+        memset(readers, 0, size);
+    }
+    return (struct_meta_snapshot_reader *)readers;
+}
+
+static void free_readers(struct_meta_snapshot_reader *readers)
+{
+#if defined(COMPILER_MSVC)
+    _aligned_free(readers);
+#else  /* !COMPILER_MSVC */
+    free(readers);
+#endif /* COMPILER_MSVC */
+}
+
+static void release_instance(const struct_meta_descriptor *descriptor, void *instance)
+{
+    if (instance != NULL)
+    {
+        (void)struct_meta_instance_release(descriptor, instance, NULL);
+        free(instance);
+    }
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_snapshot_init(struct_meta_snapshot *snapshot, const struct_meta_descriptor *descriptor,
+                              size_t reader_capacity)
+{
+    if (snapshot == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    memset(snapshot, 0, sizeof(*snapshot));
+    if ((descriptor == NULL) || (reader_capacity == 0U))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    struct_meta_snapshot_reader *readers = allocate_readers(reader_capacity);
+    if (readers == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    for (size_t i = 0; i < reader_capacity; i++)
+    {
+        readers[i].snapshot = snapshot;
+    }
+    snapshot->descriptor = descriptor;
+    snapshot->epoch = 1U;
+    snapshot->readers = readers;
+    snapshot->reader_capacity = reader_capacity;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_snapshot_publish(struct_meta_snapshot *snapshot, void *instance)
+{
+    if ((snapshot == NULL) || (snapshot->readers == NULL) || (instance == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    /* 置き換えた後に確保が失敗すると旧版を記録できないため、先に確保する。 */
+    struct_meta_snapshot_retired *retired = (struct_meta_snapshot_retired *)malloc(sizeof(*retired));
+    if (retired == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    void *previous = struct_meta_internal_atomic_exchange_ptr(&snapshot->current, instance);
+    struct_meta_internal_atomic_fence();
+    if (previous == NULL)
+    {
+        free(retired);
+        return COM_UTIL_OK;
+    }
+    retired->instance = previous;
+    retired->epoch = struct_meta_internal_atomic_fetch_add_u64(&snapshot->epoch, 1U);
+    retired->next = snapshot->retired;
+    snapshot->retired = retired;
+    snapshot->retired_count++;
+    (void)struct_meta_snapshot_reclaim(snapshot);
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_snapshot_load_file(struct_meta_snapshot *snapshot, const char *path)
+{
+    if ((snapshot == NULL) || (snapshot->descriptor == NULL) || (path == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    void *instance = calloc(1U, snapshot->descriptor->size);
+    if (instance == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    int ret = struct_meta_json_file_load(snapshot->descriptor, path, instance);
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_snapshot_publish(snapshot, instance);
+    }
+    if (ret != COM_UTIL_OK)
+    {
+        /* 途中まで読み込んだ文字列と可変長配列も解放する。 */
+        release_instance(snapshot->descriptor, instance);
+    }
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+size_t struct_meta_snapshot_reclaim(struct_meta_snapshot *snapshot)
+{
+    if ((snapshot == NULL) || (snapshot->retired == NULL))
+    {
+        return 0U;
+    }
+
+    /* pin 中の読み手が示す最も古い世代を求める。これより前の世代で置き換えた旧版は参照されていない。 */
+    struct_meta_internal_atomic_fence();
+    uint64_t oldest = UINT64_MAX;
+    for (size_t i = 0; i < snapshot->reader_capacity; i++)
+    {
+        uint64_t epoch = struct_meta_internal_atomic_load_u64(&snapshot->readers[i].epoch);
+        if ((epoch != 0U) && (epoch < oldest))
+        {
+            oldest = epoch;
+        }
+    }
+
+    struct_meta_snapshot_retired **link = &snapshot->retired;
+    while (*link != NULL)
+    {
+        struct_meta_snapshot_retired *retired = *link;
+        if (retired->epoch < oldest)
+        {
+            *link = retired->next;
+            release_instance(snapshot->descriptor, retired->instance);
+            free(retired);
+            snapshot->retired_count--;
+        }
+        else
+        {
+            link = &retired->next;
+        }
+    }
+    return snapshot->retired_count;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_snapshot_reader_attach(struct_meta_snapshot *snapshot, struct_meta_snapshot_reader **reader_out)
+{
+    if (reader_out == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    *reader_out = NULL;
+    if ((snapshot == NULL) || (snapshot->readers == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+
+    for (size_t i = 0; i < snapshot->reader_capacity; i++)
+    {
+        struct_meta_snapshot_reader *reader = &snapshot->readers[i];
+        if (struct_meta_internal_atomic_cas_ptr(&reader->owner, NULL, reader))
+        {
+            *reader_out = reader;
+            return COM_UTIL_OK;
+        }
+    }
+    return COM_UTIL_ERR_BUFFER_TOO_SMALL;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_snapshot_reader_detach(struct_meta_snapshot_reader *reader)
+{
+    if (reader == NULL)
+    {
+        return;
+    }
+    struct_meta_snapshot_unpin(reader);
+    (void)struct_meta_internal_atomic_exchange_ptr(&reader->owner, NULL);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+const void *struct_meta_snapshot_pin(struct_meta_snapshot_reader *reader)
+{
+    if (reader == NULL)
+    {
+        return NULL;
+    }
+    struct_meta_snapshot *snapshot = reader->snapshot;
+    struct_meta_internal_atomic_store_u64(&reader->epoch, struct_meta_internal_atomic_load_u64(&snapshot->epoch));
+    /* 枠の書き込みを、公開中のポインターの読み取りより先に他スレッドへ見せる。 */
+    struct_meta_internal_atomic_fence();
+    return struct_meta_internal_atomic_load_ptr(&snapshot->current);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_snapshot_unpin(struct_meta_snapshot_reader *reader)
+{
+    if (reader != NULL)
+    {
+        /* release 順序により、版の読み取りは書き手が 0 を見て解放するより先に終わる。 */
+        struct_meta_internal_atomic_store_u64(&reader->epoch, 0U);
+    }
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_snapshot_dispose(struct_meta_snapshot *snapshot)
+{
+    if (snapshot == NULL)
+    {
+        return;
+    }
+    struct_meta_snapshot_retired *retired = snapshot->retired;
+    while (retired != NULL)
+    {
+        struct_meta_snapshot_retired *next = retired->next;
+        release_instance(snapshot->descriptor, retired->instance);
+        free(retired);
+        retired = next;
+    }
+    release_instance(snapshot->descriptor, snapshot->current);
+    free_readers(snapshot->readers);
+    memset(snapshot, 0, sizeof(*snapshot));
+}
@@ -0,0 +1,362 @@
+/**
+ *******************************************************************************
+ *  @file           mmap_store.c
+ *  @brief          固定レイアウトのレコードをファイルへ並べ、メモリー マップで直接参照します。
+ *
+ *  書き出しは `com_util/crt/stdio.h` の stdio ラッパーで逐次に行います。\n
+ *  読み込みはファイル全体を読み取り専用でマップし、レコードを複写せずに参照します。
+ *  大きなスナップショットを繰り返し参照する用途では、開く時間とメモリー使用量がレコード数に依存しないためです。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/store/mmap_store.h>
+
+#include <struct_meta/base/array.h>
+#include <struct_meta/binary/plan.h>
+#include <struct_meta/memory/dynamic.h>
+#include <struct_meta/meta/registry.h>
+
+#include <com_util/base/platform.h>
+#include <com_util/base/result.h>
+#include <com_util/crt/stdio.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(PLATFORM_WINDOWS)
+    #include <com_util/base/windows_sdk.h>
+#else /* !PLATFORM_WINDOWS */
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif /* PLATFORM_WINDOWS */
+
+/* ヘッダー内の各項目のオフセット。 */
+#define HEADER_VERSION_OFFSET 4U
+#define HEADER_FINGERPRINT_OFFSET 8U
+#define HEADER_COUNT_OFFSET 16U
+#define HEADER_STRIDE_OFFSET 24U
+#define HEADER_RECORDS_OFFSET 32U
+
+static const unsigned char s_magic[4] = {'S', 'M', 'M', 'S'};
+
+static void store_le(unsigned char *out, uint64_t value, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        out[i] = (unsigned char)(value >> (i * 8U));
+    }
+}
+
+static uint64_t load_le(const unsigned char *in, size_t size)
+{
+    uint64_t value = 0U;
+    for (size_t i = 0; i < size; i++)
+    {
+        value |= (uint64_t)in[i] << (i * 8U);
+    }
+    return value;
+}
+
+/**
+ *  @brief          レコード 1 件を、フィールド以外の領域と char 配列の NUL の後ろを 0 にして複写します。
+ */
+static int normalize_record(const struct_meta_internal_binary_plan *plan, const unsigned char *in, size_t size,
+                            unsigned char *out)
+{
+    memset(out, 0, size);
+    for (size_t i = 0; i < plan->op_count; i++)
+    {
+        const struct_meta_internal_binary_op *op = &plan->ops[i];
+        const unsigned char *field = in + op->host_offset;
+        size_t length = op->length;
+        if (op->kind == STRUCT_META_INTERNAL_BINARY_OP_CHARS)
+        {
+            const unsigned char *terminator = (const unsigned char *)memchr(field, '\0', op->length);
+            if (terminator == NULL)
+            {
+                return COM_UTIL_ERR_INVALID_ARGUMENT;
+            }
+            length = (size_t)(terminator - field);
+        }
+        /* ホストの表現のまま保存するため、バイト順の反転は行わない。 */
+        memcpy(out + op->host_offset, field, length);
+    }
+    return COM_UTIL_OK;
+}
+
+static int write_records(FILE *stream, const struct_meta_descriptor *desc, const unsigned char *base, size_t count,
+                         size_t stride)
+{
+    struct_meta_internal_binary_plan local;
+    const struct_meta_internal_binary_plan *plan = NULL;
+    unsigned char header[STRUCT_META_MMAP_STORE_HEADER_SIZE];
+
+    int ret = struct_meta_internal_binary_plan_acquire(desc, &local, &plan);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    unsigned char *record = (unsigned char *)malloc(desc->size);
+    if (record == NULL)
+    {
+        struct_meta_internal_binary_plan_release(&local, plan);
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, s_magic, sizeof(s_magic));
+    store_le(header + HEADER_VERSION_OFFSET, STRUCT_META_MMAP_STORE_VERSION, 4U);
+    store_le(header + HEADER_FINGERPRINT_OFFSET, struct_meta_internal_binary_layout_fingerprint(desc), 8U);
+    store_le(header + HEADER_COUNT_OFFSET, (uint64_t)count, 8U);
+    store_le(header + HEADER_STRIDE_OFFSET, (uint64_t)desc->size, 8U);
+    store_le(header + HEADER_RECORDS_OFFSET, STRUCT_META_MMAP_STORE_HEADER_SIZE, 8U);
+    if (com_util_fwrite(header, 1U, sizeof(header), stream, NULL) != sizeof(header))
+    {
+        ret = COM_UTIL_ERR_UNKNOWN;
+    }
+    for (size_t i = 0; (i < count) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = normalize_record(plan, base + (i * stride), desc->size, record);
+        if ((ret == COM_UTIL_OK) && (com_util_fwrite(record, 1U, desc->size, stream, NULL) != desc->size))
+        {
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+    }
+
+    free(record);
+    struct_meta_internal_binary_plan_release(&local, plan);
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_mmap_store_write(const struct_meta_descriptor *descriptor, const void *base, size_t count,
+                                 size_t stride, const char *path)
+{
+    if (path == NULL)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    int ret = struct_meta_internal_array_stride(descriptor, base, count, stride, &stride);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    /* 記述子の誤りでは出力ファイルを作らないよう、開く前に検査する。 */
+    ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    if (struct_meta_internal_descriptor_has_dynamic(descriptor) != 0)
+    {
+        return COM_UTIL_ERR_UNSUPPORTED;
+    }
+
+    FILE *stream = com_util_fopen(path, "wb", NULL);
+    if (stream == NULL)
+    {
+        return COM_UTIL_ERR_NOT_FOUND;
+    }
+    ret = write_records(stream, descriptor, (const unsigned char *)base, count, stride);
+    if ((com_util_fclose(stream, NULL) != 0) && (ret == COM_UTIL_OK))
+    {
+        ret = COM_UTIL_ERR_UNKNOWN;
+    }
+    return ret;
+}
+
+/**
+ *  @brief          ファイル全体を読み取り専用でマップします。
+ */
+static int map_file(const char *path, void **base_out, size_t *size_out)
+{
+#if defined(PLATFORM_WINDOWS)
+    int wide_length = MultiByteToWideChar(CP_UTF8, 0, path, -1, NULL, 0);
+    if (wide_length <= 0)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    wchar_t *wide_path = (wchar_t *)malloc((size_t)wide_length * sizeof(wchar_t));
+    if (wide_path == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    (void)MultiByteToWideChar(CP_UTF8, 0, path, -1, wide_path, wide_length);
+    HANDLE file = CreateFileW(wide_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                              NULL);
+    free(wide_path);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return COM_UTIL_ERR_NOT_FOUND;
+    }
+    LARGE_INTEGER size;
+    if ((GetFileSizeEx(file, &size) == 0) || ((uint64_t)size.QuadPart > (uint64_t)SIZE_MAX))
+    {
+        CloseHandle(file);
+        return COM_UTIL_ERR_UNKNOWN;
+    }
+    if ((uint64_t)size.QuadPart < STRUCT_META_MMAP_STORE_HEADER_SIZE)
+    {
+        CloseHandle(file);
+        return COM_UTIL_ERR_EOF;
+    }
+    /* ビューはマッピング オブジェクトとファイルへの参照を保持するため、ハンドルはすぐに閉じてよい。 */
+    HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (mapping == NULL)
+    {
+        return COM_UTIL_ERR_UNKNOWN;
+    }
+    void *base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (base == NULL)
+    {
+        return COM_UTIL_ERR_UNKNOWN;
+    }
+    *base_out = base;
+    *size_out = (size_t)size.QuadPart;
+    return COM_UTIL_OK;
+#else  /* !PLATFORM_WINDOWS */
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return COM_UTIL_ERR_NOT_FOUND;
+    }
+    struct stat status;
+    if ((fstat(fd, &status) != 0) || (status.st_size < 0) || ((uint64_t)status.st_size > (uint64_t)SIZE_MAX))
+    {
+        (void)close(fd);
+        return COM_UTIL_ERR_UNKNOWN;
+    }
+    if ((uint64_t)status.st_size < STRUCT_META_MMAP_STORE_HEADER_SIZE)
+    {
+        (void)close(fd);
+        return COM_UTIL_ERR_EOF;
+    }
+    /* マップはファイル記述子を閉じても有効なままである。 */
+    void *base = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (base == MAP_FAILED)
+    {
+        return COM_UTIL_ERR_UNKNOWN;
+    }
+    *base_out = base;
+    *size_out = (size_t)status.st_size;
+    return COM_UTIL_OK;
+#endif /* PLATFORM_WINDOWS */
+}
+
+static void unmap_file(void *base, size_t size)
+{
+#if defined(PLATFORM_WINDOWS)
+    (void)size;
+    (void)UnmapViewOfFile(base);
+#else  /* !PLATFORM_WINDOWS */
+    (void)munmap(base, size);
+#endif /* PLATFORM_WINDOWS */
+}
+
+static int check_header(const struct_meta_descriptor *desc, const unsigned char *map, size_t map_size,
+                        size_t *count_out)
+{
+    if (memcmp(map, s_magic, sizeof(s_magic)) != 0)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if ((load_le(map + HEADER_VERSION_OFFSET, 4U) != STRUCT_META_MMAP_STORE_VERSION) ||
+        (load_le(map + HEADER_FINGERPRINT_OFFSET, 8U) != struct_meta_internal_binary_layout_fingerprint(desc)) ||
+        (load_le(map + HEADER_STRIDE_OFFSET, 8U) != (uint64_t)desc->size) ||
+        (load_le(map + HEADER_RECORDS_OFFSET, 8U) != STRUCT_META_MMAP_STORE_HEADER_SIZE))
+    {
+        return COM_UTIL_ERR_UNSUPPORTED;
+    }
+    uint64_t count = load_le(map + HEADER_COUNT_OFFSET, 8U);
+    uint64_t available = (uint64_t)(map_size - STRUCT_META_MMAP_STORE_HEADER_SIZE);
+    if ((desc->size > 0U) && (count > (available / (uint64_t)desc->size)))
+    {
+        return COM_UTIL_ERR_EOF;
+    }
+    *count_out = (size_t)count;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_mmap_store_open(const struct_meta_descriptor *descriptor, const char *path,
+                                struct_meta_mmap_store *store_out)
+{
+    void *map = NULL;
+    size_t map_size = 0U;
+    size_t count = 0U;
+
+    if ((descriptor == NULL) || (path == NULL) || (store_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    int ret = struct_meta_internal_descriptor_acquire(descriptor, NULL);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    /* マップしたレコードをそのまま参照させるため、プロセス外で意味を持たないポインターを含む型は扱わない。 */
+    if (struct_meta_internal_descriptor_has_dynamic(descriptor) != 0)
+    {
+        return COM_UTIL_ERR_UNSUPPORTED;
+    }
+    ret = map_file(path, &map, &map_size);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    ret = check_header(descriptor, (const unsigned char *)map, map_size, &count);
+    if (ret != COM_UTIL_OK)
+    {
+        unmap_file(map, map_size);
+        return ret;
+    }
+    store_out->descriptor = descriptor;
+    store_out->records = (const unsigned char *)map + STRUCT_META_MMAP_STORE_HEADER_SIZE;
+    store_out->count = count;
+    store_out->stride = descriptor->size;
+    store_out->map_base = map;
+    store_out->map_size = map_size;
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_mmap_store_record(const struct_meta_mmap_store *store, size_t index, const void **record_out)
+{
+    if ((store == NULL) || (store->records == NULL) || (record_out == NULL))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    if (index >= store->count)
+    {
+        return COM_UTIL_ERR_OUT_OF_RANGE;
+    }
+    *record_out = store->records + (index * store->stride);
+    return COM_UTIL_OK;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_mmap_store_close(struct_meta_mmap_store *store)
+{
+    if ((store == NULL) || (store->map_base == NULL))
+    {
+        return;
+    }
+    unmap_file(store->map_base, store->map_size);
+    store->records = NULL;
+    store->count = 0U;
+    store->map_base = NULL;
+    store->map_size = 0U;
+}
@@ -1,7 +1,8 @@
-# struct-meta-gen を struct-meta-sample より
+# struct-meta-gen を struct-meta-sample と struct-meta-bench より
 # 先にビルドする必要があるため、ワイルドカード自動検出 (兄弟を独立とみなし並列化) では
 # なく、宣言順を並列ビルド下でも維持する明示指定を用いる。
 # see: framework/makefw/docs/makeparts.md
 SUBDIRS := \
 	struct-meta-gen \
-	struct-meta-sample
+	struct-meta-sample \
+	struct-meta-bench
@@ -0,0 +1,47 @@
+# ライブラリの指定
+LIBS += com_util cjson struct_meta
+
+# struct-meta-gen (ヘッダー解析ツール) の実行体。
+# prod/src/cmd/makelocal.mk の SUBDIRS 宣言順により、必ずこの makepart.mk の
+# 評価より前に struct-meta-gen のビルドが完了している。
+ifdef PLATFORM_LINUX
+STRUCT_META_GEN_BIN := $(MYAPP_DIR)/prod/cbin/struct-meta-gen
+else ifdef PLATFORM_WINDOWS
+STRUCT_META_GEN_BIN := $(MYAPP_DIR)/prod/cbin/struct-meta-gen.exe
+endif
+
+# 計測対象の型は struct-meta-sample と同じヘッダーから生成する。
+# 生成物は gen/ 直下へ置くため、stem はヘッダーのファイル名部分だけから作る。
+STRUCT_META_GEN_HEADERS := ../struct-meta-sample/sample_types.h
+
+# GENDIR は _flags.mk (このファイルより後に読み込まれる) で定義されるため、
+# リテラル "gen" を使う (struct-meta-sample/makepart.mk と同じ理由)。
+_struct_meta_gen_gendir := gen
+
+_struct_meta_gen_stem = $(notdir $(basename $(1)))
+
+# 規則の構成は struct-meta-sample/makepart.mk と同じ (バッチ モードで生成し、スタンプ ファイルで実行を記録する)。
+# 記述子の解釈と比較するため、型ごとの JSON コーデックも生成する (--emit-codecs)。
+_struct_meta_gen_stamp := $(_struct_meta_gen_gendir)/struct_meta_gen.stamp
+
+_struct_meta_gen_args := --gendir $(_struct_meta_gen_gendir) --emit-codecs $(STRUCT_META_GEN_HEADERS)
+
+$(_struct_meta_gen_stamp): $(STRUCT_META_GEN_HEADERS) $(STRUCT_META_GEN_BIN) | $(_struct_meta_gen_gendir)
+	@echo "struct-meta-gen $(_struct_meta_gen_args)"
+	$(STRUCT_META_GEN_BIN) $(_struct_meta_gen_args)
+	@touch $@
+
+define _STRUCT_META_GEN_RULE
+$(_struct_meta_gen_gendir)/$(call _struct_meta_gen_stem,$(1))_meta.c: $(_struct_meta_gen_stamp)
+	@test -f $$@ || $(STRUCT_META_GEN_BIN) $(_struct_meta_gen_args)
+$(_struct_meta_gen_gendir)/$(call _struct_meta_gen_stem,$(1))_meta.h: $(_struct_meta_gen_gendir)/$(call _struct_meta_gen_stem,$(1))_meta.c
+	@test -f $$@ || $(STRUCT_META_GEN_BIN) $(_struct_meta_gen_args)
+endef
+$(foreach h,$(STRUCT_META_GEN_HEADERS),$(eval $(call _STRUCT_META_GEN_RULE,$(h))))
+
+GENDIR_EXTRA_C += $(foreach h,$(STRUCT_META_GEN_HEADERS),$(_struct_meta_gen_gendir)/$(call _struct_meta_gen_stem,$(h))_meta.c)
+
+# struct_meta_bench.c が生成ヘッダーを #include するため、初回ビルドでも
+# ヘッダー生成が先行するよう明示依存を置く。
+obj/struct_meta_bench.o obj/struct_meta_bench.obj: \
+	$(foreach h,$(STRUCT_META_GEN_HEADERS),$(_struct_meta_gen_gendir)/$(call _struct_meta_gen_stem,$(h))_meta.h)
@@ -0,0 +1,2300 @@
+/**
+ *******************************************************************************
+ *  @file           struct_meta_bench.c
+ *  @brief          struct_meta ライブラリの呼び出しコストを計測するコマンドです。
+ *
+ *  使用方法:
+    @code{.sh}
+    struct-meta-bench [--iterations <回数>] [ケース名 ...]
+    @endcode
+ *
+ *  ケース名を省略すると、すべてのケースを順に実行します。\n
+ *  計測対象は struct-meta-sample と同じ `sample_types.h` から生成した `person` です。
+ *  struct-meta-sample と同様に、生成した記述子だけを使い、ヘッダーの型名は直接参照しません。
+ *  ただし、生成コーデック (`struct-meta-gen --emit-codecs`) の計測だけは生成関数の引数として型名を使います。\n
+ *  結果は 1 操作あたりの経過時間です。計測値は実行環境に依存するため、同じ環境での相対比較に使います。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include <struct_meta/access/access.h>
+#include <struct_meta/binary/binary.h>
+#include <struct_meta/columnar/columnar.h>
+#include <struct_meta/delta/delta.h>
+#include <struct_meta/hash/hash.h>
+#include <struct_meta/json/file.h>
+#include <struct_meta/json/json.h>
+#include <struct_meta/json/ndjson.h>
+#include <struct_meta/json/reader.h>
+#include <struct_meta/json/writer.h>
+#include <struct_meta/memory/arena.h>
+#include <struct_meta/meta/catalog.h>
+#include <struct_meta/store/mmap_store.h>
+
+#include <com_util/base/result.h>
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "gen/sample_types_meta.h"
+
+/** 既定の反復回数です。 */
+#define BENCH_DEFAULT_ITERATIONS 100000U
+
+/** JSON テキストの書き出しと読み込みの計測に使う person の件数です。 */
+#define BENCH_RECORD_COUNT 10000U
+
+/** レコードごとの JSON ファイルの読み込みの計測に使うファイル数です。 */
+#define BENCH_FILE_COUNT 200U
+
+/** 名前検索の計測に使う幅広い記述子のフィールド数です。 */
+#define BENCH_WIDE_FIELD_COUNT 256U
+
+/** 起動時の一括検査の計測に使う記述子の一覧の大きさです。 */
+#define BENCH_CATALOG_SIZE 1024U
+
+/** 計測ケースです。 */
+typedef struct bench_case
+{
+    const char *name;                                                  /**< ケース名です。 */
+    const char *summary;                                               /**< 概要です。 */
+    int (*run)(const struct_meta_descriptor *desc, size_t iterations); /**< 計測処理です。 */
+} bench_case;
+
+/* 幅広い記述子は登録後に解放できないため、静的領域へ一度だけ組み立てる。 */
+static char s_wide_names[BENCH_WIDE_FIELD_COUNT][8];
+static struct_meta_field s_wide_fields[BENCH_WIDE_FIELD_COUNT];
+static struct_meta_descriptor s_wide_descriptor;
+
+/* 一括検査の計測用の記述子。逐次と並行で別の一覧を使い、いずれも未登録の状態から計測する。 */
+static struct_meta_descriptor s_catalog_descriptors[2][BENCH_CATALOG_SIZE];
+static const struct_meta_descriptor *s_catalog[2][BENCH_CATALOG_SIZE];
+
+/* 名前検索の計測用に、構造体名だけを変えた記述子。 */
+static char s_find_names[BENCH_CATALOG_SIZE][16];
+static struct_meta_descriptor s_find_descriptors[BENCH_CATALOG_SIZE];
+static const struct_meta_descriptor *s_find_catalog[BENCH_CATALOG_SIZE];
+
+/* cJSON のメモリー確保フックで数えた確保回数。 */
+static size_t s_allocations;
+
+static void *counting_malloc(size_t size)
+{
+    s_allocations++;
+    return malloc(size);
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    if (timespec_get(&ts, TIME_UTC) == 0)
+    {
+        return 0U;
+    }
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+static void report(const char *label, size_t operations, uint64_t elapsed_ns)
+{
+    double per_op = 0.0;
+    if (operations > 0U)
+    {
+        per_op = (double)elapsed_ns / (double)operations;
+    }
+    printf("  %-44s %12.1f ns/op  (%zu ops)\n", label, per_op, operations);
+}
+
+static int set_int(const struct_meta_descriptor *desc, void *instance, const char *path, int value)
+{
+    const struct_meta_field *field = NULL;
+    void *target = NULL;
+    int ret = struct_meta_path_resolve(desc, instance, path, &field, &target);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    if ((field->kind != STRUCT_META_FIELD_INT) && (field->kind != STRUCT_META_FIELD_UNSIGNED))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    memcpy(target, &value, sizeof(value));
+    return COM_UTIL_OK;
+}
+
+static int set_double(const struct_meta_descriptor *desc, void *instance, const char *path, double value)
+{
+    const struct_meta_field *field = NULL;
+    void *target = NULL;
+    int ret = struct_meta_path_resolve(desc, instance, path, &field, &target);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    if (field->kind != STRUCT_META_FIELD_DOUBLE)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    memcpy(target, &value, sizeof(value));
+    return COM_UTIL_OK;
+}
+
+static int set_text(const struct_meta_descriptor *desc, void *instance, const char *path, const char *text)
+{
+    const struct_meta_field *field = NULL;
+    void *target = NULL;
+    int ret = struct_meta_path_resolve(desc, instance, path, &field, &target);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    size_t length = strlen(text);
+    if ((field->kind != STRUCT_META_FIELD_CHAR_ARRAY) || (length >= field->char_buffer_size))
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    memcpy(target, text, length + 1U);
+    return COM_UTIL_OK;
+}
+
+/**
+ *  @brief          person の全フィールドへ代表的な値を設定します。
+ *  @param[in]      desc person の記述子です。
+ *  @param[out]     instance 設定先です。desc->size バイトを確保しておきます。
+ *  @param[in]      seed 値を変えるための番号です。
+ */
+static int fill_person(const struct_meta_descriptor *desc, void *instance, int seed)
+{
+    int ret = COM_UTIL_OK;
+
+    memset(instance, 0, desc->size);
+    if (ret == COM_UTIL_OK)
+    {
+        ret = set_int(desc, instance, "id", seed);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = set_int(desc, instance, "age", 20 + (seed % 60));
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = set_double(desc, instance, "score", 50.25 + (double)(seed % 50));
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = set_text(desc, instance, "name", "Yamada Taro");
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = set_text(desc, instance, "home.city", "Tokyo");
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = set_int(desc, instance, "home.zip", 1000001);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = set_text(desc, instance, "addresses[0].city", "Osaka");
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = set_int(desc, instance, "addresses[0].zip", 5300001);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = set_text(desc, instance, "addresses[1].city", "Nagoya \"central\"");
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = set_int(desc, instance, "addresses[1].zip", 4500002);
+    }
+    for (int i = 0; (i < 3) && (ret == COM_UTIL_OK); i++)
+    {
+        char path[16];
+        (void)snprintf(path, sizeof(path), "scores[%d]", i);
+        ret = set_int(desc, instance, path, (seed * 7) + i);
+    }
+    return ret;
+}
+
+/**
+ *  @brief          入口検査のコストを、毎回の再帰検査と登録済み記述子の検査で比較します。
+ */
+static int bench_validate(const struct_meta_descriptor *desc, size_t iterations)
+{
+    const struct_meta_field *field = NULL;
+    cJSON *json = NULL;
+    uint64_t start;
+    int ret = COM_UTIL_OK;
+
+    void *instance = malloc(desc->size);
+    if (instance == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    ret = fill_person(desc, instance, 1);
+
+    start = now_ns();
+    for (size_t i = 0; (i < iterations) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = struct_meta_descriptor_validate(desc);
+    }
+    report("descriptor_validate (per call)", iterations, now_ns() - start);
+
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_descriptor_seal(desc);
+    }
+    start = now_ns();
+    for (size_t i = 0; (i < iterations) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = struct_meta_descriptor_seal(desc);
+    }
+    report("descriptor_seal (sealed)", iterations, now_ns() - start);
+
+    start = now_ns();
+    for (size_t i = 0; (i < iterations) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = struct_meta_descriptor_validate(desc);
+        if (ret == COM_UTIL_OK)
+        {
+            ret = struct_meta_descriptor_find_field(desc, "scores", &field);
+        }
+    }
+    report("descriptor_validate + find_field", iterations, now_ns() - start);
+
+    start = now_ns();
+    for (size_t i = 0; (i < iterations) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = struct_meta_descriptor_find_field(desc, "scores", &field);
+    }
+    report("find_field (sealed)", iterations, now_ns() - start);
+
+    start = now_ns();
+    for (size_t i = 0; (i < iterations) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = struct_meta_descriptor_validate(desc);
+        if (ret == COM_UTIL_OK)
+        {
+            ret = struct_meta_json_encode(desc, instance, &json);
+            cJSON_Delete(json);
+            json = NULL;
+        }
+    }
+    report("descriptor_validate + json_encode", iterations, now_ns() - start);
+
+    start = now_ns();
+    for (size_t i = 0; (i < iterations) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = struct_meta_json_encode(desc, instance, &json);
+        cJSON_Delete(json);
+        json = NULL;
+    }
+    report("json_encode (sealed)", iterations, now_ns() - start);
+
+    free(instance);
+    return ret;
+}
+
+/**
+ *  @brief          int フィールドを BENCH_WIDE_FIELD_COUNT 個持つ記述子を返します。
+ */
+static const struct_meta_descriptor *wide_descriptor(void)
+{
+    if (s_wide_descriptor.fields == NULL)
+    {
+        for (size_t i = 0; i < BENCH_WIDE_FIELD_COUNT; i++)
+        {
+            (void)snprintf(s_wide_names[i], sizeof(s_wide_names[i]), "f%03zu", i);
+            s_wide_fields[i].name = s_wide_names[i];
+            s_wide_fields[i].kind = STRUCT_META_FIELD_INT;
+            s_wide_fields[i].offset = i * sizeof(int);
+            s_wide_fields[i].element_size = sizeof(int);
+            s_wide_fields[i].element_count = 1U;
+        }
+        s_wide_descriptor.name = "wide";
+        s_wide_descriptor.size = BENCH_WIDE_FIELD_COUNT * sizeof(int);
+        s_wide_descriptor.field_count = BENCH_WIDE_FIELD_COUNT;
+        s_wide_descriptor.fields = s_wide_fields;
+    }
+    return &s_wide_descriptor;
+}
+
+/**
+ *  @brief          索引を使わない従来の検索です。比較の基準に使います。
+ */
+static const struct_meta_field *find_field_linear(const struct_meta_descriptor *desc, const char *name)
+{
+    for (size_t i = 0; i < desc->field_count; i++)
+    {
+        if (strcmp(desc->fields[i].name, name) == 0)
+        {
+            return &desc->fields[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ *  @brief          フィールド名検索とパス解決のコストを、線形探索と名前索引で比較します。
+ */
+static int bench_lookup(const struct_meta_descriptor *desc, size_t iterations)
+{
+    const struct_meta_descriptor *wide = wide_descriptor();
+    const struct_meta_field *field = NULL;
+    void *target = NULL;
+    uint64_t start;
+    size_t found = 0U;
+
+    int ret = struct_meta_descriptor_seal(desc);
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_descriptor_seal(wide);
+    }
+    void *instance = malloc(desc->size);
+    if (instance == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = fill_person(desc, instance, 1);
+    }
+
+    start = now_ns();
+    for (size_t i = 0; (i < iterations) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = struct_meta_descriptor_find_field(desc, "scores", &field);
+    }
+    report("find_field person.scores", iterations, now_ns() - start);
+
+    start = now_ns();
+    for (size_t i = 0; (i < iterations) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = struct_meta_path_resolve(desc, instance, "addresses[1].city", &field, &target);
+    }
+    report("path_resolve addresses[1].city", iterations, now_ns() - start);
+
+    struct_meta_path_handle handle;
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_path_compile(desc, "addresses[1].city", &handle);
+    }
+    start = now_ns();
+    for (size_t i = 0; (i < iterations) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = struct_meta_path_apply(&handle, instance, &target);
+    }
+    report("path_apply addresses[1].city (compiled)", iterations, now_ns() - start);
+
+    start = now_ns();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        if (find_field_linear(wide, s_wide_names[i % BENCH_WIDE_FIELD_COUNT]) != NULL)
+        {
+            found++;
+        }
+    }
+    report("linear strcmp scan (256 fields)", iterations, now_ns() - start);
+
+    start = now_ns();
+    for (size_t i = 0; (i < iterations) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = struct_meta_descriptor_find_field(wide, s_wide_names[i % BENCH_WIDE_FIELD_COUNT], &field);
+    }
+    report("find_field (256 fields, indexed)", iterations, now_ns() - start);
+
+    if ((ret == COM_UTIL_OK) && (found != iterations))
+    {
+        ret = COM_UTIL_ERR_NOT_FOUND;
+    }
+    free(instance);
+    return ret;
+}
+
+/**
+ *  @brief          BENCH_RECORD_COUNT 件の person を、連続した配列として確保して値を設定します。
+ */
+static int make_people(const struct_meta_descriptor *desc, unsigned char **people_out)
+{
+    unsigned char *people = (unsigned char *)malloc(desc->size * BENCH_RECORD_COUNT);
+    if (people == NULL)
+    {
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    int ret = COM_UTIL_OK;
+    for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = fill_person(desc, people + (i * desc->size), (int)i);
+    }
+    if (ret != COM_UTIL_OK)
+    {
+        free(people);
+        return ret;
+    }
+    *people_out = people;
+    return COM_UTIL_OK;
+}
+
+static void report_allocations(const char *label, size_t allocations, size_t records)
+{
+    printf("  %-44s %12.1f allocs/record  (%zu allocs)\n", label, (double)allocations / (double)records, allocations);
+}
+
+/**
+ *  @brief          person 配列の JSON テキスト化を、cJSON ツリー経由と直接書き出しで比較します。
+ *
+ *  どちらも cJSON_Print() と同じ整形テキストを作ります。確保回数は、ツリー経由では cJSON のフックで、
+ *  直接書き出しではバッファーの容量が増えた回数で数えます。
+ */
+static int bench_json_text(const struct_meta_descriptor *desc, size_t iterations)
+{
+    unsigned char *people = NULL;
+    struct_meta_buffer tree_text;
+    struct_meta_buffer direct_text;
+    size_t rounds = iterations / BENCH_RECORD_COUNT;
+    size_t records;
+    uint64_t start;
+
+    if (rounds == 0U)
+    {
+        rounds = 1U;
+    }
+    records = rounds * BENCH_RECORD_COUNT;
+    int ret = make_people(desc, &people);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    struct_meta_buffer_init(&tree_text);
+    struct_meta_buffer_init(&direct_text);
+
+    cJSON_Hooks hooks = {counting_malloc, free};
+    cJSON_InitHooks(&hooks);
+    s_allocations = 0U;
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        struct_meta_buffer_reset(&tree_text);
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            cJSON *json = NULL;
+            ret = struct_meta_json_encode(desc, people + (i * desc->size), &json);
+            if (ret == COM_UTIL_OK)
+            {
+                char *text = cJSON_Print(json);
+                if (text == NULL)
+                {
+                    ret = COM_UTIL_ERR_OUT_OF_MEMORY;
+                }
+                else
+                {
+                    ret = struct_meta_buffer_append(&tree_text, text, strlen(text));
+                    cJSON_free(text);
+                }
+            }
+            cJSON_Delete(json);
+        }
+    }
+    uint64_t tree_ns = now_ns() - start;
+    size_t tree_allocations = s_allocations;
+    cJSON_InitHooks(NULL);
+
+    size_t direct_allocations = 0U;
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        struct_meta_buffer_reset(&direct_text);
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            size_t capacity = direct_text.capacity;
+            ret = struct_meta_json_write_buffer(desc, people + (i * desc->size), STRUCT_META_JSON_FORMAT_PRETTY,
+                                                &direct_text);
+            if (direct_text.capacity != capacity)
+            {
+                direct_allocations++;
+            }
+        }
+    }
+    uint64_t direct_ns = now_ns() - start;
+
+    if (ret == COM_UTIL_OK)
+    {
+        report("json_encode + cJSON_Print", records, tree_ns);
+        report("json_write_buffer (direct)", records, direct_ns);
+        report_allocations("json_encode + cJSON_Print", tree_allocations, records);
+        report_allocations("json_write_buffer (direct)", direct_allocations, records);
+        printf("  %-44s %12.1f MB/s\n", "json_write_buffer throughput",
+               ((double)direct_text.length * (double)rounds * 1000.0) / (double)direct_ns);
+        if ((tree_text.length != direct_text.length) ||
+            (memcmp(tree_text.data, direct_text.data, direct_text.length) != 0))
+        {
+            fprintf(stderr, "struct-meta-bench: 直接書き出しのテキストが cJSON_Print() と一致しません\n");
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+    }
+
+    struct_meta_buffer_dispose(&tree_text);
+    struct_meta_buffer_dispose(&direct_text);
+    free(people);
+    return ret;
+}
+
+/**
+ *  @brief          person 配列の JSON テキストの読み込みを、cJSON ツリー経由と単一パスの読み込みで比較します。
+ *
+ *  テキストは struct_meta_json_write_buffer() で 1 件ずつ作ります。cJSON_Parse() は最上位の値の後ろを
+ *  読まないため、連結したテキストの各レコードの先頭から直接解析できます。
+ */
+static int bench_json_parse(const struct_meta_descriptor *desc, size_t iterations)
+{
+    unsigned char *people = NULL;
+    unsigned char *tree_people = NULL;
+    unsigned char *direct_people = NULL;
+    size_t *offsets = NULL;
+    struct_meta_buffer text;
+    size_t rounds = iterations / BENCH_RECORD_COUNT;
+    size_t records;
+    uint64_t start;
+
+    if (rounds == 0U)
+    {
+        rounds = 1U;
+    }
+    records = rounds * BENCH_RECORD_COUNT;
+    int ret = make_people(desc, &people);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    struct_meta_buffer_init(&text);
+    tree_people = (unsigned char *)calloc(BENCH_RECORD_COUNT, desc->size);
+    direct_people = (unsigned char *)calloc(BENCH_RECORD_COUNT, desc->size);
+    offsets = (size_t *)malloc(sizeof(*offsets) * (BENCH_RECORD_COUNT + 1U));
+    if ((tree_people == NULL) || (direct_people == NULL) || (offsets == NULL))
+    {
+        ret = COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+    {
+        offsets[i] = text.length;
+        ret = struct_meta_json_write_buffer(desc, people + (i * desc->size), STRUCT_META_JSON_FORMAT_PRETTY, &text);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        offsets[BENCH_RECORD_COUNT] = text.length;
+    }
+
+    cJSON_Hooks hooks = {counting_malloc, free};
+    cJSON_InitHooks(&hooks);
+    s_allocations = 0U;
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            cJSON *json = cJSON_Parse((const char *)text.data + offsets[i]);
+            if (json == NULL)
+            {
+                ret = COM_UTIL_ERR_INVALID_ARGUMENT;
+            }
+            else
+            {
+                ret = struct_meta_json_decode(desc, json, tree_people + (i * desc->size));
+                cJSON_Delete(json);
+            }
+        }
+    }
+    uint64_t tree_ns = now_ns() - start;
+    size_t tree_allocations = s_allocations;
+    cJSON_InitHooks(NULL);
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            ret = struct_meta_json_decode_text(desc, (const char *)text.data + offsets[i],
+                                               offsets[i + 1U] - offsets[i], direct_people + (i * desc->size));
+        }
+    }
+    uint64_t direct_ns = now_ns() - start;
+
+    if (ret == COM_UTIL_OK)
+    {
+        report("cJSON_Parse + json_decode", records, tree_ns);
+        report("json_decode_text (single pass)", records, direct_ns);
+        report_allocations("cJSON_Parse + json_decode", tree_allocations, records);
+        printf("  %-44s %12.1f MB/s\n", "json_decode_text throughput",
+               ((double)text.length * (double)rounds * 1000.0) / (double)direct_ns);
+        if (memcmp(tree_people, direct_people, desc->size * BENCH_RECORD_COUNT) != 0)
+        {
+            fprintf(stderr, "struct-meta-bench: 単一パスの読み込み結果が cJSON 経由と一致しません\n");
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+    }
+
+    struct_meta_buffer_dispose(&text);
+    free(offsets);
+    free(direct_people);
+    free(tree_people);
+    free(people);
+    return ret;
+}
+
+/**
+ *  @brief          person 配列を 1 つの JSON 配列として書き出し・読み込む時間を、逐次と並行で比較します。
+ *
+ *  比較の基準は、struct_meta_json_write_buffer() を要素ごとに呼ぶ書き出しです。
+ *  並行のスレッド数は CPU 数に合わせます (thread_count に 0 を指定)。
+ */
+static int bench_json_array(const struct_meta_descriptor *desc, size_t iterations)
+{
+    unsigned char *people = NULL;
+    unsigned char *serial_people = NULL;
+    unsigned char *parallel_people = NULL;
+    struct_meta_buffer each_text;
+    struct_meta_buffer serial_text;
+    struct_meta_buffer parallel_text;
+    size_t rounds = iterations / BENCH_RECORD_COUNT;
+    size_t records;
+    size_t count = 0U;
+    uint64_t start;
+
+    if (rounds == 0U)
+    {
+        rounds = 1U;
+    }
+    records = rounds * BENCH_RECORD_COUNT;
+    int ret = make_people(desc, &people);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    struct_meta_buffer_init(&each_text);
+    struct_meta_buffer_init(&serial_text);
+    struct_meta_buffer_init(&parallel_text);
+    serial_people = (unsigned char *)calloc(BENCH_RECORD_COUNT, desc->size);
+    parallel_people = (unsigned char *)calloc(BENCH_RECORD_COUNT, desc->size);
+    if ((serial_people == NULL) || (parallel_people == NULL))
+    {
+        ret = COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        struct_meta_buffer_reset(&each_text);
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            ret = struct_meta_json_write_buffer(desc, people + (i * desc->size), STRUCT_META_JSON_FORMAT_PRETTY,
+                                                &each_text);
+        }
+    }
+    uint64_t each_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        struct_meta_buffer_reset(&serial_text);
+        ret = struct_meta_json_write_array_buffer(desc, people, BENCH_RECORD_COUNT, 0U,
+                                                  STRUCT_META_JSON_FORMAT_PRETTY, 1U, &serial_text);
+    }
+    uint64_t serial_write_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        struct_meta_buffer_reset(&parallel_text);
+        ret = struct_meta_json_write_array_buffer(desc, people, BENCH_RECORD_COUNT, 0U,
+                                                  STRUCT_META_JSON_FORMAT_PRETTY, 0U, &parallel_text);
+    }
+    uint64_t parallel_write_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        ret = struct_meta_json_decode_text_array(desc, (const char *)serial_text.data, serial_text.length,
+                                                 serial_people, BENCH_RECORD_COUNT, 0U, 1U, &count);
+    }
+    uint64_t serial_read_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        ret = struct_meta_json_decode_text_array(desc, (const char *)serial_text.data, serial_text.length,
+                                                 parallel_people, BENCH_RECORD_COUNT, 0U, 0U, &count);
+    }
+    uint64_t parallel_read_ns = now_ns() - start;
+
+    if (ret == COM_UTIL_OK)
+    {
+        report("json_write_buffer per record", records, each_ns);
+        report("json_write_array_buffer (1 thread)", records, serial_write_ns);
+        report("json_write_array_buffer (CPU threads)", records, parallel_write_ns);
+        report("json_decode_text_array (1 thread)", records, serial_read_ns);
+        report("json_decode_text_array (CPU threads)", records, parallel_read_ns);
+        if ((serial_text.length != parallel_text.length) ||
+            (memcmp(serial_text.data, parallel_text.data, serial_text.length) != 0))
+        {
+            fprintf(stderr, "struct-meta-bench: 並行書き出しのテキストが逐次と一致しません\n");
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+        else if ((count != BENCH_RECORD_COUNT) ||
+                 (memcmp(serial_people, parallel_people, desc->size * BENCH_RECORD_COUNT) != 0))
+        {
+            fprintf(stderr, "struct-meta-bench: 並行読み込みの結果が逐次と一致しません\n");
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+    }
+
+    struct_meta_buffer_dispose(&each_text);
+    struct_meta_buffer_dispose(&serial_text);
+    struct_meta_buffer_dispose(&parallel_text);
+    free(parallel_people);
+    free(serial_people);
+    free(people);
+    return ret;
+}
+
+/**
+ *  @brief          person 配列の 1 件ごとの保存と復元を、JSON テキストとバイナリー形式で比較します。
+ *
+ *  どちらも 1 件ずつ連結したバイト列へ書き出し、先頭から 1 件ずつ読み戻します。
+ */
+static int bench_binary(const struct_meta_descriptor *desc, size_t iterations)
+{
+    unsigned char *people = NULL;
+    unsigned char *json_people = NULL;
+    unsigned char *binary_people = NULL;
+    size_t *offsets = NULL;
+    struct_meta_buffer json_text;
+    struct_meta_buffer binary_data;
+    size_t rounds = iterations / BENCH_RECORD_COUNT;
+    size_t records;
+    uint64_t start;
+
+    if (rounds == 0U)
+    {
+        rounds = 1U;
+    }
+    records = rounds * BENCH_RECORD_COUNT;
+    int ret = make_people(desc, &people);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    struct_meta_buffer_init(&json_text);
+    struct_meta_buffer_init(&binary_data);
+    json_people = (unsigned char *)calloc(BENCH_RECORD_COUNT, desc->size);
+    binary_people = (unsigned char *)calloc(BENCH_RECORD_COUNT, desc->size);
+    offsets = (size_t *)malloc(sizeof(*offsets) * (BENCH_RECORD_COUNT + 1U));
+    if ((json_people == NULL) || (binary_people == NULL) || (offsets == NULL))
+    {
+        ret = COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        struct_meta_buffer_reset(&json_text);
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            offsets[i] = json_text.length;
+            ret = struct_meta_json_write_buffer(desc, people + (i * desc->size), STRUCT_META_JSON_FORMAT_COMPACT,
+                                                &json_text);
+        }
+        offsets[BENCH_RECORD_COUNT] = json_text.length;
+    }
+    uint64_t json_write_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        struct_meta_buffer_reset(&binary_data);
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            ret = struct_meta_binary_encode(desc, people + (i * desc->size), &binary_data);
+        }
+    }
+    uint64_t binary_write_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            ret = struct_meta_json_decode_text(desc, (const char *)json_text.data + offsets[i],
+                                               offsets[i + 1U] - offsets[i], json_people + (i * desc->size));
+        }
+    }
+    uint64_t json_read_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        size_t position = 0U;
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            size_t consumed = 0U;
+            ret = struct_meta_binary_decode(desc, binary_data.data + position, binary_data.length - position,
+                                            binary_people + (i * desc->size), &consumed);
+            position += consumed;
+        }
+    }
+    uint64_t binary_read_ns = now_ns() - start;
+
+    if (ret == COM_UTIL_OK)
+    {
+        report("json_write_buffer (compact)", records, json_write_ns);
+        report("binary_encode", records, binary_write_ns);
+        report("json_decode_text", records, json_read_ns);
+        report("binary_decode", records, binary_read_ns);
+        printf("  %-44s %12.1f bytes/record\n", "JSON text (compact)",
+               (double)json_text.length / (double)BENCH_RECORD_COUNT);
+        printf("  %-44s %12.1f bytes/record\n", "binary", (double)binary_data.length / (double)BENCH_RECORD_COUNT);
+        if (memcmp(json_people, binary_people, desc->size * BENCH_RECORD_COUNT) != 0)
+        {
+            fprintf(stderr, "struct-meta-bench: バイナリー形式の読み込み結果が JSON 経由と一致しません\n");
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+    }
+
+    struct_meta_buffer_dispose(&json_text);
+    struct_meta_buffer_dispose(&binary_data);
+    free(offsets);
+    free(binary_people);
+    free(json_people);
+    free(people);
+    return ret;
+}
+
+/**
+ *  @brief          保存済みの person を読み出す時間を、レコードごとの JSON ファイルとマップしたストアで比較します。
+ *
+ *  どちらもカレント ディレクトリへ一時ファイルを作り、計測後に削除します。
+ *  ストアはファイルを開いて全レコードの `addresses[1].city` を参照し、閉じるまでを 1 回とします。
+ */
+static int bench_mmap_store(const struct_meta_descriptor *desc, size_t iterations)
+{
+    static const char store_path[] = "struct-meta-bench-store.bin";
+    unsigned char *people = NULL;
+    unsigned char *loaded = NULL;
+    struct_meta_path_handle handle;
+    size_t rounds = iterations / BENCH_RECORD_COUNT;
+    size_t touched = 0U;
+    char path[64];
+    uint64_t start;
+
+    if (rounds == 0U)
+    {
+        rounds = 1U;
+    }
+    int ret = make_people(desc, &people);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    loaded = (unsigned char *)calloc(1U, desc->size);
+    if (loaded == NULL)
+    {
+        ret = COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_path_compile(desc, "addresses[1].city", &handle);
+    }
+    for (size_t i = 0; (i < BENCH_FILE_COUNT) && (ret == COM_UTIL_OK); i++)
+    {
+        (void)snprintf(path, sizeof(path), "struct-meta-bench-%zu.json", i);
+        ret = struct_meta_json_file_save(desc, people + (i * desc->size), path);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_mmap_store_write(desc, people, BENCH_RECORD_COUNT, 0U, store_path);
+    }
+
+    start = now_ns();
+    for (size_t i = 0; (i < BENCH_FILE_COUNT) && (ret == COM_UTIL_OK); i++)
+    {
+        (void)snprintf(path, sizeof(path), "struct-meta-bench-%zu.json", i);
+        ret = struct_meta_json_file_load(desc, path, loaded);
+    }
+    uint64_t json_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        struct_meta_mmap_store store;
+        ret = struct_meta_mmap_store_open(desc, store_path, &store);
+        for (size_t i = 0; (ret == COM_UTIL_OK) && (i < store.count); i++)
+        {
+            const void *record = NULL;
+            const void *value = NULL;
+            ret = struct_meta_mmap_store_record(&store, i, &record);
+            if (ret == COM_UTIL_OK)
+            {
+                ret = struct_meta_path_apply_const(&handle, record, &value);
+            }
+            if ((ret == COM_UTIL_OK) && (((const char *)value)[0] != '\0'))
+            {
+                touched++;
+            }
+        }
+        if (ret == COM_UTIL_OK)
+        {
+            struct_meta_mmap_store_close(&store);
+        }
+    }
+    uint64_t store_ns = now_ns() - start;
+
+    if (ret == COM_UTIL_OK)
+    {
+        report("json_file_load (1 file per record)", BENCH_FILE_COUNT, json_ns);
+        report("mmap_store open + path per record", rounds * BENCH_RECORD_COUNT, store_ns);
+        if (touched != (rounds * BENCH_RECORD_COUNT))
+        {
+            fprintf(stderr, "struct-meta-bench: ストアから読み出したレコード数が一致しません\n");
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+    }
+
+    for (size_t i = 0; i < BENCH_FILE_COUNT; i++)
+    {
+        (void)snprintf(path, sizeof(path), "struct-meta-bench-%zu.json", i);
+        (void)remove(path);
+    }
+    (void)remove(store_path);
+    free(loaded);
+    free(people);
+    return ret;
+}
+
+/**
+ *  @brief          person を NDJSON ファイルへ 1 行ずつ書き出し、同じインスタンスへ 1 行ずつ読み戻す時間を計測します。
+ *
+ *  ファイルはカレント ディレクトリへ作り、計測後に削除します。
+ *  読み込み側が保持した行のバイト数も表示し、ファイルの大きさに依存しないことを確認します。
+ */
+static int bench_ndjson(const struct_meta_descriptor *desc, size_t iterations)
+{
+    static const char path[] = "struct-meta-bench.ndjson";
+    unsigned char *people = NULL;
+    unsigned char *loaded = NULL;
+    size_t records = 0U;
+    size_t line_capacity = 0U;
+    long file_size = 0L;
+    uint64_t start;
+
+    if (iterations == 0U)
+    {
+        iterations = 1U;
+    }
+    int ret = make_people(desc, &people);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    loaded = (unsigned char *)calloc(1U, desc->size);
+    if (loaded == NULL)
+    {
+        ret = COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+
+    FILE *stream = NULL;
+    if (ret == COM_UTIL_OK)
+    {
+        stream = fopen(path, "wb");
+        if (stream == NULL)
+        {
+            ret = COM_UTIL_ERR_NOT_FOUND;
+        }
+    }
+    start = now_ns();
+    if (ret == COM_UTIL_OK)
+    {
+        struct_meta_ndjson_writer writer;
+        ret = struct_meta_ndjson_writer_init(&writer, stream);
+        for (size_t i = 0; (i < iterations) && (ret == COM_UTIL_OK); i++)
+        {
+            ret = struct_meta_ndjson_writer_append(&writer, desc, people + ((i % BENCH_RECORD_COUNT) * desc->size));
+        }
+        if (ret == COM_UTIL_OK)
+        {
+            ret = struct_meta_ndjson_writer_flush(&writer);
+        }
+        struct_meta_ndjson_writer_dispose(&writer);
+        file_size = ftell(stream);
+        fclose(stream);
+        stream = NULL;
+    }
+    uint64_t write_ns = now_ns() - start;
+
+    if (ret == COM_UTIL_OK)
+    {
+        stream = fopen(path, "rb");
+        if (stream == NULL)
+        {
+            ret = COM_UTIL_ERR_NOT_FOUND;
+        }
+    }
+    start = now_ns();
+    if (ret == COM_UTIL_OK)
+    {
+        struct_meta_ndjson_reader reader;
+        ret = struct_meta_ndjson_reader_init(&reader, stream, 0U);
+        while (ret == COM_UTIL_OK)
+        {
+            ret = struct_meta_ndjson_reader_next(&reader, desc, loaded);
+            if (ret == COM_UTIL_OK)
+            {
+                records++;
+            }
+        }
+        if (ret == COM_UTIL_ERR_EOF)
+        {
+            ret = COM_UTIL_OK;
+        }
+        line_capacity = reader.line.capacity;
+        struct_meta_ndjson_reader_dispose(&reader);
+        fclose(stream);
+    }
+    uint64_t read_ns = now_ns() - start;
+
+    if (ret == COM_UTIL_OK)
+    {
+        report("ndjson_writer_append", iterations, write_ns);
+        report("ndjson_reader_next", records, read_ns);
+        printf("  %-44s %12ld bytes\n", "ndjson file size", file_size);
+        printf("  %-44s %12zu bytes\n", "ndjson reader state + line buffer",
+               sizeof(struct_meta_ndjson_reader) + line_capacity);
+        if (records != iterations)
+        {
+            fprintf(stderr, "struct-meta-bench: NDJSON から読み戻したレコード数が一致しません\n");
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+    }
+
+    (void)remove(path);
+    free(loaded);
+    free(people);
+    return ret;
+}
+
+/**
+ *  @brief          person 配列から 1 個の値を列へ集める時間を、要素ごとの取得と一括複写で比較します。
+ *
+ *  要素ごとの取得は、フィールドを 1 回だけ検索した後に struct_meta_field_get_const_element() を各要素で呼び出します。
+ */
+static int bench_column(const struct_meta_descriptor *desc, size_t iterations)
+{
+    unsigned char *people = NULL;
+    int *column = NULL;
+    double *scores = NULL;
+    const struct_meta_field *field = NULL;
+    struct_meta_path_handle score_handle;
+    struct_meta_path_handle scores_handle;
+    size_t rounds = iterations / BENCH_RECORD_COUNT;
+    uint64_t start;
+
+    if (rounds == 0U)
+    {
+        rounds = 1U;
+    }
+    int ret = make_people(desc, &people);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    column = (int *)malloc(sizeof(*column) * BENCH_RECORD_COUNT);
+    scores = (double *)malloc(sizeof(*scores) * BENCH_RECORD_COUNT);
+    if ((column == NULL) || (scores == NULL))
+    {
+        ret = COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_descriptor_find_field(desc, "scores", &field);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_path_compile(desc, "scores[2]", &scores_handle);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_path_compile(desc, "score", &score_handle);
+    }
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            const void *element = NULL;
+            ret = struct_meta_field_get_const_element(field, people + (i * desc->size), 2U, &element);
+            if (ret == COM_UTIL_OK)
+            {
+                memcpy(&column[i], element, sizeof(column[i]));
+            }
+        }
+    }
+    uint64_t element_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        ret = struct_meta_gather(&scores_handle, people, BENCH_RECORD_COUNT, 0U, column);
+    }
+    uint64_t gather_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        ret = struct_meta_gather(&score_handle, people, BENCH_RECORD_COUNT, 0U, scores);
+    }
+    uint64_t gather_double_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        ret = struct_meta_scatter(&score_handle, scores, BENCH_RECORD_COUNT, 0U, people);
+    }
+    uint64_t scatter_ns = now_ns() - start;
+
+    if (ret == COM_UTIL_OK)
+    {
+        report("field_get_const_element scores[2]", rounds * BENCH_RECORD_COUNT, element_ns);
+        report("gather scores[2] (int)", rounds * BENCH_RECORD_COUNT, gather_ns);
+        report("gather score (double)", rounds * BENCH_RECORD_COUNT, gather_double_ns);
+        report("scatter score (double)", rounds * BENCH_RECORD_COUNT, scatter_ns);
+    }
+
+    free(scores);
+    free(column);
+    free(people);
+    return ret;
+}
+
+/**
+ *  @brief          person 配列の score の合計を、行ごとのフィールド アクセスと列の走査で比較します。
+ *
+ *  列への変換 (1 スレッドと CPU 数) と書き戻しの時間も表示します。
+ */
+static int bench_columnar(const struct_meta_descriptor *desc, size_t iterations)
+{
+    unsigned char *people = NULL;
+    const struct_meta_field *field = NULL;
+    const struct_meta_columnar_column *column = NULL;
+    struct_meta_columnar block;
+    size_t rounds = iterations / BENCH_RECORD_COUNT;
+    double row_sum = 0.0;
+    double column_sum = 0.0;
+    uint64_t start;
+
+    if (rounds == 0U)
+    {
+        rounds = 1U;
+    }
+    int ret = make_people(desc, &people);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    ret = struct_meta_columnar_init(desc, BENCH_RECORD_COUNT, &block);
+    if (ret != COM_UTIL_OK)
+    {
+        free(people);
+        return ret;
+    }
+    ret = struct_meta_descriptor_find_field(desc, "score", &field);
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        ret = struct_meta_columnar_from_rows(&block, people, 0U, 1U);
+    }
+    uint64_t serial_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        ret = struct_meta_columnar_from_rows(&block, people, 0U, 0U);
+    }
+    uint64_t parallel_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        ret = struct_meta_columnar_to_rows(&block, people, 0U, 0U);
+    }
+    uint64_t to_rows_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            const void *element = NULL;
+            ret = struct_meta_field_get_const_element(field, people + (i * desc->size), 0U, &element);
+            if (ret == COM_UTIL_OK)
+            {
+                double value;
+                memcpy(&value, element, sizeof(value));
+                row_sum += value;
+            }
+        }
+    }
+    uint64_t row_scan_ns = now_ns() - start;
+
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_columnar_find(&block, "score", &column);
+    }
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        const double *scores = (const double *)(const void *)column->data;
+        for (size_t i = 0; i < BENCH_RECORD_COUNT; i++)
+        {
+            column_sum += scores[i];
+        }
+    }
+    uint64_t column_scan_ns = now_ns() - start;
+
+    if (ret == COM_UTIL_OK)
+    {
+        report("columnar_from_rows (1 thread)", rounds * BENCH_RECORD_COUNT, serial_ns);
+        report("columnar_from_rows (all CPUs)", rounds * BENCH_RECORD_COUNT, parallel_ns);
+        report("columnar_to_rows (all CPUs)", rounds * BENCH_RECORD_COUNT, to_rows_ns);
+        report("score sum via field_get_const_element", rounds * BENCH_RECORD_COUNT, row_scan_ns);
+        report("score sum via column", rounds * BENCH_RECORD_COUNT, column_scan_ns);
+        printf("  %-44s %12zu columns\n", "person leaf columns", block.column_count);
+        if (row_sum != column_sum)
+        {
+            fprintf(stderr, "struct-meta-bench: 行と列で合計が一致しません\n");
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+    }
+
+    struct_meta_columnar_dispose(&block);
+    free(people);
+    return ret;
+}
+
+/**
+ *  @brief          person 配列の JSON テキストの書き出しと読み込みを、記述子の解釈と生成コーデックで比較します。
+ *
+ *  生成コーデックは struct-meta-gen --emit-codecs が出力した person_json_write() / person_json_read() です。
+ *  どちらもレコードごとに書き出し状態 (読み取り状態) を初期化し、同じテキストと同じ構造体になることを確認します。
+ */
+static int bench_codec(const struct_meta_descriptor *desc, size_t iterations)
+{
+    unsigned char *people = NULL;
+    unsigned char *generic_people = NULL;
+    unsigned char *generated_people = NULL;
+    size_t *offsets = NULL;
+    struct_meta_buffer generic_text;
+    struct_meta_buffer generated_text;
+    size_t rounds = iterations / BENCH_RECORD_COUNT;
+    size_t records;
+    uint64_t start;
+
+    if (rounds == 0U)
+    {
+        rounds = 1U;
+    }
+    records = rounds * BENCH_RECORD_COUNT;
+    int ret = make_people(desc, &people);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    struct_meta_buffer_init(&generic_text);
+    struct_meta_buffer_init(&generated_text);
+    generic_people = (unsigned char *)calloc(BENCH_RECORD_COUNT, desc->size);
+    generated_people = (unsigned char *)calloc(BENCH_RECORD_COUNT, desc->size);
+    offsets = (size_t *)malloc(sizeof(*offsets) * (BENCH_RECORD_COUNT + 1U));
+    if ((generic_people == NULL) || (generated_people == NULL) || (offsets == NULL))
+    {
+        ret = COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        struct_meta_buffer_reset(&generic_text);
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            ret = struct_meta_json_write_buffer(desc, people + (i * desc->size), STRUCT_META_JSON_FORMAT_PRETTY,
+                                                &generic_text);
+        }
+    }
+    uint64_t generic_write_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        struct_meta_buffer_reset(&generated_text);
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            struct_meta_json_writer writer;
+            offsets[i] = generated_text.length;
+            ret = struct_meta_json_writer_init_buffer(&writer, &generated_text, STRUCT_META_JSON_FORMAT_PRETTY);
+            if (ret == COM_UTIL_OK)
+            {
+                ret = person_json_write(&writer, (const person *)(const void *)(people + (i * desc->size)));
+            }
+        }
+    }
+    uint64_t generated_write_ns = now_ns() - start;
+    if (ret == COM_UTIL_OK)
+    {
+        offsets[BENCH_RECORD_COUNT] = generated_text.length;
+    }
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            ret = struct_meta_json_decode_text(desc, (const char *)generated_text.data + offsets[i],
+                                               offsets[i + 1U] - offsets[i], generic_people + (i * desc->size));
+        }
+    }
+    uint64_t generic_read_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            struct_meta_json_reader reader;
+            ret = struct_meta_json_reader_init_text(&reader, (const char *)generated_text.data + offsets[i],
+                                                    offsets[i + 1U] - offsets[i]);
+            if (ret == COM_UTIL_OK)
+            {
+                ret = person_json_read(&reader, (person *)(void *)(generated_people + (i * desc->size)));
+                struct_meta_json_reader_dispose(&reader);
+            }
+        }
+    }
+    uint64_t generated_read_ns = now_ns() - start;
+
+    if (ret == COM_UTIL_OK)
+    {
+        report("json_write_buffer (descriptor)", records, generic_write_ns);
+        report("person_json_write (generated)", records, generated_write_ns);
+        report("json_decode_text (descriptor)", records, generic_read_ns);
+        report("person_json_read (generated)", records, generated_read_ns);
+        if ((generic_text.length != generated_text.length) ||
+            (memcmp(generic_text.data, generated_text.data, generated_text.length) != 0))
+        {
+            fprintf(stderr, "struct-meta-bench: 生成コーデックのテキストが記述子による書き出しと一致しません\n");
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+        else if (memcmp(generic_people, generated_people, desc->size * BENCH_RECORD_COUNT) != 0)
+        {
+            fprintf(stderr, "struct-meta-bench: 生成コーデックの読み込み結果が記述子による読み込みと一致しません\n");
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+    }
+
+    struct_meta_buffer_dispose(&generic_text);
+    struct_meta_buffer_dispose(&generated_text);
+    free(offsets);
+    free(generated_people);
+    free(generic_people);
+    free(people);
+    return ret;
+}
+
+/**
+ *  @brief          1 個のフィールドだけを変更した person の送信量を、差分と JSON テキスト全体で比較します。
+ *
+ *  差分は struct_meta_diff() で求めて複製へ適用し、適用結果が変更後の構造体と一致することを確かめます。
+ *  送信量は、差分ではパスと値のバイト数、JSON では圧縮形式のテキストのバイト数です。
+ */
+static int bench_delta(const struct_meta_descriptor *desc, size_t iterations)
+{
+    unsigned char *people = NULL;
+    unsigned char *changed = NULL;
+    unsigned char *applied = NULL;
+    struct_meta_buffer text;
+    size_t rounds = iterations / BENCH_RECORD_COUNT;
+    size_t records;
+    size_t delta_bytes = 0U;
+    size_t json_bytes = 0U;
+    uint64_t start;
+
+    if (rounds == 0U)
+    {
+        rounds = 1U;
+    }
+    records = rounds * BENCH_RECORD_COUNT;
+    int ret = make_people(desc, &people);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    struct_meta_buffer_init(&text);
+    changed = (unsigned char *)malloc(desc->size * BENCH_RECORD_COUNT);
+    applied = (unsigned char *)malloc(desc->size * BENCH_RECORD_COUNT);
+    if ((changed == NULL) || (applied == NULL))
+    {
+        ret = COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        memcpy(changed, people, desc->size * BENCH_RECORD_COUNT);
+        memcpy(applied, people, desc->size * BENCH_RECORD_COUNT);
+    }
+    for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = set_int(desc, changed + (i * desc->size), "addresses[1].zip", (int)i);
+    }
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        delta_bytes = 0U;
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            struct_meta_delta delta;
+            ret = struct_meta_diff(desc, people + (i * desc->size), changed + (i * desc->size), &delta);
+            if (ret == COM_UTIL_OK)
+            {
+                ret = struct_meta_delta_apply(desc, &delta, applied + (i * desc->size));
+            }
+            for (size_t j = 0; (ret == COM_UTIL_OK) && (j < delta.count); j++)
+            {
+                delta_bytes += strlen(delta.entries[j].path) + 1U + delta.entries[j].size;
+            }
+            struct_meta_delta_dispose(&delta);
+        }
+    }
+    uint64_t delta_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        struct_meta_buffer_reset(&text);
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            ret = struct_meta_json_write_buffer(desc, changed + (i * desc->size), STRUCT_META_JSON_FORMAT_COMPACT,
+                                                &text);
+        }
+        json_bytes = text.length;
+    }
+    uint64_t json_ns = now_ns() - start;
+
+    if (ret == COM_UTIL_OK)
+    {
+        report("diff + delta_apply (1 field changed)", records, delta_ns);
+        report("json_write_buffer (compact, whole record)", records, json_ns);
+        printf("  %-44s %12.1f bytes/record\n", "delta payload", (double)delta_bytes / (double)BENCH_RECORD_COUNT);
+        printf("  %-44s %12.1f bytes/record\n", "json payload", (double)json_bytes / (double)BENCH_RECORD_COUNT);
+        if (memcmp(applied, changed, desc->size * BENCH_RECORD_COUNT) != 0)
+        {
+            fprintf(stderr, "struct-meta-bench: 差分の適用結果が変更後の構造体と一致しません\n");
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+    }
+
+    struct_meta_buffer_dispose(&text);
+    free(applied);
+    free(changed);
+    free(people);
+    return ret;
+}
+
+/**
+ *  @brief          person 配列のハッシュ値と等価判定を、JSON テキストのハッシュ値と比較します。
+ *
+ *  パディングを含むため memcmp やバイト列全体のハッシュは使えず、内容で比較する代替は JSON テキスト化です。
+ *  JSON テキストは空白なしで書き出し、64 ビット FNV-1a で要約します。
+ */
+static int bench_hash(const struct_meta_descriptor *desc, size_t iterations)
+{
+    unsigned char *people = NULL;
+    unsigned char *copies = NULL;
+    struct_meta_buffer text;
+    size_t rounds = iterations / BENCH_RECORD_COUNT;
+    size_t records;
+    size_t equal_count = 0U;
+    uint64_t hash = 0U;
+    uint64_t start;
+
+    if (rounds == 0U)
+    {
+        rounds = 1U;
+    }
+    records = rounds * BENCH_RECORD_COUNT;
+    int ret = make_people(desc, &people);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    struct_meta_buffer_init(&text);
+    copies = (unsigned char *)malloc(desc->size * BENCH_RECORD_COUNT);
+    if (copies == NULL)
+    {
+        ret = COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        memcpy(copies, people, desc->size * BENCH_RECORD_COUNT);
+    }
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            ret = struct_meta_hash(desc, people + (i * desc->size), &hash);
+        }
+    }
+    uint64_t hash_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            struct_meta_buffer_reset(&text);
+            ret = struct_meta_json_write_buffer(desc, people + (i * desc->size), STRUCT_META_JSON_FORMAT_COMPACT,
+                                                &text);
+            hash = 14695981039346656037ULL;
+            for (size_t j = 0; (ret == COM_UTIL_OK) && (j < text.length); j++)
+            {
+                hash ^= (uint64_t)text.data[j];
+                hash *= 1099511628211ULL;
+            }
+        }
+    }
+    uint64_t json_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            int equal = 0;
+            ret = struct_meta_equal(desc, people + (i * desc->size), copies + (i * desc->size), &equal);
+            equal_count += (size_t)equal;
+        }
+    }
+    uint64_t same_ns = now_ns() - start;
+
+    /* 隣の要素との比較は、バイト列が一致しないため走査手順を最後まで、または最初の違いまで辿る。 */
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            int equal = 0;
+            size_t other = (i + 1U) % BENCH_RECORD_COUNT;
+            ret = struct_meta_equal(desc, people + (i * desc->size), copies + (other * desc->size), &equal);
+            equal_count += (size_t)equal;
+        }
+    }
+    uint64_t differ_ns = now_ns() - start;
+
+    if (ret == COM_UTIL_OK)
+    {
+        report("struct_meta_hash", records, hash_ns);
+        report("json_write_buffer (compact) + FNV-1a", records, json_ns);
+        report("struct_meta_equal (identical copy)", records, same_ns);
+        report("struct_meta_equal (neighbour record)", records, differ_ns);
+        if (equal_count != records)
+        {
+            fprintf(stderr, "struct-meta-bench: 等価判定の結果が想定と一致しません\n");
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+    }
+
+    struct_meta_buffer_dispose(&text);
+    free(copies);
+    free(people);
+    return ret;
+}
+
+/**
+ *  @brief          person の JSON テキストとファイルの読み込みを、一時領域を毎回確保する場合とアリーナから確保する場合で比較します。
+ *
+ *  person の `addresses[1].city` はエスケープを含むため、単一パスの読み込みはレコードごとに展開用の領域を確保します。
+ *  アリーナは 1 件目の読み込みで育て (ウォームアップ)、以降にブロックが増えないことを確認します。
+ *  ファイルはカレント ディレクトリへ作り、計測後に削除します。
+ */
+static int bench_arena(const struct_meta_descriptor *desc, size_t iterations)
+{
+    unsigned char *people = NULL;
+    unsigned char *loaded = NULL;
+    size_t *offsets = NULL;
+    struct_meta_buffer text;
+    struct_meta_arena arena;
+    size_t rounds = iterations / BENCH_RECORD_COUNT;
+    size_t records;
+    size_t warm_blocks = 0U;
+    char path[64];
+    uint64_t start;
+
+    if (rounds == 0U)
+    {
+        rounds = 1U;
+    }
+    records = rounds * BENCH_RECORD_COUNT;
+    int ret = make_people(desc, &people);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    struct_meta_buffer_init(&text);
+    struct_meta_arena_init(&arena, 0U);
+    loaded = (unsigned char *)calloc(1U, desc->size);
+    offsets = (size_t *)malloc(sizeof(*offsets) * (BENCH_RECORD_COUNT + 1U));
+    if ((loaded == NULL) || (offsets == NULL))
+    {
+        ret = COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+    {
+        offsets[i] = text.length;
+        ret = struct_meta_json_write_buffer(desc, people + (i * desc->size), STRUCT_META_JSON_FORMAT_COMPACT, &text);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        offsets[BENCH_RECORD_COUNT] = text.length;
+    }
+    for (size_t i = 0; (i < BENCH_FILE_COUNT) && (ret == COM_UTIL_OK); i++)
+    {
+        (void)snprintf(path, sizeof(path), "struct-meta-bench-%zu.json", i);
+        ret = struct_meta_json_file_save(desc, people + (i * desc->size), path);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_json_decode_text_arena(desc, (const char *)text.data, offsets[1], loaded, &arena);
+        warm_blocks = arena.block_count;
+    }
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            ret = struct_meta_json_decode_text(desc, (const char *)text.data + offsets[i],
+                                               offsets[i + 1U] - offsets[i], loaded);
+        }
+    }
+    uint64_t heap_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            ret = struct_meta_json_decode_text_arena(desc, (const char *)text.data + offsets[i],
+                                                     offsets[i + 1U] - offsets[i], loaded, &arena);
+        }
+    }
+    uint64_t arena_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t i = 0; (i < BENCH_FILE_COUNT) && (ret == COM_UTIL_OK); i++)
+    {
+        (void)snprintf(path, sizeof(path), "struct-meta-bench-%zu.json", i);
+        ret = struct_meta_json_file_load(desc, path, loaded);
+    }
+    uint64_t file_heap_ns = now_ns() - start;
+
+    start = now_ns();
+    for (size_t i = 0; (i < BENCH_FILE_COUNT) && (ret == COM_UTIL_OK); i++)
+    {
+        (void)snprintf(path, sizeof(path), "struct-meta-bench-%zu.json", i);
+        ret = struct_meta_json_file_load_arena(desc, path, loaded, &arena);
+    }
+    uint64_t file_arena_ns = now_ns() - start;
+
+    if (ret == COM_UTIL_OK)
+    {
+        report("json_decode_text (heap scratch)", records, heap_ns);
+        report("json_decode_text_arena", records, arena_ns);
+        report("json_file_load (heap scratch)", BENCH_FILE_COUNT, file_heap_ns);
+        report("json_file_load_arena", BENCH_FILE_COUNT, file_arena_ns);
+        printf("  %-44s %12zu blocks\n", "arena blocks added after warm-up", arena.block_count - warm_blocks);
+        if (arena.block_count != warm_blocks)
+        {
+            fprintf(stderr, "struct-meta-bench: ウォームアップ後にアリーナのブロックが増えました\n");
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+    }
+
+    for (size_t i = 0; i < BENCH_FILE_COUNT; i++)
+    {
+        (void)snprintf(path, sizeof(path), "struct-meta-bench-%zu.json", i);
+        (void)remove(path);
+    }
+    struct_meta_arena_dispose(&arena);
+    struct_meta_buffer_dispose(&text);
+    free(offsets);
+    free(loaded);
+    free(people);
+    return ret;
+}
+
+/**
+ *  @brief          エラー時に元の内容へ戻す JSON テキストの読み込みを、一時領域へ複写して読み込む方法と比較します。
+ *
+ *  比較の基準は、構造体全体を一時領域へ複写して読み込み、成功後に複写し戻す方法です。
+ *  取り消しログは書き込むフィールドの範囲だけを記録し、置き換えは複写した領域へ読み込んでポインターを置き換えます。
+ *  テキストは score と home.zip だけを更新する部分更新と、全フィールドを含むテキストの 2 種類です。
+ */
+static int bench_atomic(const struct_meta_descriptor *desc, size_t iterations)
+{
+    static const char partial_text[] = "{\"score\":12.5,\"home\":{\"zip\":1234567}}";
+    unsigned char *people = NULL;
+    unsigned char *scratch = NULL;
+    unsigned char *slots = NULL;
+    struct_meta_buffer full_text;
+    struct_meta_buffer undo;
+    size_t rounds = iterations / BENCH_RECORD_COUNT;
+    size_t records;
+    uint64_t start;
+
+    if (rounds == 0U)
+    {
+        rounds = 1U;
+    }
+    records = rounds * BENCH_RECORD_COUNT;
+    int ret = make_people(desc, &people);
+    if (ret != COM_UTIL_OK)
+    {
+        return ret;
+    }
+    struct_meta_buffer_init(&full_text);
+    struct_meta_buffer_init(&undo);
+    scratch = (unsigned char *)malloc(desc->size);
+    slots = (unsigned char *)malloc(desc->size * 2U);
+    if ((scratch == NULL) || (slots == NULL))
+    {
+        ret = COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_json_write_buffer(desc, people, STRUCT_META_JSON_FORMAT_COMPACT, &full_text);
+    }
+
+    for (int full = 0; (full < 2) && (ret == COM_UTIL_OK); full++)
+    {
+        const char *text = partial_text;
+        size_t length = sizeof(partial_text) - 1U;
+        if (full != 0)
+        {
+            text = (const char *)full_text.data;
+            length = full_text.length;
+        }
+
+        start = now_ns();
+        for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+        {
+            for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+            {
+                unsigned char *person = people + (i * desc->size);
+                memcpy(scratch, person, desc->size);
+                ret = struct_meta_json_decode_text(desc, text, length, scratch);
+                if (ret == COM_UTIL_OK)
+                {
+                    memcpy(person, scratch, desc->size);
+                }
+            }
+        }
+        uint64_t copy_ns = now_ns() - start;
+
+        start = now_ns();
+        for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+        {
+            for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+            {
+                ret = struct_meta_json_decode_text_atomic(desc, text, length, people + (i * desc->size), &undo);
+            }
+        }
+        uint64_t undo_ns = now_ns() - start;
+
+        void *current = slots;
+        void *shadow = slots + desc->size;
+        if (ret == COM_UTIL_OK)
+        {
+            memcpy(current, people, desc->size);
+        }
+        start = now_ns();
+        for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+        {
+            for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+            {
+                ret = struct_meta_json_decode_text_swap(desc, text, length, &current, &shadow);
+            }
+        }
+        uint64_t swap_ns = now_ns() - start;
+
+        if (ret == COM_UTIL_OK)
+        {
+            report((full != 0) ? "copy + decode_text + copy back (full)" : "copy + decode_text + copy back (partial)",
+                   records, copy_ns);
+            report((full != 0) ? "json_decode_text_atomic (full)" : "json_decode_text_atomic (partial)", records,
+                   undo_ns);
+            report((full != 0) ? "json_decode_text_swap (full)" : "json_decode_text_swap (partial)", records, swap_ns);
+        }
+    }
+
+    /* 失敗する更新では、取り消しログにより元の内容へ戻ることを確かめる。 */
+    if (ret == COM_UTIL_OK)
+    {
+        static const char broken_text[] = "{\"score\":1.0,\"home\":{\"zip\":\"x\"}}";
+        memcpy(scratch, people, desc->size);
+        int broken = struct_meta_json_decode_text_atomic(desc, broken_text, sizeof(broken_text) - 1U, people, &undo);
+        if ((broken == COM_UTIL_OK) || (memcmp(scratch, people, desc->size) != 0))
+        {
+            fprintf(stderr, "struct-meta-bench: エラー時に読み込み前の内容へ戻りません\n");
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+    }
+
+    struct_meta_buffer_dispose(&undo);
+    struct_meta_buffer_dispose(&full_text);
+    free(slots);
+    free(scratch);
+    free(people);
+    return ret;
+}
+
+static void report_catalog(const char *label, int ret, const struct_meta_catalog_report *catalog)
+{
+    if (ret == COM_UTIL_OK)
+    {
+        report(label, catalog->descriptor_count, catalog->elapsed_ns);
+        printf("  %-44s %12.1f us  (%zu validated, %zu skipped, %zu threads)\n", "  startup total",
+               (double)catalog->elapsed_ns / 1000.0, catalog->validated_count, catalog->skipped_count,
+               catalog->thread_count);
+    }
+}
+
+static int bench_catalog(const struct_meta_descriptor *desc, size_t iterations)
+{
+    struct_meta_catalog_report catalog;
+    uint64_t start;
+    (void)iterations;
+
+    /* person と同じ内容の記述子をアドレスを変えて並べ、ネスト先を共有する大きな型一覧とする。 */
+    for (size_t set = 0; set < 2U; set++)
+    {
+        for (size_t i = 0; i < BENCH_CATALOG_SIZE; i++)
+        {
+            s_catalog_descriptors[set][i] = *desc;
+            s_catalog[set][i] = &s_catalog_descriptors[set][i];
+        }
+    }
+
+    int ret = sample_types_meta_validate_all(0U, &catalog);
+    if (ret != COM_UTIL_OK)
+    {
+        fprintf(stderr, "struct-meta-bench: 生成した型一覧の検査に失敗しました\n");
+        return ret;
+    }
+
+    start = now_ns();
+    for (size_t i = 0; (i < BENCH_CATALOG_SIZE) && (ret == COM_UTIL_OK); i++)
+    {
+        ret = struct_meta_descriptor_validate(s_catalog[0][i]);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        report("catalog validate (per descriptor)", BENCH_CATALOG_SIZE, now_ns() - start);
+    }
+
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_catalog_validate_all(s_catalog[0], BENCH_CATALOG_SIZE, 1U, &catalog);
+        report_catalog("catalog_validate_all (1 thread)", ret, &catalog);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_catalog_validate_all(s_catalog[1], BENCH_CATALOG_SIZE, 0U, &catalog);
+        report_catalog("catalog_validate_all (parallel)", ret, &catalog);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_catalog_validate_all(s_catalog[0], BENCH_CATALOG_SIZE, 1U, &catalog);
+        report_catalog("catalog_validate_all (sealed)", ret, &catalog);
+    }
+    return ret;
+}
+
+/**
+ *  @brief          従来の生成コードと同じ、型一覧の先頭から名前を比較する検索です。
+ */
+static const struct_meta_descriptor *find_linear(const struct_meta_descriptor *const *descriptors, size_t count,
+                                                 const char *name)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (strcmp(descriptors[i]->name, name) == 0)
+        {
+            return descriptors[i];
+        }
+    }
+    return NULL;
+}
+
+static int bench_find(const struct_meta_descriptor *desc, size_t iterations)
+{
+    size_t name_lengths[BENCH_CATALOG_SIZE];
+    uint64_t start;
+
+    for (size_t i = 0; i < BENCH_CATALOG_SIZE; i++)
+    {
+        int length = snprintf(s_find_names[i], sizeof(s_find_names[i]), "type%04zu", i);
+        name_lengths[i] = (size_t)length;
+        s_find_descriptors[i] = *desc;
+        s_find_descriptors[i].name = s_find_names[i];
+        s_find_catalog[i] = &s_find_descriptors[i];
+    }
+    int ret = struct_meta_catalog_register(s_find_catalog, BENCH_CATALOG_SIZE);
+    if (ret == COM_UTIL_OK)
+    {
+        ret = sample_types_meta_register();
+    }
+    if (ret != COM_UTIL_OK)
+    {
+        fprintf(stderr, "struct-meta-bench: 型一覧を名前索引へ登録できません\n");
+        return ret;
+    }
+
+    const struct_meta_descriptor *found = NULL;
+    start = now_ns();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        found = find_linear(s_find_catalog, BENCH_CATALOG_SIZE, s_find_names[i % BENCH_CATALOG_SIZE]);
+    }
+    report("find 1024 types (linear strcmp)", iterations, now_ns() - start);
+
+    start = now_ns();
+    for (size_t i = 0; (i < iterations) && (found != NULL); i++)
+    {
+        size_t k = i % BENCH_CATALOG_SIZE;
+        found = struct_meta_catalog_find(s_find_names[k], name_lengths[k]);
+    }
+    report("find 1024 types (struct_meta_catalog_find)", iterations, now_ns() - start);
+
+    start = now_ns();
+    for (size_t i = 0; (i < iterations) && (found != NULL); i++)
+    {
+        found = sample_types_meta_find("person");
+    }
+    report("sample_types_meta_find (perfect hash)", iterations, now_ns() - start);
+
+    if ((found != desc) || (struct_meta_catalog_find("person", 6U) != desc))
+    {
+        fprintf(stderr, "struct-meta-bench: 名前検索の結果が一致しません\n");
+        return COM_UTIL_ERR_UNKNOWN;
+    }
+    return COM_UTIL_OK;
+}
+
+/** 固定幅の種別で表した計測用のレコードです。 */
+typedef struct bench_kind_record
+{
+    int64_t id;     /**< 2^53 を超える識別子です。 */
+    uint64_t flags; /**< フラグの集合です。 */
+    int16_t delta;  /**< 差分です。 */
+    uint8_t level;  /**< 段階です。 */
+    bool active;    /**< 有効かどうかです。 */
+    uint32_t pad;   /**< 明示的アラインメントです。 */
+} bench_kind_record;
+
+/** 従来の種別 (double と int) だけで同じ値を表した計測用のレコードです。 */
+typedef struct bench_legacy_record
+{
+    double id;    /**< 識別子です。2^53 を超える値は丸められます。 */
+    double flags; /**< フラグの集合です。 */
+    int delta;    /**< 差分です。 */
+    int level;    /**< 段階です。 */
+    int active;   /**< 有効かどうかです。 */
+    int pad;      /**< 明示的アラインメントです。 */
+} bench_legacy_record;
+
+static const struct_meta_field s_kind_fields[] = {
+    {"id", STRUCT_META_FIELD_INT64, 0, offsetof(bench_kind_record, id), sizeof(int64_t), 1, 0, NULL, NULL, NULL, 0},
+    {"flags", STRUCT_META_FIELD_UINT64, 0, offsetof(bench_kind_record, flags), sizeof(uint64_t), 1, 0, NULL, NULL,
+     NULL, 0},
+    {"delta", STRUCT_META_FIELD_INT16, 0, offsetof(bench_kind_record, delta), sizeof(int16_t), 1, 0, NULL, NULL, NULL,
+     0},
+    {"level", STRUCT_META_FIELD_UINT8, 0, offsetof(bench_kind_record, level), sizeof(uint8_t), 1, 0, NULL, NULL, NULL,
+     0},
+    {"active", STRUCT_META_FIELD_BOOL, 0, offsetof(bench_kind_record, active), sizeof(bool), 1, 0, NULL, NULL, NULL,
+     0},
+};
+static const struct_meta_descriptor s_kind_descriptor = {"bench_kind_record", sizeof(bench_kind_record),
+                                                         s_kind_fields, 5, NULL};
+
+static const struct_meta_field s_legacy_fields[] = {
+    {"id", STRUCT_META_FIELD_DOUBLE, 0, offsetof(bench_legacy_record, id), sizeof(double), 1, 0, NULL, NULL, NULL, 0},
+    {"flags", STRUCT_META_FIELD_DOUBLE, 0, offsetof(bench_legacy_record, flags), sizeof(double), 1, 0, NULL, NULL,
+     NULL, 0},
+    {"delta", STRUCT_META_FIELD_INT, 0, offsetof(bench_legacy_record, delta), sizeof(int), 1, 0, NULL, NULL, NULL, 0},
+    {"level", STRUCT_META_FIELD_INT, 0, offsetof(bench_legacy_record, level), sizeof(int), 1, 0, NULL, NULL, NULL, 0},
+    {"active", STRUCT_META_FIELD_INT, 0, offsetof(bench_legacy_record, active), sizeof(int), 1, 0, NULL, NULL, NULL,
+     0},
+};
+static const struct_meta_descriptor s_legacy_descriptor = {"bench_legacy_record", sizeof(bench_legacy_record),
+                                                           s_legacy_fields, 5, NULL};
+
+/**
+ *  @brief          レコード 1 件を JSON テキストへ書き出して読み戻すことを繰り返します。
+ *  @param[out]     elapsed_out 経過時間です。
+ */
+static int kind_round_trip(const struct_meta_descriptor *desc, const void *records, void *decoded, size_t rounds,
+                           uint64_t *elapsed_out)
+{
+    struct_meta_buffer text;
+    struct_meta_buffer_init(&text);
+    int ret = COM_UTIL_OK;
+    uint64_t start = now_ns();
+    for (size_t round = 0; (round < rounds) && (ret == COM_UTIL_OK); round++)
+    {
+        for (size_t i = 0; (i < BENCH_RECORD_COUNT) && (ret == COM_UTIL_OK); i++)
+        {
+            struct_meta_buffer_reset(&text);
+            ret = struct_meta_json_write_buffer(desc, (const unsigned char *)records + (i * desc->size),
+                                                STRUCT_META_JSON_FORMAT_COMPACT, &text);
+            if (ret == COM_UTIL_OK)
+            {
+                ret = struct_meta_json_decode_text(desc, (const char *)text.data, text.length,
+                                                   (unsigned char *)decoded + (i * desc->size));
+            }
+        }
+    }
+    *elapsed_out = now_ns() - start;
+    struct_meta_buffer_dispose(&text);
+    return ret;
+}
+
+/**
+ *  @brief          固定幅整数と bool の種別と、同じ値を double と int で表す従来の記述子を比較します。
+ *
+ *  識別子は 2^53 を超えるため、double で表すと JSON テキストを経由した読み戻しで値が変わります。
+ *  両方の JSON 往復の時間、バイナリー形式の大きさ、読み戻した識別子が一致した件数を表示します。
+ */
+static int bench_kinds(const struct_meta_descriptor *desc, size_t iterations)
+{
+    size_t rounds = iterations / BENCH_RECORD_COUNT;
+    (void)desc;
+    if (rounds == 0U)
+    {
+        rounds = 1U;
+    }
+
+    bench_kind_record *records = (bench_kind_record *)calloc(BENCH_RECORD_COUNT * 2U, sizeof(*records));
+    bench_legacy_record *legacy = (bench_legacy_record *)calloc(BENCH_RECORD_COUNT * 2U, sizeof(*legacy));
+    if ((records == NULL) || (legacy == NULL))
+    {
+        free(records);
+        free(legacy);
+        return COM_UTIL_ERR_OUT_OF_MEMORY;
+    }
+    for (size_t i = 0; i < BENCH_RECORD_COUNT; i++)
+    {
+        records[i].id = (INT64_C(1) << 60) + (int64_t)i;
+        records[i].flags = UINT64_C(0x8000000000000001) | ((uint64_t)i << 8);
+        records[i].delta = (int16_t)((int)(i % 200U) - 100);
+        records[i].level = (uint8_t)(i % 8U);
+        records[i].active = (i % 3U) != 0U;
+        legacy[i].id = (double)records[i].id;
+        legacy[i].flags = (double)records[i].flags;
+        legacy[i].delta = records[i].delta;
+        legacy[i].level = records[i].level;
+        legacy[i].active = records[i].active ? 1 : 0;
+    }
+
+    uint64_t kind_ns = 0U;
+    uint64_t legacy_ns = 0U;
+    int ret = kind_round_trip(&s_kind_descriptor, records, records + BENCH_RECORD_COUNT, rounds, &kind_ns);
+    if (ret == COM_UTIL_OK)
+    {
+        ret = kind_round_trip(&s_legacy_descriptor, legacy, legacy + BENCH_RECORD_COUNT, rounds, &legacy_ns);
+    }
+    size_t kind_size = 0U;
+    size_t legacy_size = 0U;
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_binary_encoded_size(&s_kind_descriptor, &kind_size);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_binary_encoded_size(&s_legacy_descriptor, &legacy_size);
+    }
+
+    if (ret == COM_UTIL_OK)
+    {
+        size_t kind_exact = 0U;
+        size_t legacy_exact = 0U;
+        for (size_t i = 0; i < BENCH_RECORD_COUNT; i++)
+        {
+            kind_exact += (size_t)(records[BENCH_RECORD_COUNT + i].id == records[i].id);
+            legacy_exact += (size_t)((int64_t)legacy[BENCH_RECORD_COUNT + i].id == records[i].id);
+        }
+        report("json round trip (int64/uint64/int16/uint8/bool)", rounds * BENCH_RECORD_COUNT, kind_ns);
+        report("json round trip (double/int)", rounds * BENCH_RECORD_COUNT, legacy_ns);
+        printf("  %-44s %12zu bytes / %zu bytes\n", "binary record size (fixed-width / legacy)", kind_size,
+               legacy_size);
+        printf("  %-44s %12zu / %zu (fixed-width), %zu / %zu (legacy)\n", "ids read back exactly", kind_exact,
+               (size_t)BENCH_RECORD_COUNT, legacy_exact, (size_t)BENCH_RECORD_COUNT);
+        if (kind_exact != BENCH_RECORD_COUNT)
+        {
+            fprintf(stderr, "struct-meta-bench: 64 ビット整数を正確に読み戻せません\n");
+            ret = COM_UTIL_ERR_UNKNOWN;
+        }
+    }
+
+    free(records);
+    free(legacy);
+    return ret;
+}
+
+static const bench_case s_cases[] = {
+    {"validate", "記述子の入口検査 (毎回の再帰検査と登録済み検査)", bench_validate},
+    {"lookup", "フィールド名検索とパス解決 (線形探索、名前索引、解決済みパス)", bench_lookup},
+    {"json_text", "person 10000 件の JSON テキスト化 (cJSON ツリー経由と直接書き出し)", bench_json_text},
+    {"json_parse", "person 10000 件の JSON テキスト読み込み (cJSON ツリー経由と単一パス)", bench_json_parse},
+    {"json_array", "person 10000 件の JSON 配列の書き出しと読み込み (逐次と並行)", bench_json_array},
+    {"binary", "person 10000 件の保存と復元 (JSON テキストとバイナリー形式)", bench_binary},
+    {"mmap_store", "保存済み person の読み出し (レコードごとの JSON ファイルとマップしたストア)", bench_mmap_store},
+    {"ndjson", "person の NDJSON ストリーム書き出しと 1 行ずつの読み込み", bench_ndjson},
+    {"column", "person 配列からの 1 個の値の列への一括複写 (要素ごとの取得との比較)", bench_column},
+    {"columnar", "person 配列の列ブロックへの変換と、score の合計 (行ごとのアクセスとの比較)", bench_columnar},
+    {"codec", "person 10000 件の JSON 書き出しと読み込み (記述子の解釈と生成コーデック)", bench_codec},
+    {"delta", "1 個の値を変更した person の差分の作成と適用 (JSON テキスト全体との比較)", bench_delta},
+    {"hash", "person 10000 件のハッシュ値と等価判定 (JSON テキストのハッシュとの比較)", bench_hash},
+    {"arena", "person の JSON テキストとファイルの読み込み (一時領域の毎回の確保とアリーナ)", bench_arena},
+    {"atomic", "エラー時に元へ戻す person の読み込み (全体の複写、取り消しログ、ポインターの置き換え)", bench_atomic},
+    {"catalog", "person 1024 個分の記述子の起動時の一括検査 (記述子ごと、逐次、並行、登録済み)", bench_catalog},
+    {"find", "構造体名による記述子の検索 (線形探索、型一覧をまたぐ索引、生成した完全ハッシュ)", bench_find},
+    {"kinds", "固定幅整数と bool の JSON 往復とバイナリー形式の大きさ (double と int で表す場合との比較)", bench_kinds},
+};
+
+static void print_usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [--iterations <count>] [case ...]\n", prog);
+    fprintf(stderr, "cases:\n");
+    for (size_t i = 0; i < (sizeof(s_cases) / sizeof(s_cases[0])); i++)
+    {
+        fprintf(stderr, "  %-12s %s\n", s_cases[i].name, s_cases[i].summary);
+    }
+}
+
+static int parse_iterations(const char *text, size_t *iterations_out)
+{
+    char *end = NULL;
+    errno = 0;
+    unsigned long long value = strtoull(text, &end, 10);
+    if ((errno != 0) || (end == text) || (*end != '\0') || (value == 0U) || (value > SIZE_MAX) || (text[0] == '-'))
+    {
+        return COM_UTIL_ERR_INVALID_INTEGER;
+    }
+    *iterations_out = (size_t)value;
+    return COM_UTIL_OK;
+}
+
+static int run_case(const bench_case *entry, const struct_meta_descriptor *desc, size_t iterations)
+{
+    printf("%s: %s\n", entry->name, entry->summary);
+    int ret = entry->run(desc, iterations);
+    if (ret != COM_UTIL_OK)
+    {
+        fprintf(stderr, "struct-meta-bench: %s が失敗しました (結果コード %d)\n", entry->name, ret);
+    }
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    size_t iterations = BENCH_DEFAULT_ITERATIONS;
+    int first_case = argc;
+    int exit_code = EXIT_SUCCESS;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--iterations") == 0) && ((i + 1) < argc))
+        {
+            if (parse_iterations(argv[++i], &iterations) != COM_UTIL_OK)
+            {
+                fprintf(stderr, "struct-meta-bench: 反復回数が不正です: %s\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+        }
+        else if ((strcmp(argv[i], "-h") == 0) || (strcmp(argv[i], "--help") == 0))
+        {
+            print_usage(argv[0]);
+            return EXIT_SUCCESS;
+        }
+        else if (argv[i][0] == '-')
+        {
+            fprintf(stderr, "struct-meta-bench: 未知の引数です: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        else
+        {
+            first_case = i;
+            break;
+        }
+    }
+
+    const struct_meta_descriptor *desc = sample_types_meta_find("person");
+    if (desc == NULL)
+    {
+        fprintf(stderr, "struct-meta-bench: person の記述子を取得できません\n");
+        return EXIT_FAILURE;
+    }
+
+    if (first_case == argc)
+    {
+        for (size_t i = 0; i < (sizeof(s_cases) / sizeof(s_cases[0])); i++)
+        {
+            if (run_case(&s_cases[i], desc, iterations) != COM_UTIL_OK)
+            {
+                exit_code = EXIT_FAILURE;
+            }
+        }
+        return exit_code;
+    }
+
+    for (int i = first_case; i < argc; i++)
+    {
+        const bench_case *entry = NULL;
+        for (size_t j = 0; j < (sizeof(s_cases) / sizeof(s_cases[0])); j++)
+        {
+            if (strcmp(argv[i], s_cases[j].name) == 0)
+            {
+                entry = &s_cases[j];
+                break;
+            }
+        }
+        if (entry == NULL)
+        {
+            fprintf(stderr, "struct-meta-bench: 未知のケースです: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        if (run_case(entry, desc, iterations) != COM_UTIL_OK)
+        {
+            exit_code = EXIT_FAILURE;
+        }
+    }
+    return exit_code;
+}
@@ -1,2 +1,15 @@
 # ライブラリの指定
 LIBS += com_util
+ifdef PLATFORM_LINUX
+    # 複数ヘッダーの並行生成 (base/parallel.c) で POSIX スレッドを使う
+    LIBS += pthread
+endif
+
+# ライブラリ内共有ヘッダー (struct_meta_internal_*) を参照する
+INCDIR += \
+    $(MYAPP_DIR)/prod/include_internal
+
+# バッチ モードの並行実行は struct_meta ライブラリと同じ実装を使う。
+# 生成ツールはライブラリより先にビルドするため、ソースを直接取り込む。
+ADD_SRCS += \
+    $(MYAPP_DIR)/prod/libsrc/struct_meta/base/parallel.c
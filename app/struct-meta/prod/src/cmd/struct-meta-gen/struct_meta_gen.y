@@ -7,23 +7,39 @@
  *
  * Phase 2: フィールドの型に同一ヘッダー内の他の typedef struct 名を指定できる
  * (ネスト構造体)。また char[] 以外の型にも固定長配列を指定できる。
+ *
+ * 固定幅整数 (int8_t など)、bool、列挙型のフィールドを扱う。typedef enum 宣言は型名だけを記録し、
+ * 列挙子の本体は読み飛ばす。他のヘッダーの列挙型は `enum tag` と書く必要がある。
+ *
+ * ポインター メンバーは文字列 (`char *`) だけを扱う。可変長配列は STRUCT_META_SEQUENCE(要素型) と書き、
+ * 要素型には char * と、char 配列以外のフィールドに書ける型を指定できる。
+ *
+ * 複数のヘッダーを並行して解析できるよう、純粋パーサー (api.pure) とし、
+ * 解析結果と行番号はグローバル変数ではなく struct_meta_gen_parse_state に持つ。
  */
 
-%{
-#include "struct_meta_gen_ast.h"
+%code requires {
+#include "struct_meta_gen_parse.h"
 
+/* flex の再入可能スキャナーのハンドル。flex 側の定義と同じ型で、二重定義を避ける。 */
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void *yyscan_t;
+#endif
+}
+
+%{
 #include <com_util/crt/string.h>
 
 #include <stdio.h>
 #include <stdlib.h>
-
-extern int g_line;
-int yylex(void);
-static void yyerror(const char *msg);
-
-struct_meta_gen_struct_list *g_struct_meta_gen_structs = NULL;
+#include <string.h>
 %}
 
+%define api.pure full
+%lex-param {yyscan_t scanner}
+%parse-param {yyscan_t scanner} {struct_meta_gen_parse_state *state}
+
 %union {
     char *str;
     long num;
@@ -34,9 +50,11 @@ struct_meta_gen_struct_list *g_struct_meta_gen_structs = NULL;
     struct struct_meta_gen_struct *strct;
 }
 
-%token TYPEDEF STRUCT
+%token TYPEDEF STRUCT ENUM
 %token T_INT T_UNSIGNED T_CHAR T_FLOAT T_DOUBLE
-%token LBRACE RBRACE LBRACKET RBRACKET SEMI COMMA STAR
+%token <str> T_FIXED_INT T_BOOL
+%token SEQUENCE
+%token LBRACE RBRACE LBRACKET RBRACKET LPAREN RPAREN SEMI COMMA STAR
 %token <str> IDENT
 %token <str> DOC_PREFIX DOC_POSTFIX
 %token <num> INTEGER
@@ -45,15 +63,21 @@ struct_meta_gen_struct_list *g_struct_meta_gen_structs = NULL;
 %type <strct> typedef_struct_decl
 %type <field_list> field_decl_list
 %type <field> field_decl
-%type <typespec> type_spec
+%type <typespec> type_spec element_spec
 %type <str> doc_prefix_tokens
 %type <doc> doc_prefix doc_postfix
 
+%code {
+int yylex(YYSTYPE *yylval_param, yyscan_t scanner);
+static void yyerror(yyscan_t scanner, struct_meta_gen_parse_state *state, const char *msg);
+}
+
 %%
 
 translation_unit:
       /* empty */
-    | translation_unit typedef_struct_decl { struct_meta_gen_struct_list_append(&g_struct_meta_gen_structs, $2); }
+    | translation_unit typedef_struct_decl { struct_meta_gen_struct_list_append(&state->structs, $2); }
+    | translation_unit typedef_enum_decl
     | translation_unit SEMI
     | translation_unit error SEMI { yyerrok; }
     ;
@@ -97,6 +121,48 @@ typedef_struct_decl:
         }
     ;
 
+typedef_enum_decl:
+      doc_prefix TYPEDEF ENUM LBRACE enum_body RBRACE IDENT SEMI doc_postfix
+        {
+            free($1.brief);
+            free($1.json_name);
+            free($9.brief);
+            free($9.json_name);
+            if (struct_meta_gen_name_list_add(&state->enum_names, $7) != 0)
+            {
+                state->error = 1;
+                YYABORT;
+            }
+        }
+    | doc_prefix TYPEDEF ENUM IDENT LBRACE enum_body RBRACE IDENT SEMI doc_postfix
+        {
+            free($1.brief);
+            free($1.json_name);
+            free($4);
+            free($10.brief);
+            free($10.json_name);
+            if (struct_meta_gen_name_list_add(&state->enum_names, $8) != 0)
+            {
+                state->error = 1;
+                YYABORT;
+            }
+        }
+    ;
+
+/* 列挙子と値の式は記述子に現れないため、字句だけを読み飛ばす。 */
+enum_body:
+      /* empty */
+    | enum_body IDENT { free($2); }
+    | enum_body DOC_PREFIX { free($2); }
+    | enum_body DOC_POSTFIX { free($2); }
+    | enum_body INTEGER
+    | enum_body COMMA
+    | enum_body STAR
+    | enum_body LPAREN
+    | enum_body RPAREN
+    | enum_body OTHER
+    ;
+
 field_decl_list:
       field_decl { $$ = struct_meta_gen_field_list_create($1); }
     | field_decl_list field_decl { $$ = struct_meta_gen_field_list_append($1, $2); }
@@ -106,35 +172,117 @@ field_decl:
       doc_prefix type_spec IDENT SEMI doc_postfix
         {
             struct_meta_gen_doc_attrs attrs = struct_meta_gen_doc_attrs_choose($1, $5);
-            $$ = struct_meta_gen_field_create($3, $2.name, $2.is_struct, 0, g_line, attrs.brief, attrs.json_name, attrs.json_ignore,
-                                 attrs.json_required);
+            $$ = struct_meta_gen_field_create($3, $2.name, $2.is_struct, $2.is_enum, 0, state->line, attrs.brief, attrs.json_name, attrs.json_ignore,
+                                 attrs.json_required, attrs.layout_hot, attrs.layout_cold);
         }
     | doc_prefix type_spec IDENT LBRACKET INTEGER RBRACKET SEMI doc_postfix
         {
             struct_meta_gen_doc_attrs attrs = struct_meta_gen_doc_attrs_choose($1, $8);
-            $$ = struct_meta_gen_field_create($3, $2.name, $2.is_struct, $5, g_line, attrs.brief, attrs.json_name, attrs.json_ignore,
-                                 attrs.json_required);
+            $$ = struct_meta_gen_field_create($3, $2.name, $2.is_struct, $2.is_enum, $5, state->line, attrs.brief, attrs.json_name, attrs.json_ignore,
+                                 attrs.json_required, attrs.layout_hot, attrs.layout_cold);
         }
     | doc_prefix type_spec STAR IDENT SEMI doc_postfix
         {
-            fprintf(stderr, "struct-meta-gen: %d: ポインター メンバーは非対応です: %s\n", g_line, $4);
-            exit(1);
+            if (struct_meta_gen_typespec_to_string(&$2) != 0)
+            {
+                fprintf(stderr, "struct-meta-gen: %s:%d: char * 以外のポインター メンバーは非対応です: %s\n",
+                        state->header_path, state->line, $4);
+                free($2.name);
+                free($4);
+                state->error = 1;
+                YYABORT;
+            }
+            struct_meta_gen_doc_attrs attrs = struct_meta_gen_doc_attrs_choose($1, $6);
+            $$ = struct_meta_gen_field_create($4, $2.name, 0, 0, 0, state->line, attrs.brief, attrs.json_name, attrs.json_ignore,
+                                 attrs.json_required, attrs.layout_hot, attrs.layout_cold);
+        }
+    | doc_prefix type_spec STAR IDENT LBRACKET INTEGER RBRACKET SEMI doc_postfix
+        {
+            if (struct_meta_gen_typespec_to_string(&$2) != 0)
+            {
+                fprintf(stderr, "struct-meta-gen: %s:%d: char * 以外のポインター メンバーは非対応です: %s\n",
+                        state->header_path, state->line, $4);
+                free($2.name);
+                free($4);
+                state->error = 1;
+                YYABORT;
+            }
+            struct_meta_gen_doc_attrs attrs = struct_meta_gen_doc_attrs_choose($1, $9);
+            $$ = struct_meta_gen_field_create($4, $2.name, 0, 0, $6, state->line, attrs.brief, attrs.json_name, attrs.json_ignore,
+                                 attrs.json_required, attrs.layout_hot, attrs.layout_cold);
+        }
+    | doc_prefix SEQUENCE LPAREN element_spec RPAREN IDENT SEMI doc_postfix
+        {
+            if ((!$4.is_struct) && (!$4.is_enum) && (strcmp($4.name, "char") == 0))
+            {
+                fprintf(stderr, "struct-meta-gen: %s:%d: char の可変長配列は非対応です (char * を使います): %s\n",
+                        state->header_path, state->line, $6);
+                free($4.name);
+                free($6);
+                state->error = 1;
+                YYABORT;
+            }
+            struct_meta_gen_doc_attrs attrs = struct_meta_gen_doc_attrs_choose($1, $8);
+            $$ = struct_meta_gen_field_create($6, $4.name, $4.is_struct, $4.is_enum, 0, state->line, attrs.brief, attrs.json_name, attrs.json_ignore,
+                                 attrs.json_required, attrs.layout_hot, attrs.layout_cold);
+            if ($$ != NULL)
+            {
+                $$->is_sequence = 1;
+            }
+        }
+    ;
+
+element_spec:
+      type_spec { $$ = $1; }
+    | type_spec STAR
+        {
+            if (struct_meta_gen_typespec_to_string(&$1) != 0)
+            {
+                fprintf(stderr, "struct-meta-gen: %s:%d: char * 以外のポインターの可変長配列は非対応です\n",
+                        state->header_path, state->line);
+                free($1.name);
+                state->error = 1;
+                YYABORT;
+            }
+            $$ = $1;
         }
     ;
 
 type_spec:
-      T_INT { $$.name = com_util_strdup("int"); $$.is_struct = 0; }
-    | T_UNSIGNED { $$.name = com_util_strdup("unsigned"); $$.is_struct = 0; }
-    | T_UNSIGNED T_INT { $$.name = com_util_strdup("unsigned"); $$.is_struct = 0; }
-    | T_CHAR { $$.name = com_util_strdup("char"); $$.is_struct = 0; }
-    | T_FLOAT { $$.name = com_util_strdup("float"); $$.is_struct = 0; }
-    | T_DOUBLE { $$.name = com_util_strdup("double"); $$.is_struct = 0; }
-    | IDENT { $$.name = $1; $$.is_struct = 1; }
+      T_INT { $$.name = com_util_strdup("int"); $$.is_struct = 0; $$.is_enum = 0; }
+    | T_UNSIGNED { $$.name = com_util_strdup("unsigned"); $$.is_struct = 0; $$.is_enum = 0; }
+    | T_UNSIGNED T_INT { $$.name = com_util_strdup("unsigned"); $$.is_struct = 0; $$.is_enum = 0; }
+    | T_UNSIGNED T_CHAR { $$.name = com_util_strdup("unsigned char"); $$.is_struct = 0; $$.is_enum = 0; }
+    | T_CHAR { $$.name = com_util_strdup("char"); $$.is_struct = 0; $$.is_enum = 0; }
+    | T_FLOAT { $$.name = com_util_strdup("float"); $$.is_struct = 0; $$.is_enum = 0; }
+    | T_DOUBLE { $$.name = com_util_strdup("double"); $$.is_struct = 0; $$.is_enum = 0; }
+    | T_FIXED_INT { $$.name = $1; $$.is_struct = 0; $$.is_enum = 0; }
+    | T_BOOL { $$.name = $1; $$.is_struct = 0; $$.is_enum = 0; }
+    | ENUM IDENT
+        {
+            size_t length = sizeof("enum ") + strlen($2);
+            $$.name = (char *)malloc(length);
+            if ($$.name != NULL)
+            {
+                snprintf($$.name, length, "enum %s", $2);
+            }
+            free($2);
+            $$.is_struct = 0;
+            $$.is_enum = 1;
+        }
+    | IDENT
+        {
+            /* 同じヘッダーで宣言した typedef enum の名前は列挙型、それ以外は構造体名とする。 */
+            $$.name = $1;
+            $$.is_enum = struct_meta_gen_name_list_contains(state->enum_names, $1);
+            $$.is_struct = !$$.is_enum;
+        }
     ;
 
 %%
 
-static void yyerror(const char *msg)
+static void yyerror(yyscan_t scanner, struct_meta_gen_parse_state *state, const char *msg)
 {
-    fprintf(stderr, "struct-meta-gen: %d: %s\n", g_line, msg);
+    (void)scanner;
+    fprintf(stderr, "struct-meta-gen: %s:%d: %s\n", state->header_path, state->line, msg);
 }
@@ -17,9 +17,10 @@
 #include <stdlib.h>
 #include <string.h>
 
-struct_meta_gen_field *struct_meta_gen_field_create(char *name, char *type_name, int is_struct_type, long array_count,
-                                                    int line, char *brief, char *json_name, int json_ignore,
-                                                    int json_required)
+struct_meta_gen_field *struct_meta_gen_field_create(char *name, char *type_name, int is_struct_type, int is_enum_type,
+                                                    long array_count, int line, char *brief, char *json_name,
+                                                    int json_ignore, int json_required, int layout_hot,
+                                                    int layout_cold)
 {
     struct_meta_gen_field *field = (struct_meta_gen_field *)calloc(1, sizeof(*field));
     if (field == NULL)
@@ -32,7 +33,11 @@ struct_meta_gen_field *struct_meta_gen_field_create(char *name, char *type_name,
     field->json_name = json_name;
     field->json_ignore = json_ignore;
     field->json_required = json_required;
+    field->layout_hot = layout_hot;
+    field->layout_cold = layout_cold;
     field->is_struct_type = is_struct_type;
+    field->is_enum_type = is_enum_type;
+    field->is_sequence = 0;
     field->array_count = array_count;
     field->line = line;
     field->next = NULL;
@@ -92,6 +97,72 @@ void struct_meta_gen_struct_list_append(struct_meta_gen_struct_list **list, stru
     }
 }
 
+void struct_meta_gen_struct_list_destroy(struct_meta_gen_struct_list *list)
+{
+    if (list == NULL)
+    {
+        return;
+    }
+    struct_meta_gen_struct *s = list->head;
+    while (s != NULL)
+    {
+        struct_meta_gen_struct *next_struct = s->next;
+        struct_meta_gen_field *f = s->fields;
+        while (f != NULL)
+        {
+            struct_meta_gen_field *next_field = f->next;
+            free(f->name);
+            free(f->type_name);
+            free(f->brief);
+            free(f->json_name);
+            free(f);
+            f = next_field;
+        }
+        free(s->name);
+        free(s->brief);
+        free(s);
+        s = next_struct;
+    }
+    free(list);
+}
+
+int struct_meta_gen_name_list_add(struct_meta_gen_name_list **list, char *name)
+{
+    struct_meta_gen_name_list *node = (struct_meta_gen_name_list *)calloc(1, sizeof(*node));
+    if (node == NULL)
+    {
+        free(name);
+        return 1;
+    }
+    node->name = name;
+    node->next = *list;
+    *list = node;
+    return 0;
+}
+
+int struct_meta_gen_name_list_contains(const struct_meta_gen_name_list *list, const char *name)
+{
+    for (; list != NULL; list = list->next)
+    {
+        if (strcmp(list->name, name) == 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void struct_meta_gen_name_list_destroy(struct_meta_gen_name_list *list)
+{
+    while (list != NULL)
+    {
+        struct_meta_gen_name_list *next = list->next;
+        free(list->name);
+        free(list);
+        list = next;
+    }
+}
+
 const struct_meta_gen_struct *struct_meta_gen_struct_list_find(const struct_meta_gen_struct_list *list,
                                                                const char *name)
 {
@@ -367,6 +438,23 @@ static char *extract_brief_tag(const char *stripped)
     return collapse_ws(begin, end);
 }
 
+int struct_meta_gen_typespec_to_string(struct_meta_gen_typespec *spec)
+{
+    if ((spec->is_struct) || (spec->is_enum) || (strcmp(spec->name, "char") != 0))
+    {
+        return 1;
+    }
+    char *name = (char *)malloc(sizeof("char *"));
+    if (name == NULL)
+    {
+        return 1;
+    }
+    memcpy(name, "char *", sizeof("char *"));
+    free(spec->name);
+    spec->name = name;
+    return 0;
+}
+
 int struct_meta_gen_doc_has_file_tag(const char *raw)
 {
     char *stripped;
@@ -458,7 +546,7 @@ static char *extract_json_name_value(const char *text)
     return out;
 }
 
-static char *copy_without_json_cmds(const char *text)
+static char *copy_without_tag_cmds(const char *text)
 {
     size_t len = strlen(text);
     char *out = (char *)malloc(len + 1U);
@@ -497,6 +585,16 @@ static char *copy_without_json_cmds(const char *text)
                 p += 14;
                 continue;
             }
+            if ((strncmp(p + 1, "layout_hot", 10) == 0) && (cmd_ends_here(p[11]) != 0))
+            {
+                p += 11;
+                continue;
+            }
+            if ((strncmp(p + 1, "layout_cold", 11) == 0) && (cmd_ends_here(p[12]) != 0))
+            {
+                p += 12;
+                continue;
+            }
         }
         out[o] = *p;
         o++;
@@ -509,7 +607,7 @@ static char *copy_without_json_cmds(const char *text)
 char *struct_meta_gen_brief_from_doc(const char *raw, int is_postfix)
 {
     char *stripped;
-    char *without_json;
+    char *without_tags;
     char *brief;
 
     if (raw == NULL)
@@ -523,19 +621,19 @@ char *struct_meta_gen_brief_from_doc(const char *raw, int is_postfix)
         return NULL;
     }
 
-    without_json = copy_without_json_cmds(stripped);
+    without_tags = copy_without_tag_cmds(stripped);
     free(stripped);
-    if (without_json == NULL)
+    if (without_tags == NULL)
     {
         return NULL;
     }
 
-    brief = extract_brief_tag(without_json); /* 複数あるときは最後の @brief を使う */
+    brief = extract_brief_tag(without_tags); /* 複数あるときは最後の @brief を使う */
     if ((brief == NULL) && (is_postfix != 0))
     {
-        brief = collapse_ws(without_json, without_json + strlen(without_json));
+        brief = collapse_ws(without_tags, without_tags + strlen(without_tags));
     }
-    free(without_json);
+    free(without_tags);
     return brief;
 }
 
@@ -561,6 +659,13 @@ struct_meta_gen_doc_attrs struct_meta_gen_doc_attrs_from_raw(const char *raw, in
     attrs.has_json_ignore = attrs.json_ignore;
     attrs.json_required = (find_cmd_last(stripped, "json_required") != NULL) ? 1 : 0;
     attrs.has_json_required = attrs.json_required;
+    {
+        const char *hot = find_cmd_last(stripped, "layout_hot");
+        const char *cold = find_cmd_last(stripped, "layout_cold");
+        attrs.layout_hot = ((hot != NULL) && ((cold == NULL) || (hot > cold))) ? 1 : 0;
+        attrs.layout_cold = ((cold != NULL) && (attrs.layout_hot == 0)) ? 1 : 0;
+        attrs.has_layout = ((hot != NULL) || (cold != NULL)) ? 1 : 0;
+    }
     free(stripped);
     return attrs;
 }
@@ -595,6 +700,12 @@ struct_meta_gen_doc_attrs struct_meta_gen_doc_attrs_choose(struct_meta_gen_doc_a
         out.json_required = postfix.json_required;
         out.has_json_required = 1;
     }
+    if (postfix.has_layout != 0)
+    {
+        out.layout_hot = postfix.layout_hot;
+        out.layout_cold = postfix.layout_cold;
+        out.has_layout = 1;
+    }
     return out;
 }
 
@@ -23,10 +23,11 @@
  */
 typedef struct struct_meta_gen_typespec
 {
-    char *name;    /**< 型のスペリングです ("int"/"unsigned"/"char"/"float"/"double"、
-                       *   または他の `typedef struct` の名前 (ネスト メンバー))。 */
-    int is_struct; /**< 1 なら `name` は同一ヘッダー内の構造体名 (ネスト メンバー) です。 */
-    int pad;       /**< 明示的アラインメント (構造体全体を 8 バイト境界へ揃える)。 */
+    char *name;    /**< 型のスペリングです ("int"/"unsigned"/"char"/"float"/"double"/"unsigned char"、
+                       *   "int8_t" などの固定幅整数、"bool"/"_Bool"、列挙型 ("enum tag" または typedef 名)、
+                       *   文字列 ("char *")、または他の `typedef struct` の名前 (ネスト メンバー))。 */
+    int is_struct; /**< 1 なら `name` は構造体名 (ネスト メンバー) です。 */
+    int is_enum;   /**< 1 なら `name` は列挙型です。 */
 } struct_meta_gen_typespec;
 
 /**
@@ -40,9 +41,13 @@ typedef struct struct_meta_gen_field
     char *json_name;    /**< `@json_name{...}` の値です。無いときは NULL です。 */
     int json_ignore;    /**< `@json_ignore` があれば 1 です。 */
     int json_required;  /**< `@json_required` があれば 1 です。 */
+    int layout_hot;     /**< `@layout_hot` があれば 1 です。 */
+    int layout_cold;    /**< `@layout_cold` があれば 1 です。 */
     long array_count;   /**< `[N]` の N です。スカラー フィールドは 0 です。 */
     int line;           /**< ソース上の行番号です (診断メッセージ用)。 */
-    int is_struct_type; /**< 1 なら `type_name` は同一ヘッダー内の構造体名 (ネスト メンバー) です。 */
+    int is_struct_type; /**< 1 なら `type_name` は構造体名 (ネスト メンバー) です。他のヘッダーの型も含みます。 */
+    int is_enum_type;   /**< 1 なら `type_name` は列挙型です。 */
+    int is_sequence;    /**< 1 なら `STRUCT_META_SEQUENCE(type_name)` の可変長配列です。 */
     struct struct_meta_gen_field *next;
 } struct_meta_gen_field;
 
@@ -76,7 +81,9 @@ typedef struct struct_meta_gen_struct_list
 } struct_meta_gen_struct_list;
 
 /**
- *  @brief          1 コメントから取り出した説明と JSON タグです。
+ *  @brief          1 コメントから取り出した説明と JSON タグ、参照頻度のタグです。
+ *
+ *  `@layout_hot` と `@layout_cold` は、同じコメントでは後に書いた方を使います。
  */
 typedef struct struct_meta_gen_doc_attrs
 {
@@ -87,21 +94,59 @@ typedef struct struct_meta_gen_doc_attrs
     int has_json_name;
     int has_json_ignore;
     int has_json_required;
-    int pad;
+    int layout_hot;
+    int layout_cold;
+    int has_layout;
 } struct_meta_gen_doc_attrs;
 
-struct_meta_gen_field *struct_meta_gen_field_create(char *name, char *type_name, int is_struct_type, long array_count,
-                                                    int line, char *brief, char *json_name, int json_ignore,
-                                                    int json_required);
+/**
+ *  @brief          名前の連結リストです (ヘッダー内で宣言した列挙型の typedef 名など)。
+ */
+typedef struct struct_meta_gen_name_list
+{
+    char *name;
+    struct struct_meta_gen_name_list *next;
+} struct_meta_gen_name_list;
+
+struct_meta_gen_field *struct_meta_gen_field_create(char *name, char *type_name, int is_struct_type, int is_enum_type,
+                                                    long array_count, int line, char *brief, char *json_name,
+                                                    int json_ignore, int json_required, int layout_hot,
+                                                    int layout_cold);
 struct_meta_gen_field_list *struct_meta_gen_field_list_create(struct_meta_gen_field *first);
 struct_meta_gen_field_list *struct_meta_gen_field_list_append(struct_meta_gen_field_list *list,
                                                               struct_meta_gen_field *field);
 
 struct_meta_gen_struct *struct_meta_gen_struct_create(char *name, struct_meta_gen_field_list *fields, char *brief);
 void struct_meta_gen_struct_list_append(struct_meta_gen_struct_list **list, struct_meta_gen_struct *s);
+/**
+ *  @brief          構造体リストと、リストが所有する構造体・フィールド・文字列をすべて解放します。NULL は何もしません。
+ */
+void struct_meta_gen_struct_list_destroy(struct_meta_gen_struct_list *list);
 const struct_meta_gen_struct *struct_meta_gen_struct_list_find(const struct_meta_gen_struct_list *list,
                                                                const char *name);
 
+/**
+ *  @brief          名前をリストの先頭へ追加します。@p name の所有権を受け取ります。
+ *  @return         成功時は 0、メモリー不足の場合は 0 以外です (@p name は解放します)。
+ */
+int struct_meta_gen_name_list_add(struct_meta_gen_name_list **list, char *name);
+
+/**
+ *  @brief          リストが名前を含むかどうかを返します。
+ */
+int struct_meta_gen_name_list_contains(const struct_meta_gen_name_list *list, const char *name);
+
+/**
+ *  @brief          リストと、リストが所有する名前をすべて解放します。NULL は何もしません。
+ */
+void struct_meta_gen_name_list_destroy(struct_meta_gen_name_list *list);
+
+/**
+ *  @brief          `char` の型指定を文字列 (`char *`) の型指定へ置き換えます。
+ *  @return         成功時は 0、`char` 以外の型の場合とメモリー不足の場合は 0 以外です (@p spec は変更しません)。
+ */
+int struct_meta_gen_typespec_to_string(struct_meta_gen_typespec *spec);
+
 /**
  *  @brief          Doxygen コメントが `@file` タグを持つかどうかを返します。
  */
@@ -0,0 +1,695 @@
+/**
+ *******************************************************************************
+ *  @file           struct_meta_gen_codec.c
+ *  @brief          解析済みの構造体定義から、型ごとの JSON 書き出し・読み込み関数を生成します。
+ *  @author         Tetsuo Honda
+ *  @date           2026/10/17
+ *  @version        1.0.0
+ *
+ *  生成コードは libstruct_meta の公開 API (json/writer.h と json/reader.h) だけを呼び出します。
+ *  キー、書式、要素数と型の検査、`json.required` の確認は、記述子を解釈する実装と同じ規則で展開します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include "struct_meta_gen_codec.h"
+#include "struct_meta_gen_emit.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/**
+ *  @brief          生成コードでのフィールドの扱いです。
+ */
+typedef enum codec_kind
+{
+    CODEC_INT,        /**< int です。 */
+    CODEC_UNSIGNED,   /**< unsigned int です。 */
+    CODEC_FLOAT,      /**< float です。 */
+    CODEC_DOUBLE,     /**< double です。 */
+    CODEC_SIGNED,     /**< int8_t、int16_t、int64_t、列挙型です (int64_t を経由して読み書きします)。 */
+    CODEC_UNSIGNED64, /**< uint8_t、uint16_t、uint64_t です (uint64_t を経由して読み書きします)。 */
+    CODEC_BOOL,       /**< bool です。 */
+    CODEC_CHARS,      /**< char 配列です (配列全体で 1 個の文字列値)。 */
+    CODEC_STRUCT,     /**< 同じヘッダー内の構造体です。 */
+    CODEC_UNSUPPORTED /**< 記述子でも扱えない型 (char の単体)、または文字列と可変長配列です。 */
+} codec_kind;
+
+/**
+ *  @brief          int64_t を経由して読み込む型の下限と上限の式です。
+ */
+typedef struct signed_range
+{
+    const char *type_name; /**< 型のスペリングです。 */
+    const char *minimum;   /**< 下限の式です。 */
+    const char *maximum;   /**< 上限の式です。 */
+} signed_range;
+
+static const signed_range s_signed_ranges[] = {
+    {"int8_t", "INT8_MIN", "INT8_MAX"},
+    {"int16_t", "INT16_MIN", "INT16_MAX"},
+    {"int64_t", "INT64_MIN", "INT64_MAX"},
+};
+
+/**
+ *  @brief          uint64_t を経由して読み込む型の上限の式です。
+ */
+typedef struct unsigned_range
+{
+    const char *type_name; /**< 型のスペリングです。 */
+    const char *maximum;   /**< 上限の式です。 */
+} unsigned_range;
+
+static const unsigned_range s_unsigned_ranges[] = {
+    {"uint8_t", "UINT8_MAX"},
+    {"unsigned char", "UINT8_MAX"},
+    {"uint16_t", "UINT16_MAX"},
+    {"uint64_t", "UINT64_MAX"},
+};
+
+static const signed_range *find_signed_range(const char *type_name)
+{
+    for (size_t i = 0; i < sizeof(s_signed_ranges) / sizeof(s_signed_ranges[0]); i++)
+    {
+        if (strcmp(type_name, s_signed_ranges[i].type_name) == 0)
+        {
+            return &s_signed_ranges[i];
+        }
+    }
+    return NULL;
+}
+
+static const unsigned_range *find_unsigned_range(const char *type_name)
+{
+    for (size_t i = 0; i < sizeof(s_unsigned_ranges) / sizeof(s_unsigned_ranges[0]); i++)
+    {
+        if (strcmp(type_name, s_unsigned_ranges[i].type_name) == 0)
+        {
+            return &s_unsigned_ranges[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ *  @brief          値が構造体の外の領域にあるフィールド (文字列、可変長配列) かを返します。
+ *
+ *  生成コードはアロケーターを受け取らないため、このフィールドを @c COM_UTIL_ERR_UNSUPPORTED とします。
+ */
+static int is_dynamic(const struct_meta_gen_field *f)
+{
+    return (f->is_sequence) || (strcmp(f->type_name, "char *") == 0);
+}
+
+static codec_kind field_codec_kind(const struct_meta_gen_field *f)
+{
+    if (is_dynamic(f))
+    {
+        return CODEC_UNSUPPORTED;
+    }
+    if (f->is_struct_type)
+    {
+        return CODEC_STRUCT;
+    }
+    if ((f->is_enum_type) || (find_signed_range(f->type_name) != NULL))
+    {
+        return CODEC_SIGNED;
+    }
+    if (find_unsigned_range(f->type_name) != NULL)
+    {
+        return CODEC_UNSIGNED64;
+    }
+    if ((strcmp(f->type_name, "bool") == 0) || (strcmp(f->type_name, "_Bool") == 0))
+    {
+        return CODEC_BOOL;
+    }
+    if (strcmp(f->type_name, "char") == 0)
+    {
+        if (f->array_count > 0)
+        {
+            return CODEC_CHARS;
+        }
+        return CODEC_UNSUPPORTED;
+    }
+    if ((strcmp(f->type_name, "int") == 0) || (strcmp(f->type_name, "int32_t") == 0))
+    {
+        return CODEC_INT;
+    }
+    if ((strcmp(f->type_name, "unsigned") == 0) || (strcmp(f->type_name, "uint32_t") == 0))
+    {
+        return CODEC_UNSIGNED;
+    }
+    if (strcmp(f->type_name, "float") == 0)
+    {
+        return CODEC_FLOAT;
+    }
+    return CODEC_DOUBLE;
+}
+
+/**
+ *  @brief          JSON 配列として扱うフィールドかを返します。
+ *
+ *  記述子と同じく、char 配列と要素数 1 以下の配列は単一の値として扱います。
+ */
+static int is_json_array(const struct_meta_gen_field *f)
+{
+    return (field_codec_kind(f) != CODEC_CHARS) && (f->array_count > 1);
+}
+
+/**
+ *  @brief          フィールドの JSON キーを返します。`json.ignore` のフィールドは NULL です。
+ */
+static const char *json_key(const struct_meta_gen_field *f)
+{
+    if (f->json_ignore != 0)
+    {
+        return NULL;
+    }
+    if ((f->json_name != NULL) && (f->json_name[0] != '\0'))
+    {
+        return f->json_name;
+    }
+    return f->name;
+}
+
+/**
+ *  @brief          値 1 個分のメンバー式を書き出します (`instance->id`、`instance->scores[i]` など)。
+ */
+static void fprint_member(FILE *out, const struct_meta_gen_field *f)
+{
+    if (is_json_array(f))
+    {
+        fprintf(out, "instance->%s[i]", f->name);
+    }
+    else if ((field_codec_kind(f) != CODEC_CHARS) && (f->array_count == 1))
+    {
+        fprintf(out, "instance->%s[0]", f->name);
+    }
+    else
+    {
+        fprintf(out, "instance->%s", f->name);
+    }
+}
+
+static int count_codec_fields(const struct_meta_gen_struct *s)
+{
+    int count = 0;
+    for (const struct_meta_gen_field *f = s->fields; f != NULL; f = f->next)
+    {
+        count++;
+    }
+    return count;
+}
+
+static int count_json_fields(const struct_meta_gen_struct *s)
+{
+    int count = 0;
+    for (const struct_meta_gen_field *f = s->fields; f != NULL; f = f->next)
+    {
+        if (json_key(f) != NULL)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ *  @brief          値 1 個分を書き出す文を出力します。文の前後で ret は COM_UTIL_OK です。
+ */
+static void emit_write_value(FILE *out, const struct_meta_gen_field *f, const char *indent)
+{
+    fprintf(out, "%sret = ", indent);
+    switch (field_codec_kind(f))
+    {
+    case CODEC_INT:
+    case CODEC_UNSIGNED:
+    case CODEC_FLOAT:
+        fputs("struct_meta_json_writer_number(writer, (double)", out);
+        fprint_member(out, f);
+        fputs(");\n", out);
+        break;
+    case CODEC_DOUBLE:
+        fputs("struct_meta_json_writer_number(writer, ", out);
+        fprint_member(out, f);
+        fputs(");\n", out);
+        break;
+    case CODEC_SIGNED:
+        fputs("struct_meta_json_writer_int64(writer, (int64_t)", out);
+        fprint_member(out, f);
+        fputs(");\n", out);
+        break;
+    case CODEC_UNSIGNED64:
+        fputs("struct_meta_json_writer_uint64(writer, (uint64_t)", out);
+        fprint_member(out, f);
+        fputs(");\n", out);
+        break;
+    case CODEC_BOOL:
+        fputs("struct_meta_json_writer_bool(writer, ", out);
+        fprint_member(out, f);
+        fputs(" ? 1 : 0);\n", out);
+        break;
+    case CODEC_CHARS:
+        fprintf(out, "struct_meta_json_writer_chars(writer, instance->%s, sizeof(instance->%s));\n", f->name,
+                f->name);
+        break;
+    case CODEC_STRUCT:
+        fprintf(out, "%s_json_write(writer, &", f->type_name);
+        fprint_member(out, f);
+        fputs(");\n", out);
+        break;
+    case CODEC_UNSUPPORTED:
+    default:
+        fputs("COM_UTIL_ERR_UNSUPPORTED;\n", out);
+        break;
+    }
+}
+
+static void emit_write_function(FILE *out, const struct_meta_gen_struct *s)
+{
+    fprintf(out, "int %s_json_write(struct_meta_json_writer *writer, const %s *instance)\n", s->name, s->name);
+    fputs("{\n", out);
+    fputs("    if ((writer == NULL) || (instance == NULL))\n", out);
+    fputs("    {\n", out);
+    fputs("        return COM_UTIL_ERR_INVALID_ARGUMENT;\n", out);
+    fputs("    }\n\n", out);
+    fputs("    int ret = struct_meta_json_writer_begin_object(writer);\n", out);
+    for (const struct_meta_gen_field *f = s->fields; f != NULL; f = f->next)
+    {
+        const char *key = json_key(f);
+        if (key == NULL)
+        {
+            continue;
+        }
+        fputs("    if (ret == COM_UTIL_OK)\n", out);
+        fputs("    {\n", out);
+        fputs("        ret = struct_meta_json_writer_key(writer, ", out);
+        struct_meta_gen_fprint_c_string(out, key);
+        fputs(");\n", out);
+        fputs("    }\n", out);
+        if (is_json_array(f))
+        {
+            fputs("    if (ret == COM_UTIL_OK)\n", out);
+            fputs("    {\n", out);
+            fputs("        ret = struct_meta_json_writer_begin_array(writer);\n", out);
+            fputs("    }\n", out);
+            fprintf(out, "    for (size_t i = 0; (i < %ldU) && (ret == COM_UTIL_OK); i++)\n", f->array_count);
+            fputs("    {\n", out);
+            emit_write_value(out, f, "        ");
+            fputs("    }\n", out);
+            fputs("    if (ret == COM_UTIL_OK)\n", out);
+            fputs("    {\n", out);
+            fputs("        ret = struct_meta_json_writer_end_array(writer);\n", out);
+            fputs("    }\n", out);
+        }
+        else
+        {
+            fputs("    if (ret == COM_UTIL_OK)\n", out);
+            fputs("    {\n", out);
+            emit_write_value(out, f, "        ");
+            fputs("    }\n", out);
+        }
+    }
+    fputs("    if (ret == COM_UTIL_OK)\n", out);
+    fputs("    {\n", out);
+    fputs("        ret = struct_meta_json_writer_end_object(writer);\n", out);
+    fputs("    }\n", out);
+    fputs("    return ret;\n", out);
+    fputs("}\n\n", out);
+}
+
+/**
+ *  @brief          JSON キーからフィールドの添字を求める関数を出力します。
+ *
+ *  キーの長さで分岐し、同じ長さのキーだけを比較します。同じキーのフィールドが複数ある場合は、
+ *  記述子の名前索引と同じく先頭のフィールドを返します。
+ */
+static void emit_key_function(FILE *out, const struct_meta_gen_struct *s)
+{
+    fprintf(out, "static int %s_json_field(const char *key, size_t length)\n", s->name);
+    fputs("{\n", out);
+    fputs("    switch (length)\n", out);
+    fputs("    {\n", out);
+    int index = 0;
+    for (const struct_meta_gen_field *f = s->fields; f != NULL; f = f->next, index++)
+    {
+        const char *key = json_key(f);
+        size_t length = 0U;
+        int first_of_length = 1;
+        if (key == NULL)
+        {
+            continue;
+        }
+        length = strlen(key);
+        for (const struct_meta_gen_field *g = s->fields; g != f; g = g->next)
+        {
+            const char *other = json_key(g);
+            if ((other != NULL) && (strlen(other) == length))
+            {
+                first_of_length = 0;
+                break;
+            }
+        }
+        if (first_of_length == 0)
+        {
+            continue;
+        }
+
+        fprintf(out, "    case %zuU:\n", length);
+        int candidate = index;
+        for (const struct_meta_gen_field *g = f; g != NULL; g = g->next, candidate++)
+        {
+            const char *other = json_key(g);
+            if ((other == NULL) || (strlen(other) != length))
+            {
+                continue;
+            }
+            fputs("        if (memcmp(key, ", out);
+            struct_meta_gen_fprint_c_string(out, other);
+            fprintf(out, ", %zuU) == 0)\n", length);
+            fputs("        {\n", out);
+            fprintf(out, "            return %d;\n", candidate);
+            fputs("        }\n", out);
+        }
+        fputs("        break;\n", out);
+    }
+    fputs("    default:\n", out);
+    fputs("        break;\n", out);
+    fputs("    }\n", out);
+    fputs("    return -1;\n", out);
+    fputs("}\n\n", out);
+}
+
+/**
+ *  @brief          直前のトークンから整数 1 個を、double を経由せずに型の範囲を確認して読み込む文を出力します。
+ *
+ *  列挙型の値は int32_t の範囲とします (C の列挙定数は int で表せる値に限られるため)。
+ */
+static void emit_read_integer(FILE *out, const struct_meta_gen_field *f, const char *indent)
+{
+    const signed_range *signed_bounds = find_signed_range(f->type_name);
+    const unsigned_range *unsigned_bounds = find_unsigned_range(f->type_name);
+
+    fprintf(out, "%s{\n", indent);
+    if (unsigned_bounds != NULL)
+    {
+        fprintf(out, "%s    uint64_t value;\n", indent);
+        fprintf(out, "%s    if (struct_meta_json_reader_uint64(reader, token, %s, &value) != COM_UTIL_OK)\n", indent,
+                unsigned_bounds->maximum);
+    }
+    else
+    {
+        fprintf(out, "%s    int64_t value;\n", indent);
+        fprintf(out, "%s    if (struct_meta_json_reader_int64(reader, token, %s, %s, &value) != COM_UTIL_OK)\n", indent,
+                (signed_bounds != NULL) ? signed_bounds->minimum : "INT32_MIN",
+                (signed_bounds != NULL) ? signed_bounds->maximum : "INT32_MAX");
+    }
+    fprintf(out, "%s    {\n", indent);
+    fprintf(out, "%s        return COM_UTIL_ERR_INVALID_ARGUMENT;\n", indent);
+    fprintf(out, "%s    }\n", indent);
+    fprintf(out, "%s    ", indent);
+    fprint_member(out, f);
+    fprintf(out, " = (%s)value;\n", f->type_name);
+    fprintf(out, "%s}\n", indent);
+}
+
+/**
+ *  @brief          直前のトークンから値 1 個分を読み込む文を出力します。エラーの場合は return します。
+ */
+static void emit_read_value(FILE *out, const struct_meta_gen_field *f, const char *indent)
+{
+    switch (field_codec_kind(f))
+    {
+    case CODEC_INT:
+    case CODEC_FLOAT:
+    case CODEC_DOUBLE:
+        fprintf(out, "%sif (token != STRUCT_META_JSON_TOKEN_NUMBER)\n", indent);
+        break;
+    case CODEC_UNSIGNED:
+        fprintf(out, "%sif ((token != STRUCT_META_JSON_TOKEN_NUMBER) || (reader->number < 0.0))\n", indent);
+        break;
+    case CODEC_SIGNED:
+    case CODEC_UNSIGNED64:
+        emit_read_integer(out, f, indent);
+        return;
+    case CODEC_BOOL:
+        fprintf(out, "%sif ((token != STRUCT_META_JSON_TOKEN_TRUE) && (token != STRUCT_META_JSON_TOKEN_FALSE))\n",
+                indent);
+        break;
+    case CODEC_CHARS:
+        fprintf(out, "%sret = struct_meta_json_reader_chars(reader, token, instance->%s, sizeof(instance->%s));\n",
+                indent, f->name, f->name);
+        fprintf(out, "%sif (ret != COM_UTIL_OK)\n", indent);
+        fprintf(out, "%s{\n", indent);
+        fprintf(out, "%s    return ret;\n", indent);
+        fprintf(out, "%s}\n", indent);
+        return;
+    case CODEC_STRUCT:
+        fprintf(out, "%sif (token != STRUCT_META_JSON_TOKEN_BEGIN_OBJECT)\n", indent);
+        fprintf(out, "%s{\n", indent);
+        fprintf(out, "%s    return COM_UTIL_ERR_INVALID_ARGUMENT;\n", indent);
+        fprintf(out, "%s}\n", indent);
+        fprintf(out, "%sret = %s_json_read_members(reader, &", indent, f->type_name);
+        fprint_member(out, f);
+        fputs(");\n", out);
+        fprintf(out, "%sif (ret != COM_UTIL_OK)\n", indent);
+        fprintf(out, "%s{\n", indent);
+        fprintf(out, "%s    return ret;\n", indent);
+        fprintf(out, "%s}\n", indent);
+        return;
+    case CODEC_UNSUPPORTED:
+    default:
+        fprintf(out, "%sreturn %s;\n", indent,
+                is_dynamic(f) ? "COM_UTIL_ERR_UNSUPPORTED" : "COM_UTIL_ERR_INVALID_ARGUMENT");
+        return;
+    }
+
+    fprintf(out, "%s{\n", indent);
+    fprintf(out, "%s    return COM_UTIL_ERR_INVALID_ARGUMENT;\n", indent);
+    fprintf(out, "%s}\n", indent);
+    fprintf(out, "%s", indent);
+    fprint_member(out, f);
+    switch (field_codec_kind(f))
+    {
+    case CODEC_INT:
+        fputs(" = (int)reader->number;\n", out);
+        break;
+    case CODEC_UNSIGNED:
+        fputs(" = (unsigned int)reader->number;\n", out);
+        break;
+    case CODEC_FLOAT:
+        fputs(" = (float)reader->number;\n", out);
+        break;
+    case CODEC_BOOL:
+        fputs(" = (token == STRUCT_META_JSON_TOKEN_TRUE);\n", out);
+        break;
+    case CODEC_DOUBLE:
+    case CODEC_SIGNED:
+    case CODEC_UNSIGNED64:
+    case CODEC_CHARS:
+    case CODEC_STRUCT:
+    case CODEC_UNSUPPORTED:
+    default:
+        fputs(" = reader->number;\n", out);
+        break;
+    }
+}
+
+/**
+ *  @brief          ret 変数を使う読み込み文を出力するフィールドがあるかを返します。
+ */
+static int read_needs_ret(const struct_meta_gen_struct *s)
+{
+    for (const struct_meta_gen_field *f = s->fields; f != NULL; f = f->next)
+    {
+        codec_kind kind = field_codec_kind(f);
+        if ((json_key(f) != NULL) && (is_json_array(f) || (kind == CODEC_CHARS) || (kind == CODEC_STRUCT)))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void emit_read_field_function(FILE *out, const struct_meta_gen_struct *s)
+{
+    /* 2 行目の引数は、1 行目の開き括弧の次の桁へ揃える。 */
+    int column = (int)(strlen("static int _json_read_field(") + strlen(s->name));
+    fprintf(out,
+            "static int %s_json_read_field(struct_meta_json_reader *reader, struct_meta_json_token token, int field,\n",
+            s->name);
+    fprintf(out, "%*s%s *instance)\n", column, "", s->name);
+    fputs("{\n", out);
+    if (read_needs_ret(s))
+    {
+        fputs("    int ret;\n\n", out);
+    }
+    if (count_json_fields(s) == 0)
+    {
+        fputs("    (void)reader;\n", out);
+        fputs("    (void)token;\n", out);
+        fputs("    (void)instance;\n", out);
+    }
+    fputs("    switch (field)\n", out);
+    fputs("    {\n", out);
+    int index = 0;
+    for (const struct_meta_gen_field *f = s->fields; f != NULL; f = f->next, index++)
+    {
+        if (json_key(f) == NULL)
+        {
+            continue;
+        }
+        fprintf(out, "    case %d:\n", index);
+        if (is_json_array(f))
+        {
+            /* 要素数は記述子による読み込みと同じく、固定長配列の長さと一致しなければならない。 */
+            fputs("        if (token != STRUCT_META_JSON_TOKEN_BEGIN_ARRAY)\n", out);
+            fputs("        {\n", out);
+            fputs("            return COM_UTIL_ERR_INVALID_ARGUMENT;\n", out);
+            fputs("        }\n", out);
+            fprintf(out, "        for (size_t i = 0; i < %ldU; i++)\n", f->array_count);
+            fputs("        {\n", out);
+            fputs("            ret = struct_meta_json_reader_next(reader, &token);\n", out);
+            fputs("            if (ret != COM_UTIL_OK)\n", out);
+            fputs("            {\n", out);
+            fputs("                return ret;\n", out);
+            fputs("            }\n", out);
+            fputs("            if (token == STRUCT_META_JSON_TOKEN_END_ARRAY)\n", out);
+            fputs("            {\n", out);
+            fputs("                return COM_UTIL_ERR_INVALID_ARGUMENT;\n", out);
+            fputs("            }\n", out);
+            emit_read_value(out, f, "            ");
+            fputs("        }\n", out);
+            fputs("        ret = struct_meta_json_reader_next(reader, &token);\n", out);
+            fputs("        if (ret != COM_UTIL_OK)\n", out);
+            fputs("        {\n", out);
+            fputs("            return ret;\n", out);
+            fputs("        }\n", out);
+            fputs("        if (token != STRUCT_META_JSON_TOKEN_END_ARRAY)\n", out);
+            fputs("        {\n", out);
+            fputs("            return COM_UTIL_ERR_INVALID_ARGUMENT;\n", out);
+            fputs("        }\n", out);
+        }
+        else
+        {
+            emit_read_value(out, f, "        ");
+        }
+        if (field_codec_kind(f) != CODEC_UNSUPPORTED)
+        {
+            fputs("        return COM_UTIL_OK;\n", out);
+        }
+    }
+    fputs("    default:\n", out);
+    fputs("        return COM_UTIL_ERR_INVALID_ARGUMENT;\n", out);
+    fputs("    }\n", out);
+    fputs("}\n\n", out);
+}
+
+static void emit_read_members_function(FILE *out, const struct_meta_gen_struct *s)
+{
+    int field_count = count_codec_fields(s);
+
+    fprintf(out, "int %s_json_read_members(struct_meta_json_reader *reader, %s *instance)\n", s->name, s->name);
+    fputs("{\n", out);
+    fprintf(out, "    unsigned char seen[%d] = {0};\n", (field_count + 7) / 8);
+    fputs("    struct_meta_json_token token;\n", out);
+    fputs("    int ret;\n", out);
+    fputs("    for (;;)\n", out);
+    fputs("    {\n", out);
+    fputs("        ret = struct_meta_json_reader_next(reader, &token);\n", out);
+    fputs("        if ((ret != COM_UTIL_OK) || (token == STRUCT_META_JSON_TOKEN_END_OBJECT))\n", out);
+    fputs("        {\n", out);
+    fputs("            break;\n", out);
+    fputs("        }\n", out);
+    fprintf(out, "        int field = %s_json_field(reader->string, reader->string_length);\n", s->name);
+    fputs("        ret = struct_meta_json_reader_next(reader, &token);\n", out);
+    fputs("        if (ret != COM_UTIL_OK)\n", out);
+    fputs("        {\n", out);
+    fputs("            break;\n", out);
+    fputs("        }\n", out);
+    fputs("        /* 記述子による読み込みと同じく、同じキーが複数ある場合は先頭の値を使う。 */\n", out);
+    fputs("        if ((field < 0) || ((seen[field / 8] & (1U << (field % 8))) != 0U))\n", out);
+    fputs("        {\n", out);
+    fputs("            ret = struct_meta_json_reader_skip(reader, token);\n", out);
+    fputs("        }\n", out);
+    fputs("        else\n", out);
+    fputs("        {\n", out);
+    fputs("            seen[field / 8] |= (unsigned char)(1U << (field % 8));\n", out);
+    fprintf(out, "            ret = %s_json_read_field(reader, token, field, instance);\n", s->name);
+    fputs("        }\n", out);
+    fputs("        if (ret != COM_UTIL_OK)\n", out);
+    fputs("        {\n", out);
+    fputs("            break;\n", out);
+    fputs("        }\n", out);
+    fputs("    }\n", out);
+
+    int index = 0;
+    for (const struct_meta_gen_field *f = s->fields; f != NULL; f = f->next, index++)
+    {
+        if ((json_key(f) == NULL) || (f->json_required == 0))
+        {
+            continue;
+        }
+        fprintf(out, "    if ((ret == COM_UTIL_OK) && ((seen[%d] & 0x%02XU) == 0U))\n", index / 8,
+                1U << (unsigned int)(index % 8));
+        fputs("    {\n", out);
+        fputs("        ret = COM_UTIL_ERR_MISSING_REQUIRED;\n", out);
+        fputs("    }\n", out);
+    }
+    fputs("    return ret;\n", out);
+    fputs("}\n\n", out);
+}
+
+static void emit_read_function(FILE *out, const struct_meta_gen_struct *s)
+{
+    fprintf(out, "int %s_json_read(struct_meta_json_reader *reader, %s *instance)\n", s->name, s->name);
+    fputs("{\n", out);
+    fputs("    if ((reader == NULL) || (instance == NULL))\n", out);
+    fputs("    {\n", out);
+    fputs("        return COM_UTIL_ERR_INVALID_ARGUMENT;\n", out);
+    fputs("    }\n\n", out);
+    fputs("    struct_meta_json_token token;\n", out);
+    fputs("    int ret = struct_meta_json_reader_next(reader, &token);\n", out);
+    fputs("    if (ret != COM_UTIL_OK)\n", out);
+    fputs("    {\n", out);
+    fputs("        return ret;\n", out);
+    fputs("    }\n", out);
+    fputs("    if (token != STRUCT_META_JSON_TOKEN_BEGIN_OBJECT)\n", out);
+    fputs("    {\n", out);
+    fputs("        return COM_UTIL_ERR_INVALID_ARGUMENT;\n", out);
+    fputs("    }\n", out);
+    fprintf(out, "    return %s_json_read_members(reader, instance);\n", s->name);
+    fputs("}\n\n", out);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_gen_codec_emit_declarations(FILE *out, const struct_meta_gen_struct_list *structs)
+{
+    for (const struct_meta_gen_struct *s = structs->head; s != NULL; s = s->next)
+    {
+        fprintf(out, "int %s_json_write(struct_meta_json_writer *writer, const %s *instance);\n", s->name, s->name);
+        fprintf(out, "int %s_json_read(struct_meta_json_reader *reader, %s *instance);\n", s->name, s->name);
+        /* 開き括弧を読んだ後のメンバーを読み込む。他のヘッダーの型がネスト メンバーとして呼び出す。 */
+        fprintf(out, "int %s_json_read_members(struct_meta_json_reader *reader, %s *instance);\n", s->name,
+                s->name);
+    }
+    fputs("\n", out);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_gen_codec_emit_source(FILE *out, const struct_meta_gen_struct_list *structs)
+{
+    /* ネスト メンバーの読み込み関数 (*_json_read_members()) は生成ヘッダーで宣言済みのため、順序を問わない。 */
+    for (const struct_meta_gen_struct *s = structs->head; s != NULL; s = s->next)
+    {
+        emit_write_function(out, s);
+        emit_key_function(out, s);
+        emit_read_field_function(out, s);
+        emit_read_members_function(out, s);
+        emit_read_function(out, s);
+    }
+}
@@ -0,0 +1,50 @@
+/**
+ *******************************************************************************
+ *  @file           struct_meta_gen_codec.h
+ *  @brief          解析済みの構造体定義から、型ごとの JSON 書き出し・読み込み関数を生成します。
+ *  @author         Tetsuo Honda
+ *  @date           2026/10/17
+ *  @version        1.0.0
+ *
+ *  `--emit-codecs` を指定した場合に、構造体 `T` ごとに次の関数を生成します。
+    @code{.c}
+    int T_json_write(struct_meta_json_writer *writer, const T *instance);
+    int T_json_read(struct_meta_json_reader *reader, T *instance);
+    @endcode
+ *
+ *  記述子を実行時に解釈する struct_meta_json_writer_value() / struct_meta_json_reader_value() と
+ *  同じテキストと結果コードになるよう、フィールドごとの処理を定数のメンバー アクセスで展開します。
+ *  キーの照合は、キーの長さで分岐してから比較する関数として生成します。
+ *  開き括弧の後のメンバーを読み込む `T_json_read_members()` も生成ヘッダーで宣言し、
+ *  他のヘッダーの構造体がネスト メンバーとして `T` を読み込む際に呼び出します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_GEN_CODEC_H
+#define STRUCT_META_GEN_CODEC_H
+
+#include "struct_meta_gen_ast.h"
+
+#include <stdio.h>
+
+/**
+ *  @brief          生成ヘッダーへ、型ごとの JSON 書き出し・読み込み関数の宣言を書き出します。
+ *
+ *  @param[in,out]  out     生成ヘッダーです。
+ *  @param[in]      structs 解析済みの構造体一覧です。
+ */
+void struct_meta_gen_codec_emit_declarations(FILE *out, const struct_meta_gen_struct_list *structs);
+
+/**
+ *  @brief          生成 C ソースへ、型ごとの JSON 書き出し・読み込み関数の定義を書き出します。
+ *
+ *  @param[in,out]  out     生成 C ソースです。
+ *  @param[in]      structs 解析済みの構造体一覧です。一覧に無いネスト メンバーの型は、
+ *                          定義元の生成ヘッダーが宣言する関数を呼び出します。
+ */
+void struct_meta_gen_codec_emit_source(FILE *out, const struct_meta_gen_struct_list *structs);
+
+#endif /* STRUCT_META_GEN_CODEC_H */
@@ -11,7 +11,9 @@
  *  計算しません (`docs/architecture.md` の設計方針を参照)。
  *
  *  ネスト構造体メンバーがある場合、参照先の構造体記述子を先に出力してから
- *  (依存順)、それを参照する構造体の記述子を出力します。
+ *  (依存順)、それを参照する構造体の記述子を出力します。\n
+ *  参照先が他のヘッダーの型の場合は記述子を出力せず、型データベースが示す
+ *  定義元の生成ヘッダーを `#include` して、定義元の記述子を参照します。
  *
  *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
  *
@@ -19,16 +21,16 @@
  */
 
 #include "struct_meta_gen_emit.h"
-
-#include <com_util/crt/stdio.h>
+#include "struct_meta_gen_codec.h"
+#include "struct_meta_gen_index.h"
+#include "struct_meta_gen_output.h"
+#include "struct_meta_gen_typedb.h"
 
 #include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-extern struct_meta_gen_struct_list *g_struct_meta_gen_structs;
-
 /** 生成パス・識別子を組み立てる作業バッファーのバイト数です。 */
 #define STRUCT_META_GEN_EMIT_PATH_BYTES 512
 
@@ -53,6 +55,43 @@ static int is_emitted(const emitted_name *list, const char *name)
     return 0;
 }
 
+/**
+ *  @brief          固定幅整数と bool の型スペリングと、対応するフィールド種別です。
+ */
+typedef struct fixed_type
+{
+    const char *type_name;   /**< 型のスペリングです。 */
+    const char *kind;        /**< @ref struct_meta_field_kind の列挙定数名です。 */
+    const char *sizeof_expr; /**< 要素 1 個分の `sizeof` 式です。 */
+} fixed_type;
+
+/* int32_t と uint32_t は、幅が同じ int と unsigned int の種別で扱う。 */
+static const fixed_type s_fixed_types[] = {
+    {"int8_t", "STRUCT_META_FIELD_INT8", "sizeof(int8_t)"},
+    {"int16_t", "STRUCT_META_FIELD_INT16", "sizeof(int16_t)"},
+    {"int32_t", "STRUCT_META_FIELD_INT", "sizeof(int32_t)"},
+    {"int64_t", "STRUCT_META_FIELD_INT64", "sizeof(int64_t)"},
+    {"uint8_t", "STRUCT_META_FIELD_UINT8", "sizeof(uint8_t)"},
+    {"unsigned char", "STRUCT_META_FIELD_UINT8", "sizeof(unsigned char)"},
+    {"uint16_t", "STRUCT_META_FIELD_UINT16", "sizeof(uint16_t)"},
+    {"uint32_t", "STRUCT_META_FIELD_UNSIGNED", "sizeof(uint32_t)"},
+    {"uint64_t", "STRUCT_META_FIELD_UINT64", "sizeof(uint64_t)"},
+    {"bool", "STRUCT_META_FIELD_BOOL", "sizeof(bool)"},
+    {"_Bool", "STRUCT_META_FIELD_BOOL", "sizeof(_Bool)"},
+};
+
+static const fixed_type *find_fixed_type(const char *type_name)
+{
+    for (size_t i = 0; i < sizeof(s_fixed_types) / sizeof(s_fixed_types[0]); i++)
+    {
+        if (strcmp(type_name, s_fixed_types[i].type_name) == 0)
+        {
+            return &s_fixed_types[i];
+        }
+    }
+    return NULL;
+}
+
 /**
  *  @brief          フィールドの型スペリングから @ref struct_meta_field_kind の列挙定数名を求めます。
  */
@@ -74,6 +113,15 @@ static const char *field_kind_name(const char *type_name, int is_char_array)
     {
         return "STRUCT_META_FIELD_FLOAT";
     }
+    if (strcmp(type_name, "char *") == 0)
+    {
+        return "STRUCT_META_FIELD_STRING";
+    }
+    const fixed_type *fixed = find_fixed_type(type_name);
+    if (fixed != NULL)
+    {
+        return fixed->kind;
+    }
     return "STRUCT_META_FIELD_DOUBLE";
 }
 
@@ -98,6 +146,15 @@ static const char *elem_sizeof_expr(const char *type_name)
     {
         return "sizeof(double)";
     }
+    if (strcmp(type_name, "char *") == 0)
+    {
+        return "sizeof(char *)";
+    }
+    const fixed_type *fixed = find_fixed_type(type_name);
+    if (fixed != NULL)
+    {
+        return fixed->sizeof_expr;
+    }
     return "sizeof(char)";
 }
 
@@ -224,7 +281,7 @@ static const char *generated_header_include(const char *header_out)
     return path_basename(header_out);
 }
 
-static void fprint_c_string(FILE *out, const char *text)
+void struct_meta_gen_fprint_c_string(FILE *out, const char *text)
 {
     if (text == NULL)
     {
@@ -277,6 +334,10 @@ static int count_attributes(const struct_meta_gen_field *field)
     {
         count++;
     }
+    if ((field->layout_hot != 0) || (field->layout_cold != 0))
+    {
+        count++;
+    }
     return count;
 }
 
@@ -291,7 +352,7 @@ static void emit_attributes(FILE *out, const struct_meta_gen_struct *structure,
     if (field->json_name != NULL)
     {
         fputs("    { \"json.name\", ", out);
-        fprint_c_string(out, field->json_name);
+        struct_meta_gen_fprint_c_string(out, field->json_name);
         fputs(" },\n", out);
     }
     if (field->json_ignore != 0)
@@ -302,6 +363,14 @@ static void emit_attributes(FILE *out, const struct_meta_gen_struct *structure,
     {
         fputs("    { \"json.required\", NULL },\n", out);
     }
+    if (field->layout_hot != 0)
+    {
+        fputs("    { \"layout.hot\", NULL },\n", out);
+    }
+    else if (field->layout_cold != 0)
+    {
+        fputs("    { \"layout.cold\", NULL },\n", out);
+    }
     fputs("};\n\n", out);
 }
 
@@ -310,27 +379,34 @@ static void emit_attributes(FILE *out, const struct_meta_gen_struct *structure,
  *
  *  ネスト構造体メンバーがあれば、参照先の記述子を先に出力してから
  *  (依存順)、`s` 自身の記述子を出力します。同じ構造体は 2 回出力しません。
- *  記述子はすべて `static` です。外部からは型一覧の取得関数だけが見えます。
+ *  他のヘッダーの型 (@p structs に無い型) は、定義元の記述子を参照するだけで出力しません。\n
+ *  記述子は、他のヘッダーの生成コードから参照できるよう外部結合とします。
+ *  フィールドと属性の配列は `static` です。
+ *
+ *  @return         成功時は 0、失敗時は 0 以外です。
  */
-static void emit_struct(FILE *out, const struct_meta_gen_struct *s, emitted_name **emitted)
+static int emit_struct(FILE *out, const struct_meta_gen_struct_list *structs, const struct_meta_gen_struct *s,
+                       emitted_name **emitted)
 {
     if (is_emitted(*emitted, s->name))
     {
-        return;
+        return 0;
     }
 
     for (const struct_meta_gen_field *f = s->fields; f != NULL; f = f->next)
     {
         if (f->is_struct_type)
         {
-            const struct_meta_gen_struct *nested =
-                struct_meta_gen_struct_list_find(g_struct_meta_gen_structs, f->type_name);
+            const struct_meta_gen_struct *nested = struct_meta_gen_struct_list_find(structs, f->type_name);
             if (nested == NULL)
             {
-                fprintf(stderr, "struct-meta-gen: %d: 未知の型です: %s\n", f->line, f->type_name);
-                exit(1);
+                /* 他のヘッダーの型。解決できることは collect_foreign_headers() で確認済み。 */
+                continue;
+            }
+            if (emit_struct(out, structs, nested, emitted) != 0)
+            {
+                return 1;
             }
-            emit_struct(out, nested, emitted);
         }
     }
 
@@ -364,6 +440,12 @@ static void emit_struct(FILE *out, const struct_meta_gen_struct *s, emitted_name
             snprintf(elem_size_expr, sizeof(elem_size_expr), "sizeof(%s)", f->type_name);
             snprintf(nested_expr, sizeof(nested_expr), "&g_%s_desc", f->type_name);
         }
+        else if (f->is_enum_type)
+        {
+            /* 列挙型の幅はコンパイラーが決めるため、sizeof で求める。 */
+            kind = "STRUCT_META_FIELD_ENUM";
+            snprintf(elem_size_expr, sizeof(elem_size_expr), "sizeof(%s)", f->type_name);
+        }
         else
         {
             kind = field_kind_name(f->type_name, is_char_array);
@@ -371,9 +453,11 @@ static void emit_struct(FILE *out, const struct_meta_gen_struct *s, emitted_name
         }
 
         int attribute_count = count_attributes(f);
-        fprintf(out, "    { \"%s\", %s, 0, offsetof(%s, %s), %s, %ld, %s, %s, ", f->name, kind, s->name, f->name,
-                elem_size_expr, array_count_out, char_buf_expr, nested_expr);
-        fprint_c_string(out, f->brief);
+        /* 可変長配列の offsetof は items と count の組を指し、種別と要素サイズは要素 1 個分を表す。 */
+        const char *storage = (f->is_sequence) ? "STRUCT_META_STORAGE_SEQUENCE" : "STRUCT_META_STORAGE_INLINE";
+        fprintf(out, "    { \"%s\", %s, %s, offsetof(%s, %s), %s, %ld, %s, %s, ", f->name, kind, storage, s->name,
+                f->name, elem_size_expr, array_count_out, char_buf_expr, nested_expr);
+        struct_meta_gen_fprint_c_string(out, f->brief);
         if (attribute_count == 0)
         {
             fputs(", NULL, 0 },\n", out);
@@ -385,29 +469,89 @@ static void emit_struct(FILE *out, const struct_meta_gen_struct *s, emitted_name
     }
     fprintf(out, "};\n\n");
 
-    fprintf(out, "static const struct_meta_descriptor g_%s_desc = { \"%s\", sizeof(%s), g_%s_fields, %d, ", s->name,
-            s->name, s->name, s->name, count_fields(s));
-    fprint_c_string(out, s->brief);
+    fprintf(out, "const struct_meta_descriptor g_%s_desc = { \"%s\", sizeof(%s), g_%s_fields, %d, ", s->name, s->name,
+            s->name, s->name, count_fields(s));
+    struct_meta_gen_fprint_c_string(out, s->brief);
     fprintf(out, " };\n\n");
 
     emitted_name *node = (emitted_name *)calloc(1, sizeof(*node));
+    if (node == NULL)
+    {
+        fprintf(stderr, "struct-meta-gen: メモリーを確保できません\n");
+        return 1;
+    }
     node->name = s->name;
     node->next = *emitted;
     *emitted = node;
+    return 0;
+}
+
+static void emitted_destroy(emitted_name *list)
+{
+    while (list != NULL)
+    {
+        emitted_name *next = list->next;
+        free(list);
+        list = next;
+    }
+}
+
+/**
+ *  @brief          他のヘッダーの型を参照するネスト メンバーについて、定義元の生成ヘッダー名を重複なく集めます。
+ *
+ *  @param[in]      own_header 自身の生成ヘッダー名です。型データベースの古い登録で自身を指す型は未知の型とします。
+ *  @param[out]     headers_out 生成ヘッダー名の一覧です。emitted_destroy() で解放します。
+ *  @return         成功時は 0、どのヘッダーにも無い型がある場合やメモリー不足の場合は 0 以外です。
+ */
+static int collect_foreign_headers(const struct_meta_gen_struct_list *structs, const struct_meta_gen_typedb *types,
+                                   const char *own_header, emitted_name **headers_out)
+{
+    for (const struct_meta_gen_struct *s = structs->head; s != NULL; s = s->next)
+    {
+        for (const struct_meta_gen_field *f = s->fields; f != NULL; f = f->next)
+        {
+            if ((!f->is_struct_type) || (struct_meta_gen_struct_list_find(structs, f->type_name) != NULL))
+            {
+                continue;
+            }
+            const struct_meta_gen_typedb_entry *entry = struct_meta_gen_typedb_find(types, f->type_name);
+            if ((entry == NULL) || (strcmp(entry->meta_header, own_header) == 0))
+            {
+                fprintf(stderr, "struct-meta-gen: %d: 未知の型です: %s\n", f->line, f->type_name);
+                return 1;
+            }
+            if (is_emitted(*headers_out, entry->meta_header))
+            {
+                continue;
+            }
+            emitted_name *node = (emitted_name *)calloc(1, sizeof(*node));
+            if (node == NULL)
+            {
+                fprintf(stderr, "struct-meta-gen: メモリーを確保できません\n");
+                return 1;
+            }
+            node->name = entry->meta_header;
+            node->next = *headers_out;
+            *headers_out = node;
+        }
+    }
+    return 0;
 }
 
 /**
  *  @brief          型一覧 enum と取得関数の宣言をヘッダーへ書き出します。
+ *
+ *  @param[out]     updated_out ヘッダーを書き換えた場合は 1、内容が同じだった場合は 0 です。
  */
-static int emit_catalog_header(const char *header_out, const char *stem, const char *prefix,
-                               const struct_meta_gen_struct_list *structs)
+static int emit_catalog_header(const char *header_out, const char *header_path, const char *stem, const char *prefix,
+                               const struct_meta_gen_struct_list *structs, int emit_codecs, int *updated_out)
 {
-    FILE *out = com_util_fopen(header_out, "w", NULL);
-    if (out == NULL)
+    struct_meta_gen_output output;
+    if (struct_meta_gen_output_open(&output, header_out) != 0)
     {
-        fprintf(stderr, "struct-meta-gen: 出力ファイルを作成できません: %s\n", header_out);
         return 1;
     }
+    FILE *out = output.file;
 
     int index = 0;
     int count = count_structs(structs);
@@ -415,7 +559,15 @@ static int emit_catalog_header(const char *header_out, const char *stem, const c
     fprintf(out, "/* このファイルは struct-meta-gen が自動生成しました。手編集しないでください。 */\n");
     fprintf(out, "#ifndef %s_META_H\n", prefix);
     fprintf(out, "#define %s_META_H\n\n", prefix);
-    fprintf(out, "#include <struct_meta/meta/meta.h>\n\n");
+    fprintf(out, "#include <struct_meta/meta/catalog.h>\n");
+    fprintf(out, "#include <struct_meta/meta/meta.h>\n");
+    if (emit_codecs)
+    {
+        fprintf(out, "#include <struct_meta/json/reader.h>\n");
+        fprintf(out, "#include <struct_meta/json/writer.h>\n\n");
+        fprintf(out, "#include \"../%s\"\n", header_path);
+    }
+    fprintf(out, "\n");
     fprintf(out, "#ifdef __cplusplus\n");
     fprintf(out, "extern \"C\"\n");
     fprintf(out, "{\n");
@@ -436,24 +588,38 @@ static int emit_catalog_header(const char *header_out, const char *stem, const c
     fprintf(out, "} %s_meta_id;\n\n", stem);
     fprintf(out, "size_t %s_meta_count(void);\n", stem);
     fprintf(out, "const struct_meta_descriptor *%s_meta_get(%s_meta_id id);\n", stem, stem);
-    fprintf(out, "const struct_meta_descriptor *%s_meta_find(const char *name);\n\n", stem);
+    fprintf(out, "const struct_meta_descriptor *%s_meta_find(const char *name);\n", stem);
+    fprintf(out, "int %s_meta_validate_all(size_t thread_count, struct_meta_catalog_report *report_out);\n", stem);
+    fprintf(out, "int %s_meta_register(void);\n\n", stem);
+    /* 記述子は外部結合とし、他のヘッダーの型がネスト メンバーとして同じ記述子を参照する。 */
+    for (const struct_meta_gen_struct *s = structs->head; s != NULL; s = s->next)
+    {
+        fprintf(out, "extern const struct_meta_descriptor g_%s_desc;\n", s->name);
+    }
+    fprintf(out, "\n");
+    if (emit_codecs)
+    {
+        struct_meta_gen_codec_emit_declarations(out, structs);
+    }
     fprintf(out, "#ifdef __cplusplus\n");
     fprintf(out, "}\n");
     fprintf(out, "#endif /* __cplusplus */\n\n");
     fprintf(out, "#endif /* %s_META_H */\n", prefix);
 
-    fclose(out);
-    return 0;
+    return struct_meta_gen_output_commit(&output, updated_out);
 }
 
 /**
  *  @brief          型一覧テーブルと取得関数を C ソースへ書き出します。
  *
  *  テーブルの並びはヘッダーの宣言順 (enum と同じ) です。記述子の出力順
- *  (依存順) とは独立です。
+ *  (依存順) とは独立です。構造体名による検索は完全ハッシュ表で引きます
+ *  (`struct_meta_gen_index.h` を参照)。
+ *
+ *  @return         成功時は 0、失敗時は 0 以外です。
  */
-static void emit_catalog_source(FILE *out, const char *stem, const char *prefix,
-                                const struct_meta_gen_struct_list *structs)
+static int emit_catalog_source(FILE *out, const char *stem, const char *prefix,
+                               const struct_meta_gen_struct_list *structs)
 {
     fprintf(out, "static const struct_meta_descriptor *const s_descriptors[%s_META_COUNT] = {\n", prefix);
     for (const struct_meta_gen_struct *s = structs->head; s != NULL; s = s->next)
@@ -476,25 +642,35 @@ static void emit_catalog_source(FILE *out, const char *stem, const char *prefix,
     fprintf(out, "    return s_descriptors[id];\n");
     fprintf(out, "}\n\n");
 
-    fprintf(out, "const struct_meta_descriptor *%s_meta_find(const char *name)\n", stem);
+    if (struct_meta_gen_index_emit(out, stem, structs) != 0)
+    {
+        return 1;
+    }
+    fprintf(out, "\n");
+
+    /* 起動時に型一覧全体を検査・登録し、初回利用時の検査を前倒しする。 */
+    fprintf(out, "int %s_meta_validate_all(size_t thread_count, struct_meta_catalog_report *report_out)\n", stem);
     fprintf(out, "{\n");
-    fprintf(out, "    if (name == NULL)\n");
-    fprintf(out, "    {\n");
-    fprintf(out, "        return NULL;\n");
-    fprintf(out, "    }\n");
-    fprintf(out, "    for (size_t i = 0; i < %s_META_COUNT; i++)\n", prefix);
-    fprintf(out, "    {\n");
-    fprintf(out, "        if (strcmp(s_descriptors[i]->name, name) == 0)\n");
-    fprintf(out, "        {\n");
-    fprintf(out, "            return s_descriptors[i];\n");
-    fprintf(out, "        }\n");
-    fprintf(out, "    }\n");
-    fprintf(out, "    return NULL;\n");
+    fprintf(out,
+            "    return struct_meta_catalog_validate_all(s_descriptors, %s_META_COUNT, thread_count, report_out);\n",
+            prefix);
+    fprintf(out, "}\n\n");
+
+    fprintf(out, "int %s_meta_register(void)\n", stem);
+    fprintf(out, "{\n");
+    fprintf(out, "    return struct_meta_catalog_register(s_descriptors, %s_META_COUNT);\n", prefix);
     fprintf(out, "}\n");
+    return 0;
 }
 
-int struct_meta_gen_emit(const struct_meta_gen_struct_list *structs, const char *header_path, const char *out_path)
+int struct_meta_gen_emit(const struct_meta_gen_struct_list *structs, const struct_meta_gen_typedb *types,
+                         const char *header_path, const char *out_path, int emit_codecs, int *updated_out)
 {
+    if (updated_out != NULL)
+    {
+        *updated_out = 0;
+    }
+
     char stem[STRUCT_META_GEN_EMIT_PATH_BYTES];
     char prefix[STRUCT_META_GEN_EMIT_PATH_BYTES];
     char header_out[STRUCT_META_GEN_EMIT_PATH_BYTES];
@@ -520,26 +696,68 @@ int struct_meta_gen_emit(const struct_meta_gen_struct_list *structs, const char
         return 1;
     }
 
-    FILE *out = com_util_fopen(out_path, "w", NULL);
-    if (out == NULL)
+    emitted_name *foreign_headers = NULL;
+    if (collect_foreign_headers(structs, types, generated_header_include(header_out), &foreign_headers) != 0)
     {
-        fprintf(stderr, "struct-meta-gen: 出力ファイルを作成できません: %s\n", out_path);
+        emitted_destroy(foreign_headers);
         return 1;
     }
 
+    struct_meta_gen_output output;
+    if (struct_meta_gen_output_open(&output, out_path) != 0)
+    {
+        emitted_destroy(foreign_headers);
+        return 1;
+    }
+    FILE *out = output.file;
+
     fprintf(out, "/* このファイルは struct-meta-gen が自動生成しました。手編集しないでください。 */\n");
     fprintf(out, "#include \"../%s\"\n", header_path);
     fprintf(out, "#include \"%s\"\n", generated_header_include(header_out));
+    for (const emitted_name *h = foreign_headers; h != NULL; h = h->next)
+    {
+        fprintf(out, "#include \"%s\"\n", h->name);
+    }
+    emitted_destroy(foreign_headers);
+    if (emit_codecs)
+    {
+        fprintf(out, "#include <com_util/base/result.h>\n");
+    }
     fprintf(out, "#include <stddef.h>\n");
+    fprintf(out, "#include <stdint.h>\n");
     fprintf(out, "#include <string.h>\n\n");
 
     emitted_name *emitted = NULL;
-    for (const struct_meta_gen_struct *s = structs->head; s != NULL; s = s->next)
+    int ret = 0;
+    for (const struct_meta_gen_struct *s = structs->head; (s != NULL) && (ret == 0); s = s->next)
     {
-        emit_struct(out, s, &emitted);
+        ret = emit_struct(out, structs, s, &emitted);
+    }
+    emitted_destroy(emitted);
+    if ((ret != 0) || (emit_catalog_source(out, stem, prefix, structs) != 0))
+    {
+        struct_meta_gen_output_discard(&output);
+        return 1;
+    }
+    if (emit_codecs)
+    {
+        fprintf(out, "\n");
+        struct_meta_gen_codec_emit_source(out, structs);
     }
-    emit_catalog_source(out, stem, prefix, structs);
-    fclose(out);
 
-    return emit_catalog_header(header_out, stem, prefix, structs);
+    int source_updated = 0;
+    int header_updated = 0;
+    if (struct_meta_gen_output_commit(&output, &source_updated) != 0)
+    {
+        return 1;
+    }
+    if (emit_catalog_header(header_out, header_path, stem, prefix, structs, emit_codecs, &header_updated) != 0)
+    {
+        return 1;
+    }
+    if (updated_out != NULL)
+    {
+        *updated_out = source_updated + header_updated;
+    }
+    return 0;
 }
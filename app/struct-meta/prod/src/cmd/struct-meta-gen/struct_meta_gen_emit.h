@@ -15,11 +15,21 @@
 #define STRUCT_META_GEN_EMIT_H
 
 #include "struct_meta_gen_ast.h"
+#include "struct_meta_gen_typedb.h"
+
+#include <stdio.h>
+
+/**
+ *  @brief          文字列を C の文字列リテラルとして書き出します。NULL は `NULL` と書き出します。
+ */
+void struct_meta_gen_fprint_c_string(FILE *out, const char *text);
 
 /**
  *  @brief          ヘッダー内の全構造体の記述子と型一覧を生成し、ファイルへ書き出します。
  *
  *  @param[in]      structs     解析済みの構造体一覧です。1 件以上必要です。
+ *  @param[in]      types       他のヘッダーの型の定義元を引く型データベースです。
+ *                              ネスト メンバーの型が @p structs に無い場合に使います。不要な場合は NULL です。
  *  @param[in]      header_path struct-meta-gen の呼び出し元カレント ディレクトリから見た、
  *                              解析元ヘッダーへの相対パスです。生成コードは
  *                              `$(GENDIR)` (呼び出し元のカレント ディレクトリ直下)
@@ -28,8 +38,17 @@
  *  @param[in]      out_path    生成する C ソースの出力先パスです。拡張子は `.c` です。\n
  *                              同名の `.h` (型一覧 enum と取得関数の宣言) も同じ
  *                              ディレクトリへ書き出します。
+ *  @param[in]      emit_codecs 0 以外なら、構造体ごとの JSON 書き出し・読み込み関数も生成します
+ *                              (`struct_meta_gen_codec.h` を参照)。
+ *  @param[out]     updated_out 書き換えたファイル数 (0 から 2) です。内容が変わらないファイルは
+ *                              書き換えません (`struct_meta_gen_output.h` を参照)。
+ *                              不要な場合は NULL を指定します。
  *  @return         成功時は 0、失敗時は 0 以外です。
+ *
+ *  @par            スレッド セーフ
+ *  本関数はスレッド セーフです。出力先の異なる呼び出しを並行して実行できます。
  */
-int struct_meta_gen_emit(const struct_meta_gen_struct_list *structs, const char *header_path, const char *out_path);
+int struct_meta_gen_emit(const struct_meta_gen_struct_list *structs, const struct_meta_gen_typedb *types,
+                         const char *header_path, const char *out_path, int emit_codecs, int *updated_out);
 
 #endif /* STRUCT_META_GEN_EMIT_H */
@@ -0,0 +1,307 @@
+/**
+ *******************************************************************************
+ *  @file           struct_meta_gen_index.c
+ *  @brief          型一覧の構造体名から記述子を引く、完全ハッシュ表と検索関数を生成します。
+ *  @author         Tetsuo Honda
+ *  @date           2026/10/17
+ *  @version        1.0.0
+ *
+ *  ハッシュ関数は生成コードへも同じ内容で書き出します。
+ *  name_hash() と emit_hash_function() は必ず同時に変更してください。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include "struct_meta_gen_index.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** バケットごとのシードを探す上限です。表の使用率を 1/2 以下にするため、通常は数回で見つかります。 */
+#define INDEX_MAX_SEED 0x01000000U
+
+/** 表の値を 1 行に並べる個数です。 */
+#define INDEX_VALUES_PER_LINE 8
+
+/**
+ *  @brief          バケットの大きさと番号です。大きいバケットから枠を割り当てるために並べ替えます。
+ */
+typedef struct index_bucket
+{
+    size_t size;
+    size_t id;
+} index_bucket;
+
+/**
+ *  @brief          名前のハッシュ値を求めます (FNV-1a の後に下位ビットを攪拌)。
+ */
+static uint32_t name_hash(const char *name, uint32_t seed)
+{
+    uint32_t hash = 2166136261U ^ seed;
+    for (; *name != '\0'; name++)
+    {
+        hash ^= (uint32_t)(unsigned char)*name;
+        hash *= 16777619U;
+    }
+    hash ^= hash >> 16U;
+    hash *= 0x85EBCA6BU;
+    hash ^= hash >> 13U;
+    return hash;
+}
+
+static void emit_hash_function(FILE *out, const char *stem)
+{
+    fprintf(out, "static uint32_t %s_meta_name_hash(const char *name, uint32_t seed)\n", stem);
+    fprintf(out, "{\n");
+    fprintf(out, "    uint32_t hash = 2166136261U ^ seed;\n");
+    fprintf(out, "    for (; *name != '\\0'; name++)\n");
+    fprintf(out, "    {\n");
+    fprintf(out, "        hash ^= (uint32_t)(unsigned char)*name;\n");
+    fprintf(out, "        hash *= 16777619U;\n");
+    fprintf(out, "    }\n");
+    fprintf(out, "    hash ^= hash >> 16U;\n");
+    fprintf(out, "    hash *= 0x85EBCA6BU;\n");
+    fprintf(out, "    hash ^= hash >> 13U;\n");
+    fprintf(out, "    return hash;\n");
+    fprintf(out, "}\n\n");
+}
+
+static size_t power_of_two_at_least(size_t value)
+{
+    size_t result = 1U;
+    while (result < value)
+    {
+        result <<= 1U;
+    }
+    return result;
+}
+
+static int compare_names(const void *left, const void *right)
+{
+    return strcmp(*(const char *const *)left, *(const char *const *)right);
+}
+
+static int compare_buckets(const void *left, const void *right)
+{
+    const index_bucket *a = (const index_bucket *)left;
+    const index_bucket *b = (const index_bucket *)right;
+    if (a->size != b->size)
+    {
+        return (a->size > b->size) ? -1 : 1;
+    }
+    return (a->id < b->id) ? -1 : ((a->id > b->id) ? 1 : 0);
+}
+
+/**
+ *  @brief          同じ構造体名が複数あるかどうかを調べます。重複した名前は完全ハッシュで分けられません。
+ */
+static const char *find_duplicate(const char **names, size_t count)
+{
+    const char **sorted = (const char **)malloc(count * sizeof(*sorted));
+    if (sorted == NULL)
+    {
+        return NULL;
+    }
+    memcpy((void *)sorted, (const void *)names, count * sizeof(*sorted));
+    qsort((void *)sorted, count, sizeof(*sorted), compare_names);
+    const char *duplicate = NULL;
+    for (size_t i = 1; (i < count) && (duplicate == NULL); i++)
+    {
+        if (strcmp(sorted[i - 1U], sorted[i]) == 0)
+        {
+            duplicate = sorted[i];
+        }
+    }
+    free((void *)sorted);
+    return duplicate;
+}
+
+/**
+ *  @brief          1 個のバケットの名前がすべて空き枠へ入るシードを探し、枠へ割り当てます。
+ *  @return         見つかったシードです。見つからない場合は 0 です。
+ */
+static uint32_t place_bucket(const char **names, const size_t *members, size_t member_count, unsigned int *slots,
+                             size_t slot_mask)
+{
+    for (uint32_t seed = 1U; seed < INDEX_MAX_SEED; seed++)
+    {
+        size_t placed = 0U;
+        for (; placed < member_count; placed++)
+        {
+            size_t slot = (size_t)name_hash(names[members[placed]], seed) & slot_mask;
+            if (slots[slot] != 0U)
+            {
+                break;
+            }
+            slots[slot] = (unsigned int)(members[placed] + 1U);
+        }
+        if (placed == member_count)
+        {
+            return seed;
+        }
+        /* 同じシードで置いた分を取り消して、次のシードを試す。 */
+        for (size_t i = 0; i < placed; i++)
+        {
+            slots[(size_t)name_hash(names[members[i]], seed) & slot_mask] = 0U;
+        }
+    }
+    return 0U;
+}
+
+static void emit_table(FILE *out, const char *type_name, const char *table_name, const void *values, size_t count,
+                       int is_seed)
+{
+    fprintf(out, "static const %s %s[%zu] = {", type_name, table_name, count);
+    for (size_t i = 0; i < count; i++)
+    {
+        if ((i % INDEX_VALUES_PER_LINE) == 0U)
+        {
+            fprintf(out, "\n   ");
+        }
+        if (is_seed)
+        {
+            fprintf(out, " 0x%08lXU,", (unsigned long)((const uint32_t *)values)[i]);
+        }
+        else
+        {
+            fprintf(out, " %uU,", ((const unsigned int *)values)[i]);
+        }
+    }
+    fprintf(out, "\n};\n\n");
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_gen_index_emit(FILE *out, const char *stem, const struct_meta_gen_struct_list *structs)
+{
+    size_t count = 0U;
+    for (const struct_meta_gen_struct *s = structs->head; s != NULL; s = s->next)
+    {
+        count++;
+    }
+
+    /* 使用率を 1/2 以下とし、バケットあたりの名前は平均 2 個とする。 */
+    size_t slot_count = power_of_two_at_least(count * 2U);
+    size_t bucket_count = slot_count / 4U;
+    if (bucket_count == 0U)
+    {
+        bucket_count = 1U;
+    }
+
+    const char **names = (const char **)malloc(count * sizeof(*names));
+    size_t *bucket_of = (size_t *)malloc(count * sizeof(*bucket_of));
+    size_t *members = (size_t *)malloc(count * sizeof(*members));
+    size_t *starts = (size_t *)calloc(bucket_count + 1U, sizeof(*starts));
+    index_bucket *order = (index_bucket *)malloc(bucket_count * sizeof(*order));
+    uint32_t *seeds = (uint32_t *)calloc(bucket_count, sizeof(*seeds));
+    unsigned int *slots = (unsigned int *)calloc(slot_count, sizeof(*slots));
+    int ret = 0;
+    if ((names == NULL) || (bucket_of == NULL) || (members == NULL) || (starts == NULL) || (order == NULL) ||
+        (seeds == NULL) || (slots == NULL))
+    {
+        fprintf(stderr, "struct-meta-gen: 名前索引の作業領域を確保できません\n");
+        ret = 1;
+    }
+
+    if (ret == 0)
+    {
+        size_t i = 0U;
+        for (const struct_meta_gen_struct *s = structs->head; s != NULL; s = s->next)
+        {
+            names[i] = s->name;
+            i++;
+        }
+        const char *duplicate = find_duplicate(names, count);
+        if (duplicate != NULL)
+        {
+            fprintf(stderr, "struct-meta-gen: 構造体名が重複しています: %s\n", duplicate);
+            ret = 1;
+        }
+    }
+
+    if (ret == 0)
+    {
+        /* 名前をバケットごとに連続して並べる (計数ソート)。 */
+        for (size_t i = 0; i < count; i++)
+        {
+            bucket_of[i] = (size_t)name_hash(names[i], 0U) & (bucket_count - 1U);
+            starts[bucket_of[i] + 1U]++;
+        }
+        for (size_t b = 0; b < bucket_count; b++)
+        {
+            starts[b + 1U] += starts[b];
+            order[b].size = starts[b + 1U] - starts[b];
+            order[b].id = b;
+        }
+        size_t *cursor = (size_t *)malloc(bucket_count * sizeof(*cursor));
+        if (cursor == NULL)
+        {
+            fprintf(stderr, "struct-meta-gen: 名前索引の作業領域を確保できません\n");
+            ret = 1;
+        }
+        else
+        {
+            memcpy(cursor, starts, bucket_count * sizeof(*cursor));
+            for (size_t i = 0; i < count; i++)
+            {
+                members[cursor[bucket_of[i]]++] = i;
+            }
+            free(cursor);
+        }
+    }
+
+    if (ret == 0)
+    {
+        /* 名前の多いバケットほど空き枠の多いうちに置く。 */
+        qsort(order, bucket_count, sizeof(*order), compare_buckets);
+        for (size_t k = 0; (k < bucket_count) && (order[k].size > 0U); k++)
+        {
+            size_t b = order[k].id;
+            seeds[b] = place_bucket(names, &members[starts[b]], order[k].size, slots, slot_count - 1U);
+            if (seeds[b] == 0U)
+            {
+                fprintf(stderr, "struct-meta-gen: 名前索引を構築できません\n");
+                ret = 1;
+                break;
+            }
+        }
+    }
+
+    if (ret == 0)
+    {
+        fprintf(out, "/* 構造体名の完全ハッシュ表。値は s_descriptors の添字 + 1 (0 は空き)。 */\n");
+        emit_hash_function(out, stem);
+        emit_table(out, "uint32_t", "s_name_seeds", seeds, bucket_count, 1);
+        emit_table(out, "unsigned int", "s_name_slots", slots, slot_count, 0);
+
+        fprintf(out, "const struct_meta_descriptor *%s_meta_find(const char *name)\n", stem);
+        fprintf(out, "{\n");
+        fprintf(out, "    if (name == NULL)\n");
+        fprintf(out, "    {\n");
+        fprintf(out, "        return NULL;\n");
+        fprintf(out, "    }\n");
+        fprintf(out, "    uint32_t seed = s_name_seeds[%s_meta_name_hash(name, 0U) & %zuU];\n", stem,
+                bucket_count - 1U);
+        fprintf(out, "    unsigned int slot = s_name_slots[%s_meta_name_hash(name, seed) & %zuU];\n", stem,
+                slot_count - 1U);
+        fprintf(out, "    if ((slot == 0U) || (strcmp(s_descriptors[slot - 1U]->name, name) != 0))\n");
+        fprintf(out, "    {\n");
+        fprintf(out, "        return NULL;\n");
+        fprintf(out, "    }\n");
+        fprintf(out, "    return s_descriptors[slot - 1U];\n");
+        fprintf(out, "}\n");
+    }
+
+    free(slots);
+    free(seeds);
+    free(order);
+    free(starts);
+    free(members);
+    free(bucket_of);
+    free((void *)names);
+    return ret;
+}
@@ -0,0 +1,39 @@
+/**
+ *******************************************************************************
+ *  @file           struct_meta_gen_index.h
+ *  @brief          型一覧の構造体名から記述子を引く、完全ハッシュ表と検索関数を生成します。
+ *  @author         Tetsuo Honda
+ *  @date           2026/10/17
+ *  @version        1.0.0
+ *
+ *  生成する `<stem>_meta_find()` は、名前のハッシュ値を 2 回求め、表を 2 回引き、
+ *  最後に 1 回だけ文字列を比較します。型の数によらず比較回数は一定です。\n
+ *  表は 2 段の完全ハッシュ (hash and displace) です。1 段目で名前をバケットへ分け、
+ *  2 段目ではバケットごとに選んだシードで、バケット内の名前が空き枠へ衝突せずに入るようにします。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_GEN_INDEX_H
+#define STRUCT_META_GEN_INDEX_H
+
+#include "struct_meta_gen_ast.h"
+
+#include <stdio.h>
+
+/**
+ *  @brief          生成 C ソースへ、名前の完全ハッシュ表と `<stem>_meta_find()` の定義を書き出します。
+ *
+ *  表の値は、型一覧テーブル `s_descriptors` の添字 + 1 です (0 は空き)。
+ *  呼び出し前に `s_descriptors` を書き出しておく必要があります。
+ *
+ *  @param[in,out]  out     生成 C ソースです。
+ *  @param[in]      stem    生成関数名の接頭辞です。
+ *  @param[in]      structs 解析済みの構造体一覧です。1 件以上必要です。
+ *  @return         成功時は 0、構造体名の重複やメモリー不足の場合は 0 以外です。
+ */
+int struct_meta_gen_index_emit(FILE *out, const char *stem, const struct_meta_gen_struct_list *structs);
+
+#endif /* STRUCT_META_GEN_INDEX_H */
@@ -8,39 +8,339 @@
  *
  *  使用方法:
     @code{.sh}
-    struct-meta-gen --header <ヘッダー パス> --out <出力 C ソース パス>
+    struct-meta-gen --header <ヘッダー パス> --out <出力 C ソース パス> [--typedb <型データベース>] [--emit-codecs]
+    struct-meta-gen --gendir <出力ディレクトリ> [--jobs <スレッド数>] [--typedb <型データベース>] [--emit-codecs]
+                    <ヘッダー パス>...
     @endcode
  *
  *  対象ヘッダーを解析し、ヘッダー内の全 `typedef struct` のメタデータ記述子
  *  (`struct_meta_descriptor`) と型一覧 (enum + 取得関数) を `--out` へ生成します。\n
- *  同名の `.h` も同じディレクトリへ書き出します。
+ *  同名の `.h` も同じディレクトリへ書き出します。\n
+ *  `--emit-codecs` を指定すると、構造体ごとの JSON 書き出し・読み込み関数
+ *  (`<型名>_json_write()` / `<型名>_json_read()`) も生成します。
+ *
+ *  `--gendir` を指定すると、複数のヘッダーを 1 回の起動でまとめて変換します (バッチ モード)。
+ *  出力はヘッダーごとに `<出力ディレクトリ>/<ヘッダーのファイル名から拡張子を除いた名前>_meta.c` (と `.h`) です。
+ *  出力名が重複するヘッダー (別のディレクトリの同名ヘッダー) を指定した場合は、何も生成せずにエラーとします。\n
+ *  ヘッダーは `--jobs` のスレッド数で並行に解析・生成します。0 または省略時はオンラインの CPU 数です。\n
+ *  どちらのモードでも、内容が変わらない生成ファイルは書き換えません。
+ *
+ *  ネスト メンバーの型は、同じヘッダーに無ければ型データベース (`struct_meta_gen_typedb.h`) から
+ *  定義元の生成ヘッダーを引き、記述子を複製せずに参照します。
+ *  型データベースは `--typedb` のファイルへ保存します。バッチ モードで省略した場合は
+ *  `<出力ディレクトリ>/struct_meta_gen.types` です。生成ファイルと同じディレクトリに置く必要があります。
  *
  *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
  *
  *******************************************************************************
  */
 
-#include "struct_meta_gen_ast.h"
 #include "struct_meta_gen_emit.h"
+#include "struct_meta_gen_output.h"
+#include "struct_meta_gen_parse.h"
+#include "struct_meta_gen_typedb.h"
 
-#include <com_util/crt/stdio.h>
+#include <struct_meta/base/parallel.h>
 
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
-extern FILE *yyin;
-extern struct_meta_gen_struct_list *g_struct_meta_gen_structs;
-int yyparse(void);
+/** バッチ モードで、`--typedb` を省略した場合の型データベースのファイル名です (出力ディレクトリ内)。 */
+#define GEN_DEFAULT_TYPEDB "struct_meta_gen.types"
+
+/**
+ *  @brief          ヘッダー 1 個分の解析結果と生成結果です。
+ */
+typedef struct gen_item
+{
+    const char *header_path;
+    struct_meta_gen_struct_list *structs;                /* 解析に失敗した場合は NULL です。 */
+    char out_path[STRUCT_META_GEN_OUTPUT_PATH_BYTES];    /* 生成 C ソースのパスです。 */
+    char meta_header[STRUCT_META_GEN_OUTPUT_PATH_BYTES]; /* 生成ヘッダーのファイル名です。空の場合は生成しません。 */
+    int ret;                                             /* 成功時は 0 です。 */
+    int updated;                                         /* 書き換えたファイル数です。 */
+} gen_item;
+
+/**
+ *  @brief          バッチ モードの共有データです。各タスクは自分の受け持つヘッダーの結果だけを書き込みます。
+ */
+typedef struct gen_batch
+{
+    gen_item *items;
+    size_t item_count;
+    size_t task_count;
+    const struct_meta_gen_typedb *types;
+    int emit_codecs;
+    int pad;
+} gen_batch;
 
 static void print_usage(const char *prog)
 {
-    fprintf(stderr, "usage: %s --header <header> --out <out.c>\n", prog);
+    fprintf(stderr, "usage: %s --header <header> --out <out.c> [--typedb <file>] [--emit-codecs]\n", prog);
+    fprintf(stderr, "       %s --gendir <dir> [--jobs <n>] [--typedb <file>] [--emit-codecs] <header>...\n", prog);
+}
+
+static const char *path_basename(const char *path)
+{
+    const char *base = path;
+    for (const char *p = path; *p != '\0'; p++)
+    {
+        if ((*p == '/') || (*p == '\\'))
+        {
+            base = p + 1;
+        }
+    }
+    return base;
+}
+
+/**
+ *  @brief          出力パスと生成ヘッダー名を設定します。
+ *
+ *  @p gendir が NULL の場合は @p out_path をそのまま使います。
+ *  それ以外は `<gendir>/<ヘッダーのファイル名から拡張子を除いた名前>_meta.c` とします。
+ */
+static int item_init(gen_item *item, const char *header_path, const char *gendir, const char *out_path)
+{
+    memset(item, 0, sizeof(*item));
+    item->header_path = header_path;
+    item->ret = 1;
+
+    int written;
+    if (gendir == NULL)
+    {
+        written = snprintf(item->out_path, sizeof(item->out_path), "%s", out_path);
+    }
+    else
+    {
+        const char *base = path_basename(header_path);
+        const char *dot = strrchr(base, '.');
+        int stem_length = (dot != NULL) ? (int)(dot - base) : (int)strlen(base);
+        written = snprintf(item->out_path, sizeof(item->out_path), "%s/%.*s_meta.c", gendir, stem_length, base);
+    }
+    if ((written < 0) || ((size_t)written >= sizeof(item->out_path)))
+    {
+        fprintf(stderr, "struct-meta-gen: 出力パスが長すぎます: %s\n", header_path);
+        return 1;
+    }
+
+    /* 生成ヘッダーは出力 C ソースと同じ名前で、拡張子だけが .h になる。 */
+    const char *base = path_basename(item->out_path);
+    size_t length = strlen(base);
+    if ((length < 2U) || (strcmp(&base[length - 2U], ".c") != 0))
+    {
+        fprintf(stderr, "struct-meta-gen: 出力パスは .c で終わる必要があります: %s\n", item->out_path);
+        return 1;
+    }
+    memcpy(item->meta_header, base, length + 1U);
+    item->meta_header[length - 1U] = 'h';
+    return 0;
+}
+
+/**
+ *  @brief          生成先が重複するヘッダーを調べます。
+ *
+ *  バッチ モードの出力名はヘッダーのファイル名だけから作るため、
+ *  別のディレクトリの同名ヘッダーは同じファイルへ出力します。
+ *  並行に書き込むと生成物が壊れ、型データベースの登録も上書きされるため、生成を始める前にエラーとします。
+ *  @return         重複が無い場合は 0、ある場合は 1 です。
+ */
+static int check_duplicate_outputs(const gen_item *items, size_t item_count)
+{
+    int ret = 0;
+    for (size_t i = 0; i < item_count; i++)
+    {
+        if (items[i].meta_header[0] == '\0')
+        {
+            continue;
+        }
+        for (size_t j = 0; j < i; j++)
+        {
+            if (strcmp(items[i].out_path, items[j].out_path) == 0)
+            {
+                fprintf(stderr, "struct-meta-gen: %s と %s は同じファイル %s へ出力されます\n", items[j].header_path,
+                        items[i].header_path, items[i].out_path);
+                ret = 1;
+                break;
+            }
+        }
+    }
+    return ret;
+}
+
+/**
+ *  @brief          1 タスク分のヘッダーを解析します。
+ *
+ *  ヘッダーの大きさは揃っていないため、連続した範囲ではなく task_count 個おきに受け持ちます。
+ */
+static void parse_task(void *context, size_t task_index)
+{
+    const gen_batch *batch = (const gen_batch *)context;
+    for (size_t i = task_index; i < batch->item_count; i += batch->task_count)
+    {
+        gen_item *item = &batch->items[i];
+        if (item->meta_header[0] != '\0')
+        {
+            item->ret = struct_meta_gen_parse_file(item->header_path, &item->structs);
+        }
+    }
+}
+
+/**
+ *  @brief          1 タスク分のヘッダーを生成します。型データベースは読み取りだけを行います。
+ */
+static void emit_task(void *context, size_t task_index)
+{
+    const gen_batch *batch = (const gen_batch *)context;
+    for (size_t i = task_index; i < batch->item_count; i += batch->task_count)
+    {
+        gen_item *item = &batch->items[i];
+        if (item->ret == 0)
+        {
+            item->ret = struct_meta_gen_emit(item->structs, batch->types, item->header_path, item->out_path,
+                                             batch->emit_codecs, &item->updated);
+        }
+    }
+}
+
+static void run_tasks(gen_batch *batch, struct_meta_internal_task_fn task)
+{
+    if (batch->task_count > 1U)
+    {
+        struct_meta_internal_parallel_run(batch->task_count, task, batch);
+    }
+    else
+    {
+        task(batch, 0U);
+    }
+}
+
+/**
+ *  @brief          解析済みのヘッダーの型を型データベースへ登録します。
+ *
+ *  同じ型を定義するヘッダーが今回の生成対象に 2 個以上ある場合はエラーです
+ *  (どちらの記述子を共有すべきか決められず、リンク時にも記述子が重複するため)。\n
+ *  型データベースは生成ヘッダーのファイル名で登録内容を置き換えるため、
+ *  同じファイル名の生成ヘッダーが今回の生成対象に 2 個以上ある場合もエラーとし、先に登録した型を消しません。
+ *  main() の出力先の重複検査で除いているため、ここでは起きないはずの状態の確認です。
+ */
+static void register_types(gen_item *items, size_t item_count, struct_meta_gen_typedb *types)
+{
+    for (size_t i = 0; i < item_count; i++)
+    {
+        if (items[i].ret != 0)
+        {
+            continue;
+        }
+        for (size_t j = 0; (j < i) && (items[i].ret == 0); j++)
+        {
+            if (strcmp(items[j].meta_header, items[i].meta_header) == 0)
+            {
+                fprintf(stderr, "struct-meta-gen: %s と %s は同じ生成ヘッダー %s を使います\n", items[j].header_path,
+                        items[i].header_path, items[i].meta_header);
+                items[i].ret = 1;
+                break;
+            }
+            if (items[j].structs == NULL)
+            {
+                continue;
+            }
+            for (const struct_meta_gen_struct *s = items[i].structs->head; s != NULL; s = s->next)
+            {
+                if (struct_meta_gen_struct_list_find(items[j].structs, s->name) != NULL)
+                {
+                    fprintf(stderr, "struct-meta-gen: 型 %s が %s と %s の両方で定義されています\n", s->name,
+                            items[j].header_path, items[i].header_path);
+                    items[i].ret = 1;
+                    break;
+                }
+            }
+        }
+        if ((items[i].ret == 0) &&
+            (struct_meta_gen_typedb_register(types, items[i].meta_header, items[i].header_path, items[i].structs) != 0))
+        {
+            items[i].ret = 1;
+        }
+    }
+}
+
+/**
+ *  @brief          ヘッダーを解析し、型データベースへ登録してから生成します。
+ *
+ *  すべてのヘッダーの型を登録してから生成するため、ヘッダーの並び順によらず他のヘッダーの型を解決できます。
+ *  生成がすべて成功した場合だけ、型データベースを保存します。
+ */
+static int run(gen_item *items, size_t item_count, size_t jobs, const char *typedb_path, int emit_codecs,
+               int print_summary)
+{
+    struct_meta_gen_typedb types;
+    struct_meta_gen_typedb_init(&types);
+    int ret = 0;
+    if ((typedb_path != NULL) && (struct_meta_gen_typedb_load(&types, typedb_path) != 0))
+    {
+        ret = 1;
+    }
+
+    /* ヘッダー 1 個でも解析と生成に十分な時間がかかるため、要素数によるタスク数の削減は行わない。 */
+    gen_batch batch;
+    batch.items = items;
+    batch.item_count = item_count;
+    batch.task_count = struct_meta_internal_parallel_tasks(jobs, SIZE_MAX);
+    if (batch.task_count > item_count)
+    {
+        batch.task_count = item_count;
+    }
+    batch.types = &types;
+    batch.emit_codecs = emit_codecs;
+    batch.pad = 0;
+
+    if (ret == 0)
+    {
+        run_tasks(&batch, parse_task);
+        register_types(items, item_count, &types);
+        run_tasks(&batch, emit_task);
+    }
+
+    /* 生成に成功したヘッダーは .c と .h の 2 ファイルを出力する。 */
+    size_t failed = 0U;
+    size_t updated = 0U;
+    for (size_t i = 0; i < item_count; i++)
+    {
+        if (items[i].ret != 0)
+        {
+            failed++;
+        }
+        updated += (size_t)items[i].updated;
+        struct_meta_gen_struct_list_destroy(items[i].structs);
+        items[i].structs = NULL;
+    }
+    if ((ret == 0) && (failed == 0U) && (typedb_path != NULL))
+    {
+        ret = struct_meta_gen_typedb_save(&types, typedb_path);
+    }
+    struct_meta_gen_typedb_dispose(&types);
+
+    if (print_summary)
+    {
+        printf("struct-meta-gen: %zu 個のヘッダーから生成しました (更新 %zu、変更なし %zu ファイル)\n",
+               item_count - failed, updated, ((item_count - failed) * 2U) - updated);
+    }
+    return ((ret == 0) && (failed == 0U)) ? 0 : 1;
 }
 
 int main(int argc, char **argv)
 {
     const char *header_path = NULL;
     const char *out_path = NULL;
+    const char *gendir = NULL;
+    const char *typedb_path = NULL;
+    size_t jobs = 0U;
+    int emit_codecs = 0;
+
+    /* バッチ モードの位置引数 (ヘッダー パス) は argv[1] 以降へ詰め直す。 */
+    char **headers = &argv[1];
+    size_t header_count = 0U;
 
     for (int i = 1; i < argc; i++)
     {
@@ -52,6 +352,33 @@ int main(int argc, char **argv)
         {
             out_path = argv[++i];
         }
+        else if ((strcmp(argv[i], "--gendir") == 0) && ((i + 1) < argc))
+        {
+            gendir = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--typedb") == 0) && ((i + 1) < argc))
+        {
+            typedb_path = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--jobs") == 0) && ((i + 1) < argc))
+        {
+            char *end = NULL;
+            unsigned long value = strtoul(argv[++i], &end, 10);
+            if ((end == argv[i]) || (*end != '\0'))
+            {
+                fprintf(stderr, "struct-meta-gen: スレッド数が不正です: %s\n", argv[i]);
+                return 1;
+            }
+            jobs = (size_t)value;
+        }
+        else if (strcmp(argv[i], "--emit-codecs") == 0)
+        {
+            emit_codecs = 1;
+        }
+        else if (argv[i][0] != '-')
+        {
+            headers[header_count++] = argv[i];
+        }
         else
         {
             fprintf(stderr, "struct-meta-gen: 未知の引数です: %s\n", argv[i]);
@@ -60,31 +387,55 @@ int main(int argc, char **argv)
         }
     }
 
-    if ((header_path == NULL) || (out_path == NULL))
+    if (gendir == NULL)
     {
-        print_usage(argv[0]);
-        return 1;
+        if ((header_path == NULL) || (out_path == NULL) || (header_count > 0U))
+        {
+            print_usage(argv[0]);
+            return 1;
+        }
+        gen_item item;
+        if (item_init(&item, header_path, NULL, out_path) != 0)
+        {
+            return 1;
+        }
+        return run(&item, 1U, 1U, typedb_path, emit_codecs, 0);
     }
 
-    yyin = com_util_fopen(header_path, "r", NULL);
-    if (yyin == NULL)
+    if ((header_path != NULL) || (out_path != NULL) || (header_count == 0U))
     {
-        fprintf(stderr, "struct-meta-gen: ヘッダーを開けません: %s\n", header_path);
+        print_usage(argv[0]);
         return 1;
     }
+    char default_typedb[STRUCT_META_GEN_OUTPUT_PATH_BYTES];
+    if (typedb_path == NULL)
+    {
+        int written = snprintf(default_typedb, sizeof(default_typedb), "%s/%s", gendir, GEN_DEFAULT_TYPEDB);
+        if ((written < 0) || ((size_t)written >= sizeof(default_typedb)))
+        {
+            fprintf(stderr, "struct-meta-gen: 出力パスが長すぎます: %s\n", gendir);
+            return 1;
+        }
+        typedb_path = default_typedb;
+    }
 
-    if (yyparse() != 0)
+    gen_item *items = (gen_item *)calloc(header_count, sizeof(*items));
+    if (items == NULL)
     {
-        fclose(yyin);
+        fprintf(stderr, "struct-meta-gen: メモリーを確保できません\n");
         return 1;
     }
-    fclose(yyin);
-
-    if ((g_struct_meta_gen_structs == NULL) || (g_struct_meta_gen_structs->head == NULL))
+    for (size_t i = 0; i < header_count; i++)
+    {
+        /* 出力パスを作れないヘッダーは生成ヘッダー名が空のまま残り、解析せずに失敗として数える。 */
+        (void)item_init(&items[i], headers[i], gendir, NULL);
+    }
+    if (check_duplicate_outputs(items, header_count) != 0)
     {
-        fprintf(stderr, "struct-meta-gen: 構造体が見つかりません (ヘッダー: %s)\n", header_path);
+        free(items);
         return 1;
     }
-
-    return struct_meta_gen_emit(g_struct_meta_gen_structs, header_path, out_path);
+    int ret = run(items, header_count, jobs, typedb_path, emit_codecs, 1);
+    free(items);
+    return ret;
 }
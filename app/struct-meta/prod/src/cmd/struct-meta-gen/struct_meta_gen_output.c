@@ -0,0 +1,147 @@
+/**
+ *******************************************************************************
+ *  @file           struct_meta_gen_output.c
+ *  @brief          生成ファイルを一時ファイルへ書き出し、内容が変わった場合だけ置き換えます。
+ *  @author         Tetsuo Honda
+ *  @date           2026/10/17
+ *  @version        1.0.0
+ *
+ *  生成ファイルは数十 KB 程度のため、ハッシュ値を保存せず、既存の出力と直接比較します。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include "struct_meta_gen_output.h"
+
+#include <com_util/crt/stdio.h>
+
+#include <stdio.h>
+#include <string.h>
+
+/** 内容を比較する読み込み単位のバイト数です。 */
+#define OUTPUT_COMPARE_BYTES 4096
+
+/**
+ *  @brief          2 個のファイルの内容が同じかどうかを返します。@p existing_path が無い場合は異なるとみなします。
+ */
+static int same_content(const char *temp_path, const char *existing_path)
+{
+    FILE *existing = com_util_fopen(existing_path, "rb", NULL);
+    if (existing == NULL)
+    {
+        return 0;
+    }
+    FILE *temp = com_util_fopen(temp_path, "rb", NULL);
+    if (temp == NULL)
+    {
+        fclose(existing);
+        return 0;
+    }
+
+    unsigned char temp_buffer[OUTPUT_COMPARE_BYTES];
+    unsigned char existing_buffer[OUTPUT_COMPARE_BYTES];
+    int same = 1;
+    while (same)
+    {
+        size_t temp_read = fread(temp_buffer, 1U, sizeof(temp_buffer), temp);
+        size_t existing_read = fread(existing_buffer, 1U, sizeof(existing_buffer), existing);
+        if ((temp_read != existing_read) || (memcmp(temp_buffer, existing_buffer, temp_read) != 0))
+        {
+            same = 0;
+        }
+        else if (temp_read < sizeof(temp_buffer))
+        {
+            /* 両方とも同じ位置で終端に達した。読み込みエラーは内容の相違として扱う。 */
+            same = (ferror(temp) == 0) && (ferror(existing) == 0);
+            break;
+        }
+    }
+
+    fclose(temp);
+    fclose(existing);
+    return same;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_gen_output_open(struct_meta_gen_output *output, const char *path)
+{
+    output->file = NULL;
+    int path_length = snprintf(output->path, sizeof(output->path), "%s", path);
+    int temp_length = snprintf(output->temp_path, sizeof(output->temp_path), "%s.tmp", path);
+    if ((path_length < 0) || ((size_t)path_length >= sizeof(output->path)) || (temp_length < 0) ||
+        ((size_t)temp_length >= sizeof(output->temp_path)))
+    {
+        fprintf(stderr, "struct-meta-gen: 出力パスが長すぎます: %s\n", path);
+        return 1;
+    }
+
+    /* 書き出しは従来どおりテキスト モードとする。比較は書き出し後のバイト列同士で行う。 */
+    output->file = com_util_fopen(output->temp_path, "w", NULL);
+    if (output->file == NULL)
+    {
+        fprintf(stderr, "struct-meta-gen: 出力ファイルを作成できません: %s\n", output->temp_path);
+        return 1;
+    }
+    return 0;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_gen_output_commit(struct_meta_gen_output *output, int *updated_out)
+{
+    if (updated_out != NULL)
+    {
+        *updated_out = 0;
+    }
+
+    int write_error = ferror(output->file);
+    if (fclose(output->file) != 0)
+    {
+        write_error = 1;
+    }
+    output->file = NULL;
+    if (write_error != 0)
+    {
+        fprintf(stderr, "struct-meta-gen: 出力ファイルへ書き込めません: %s\n", output->temp_path);
+        (void)remove(output->temp_path);
+        return 1;
+    }
+
+    if (same_content(output->temp_path, output->path))
+    {
+        (void)remove(output->temp_path);
+        return 0;
+    }
+
+    /* Windows の rename() は既存のファイルを置き換えないため、失敗したら削除してからやり直す。 */
+    if (rename(output->temp_path, output->path) != 0)
+    {
+        (void)remove(output->path);
+        if (rename(output->temp_path, output->path) != 0)
+        {
+            fprintf(stderr, "struct-meta-gen: 出力ファイルを置き換えられません: %s\n", output->path);
+            (void)remove(output->temp_path);
+            return 1;
+        }
+    }
+    if (updated_out != NULL)
+    {
+        *updated_out = 1;
+    }
+    return 0;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_gen_output_discard(struct_meta_gen_output *output)
+{
+    if (output->file != NULL)
+    {
+        fclose(output->file);
+        output->file = NULL;
+    }
+    (void)remove(output->temp_path);
+}
@@ -0,0 +1,64 @@
+/**
+ *******************************************************************************
+ *  @file           struct_meta_gen_output.h
+ *  @brief          生成ファイルを一時ファイルへ書き出し、内容が変わった場合だけ置き換えます。
+ *  @author         Tetsuo Honda
+ *  @date           2026/10/17
+ *  @version        1.0.0
+ *
+ *  内容が同じ生成ファイルは書き換えないため、更新日時も変わりません。
+ *  make は変わっていない生成 C ソースを再コンパイルせず、生成ヘッダーを読み込むソースも再コンパイルしません。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_GEN_OUTPUT_H
+#define STRUCT_META_GEN_OUTPUT_H
+
+#include <stdio.h>
+
+/** 出力パス・一時ファイル パスのバイト数の上限です。 */
+#define STRUCT_META_GEN_OUTPUT_PATH_BYTES 512
+
+/**
+ *  @brief          書き出し中の生成ファイル 1 個です。
+ */
+typedef struct struct_meta_gen_output
+{
+    FILE *file;                                        /**< 一時ファイルです。閉じた後は NULL です。 */
+    char path[STRUCT_META_GEN_OUTPUT_PATH_BYTES];      /**< 最終的な出力パスです。 */
+    char temp_path[STRUCT_META_GEN_OUTPUT_PATH_BYTES]; /**< 一時ファイルのパス (出力パス + ".tmp") です。 */
+} struct_meta_gen_output;
+
+/**
+ *  @brief          生成ファイルの書き出しを始めます。
+ *
+ *  @p path と同じディレクトリに一時ファイルを作ります。
+ *  書き出した後は struct_meta_gen_output_commit() または struct_meta_gen_output_discard() を必ず呼びます。
+ *
+ *  @param[out]     output 書き出し中の生成ファイルです。
+ *  @param[in]      path   最終的な出力パスです。
+ *  @return         成功時は 0、一時ファイルを作成できない場合は 0 以外です。
+ */
+int struct_meta_gen_output_open(struct_meta_gen_output *output, const char *path);
+
+/**
+ *  @brief          一時ファイルを閉じ、既存の出力と内容が異なる場合だけ置き換えます。
+ *
+ *  内容が同じ場合は一時ファイルを削除し、既存の出力には触れません。
+ *
+ *  @param[in,out]  output      書き出し中の生成ファイルです。
+ *  @param[out]     updated_out 出力を書き換えた場合は 1、内容が同じため書き換えなかった場合は 0 です。
+ *                              不要な場合は NULL を指定します。
+ *  @return         成功時は 0、書き込みや置き換えに失敗した場合は 0 以外です。
+ */
+int struct_meta_gen_output_commit(struct_meta_gen_output *output, int *updated_out);
+
+/**
+ *  @brief          一時ファイルを閉じて削除します。既存の出力には触れません。
+ */
+void struct_meta_gen_output_discard(struct_meta_gen_output *output);
+
+#endif /* STRUCT_META_GEN_OUTPUT_H */
@@ -0,0 +1,49 @@
+/**
+ *******************************************************************************
+ *  @file           struct_meta_gen_parse.h
+ *  @brief          構造体ヘッダー 1 個を解析し、構造体一覧を返します。
+ *  @author         Tetsuo Honda
+ *  @date           2026/10/17
+ *  @version        1.0.0
+ *
+ *  字句解析 (flex) と構文解析 (bison) は再入可能な形で生成し、解析の状態は
+ *  呼び出しごとの struct_meta_gen_parse_state に持ちます。
+ *  このため、複数のヘッダーを別々のスレッドで同時に解析できます。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_GEN_PARSE_H
+#define STRUCT_META_GEN_PARSE_H
+
+#include "struct_meta_gen_ast.h"
+
+/**
+ *  @brief          ヘッダー 1 個分の解析状態です。字句解析器と構文解析器が共有します。
+ */
+typedef struct struct_meta_gen_parse_state
+{
+    const char *header_path;               /**< 解析中のヘッダーのパスです (診断メッセージ用)。 */
+    struct_meta_gen_struct_list *structs;  /**< 解析済みの構造体一覧です。無いときは NULL です。 */
+    struct_meta_gen_name_list *enum_names; /**< 解析済みの `typedef enum` の型名です。無いときは NULL です。 */
+    int line;                              /**< 解析中の行番号です。1 から始まります。 */
+    int error;                             /**< 文法以外の理由で解析を中断した場合に 1 です。 */
+} struct_meta_gen_parse_state;
+
+/**
+ *  @brief          ヘッダー 1 個を解析します。
+ *
+ *  @param[in]      header_path 解析するヘッダーのパスです。
+ *  @param[out]     structs_out 解析済みの構造体一覧です。所有権は呼び出し元へ移り、
+ *                              struct_meta_gen_struct_list_destroy() で解放します。
+ *                              失敗時は NULL を格納します。
+ *  @return         成功時は 0、ヘッダーを開けない場合・解析エラー・構造体が 1 個も無い場合は 0 以外です。
+ *
+ *  @par            スレッド セーフ
+ *  本関数はスレッド セーフです。異なるヘッダーを並行して解析できます。
+ */
+int struct_meta_gen_parse_file(const char *header_path, struct_meta_gen_struct_list **structs_out);
+
+#endif /* STRUCT_META_GEN_PARSE_H */
@@ -0,0 +1,239 @@
+/**
+ *******************************************************************************
+ *  @file           struct_meta_gen_typedb.c
+ *  @brief          生成済みの構造体型と、その記述子を定義する生成ファイルの対応 (型データベース) を管理します。
+ *  @author         Tetsuo Honda
+ *  @date           2026/10/17
+ *  @version        1.0.0
+ *
+ *  登録内容は型名で並べた配列に持ち、二分探索で検索します。
+ *  保存するテキストも同じ順に並ぶため、登録内容が同じなら保存結果も同じバイト列になります。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#include "struct_meta_gen_typedb.h"
+#include "struct_meta_gen_output.h"
+
+#include <com_util/crt/stdio.h>
+#include <com_util/crt/string.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** 型データベースの 1 行のバイト数の上限です。 */
+#define TYPEDB_LINE_BYTES 1024
+
+/** 型データベースの先頭行です。 */
+#define TYPEDB_HEADER_LINE "# struct-meta-gen type database: <type> <generated header> <source header>"
+
+static void entry_dispose(struct_meta_gen_typedb_entry *entry)
+{
+    free(entry->type_name);
+    free(entry->meta_header);
+    free(entry->header_path);
+}
+
+/**
+ *  @brief          型名を二分探索します。
+ *  @return         一致した添字、または挿入位置です。@p found_out に一致したかどうかを格納します。
+ */
+static size_t lower_bound(const struct_meta_gen_typedb *db, const char *type_name, int *found_out)
+{
+    size_t low = 0U;
+    size_t high = db->count;
+    while (low < high)
+    {
+        size_t mid = low + ((high - low) / 2U);
+        if (strcmp(db->entries[mid].type_name, type_name) < 0)
+        {
+            low = mid + 1U;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    *found_out = (low < db->count) && (strcmp(db->entries[low].type_name, type_name) == 0);
+    return low;
+}
+
+/**
+ *  @brief          型を登録します。同じ型名の登録内容は置き換えます。
+ */
+static int put(struct_meta_gen_typedb *db, const char *type_name, const char *meta_header, const char *header_path)
+{
+    struct_meta_gen_typedb_entry entry;
+    entry.type_name = com_util_strdup(type_name);
+    entry.meta_header = com_util_strdup(meta_header);
+    entry.header_path = com_util_strdup(header_path);
+    if ((entry.type_name == NULL) || (entry.meta_header == NULL) || (entry.header_path == NULL))
+    {
+        entry_dispose(&entry);
+        return 1;
+    }
+
+    int found = 0;
+    size_t index = lower_bound(db, type_name, &found);
+    if (found)
+    {
+        entry_dispose(&db->entries[index]);
+        db->entries[index] = entry;
+        return 0;
+    }
+
+    if (db->count == db->capacity)
+    {
+        size_t capacity = (db->capacity == 0U) ? 16U : (db->capacity * 2U);
+        struct_meta_gen_typedb_entry *entries =
+            (struct_meta_gen_typedb_entry *)realloc(db->entries, capacity * sizeof(*entries));
+        if (entries == NULL)
+        {
+            entry_dispose(&entry);
+            return 1;
+        }
+        db->entries = entries;
+        db->capacity = capacity;
+    }
+    memmove(&db->entries[index + 1U], &db->entries[index], (db->count - index) * sizeof(*db->entries));
+    db->entries[index] = entry;
+    db->count++;
+    return 0;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_gen_typedb_init(struct_meta_gen_typedb *db)
+{
+    db->entries = NULL;
+    db->count = 0U;
+    db->capacity = 0U;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+void struct_meta_gen_typedb_dispose(struct_meta_gen_typedb *db)
+{
+    for (size_t i = 0; i < db->count; i++)
+    {
+        entry_dispose(&db->entries[i]);
+    }
+    free(db->entries);
+    struct_meta_gen_typedb_init(db);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_gen_typedb_load(struct_meta_gen_typedb *db, const char *path)
+{
+    FILE *in = com_util_fopen(path, "r", NULL);
+    if (in == NULL)
+    {
+        return 0;
+    }
+
+    char line[TYPEDB_LINE_BYTES];
+    int line_number = 0;
+    int ret = 0;
+    while ((ret == 0) && (fgets(line, (int)sizeof(line), in) != NULL))
+    {
+        line_number++;
+        line[strcspn(line, "\r\n")] = '\0';
+        if ((line[0] == '#') || (line[0] == '\0'))
+        {
+            continue;
+        }
+
+        /* 型名と生成ヘッダー名は空白を含まない。ヘッダー パスは行末までとする。 */
+        char *type_name = line;
+        char *meta_header = strchr(type_name, ' ');
+        char *header_path = (meta_header != NULL) ? strchr(meta_header + 1, ' ') : NULL;
+        if (header_path == NULL)
+        {
+            fprintf(stderr, "struct-meta-gen: %s:%d: 型データベースの書式が不正です\n", path, line_number);
+            ret = 1;
+            break;
+        }
+        *meta_header++ = '\0';
+        *header_path++ = '\0';
+        if (put(db, type_name, meta_header, header_path) != 0)
+        {
+            fprintf(stderr, "struct-meta-gen: メモリーを確保できません\n");
+            ret = 1;
+        }
+    }
+    fclose(in);
+    return ret;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_gen_typedb_save(const struct_meta_gen_typedb *db, const char *path)
+{
+    struct_meta_gen_output output;
+    if (struct_meta_gen_output_open(&output, path) != 0)
+    {
+        return 1;
+    }
+    fprintf(output.file, "%s\n", TYPEDB_HEADER_LINE);
+    for (size_t i = 0; i < db->count; i++)
+    {
+        const struct_meta_gen_typedb_entry *entry = &db->entries[i];
+        fprintf(output.file, "%s %s %s\n", entry->type_name, entry->meta_header, entry->header_path);
+    }
+    return struct_meta_gen_output_commit(&output, NULL);
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+int struct_meta_gen_typedb_register(struct_meta_gen_typedb *db, const char *meta_header, const char *header_path,
+                                    const struct_meta_gen_struct_list *structs)
+{
+    /* ヘッダーから削除した型を残さないよう、同じ生成ヘッダーの登録内容を取り除く (順序は保つ)。 */
+    size_t kept = 0U;
+    for (size_t i = 0; i < db->count; i++)
+    {
+        if (strcmp(db->entries[i].meta_header, meta_header) == 0)
+        {
+            entry_dispose(&db->entries[i]);
+        }
+        else
+        {
+            db->entries[kept++] = db->entries[i];
+        }
+    }
+    db->count = kept;
+
+    for (const struct_meta_gen_struct *s = structs->head; s != NULL; s = s->next)
+    {
+        const struct_meta_gen_typedb_entry *previous = struct_meta_gen_typedb_find(db, s->name);
+        if (previous != NULL)
+        {
+            fprintf(stderr, "struct-meta-gen: 警告: 型 %s の定義元を %s から %s へ変更します\n", s->name,
+                    previous->header_path, header_path);
+        }
+        if (put(db, s->name, meta_header, header_path) != 0)
+        {
+            fprintf(stderr, "struct-meta-gen: メモリーを確保できません\n");
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Doxygen コメントは、ヘッダーに記載 */
+
+const struct_meta_gen_typedb_entry *struct_meta_gen_typedb_find(const struct_meta_gen_typedb *db,
+                                                                const char *type_name)
+{
+    if (db == NULL)
+    {
+        return NULL;
+    }
+    int found = 0;
+    size_t index = lower_bound(db, type_name, &found);
+    return found ? &db->entries[index] : NULL;
+}
@@ -0,0 +1,103 @@
+/**
+ *******************************************************************************
+ *  @file           struct_meta_gen_typedb.h
+ *  @brief          生成済みの構造体型と、その記述子を定義する生成ファイルの対応 (型データベース) を管理します。
+ *  @author         Tetsuo Honda
+ *  @date           2026/10/17
+ *  @version        1.0.0
+ *
+ *  1 個の構造体型の記述子は、型を定義したヘッダーの生成ファイルだけが出力します。
+ *  他のヘッダーの構造体がその型をメンバーに持つ場合は、記述子を複製せず、
+ *  定義元の生成ヘッダー (`<stem>_meta.h`) を `#include` して同じ記述子を参照します。\n
+ *  型データベースはこの対応をファイルへ保存し、別の起動で生成するヘッダーからも型を解決できるようにします。
+ *
+ *  ファイルは 1 行 1 型のテキストで、`<型名> <生成ヘッダー名> <ヘッダー パス>` を型名の順に並べます。
+ *
+ *  @copyright      Copyright (C) Tetsuo Honda. 2026. All rights reserved.
+ *
+ *******************************************************************************
+ */
+
+#ifndef STRUCT_META_GEN_TYPEDB_H
+#define STRUCT_META_GEN_TYPEDB_H
+
+#include "struct_meta_gen_ast.h"
+
+#include <stddef.h>
+
+/**
+ *  @brief          型 1 個分の登録内容です。
+ */
+typedef struct struct_meta_gen_typedb_entry
+{
+    char *type_name;   /**< 構造体名です。 */
+    char *meta_header; /**< 記述子を宣言する生成ヘッダーのファイル名 (`<stem>_meta.h`) です。 */
+    char *header_path; /**< 型を定義したヘッダーのパスです (診断メッセージ用)。 */
+} struct_meta_gen_typedb_entry;
+
+/**
+ *  @brief          型データベースです。要素は型名の順に並べます。
+ */
+typedef struct struct_meta_gen_typedb
+{
+    struct_meta_gen_typedb_entry *entries; /**< 登録内容の配列です。 */
+    size_t count;                          /**< 登録した型の数です。 */
+    size_t capacity;                       /**< @p entries の要素数です。 */
+} struct_meta_gen_typedb;
+
+/**
+ *  @brief          空の型データベースを初期化します。
+ */
+void struct_meta_gen_typedb_init(struct_meta_gen_typedb *db);
+
+/**
+ *  @brief          型データベースが所有するメモリーをすべて解放します。
+ */
+void struct_meta_gen_typedb_dispose(struct_meta_gen_typedb *db);
+
+/**
+ *  @brief          ファイルから登録内容を読み込みます。
+ *
+ *  @param[in,out]  db   読み込み先です。同じ型名の登録内容は置き換えます。
+ *  @param[in]      path 型データベースのファイルです。存在しない場合は何もしません。
+ *  @return         成功時は 0、書式が不正な場合やメモリー不足の場合は 0 以外です。
+ */
+int struct_meta_gen_typedb_load(struct_meta_gen_typedb *db, const char *path);
+
+/**
+ *  @brief          登録内容をファイルへ保存します。内容が変わらない場合はファイルを書き換えません。
+ *
+ *  @return         成功時は 0、書き込みに失敗した場合は 0 以外です。
+ */
+int struct_meta_gen_typedb_save(const struct_meta_gen_typedb *db, const char *path);
+
+/**
+ *  @brief          ヘッダー 1 個分の構造体をすべて登録します。
+ *
+ *  同じ @p meta_header で登録済みだった型は、いったんすべて取り除いてから登録し直します
+ *  (ヘッダーから削除した型を残さないため)。\n
+ *  別の生成ヘッダーで登録済みの型は、このヘッダーの定義で置き換え、警告を表示します。\n
+ *  生成ファイルは型データベースと同じディレクトリに置くため、@p meta_header だけで生成先を特定できます。
+ *  1 回の実行で同じ @p meta_header を 2 回以上登録しないでください (先に登録した型が消えます)。
+ *
+ *  @param[in,out]  db          登録先です。
+ *  @param[in]      meta_header 生成ヘッダーのファイル名 (`<stem>_meta.h`) です。
+ *  @param[in]      header_path 解析したヘッダーのパスです。
+ *  @param[in]      structs     解析済みの構造体一覧です。
+ *  @return         成功時は 0、メモリー不足の場合は 0 以外です。
+ */
+int struct_meta_gen_typedb_register(struct_meta_gen_typedb *db, const char *meta_header, const char *header_path,
+                                    const struct_meta_gen_struct_list *structs);
+
+/**
+ *  @brief          構造体名から登録内容を検索します。
+ *
+ *  @return         登録内容です。未登録の場合や @p db が NULL の場合は NULL です。
+ *
+ *  @par            スレッド セーフ
+ *  登録内容を変更しない間は、複数スレッドから並行して呼び出せます。
+ */
+const struct_meta_gen_typedb_entry *struct_meta_gen_typedb_find(const struct_meta_gen_typedb *db,
+                                                                const char *type_name);
+
+#endif /* STRUCT_META_GEN_TYPEDB_H */
@@ -20,19 +20,30 @@ STRUCT_META_GEN_HEADERS := sample_types.h
 # リテラルを直接使う (framework/makefw/docs/makeparts.md の例 6 を参照)。
 _struct_meta_gen_gendir := gen
 
-_struct_meta_gen_stem = $(basename $(1))
+# バッチ モードの出力名は、ヘッダーのファイル名部分から作る。
+_struct_meta_gen_stem = $(notdir $(basename $(1)))
 
-# ヘッダーごとに .c を生成する。struct-meta-gen は同名の .h も副作用として書き出す。
-# 複数ターゲットを 1 行に並べると GNU Make が規則を複製して 2 回起動するため、
-# 正本は .c だけにし、.h は .c に依存させる。
+# 全ヘッダーを 1 回の struct-meta-gen 起動でまとめて変換する (バッチ モード)。
+# struct-meta-gen はヘッダーを並行に解析し、内容が変わらない .c / .h は書き換えない。
+# 書き換えなかった生成物は更新日時が古いままなので、規則の実行記録はスタンプ ファイルに残す。
+# 生成物の .c はスタンプに、.h は .c に依存させる (.h は .c の副作用として書き出される)。
+# スタンプより新しいヘッダーがなくても生成物が削除されている場合は、個別の規則から struct-meta-gen を再実行する。
 # gen/*.c -> obj/*.o のコンパイルは framework 側の _flex_bison_compile.mk が
 # GENDIR_EXTRA_C 経由で汎用的に扱う。
+_struct_meta_gen_stamp := $(_struct_meta_gen_gendir)/struct_meta_gen.stamp
+
+_struct_meta_gen_args := --gendir $(_struct_meta_gen_gendir) $(STRUCT_META_GEN_HEADERS)
+
+$(_struct_meta_gen_stamp): $(STRUCT_META_GEN_HEADERS) $(STRUCT_META_GEN_BIN) | $(_struct_meta_gen_gendir)
+	@echo "struct-meta-gen $(_struct_meta_gen_args)"
+	$(STRUCT_META_GEN_BIN) $(_struct_meta_gen_args)
+	@touch $@
+
 define _STRUCT_META_GEN_RULE
-$(_struct_meta_gen_gendir)/$(call _struct_meta_gen_stem,$(1))_meta.c: $(1) $(STRUCT_META_GEN_BIN) | $(_struct_meta_gen_gendir)
-	@echo "struct-meta-gen --header $(1)"
-	$(STRUCT_META_GEN_BIN) --header $(1) --out $$@
+$(_struct_meta_gen_gendir)/$(call _struct_meta_gen_stem,$(1))_meta.c: $(_struct_meta_gen_stamp)
+	@test -f $$@ || $(STRUCT_META_GEN_BIN) $(_struct_meta_gen_args)
 $(_struct_meta_gen_gendir)/$(call _struct_meta_gen_stem,$(1))_meta.h: $(_struct_meta_gen_gendir)/$(call _struct_meta_gen_stem,$(1))_meta.c
-	@test -f $$@
+	@test -f $$@ || $(STRUCT_META_GEN_BIN) $(_struct_meta_gen_args)
 endef
 $(foreach h,$(STRUCT_META_GEN_HEADERS),$(eval $(call _STRUCT_META_GEN_RULE,$(h))))
 
@@ -34,14 +34,14 @@ typedef struct address
  */
 typedef struct person
 {
-    int id;               /**< 識別子です。 @json_name{person_id} @json_required */
+    int id;               /**< 識別子です。 @json_name{person_id} @json_required @layout_hot */
     unsigned int age;     /**< 年齢です。 */
     double score;         /**< 得点です。 */
     char name[64];        /**< 氏名です。 */
     address home;         /**< 自宅です。 */
     address addresses[2]; /**< 追加の住所です。 */
     int scores[3];        /**< 得点の配列です。 */
-    int serial;           /**< 内部連番です。 @json_ignore */
+    int serial;           /**< 内部連番です。 @json_ignore @layout_cold */
     int pad;              /**< 明示的アラインメントです。 @json_ignore */
 } person;
 
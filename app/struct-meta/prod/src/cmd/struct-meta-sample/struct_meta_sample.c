@@ -15,6 +15,7 @@
  *  起動後は対話でサブコマンドを発行します。\n
  *  `load <path>`、`save <path>`、`cat <path>` はファイル名を引数に取ります。\n
  *  `patch` はメニュー形式、`patch <path>` はパス指定で編集対象を選びます。\n
+ *  `layout` は記述子の配置 (パディング、キャッシュ ライン、並べ替え案) を表示します。\n
  *  その他は `init` / `dump` / `help` / `exit` です。\n
  *  ルートメニューの空行は `help` と同じです。終了は `exit` です。\n
  *  記述子は型一覧の @c SAMPLE_TYPES_PERSON だけを使います。\n
@@ -26,6 +27,7 @@
  */
 
 #include <struct_meta/json/file.h>
+#include <struct_meta/layout/layout.h>
 #include <struct_meta/patch/patch.h>
 #include <struct_meta/print/print.h>
 
@@ -64,7 +66,8 @@ static const struct_meta_descriptor *person_desc(void)
 
 static void print_commands(void)
 {
-    fprintf(stderr, "commands: init  load <path>  patch [field-path]  save <path>  cat <path>  dump  help  exit\n");
+    fprintf(stderr, "commands: init  load <path>  patch [field-path]  save <path>  cat <path>  dump  layout\n");
+    fprintf(stderr, "          help  exit\n");
     fprintf(stderr, "          (空行は help、終了は exit)\n");
 }
 
@@ -269,6 +272,15 @@ static void cmd_dump(const struct_meta_descriptor *desc, const void *instance, i
     }
 }
 
+static void cmd_layout(const struct_meta_descriptor *desc)
+{
+    int ret = struct_meta_layout_write(desc, stdout);
+    if (ret != COM_UTIL_OK)
+    {
+        fprintf(stderr, "struct-meta-sample: 配置の表示に失敗しました (結果コード %d)\n", ret);
+    }
+}
+
 int main(int argc, char **argv)
 {
     const struct_meta_descriptor *desc;
@@ -410,6 +422,17 @@ int main(int argc, char **argv)
                 cmd_dump(desc, instance, has_data);
             }
         }
+        else if (match_command(line, "layout", &args) != 0)
+        {
+            if (args[0] != '\0')
+            {
+                print_commands();
+            }
+            else
+            {
+                cmd_layout(desc);
+            }
+        }
         else
         {
             print_commands();
@@ -1,3 +1,7 @@
+# テスト対象の製品ソースがライブラリ内共有ヘッダーを参照する
+INCDIR += \
+	$(MYAPP_DIR)/prod/include_internal
+
 ifdef PLATFORM_WINDOWS
     # 製品ソースをテスト実行体へ直接定義する。
     # 製品ライブラリのリンク方式は変更しない。
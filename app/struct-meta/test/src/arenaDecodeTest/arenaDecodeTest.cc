@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <struct_meta/json/file.h>
+#include <struct_meta/json/ndjson.h>
+#include <struct_meta/json/reader.h>
+#include <struct_meta/memory/arena.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace
+{
+struct Message
+{
+    int id;
+    double value;
+    char text[6000];
+};
+const struct_meta_field kMessageFields[] = {
+    {"id", STRUCT_META_FIELD_INT, 0, offsetof(Message, id), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"value", STRUCT_META_FIELD_DOUBLE, 0, offsetof(Message, value), sizeof(double), 1, 0, nullptr, nullptr, nullptr,
+     0},
+    {"text", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Message, text), sizeof(char), 1, sizeof(Message::text),
+     nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kMessageDescriptor = {"Message", sizeof(Message), kMessageFields, 3, nullptr};
+
+// エスケープを含む長い文字列で、展開用の一時領域とストリームの窓を伸ばす。
+std::string MessageText(int id, size_t escapes)
+{
+    std::string text = "{\"id\":" + std::to_string(id) + ",\"value\":0.5,\"text\":\"";
+    for (size_t i = 0; i < escapes; i++)
+    {
+        text += "a\\n";
+    }
+    return text + "\"}";
+}
+
+std::string TempPath(const char *name)
+{
+    return testing::TempDir() + name;
+}
+} // namespace
+
+TEST(ArenaDecodeTest, AllocatesAlignedAndRewindsWithoutNewBlocks)
+{
+    struct_meta_arena arena; // [準備_正常系] - 小さいブロックのアリーナを用意する。
+    struct_meta_arena_init(&arena, 64U);
+    void *first = struct_meta_arena_alloc(&arena, 3U); // [手順_正常系]
+    void *second = struct_meta_arena_alloc(&arena, 5U);
+    struct_meta_arena_mark mark = struct_meta_arena_save(&arena);
+    void *large = struct_meta_arena_alloc(&arena, 200U);
+    void *grown = struct_meta_arena_grow(&arena, large, 200U, 210U);
+    size_t blocks = arena.block_count;
+    struct_meta_arena_rewind(&arena, mark);
+    void *again = struct_meta_arena_alloc(&arena, 200U);
+    struct_meta_arena_reset(&arena);
+    void *reused = struct_meta_arena_alloc(&arena, 3U);
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(first) % STRUCT_META_ARENA_ALIGNMENT); // [確認_正常系] - 境界をそろえ、使用量を戻した後は既存のブロックを再利用すること。
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(second) % STRUCT_META_ARENA_ALIGNMENT);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(large, grown);
+    EXPECT_EQ(2U, blocks);
+    EXPECT_EQ(large, again);
+    EXPECT_EQ(first, reused);
+    EXPECT_EQ(2U, arena.block_count);
+    struct_meta_arena_dispose(&arena);
+    EXPECT_EQ(nullptr, arena.first);
+}
+
+TEST(ArenaDecodeTest, DecodesTextWithoutGrowingAfterWarmUp)
+{
+    struct_meta_arena arena; // [準備_正常系] - 1 件目で一時領域を育てる。
+    struct_meta_arena_init(&arena, 0U);
+    Message message;
+    std::string text = MessageText(1, 1000U);
+    ASSERT_EQ(COM_UTIL_OK,
+              struct_meta_json_decode_text_arena(&kMessageDescriptor, text.data(), text.size(), &message, &arena));
+    size_t warm_blocks = arena.block_count;
+    int ret = COM_UTIL_OK; // [手順_正常系]
+    for (int i = 0; (i < 1000) && (ret == COM_UTIL_OK); i++)
+    {
+        std::string next = MessageText(i, 1000U);
+        ret = struct_meta_json_decode_text_arena(&kMessageDescriptor, next.data(), next.size(), &message, &arena);
+    }
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 値を読み込み、ブロックを追加せず、使用量を呼び出し前へ戻すこと。
+    EXPECT_EQ(999, message.id);
+    EXPECT_EQ(2000U, std::strlen(message.text));
+    EXPECT_EQ(warm_blocks, arena.block_count);
+    EXPECT_EQ(0U, arena.used);
+    struct_meta_arena_dispose(&arena);
+}
+
+TEST(ArenaDecodeTest, LoadsFileAndNdjsonFromArena)
+{
+    std::string path = TempPath("arenaDecodeTest_message.json"); // [準備_正常系] - チャンクより長いファイルと NDJSON を用意する。
+    std::string text = MessageText(7, 2500U);
+    FILE *file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(nullptr, file);
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::fclose(file);
+    FILE *stream = std::tmpfile();
+    ASSERT_NE(nullptr, stream);
+    std::string lines = MessageText(1, 10U) + "\n" + MessageText(2, 20U) + "\n";
+    std::fwrite(lines.data(), 1, lines.size(), stream);
+    std::rewind(stream);
+    struct_meta_arena arena;
+    struct_meta_arena_init(&arena, 0U);
+    Message loaded;
+    std::memset(&loaded, 0, sizeof(loaded));
+    int load_ret = struct_meta_json_file_load_arena(&kMessageDescriptor, path.c_str(), &loaded, &arena); // [手順_正常系]
+    size_t used_after_load = arena.used;
+    struct_meta_ndjson_reader reader;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_ndjson_reader_init(&reader, stream, 0U));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_ndjson_reader_use_arena(&reader, &arena));
+    Message records[2];
+    int first_ret = struct_meta_ndjson_reader_next(&reader, &kMessageDescriptor, &records[0]);
+    int second_ret = struct_meta_ndjson_reader_next(&reader, &kMessageDescriptor, &records[1]);
+    int end_ret = struct_meta_ndjson_reader_next(&reader, &kMessageDescriptor, &records[1]);
+    struct_meta_ndjson_reader_dispose(&reader);
+    std::fclose(stream);
+    std::remove(path.c_str());
+    EXPECT_EQ(COM_UTIL_OK, load_ret); // [確認_正常系] - 読み込み後はアリーナの使用量が戻っていること。
+    EXPECT_EQ(7, loaded.id);
+    EXPECT_EQ(5000U, std::strlen(loaded.text));
+    EXPECT_EQ(0U, used_after_load);
+    EXPECT_EQ(COM_UTIL_OK, first_ret);
+    EXPECT_EQ(COM_UTIL_OK, second_ret);
+    EXPECT_EQ(COM_UTIL_ERR_EOF, end_ret);
+    EXPECT_EQ(20U, std::strlen(records[0].text));
+    EXPECT_EQ(40U, std::strlen(records[1].text));
+    EXPECT_EQ(0U, arena.used);
+    struct_meta_arena_dispose(&arena);
+}
+
+TEST(ArenaDecodeTest, RejectsInvalidArguments)
+{
+    struct_meta_arena arena; // [準備_異常系] - アリーナの欠けた呼び出しと、読み取りを始めた後の設定を用意する。
+    struct_meta_arena_init(&arena, 0U);
+    Message message;
+    struct_meta_json_reader reader;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_json_reader_init_text(&reader, "{}", 2U));
+    struct_meta_json_token token;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_json_reader_next(&reader, &token));
+    int no_arena = struct_meta_json_decode_text_arena(&kMessageDescriptor, "{}", 2U, &message, nullptr); // [手順_異常系]
+    int no_file_arena = struct_meta_json_file_load_arena(&kMessageDescriptor, "unused.json", &message, nullptr);
+    int late = struct_meta_json_reader_use_arena(&reader, &arena);
+    int bad_text = struct_meta_json_decode_text_arena(&kMessageDescriptor, "{\"id\":", 6U, &message, &arena);
+    struct_meta_json_reader_dispose(&reader);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, no_arena); // [確認_異常系] - 結果コードでエラーを返し、エラーでも使用量を戻すこと。
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, no_file_arena);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, late);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, bad_text);
+    EXPECT_EQ(0U, arena.used);
+    struct_meta_arena_dispose(&arena);
+}
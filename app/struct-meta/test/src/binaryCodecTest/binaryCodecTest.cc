@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <struct_meta/binary/binary.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+struct Point
+{
+    int x;
+    int pad;
+    double y;
+};
+struct Record
+{
+    int id;
+    int pad;
+    double ratio;
+    char label[6];
+    char pad2[2];
+    unsigned int counts[2];
+    Point points[2];
+};
+struct Packed
+{
+    int a;
+    unsigned int b;
+    float c;
+};
+const struct_meta_field kPointFields[] = {
+    {"x", STRUCT_META_FIELD_INT, 0, offsetof(Point, x), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"y", STRUCT_META_FIELD_DOUBLE, 0, offsetof(Point, y), sizeof(double), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kPointDescriptor = {"Point", sizeof(Point), kPointFields, 2, nullptr};
+const struct_meta_field kRecordFields[] = {
+    {"id", STRUCT_META_FIELD_INT, 0, offsetof(Record, id), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"ratio", STRUCT_META_FIELD_DOUBLE, 0, offsetof(Record, ratio), sizeof(double), 1, 0, nullptr, nullptr, nullptr,
+     0},
+    {"label", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Record, label), sizeof(char), 1, sizeof(Record::label),
+     nullptr, nullptr, nullptr, 0},
+    {"counts", STRUCT_META_FIELD_UNSIGNED, 0, offsetof(Record, counts), sizeof(unsigned int), 2, 0, nullptr, nullptr,
+     nullptr, 0},
+    {"points", STRUCT_META_FIELD_STRUCT, 0, offsetof(Record, points), sizeof(Point), 2, 0, &kPointDescriptor, nullptr,
+     nullptr, 0},
+};
+const struct_meta_descriptor kRecordDescriptor = {"Record", sizeof(Record), kRecordFields, 5, nullptr};
+const struct_meta_field kPackedFields[] = {
+    {"a", STRUCT_META_FIELD_INT, 0, offsetof(Packed, a), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"b", STRUCT_META_FIELD_UNSIGNED, 0, offsetof(Packed, b), sizeof(unsigned int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"c", STRUCT_META_FIELD_FLOAT, 0, offsetof(Packed, c), sizeof(float), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kPackedDescriptor = {"Packed", sizeof(Packed), kPackedFields, 3, nullptr};
+/* フィールドの並びが異なるだけで、名前、種別、サイズ、要素数が同じ記述子。 */
+const struct_meta_field kPackedReorderedFields[] = {
+    {"a", STRUCT_META_FIELD_INT, 0, offsetof(Packed, b), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"b", STRUCT_META_FIELD_UNSIGNED, 0, offsetof(Packed, a), sizeof(unsigned int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"c", STRUCT_META_FIELD_FLOAT, 0, offsetof(Packed, c), sizeof(float), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kPackedReorderedDescriptor = {"Moved", sizeof(Packed), kPackedReorderedFields, 3,
+                                                           nullptr};
+const struct_meta_field kPackedRenamedFields[] = {
+    {"a", STRUCT_META_FIELD_INT, 0, offsetof(Packed, a), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"b", STRUCT_META_FIELD_UNSIGNED, 0, offsetof(Packed, b), sizeof(unsigned int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"d", STRUCT_META_FIELD_FLOAT, 0, offsetof(Packed, c), sizeof(float), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kPackedRenamedDescriptor = {"Packed", sizeof(Packed), kPackedRenamedFields, 3, nullptr};
+
+Record MakeRecord()
+{
+    Record record;
+    std::memset(&record, 0x5A, sizeof(record));
+    record.id = -7;
+    record.ratio = 0.1;
+    std::strcpy(record.label, "ab");
+    record.counts[0] = 4000000000U;
+    record.counts[1] = 1U;
+    record.points[0].x = 1;
+    record.points[0].y = -2.5;
+    record.points[1].x = 3;
+    record.points[1].y = 1e300;
+    return record;
+}
+} // namespace
+
+TEST(BinaryCodecTest, RoundTripsNestedRecordWithoutTouchingPadding)
+{
+    Record source = MakeRecord(); // [準備_正常系] - パディング、char 配列、ネストした配列を含む構造体を用意する。
+    Record actual;
+    std::memset(&actual, 0xEE, sizeof(actual));
+    struct_meta_buffer buffer;
+    struct_meta_buffer_init(&buffer);
+    size_t expected_size = 0;
+    size_t consumed = 0;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_binary_encoded_size(&kRecordDescriptor, &expected_size));
+    int encoded = struct_meta_binary_encode(&kRecordDescriptor, &source, &buffer); // [手順_正常系]
+    int decoded = struct_meta_binary_decode(&kRecordDescriptor, buffer.data, buffer.length, &actual, &consumed);
+    EXPECT_EQ(COM_UTIL_OK, encoded); // [確認_正常系] - フィールドの値を復元し、パディングは変更しないこと。
+    EXPECT_EQ(COM_UTIL_OK, decoded);
+    EXPECT_EQ(STRUCT_META_BINARY_HEADER_SIZE + 4U + 8U + 6U + 8U + (2U * 12U), expected_size);
+    EXPECT_EQ(expected_size, buffer.length);
+    EXPECT_EQ(expected_size, consumed);
+    EXPECT_EQ(-7, actual.id);
+    EXPECT_EQ(0.1, actual.ratio);
+    EXPECT_STREQ("ab", actual.label);
+    EXPECT_EQ(0, actual.label[3]);
+    EXPECT_EQ(4000000000U, actual.counts[0]);
+    EXPECT_EQ(1U, actual.counts[1]);
+    EXPECT_EQ(-2.5, actual.points[0].y);
+    EXPECT_EQ(3, actual.points[1].x);
+    EXPECT_EQ(1e300, actual.points[1].y);
+    EXPECT_EQ(static_cast<int>(0xEEEEEEEE), actual.pad);
+    EXPECT_EQ(static_cast<int>(0xEEEEEEEE), actual.points[1].pad);
+    struct_meta_buffer_dispose(&buffer);
+}
+
+TEST(BinaryCodecTest, WritesLittleEndianHeaderAndPayload)
+{
+    Packed packed = {0x01020304, 0xA0B0C0D0U, 1.0F}; // [準備_正常系] - パディングのない構造体を用意する。
+    struct_meta_buffer buffer;
+    struct_meta_buffer_init(&buffer);
+    uint64_t fingerprint = 0;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_binary_fingerprint(&kPackedDescriptor, &fingerprint));
+    int ret = struct_meta_binary_encode(&kPackedDescriptor, &packed, &buffer); // [手順_正常系]
+    const unsigned char expected_payload[] = {0x04, 0x03, 0x02, 0x01, 0xD0, 0xC0, 0xB0, 0xA0, 0x00, 0x00, 0x80, 0x3F};
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - ヘッダーと値をリトル エンディアンで、記述子の順に並べること。
+    ASSERT_EQ(STRUCT_META_BINARY_HEADER_SIZE + sizeof(expected_payload), buffer.length);
+    EXPECT_EQ(0, std::memcmp("SMB\x01\x0C\x00\x00\x00", buffer.data, 8));
+    for (size_t i = 0; i < 8U; i++)
+    {
+        EXPECT_EQ(static_cast<unsigned char>(fingerprint >> (i * 8U)), buffer.data[8U + i]);
+    }
+    EXPECT_EQ(0, std::memcmp(expected_payload, buffer.data + STRUCT_META_BINARY_HEADER_SIZE, sizeof(expected_payload)));
+    struct_meta_buffer_dispose(&buffer);
+}
+
+TEST(BinaryCodecTest, FingerprintFollowsSchemaNotOffsets)
+{
+    uint64_t packed = 0; // [準備_正常系] - オフセットだけが異なる記述子と、フィールド名が異なる記述子を用意する。
+    uint64_t reordered = 0;
+    uint64_t renamed = 0;
+    int ret1 = struct_meta_binary_fingerprint(&kPackedDescriptor, &packed); // [手順_正常系]
+    int ret2 = struct_meta_binary_fingerprint(&kPackedReorderedDescriptor, &reordered);
+    int ret3 = struct_meta_binary_fingerprint(&kPackedRenamedDescriptor, &renamed);
+    EXPECT_EQ(COM_UTIL_OK, ret1); // [確認_正常系] - 指紋はオフセットと構造体名に依存せず、フィールド名に依存すること。
+    EXPECT_EQ(COM_UTIL_OK, ret2);
+    EXPECT_EQ(COM_UTIL_OK, ret3);
+    EXPECT_EQ(packed, reordered);
+    EXPECT_NE(packed, renamed);
+}
+
+TEST(BinaryCodecTest, RejectsMismatchedAndBrokenRecords)
+{
+    Packed packed = {1, 2U, 3.0F}; // [準備_異常系] - 指紋の異なる記述子、途中で切れたデータ、不正なマジックを用意する。
+    Packed target = {9, 9U, 9.0F};
+    struct_meta_buffer buffer;
+    struct_meta_buffer_init(&buffer);
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_binary_encode(&kPackedDescriptor, &packed, &buffer));
+    int mismatched = struct_meta_binary_decode(&kPackedRenamedDescriptor, buffer.data, buffer.length, &target,
+                                               nullptr); // [手順_異常系]
+    int truncated = struct_meta_binary_decode(&kPackedDescriptor, buffer.data, buffer.length - 1U, &target, nullptr);
+    int short_header = struct_meta_binary_decode(&kPackedDescriptor, buffer.data, 3U, &target, nullptr);
+    buffer.data[0] = 'X';
+    int bad_magic = struct_meta_binary_decode(&kPackedDescriptor, buffer.data, buffer.length, &target, nullptr);
+    EXPECT_EQ(COM_UTIL_ERR_UNSUPPORTED, mismatched); // [確認_異常系] - 結果コードで区別し、書き戻し先を変更しないこと。
+    EXPECT_EQ(COM_UTIL_ERR_EOF, truncated);
+    EXPECT_EQ(COM_UTIL_ERR_EOF, short_header);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, bad_magic);
+    EXPECT_EQ(9, target.a);
+    EXPECT_EQ(9U, target.b);
+    struct_meta_buffer_dispose(&buffer);
+}
+
+TEST(BinaryCodecTest, RejectsUnterminatedCharArray)
+{
+    Record source = MakeRecord(); // [準備_異常系] - NUL 終端のない char 配列を用意する。
+    Record target = MakeRecord();
+    struct_meta_buffer buffer;
+    struct_meta_buffer_init(&buffer);
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_binary_encode(&kRecordDescriptor, &source, &buffer));
+    size_t length = buffer.length;
+    std::memcpy(source.label, "abcdef", sizeof(source.label));
+    int encoded = struct_meta_binary_encode(&kRecordDescriptor, &source, &buffer); // [手順_異常系]
+    std::memcpy(buffer.data + STRUCT_META_BINARY_HEADER_SIZE + 12U, "abcdef", 6U);
+    target.id = 42;
+    int decoded = struct_meta_binary_decode(&kRecordDescriptor, buffer.data, buffer.length, &target, nullptr);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, encoded); // [確認_異常系] - 書き出しは追記を取り消し、読み込みは何も書き込まないこと。
+    EXPECT_EQ(length, buffer.length);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, decoded);
+    EXPECT_EQ(42, target.id);
+    struct_meta_buffer_dispose(&buffer);
+}
@@ -0,0 +1,240 @@
+#include <gtest/gtest.h>
+#include <struct_meta/meta/catalog.h>
+#include <struct_meta/meta/name_index.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+struct Inner
+{
+    int value;
+};
+struct Item
+{
+    int id;
+    Inner inner;
+};
+const struct_meta_field kInnerFields[] = {
+    {"value", STRUCT_META_FIELD_INT, 0, offsetof(Inner, value), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kInnerDescriptor = {"Inner", sizeof(Inner), kInnerFields, 1, nullptr};
+const struct_meta_field kCorruptFields[] = {
+    {"inner", STRUCT_META_FIELD_STRUCT, 0, 0, sizeof(Inner) + 1U, 1, 0, &kInnerDescriptor, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kCorruptDescriptor = {"Corrupt", sizeof(Inner) + 1U, kCorruptFields, 1, nullptr};
+
+// 記述子は登録後も参照されるため、プロセス終了まで残る領域に置く。
+constexpr size_t kItemCount = 1024U;
+struct_meta_field g_item_fields[kItemCount][2];
+struct_meta_descriptor g_item_descriptors[kItemCount];
+const struct_meta_descriptor *g_items[kItemCount];
+
+// すべて同じネスト先 Inner を共有する、アドレスの異なる記述子の一覧を作る。
+void MakeItems()
+{
+    for (size_t i = 0; i < kItemCount; i++)
+    {
+        g_item_fields[i][0] = {"id", STRUCT_META_FIELD_INT, 0, offsetof(Item, id), sizeof(int), 1, 0, nullptr,
+                               nullptr, nullptr, 0};
+        g_item_fields[i][1] = {"inner", STRUCT_META_FIELD_STRUCT, 0, offsetof(Item, inner), sizeof(Inner), 1, 0,
+                               &kInnerDescriptor, nullptr, nullptr, 0};
+        g_item_descriptors[i] = {"Item", sizeof(Item), g_item_fields[i], 2, nullptr};
+        g_items[i] = &g_item_descriptors[i];
+    }
+}
+
+constexpr size_t kChainDepth = 40U;
+struct_meta_field g_chain_fields[kChainDepth];
+struct_meta_descriptor g_chain_descriptors[kChainDepth];
+
+// 各記述子が次の記述子を 1 個だけ持つ、深いネストを作る。
+const struct_meta_descriptor *MakeChain()
+{
+    for (size_t i = 0; i < kChainDepth; i++)
+    {
+        if (i + 1U < kChainDepth)
+        {
+            g_chain_fields[i] = {"next", STRUCT_META_FIELD_STRUCT, 0, 0, sizeof(int), 1, 0,
+                                 &g_chain_descriptors[i + 1U], nullptr, nullptr, 0};
+        }
+        else
+        {
+            g_chain_fields[i] = {"value", STRUCT_META_FIELD_INT, 0, 0, sizeof(int), 1, 0, nullptr, nullptr, nullptr,
+                                 0};
+        }
+        g_chain_descriptors[i] = {"Chain", sizeof(int), &g_chain_fields[i], 1, nullptr};
+    }
+    return &g_chain_descriptors[0];
+}
+
+const struct_meta_attribute kUniqueAttributes[] = {
+    {"a", nullptr}, {"b", nullptr}, {"c", nullptr}, {"d", nullptr}, {"e", nullptr}, {"f", nullptr},
+    {"g", nullptr}, {"h", nullptr}, {"i", nullptr}, {"j", nullptr}, {"k", nullptr}, {"l", nullptr},
+};
+const struct_meta_field kUniqueFields[] = {
+    {"value", STRUCT_META_FIELD_INT, 0, 0, sizeof(int), 1, 0, nullptr, nullptr, kUniqueAttributes, 12},
+};
+const struct_meta_descriptor kUniqueDescriptor = {"Unique", sizeof(int), kUniqueFields, 1, nullptr};
+const struct_meta_attribute kDuplicatedAttributes[] = {
+    {"a", nullptr}, {"b", nullptr}, {"c", nullptr}, {"d", nullptr}, {"e", nullptr}, {"f", nullptr},
+    {"g", nullptr}, {"h", nullptr}, {"i", nullptr}, {"j", nullptr}, {"k", nullptr}, {"c", nullptr},
+};
+const struct_meta_field kDuplicatedFields[] = {
+    {"value", STRUCT_META_FIELD_INT, 0, 0, sizeof(int), 1, 0, nullptr, nullptr, kDuplicatedAttributes, 12},
+};
+const struct_meta_descriptor kDuplicatedDescriptor = {"Duplicated", sizeof(int), kDuplicatedFields, 1, nullptr};
+const struct_meta_descriptor kSpotDescriptor = {"Spot", sizeof(int), kUniqueFields, 1, nullptr};
+
+// 名前索引で "Spot" と同じ位置から探索が始まる、"Spot" の後ろに NUL と 2 文字を続けた 7 バイトのキーを作る。
+bool MakeKeyCollidingWithSpot(char *key)
+{
+    const uint32_t slot = struct_meta_internal_name_hash("Spot", 4U) & (STRUCT_META_CATALOG_NAME_CAPACITY - 1U);
+    std::memcpy(key, "Spot", 5U);
+    for (unsigned int first = 'a'; first <= 'z'; first++)
+    {
+        for (unsigned int second = 0U; second < 256U; second++)
+        {
+            key[5] = (char)first;
+            key[6] = (char)second;
+            if ((struct_meta_internal_name_hash(key, 7U) & (STRUCT_META_CATALOG_NAME_CAPACITY - 1U)) == slot)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+} // namespace
+
+TEST(CatalogValidateTest, ValidatesEachDescriptorOnce)
+{
+    MakeItems(); // [準備_正常系] - ネスト先を共有する一覧を用意する。
+    const struct_meta_descriptor *items[] = {g_items[0], g_items[1], g_items[2]};
+    const struct_meta_descriptor *nested[] = {&kInnerDescriptor};
+    struct_meta_catalog_report first;
+    struct_meta_catalog_report second;
+    int first_ret = struct_meta_catalog_validate_all(items, 3U, 1U, &first); // [手順_正常系]
+    int second_ret = struct_meta_catalog_validate_all(items, 3U, 1U, &second);
+    struct_meta_catalog_report nested_report;
+    int nested_ret = struct_meta_catalog_validate_all(nested, 1U, 1U, &nested_report);
+    EXPECT_EQ(COM_UTIL_OK, first_ret); // [確認_正常系] - 初回だけ検査し、2 回目と共有されたネスト先は登録済みとして省略すること。
+    EXPECT_EQ(3U, first.descriptor_count);
+    EXPECT_EQ(3U, first.validated_count);
+    EXPECT_EQ(0U, first.skipped_count);
+    EXPECT_EQ(3U, first.failed_index);
+    EXPECT_EQ(1U, first.thread_count);
+    EXPECT_EQ(COM_UTIL_OK, second_ret);
+    EXPECT_EQ(0U, second.validated_count);
+    EXPECT_EQ(3U, second.skipped_count);
+    EXPECT_EQ(COM_UTIL_OK, nested_ret);
+    EXPECT_EQ(1U, nested_report.skipped_count);
+}
+
+TEST(CatalogValidateTest, ValidatesLargeCatalogInParallel)
+{
+    MakeItems(); // [準備_正常系] - 複数タスクへ分けられる大きさの一覧を用意する。
+    struct_meta_catalog_report report;
+    struct_meta_catalog_report again;
+    int ret = struct_meta_catalog_validate_all(g_items, kItemCount, 4U, &report); // [手順_正常系]
+    int again_ret = struct_meta_catalog_validate_all(g_items, kItemCount, 4U, &again);
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 複数スレッドで検査し、すべての記述子を 1 回ずつ数えること。
+    EXPECT_EQ(4U, report.thread_count);
+    EXPECT_EQ(kItemCount, report.validated_count + report.skipped_count);
+    EXPECT_EQ(kItemCount, report.failed_index);
+    EXPECT_EQ(COM_UTIL_OK, again_ret);
+    EXPECT_EQ(kItemCount, again.skipped_count);
+    EXPECT_EQ(0U, again.validated_count);
+}
+
+TEST(CatalogValidateTest, ValidatesDeepNestingAndLongAttributeLists)
+{
+    const struct_meta_descriptor *catalog[] = {MakeChain(), &kUniqueDescriptor}; // [準備_正常系] - 探索中の記述子の初期容量を超えるネストと、整列して調べる長さの属性を用意する。
+    struct_meta_catalog_report report;
+    int ret = struct_meta_catalog_validate_all(catalog, 2U, 1U, &report); // [手順_正常系]
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - いずれも検査に成功すること。
+    EXPECT_EQ(2U, report.validated_count);
+}
+
+TEST(CatalogValidateTest, ReportsFirstFailure)
+{
+    MakeItems(); // [準備_異常系] - 途中に壊れた記述子を含む一覧と、重複キーを持つ長い属性を用意する。
+    const struct_meta_descriptor *mixed[600];
+    for (size_t i = 0; i < 600U; i++)
+    {
+        mixed[i] = g_items[i];
+    }
+    mixed[100] = &kCorruptDescriptor;
+    mixed[500] = &kCorruptDescriptor;
+    const struct_meta_descriptor *with_null[] = {g_items[0], nullptr};
+    const struct_meta_descriptor *attributes[] = {&kDuplicatedDescriptor};
+    struct_meta_catalog_report sequential;
+    struct_meta_catalog_report parallel;
+    struct_meta_catalog_report null_report;
+    int sequential_ret = struct_meta_catalog_validate_all(mixed, 600U, 1U, &sequential); // [手順_異常系]
+    int parallel_ret = struct_meta_catalog_validate_all(mixed, 600U, 2U, &parallel);
+    int null_ret = struct_meta_catalog_validate_all(with_null, 2U, 1U, &null_report);
+    int attribute_ret = struct_meta_catalog_validate_all(attributes, 1U, 1U, nullptr);
+    int no_list = struct_meta_catalog_validate_all(nullptr, 1U, 1U, nullptr);
+    int empty = struct_meta_catalog_validate_all(nullptr, 0U, 1U, nullptr);
+    EXPECT_EQ(COM_UTIL_ERR_CORRUPT_DESCRIPTOR, sequential_ret); // [確認_異常系] - 一覧で最初に失敗した添字と結果コードを返すこと。
+    EXPECT_EQ(100U, sequential.failed_index);
+    EXPECT_EQ(COM_UTIL_ERR_CORRUPT_DESCRIPTOR, parallel_ret);
+    EXPECT_EQ(100U, parallel.failed_index);
+    EXPECT_EQ(2U, parallel.thread_count);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, null_ret);
+    EXPECT_EQ(1U, null_report.failed_index);
+    EXPECT_EQ(COM_UTIL_ERR_CORRUPT_DESCRIPTOR, attribute_ret);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, no_list);
+    EXPECT_EQ(COM_UTIL_OK, empty);
+}
+
+TEST(CatalogValidateTest, FindsNamesAcrossRegisteredCatalogs)
+{
+    const struct_meta_descriptor *first[] = {&kInnerDescriptor, &kUniqueDescriptor}; // [準備_正常系] - 2 個の型一覧を用意する。
+    const struct_meta_descriptor *second[] = {&kDuplicatedDescriptor};
+    int first_ret = struct_meta_catalog_register(first, 2U); // [手順_正常系]
+    int second_ret = struct_meta_catalog_register(second, 1U);
+    int again_ret = struct_meta_catalog_register(first, 2U);
+    const char message[] = "Uniquely";
+    EXPECT_EQ(COM_UTIL_OK, first_ret); // [確認_正常系] - どちらの型一覧の記述子も、名前の長さを指定して検索できること。
+    EXPECT_EQ(COM_UTIL_OK, second_ret);
+    EXPECT_EQ(COM_UTIL_OK, again_ret);
+    EXPECT_EQ(&kInnerDescriptor, struct_meta_catalog_find("Inner", 5U));
+    EXPECT_EQ(&kDuplicatedDescriptor, struct_meta_catalog_find("Duplicated", 10U));
+    EXPECT_EQ(&kUniqueDescriptor, struct_meta_catalog_find(message, 6U));
+    EXPECT_EQ(nullptr, struct_meta_catalog_find(message, 8U));
+    EXPECT_EQ(nullptr, struct_meta_catalog_find("Inne", 4U));
+    EXPECT_EQ(nullptr, struct_meta_catalog_find(nullptr, 0U));
+}
+
+TEST(CatalogValidateTest, KeepsFirstDescriptorForDuplicateName)
+{
+    static const struct_meta_descriptor other_inner = {"Inner", sizeof(Inner), kInnerFields, 1, nullptr}; // [準備_異常系] - 登録済みの構造体名を持つ別の記述子と、NULL を含む一覧を用意する。
+    const struct_meta_descriptor *first[] = {&kInnerDescriptor};
+    const struct_meta_descriptor *conflict[] = {&other_inner, &kCorruptDescriptor};
+    const struct_meta_descriptor *with_null[] = {nullptr};
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_catalog_register(first, 1U));
+    int conflict_ret = struct_meta_catalog_register(conflict, 2U); // [手順_異常系]
+    int null_ret = struct_meta_catalog_register(with_null, 1U);
+    int no_list = struct_meta_catalog_register(nullptr, 1U);
+    EXPECT_EQ(COM_UTIL_SKIPPED, conflict_ret); // [確認_異常系] - 先に登録した記述子を残し、重複しない記述子は登録すること。
+    EXPECT_EQ(&kInnerDescriptor, struct_meta_catalog_find("Inner", 5U));
+    EXPECT_EQ(&kCorruptDescriptor, struct_meta_catalog_find("Corrupt", 7U));
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, null_ret);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, no_list);
+}
+
+TEST(CatalogValidateTest, RejectsNamesWithEmbeddedNul)
+{
+    const struct_meta_descriptor *spot[] = {&kSpotDescriptor}; // [準備_異常系] - NUL を含むキーを用意する。
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_catalog_register(spot, 1U));
+    char key[7];
+    ASSERT_TRUE(MakeKeyCollidingWithSpot(key));
+    const struct_meta_descriptor *embedded = struct_meta_catalog_find(key, 7U); // [手順_異常系]
+    const struct_meta_descriptor *prefix = struct_meta_catalog_find(key, 4U);
+    EXPECT_EQ(nullptr, embedded); // [確認_異常系] - 名前の終端より先を読まないこと。
+    EXPECT_EQ(&kSpotDescriptor, prefix);
+}
@@ -0,0 +1,11 @@
+# テスト対象のソース ファイル
+TEST_SRCS := \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/catalog.c
+
+ADD_SRCS += \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/base/parallel.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/name_index.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/registry.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/validate.c
+
+LIBS += com_util
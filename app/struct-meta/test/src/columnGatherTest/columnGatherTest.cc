@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <struct_meta/access/access.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+struct Address
+{
+    char city[8];
+    int zip;
+};
+struct Person
+{
+    int id;
+    float ratio;
+    double scores[3];
+    Address addresses[2];
+};
+const struct_meta_field kAddressFields[] = {
+    {"city", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Address, city), sizeof(char), 1, sizeof(Address::city), nullptr,
+     nullptr, nullptr, 0},
+    {"zip", STRUCT_META_FIELD_INT, 0, offsetof(Address, zip), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kAddressDescriptor = {"Address", sizeof(Address), kAddressFields, 2, nullptr};
+const struct_meta_field kPersonFields[] = {
+    {"id", STRUCT_META_FIELD_INT, 0, offsetof(Person, id), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"ratio", STRUCT_META_FIELD_FLOAT, 0, offsetof(Person, ratio), sizeof(float), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"scores", STRUCT_META_FIELD_DOUBLE, 0, offsetof(Person, scores), sizeof(double), 3, 0, nullptr, nullptr, nullptr,
+     0},
+    {"addresses", STRUCT_META_FIELD_STRUCT, 0, offsetof(Person, addresses), sizeof(Address), 2, 0,
+     &kAddressDescriptor, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kPersonDescriptor = {"Person", sizeof(Person), kPersonFields, 4, nullptr};
+
+std::vector<Person> MakePeople(size_t count)
+{
+    std::vector<Person> people(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        Person &person = people[i];
+        std::memset(&person, 0, sizeof(person));
+        person.id = static_cast<int>(i);
+        person.ratio = static_cast<float>(i) * 0.5f;
+        for (size_t j = 0; j < 3U; j++)
+        {
+            person.scores[j] = static_cast<double>((i * 10U) + j);
+        }
+        person.addresses[1].zip = static_cast<int>(1000U + i);
+        person.addresses[1].city[0] = static_cast<char>('a' + (i % 26U));
+    }
+    return people;
+}
+} // namespace
+
+TEST(ColumnGatherTest, GathersFieldAcrossArray)
+{
+    std::vector<Person> people = MakePeople(37); // [準備_正常系] - int、float、double の配列要素、ネストした値のパスを用意する。
+    struct_meta_path_handle id;
+    struct_meta_path_handle ratio;
+    struct_meta_path_handle score;
+    struct_meta_path_handle zip;
+    struct_meta_path_handle city;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_path_compile(&kPersonDescriptor, "id", &id));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_path_compile(&kPersonDescriptor, "ratio", &ratio));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_path_compile(&kPersonDescriptor, "scores[2]", &score));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_path_compile(&kPersonDescriptor, "addresses[1].zip", &zip));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_path_compile(&kPersonDescriptor, "addresses[1].city", &city));
+    std::vector<int> ids(people.size());
+    std::vector<float> ratios(people.size());
+    std::vector<double> scores(people.size());
+    std::vector<int> zips(people.size());
+    std::vector<char> cities(people.size() * sizeof(Address::city));
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_gather(&id, people.data(), people.size(), 0, ids.data())); // [手順_正常系]
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_gather(&ratio, people.data(), people.size(), 0, ratios.data()));
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_gather(&score, people.data(), people.size(), 0, scores.data()));
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_gather(&zip, people.data(), people.size(), 0, zips.data()));
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_gather(&city, people.data(), people.size(), 0, cities.data()));
+    for (size_t i = 0; i < people.size(); i++) // [確認_正常系] - 各要素の値を添字順に詰めて複写すること。
+    {
+        EXPECT_EQ(people[i].id, ids[i]);
+        EXPECT_EQ(people[i].ratio, ratios[i]);
+        EXPECT_EQ(people[i].scores[2], scores[i]);
+        EXPECT_EQ(people[i].addresses[1].zip, zips[i]);
+        EXPECT_STREQ(people[i].addresses[1].city, &cities[i * sizeof(Address::city)]);
+    }
+}
+
+TEST(ColumnGatherTest, ScattersColumnWithStrideAndWholeArray)
+{
+    std::vector<Person> people = MakePeople(8); // [準備_正常系] - 1 個おきの要素と、添字のない配列全体のパスを用意する。
+    std::vector<Person> expected = people;
+    struct_meta_path_handle score;
+    struct_meta_path_handle scores;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_path_compile(&kPersonDescriptor, "scores[1]", &score));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_path_compile(&kPersonDescriptor, "scores", &scores));
+    const double column[4] = {-1.0, -2.0, -3.0, -4.0};
+    std::vector<double> whole(4U * 3U);
+    int scattered = struct_meta_scatter(&score, column, 4, 2U * sizeof(Person), people.data()); // [手順_正常系]
+    int gathered = struct_meta_gather(&scores, people.data(), 4, 2U * sizeof(Person), whole.data());
+    EXPECT_EQ(COM_UTIL_OK, scattered); // [確認_正常系] - 指定した要素だけを書き換え、配列全体は要素数分のバイト数で複写すること。
+    EXPECT_EQ(COM_UTIL_OK, gathered);
+    EXPECT_EQ(3U * sizeof(double), scores.size);
+    for (size_t i = 0; i < people.size(); i++)
+    {
+        if ((i % 2U) == 0U)
+        {
+            expected[i].scores[1] = column[i / 2U];
+        }
+        EXPECT_EQ(0, std::memcmp(&expected[i], &people[i], sizeof(Person)));
+    }
+    for (size_t i = 0; i < 4U; i++)
+    {
+        EXPECT_EQ(people[i * 2U].scores[0], whole[(i * 3U) + 0U]);
+        EXPECT_EQ(column[i], whole[(i * 3U) + 1U]);
+        EXPECT_EQ(people[i * 2U].scores[2], whole[(i * 3U) + 2U]);
+    }
+}
+
+TEST(ColumnGatherTest, RejectsInvalidArguments)
+{
+    std::vector<Person> people = MakePeople(2); // [準備_異常系] - 記述子より短い要素間隔と、未解決のハンドルを用意する。
+    struct_meta_path_handle id;
+    struct_meta_path_handle empty = {};
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_path_compile(&kPersonDescriptor, "id", &id));
+    int column[2] = {7, 8};
+    int short_stride = struct_meta_gather(&id, people.data(), 2, sizeof(int), column); // [手順_異常系]
+    int no_handle = struct_meta_scatter(&empty, column, 2, 0, people.data());
+    int no_column = struct_meta_gather(&id, people.data(), 2, 0, nullptr);
+    int nothing = struct_meta_gather(&id, nullptr, 0, 0, nullptr);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, short_stride); // [確認_異常系] - 配列と列を変更しないこと。
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, no_handle);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, no_column);
+    EXPECT_EQ(COM_UTIL_OK, nothing);
+    EXPECT_EQ(7, column[0]);
+    EXPECT_EQ(1, people[1].id);
+}
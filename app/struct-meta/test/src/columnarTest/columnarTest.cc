@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <struct_meta/columnar/columnar.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Address
+{
+    char city[8];
+    int zip;
+};
+struct Person
+{
+    int id;
+    unsigned int age;
+    double score;
+    Address home;
+    Address addresses[2];
+    int scores[3];
+};
+const struct_meta_field kAddressFields[] = {
+    {"city", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Address, city), sizeof(char), 1, sizeof(Address::city), nullptr,
+     nullptr, nullptr, 0},
+    {"zip", STRUCT_META_FIELD_INT, 0, offsetof(Address, zip), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kAddressDescriptor = {"Address", sizeof(Address), kAddressFields, 2, nullptr};
+const struct_meta_field kPersonFields[] = {
+    {"id", STRUCT_META_FIELD_INT, 0, offsetof(Person, id), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"age", STRUCT_META_FIELD_UNSIGNED, 0, offsetof(Person, age), sizeof(unsigned int), 1, 0, nullptr, nullptr, nullptr,
+     0},
+    {"score", STRUCT_META_FIELD_DOUBLE, 0, offsetof(Person, score), sizeof(double), 1, 0, nullptr, nullptr, nullptr,
+     0},
+    {"home", STRUCT_META_FIELD_STRUCT, 0, offsetof(Person, home), sizeof(Address), 1, 0, &kAddressDescriptor, nullptr,
+     nullptr, 0},
+    {"addresses", STRUCT_META_FIELD_STRUCT, 0, offsetof(Person, addresses), sizeof(Address), 2, 0,
+     &kAddressDescriptor, nullptr, nullptr, 0},
+    {"scores", STRUCT_META_FIELD_INT, 0, offsetof(Person, scores), sizeof(int), 3, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kPersonDescriptor = {"Person", sizeof(Person), kPersonFields, 6, nullptr};
+
+std::vector<Person> MakePeople(size_t count)
+{
+    std::vector<Person> people(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        Person &person = people[i];
+        std::memset(&person, 0, sizeof(person));
+        person.id = static_cast<int>(i);
+        person.age = static_cast<unsigned int>(i % 90U);
+        person.score = static_cast<double>(i) * 0.25;
+        std::snprintf(person.home.city, sizeof(person.home.city), "h%zu", i % 1000U);
+        person.home.zip = static_cast<int>(i + 1U);
+        person.addresses[1].zip = static_cast<int>(i + 2U);
+        for (size_t j = 0; j < 3U; j++)
+        {
+            person.scores[j] = static_cast<int>((i * 3U) + j);
+        }
+    }
+    return people;
+}
+} // namespace
+
+TEST(ColumnarTest, FlattensNestedAndArrayLeavesIntoColumns)
+{
+    std::vector<Person> people = MakePeople(5); // [準備_正常系] - ネスト構造体、構造体配列、数値配列を含む配列を用意する。
+    struct_meta_columnar block;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_columnar_init(&kPersonDescriptor, people.size(), &block));
+    int ret = struct_meta_columnar_from_rows(&block, people.data(), 0, 1); // [手順_正常系]
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < block.column_count; i++)
+    {
+        paths.push_back(block.columns[i].path);
+    }
+    const struct_meta_columnar_column *zip = nullptr;
+    const struct_meta_columnar_column *city = nullptr;
+    const struct_meta_columnar_column *score = nullptr;
+    const struct_meta_columnar_column *missing = nullptr;
+    int found_zip = struct_meta_columnar_find(&block, "addresses[1].zip", &zip);
+    int found_city = struct_meta_columnar_find(&block, "home.city", &city);
+    int found_score = struct_meta_columnar_find(&block, "scores[2]", &score);
+    int not_found = struct_meta_columnar_find(&block, "scores", &missing);
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 末端の値ごとに、パスの名前を持つ連続した列を作ること。
+    std::vector<std::string> expected = {"id",
+                                         "age",
+                                         "score",
+                                         "home.city",
+                                         "home.zip",
+                                         "addresses[0].city",
+                                         "addresses[0].zip",
+                                         "addresses[1].city",
+                                         "addresses[1].zip",
+                                         "scores[0]",
+                                         "scores[1]",
+                                         "scores[2]"};
+    EXPECT_EQ(expected, paths);
+    EXPECT_EQ(COM_UTIL_OK, found_zip);
+    EXPECT_EQ(COM_UTIL_OK, found_city);
+    EXPECT_EQ(COM_UTIL_OK, found_score);
+    EXPECT_EQ(COM_UTIL_ERR_NOT_FOUND, not_found);
+    ASSERT_NE(nullptr, zip);
+    ASSERT_NE(nullptr, city);
+    ASSERT_NE(nullptr, score);
+    EXPECT_EQ(sizeof(Address::city), city->handle.size);
+    for (size_t i = 0; i < block.column_count; i++)
+    {
+        EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(block.columns[i].data) % STRUCT_META_COLUMNAR_ALIGNMENT);
+    }
+    for (size_t i = 0; i < people.size(); i++)
+    {
+        int value = 0;
+        std::memcpy(&value, zip->data + (i * sizeof(int)), sizeof(int));
+        EXPECT_EQ(people[i].addresses[1].zip, value);
+        std::memcpy(&value, score->data + (i * sizeof(int)), sizeof(int));
+        EXPECT_EQ(people[i].scores[2], value);
+        EXPECT_STREQ(people[i].home.city, reinterpret_cast<const char *>(city->data + (i * sizeof(Address::city))));
+    }
+    struct_meta_columnar_dispose(&block);
+    EXPECT_EQ(nullptr, block.columns);
+}
+
+TEST(ColumnarTest, RoundTripsInParallelWithStride)
+{
+    struct Wrapped // [準備_正常系] - 要素間隔が記述子より大きい配列と、複数スレッドで分割される行数を用意する。
+    {
+        Person person;
+        double extra;
+    };
+    std::vector<Person> people = MakePeople(5000);
+    std::vector<Wrapped> source(people.size());
+    std::vector<Wrapped> restored(people.size());
+    std::memset(source.data(), 0, source.size() * sizeof(Wrapped));
+    std::memset(restored.data(), 0, restored.size() * sizeof(Wrapped));
+    for (size_t i = 0; i < people.size(); i++)
+    {
+        source[i].person = people[i];
+        source[i].extra = -1.0;
+    }
+    struct_meta_columnar serial;
+    struct_meta_columnar parallel;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_columnar_init(&kPersonDescriptor, people.size(), &serial));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_columnar_init(&kPersonDescriptor, people.size(), &parallel));
+    int from_serial = struct_meta_columnar_from_rows(&serial, source.data(), sizeof(Wrapped), 1); // [手順_正常系]
+    int from_parallel = struct_meta_columnar_from_rows(&parallel, source.data(), sizeof(Wrapped), 4);
+    int to_rows = struct_meta_columnar_to_rows(&parallel, restored.data(), sizeof(Wrapped), 4);
+    EXPECT_EQ(COM_UTIL_OK, from_serial); // [確認_正常系] - スレッド数に関わらず同じ列となり、書き戻すと元のフィールド値になること。
+    EXPECT_EQ(COM_UTIL_OK, from_parallel);
+    EXPECT_EQ(COM_UTIL_OK, to_rows);
+    ASSERT_EQ(serial.column_count, parallel.column_count);
+    for (size_t i = 0; i < serial.column_count; i++)
+    {
+        EXPECT_EQ(0, std::memcmp(serial.columns[i].data, parallel.columns[i].data,
+                                 serial.columns[i].handle.size * people.size()))
+            << serial.columns[i].path;
+    }
+    for (size_t i = 0; i < people.size(); i++)
+    {
+        ASSERT_EQ(0, std::memcmp(&source[i].person, &restored[i].person, sizeof(Person))) << i;
+        ASSERT_EQ(0.0, restored[i].extra);
+    }
+    struct_meta_columnar_dispose(&serial);
+    struct_meta_columnar_dispose(&parallel);
+}
+
+TEST(ColumnarTest, RejectsInvalidArguments)
+{
+    std::vector<Person> people = MakePeople(2); // [準備_異常系] - 記述子より短い要素間隔と、初期化していないブロックを用意する。
+    struct_meta_columnar block;
+    struct_meta_columnar empty = {};
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_columnar_init(&kPersonDescriptor, people.size(), &block));
+    int short_stride = struct_meta_columnar_from_rows(&block, people.data(), sizeof(int), 1); // [手順_異常系]
+    int no_rows = struct_meta_columnar_to_rows(&block, nullptr, 0, 1);
+    int no_block = struct_meta_columnar_from_rows(&empty, people.data(), 0, 1);
+    int no_descriptor = struct_meta_columnar_init(nullptr, 1, &empty);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, short_stride); // [確認_異常系] - いずれも列と配列を変更しないこと。
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, no_rows);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, no_block);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, no_descriptor);
+    EXPECT_EQ(0, block.columns[0].data[0]);
+    struct_meta_columnar_dispose(&block);
+}
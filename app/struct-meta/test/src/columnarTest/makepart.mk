@@ -0,0 +1,17 @@
+# テスト対象のソース ファイル
+TEST_SRCS := \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/columnar/columnar.c
+
+ADD_SRCS += \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/access/access.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/access/column.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/access/leaf.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/access/path.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/base/parallel.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/memory/arena.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/memory/buffer.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/name_index.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/registry.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/validate.c
+
+LIBS += com_util
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <struct_meta/delta/delta.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Address
+{
+    char city[8];
+    int zip;
+};
+struct Person
+{
+    int id;
+    unsigned int age;
+    double score;
+    Address home;
+    Address addresses[2];
+    int scores[3];
+};
+const struct_meta_field kAddressFields[] = {
+    {"city", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Address, city), sizeof(char), 1, sizeof(Address::city), nullptr,
+     nullptr, nullptr, 0},
+    {"zip", STRUCT_META_FIELD_INT, 0, offsetof(Address, zip), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kAddressDescriptor = {"Address", sizeof(Address), kAddressFields, 2, nullptr};
+const struct_meta_field kPersonFields[] = {
+    {"id", STRUCT_META_FIELD_INT, 0, offsetof(Person, id), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"age", STRUCT_META_FIELD_UNSIGNED, 0, offsetof(Person, age), sizeof(unsigned int), 1, 0, nullptr, nullptr, nullptr,
+     0},
+    {"score", STRUCT_META_FIELD_DOUBLE, 0, offsetof(Person, score), sizeof(double), 1, 0, nullptr, nullptr, nullptr,
+     0},
+    {"home", STRUCT_META_FIELD_STRUCT, 0, offsetof(Person, home), sizeof(Address), 1, 0, &kAddressDescriptor, nullptr,
+     nullptr, 0},
+    {"addresses", STRUCT_META_FIELD_STRUCT, 0, offsetof(Person, addresses), sizeof(Address), 2, 0,
+     &kAddressDescriptor, nullptr, nullptr, 0},
+    {"scores", STRUCT_META_FIELD_INT, 0, offsetof(Person, scores), sizeof(int), 3, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kPersonDescriptor = {"Person", sizeof(Person), kPersonFields, 6, nullptr};
+
+Person MakePerson()
+{
+    Person person;
+    std::memset(&person, 0, sizeof(person));
+    person.id = 7;
+    person.age = 30U;
+    person.score = 1.5;
+    std::strcpy(person.home.city, "tokyo");
+    person.home.zip = 100;
+    std::strcpy(person.addresses[0].city, "osaka");
+    person.addresses[0].zip = 530;
+    std::strcpy(person.addresses[1].city, "nagoya");
+    person.addresses[1].zip = 450;
+    person.scores[0] = 1;
+    person.scores[1] = 2;
+    person.scores[2] = 3;
+    return person;
+}
+} // namespace
+
+TEST(DeltaTest, RecordsChangedLeavesAndAppliesThem)
+{
+    Person before = MakePerson(); // [準備_正常系] - スカラー、ネスト構造体の文字列、構造体配列の要素、数値配列の要素を変更する。
+    Person after = before;
+    after.age = 31U;
+    std::strcpy(after.home.city, "kyoto");
+    after.addresses[1].zip = 451;
+    after.scores[2] = 30;
+    after.addresses[0].city[7] = 'x'; // 文字列の終端より後ろのバイトだけの違いは差分としない。
+    struct_meta_delta delta;
+    int ret = struct_meta_diff(&kPersonDescriptor, &before, &after, &delta); // [手順_正常系]
+    Person target = before;
+    int applied = struct_meta_delta_apply(&kPersonDescriptor, &delta, &target);
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 変更された末端の値だけが記述子の順に並び、適用すると変更後の値になること。
+    EXPECT_EQ(COM_UTIL_OK, applied);
+    EXPECT_EQ(&kPersonDescriptor, delta.descriptor);
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < delta.count; i++)
+    {
+        paths.push_back(delta.entries[i].path);
+        EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(delta.entries[i].value) % 8U);
+    }
+    std::vector<std::string> expected = {"age", "home.city", "addresses[1].zip", "scores[2]"};
+    EXPECT_EQ(expected, paths);
+    ASSERT_EQ(4U, delta.count);
+    EXPECT_EQ(STRUCT_META_FIELD_CHAR_ARRAY, delta.entries[1].kind);
+    EXPECT_EQ(sizeof("kyoto"), delta.entries[1].size);
+    EXPECT_STREQ("kyoto", static_cast<const char *>(delta.entries[1].value));
+    EXPECT_EQ(after.age, target.age);
+    EXPECT_STREQ(after.home.city, target.home.city);
+    EXPECT_EQ(after.addresses[1].zip, target.addresses[1].zip);
+    EXPECT_EQ(after.scores[2], target.scores[2]);
+    EXPECT_EQ(before.addresses[0].city[7], target.addresses[0].city[7]);
+    struct_meta_delta_dispose(&delta);
+    EXPECT_EQ(nullptr, delta.entries);
+    EXPECT_EQ(0U, delta.count);
+}
+
+TEST(DeltaTest, ReturnsEmptyDeltaForEqualInstances)
+{
+    Person before = MakePerson(); // [準備_正常系] - 同じ値の 2 個の構造体を用意する。
+    Person after = before;
+    struct_meta_delta delta;
+    int ret = struct_meta_diff(&kPersonDescriptor, &before, &after, &delta); // [手順_正常系]
+    int applied = struct_meta_delta_apply(&kPersonDescriptor, &delta, &after);
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 領域を確保しない要素数 0 の差分となり、適用しても変わらないこと。
+    EXPECT_EQ(COM_UTIL_OK, applied);
+    EXPECT_EQ(0U, delta.count);
+    EXPECT_EQ(nullptr, delta.entries);
+    EXPECT_EQ(nullptr, delta.storage);
+    EXPECT_EQ(0, std::memcmp(&before, &after, sizeof(Person)));
+    struct_meta_delta_dispose(&delta);
+}
+
+TEST(DeltaTest, RejectsInvalidEntriesWithoutPartialWrites)
+{
+    Person person = MakePerson(); // [準備_異常系] - 正しい変更の後ろに、種別やバイト数の合わない変更を並べる。
+    int zip = 999;
+    int wide[2] = {1, 2};
+    char city[] = "toolongcity";
+    struct_meta_delta_entry good = {"home.zip", &zip, sizeof(zip), STRUCT_META_FIELD_INT, 0U};
+    struct_meta_delta_entry wrong_kind[] = {good, {"age", &zip, sizeof(zip), STRUCT_META_FIELD_INT, 0U}};
+    struct_meta_delta_entry wrong_size[] = {good, {"scores[1]", wide, sizeof(wide), STRUCT_META_FIELD_INT, 0U}};
+    struct_meta_delta_entry too_long[] = {good, {"home.city", city, sizeof(city), STRUCT_META_FIELD_CHAR_ARRAY, 0U}};
+    struct_meta_delta_entry unknown[] = {good, {"home.street", &zip, sizeof(zip), STRUCT_META_FIELD_INT, 0U}};
+    struct_meta_delta delta = {&kPersonDescriptor, 2U, wrong_kind, nullptr};
+    struct_meta_delta result;
+    Person original = person;
+    int kind_ret = struct_meta_delta_apply(&kPersonDescriptor, &delta, &person); // [手順_異常系]
+    delta.entries = wrong_size;
+    int size_ret = struct_meta_delta_apply(&kPersonDescriptor, &delta, &person);
+    delta.entries = too_long;
+    int long_ret = struct_meta_delta_apply(&kPersonDescriptor, &delta, &person);
+    delta.entries = unknown;
+    int unknown_ret = struct_meta_delta_apply(&kPersonDescriptor, &delta, &person);
+    int no_instance = struct_meta_diff(&kPersonDescriptor, &person, nullptr, &result);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, kind_ret); // [確認_異常系] - いずれも失敗し、構造体を変更しないこと。
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, size_ret);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, long_ret);
+    EXPECT_EQ(COM_UTIL_ERR_NOT_FOUND, unknown_ret);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, no_instance);
+    EXPECT_EQ(nullptr, result.entries);
+    EXPECT_EQ(0, std::memcmp(&original, &person, sizeof(Person)));
+}
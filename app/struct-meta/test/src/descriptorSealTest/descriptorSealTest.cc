@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <struct_meta/access/access.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct Inner
+{
+    int value;
+};
+struct Outer
+{
+    int id;
+    Inner inner;
+};
+const struct_meta_field kInnerFields[] = {
+    {"value", STRUCT_META_FIELD_INT, 0, offsetof(Inner, value), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kInnerDescriptor = {"Inner", sizeof(Inner), kInnerFields, 1, nullptr};
+const struct_meta_field kOuterFields[] = {
+    {"id", STRUCT_META_FIELD_INT, 0, offsetof(Outer, id), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"inner", STRUCT_META_FIELD_STRUCT, 0, offsetof(Outer, inner), sizeof(Inner), 1, 0, &kInnerDescriptor, nullptr,
+     nullptr, 0},
+};
+const struct_meta_descriptor kOuterDescriptor = {"Outer", sizeof(Outer), kOuterFields, 2, nullptr};
+const struct_meta_field kCorruptFields[] = {
+    {"inner", STRUCT_META_FIELD_STRUCT, 0, 0, sizeof(Inner) + 1U, 1, 0, &kInnerDescriptor, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kCorruptDescriptor = {"Corrupt", sizeof(Inner) + 1U, kCorruptFields, 1, nullptr};
+} // namespace
+
+TEST(DescriptorSealTest, SealsDescriptorAndNestedDescriptor)
+{
+    const struct_meta_field *field = nullptr; // [準備_正常系] - ネストを含む正しい記述子を用意する。
+    int first = struct_meta_descriptor_seal(&kOuterDescriptor); // [手順_正常系]
+    int second = struct_meta_descriptor_seal(&kOuterDescriptor);
+    int nested = struct_meta_descriptor_find_field(&kInnerDescriptor, "value", &field);
+    EXPECT_EQ(COM_UTIL_OK, first); // [確認_正常系] - 登録済みの再登録とネスト先の利用が成功すること。
+    EXPECT_EQ(COM_UTIL_OK, second);
+    EXPECT_EQ(COM_UTIL_OK, nested);
+    EXPECT_EQ(&kInnerFields[0], field);
+}
+
+TEST(DescriptorSealTest, KeepsReportingCorruptDescriptor)
+{
+    const struct_meta_field *field = nullptr; // [準備_異常系] - ネスト先とサイズが一致しない記述子を用意する。
+    int first = struct_meta_descriptor_seal(&kCorruptDescriptor); // [手順_異常系]
+    int second = struct_meta_descriptor_find_field(&kCorruptDescriptor, "inner", &field);
+    EXPECT_EQ(COM_UTIL_ERR_CORRUPT_DESCRIPTOR, first); // [確認_異常系] - 不正な記述子を登録せず、毎回報告すること。
+    EXPECT_EQ(COM_UTIL_ERR_CORRUPT_DESCRIPTOR, second);
+    EXPECT_EQ(nullptr, field);
+}
+
+TEST(DescriptorSealTest, SealsConcurrently)
+{
+    std::vector<std::thread> threads; // [準備_正常系] - 同じ記述子を複数スレッドから利用する。
+    std::vector<int> results(8, COM_UTIL_ERR_UNKNOWN);
+    for (size_t i = 0; i < results.size(); i++) // [手順_正常系]
+    {
+        threads.emplace_back([&results, i]() {
+            const struct_meta_field *field = nullptr;
+            results[i] = struct_meta_descriptor_find_field(&kOuterDescriptor, "inner", &field);
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    for (int result : results)
+    {
+        EXPECT_EQ(COM_UTIL_OK, result); // [確認_正常系] - 並行登録がすべて成功すること。
+    }
+}
+
+TEST(DescriptorSealTest, UnregistersSoChangedDescriptorIsValidatedAgain)
+{
+    struct_meta_field fields[] = { // [準備_正常系] - 動的に作った記述子を登録する。
+        {"value", STRUCT_META_FIELD_INT, 0, offsetof(Inner, value), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    };
+    struct_meta_descriptor descriptor = {"Dynamic", sizeof(Inner), fields, 1, nullptr};
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_descriptor_seal(&descriptor));
+    int removed = struct_meta_descriptor_unregister(&descriptor); // [手順_正常系] - 削除してからフィールドを壊す。
+    fields[0].offset = sizeof(Inner);
+    int resealed = struct_meta_descriptor_seal(&descriptor);
+    int removed_again = struct_meta_descriptor_unregister(&descriptor);
+    EXPECT_EQ(COM_UTIL_OK, removed); // [確認_正常系] - 削除後は再検査され、壊れた記述子を報告すること。
+    EXPECT_EQ(COM_UTIL_ERR_CORRUPT_DESCRIPTOR, resealed);
+    EXPECT_EQ(COM_UTIL_SKIPPED, removed_again); // [確認_正常系] - 登録されていない記述子の削除は SKIPPED となること。
+}
+
+TEST(DescriptorSealTest, ReusesRemovedSlotsBeyondCapacity)
+{
+    // [準備_正常系] - 登録数の上限より多くの記述子を、登録と削除を繰り返して使う。
+    constexpr size_t kCount = 3U * 4096U;
+    std::unique_ptr<struct_meta_descriptor[]> descriptors(new struct_meta_descriptor[kCount]);
+    size_t failures = 0U;
+    for (size_t i = 0; i < kCount; i++) // [手順_正常系]
+    {
+        descriptors[i] = {"Churn", sizeof(Inner), kInnerFields, 1, nullptr};
+        if ((struct_meta_descriptor_seal(&descriptors[i]) != COM_UTIL_OK) ||
+            (struct_meta_descriptor_unregister(&descriptors[i]) != COM_UTIL_OK))
+        {
+            failures++;
+        }
+    }
+    EXPECT_EQ(0U, failures); // [確認_正常系] - 削除した枠が再利用され、すべて登録と削除に成功すること。
+}
+
+TEST(DescriptorSealTest, RejectsNullOnUnregister)
+{
+    int ret = struct_meta_descriptor_unregister(nullptr); // [手順_異常系] - NULL を渡す。
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, ret);         // [確認_異常系] - 引数エラーとなること。
+}
@@ -0,0 +1,355 @@
+#include <gtest/gtest.h>
+#include <struct_meta/access/access.h>
+#include <struct_meta/binary/binary.h>
+#include <struct_meta/json/file.h>
+#include <struct_meta/json/json.h>
+#include <struct_meta/json/ndjson.h>
+#include <struct_meta/json/reader.h>
+#include <struct_meta/memory/arena.h>
+#include <com_util/base/result.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Point
+{
+    int x;
+    int y;
+};
+struct Record
+{
+    char *name;
+    STRUCT_META_SEQUENCE(int) values;
+    STRUCT_META_SEQUENCE(char *) tags;
+    STRUCT_META_SEQUENCE(Point) points;
+    int id;
+};
+const struct_meta_field kPointFields[] = {
+    {"x", STRUCT_META_FIELD_INT, STRUCT_META_STORAGE_INLINE, offsetof(Point, x), sizeof(int), 1, 0, nullptr, nullptr,
+     nullptr, 0},
+    {"y", STRUCT_META_FIELD_INT, STRUCT_META_STORAGE_INLINE, offsetof(Point, y), sizeof(int), 1, 0, nullptr, nullptr,
+     nullptr, 0},
+};
+const struct_meta_descriptor kPointDescriptor = {"Point", sizeof(Point), kPointFields, 2, nullptr};
+const struct_meta_field kRecordFields[] = {
+    {"name", STRUCT_META_FIELD_STRING, STRUCT_META_STORAGE_INLINE, offsetof(Record, name), sizeof(char *), 1, 0,
+     nullptr, nullptr, nullptr, 0},
+    {"values", STRUCT_META_FIELD_INT, STRUCT_META_STORAGE_SEQUENCE, offsetof(Record, values), sizeof(int), 1, 0,
+     nullptr, nullptr, nullptr, 0},
+    {"tags", STRUCT_META_FIELD_STRING, STRUCT_META_STORAGE_SEQUENCE, offsetof(Record, tags), sizeof(char *), 1, 0,
+     nullptr, nullptr, nullptr, 0},
+    {"points", STRUCT_META_FIELD_STRUCT, STRUCT_META_STORAGE_SEQUENCE, offsetof(Record, points), sizeof(Point), 1, 0,
+     &kPointDescriptor, nullptr, nullptr, 0},
+    {"id", STRUCT_META_FIELD_INT, STRUCT_META_STORAGE_INLINE, offsetof(Record, id), sizeof(int), 1, 0, nullptr,
+     nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kRecordDescriptor = {"Record", sizeof(Record), kRecordFields, 5, nullptr};
+/* char 配列を要素とする可変長配列の記述子。 */
+const struct_meta_field kCharSequenceFields[] = {
+    {"values", STRUCT_META_FIELD_CHAR_ARRAY, STRUCT_META_STORAGE_SEQUENCE, offsetof(Record, values), sizeof(char), 1,
+     8, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kCharSequenceDescriptor = {"CharSequence", sizeof(Record), kCharSequenceFields, 1,
+                                                        nullptr};
+/* 可変長配列に固定長配列の要素数を指定した記述子。 */
+const struct_meta_field kCountedSequenceFields[] = {
+    {"values", STRUCT_META_FIELD_INT, STRUCT_META_STORAGE_SEQUENCE, offsetof(Record, values), sizeof(int), 2, 0,
+     nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kCountedSequenceDescriptor = {"CountedSequence", sizeof(Record), kCountedSequenceFields,
+                                                           1, nullptr};
+/* 文字列の要素サイズがポインターの幅と一致しない記述子。 */
+const struct_meta_field kNarrowStringFields[] = {
+    {"name", STRUCT_META_FIELD_STRING, STRUCT_META_STORAGE_INLINE, offsetof(Record, name), sizeof(char), 1, 0,
+     nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kNarrowStringDescriptor = {"NarrowString", sizeof(Record), kNarrowStringFields, 1,
+                                                        nullptr};
+
+const char kRecordJson[] = "{\"name\":\"alpha\",\"values\":[1,2,3],\"tags\":[\"a\",\"bc\"],"
+                           "\"points\":[{\"x\":1,\"y\":2},{\"x\":3,\"y\":4}],\"id\":7}";
+
+/* 確保したバイト数を記録し、malloc() と free() へ委ねるアロケーター。 */
+struct Recorder
+{
+    std::vector<size_t> sizes;
+    size_t released;
+};
+
+void *RecordAllocate(void *context, size_t size)
+{
+    static_cast<Recorder *>(context)->sizes.push_back(size);
+    return std::malloc((size > 0U) ? size : 1U);
+}
+
+void RecordRelease(void *context, void *data)
+{
+    static_cast<Recorder *>(context)->released++;
+    std::free(data);
+}
+
+int Decode(const char *text, Record *record, const struct_meta_allocator *allocator)
+{
+    cJSON *json = cJSON_Parse(text);
+    if (json == nullptr)
+    {
+        return COM_UTIL_ERR_UNKNOWN;
+    }
+    int ret = struct_meta_json_decode_alloc(&kRecordDescriptor, json, record, allocator);
+    cJSON_Delete(json);
+    return ret;
+}
+
+int DecodeText(const char *text, Record *record, const struct_meta_allocator *allocator)
+{
+    struct_meta_json_reader reader;
+    int ret = struct_meta_json_reader_init_text(&reader, text, std::strlen(text));
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_json_reader_use_allocator(&reader, allocator);
+    }
+    if (ret == COM_UTIL_OK)
+    {
+        ret = struct_meta_json_reader_value(&reader, &kRecordDescriptor, record);
+    }
+    struct_meta_json_reader_dispose(&reader);
+    return ret;
+}
+
+std::string WriteTempFile(const char *name, const char *text)
+{
+    std::string path = testing::TempDir() + name;
+    FILE *stream = std::fopen(path.c_str(), "wb");
+    if (stream != nullptr)
+    {
+        std::fputs(text, stream);
+        std::fclose(stream);
+    }
+    return path;
+}
+} // namespace
+
+TEST(DynamicFieldTest, DecodesWithExactAllocationSizes)
+{
+    Recorder recorder{{}, 0U}; // [準備_正常系] - 確保サイズを記録するアロケーターを用意する。
+    struct_meta_allocator allocator = {RecordAllocate, RecordRelease, &recorder};
+    Record record = {};
+    int ret = Decode(kRecordJson, &record, &allocator); // [手順_正常系]
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 値の長さちょうどの領域へ書き戻すこと。
+    EXPECT_STREQ("alpha", record.name);
+    ASSERT_EQ(3U, record.values.count);
+    EXPECT_EQ(3, record.values.items[2]);
+    ASSERT_EQ(2U, record.tags.count);
+    EXPECT_STREQ("bc", record.tags.items[1]);
+    ASSERT_EQ(2U, record.points.count);
+    EXPECT_EQ(4, record.points.items[1].y);
+    EXPECT_EQ(7, record.id);
+    std::vector<size_t> expected = {6U, 3U * sizeof(int), 2U * sizeof(char *), 2U, 3U, 2U * sizeof(Point)};
+    EXPECT_EQ(expected, recorder.sizes);
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_instance_release(&kRecordDescriptor, &record, &allocator));
+    EXPECT_EQ(recorder.sizes.size(), recorder.released);
+    EXPECT_EQ(nullptr, record.name);
+    EXPECT_EQ(nullptr, record.values.items);
+    EXPECT_EQ(0U, record.values.count);
+    EXPECT_EQ(7, record.id);
+}
+
+TEST(DynamicFieldTest, ReplacesExistingValuesAndMapsNull)
+{
+    Recorder recorder{{}, 0U}; // [準備_正常系] - 動的フィールドに値を持つ構造体を用意する。
+    struct_meta_allocator allocator = {RecordAllocate, RecordRelease, &recorder};
+    Record record = {};
+    ASSERT_EQ(COM_UTIL_OK, Decode(kRecordJson, &record, &allocator));
+    size_t allocated = recorder.sizes.size();
+    const char *replacement = "{\"name\":null,\"values\":[9],\"tags\":null,\"points\":[]}";
+    int ret = Decode(replacement, &record, &allocator); // [手順_正常系]
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 古い領域を解放し、null は値なしとすること。
+    EXPECT_EQ(nullptr, record.name);
+    ASSERT_EQ(1U, record.values.count);
+    EXPECT_EQ(9, record.values.items[0]);
+    EXPECT_EQ(nullptr, record.tags.items);
+    EXPECT_EQ(0U, record.tags.count);
+    EXPECT_EQ(nullptr, record.points.items);
+    EXPECT_EQ(0U, record.points.count);
+    EXPECT_EQ(allocated + 1U, recorder.sizes.size());
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_instance_release(&kRecordDescriptor, &record, &allocator));
+    EXPECT_EQ(recorder.sizes.size(), recorder.released);
+}
+
+TEST(DynamicFieldTest, DecodesIntoArena)
+{
+    struct_meta_arena arena; // [準備_正常系] - アリーナから切り出すアロケーターを用意する。
+    struct_meta_arena_init(&arena, 0U);
+    struct_meta_allocator allocator;
+    struct_meta_arena_allocator(&arena, &allocator);
+    Record record = {};
+    int ret = Decode(kRecordJson, &record, &allocator); // [手順_正常系]
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - アリーナの領域へ書き戻し、解放は何もしないこと。
+    EXPECT_STREQ("alpha", record.name);
+    EXPECT_STREQ("a", record.tags.items[0]);
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_instance_release(&kRecordDescriptor, &record, &allocator));
+    EXPECT_EQ(nullptr, record.name);
+    struct_meta_arena_dispose(&arena);
+}
+
+TEST(DynamicFieldTest, EncodeRoundTrips)
+{
+    Record source = {}; // [準備_正常系] - 既定のアロケーターで書き戻した構造体を用意する。
+    ASSERT_EQ(COM_UTIL_OK, Decode(kRecordJson, &source, nullptr));
+    cJSON *json = nullptr;
+    int encoded = struct_meta_json_encode(&kRecordDescriptor, &source, &json); // [手順_正常系]
+    Record actual = {};
+    int decoded = struct_meta_json_decode(&kRecordDescriptor, json, &actual);
+    EXPECT_EQ(COM_UTIL_OK, encoded); // [確認_正常系] - 要素数どおりの配列と文字列を書き出し、同じ値へ戻ること。
+    EXPECT_EQ(COM_UTIL_OK, decoded);
+    EXPECT_EQ(3, cJSON_GetArraySize(cJSON_GetObjectItemCaseSensitive(json, "values")));
+    EXPECT_STREQ("alpha", actual.name);
+    ASSERT_EQ(2U, actual.tags.count);
+    EXPECT_STREQ("bc", actual.tags.items[1]);
+    ASSERT_EQ(2U, actual.points.count);
+    EXPECT_EQ(3, actual.points.items[1].x);
+    cJSON_Delete(json);
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_instance_release(&kRecordDescriptor, &source, nullptr));
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_instance_release(&kRecordDescriptor, &actual, nullptr));
+}
+
+TEST(DynamicFieldTest, PathAndElementAccessAreBoundedByCount)
+{
+    Record record = {}; // [準備_正常系] - 要素数 2 の可変長配列を持つ構造体を用意する。
+    ASSERT_EQ(COM_UTIL_OK, Decode(kRecordJson, &record, nullptr));
+    const struct_meta_field *field = nullptr;
+    void *value = nullptr;
+    int inside = struct_meta_path_resolve(&kRecordDescriptor, &record, "points[1].x", &field, &value); // [手順_正常系]
+    void *outside_value = nullptr;
+    int outside = struct_meta_path_resolve(&kRecordDescriptor, &record, "points[2].x", &field, &outside_value);
+    void *element = nullptr;
+    int element_ret = struct_meta_field_get_element(&kRecordFields[1], &record, 2U, &element);
+    void *beyond_element = nullptr;
+    int beyond = struct_meta_field_get_element(&kRecordFields[1], &record, 3U, &beyond_element);
+    struct_meta_path_handle handle;
+    int compiled = struct_meta_path_compile(&kRecordDescriptor, "values[0]", &handle);
+    EXPECT_EQ(COM_UTIL_OK, inside); // [確認_正常系] - items の要素を指し、count 以上の添字は範囲外とすること。
+    EXPECT_EQ(static_cast<void *>(&record.points.items[1].x), value);
+    EXPECT_EQ(COM_UTIL_ERR_OUT_OF_RANGE, outside);
+    EXPECT_EQ(COM_UTIL_OK, element_ret);
+    EXPECT_EQ(static_cast<void *>(&record.values.items[2]), element);
+    EXPECT_EQ(COM_UTIL_ERR_OUT_OF_RANGE, beyond);
+    EXPECT_EQ(COM_UTIL_ERR_UNSUPPORTED, compiled);
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_instance_release(&kRecordDescriptor, &record, nullptr));
+}
+
+TEST(DynamicFieldTest, ByteOrientedModesRejectDynamicFields)
+{
+    Record record = {}; // [準備_異常系] - 動的フィールドを持つ構造体と、その JSON を用意する。
+    cJSON *json = cJSON_Parse(kRecordJson);
+    ASSERT_NE(nullptr, json);
+    struct_meta_buffer undo;
+    struct_meta_buffer_init(&undo);
+    int atomic = struct_meta_json_decode_atomic(&kRecordDescriptor, json, &record, &undo); // [手順_異常系]
+    size_t size = 0U;
+    int binary = struct_meta_binary_encoded_size(&kRecordDescriptor, &size);
+    EXPECT_EQ(COM_UTIL_ERR_UNSUPPORTED, atomic); // [確認_異常系] - 元に戻せない書き戻しとバイト列の変換は拒否すること。
+    EXPECT_EQ(nullptr, record.name);
+    EXPECT_EQ(COM_UTIL_ERR_UNSUPPORTED, binary);
+    struct_meta_buffer_dispose(&undo);
+    cJSON_Delete(json);
+}
+
+TEST(DynamicFieldTest, ValidateRejectsMalformedSequences)
+{
+    // [準備_異常系] - char 配列の要素、要素数 2、ポインター幅でない文字列の記述子を用意する。
+    int char_sequence = struct_meta_descriptor_validate(&kCharSequenceDescriptor); // [手順_異常系]
+    int counted = struct_meta_descriptor_validate(&kCountedSequenceDescriptor);
+    int narrow = struct_meta_descriptor_validate(&kNarrowStringDescriptor);
+    EXPECT_EQ(COM_UTIL_ERR_CORRUPT_DESCRIPTOR, char_sequence); // [確認_異常系] - 不正な動的フィールドを検出すること。
+    EXPECT_EQ(COM_UTIL_ERR_CORRUPT_DESCRIPTOR, counted);
+    EXPECT_EQ(COM_UTIL_ERR_CORRUPT_DESCRIPTOR, narrow);
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_descriptor_validate(&kRecordDescriptor));
+}
+
+TEST(DynamicFieldTest, StreamingReaderDecodesLikeDom)
+{
+    Recorder recorder{{}, 0U}; // [準備_正常系] - 確保を数えるアロケーターと長い配列を用意する。
+    struct_meta_allocator allocator = {RecordAllocate, RecordRelease, &recorder};
+    const char many[] = "{\"values\":[1,2,3,4,5,6,7,8,9],\"tags\":[\"x\\u0000y\"]}";
+    Record record = {};
+    int first = DecodeText(kRecordJson, &record, &allocator); // [手順_正常系]
+    ASSERT_EQ(COM_UTIL_OK, first);
+    int first_y = record.points.items[1].y;
+    size_t first_points = record.points.count;
+    int second = DecodeText(many, &record, &allocator);
+    EXPECT_EQ(4, first_y); // [確認_正常系] - DOM 経由と同じ値を書き込むこと。
+    EXPECT_EQ(2U, first_points);
+    EXPECT_EQ(COM_UTIL_OK, second);
+    EXPECT_STREQ("alpha", record.name);
+    ASSERT_EQ(9U, record.values.count);
+    EXPECT_EQ(9, record.values.items[8]);
+    ASSERT_EQ(1U, record.tags.count);
+    EXPECT_STREQ("x", record.tags.items[0]);
+    EXPECT_NE(recorder.sizes.end(), std::find(recorder.sizes.begin(), recorder.sizes.end(), 9U * sizeof(int)));
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_instance_release(&kRecordDescriptor, &record, &allocator));
+    EXPECT_EQ(recorder.sizes.size(), recorder.released);
+}
+
+TEST(DynamicFieldTest, StreamingLoadsReleaseReplacedValuesOnlyOnSuccess)
+{
+    Record record = {}; // [準備_異常系] - 動的フィールドに値を持つ構造体を用意する。
+    ASSERT_EQ(COM_UTIL_OK, Decode(kRecordJson, &record, nullptr));
+    Record original = record;
+    std::string broken = WriteTempFile("dynamic_broken.json", "{\"name\":\"beta\",\"tags\":[\"c\"],\"values\":[4,");
+    std::string valid = WriteTempFile("dynamic_valid.json", "{\"name\":\"beta\",\"points\":[{\"x\":5,\"y\":6}]}");
+    const char text[] = "{\"tags\":[\"d\"],\"name\":\"gamma\",\"id\":\"x\"}";
+    int broken_ret = struct_meta_json_file_load(&kRecordDescriptor, broken.c_str(), &record); // [手順_異常系]
+    int atomic_ret = struct_meta_json_decode_text_atomic(&kRecordDescriptor, text, sizeof(text) - 1U, &record, nullptr);
+    bool unchanged = std::memcmp(&original, &record, sizeof(Record)) == 0;
+    int valid_ret = struct_meta_json_file_load(&kRecordDescriptor, valid.c_str(), &record);
+    void *current = &record;
+    Record shadow_record = {};
+    void *shadow = &shadow_record;
+    int swap_ret = struct_meta_json_decode_text_swap(&kRecordDescriptor, "{}", 2U, &current, &shadow);
+    std::remove(broken.c_str());
+    std::remove(valid.c_str());
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, broken_ret); // [確認_異常系] - 元の値へ戻ること。
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, atomic_ret);
+    EXPECT_TRUE(unchanged);
+    EXPECT_EQ(COM_UTIL_OK, valid_ret);
+    EXPECT_STREQ("beta", record.name);
+    ASSERT_EQ(1U, record.points.count);
+    EXPECT_EQ(6, record.points.items[0].y);
+    ASSERT_EQ(2U, record.tags.count);
+    EXPECT_STREQ("bc", record.tags.items[1]);
+    EXPECT_EQ(COM_UTIL_ERR_UNSUPPORTED, swap_ret);
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_instance_release(&kRecordDescriptor, &record, nullptr));
+}
+
+TEST(DynamicFieldTest, NdjsonRecordsOwnTheirDynamicValues)
+{
+    // [準備_正常系] - 文字列と可変長配列を含む 2 行を用意する。
+    const char lines[] = "{\"name\":\"one\",\"values\":[1]}\n{\"name\":\"two\",\"tags\":[\"t\"]}\n";
+    FILE *stream = std::tmpfile();
+    ASSERT_NE(nullptr, stream);
+    std::fputs(lines, stream);
+    std::rewind(stream);
+    struct_meta_ndjson_reader reader;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_ndjson_reader_init(&reader, stream, 0U));
+    Record records[2];
+    int first = struct_meta_ndjson_reader_next(&reader, &kRecordDescriptor, &records[0]); // [手順_正常系]
+    int second = struct_meta_ndjson_reader_next(&reader, &kRecordDescriptor, &records[1]);
+    struct_meta_ndjson_reader_dispose(&reader);
+    std::fclose(stream);
+    EXPECT_EQ(COM_UTIL_OK, first); // [確認_正常系] - 各行の値を malloc() で確保した領域へ書き込むこと。
+    EXPECT_EQ(COM_UTIL_OK, second);
+    EXPECT_STREQ("one", records[0].name);
+    ASSERT_EQ(1U, records[0].values.count);
+    EXPECT_STREQ("two", records[1].name);
+    ASSERT_EQ(1U, records[1].tags.count);
+    EXPECT_STREQ("t", records[1].tags.items[0]);
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_instance_release(&kRecordDescriptor, &records[0], nullptr));
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_instance_release(&kRecordDescriptor, &records[1], nullptr));
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <struct_meta/access/access.h>
+#include <struct_meta/meta/name_index.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <cstring>
+
+namespace
+{
+struct Leaf
+{
+    int value;
+};
+struct Wide
+{
+    int f0;
+    int f1;
+    int f2;
+    int f3;
+    int f4;
+    int f5;
+    int f6;
+    int f7;
+    int f8;
+    Leaf leaf[2];
+};
+const struct_meta_field kLeafFields[] = {
+    {"value", STRUCT_META_FIELD_INT, 0, offsetof(Leaf, value), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kLeafDescriptor = {"Leaf", sizeof(Leaf), kLeafFields, 1, nullptr};
+const struct_meta_field kWideFields[] = {
+    {"f0", STRUCT_META_FIELD_INT, 0, offsetof(Wide, f0), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"f1", STRUCT_META_FIELD_INT, 0, offsetof(Wide, f1), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"f2", STRUCT_META_FIELD_INT, 0, offsetof(Wide, f2), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"f3", STRUCT_META_FIELD_INT, 0, offsetof(Wide, f3), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"f4", STRUCT_META_FIELD_INT, 0, offsetof(Wide, f4), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"f5", STRUCT_META_FIELD_INT, 0, offsetof(Wide, f5), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"f6", STRUCT_META_FIELD_INT, 0, offsetof(Wide, f6), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"f7", STRUCT_META_FIELD_INT, 0, offsetof(Wide, f7), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"f8", STRUCT_META_FIELD_INT, 0, offsetof(Wide, f8), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"leaf", STRUCT_META_FIELD_STRUCT, 0, offsetof(Wide, leaf), sizeof(Leaf), 2, 0, &kLeafDescriptor, nullptr,
+     nullptr, 0},
+};
+const struct_meta_descriptor kWideDescriptor = {"Wide", sizeof(Wide), kWideFields, 10, nullptr};
+const struct_meta_field kDuplicateFields[] = {
+    {"same", STRUCT_META_FIELD_INT, 0, 0, sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"a", STRUCT_META_FIELD_INT, 0, 0, sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"b", STRUCT_META_FIELD_INT, 0, 0, sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"c", STRUCT_META_FIELD_INT, 0, 0, sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"d", STRUCT_META_FIELD_INT, 0, 0, sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"e", STRUCT_META_FIELD_INT, 0, 0, sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"f", STRUCT_META_FIELD_INT, 0, 0, sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"same", STRUCT_META_FIELD_INT, 0, 0, sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kDuplicateDescriptor = {"Duplicate", sizeof(int), kDuplicateFields, 8, nullptr};
+
+const char *FieldName(const struct_meta_field *field)
+{
+    return field->name;
+}
+} // namespace
+
+TEST(FieldNameIndexTest, FindsEveryFieldOfWideDescriptor)
+{
+    const struct_meta_field *field = nullptr; // [準備_正常系] - 索引を構築するフィールド数の記述子を用意する。
+    for (size_t i = 0; i < kWideDescriptor.field_count; i++) // [手順_正常系]
+    {
+        int ret = struct_meta_descriptor_find_field(&kWideDescriptor, kWideFields[i].name, &field);
+        EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - すべてのフィールドを名前で取得できること。
+        EXPECT_EQ(&kWideFields[i], field);
+    }
+}
+
+TEST(FieldNameIndexTest, RejectsMissingAndPrefixName)
+{
+    const struct_meta_field *field = &kWideFields[0]; // [準備_異常系] - 存在しない名前と既存名の接頭辞を用意する。
+    int missing = struct_meta_descriptor_find_field(&kWideDescriptor, "f9", &field); // [手順_異常系]
+    int prefix = struct_meta_descriptor_find_field(&kWideDescriptor, "lea", &field);
+    int longer = struct_meta_descriptor_find_field(&kWideDescriptor, "leafs", &field);
+    EXPECT_EQ(COM_UTIL_ERR_NOT_FOUND, missing); // [確認_異常系] - 完全一致しない名前を見つからないと報告すること。
+    EXPECT_EQ(COM_UTIL_ERR_NOT_FOUND, prefix);
+    EXPECT_EQ(COM_UTIL_ERR_NOT_FOUND, longer);
+}
+
+TEST(FieldNameIndexTest, ResolvesNestedPathThroughIndex)
+{
+    Wide wide = {}; // [準備_正常系] - 索引を持つ記述子からネスト先へ進むパスを用意する。
+    const struct_meta_field *field = nullptr;
+    void *target = nullptr;
+    int ret = struct_meta_path_resolve(&kWideDescriptor, &wide, "leaf[1].value", &field, &target); // [手順_正常系]
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - ネスト先のフィールドとアドレスを解決できること。
+    EXPECT_EQ(&kLeafFields[0], field);
+    EXPECT_EQ(&wide.leaf[1].value, target);
+}
+
+TEST(FieldNameIndexTest, KeepsFirstOfDuplicateKeys)
+{
+    struct_meta_internal_name_index index = {}; // [準備_正常系] - 同じキーを 2 個持つフィールド配列を用意する。
+    int ret = struct_meta_internal_name_index_build(&kDuplicateDescriptor, FieldName, 0, &index); // [手順_正常系]
+    const struct_meta_field *indexed =
+        struct_meta_internal_name_index_find(&index, &kDuplicateDescriptor, FieldName, "same", strlen("same"));
+    const struct_meta_field *linear =
+        struct_meta_internal_name_index_find(nullptr, &kDuplicateDescriptor, FieldName, "same", strlen("same"));
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 索引と線形探索がどちらも先頭のフィールドを返すこと。
+    EXPECT_NE(nullptr, index.slots);
+    EXPECT_EQ(&kDuplicateFields[0], indexed);
+    EXPECT_EQ(&kDuplicateFields[0], linear);
+    struct_meta_internal_name_index_dispose(&index);
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <struct_meta/hash/hash.h>
+#include <com_util/base/result.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+struct Address
+{
+    char city[8];
+    int zip;
+};
+struct Record
+{
+    char code[5];
+    int id;
+    double score;
+    float ratio;
+    Address home;
+    unsigned int flags[2];
+};
+const struct_meta_field kAddressFields[] = {
+    {"city", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Address, city), sizeof(char), 1, sizeof(Address::city), nullptr,
+     nullptr, nullptr, 0},
+    {"zip", STRUCT_META_FIELD_INT, 0, offsetof(Address, zip), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kAddressDescriptor = {"Address", sizeof(Address), kAddressFields, 2, nullptr};
+const struct_meta_field kRecordFields[] = {
+    {"code", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Record, code), sizeof(char), 1, sizeof(Record::code), nullptr,
+     nullptr, nullptr, 0},
+    {"id", STRUCT_META_FIELD_INT, 0, offsetof(Record, id), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"score", STRUCT_META_FIELD_DOUBLE, 0, offsetof(Record, score), sizeof(double), 1, 0, nullptr, nullptr, nullptr,
+     0},
+    {"ratio", STRUCT_META_FIELD_FLOAT, 0, offsetof(Record, ratio), sizeof(float), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"home", STRUCT_META_FIELD_STRUCT, 0, offsetof(Record, home), sizeof(Address), 1, 0, &kAddressDescriptor, nullptr,
+     nullptr, 0},
+    {"flags", STRUCT_META_FIELD_UNSIGNED, 0, offsetof(Record, flags), sizeof(unsigned int), 2, 0, nullptr, nullptr,
+     nullptr, 0},
+};
+const struct_meta_descriptor kRecordDescriptor = {"Record", sizeof(Record), kRecordFields, 6, nullptr};
+const struct_meta_field kWideFloatFields[] = {
+    {"ratio", STRUCT_META_FIELD_FLOAT, 0, 0, sizeof(double), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kWideFloatDescriptor = {"WideFloat", sizeof(double), kWideFloatFields, 1, nullptr};
+struct Switches
+{
+    int id;
+    bool enabled[2];
+    unsigned char pad[2];
+};
+const struct_meta_field kSwitchesFields[] = {
+    {"id", STRUCT_META_FIELD_INT, 0, offsetof(Switches, id), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"enabled", STRUCT_META_FIELD_BOOL, 0, offsetof(Switches, enabled), sizeof(bool), 2, 0, nullptr, nullptr, nullptr,
+     0},
+};
+const struct_meta_descriptor kSwitchesDescriptor = {"Switches", sizeof(Switches), kSwitchesFields, 2, nullptr};
+
+// 値の外側 (パディングと文字列の終端より後ろ) を fill で埋めてから値を設定する。
+void MakeRecord(Record *record, unsigned char fill)
+{
+    std::memset(record, fill, sizeof(*record));
+    std::strcpy(record->code, "ab");
+    record->id = 7;
+    record->score = 1.5;
+    record->ratio = 0.25F;
+    std::strcpy(record->home.city, "tokyo");
+    record->home.zip = 100;
+    record->flags[0] = 1U;
+    record->flags[1] = 2U;
+}
+
+uint64_t HashOf(const Record &record)
+{
+    uint64_t hash = 0U;
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_hash(&kRecordDescriptor, &record, &hash));
+    return hash;
+}
+
+bool EqualOf(const Record &left, const Record &right)
+{
+    int equal = -1;
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_equal(&kRecordDescriptor, &left, &right, &equal));
+    return equal == 1;
+}
+} // namespace
+
+TEST(HashTest, IgnoresPaddingAndBytesAfterTerminator)
+{
+    Record left; // [準備_正常系] - 値は同じで、パディングと文字列の終端より後ろのバイトだけが異なる 2 個を用意する。
+    Record right;
+    MakeRecord(&left, 0x00U);
+    MakeRecord(&right, 0xA5U);
+    ASSERT_NE(0, std::memcmp(&left, &right, sizeof(Record)));
+    uint64_t left_hash = HashOf(left); // [手順_正常系]
+    uint64_t right_hash = HashOf(right);
+    bool equal = EqualOf(left, right);
+    EXPECT_TRUE(equal); // [確認_正常系] - 等しいと判定し、ハッシュ値も一致すること。
+    EXPECT_EQ(left_hash, right_hash);
+    EXPECT_EQ(left_hash, HashOf(left));
+}
+
+TEST(HashTest, DetectsChangedValues)
+{
+    Record base; // [準備_正常系] - 種別ごとに 1 個の値だけを変えた構造体を用意する。
+    MakeRecord(&base, 0x00U);
+    Record changed[6];
+    for (Record &record : changed)
+    {
+        record = base;
+    }
+    std::strcpy(changed[0].code, "abc");
+    changed[1].id = 8;
+    changed[2].score = 2.5;
+    changed[3].ratio = 0.5F;
+    std::strcpy(changed[4].home.city, "kyoto");
+    changed[5].flags[1] = 3U;
+    uint64_t base_hash = HashOf(base); // [手順_正常系]
+    for (const Record &record : changed)
+    {
+        EXPECT_FALSE(EqualOf(base, record)); // [確認_正常系] - いずれも異なると判定し、ハッシュ値も異なること。
+        EXPECT_NE(base_hash, HashOf(record));
+    }
+}
+
+TEST(HashTest, NormalizesSignedZeroAndNaN)
+{
+    Record left; // [準備_正常系] - -0.0 と 0.0、ビット列の異なる NaN を持つ 2 個を用意する。
+    Record right;
+    MakeRecord(&left, 0x00U);
+    MakeRecord(&right, 0x00U);
+    left.score = 0.0;
+    right.score = -0.0;
+    left.ratio = std::numeric_limits<float>::quiet_NaN();
+    right.ratio = -std::numeric_limits<float>::quiet_NaN();
+    ASSERT_TRUE(std::isnan(right.ratio));
+    ASSERT_NE(0, std::memcmp(&left, &right, sizeof(Record)));
+    bool equal = EqualOf(left, right); // [手順_正常系]
+    EXPECT_TRUE(equal); // [確認_正常系] - 等しいと判定し、ハッシュ値も一致すること。
+    EXPECT_EQ(HashOf(left), HashOf(right));
+}
+
+TEST(HashTest, TreatsNonZeroBoolBytesAsTrue)
+{
+    // [準備_正常系] - bool のバイトが 1 の構造体と、同じ真を 2 のバイトで持つ構造体、偽を持つ構造体を用意する。
+    unsigned char left[sizeof(Switches)] = {};
+    unsigned char right[sizeof(Switches)] = {};
+    unsigned char other[sizeof(Switches)] = {};
+    left[offsetof(Switches, enabled)] = 1U;
+    right[offsetof(Switches, enabled)] = 2U;
+    other[offsetof(Switches, enabled) + 1U] = 1U;
+    uint64_t left_hash = 0U;
+    uint64_t right_hash = 0U;
+    uint64_t other_hash = 0U;
+    int equal = -1;
+    int other_equal = -1;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_hash(&kSwitchesDescriptor, left, &left_hash)); // [手順_正常系]
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_hash(&kSwitchesDescriptor, right, &right_hash));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_hash(&kSwitchesDescriptor, other, &other_hash));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_equal(&kSwitchesDescriptor, left, right, &equal));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_equal(&kSwitchesDescriptor, left, other, &other_equal));
+    EXPECT_EQ(1, equal); // [確認_正常系] - 0 以外のバイトを同じ真として等しいと判定し、ハッシュ値も一致すること。
+    EXPECT_EQ(left_hash, right_hash);
+    EXPECT_EQ(0, other_equal); // [確認_正常系] - 真の位置が異なる構造体は異なると判定すること。
+    EXPECT_NE(left_hash, other_hash);
+}
+
+TEST(HashTest, ReleasesPublishedPlanOnUnregister)
+{
+    // [準備_正常系] - 走査手順を公開済みにした、動的に作った記述子を用意する。
+    struct_meta_descriptor descriptor = {"DynamicRecord", sizeof(Record), kRecordFields, 6, nullptr};
+    Record record;
+    MakeRecord(&record, 0x00U);
+    uint64_t first = 0U;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_hash(&descriptor, &record, &first));
+    int removed = struct_meta_descriptor_unregister(&descriptor); // [手順_正常系] - 登録を削除してから再度使う。
+    uint64_t second = 0U;
+    int again = struct_meta_hash(&descriptor, &record, &second);
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_descriptor_unregister(&descriptor));
+    EXPECT_EQ(COM_UTIL_OK, removed); // [確認_正常系] - 走査手順を解放し、作り直した手順で同じ値を返すこと。
+    EXPECT_EQ(COM_UTIL_OK, again);
+    EXPECT_EQ(first, second);
+}
+
+TEST(HashTest, RejectsInvalidArguments)
+{
+    Record record; // [準備_異常系] - 引数の欠けた呼び出しと、float の要素サイズが合わない記述子を用意する。
+    MakeRecord(&record, 0x00U);
+    double wide_value = 1.0;
+    uint64_t hash = 0U;
+    int no_instance = struct_meta_hash(&kRecordDescriptor, nullptr, &hash); // [手順_異常系]
+    int no_output = struct_meta_equal(&kRecordDescriptor, &record, &record, nullptr);
+    int wide_ret = struct_meta_hash(&kWideFloatDescriptor, &wide_value, &hash);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, no_instance); // [確認_異常系] - 結果コードでエラーを返すこと。
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, no_output);
+    EXPECT_EQ(COM_UTIL_ERR_UNSUPPORTED, wide_ret);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <struct_meta/json/file.h>
+#include <struct_meta/json/reader.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace
+{
+struct Point
+{
+    int x;
+    int y;
+};
+struct Shape
+{
+    char name[8];
+    Point points[2];
+    double scale;
+    int tags[3];
+};
+const struct_meta_field kPointFields[] = {
+    {"x", STRUCT_META_FIELD_INT, 0, offsetof(Point, x), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"y", STRUCT_META_FIELD_INT, 0, offsetof(Point, y), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kPointDescriptor = {"Point", sizeof(Point), kPointFields, 2, nullptr};
+const struct_meta_field kShapeFields[] = {
+    {"name", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Shape, name), sizeof(char), 1, sizeof(Shape::name), nullptr,
+     nullptr, nullptr, 0},
+    {"points", STRUCT_META_FIELD_STRUCT, 0, offsetof(Shape, points), sizeof(Point), 2, 0, &kPointDescriptor, nullptr,
+     nullptr, 0},
+    {"scale", STRUCT_META_FIELD_DOUBLE, 0, offsetof(Shape, scale), sizeof(double), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"tags", STRUCT_META_FIELD_INT, 0, offsetof(Shape, tags), sizeof(int), 3, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kShapeDescriptor = {"Shape", sizeof(Shape), kShapeFields, 4, nullptr};
+
+// パディングも含めて比較できるよう、全体を埋めてから値を設定する。
+void MakeShape(Shape *shape)
+{
+    std::memset(shape, 0x5A, sizeof(*shape));
+    std::strcpy(shape->name, "tri");
+    shape->points[0] = {1, 2};
+    shape->points[1] = {3, 4};
+    shape->scale = 1.5;
+    shape->tags[0] = 7;
+    shape->tags[1] = 8;
+    shape->tags[2] = 9;
+}
+
+std::string WriteTempFile(const char *name, const char *text)
+{
+    std::string path = testing::TempDir() + name;
+    FILE *stream = std::fopen(path.c_str(), "wb");
+    if (stream != nullptr)
+    {
+        std::fputs(text, stream);
+        std::fclose(stream);
+    }
+    return path;
+}
+} // namespace
+
+TEST(JsonAtomicDecodeTest, RestoresEveryWrittenFieldOnError)
+{
+    Shape shape; // [準備_異常系] - ネスト構造体と配列を書き込んだ後に、要素数の合わない配列が続くテキストを用意する。
+    MakeShape(&shape);
+    Shape original = shape;
+    const char text[] = "{\"name\":\"square\",\"points\":[{\"x\":10,\"y\":20},{\"x\":30}],\"scale\":2.5,\"tags\":[1,2]}";
+    struct_meta_buffer undo;
+    struct_meta_buffer_init(&undo);
+    Shape partial = shape;
+    int in_place = struct_meta_json_decode_text(&kShapeDescriptor, text, sizeof(text) - 1U, &partial); // [手順_異常系]
+    int atomic = struct_meta_json_decode_text_atomic(&kShapeDescriptor, text, sizeof(text) - 1U, &shape, &undo);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, in_place); // [確認_異常系] - パディングを含めて呼び出し前の内容へ戻り、ログは空になること。
+    EXPECT_EQ(2.5, partial.scale);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, atomic);
+    EXPECT_EQ(0, std::memcmp(&original, &shape, sizeof(Shape)));
+    EXPECT_EQ(0U, undo.length);
+    struct_meta_buffer_dispose(&undo);
+}
+
+TEST(JsonAtomicDecodeTest, KeepsUpdatesOnSuccessAndReusesLog)
+{
+    Shape shape; // [準備_正常系] - 一部のフィールドだけを更新するテキストを用意する。
+    MakeShape(&shape);
+    const char first[] = "{\"points\":[{\"x\":10,\"y\":20},{\"x\":30,\"y\":40}]}";
+    const char second[] = "{\"name\":\"quad\",\"tags\":[4,5,6]}";
+    struct_meta_buffer undo;
+    struct_meta_buffer_init(&undo);
+    int first_ret = struct_meta_json_decode_text_atomic(&kShapeDescriptor, first, sizeof(first) - 1U, &shape, &undo); // [手順_正常系]
+    size_t capacity = undo.capacity;
+    int second_ret =
+        struct_meta_json_decode_text_atomic(&kShapeDescriptor, second, sizeof(second) - 1U, &shape, &undo);
+    int no_log = struct_meta_json_decode_text_atomic(&kShapeDescriptor, "{\"scale\":3}", 11U, &shape, nullptr);
+    EXPECT_EQ(COM_UTIL_OK, first_ret); // [確認_正常系] - 値を更新し、含まれないフィールドと確保済みのログは残ること。
+    EXPECT_EQ(COM_UTIL_OK, second_ret);
+    EXPECT_EQ(COM_UTIL_OK, no_log);
+    EXPECT_STREQ("quad", shape.name);
+    EXPECT_EQ(40, shape.points[1].y);
+    EXPECT_EQ(3.0, shape.scale);
+    EXPECT_EQ(6, shape.tags[2]);
+    EXPECT_EQ(capacity, undo.capacity);
+    EXPECT_EQ(0U, undo.length);
+    struct_meta_buffer_dispose(&undo);
+}
+
+TEST(JsonAtomicDecodeTest, SwapPublishesOnlyOnSuccess)
+{
+    Shape first_slot; // [準備_正常系] - 公開中のインスタンスと、読み込みに使う領域を用意する。
+    Shape second_slot;
+    MakeShape(&first_slot);
+    std::memset(&second_slot, 0, sizeof(second_slot));
+    void *current = &first_slot;
+    void *shadow = &second_slot;
+    const char bad[] = "{\"scale\":\"x\"}";
+    const char good[] = "{\"scale\":4}";
+    int bad_ret = struct_meta_json_decode_text_swap(&kShapeDescriptor, bad, sizeof(bad) - 1U, &current, &shadow); // [手順_正常系]
+    void *after_bad = current;
+    int good_ret = struct_meta_json_decode_text_swap(&kShapeDescriptor, good, sizeof(good) - 1U, &current, &shadow);
+    int same_ret = struct_meta_json_decode_text_swap(&kShapeDescriptor, good, sizeof(good) - 1U, &current, &current);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, bad_ret); // [確認_正常系] - 成功した場合だけ置き換え、それまでのインスタンスを返すこと。
+    EXPECT_EQ(&first_slot, after_bad);
+    EXPECT_EQ(COM_UTIL_OK, good_ret);
+    EXPECT_EQ(&second_slot, current);
+    EXPECT_EQ(&first_slot, shadow);
+    EXPECT_EQ(4.0, second_slot.scale);
+    EXPECT_STREQ("tri", second_slot.name);
+    EXPECT_EQ(1.5, first_slot.scale);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, same_ret);
+}
+
+TEST(JsonAtomicDecodeTest, FileLoadKeepsInstanceOnBrokenFile)
+{
+    Shape shape; // [準備_異常系] - 途中で切れたファイルと、値の後ろで構文が崩れたファイルを用意する。
+    MakeShape(&shape);
+    Shape original = shape;
+    std::string truncated = WriteTempFile("atomic_truncated.json", "{\"name\":\"square\",\"points\":[{\"x\":10,");
+    std::string broken = WriteTempFile("atomic_broken.json", "{\"scale\":2.5,\"tags\":[1,2,3] \"name\":\"x\"}");
+    std::string valid = WriteTempFile("atomic_valid.json", "{\"scale\":2.5,\"tags\":[1,2,3]}");
+    int truncated_ret = struct_meta_json_file_load(&kShapeDescriptor, truncated.c_str(), &shape); // [手順_異常系]
+    int broken_ret = struct_meta_json_file_load(&kShapeDescriptor, broken.c_str(), &shape);
+    bool unchanged = std::memcmp(&original, &shape, sizeof(Shape)) == 0;
+    int valid_ret = struct_meta_json_file_load(&kShapeDescriptor, valid.c_str(), &shape);
+    std::remove(truncated.c_str());
+    std::remove(broken.c_str());
+    std::remove(valid.c_str());
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, truncated_ret); // [確認_異常系] - エラーでは変更しないこと。
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, broken_ret);
+    EXPECT_TRUE(unchanged);
+    EXPECT_EQ(COM_UTIL_OK, valid_ret);
+    EXPECT_EQ(2.5, shape.scale);
+    EXPECT_EQ(3, shape.tags[2]);
+    EXPECT_STREQ("tri", shape.name);
+}
@@ -0,0 +1,19 @@
+# テスト対象のソース ファイル
+TEST_SRCS := \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/json/undo.c
+
+ADD_SRCS += \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/access/access.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/base/parallel.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/json/file.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/json/key.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/json/reader.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/json/writer.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/memory/allocator.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/memory/arena.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/memory/buffer.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/name_index.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/registry.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/validate.c
+
+LIBS += com_util
@@ -39,3 +39,44 @@ TEST(JsonDecodeTest, ReportsMissingRequiredAttribute)
     EXPECT_EQ(COM_UTIL_ERR_MISSING_REQUIRED, actual); // [確認_異常系] - 必須キー欠落を報告すること。
     cJSON_Delete(json);
 }
+
+TEST(JsonDecodeTest, DecodesArrayWithStride)
+{
+    struct Row
+    {
+        Sample sample;
+        int extra;
+    };
+    cJSON *json = cJSON_Parse("[{\"person_id\":1},{\"person_id\":2,\"optional\":3}]");
+    Row rows[3] = {{{0, 9}, 7}, {{0, 9}, 7}, {{0, 9}, 7}}; // [準備_正常系] - 別のメンバーを挟んだ配列を用意する。
+    size_t count = 0;
+    ASSERT_NE(nullptr, json);
+    int actual = struct_meta_json_decode_array(&kDescriptor, json, rows, 3, sizeof(Row), &count); // [手順_正常系]
+    EXPECT_EQ(COM_UTIL_OK, actual); // [確認_正常系] - 要素間隔に従って書き戻し、間のメンバーは変更しないこと。
+    EXPECT_EQ(2U, count);
+    EXPECT_EQ(1, rows[0].sample.id);
+    EXPECT_EQ(9, rows[0].sample.optional);
+    EXPECT_EQ(2, rows[1].sample.id);
+    EXPECT_EQ(3, rows[1].sample.optional);
+    EXPECT_EQ(7, rows[1].extra);
+    EXPECT_EQ(0, rows[2].sample.id);
+    EXPECT_EQ(COM_UTIL_ERR_BUFFER_TOO_SMALL, struct_meta_json_decode_array(&kDescriptor, json, rows, 1, sizeof(Row),
+                                                                            &count));
+    cJSON_Delete(json);
+}
+
+TEST(JsonDecodeTest, AtomicDecodeRestoresOnLaterError)
+{
+    cJSON *json = cJSON_Parse("{\"person_id\":5,\"optional\":\"x\"}");
+    Sample sample = {1, 9}; // [準備_異常系] - 先頭のフィールドは書き込め、後続のフィールドで型が合わない JSON を用意する。
+    ASSERT_NE(nullptr, json);
+    Sample partial = sample;
+    int in_place = struct_meta_json_decode(&kDescriptor, json, &partial); // [手順_異常系]
+    int atomic = struct_meta_json_decode_atomic(&kDescriptor, json, &sample, nullptr);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, in_place); // [確認_異常系] - 取り消しログにより呼び出し前の内容へ戻ること。
+    EXPECT_EQ(5, partial.id);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, atomic);
+    EXPECT_EQ(1, sample.id);
+    EXPECT_EQ(9, sample.optional);
+    cJSON_Delete(json);
+}
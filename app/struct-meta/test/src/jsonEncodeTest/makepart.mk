@@ -4,6 +4,9 @@ TEST_SRCS := \
 
 ADD_SRCS += \
 	$(MYAPP_DIR)/prod/libsrc/struct_meta/access/access.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/json/key.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/name_index.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/registry.c \
 	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/validate.c
 
 # cJSON API を直接使用するため実体をリンクする (モック不要)。
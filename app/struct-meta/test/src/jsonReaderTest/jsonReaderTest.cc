@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+#include <struct_meta/json/json.h>
+#include <struct_meta/json/reader.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Point
+{
+    int x;
+    int pad;
+    double y;
+};
+struct Record
+{
+    int id;
+    unsigned int count;
+    float ratio;
+    int hidden;
+    double values[3];
+    char label[16];
+    Point points[2];
+};
+const struct_meta_attribute kIdAttributes[] = {{"json.name", "record_id"}, {"json.required", nullptr}};
+const struct_meta_attribute kHiddenAttributes[] = {{"json.ignore", nullptr}};
+const struct_meta_field kPointFields[] = {
+    {"x", STRUCT_META_FIELD_INT, 0, offsetof(Point, x), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"y", STRUCT_META_FIELD_DOUBLE, 0, offsetof(Point, y), sizeof(double), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kPointDescriptor = {"Point", sizeof(Point), kPointFields, 2, nullptr};
+const struct_meta_field kRecordFields[] = {
+    {"id", STRUCT_META_FIELD_INT, 0, offsetof(Record, id), sizeof(int), 1, 0, nullptr, nullptr, kIdAttributes, 2},
+    {"count", STRUCT_META_FIELD_UNSIGNED, 0, offsetof(Record, count), sizeof(unsigned int), 1, 0, nullptr, nullptr,
+     nullptr, 0},
+    {"ratio", STRUCT_META_FIELD_FLOAT, 0, offsetof(Record, ratio), sizeof(float), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"values", STRUCT_META_FIELD_DOUBLE, 0, offsetof(Record, values), sizeof(double), 3, 0, nullptr, nullptr, nullptr,
+     0},
+    {"label", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Record, label), sizeof(char), 1, sizeof(Record::label),
+     nullptr, nullptr, nullptr, 0},
+    {"hidden", STRUCT_META_FIELD_INT, 0, offsetof(Record, hidden), sizeof(int), 1, 0, nullptr, nullptr,
+     kHiddenAttributes, 1},
+    {"points", STRUCT_META_FIELD_STRUCT, 0, offsetof(Record, points), sizeof(Point), 2, 0, &kPointDescriptor, nullptr,
+     nullptr, 0},
+};
+const struct_meta_descriptor kRecordDescriptor = {"Record", sizeof(Record), kRecordFields, 7, nullptr};
+
+const char kText[] = "\xEF\xBB\xBF {\n"
+                     "  \"unknown\": {\"nested\": [1, {\"deep\": null}, \"}\"]},\n"
+                     "  \"record_id\": -42,\n"
+                     "  \"count\": 3000000000,\n"
+                     "  \"ratio\": 1.25e-1,\n"
+                     "  \"hidden\": 99,\n"
+                     "  \"values\": [1.5, -0.0, 1E300],\n"
+                     "  \"label\": \"a\\\"b\\\\\\n\\u3042\\ud83d\\ude00\",\n"
+                     "  \"points\": [{\"y\": -0.25, \"x\": 1}, {\"x\": 2, \"y\": 2147483648}],\n"
+                     "  \"flag\": true\n"
+                     "} trailing text is ignored";
+
+int DecodeWithCJson(const char *text, Record *record)
+{
+    cJSON *json = cJSON_Parse(text);
+    if (json == nullptr)
+    {
+        return COM_UTIL_ERR_INVALID_ARGUMENT;
+    }
+    int ret = struct_meta_json_decode(&kRecordDescriptor, json, record);
+    cJSON_Delete(json);
+    return ret;
+}
+} // namespace
+
+TEST(JsonReaderTest, MatchesCJsonDecode)
+{
+    Record expected = {}; // [準備_正常系] - 未知キーのネスト、エスケープ、サロゲート ペア、キー順の入れ替えを含むテキストを用意する。
+    Record actual = {};
+    expected.hidden = 7;
+    actual.hidden = 7;
+    ASSERT_EQ(COM_UTIL_OK, DecodeWithCJson(kText, &expected));
+    int ret = struct_meta_json_decode_text(&kRecordDescriptor, kText, sizeof(kText) - 1U, &actual); // [手順_正常系]
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - cJSON_Parse() と struct_meta_json_decode() の結果に一致すること。
+    EXPECT_EQ(0, std::memcmp(&expected, &actual, sizeof(Record)));
+    EXPECT_EQ(-42, actual.id);
+    EXPECT_EQ(7, actual.hidden);
+    EXPECT_STREQ("a\"b\\\n\xE3\x81\x82\xF0\x9F\x98\x80", actual.label);
+}
+
+TEST(JsonReaderTest, UsesFirstOfDuplicateKeys)
+{
+    const char text[] = "{\"record_id\": 1, \"record_id\": 2, \"label\": \"first\", \"label\": 3}";
+    Record record = {}; // [準備_正常系] - 同じキーを 2 回含むテキストを用意する。後の値は型も不正とする。
+    int ret = struct_meta_json_decode_text(&kRecordDescriptor, text, sizeof(text) - 1U, &record); // [手順_正常系]
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - cJSON と同じく先頭の値を使い、後の値は読み飛ばすこと。
+    EXPECT_EQ(1, record.id);
+    EXPECT_STREQ("first", record.label);
+}
+
+TEST(JsonReaderTest, ReportsSameErrorsAsCJsonDecode)
+{
+    const char *const texts[] = {
+        "{\"count\": 1}",                                       // 必須キーの欠落
+        "{\"record_id\": 1, \"values\": [1, 2]}",               // 配列の要素数不足
+        "{\"record_id\": 1, \"values\": [1, 2, 3, 4]}",         // 配列の要素数超過
+        "{\"record_id\": 1, \"label\": \"0123456789abcdef\"}",  // char 配列の容量不足
+        "{\"record_id\": 1, \"count\": -1}",                    // 負の符号なし整数
+        "{\"record_id\": \"1\"}",                               // 型の不一致
+        "{\"record_id\": 1, \"unknown\": [1, 2,]}",             // 読み飛ばす値の構文エラー
+        "{\"record_id\": 1,}",                                  // 末尾のカンマ
+        "{\"record_id\": 1",                                    // 閉じていないオブジェクト
+        "{\"label\": \"\\ud83d\", \"record_id\": 1}",           // 対のないサロゲート
+        "",                                                     // 空のテキスト
+    };
+    for (const char *text : texts) // [準備_異常系] - decode と同じ検査に掛かるテキスト、および構文エラーを用意する。
+    {
+        Record expected = {};
+        Record actual = {};
+        int expected_ret = DecodeWithCJson(text, &expected);
+        int actual_ret = struct_meta_json_decode_text(&kRecordDescriptor, text, std::strlen(text), &actual); // [手順_異常系]
+        EXPECT_NE(COM_UTIL_OK, actual_ret) << text; // [確認_異常系] - cJSON 経由の読み込みと同じ結果コードを返すこと。
+        EXPECT_EQ(expected_ret, actual_ret) << text;
+    }
+}
+
+TEST(JsonReaderTest, CopiesStringTokenIntoCharArray)
+{
+    const char text[] = "[\"abc\", \"a\\u0000bcdef\", \"abcd\", 1]"; // [準備_正常系] - 容量ちょうど、\u0000 を含む、容量超過、数値の値を用意する。
+    struct_meta_json_reader reader;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_json_reader_init_text(&reader, text, sizeof(text) - 1U));
+    struct_meta_json_token token;
+    char fits[4] = {'x', 'x', 'x', 'x'};
+    char nul[4] = {'x', 'x', 'x', 'x'};
+    char small[4] = {'x', 'x', 'x', 'x'};
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_json_reader_next(&reader, &token));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_json_reader_next(&reader, &token));
+    int fits_ret = struct_meta_json_reader_chars(&reader, token, fits, sizeof(fits)); // [手順_正常系]
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_json_reader_next(&reader, &token));
+    int nul_ret = struct_meta_json_reader_chars(&reader, token, nul, sizeof(nul));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_json_reader_next(&reader, &token));
+    int small_ret = struct_meta_json_reader_chars(&reader, token, small, sizeof(small));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_json_reader_next(&reader, &token));
+    int number_ret = struct_meta_json_reader_chars(&reader, token, small, sizeof(small));
+    struct_meta_json_reader_dispose(&reader);
+    EXPECT_EQ(COM_UTIL_OK, fits_ret); // [確認_正常系] - NUL 終端して複写し、\u0000 以降は含めず、エラーでは変更しないこと。
+    EXPECT_STREQ("abc", fits);
+    EXPECT_EQ(COM_UTIL_OK, nul_ret);
+    EXPECT_STREQ("a", nul);
+    EXPECT_EQ(COM_UTIL_ERR_BUFFER_TOO_SMALL, small_ret);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, number_ret);
+    EXPECT_EQ('x', small[0]);
+}
+
+TEST(JsonReaderTest, ReadsStreamAcrossChunkBoundaries)
+{
+    std::string text = "{\"unknown\": \""; // [準備_正常系] - チャンク境界をまたぐ長い文字列と空白を含むテキストを一時ファイルへ書く。
+    text.append(STRUCT_META_JSON_READER_CHUNK_SIZE + 100U, 'x');
+    text += "\",";
+    text.append(STRUCT_META_JSON_READER_CHUNK_SIZE - 3U, ' ');
+    text += "\"record_id\": 12345.0, \"label\": \"tail\\u00e9\"}";
+    FILE *stream = std::tmpfile();
+    ASSERT_NE(nullptr, stream);
+    ASSERT_EQ(text.size(), std::fwrite(text.data(), 1, text.size(), stream));
+    std::rewind(stream);
+    struct_meta_json_reader reader;
+    Record record = {};
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_json_reader_init_stream(&reader, stream));
+    int ret = struct_meta_json_reader_value(&reader, &kRecordDescriptor, &record); // [手順_正常系]
+    struct_meta_json_reader_dispose(&reader);
+    std::fclose(stream);
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - ストリームからもテキストと同じ値を読み込むこと。
+    EXPECT_EQ(12345, record.id);
+    EXPECT_STREQ("tail\xC3\xA9", record.label);
+}
+
+TEST(JsonReaderTest, DecodesArrayInParallelSameAsSerial)
+{
+    std::string text = "[ "; // [準備_正常系] - 複数スレッドへ分割される件数の配列テキストを用意する。
+    for (int i = 0; i < 1000; i++)
+    {
+        if (i > 0)
+        {
+            text += ",\n";
+        }
+        text += "{\"record_id\": " + std::to_string(i) + ", \"label\": \"[,]{\\\"}\", \"values\": [1, 2, 3]}";
+    }
+    text += " ]";
+    std::vector<Record> serial(1000);
+    std::vector<Record> parallel(1000);
+    size_t serial_count = 0;
+    size_t parallel_count = 0;
+    int serial_ret = struct_meta_json_decode_text_array(&kRecordDescriptor, text.data(), text.size(), serial.data(),
+                                                        serial.size(), 0, 1, &serial_count); // [手順_正常系]
+    int parallel_ret = struct_meta_json_decode_text_array(&kRecordDescriptor, text.data(), text.size(),
+                                                          parallel.data(), parallel.size(), 0, 4, &parallel_count);
+    EXPECT_EQ(COM_UTIL_OK, serial_ret); // [確認_正常系] - 並行読み込みも全要素を順に読み込み、逐次と一致すること。
+    EXPECT_EQ(COM_UTIL_OK, parallel_ret);
+    EXPECT_EQ(1000U, serial_count);
+    EXPECT_EQ(1000U, parallel_count);
+    EXPECT_EQ(0, std::memcmp(serial.data(), parallel.data(), sizeof(Record) * serial.size()));
+    EXPECT_EQ(999, parallel[999].id);
+    EXPECT_STREQ("[,]{\"}", parallel[999].label);
+}
+
+TEST(JsonReaderTest, ReportsFirstFailingArrayElement)
+{
+    std::string text = "["; // [準備_異常系] - 途中の要素に必須キーの欠落を含む配列と、容量を超える配列を用意する。
+    for (int i = 0; i < 600; i++)
+    {
+        if (i > 0)
+        {
+            text += ",";
+        }
+        if ((i == 300) || (i == 500))
+        {
+            text += "{}";
+        }
+        else
+        {
+            text += "{\"record_id\": 1}";
+        }
+    }
+    text += "]";
+    std::vector<Record> records(600);
+    size_t serial_count = 0;
+    size_t parallel_count = 0;
+    size_t small_count = 0;
+    int serial_ret = struct_meta_json_decode_text_array(&kRecordDescriptor, text.data(), text.size(), records.data(),
+                                                        records.size(), 0, 1, &serial_count); // [手順_異常系]
+    int parallel_ret = struct_meta_json_decode_text_array(&kRecordDescriptor, text.data(), text.size(),
+                                                          records.data(), records.size(), 0, 2, &parallel_count);
+    int small_ret = struct_meta_json_decode_text_array(&kRecordDescriptor, text.data(), text.size(), records.data(),
+                                                       599, 0, 2, &small_count);
+    EXPECT_EQ(COM_UTIL_ERR_MISSING_REQUIRED, serial_ret); // [確認_異常系] - 要素の順で最初のエラーと、その添字を返すこと。
+    EXPECT_EQ(300U, serial_count);
+    EXPECT_EQ(COM_UTIL_ERR_MISSING_REQUIRED, parallel_ret);
+    EXPECT_EQ(300U, parallel_count);
+    EXPECT_EQ(COM_UTIL_ERR_BUFFER_TOO_SMALL, small_ret);
+}
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include <struct_meta/json/json.h>
+#include <struct_meta/json/writer.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Point
+{
+    int x;
+    int pad;
+    double y;
+};
+struct Record
+{
+    int id;
+    unsigned int count;
+    float ratio;
+    int hidden;
+    double values[4];
+    char label[16];
+    Point points[2];
+};
+const struct_meta_attribute kIdAttributes[] = {{"json.name", "record_id"}};
+const struct_meta_attribute kHiddenAttributes[] = {{"json.ignore", nullptr}};
+const struct_meta_field kPointFields[] = {
+    {"x", STRUCT_META_FIELD_INT, 0, offsetof(Point, x), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"y", STRUCT_META_FIELD_DOUBLE, 0, offsetof(Point, y), sizeof(double), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kPointDescriptor = {"Point", sizeof(Point), kPointFields, 2, nullptr};
+const struct_meta_field kRecordFields[] = {
+    {"id", STRUCT_META_FIELD_INT, 0, offsetof(Record, id), sizeof(int), 1, 0, nullptr, nullptr, kIdAttributes, 1},
+    {"count", STRUCT_META_FIELD_UNSIGNED, 0, offsetof(Record, count), sizeof(unsigned int), 1, 0, nullptr, nullptr,
+     nullptr, 0},
+    {"ratio", STRUCT_META_FIELD_FLOAT, 0, offsetof(Record, ratio), sizeof(float), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"values", STRUCT_META_FIELD_DOUBLE, 0, offsetof(Record, values), sizeof(double), 4, 0, nullptr, nullptr, nullptr,
+     0},
+    {"label", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Record, label), sizeof(char), 1, sizeof(Record::label),
+     nullptr, nullptr, nullptr, 0},
+    {"hidden", STRUCT_META_FIELD_INT, 0, offsetof(Record, hidden), sizeof(int), 1, 0, nullptr, nullptr,
+     kHiddenAttributes, 1},
+    {"points", STRUCT_META_FIELD_STRUCT, 0, offsetof(Record, points), sizeof(Point), 2, 0, &kPointDescriptor, nullptr,
+     nullptr, 0},
+};
+const struct_meta_descriptor kRecordDescriptor = {"Record", sizeof(Record), kRecordFields, 7, nullptr};
+const struct_meta_field kUnsupportedFields[] = {
+    {"id", STRUCT_META_FIELD_INT, 0, 0, sizeof(short), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kUnsupportedDescriptor = {"Unsupported", sizeof(short), kUnsupportedFields, 1, nullptr};
+
+Record MakeRecord()
+{
+    Record record = {};
+    record.id = -42;
+    record.count = 3000000000U;
+    record.ratio = 0.1F;
+    record.values[0] = 1.5;
+    record.values[1] = 1e300;
+    record.values[2] = 1.0 / 3.0;
+    record.values[3] = std::numeric_limits<double>::quiet_NaN();
+    std::memcpy(record.label, "a\"b\\\n\x01\xE3\x81\x82", 10);
+    record.hidden = 7;
+    record.points[0] = {1, 0, -0.25};
+    record.points[1] = {2, 0, 2147483648.0};
+    return record;
+}
+
+std::string PrintWithCJson(const Record &record, bool formatted)
+{
+    cJSON *json = nullptr;
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_json_encode(&kRecordDescriptor, &record, &json));
+    char *text = nullptr;
+    if (formatted)
+    {
+        text = cJSON_Print(json);
+    }
+    else
+    {
+        text = cJSON_PrintUnformatted(json);
+    }
+    std::string result(text);
+    cJSON_free(text);
+    cJSON_Delete(json);
+    return result;
+}
+} // namespace
+
+TEST(JsonWriterTest, MatchesCJsonPrintByteForByte)
+{
+    Record record = MakeRecord(); // [準備_正常系] - 全種別、属性、エスケープ対象文字、ネスト配列を含む値を用意する。
+    struct_meta_buffer pretty;
+    struct_meta_buffer compact;
+    struct_meta_buffer_init(&pretty);
+    struct_meta_buffer_init(&compact);
+    int pretty_ret = // [手順_正常系]
+        struct_meta_json_write_buffer(&kRecordDescriptor, &record, STRUCT_META_JSON_FORMAT_PRETTY, &pretty);
+    int compact_ret =
+        struct_meta_json_write_buffer(&kRecordDescriptor, &record, STRUCT_META_JSON_FORMAT_COMPACT, &compact);
+    EXPECT_EQ(COM_UTIL_OK, pretty_ret); // [確認_正常系] - cJSON_Print() と cJSON_PrintUnformatted() に一致すること。
+    EXPECT_EQ(COM_UTIL_OK, compact_ret);
+    EXPECT_EQ(PrintWithCJson(record, true), std::string(reinterpret_cast<const char *>(pretty.data), pretty.length));
+    EXPECT_EQ(PrintWithCJson(record, false),
+              std::string(reinterpret_cast<const char *>(compact.data), compact.length));
+    struct_meta_buffer_dispose(&pretty);
+    struct_meta_buffer_dispose(&compact);
+}
+
+TEST(JsonWriterTest, WritesSameTextToStream)
+{
+    Record record = MakeRecord(); // [準備_正常系] - 書き出し先の一時ファイルを用意する。
+    FILE *stream = std::tmpfile();
+    ASSERT_NE(nullptr, stream);
+    int ret = struct_meta_json_write_stream(&kRecordDescriptor, &record, STRUCT_META_JSON_FORMAT_PRETTY,
+                                            stream); // [手順_正常系]
+    std::string written;
+    char chunk[256];
+    std::rewind(stream);
+    for (size_t length = std::fread(chunk, 1, sizeof(chunk), stream); length > 0;
+         length = std::fread(chunk, 1, sizeof(chunk), stream))
+    {
+        written.append(chunk, length);
+    }
+    std::fclose(stream);
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - ストリームへもバッファーと同じテキストを書き出すこと。
+    EXPECT_EQ(PrintWithCJson(record, true), written);
+}
+
+TEST(JsonWriterTest, WritesCharArrayUpToTerminatorOrCapacity)
+{
+    const char terminated[8] = {'a', '"', 'b', '\0', 'x', 'y', 'z', '\0'}; // [準備_正常系] - NUL 終端の有無が異なる char 配列を用意する。
+    const char unterminated[3] = {'a', 'b', 'c'};
+    struct_meta_buffer buffer;
+    struct_meta_buffer_init(&buffer);
+    struct_meta_json_writer writer;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_json_writer_init_buffer(&writer, &buffer, STRUCT_META_JSON_FORMAT_COMPACT));
+    int begin = struct_meta_json_writer_begin_array(&writer); // [手順_正常系]
+    int first = struct_meta_json_writer_chars(&writer, terminated, sizeof(terminated));
+    int second = struct_meta_json_writer_chars(&writer, unterminated, sizeof(unterminated));
+    int empty = struct_meta_json_writer_chars(&writer, nullptr, 0);
+    int end = struct_meta_json_writer_end_array(&writer);
+    EXPECT_EQ(COM_UTIL_OK, begin); // [確認_正常系] - 最初の NUL まで、NUL がなければ配列全体をエスケープして書き出すこと。
+    EXPECT_EQ(COM_UTIL_OK, first);
+    EXPECT_EQ(COM_UTIL_OK, second);
+    EXPECT_EQ(COM_UTIL_OK, empty);
+    EXPECT_EQ(COM_UTIL_OK, end);
+    EXPECT_STREQ("[\"a\\\"b\",\"abc\",\"\"]", reinterpret_cast<const char *>(buffer.data));
+    struct_meta_buffer_dispose(&buffer);
+}
+
+TEST(JsonWriterTest, KeepsBufferOnUnsupportedField)
+{
+    short value = 1; // [準備_異常系] - 既存の内容を持つバッファーと、未対応サイズの int フィールドを用意する。
+    struct_meta_buffer buffer;
+    struct_meta_buffer_init(&buffer);
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_buffer_append(&buffer, "[", 1));
+    int ret = struct_meta_json_write_buffer(&kUnsupportedDescriptor, &value, STRUCT_META_JSON_FORMAT_COMPACT,
+                                            &buffer); // [手順_異常系]
+    EXPECT_EQ(COM_UTIL_ERR_UNSUPPORTED, ret); // [確認_異常系] - エラーを返し、追記前の内容へ戻すこと。
+    EXPECT_EQ(1U, buffer.length);
+    EXPECT_STREQ("[", reinterpret_cast<const char *>(buffer.data));
+    struct_meta_buffer_dispose(&buffer);
+}
+
+TEST(JsonWriterTest, WritesArrayInParallelSameAsCJson)
+{
+    std::vector<Record> records(1000); // [準備_正常系] - 複数スレッドへ分割される件数の配列を用意する。
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        records[i] = MakeRecord();
+        records[i].id = static_cast<int>(i);
+    }
+    cJSON *json = nullptr;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_json_encode_array(&kRecordDescriptor, records.data(), records.size(), 0, &json));
+    char *expected = cJSON_Print(json);
+    struct_meta_buffer serial;
+    struct_meta_buffer parallel;
+    struct_meta_buffer_init(&serial);
+    struct_meta_buffer_init(&parallel);
+    int serial_ret = struct_meta_json_write_array_buffer(&kRecordDescriptor, records.data(), records.size(), 0,
+                                                         STRUCT_META_JSON_FORMAT_PRETTY, 1, &serial); // [手順_正常系]
+    int parallel_ret = struct_meta_json_write_array_buffer(&kRecordDescriptor, records.data(), records.size(), 0,
+                                                           STRUCT_META_JSON_FORMAT_PRETTY, 4, &parallel);
+    EXPECT_EQ(COM_UTIL_OK, serial_ret); // [確認_正常系] - 並行書き出しも要素の順に連結し、cJSON_Print() に一致すること。
+    EXPECT_EQ(COM_UTIL_OK, parallel_ret);
+    EXPECT_EQ(std::string(expected), std::string(reinterpret_cast<const char *>(serial.data), serial.length));
+    EXPECT_EQ(std::string(expected), std::string(reinterpret_cast<const char *>(parallel.data), parallel.length));
+    struct_meta_buffer_dispose(&serial);
+    struct_meta_buffer_dispose(&parallel);
+    cJSON_free(expected);
+    cJSON_Delete(json);
+}
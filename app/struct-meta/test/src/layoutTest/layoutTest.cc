@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include <struct_meta/layout/layout.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+struct Sample
+{
+    uint8_t flag;
+    double value;
+    uint16_t code;
+    int32_t count;
+    char name[3];
+};
+const struct_meta_field kSampleFields[] = {
+    {"flag", STRUCT_META_FIELD_UINT8, 0, offsetof(Sample, flag), sizeof(uint8_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"value", STRUCT_META_FIELD_DOUBLE, 0, offsetof(Sample, value), sizeof(double), 1, 0, nullptr, nullptr, nullptr,
+     0},
+    {"code", STRUCT_META_FIELD_UINT16, 0, offsetof(Sample, code), sizeof(uint16_t), 1, 0, nullptr, nullptr, nullptr,
+     0},
+    {"count", STRUCT_META_FIELD_INT, 0, offsetof(Sample, count), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"name", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Sample, name), sizeof(char), 1, sizeof(Sample::name), nullptr,
+     nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kSampleDescriptor = {"Sample", sizeof(Sample), kSampleFields, 5, nullptr};
+
+// 記述子の順とオフセット順が異なり、hot の値が 2 個のキャッシュ ラインへ散った構造体。
+struct Wide
+{
+    char note[120];
+    int32_t hot_a;
+    char middle[60];
+    int32_t hot_b;
+};
+const struct_meta_attribute kHotAttributes[] = {{"layout.hot", nullptr}};
+const struct_meta_attribute kColdAttributes[] = {{"layout.cold", nullptr}};
+const struct_meta_field kWideFields[] = {
+    {"hot_b", STRUCT_META_FIELD_INT, 0, offsetof(Wide, hot_b), sizeof(int32_t), 1, 0, nullptr, nullptr, kHotAttributes,
+     1},
+    {"note", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Wide, note), sizeof(char), 1, sizeof(Wide::note), nullptr,
+     nullptr, kColdAttributes, 1},
+    {"hot_a", STRUCT_META_FIELD_INT, 0, offsetof(Wide, hot_a), sizeof(int32_t), 1, 0, nullptr, nullptr, kHotAttributes,
+     1},
+    {"middle", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Wide, middle), sizeof(char), 1, sizeof(Wide::middle), nullptr,
+     nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kWideDescriptor = {"Wide", sizeof(Wide), kWideFields, 4, nullptr};
+
+struct Inner
+{
+    char tag;
+    int64_t stamp;
+};
+struct Outer
+{
+    Inner first;
+    STRUCT_META_SEQUENCE(int) values;
+    Inner second;
+};
+const struct_meta_field kInnerFields[] = {
+    {"tag", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Inner, tag), sizeof(char), 1, sizeof(char), nullptr, nullptr,
+     nullptr, 0},
+    {"stamp", STRUCT_META_FIELD_INT64, 0, offsetof(Inner, stamp), sizeof(int64_t), 1, 0, nullptr, nullptr, nullptr,
+     0},
+};
+const struct_meta_descriptor kInnerDescriptor = {"Inner", sizeof(Inner), kInnerFields, 2, nullptr};
+const struct_meta_field kOuterFields[] = {
+    {"first", STRUCT_META_FIELD_STRUCT, 0, offsetof(Outer, first), sizeof(Inner), 1, 0, &kInnerDescriptor, nullptr,
+     nullptr, 0},
+    {"values", STRUCT_META_FIELD_INT, STRUCT_META_STORAGE_SEQUENCE, offsetof(Outer, values), sizeof(int), 1, 0, nullptr,
+     nullptr, nullptr, 0},
+    {"second", STRUCT_META_FIELD_STRUCT, 0, offsetof(Outer, second), sizeof(Inner), 1, 0, &kInnerDescriptor, nullptr,
+     nullptr, 0},
+};
+const struct_meta_descriptor kOuterDescriptor = {"Outer", sizeof(Outer), kOuterFields, 3, nullptr};
+
+size_t CountOf(const std::string &text, const std::string &pattern)
+{
+    size_t count = 0U;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1U))
+    {
+        count++;
+    }
+    return count;
+}
+} // namespace
+
+TEST(LayoutTest, ReportsPaddingAndSuggestsSmallerOrder)
+{
+    struct_meta_layout_field fields[5]; // [準備_正常系] - フィールド間と末尾にパディングを持つ構造体を用意する。
+    struct_meta_layout_report report;
+    int ret = struct_meta_layout_analyze(&kSampleDescriptor, fields, 5U, &report); // [手順_正常系]
+    ASSERT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 隙間と末尾のパディングを数えること。
+    EXPECT_EQ(sizeof(Sample), report.size);
+    EXPECT_EQ(alignof(Sample), report.alignment);
+    EXPECT_EQ(offsetof(Sample, value) - 1U, fields[1].padding_before);
+    EXPECT_EQ(offsetof(Sample, count) - offsetof(Sample, code) - sizeof(uint16_t), fields[3].padding_before);
+    EXPECT_EQ(sizeof(Sample) - offsetof(Sample, name) - sizeof(Sample::name), report.trailing_padding);
+    EXPECT_EQ(sizeof(Sample) - 18U, report.padding);
+    EXPECT_EQ(1U, report.cache_lines);
+    // [確認_正常系] - 境界の大きい順に並べ、同じ境界では元の順を保つこと。
+    EXPECT_EQ(0U, fields[1].suggested_offset);
+    EXPECT_EQ(8U, fields[3].suggested_offset);
+    EXPECT_EQ(12U, fields[2].suggested_offset);
+    EXPECT_EQ(14U, fields[0].suggested_offset);
+    EXPECT_EQ(15U, fields[4].suggested_offset);
+    EXPECT_EQ(24U, report.suggested_size);
+    EXPECT_EQ(6U, report.suggested_padding);
+    EXPECT_LT(report.suggested_size, report.size);
+}
+
+TEST(LayoutTest, GroupsHotFieldsIntoFewerCacheLines)
+{
+    struct_meta_layout_field fields[4]; // [準備_正常系] - hot の値が 2 個のキャッシュ ラインに散った構造体を用意する。
+    struct_meta_layout_report report;
+    int ret = struct_meta_layout_analyze(&kWideDescriptor, fields, 4U, &report); // [手順_正常系]
+    ASSERT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - オフセット順に並べ、ラインをまたぐ値を示すこと。
+    EXPECT_STREQ("note", fields[0].field->name);
+    EXPECT_STREQ("hot_a", fields[1].field->name);
+    EXPECT_STREQ("middle", fields[2].field->name);
+    EXPECT_STREQ("hot_b", fields[3].field->name);
+    EXPECT_EQ(STRUCT_META_LAYOUT_COLD, fields[0].group);
+    EXPECT_EQ(STRUCT_META_LAYOUT_HOT, fields[1].group);
+    EXPECT_EQ(STRUCT_META_LAYOUT_NORMAL, fields[2].group);
+    EXPECT_EQ(1U, fields[2].first_cache_line);
+    EXPECT_EQ(2U, fields[2].last_cache_line);
+    EXPECT_EQ(3U, report.cache_lines);
+    EXPECT_EQ(2U, report.hot_cache_lines);
+    // [確認_正常系] - hot、無指定、cold の順に並べ、hot の値を 1 個のラインへまとめること。
+    EXPECT_EQ(0U, fields[1].suggested_offset);
+    EXPECT_EQ(4U, fields[3].suggested_offset);
+    EXPECT_EQ(8U, fields[2].suggested_offset);
+    EXPECT_EQ(68U, fields[0].suggested_offset);
+    EXPECT_EQ(sizeof(Wide), report.suggested_size);
+    EXPECT_EQ(1U, report.suggested_hot_cache_lines);
+}
+
+TEST(LayoutTest, WritesEachNestedTypeOnce)
+{
+    std::FILE *stream = std::tmpfile(); // [準備_正常系] - 同じネスト先の型を 2 個持つ構造体を用意する。
+    ASSERT_NE(nullptr, stream);
+    int ret = struct_meta_layout_write(&kOuterDescriptor, stream); // [手順_正常系]
+    std::string text;
+    std::rewind(stream);
+    for (int c = std::fgetc(stream); c != EOF; c = std::fgetc(stream))
+    {
+        text.push_back(static_cast<char>(c));
+    }
+    std::fclose(stream);
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 型ごとの表を 1 回ずつ書き出すこと。
+    EXPECT_EQ(1U, CountOf(text, "Outer: size"));
+    EXPECT_EQ(1U, CountOf(text, "Inner: size"));
+    EXPECT_EQ(2U, CountOf(text, "trailing padding"));
+    EXPECT_LT(text.find("Outer: size"), text.find("Inner: size"));
+
+    struct_meta_layout_field fields[3]; // [確認_正常系] - 可変長配列は items と count の組の大きさとすること。
+    struct_meta_layout_report report;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_layout_analyze(&kOuterDescriptor, fields, 3U, &report));
+    EXPECT_EQ(sizeof(struct_meta_sequence), fields[1].size);
+    EXPECT_EQ(alignof(Inner), fields[0].alignment);
+}
+
+TEST(LayoutTest, RejectsInvalidArguments)
+{
+    struct_meta_layout_field fields[4]; // [準備_異常系]
+    struct_meta_layout_report report;
+    // [手順_異常系] [確認_異常系] - 引数の不足と、フィールド数より小さい格納先を拒否すること。
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, struct_meta_layout_analyze(nullptr, fields, 4U, &report));
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, struct_meta_layout_analyze(&kWideDescriptor, fields, 4U, nullptr));
+    EXPECT_EQ(COM_UTIL_ERR_BUFFER_TOO_SMALL, struct_meta_layout_analyze(&kWideDescriptor, fields, 3U, &report));
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, struct_meta_layout_write(&kWideDescriptor, nullptr));
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_layout_analyze(&kWideDescriptor, nullptr, 0U, &report));
+    EXPECT_EQ(2U, report.hot_cache_lines);
+}
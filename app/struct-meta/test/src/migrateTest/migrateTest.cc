@@ -0,0 +1,349 @@
+#include <gtest/gtest.h>
+#include <struct_meta/migrate/migrate.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+// 旧版。
+struct PersonV1
+{
+    int32_t id;
+    char name[16];
+    double score;
+    int32_t legacy;
+};
+const struct_meta_field kPersonV1Fields[] = {
+    {"id", STRUCT_META_FIELD_INT, 0, offsetof(PersonV1, id), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"name", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(PersonV1, name), sizeof(char), 1, sizeof(PersonV1::name),
+     nullptr, nullptr, nullptr, 0},
+    {"score", STRUCT_META_FIELD_DOUBLE, 0, offsetof(PersonV1, score), sizeof(double), 1, 0, nullptr, nullptr, nullptr,
+     0},
+    {"legacy", STRUCT_META_FIELD_INT, 0, offsetof(PersonV1, legacy), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr,
+     0},
+};
+const struct_meta_descriptor kPersonV1Descriptor = {"PersonV1", sizeof(PersonV1), kPersonV1Fields, 4, nullptr};
+
+// 同じレイアウトを別の記述子で表した版。
+const struct_meta_descriptor kPersonV1CopyDescriptor = {"PersonV1", sizeof(PersonV1), kPersonV1Fields, 4, nullptr};
+
+// 新版。id は person_id へ改名して JSON キーに旧名を残し、legacy を削除し、added を追加した。
+struct PersonV2
+{
+    double score;
+    int64_t person_id;
+    char name[8];
+    int32_t added;
+};
+const struct_meta_attribute kPersonIdAttributes[] = {{"json.name", "id"}};
+const struct_meta_field kPersonV2Fields[] = {
+    {"score", STRUCT_META_FIELD_DOUBLE, 0, offsetof(PersonV2, score), sizeof(double), 1, 0, nullptr, nullptr, nullptr,
+     0},
+    {"person_id", STRUCT_META_FIELD_INT64, 0, offsetof(PersonV2, person_id), sizeof(int64_t), 1, 0, nullptr, nullptr,
+     kPersonIdAttributes, 1},
+    {"name", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(PersonV2, name), sizeof(char), 1, sizeof(PersonV2::name),
+     nullptr, nullptr, nullptr, 0},
+    {"added", STRUCT_META_FIELD_INT, 0, offsetof(PersonV2, added), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr,
+     0},
+};
+const struct_meta_descriptor kPersonV2Descriptor = {"PersonV2", sizeof(PersonV2), kPersonV2Fields, 4, nullptr};
+
+// 旧版。連続する a と b の間へ、新版で追加するフィールドはない。
+struct RowV1
+{
+    int32_t a;
+    int32_t b;
+    int32_t c;
+    int32_t d;
+};
+const struct_meta_field kRowV1Fields[] = {
+    {"a", STRUCT_META_FIELD_INT, 0, offsetof(RowV1, a), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"b", STRUCT_META_FIELD_INT, 0, offsetof(RowV1, b), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"c", STRUCT_META_FIELD_INT, 0, offsetof(RowV1, c), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"d", STRUCT_META_FIELD_INT, 0, offsetof(RowV1, d), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kRowV1Descriptor = {"Row", sizeof(RowV1), kRowV1Fields, 4, nullptr};
+
+// 新版。b と c の間へ inserted を追加し、末尾の d を削除した。
+struct RowV2
+{
+    int32_t a;
+    int32_t b;
+    int32_t inserted;
+    int32_t c;
+};
+const struct_meta_field kRowV2Fields[] = {
+    {"a", STRUCT_META_FIELD_INT, 0, offsetof(RowV2, a), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"b", STRUCT_META_FIELD_INT, 0, offsetof(RowV2, b), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"inserted", STRUCT_META_FIELD_INT, 0, offsetof(RowV2, inserted), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr,
+     0},
+    {"c", STRUCT_META_FIELD_INT, 0, offsetof(RowV2, c), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kRowV2Descriptor = {"Row", sizeof(RowV2), kRowV2Fields, 4, nullptr};
+
+// 同じ大きさで、末尾の d を added へ置き換えた版。
+const struct_meta_field kRowV3Fields[] = {
+    {"a", STRUCT_META_FIELD_INT, 0, offsetof(RowV1, a), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"b", STRUCT_META_FIELD_INT, 0, offsetof(RowV1, b), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"c", STRUCT_META_FIELD_INT, 0, offsetof(RowV1, c), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"added", STRUCT_META_FIELD_INT, 0, offsetof(RowV1, d), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kRowV3Descriptor = {"Row", sizeof(RowV1), kRowV3Fields, 4, nullptr};
+
+// ネストした構造体の配列と数値の配列を持つ旧版。
+struct PointV1
+{
+    int16_t x;
+    int16_t y;
+};
+const struct_meta_field kPointV1Fields[] = {
+    {"x", STRUCT_META_FIELD_INT16, 0, offsetof(PointV1, x), sizeof(int16_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"y", STRUCT_META_FIELD_INT16, 0, offsetof(PointV1, y), sizeof(int16_t), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kPointV1Descriptor = {"Point", sizeof(PointV1), kPointV1Fields, 2, nullptr};
+struct PathV1
+{
+    PointV1 points[3];
+    float weights[2];
+};
+const struct_meta_field kPathV1Fields[] = {
+    {"points", STRUCT_META_FIELD_STRUCT, 0, offsetof(PathV1, points), sizeof(PointV1), 3, 0, &kPointV1Descriptor,
+     nullptr, nullptr, 0},
+    {"weights", STRUCT_META_FIELD_FLOAT, 0, offsetof(PathV1, weights), sizeof(float), 2, 0, nullptr, nullptr, nullptr,
+     0},
+};
+const struct_meta_descriptor kPathV1Descriptor = {"Path", sizeof(PathV1), kPathV1Fields, 2, nullptr};
+
+// 新版。座標を double へ広げて z を追加し、点の数を減らし、重みの数を増やした。
+struct PointV2
+{
+    double y;
+    double x;
+    double z;
+};
+const struct_meta_field kPointV2Fields[] = {
+    {"y", STRUCT_META_FIELD_DOUBLE, 0, offsetof(PointV2, y), sizeof(double), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"x", STRUCT_META_FIELD_DOUBLE, 0, offsetof(PointV2, x), sizeof(double), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"z", STRUCT_META_FIELD_DOUBLE, 0, offsetof(PointV2, z), sizeof(double), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kPointV2Descriptor = {"Point", sizeof(PointV2), kPointV2Fields, 3, nullptr};
+struct PathV2
+{
+    PointV2 points[2];
+    float weights[4];
+};
+const struct_meta_field kPathV2Fields[] = {
+    {"points", STRUCT_META_FIELD_STRUCT, 0, offsetof(PathV2, points), sizeof(PointV2), 2, 0, &kPointV2Descriptor,
+     nullptr, nullptr, 0},
+    {"weights", STRUCT_META_FIELD_FLOAT, 0, offsetof(PathV2, weights), sizeof(float), 4, 0, nullptr, nullptr, nullptr,
+     0},
+};
+const struct_meta_descriptor kPathV2Descriptor = {"Path", sizeof(PathV2), kPathV2Fields, 2, nullptr};
+
+// double を int へ、int を uint8_t へ狭める版。
+struct NarrowV1
+{
+    double ratio;
+    int32_t level;
+};
+const struct_meta_field kNarrowV1Fields[] = {
+    {"ratio", STRUCT_META_FIELD_DOUBLE, 0, offsetof(NarrowV1, ratio), sizeof(double), 1, 0, nullptr, nullptr, nullptr,
+     0},
+    {"level", STRUCT_META_FIELD_INT, 0, offsetof(NarrowV1, level), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr,
+     0},
+};
+const struct_meta_descriptor kNarrowV1Descriptor = {"Narrow", sizeof(NarrowV1), kNarrowV1Fields, 2, nullptr};
+struct NarrowV2
+{
+    int32_t ratio;
+    uint8_t level;
+};
+const struct_meta_field kNarrowV2Fields[] = {
+    {"ratio", STRUCT_META_FIELD_INT, 0, offsetof(NarrowV2, ratio), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr,
+     0},
+    {"level", STRUCT_META_FIELD_UINT8, 0, offsetof(NarrowV2, level), sizeof(uint8_t), 1, 0, nullptr, nullptr, nullptr,
+     0},
+};
+const struct_meta_descriptor kNarrowV2Descriptor = {"Narrow", sizeof(NarrowV2), kNarrowV2Fields, 2, nullptr};
+
+// 変換できない組と、可変長配列を持つ版。
+struct Mismatch
+{
+    char id[8];
+};
+const struct_meta_field kMismatchFields[] = {
+    {"id", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Mismatch, id), sizeof(char), 1, sizeof(Mismatch::id), nullptr,
+     nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kMismatchDescriptor = {"Mismatch", sizeof(Mismatch), kMismatchFields, 1, nullptr};
+struct Dynamic
+{
+    STRUCT_META_SEQUENCE(int) id;
+};
+const struct_meta_field kDynamicFields[] = {
+    {"id", STRUCT_META_FIELD_INT, STRUCT_META_STORAGE_SEQUENCE, offsetof(Dynamic, id), sizeof(int), 1, 0, nullptr,
+     nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kDynamicDescriptor = {"Dynamic", sizeof(Dynamic), kDynamicFields, 1, nullptr};
+} // namespace
+
+TEST(MigrateTest, CopiesIdenticalLayoutInOneOperation)
+{
+    struct_meta_migration migration; // [準備_正常系] - 同じレイアウトの記述子の組を用意する。
+    PersonV1 sources[2];
+    std::memset(sources, 0xA5, sizeof(sources));
+    sources[0].id = 7;
+    std::strcpy(sources[0].name, "alice");
+    sources[1].score = 2.5;
+    PersonV1 targets[2];
+    int ret = struct_meta_migration_init(&kPersonV1Descriptor, &kPersonV1CopyDescriptor, &migration); // [手順_正常系]
+    ASSERT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 構造体全体の複写 1 回とし、全フィールドを複写とすること。
+    EXPECT_EQ(1U, migration.op_count);
+    EXPECT_EQ(migration.source_fingerprint, migration.target_fingerprint);
+    EXPECT_EQ(0U, migration.removed_count);
+    ASSERT_EQ(4U, migration.field_count);
+    for (size_t i = 0; i < migration.field_count; i++)
+    {
+        EXPECT_EQ(STRUCT_META_MIGRATION_COPY, migration.fields[i].action);
+        EXPECT_EQ(0, migration.fields[i].renamed);
+    }
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_migration_apply_array(&migration, sources, 2U, targets));
+    EXPECT_EQ(0, std::memcmp(sources, targets, sizeof(sources)));
+    struct_meta_migration_dispose(&migration);
+    EXPECT_EQ(nullptr, migration.plan);
+}
+
+TEST(MigrateTest, MapsRenamedRemovedAndAddedFields)
+{
+    struct_meta_migration migration; // [準備_正常系] - 改名、削除、追加、並べ替えを含む 2 版を用意する。
+    PersonV1 source;
+    std::memset(&source, 0, sizeof(source));
+    source.id = -42;
+    std::strcpy(source.name, "bob");
+    source.score = 1.25;
+    source.legacy = 99;
+    PersonV2 target;
+    std::memset(&target, 0xFF, sizeof(target));
+    int ret = struct_meta_migration_init(&kPersonV1Descriptor, &kPersonV2Descriptor, &migration); // [手順_正常系]
+    ASSERT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 名前、JSON キーの順に対応付け、対応しないフィールドを記録すること。
+    EXPECT_NE(migration.source_fingerprint, migration.target_fingerprint);
+    ASSERT_EQ(4U, migration.field_count);
+    EXPECT_EQ(&kPersonV1Fields[2], migration.fields[0].source);
+    EXPECT_EQ(STRUCT_META_MIGRATION_COPY, migration.fields[0].action);
+    EXPECT_EQ(&kPersonV1Fields[0], migration.fields[1].source);
+    EXPECT_EQ(STRUCT_META_MIGRATION_CONVERT, migration.fields[1].action);
+    EXPECT_EQ(1, migration.fields[1].renamed);
+    EXPECT_EQ(STRUCT_META_MIGRATION_CONVERT, migration.fields[2].action);
+    EXPECT_EQ(nullptr, migration.fields[3].source);
+    EXPECT_EQ(STRUCT_META_MIGRATION_ADDED, migration.fields[3].action);
+    ASSERT_EQ(1U, migration.removed_count);
+    EXPECT_EQ(&kPersonV1Fields[3], migration.removed[0]);
+
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_migration_apply(&migration, &source, &target)); // [確認_正常系] - 値を移すこと。
+    EXPECT_EQ(1.25, target.score);
+    EXPECT_EQ(-42, target.person_id);
+    EXPECT_STREQ("bob", target.name);
+    EXPECT_EQ(0, target.added);
+
+    std::strcpy(source.name, "too-long"); // [確認_異常系] - 移行先の char 配列に収まらない文字列を拒否すること。
+    EXPECT_EQ(COM_UTIL_ERR_OUT_OF_RANGE, struct_meta_migration_apply(&migration, &source, &target));
+    struct_meta_migration_dispose(&migration);
+}
+
+TEST(MigrateTest, MergesCopiesAndZeroesAddedFields)
+{
+    struct_meta_migration migration; // [準備_正常系] - 途中へ追加し、末尾を削除した 2 版を用意する。
+    RowV1 source = {1, 2, 3, 4};
+    RowV2 target;
+    std::memset(&target, 0xFF, sizeof(target));
+    int ret = struct_meta_migration_init(&kRowV1Descriptor, &kRowV2Descriptor, &migration); // [手順_正常系]
+    ASSERT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - a と b を 1 回の複写へまとめ、追加した範囲を上書きしないこと。
+    EXPECT_EQ(2U, migration.op_count);
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_migration_apply(&migration, &source, &target));
+    EXPECT_EQ(1, target.a);
+    EXPECT_EQ(2, target.b);
+    EXPECT_EQ(0, target.inserted);
+    EXPECT_EQ(3, target.c);
+    struct_meta_migration_dispose(&migration);
+
+    RowV1 replaced; // [確認_正常系] - 大きさが同じでも、末尾の置き換えは全体の複写としないこと。
+    std::memset(&replaced, 0xFF, sizeof(replaced));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_migration_init(&kRowV1Descriptor, &kRowV3Descriptor, &migration));
+    EXPECT_EQ(1U, migration.op_count);
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_migration_apply(&migration, &source, &replaced));
+    EXPECT_EQ(3, replaced.c);
+    EXPECT_EQ(0, replaced.d);
+    struct_meta_migration_dispose(&migration);
+}
+
+TEST(MigrateTest, ConvertsNestedStructsAndResizedArrays)
+{
+    struct_meta_migration migration; // [準備_正常系] - ネスト先の型と配列の要素数が変わった 2 版を用意する。
+    PathV1 source;
+    std::memset(&source, 0, sizeof(source));
+    for (int i = 0; i < 3; i++)
+    {
+        source.points[i].x = static_cast<int16_t>(i + 1);
+        source.points[i].y = static_cast<int16_t>(-(i + 1));
+    }
+    source.weights[0] = 0.5F;
+    source.weights[1] = 1.5F;
+    PathV2 target;
+    std::memset(&target, 0xFF, sizeof(target));
+    int ret = struct_meta_migration_init(&kPathV1Descriptor, &kPathV2Descriptor, &migration); // [手順_正常系]
+    ASSERT_EQ(COM_UTIL_OK, ret);
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_migration_apply(&migration, &source, &target));
+    // [確認_正常系] - 共通の要素数だけを移し、残りの要素と追加したフィールドを 0 とすること。
+    EXPECT_EQ(STRUCT_META_MIGRATION_CONVERT, migration.fields[0].action);
+    EXPECT_EQ(STRUCT_META_MIGRATION_CONVERT, migration.fields[1].action);
+    EXPECT_EQ(1.0, target.points[0].x);
+    EXPECT_EQ(-1.0, target.points[0].y);
+    EXPECT_EQ(0.0, target.points[0].z);
+    EXPECT_EQ(2.0, target.points[1].x);
+    EXPECT_EQ(-2.0, target.points[1].y);
+    EXPECT_EQ(0.5F, target.weights[0]);
+    EXPECT_EQ(1.5F, target.weights[1]);
+    EXPECT_EQ(0.0F, target.weights[2]);
+    EXPECT_EQ(0.0F, target.weights[3]);
+    struct_meta_migration_dispose(&migration);
+}
+
+TEST(MigrateTest, RejectsValuesOutsideTargetRange)
+{
+    struct_meta_migration migration; // [準備_異常系] - 値を狭い型へ移す 2 版を用意する。
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_migration_init(&kNarrowV1Descriptor, &kNarrowV2Descriptor, &migration));
+    NarrowV1 source = {3.0, 200};
+    NarrowV2 target;
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_migration_apply(&migration, &source, &target)); // [手順_正常系]
+    EXPECT_EQ(3, target.ratio);                                                      // [確認_正常系]
+    EXPECT_EQ(200U, target.level);
+    // [手順_異常系] [確認_異常系] - 収まらない整数と、小数部を持つ値を拒否すること。
+    source.level = 256;
+    EXPECT_EQ(COM_UTIL_ERR_OUT_OF_RANGE, struct_meta_migration_apply(&migration, &source, &target));
+    source.level = 1;
+    source.ratio = 0.5;
+    EXPECT_EQ(COM_UTIL_ERR_OUT_OF_RANGE, struct_meta_migration_apply(&migration, &source, &target));
+    struct_meta_migration_dispose(&migration);
+}
+
+TEST(MigrateTest, RejectsUnsupportedPairsAndInvalidArguments)
+{
+    struct_meta_migration migration; // [準備_異常系]
+    PersonV1 source;
+    PersonV1 target;
+    // [手順_異常系] [確認_異常系] - 数値と char 配列の組、可変長配列、引数の不足を拒否すること。
+    EXPECT_EQ(COM_UTIL_ERR_UNSUPPORTED,
+              struct_meta_migration_init(&kMismatchDescriptor, &kPersonV1Descriptor, &migration));
+    EXPECT_EQ(nullptr, migration.plan);
+    EXPECT_EQ(COM_UTIL_ERR_UNSUPPORTED,
+              struct_meta_migration_init(&kDynamicDescriptor, &kPersonV1Descriptor, &migration));
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, struct_meta_migration_init(nullptr, &kPersonV1Descriptor, &migration));
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, struct_meta_migration_init(&kPersonV1Descriptor, nullptr, &migration));
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT,
+              struct_meta_migration_init(&kPersonV1Descriptor, &kPersonV1Descriptor, nullptr));
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, struct_meta_migration_apply(&migration, &source, &target));
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, struct_meta_migration_apply_array(nullptr, &source, 1U, &target));
+    struct_meta_migration_dispose(nullptr);
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <struct_meta/access/access.h>
+#include <struct_meta/print/print.h>
+#include <struct_meta/store/mmap_store.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Point
+{
+    int x;
+    int pad;
+    double y;
+};
+struct Record
+{
+    int id;
+    char label[12];
+    Point points[2];
+};
+struct Renamed
+{
+    int key;
+    char label[12];
+    Point points[2];
+};
+const struct_meta_field kPointFields[] = {
+    {"x", STRUCT_META_FIELD_INT, 0, offsetof(Point, x), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"y", STRUCT_META_FIELD_DOUBLE, 0, offsetof(Point, y), sizeof(double), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kPointDescriptor = {"Point", sizeof(Point), kPointFields, 2, nullptr};
+const struct_meta_field kRecordFields[] = {
+    {"id", STRUCT_META_FIELD_INT, 0, offsetof(Record, id), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"label", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Record, label), sizeof(char), 1, sizeof(Record::label),
+     nullptr, nullptr, nullptr, 0},
+    {"points", STRUCT_META_FIELD_STRUCT, 0, offsetof(Record, points), sizeof(Point), 2, 0, &kPointDescriptor, nullptr,
+     nullptr, 0},
+};
+const struct_meta_descriptor kRecordDescriptor = {"Record", sizeof(Record), kRecordFields, 3, nullptr};
+const struct_meta_field kRenamedFields[] = {
+    {"key", STRUCT_META_FIELD_INT, 0, offsetof(Renamed, key), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"label", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Renamed, label), sizeof(char), 1, sizeof(Renamed::label),
+     nullptr, nullptr, nullptr, 0},
+    {"points", STRUCT_META_FIELD_STRUCT, 0, offsetof(Renamed, points), sizeof(Point), 2, 0, &kPointDescriptor,
+     nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kRenamedDescriptor = {"Record", sizeof(Renamed), kRenamedFields, 3, nullptr};
+
+std::string StorePath(const char *name)
+{
+    return testing::TempDir() + name;
+}
+
+std::vector<Record> MakeRecords(size_t count)
+{
+    std::vector<Record> records(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        std::memset(&records[i], 0x5A, sizeof(Record));
+        records[i].id = static_cast<int>(i);
+        std::snprintf(records[i].label, sizeof(records[i].label), "r%zu", i % 100000U);
+        records[i].points[1].x = static_cast<int>(i * 2U);
+        records[i].points[1].y = static_cast<double>(i) / 4.0;
+        records[i].points[0].x = 0;
+        records[i].points[0].y = 0.0;
+    }
+    return records;
+}
+} // namespace
+
+TEST(MmapStoreTest, MapsRecordsForPathAndPrintApis)
+{
+    std::string path = StorePath("mmapStoreTest_records.bin"); // [準備_正常系] - ネストと char 配列を含むレコードを書き出す。
+    std::vector<Record> records = MakeRecords(1000);
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_mmap_store_write(&kRecordDescriptor, records.data(), records.size(), 0,
+                                                        path.c_str()));
+    struct_meta_mmap_store store = {};
+    int opened = struct_meta_mmap_store_open(&kRecordDescriptor, path.c_str(), &store); // [手順_正常系]
+    const void *record = nullptr;
+    const struct_meta_field *field = nullptr;
+    const void *value = nullptr;
+    int fetched = struct_meta_mmap_store_record(&store, 999, &record);
+    int resolved = struct_meta_path_resolve_const(&kRecordDescriptor, record, "points[1].y", &field, &value);
+    FILE *stream = std::tmpfile();
+    ASSERT_NE(nullptr, stream);
+    int printed = struct_meta_print_write(&kRecordDescriptor, record, stream);
+    std::rewind(stream);
+    char text[4096] = {};
+    size_t text_length = std::fread(text, 1, sizeof(text) - 1U, stream);
+    std::fclose(stream);
+    EXPECT_EQ(COM_UTIL_OK, opened); // [確認_正常系] - マップした領域のレコードを、そのまま既存 API へ渡せること。
+    EXPECT_EQ(COM_UTIL_OK, fetched);
+    EXPECT_EQ(COM_UTIL_OK, resolved);
+    EXPECT_EQ(COM_UTIL_OK, printed);
+    EXPECT_EQ(1000U, store.count);
+    EXPECT_EQ(sizeof(Record), store.stride);
+    EXPECT_EQ(store.records + (999U * sizeof(Record)), record);
+    EXPECT_EQ(999.0 / 4.0, *static_cast<const double *>(value));
+    EXPECT_NE(nullptr, std::strstr(std::string(text, text_length).c_str(), "r999"));
+    EXPECT_EQ(0, static_cast<const Record *>(record)->points[1].pad);
+    EXPECT_EQ(COM_UTIL_ERR_OUT_OF_RANGE, struct_meta_mmap_store_record(&store, 1000, &record));
+    struct_meta_mmap_store_close(&store);
+    struct_meta_mmap_store_close(&store);
+    EXPECT_EQ(nullptr, store.map_base);
+    std::remove(path.c_str());
+}
+
+TEST(MmapStoreTest, OpensEmptyStore)
+{
+    std::string path = StorePath("mmapStoreTest_empty.bin"); // [準備_正常系] - レコードのないストアを書き出す。
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_mmap_store_write(&kRecordDescriptor, nullptr, 0, 0, path.c_str()));
+    struct_meta_mmap_store store = {};
+    const void *record = nullptr;
+    int opened = struct_meta_mmap_store_open(&kRecordDescriptor, path.c_str(), &store); // [手順_正常系]
+    EXPECT_EQ(COM_UTIL_OK, opened); // [確認_正常系] - レコード数 0 で開けること。
+    EXPECT_EQ(0U, store.count);
+    EXPECT_EQ(COM_UTIL_ERR_OUT_OF_RANGE, struct_meta_mmap_store_record(&store, 0, &record));
+    struct_meta_mmap_store_close(&store);
+    std::remove(path.c_str());
+}
+
+TEST(MmapStoreTest, RejectsMismatchedOrTruncatedStore)
+{
+    std::string path = StorePath("mmapStoreTest_broken.bin"); // [準備_異常系] - 異なる記述子、切り詰めたファイルを用意する。
+    std::vector<Record> records = MakeRecords(4);
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_mmap_store_write(&kRecordDescriptor, records.data(), records.size(), 0,
+                                                        path.c_str()));
+    struct_meta_mmap_store store = {};
+    int mismatched = struct_meta_mmap_store_open(&kRenamedDescriptor, path.c_str(), &store); // [手順_異常系]
+    FILE *stream = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(nullptr, stream);
+    std::vector<unsigned char> content(STRUCT_META_MMAP_STORE_HEADER_SIZE + (3U * sizeof(Record)));
+    ASSERT_EQ(content.size(), std::fread(content.data(), 1, content.size(), stream));
+    std::fclose(stream);
+    stream = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(nullptr, stream);
+    ASSERT_EQ(content.size(), std::fwrite(content.data(), 1, content.size(), stream));
+    std::fclose(stream);
+    int truncated = struct_meta_mmap_store_open(&kRecordDescriptor, path.c_str(), &store);
+    int missing = struct_meta_mmap_store_open(&kRecordDescriptor, StorePath("mmapStoreTest_none.bin").c_str(), &store);
+    EXPECT_EQ(COM_UTIL_ERR_UNSUPPORTED, mismatched); // [確認_異常系] - いずれも開かず、ストアを変更しないこと。
+    EXPECT_EQ(COM_UTIL_ERR_EOF, truncated);
+    EXPECT_EQ(COM_UTIL_ERR_NOT_FOUND, missing);
+    EXPECT_EQ(nullptr, store.map_base);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <struct_meta/json/ndjson.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Record
+{
+    int id;
+    int pad;
+    double value;
+    char label[16];
+};
+struct Note
+{
+    int id;
+    char text[6000];
+};
+const struct_meta_attribute kIdAttributes[] = {{"json.required", nullptr}};
+const struct_meta_field kRecordFields[] = {
+    {"id", STRUCT_META_FIELD_INT, 0, offsetof(Record, id), sizeof(int), 1, 0, nullptr, nullptr, kIdAttributes, 1},
+    {"value", STRUCT_META_FIELD_DOUBLE, 0, offsetof(Record, value), sizeof(double), 1, 0, nullptr, nullptr, nullptr,
+     0},
+    {"label", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Record, label), sizeof(char), 1, sizeof(Record::label),
+     nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kRecordDescriptor = {"Record", sizeof(Record), kRecordFields, 3, nullptr};
+const struct_meta_descriptor kTruncatedDescriptor = {"Record", sizeof(int), kRecordFields, 3, nullptr};
+const struct_meta_field kNoteFields[] = {
+    {"id", STRUCT_META_FIELD_INT, 0, offsetof(Note, id), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"text", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Note, text), sizeof(char), 1, sizeof(Note::text), nullptr,
+     nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kNoteDescriptor = {"Note", sizeof(Note), kNoteFields, 2, nullptr};
+
+FILE *OpenText(const std::string &text)
+{
+    FILE *stream = std::tmpfile();
+    if (stream != nullptr)
+    {
+        std::fwrite(text.data(), 1, text.size(), stream);
+        std::rewind(stream);
+    }
+    return stream;
+}
+
+std::string ReadAll(FILE *stream)
+{
+    std::string text;
+    char chunk[4096];
+    size_t length;
+    std::rewind(stream);
+    while ((length = std::fread(chunk, 1, sizeof(chunk), stream)) > 0U)
+    {
+        text.append(chunk, length);
+    }
+    return text;
+}
+} // namespace
+
+TEST(NdjsonStreamTest, WritesAndReadsOneRecordPerLine)
+{
+    FILE *stream = std::tmpfile(); // [準備_正常系] - 3 レコードを書き出すストリームを用意する。
+    ASSERT_NE(nullptr, stream);
+    Record records[3] = {{1, 0, 0.5, "a"}, {2, 0, -1.0, "b\nc"}, {3, 0, 1e300, ""}};
+    struct_meta_ndjson_writer writer;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_ndjson_writer_init(&writer, stream));
+    for (const Record &record : records) // [手順_正常系]
+    {
+        EXPECT_EQ(COM_UTIL_OK, struct_meta_ndjson_writer_append(&writer, &kRecordDescriptor, &record));
+    }
+    int flushed = struct_meta_ndjson_writer_flush(&writer);
+    size_t written = writer.record_count;
+    struct_meta_ndjson_writer_dispose(&writer);
+    std::string text = ReadAll(stream);
+    std::rewind(stream);
+    struct_meta_ndjson_reader reader;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_ndjson_reader_init(&reader, stream, 0));
+    std::vector<Record> loaded;
+    Record record;
+    std::memset(&record, 0x5A, sizeof(record));
+    int ret;
+    while ((ret = struct_meta_ndjson_reader_next(&reader, &kRecordDescriptor, &record)) == COM_UTIL_OK)
+    {
+        loaded.push_back(record);
+    }
+    size_t lines = reader.line_number;
+    struct_meta_ndjson_reader_dispose(&reader);
+    std::fclose(stream);
+    EXPECT_EQ(COM_UTIL_OK, flushed); // [確認_正常系] - 1 行 1 レコードの空白なしテキストとなり、同じ値を読み戻せること。
+    EXPECT_EQ(3U, written);
+    EXPECT_EQ("{\"id\":1,\"value\":0.5,\"label\":\"a\"}\n"
+              "{\"id\":2,\"value\":-1,\"label\":\"b\\nc\"}\n"
+              "{\"id\":3,\"value\":1e+300,\"label\":\"\"}\n",
+              text);
+    EXPECT_EQ(COM_UTIL_ERR_EOF, ret);
+    EXPECT_EQ(3U, lines);
+    ASSERT_EQ(3U, loaded.size());
+    for (size_t i = 0; i < 3U; i++)
+    {
+        EXPECT_EQ(records[i].id, loaded[i].id);
+        EXPECT_EQ(records[i].value, loaded[i].value);
+        EXPECT_STREQ(records[i].label, loaded[i].label);
+        EXPECT_EQ(0, loaded[i].pad);
+    }
+}
+
+TEST(NdjsonStreamTest, ReadsLinesSpanningChunks)
+{
+    std::string text; // [準備_正常系] - チャンクより長い行と、改行で終わらない最後の行を含むテキストを用意する。
+    for (int i = 0; i < 20; i++)
+    {
+        std::string body(static_cast<size_t>(1000 + (i * 250)), static_cast<char>('a' + i));
+        text += "{\"id\":" + std::to_string(i) + ",\"text\":\"" + body + "\"}\r\n";
+    }
+    text += "{\"id\":20,\"text\":\"end\"}";
+    FILE *stream = OpenText(text);
+    ASSERT_NE(nullptr, stream);
+    struct_meta_ndjson_reader reader;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_ndjson_reader_init(&reader, stream, 8192));
+    static Note note;
+    std::vector<size_t> lengths;
+    int ret; // [手順_正常系]
+    while ((ret = struct_meta_ndjson_reader_next(&reader, &kNoteDescriptor, &note)) == COM_UTIL_OK)
+    {
+        EXPECT_EQ(static_cast<int>(lengths.size()), note.id);
+        lengths.push_back(std::strlen(note.text));
+    }
+    size_t lines = reader.line_number;
+    struct_meta_ndjson_reader_dispose(&reader);
+    std::fclose(stream);
+    EXPECT_EQ(COM_UTIL_ERR_EOF, ret); // [確認_正常系] - 行の長さに関わらず、全レコードを順に読み込むこと。
+    EXPECT_EQ(21U, lines);
+    ASSERT_EQ(21U, lengths.size());
+    EXPECT_EQ(1000U, lengths[0]);
+    EXPECT_EQ(5750U, lengths[19]);
+    EXPECT_EQ(3U, lengths[20]);
+}
+
+TEST(NdjsonStreamTest, ReportsLineNumberAndContinuesAfterError)
+{
+    std::string text = "{\"id\":1}\n" // [準備_異常系] - 空行、構文エラー、後続テキスト、必須キーの欠落、長すぎる行を含める。
+                       "\n"
+                       "   \t\r\n"
+                       "{\"id\":2,}\n"
+                       "{\"id\":3} {\"id\":4}\n"
+                       "{\"value\":1}\n" +
+                       std::string("{\"id\":5,\"label\":\"") + std::string(100, 'x') + "\"}\n"
+                       "{\"id\":6}\n";
+    FILE *stream = OpenText(text);
+    ASSERT_NE(nullptr, stream);
+    struct_meta_ndjson_reader reader;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_ndjson_reader_init(&reader, stream, 64));
+    Record record = {};
+    std::vector<int> results; // [手順_異常系]
+    std::vector<size_t> lines;
+    std::vector<int> ids;
+    for (int i = 0; i < 7; i++)
+    {
+        results.push_back(struct_meta_ndjson_reader_next(&reader, &kRecordDescriptor, &record));
+        lines.push_back(reader.line_number);
+        ids.push_back(record.id);
+    }
+    struct_meta_ndjson_reader_dispose(&reader);
+    std::fclose(stream);
+    EXPECT_EQ(COM_UTIL_OK, results[0]); // [確認_異常系] - エラーの行番号を報告し、次の行から続けて読み込むこと。
+    EXPECT_EQ(1U, lines[0]);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, results[1]);
+    EXPECT_EQ(4U, lines[1]);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, results[2]);
+    EXPECT_EQ(5U, lines[2]);
+    EXPECT_EQ(COM_UTIL_ERR_MISSING_REQUIRED, results[3]);
+    EXPECT_EQ(6U, lines[3]);
+    EXPECT_EQ(COM_UTIL_ERR_BUFFER_TOO_SMALL, results[4]);
+    EXPECT_EQ(7U, lines[4]);
+    EXPECT_EQ(COM_UTIL_OK, results[5]);
+    EXPECT_EQ(8U, lines[5]);
+    EXPECT_EQ(6, ids[5]);
+    EXPECT_EQ(COM_UTIL_ERR_EOF, results[6]);
+}
+
+TEST(NdjsonStreamTest, KeepsStreamCleanWhenRecordFails)
+{
+    FILE *stream = std::tmpfile(); // [準備_異常系] - 構造体サイズとフィールドの範囲が矛盾する記述子を用意する。
+    ASSERT_NE(nullptr, stream);
+    Record good = {7, 0, 1.0, "ok"};
+    struct_meta_ndjson_writer writer;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_ndjson_writer_init(&writer, stream));
+    int failed = struct_meta_ndjson_writer_append(&writer, &kTruncatedDescriptor, &good); // [手順_異常系]
+    int appended = struct_meta_ndjson_writer_append(&writer, &kRecordDescriptor, &good);
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_ndjson_writer_flush(&writer));
+    size_t written = writer.record_count;
+    struct_meta_ndjson_writer_dispose(&writer);
+    std::string text = ReadAll(stream);
+    std::fclose(stream);
+    EXPECT_NE(COM_UTIL_OK, failed); // [確認_異常系] - 失敗したレコードを出力せず、後続のレコードを追記できること。
+    EXPECT_EQ(COM_UTIL_OK, appended);
+    EXPECT_EQ(1U, written);
+    EXPECT_EQ("{\"id\":7,\"value\":1,\"label\":\"ok\"}\n", text);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <struct_meta/access/access.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+
+namespace
+{
+struct Address
+{
+    char city[8];
+    int zip;
+};
+struct Person
+{
+    int id;
+    Address addresses[2];
+};
+const struct_meta_field kAddressFields[] = {
+    {"city", STRUCT_META_FIELD_CHAR_ARRAY, 0, offsetof(Address, city), sizeof(char), 1, sizeof(Address::city), nullptr,
+     nullptr, nullptr, 0},
+    {"zip", STRUCT_META_FIELD_INT, 0, offsetof(Address, zip), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kAddressDescriptor = {"Address", sizeof(Address), kAddressFields, 2, nullptr};
+const struct_meta_field kPersonFields[] = {
+    {"id", STRUCT_META_FIELD_INT, 0, offsetof(Person, id), sizeof(int), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"addresses", STRUCT_META_FIELD_STRUCT, 0, offsetof(Person, addresses), sizeof(Address), 2, 0,
+     &kAddressDescriptor, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kPersonDescriptor = {"Person", sizeof(Person), kPersonFields, 2, nullptr};
+} // namespace
+
+TEST(PathHandleTest, AppliesCompiledPathLikeResolve)
+{
+    Person person = {}; // [準備_正常系] - ネスト配列を含むパスを用意する。
+    struct_meta_path_handle handle;
+    const struct_meta_field *field = nullptr;
+    void *resolved = nullptr;
+    void *applied = nullptr;
+    const void *applied_const = nullptr;
+    int compiled = struct_meta_path_compile(&kPersonDescriptor, "addresses[1].zip", &handle); // [手順_正常系]
+    int ret = struct_meta_path_resolve(&kPersonDescriptor, &person, "addresses[1].zip", &field, &resolved);
+    int apply = struct_meta_path_apply(&handle, &person, &applied);
+    int apply_const = struct_meta_path_apply_const(&handle, &person, &applied_const);
+    EXPECT_EQ(COM_UTIL_OK, compiled); // [確認_正常系] - 文字列パスの解決と同じフィールドとアドレスを得ること。
+    EXPECT_EQ(COM_UTIL_OK, ret);
+    EXPECT_EQ(COM_UTIL_OK, apply);
+    EXPECT_EQ(COM_UTIL_OK, apply_const);
+    EXPECT_EQ(field, handle.field);
+    EXPECT_EQ(STRUCT_META_FIELD_INT, handle.kind);
+    EXPECT_EQ(sizeof(int), handle.size);
+    EXPECT_EQ(offsetof(Person, addresses) + sizeof(Address) + offsetof(Address, zip), handle.offset);
+    EXPECT_EQ(&person.addresses[1].zip, applied);
+    EXPECT_EQ(&person.addresses[1].zip, applied_const);
+    EXPECT_EQ(resolved, applied);
+}
+
+TEST(PathHandleTest, AppliesHandleAcrossArray)
+{
+    Person people[3] = {}; // [準備_正常系] - 構造体配列と終端値の格納先を用意する。
+    struct_meta_path_handle handle;
+    void *values[3] = {};
+    int compiled = struct_meta_path_compile(&kPersonDescriptor, "addresses[0].city", &handle); // [手順_正常系]
+    int ret = struct_meta_path_apply_batch(&handle, people, 3, 0, values);
+    EXPECT_EQ(COM_UTIL_OK, compiled); // [確認_正常系] - 要素ごとの終端値のアドレスを得ること。
+    EXPECT_EQ(COM_UTIL_OK, ret);
+    for (size_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(people[i].addresses[0].city, values[i]);
+    }
+}
+
+TEST(PathHandleTest, AppliesHandleAcrossEmbeddedRecordsWithStride)
+{
+    struct Entry // [準備_正常系] - より大きな構造体に埋め込まれた要素の配列を用意する。
+    {
+        double weight;
+        Person person;
+        char tag[3];
+    };
+    Entry entries[3] = {};
+    struct_meta_path_handle handle;
+    void *values[3] = {};
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_path_compile(&kPersonDescriptor, "addresses[1].zip", &handle));
+    int ret = struct_meta_path_apply_batch(&handle, &entries[0].person, 3, sizeof(Entry), values); // [手順_正常系]
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 指定した間隔で要素ごとの終端値のアドレスを得ること。
+    for (size_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(&entries[i].person.addresses[1].zip, values[i]);
+    }
+}
+
+TEST(PathHandleTest, RejectsStrideSmallerThanDescriptor)
+{
+    Person people[2] = {}; // [準備_異常系] - 要素が重なる間隔を用意する。
+    struct_meta_path_handle handle;
+    void *values[2] = {};
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_path_compile(&kPersonDescriptor, "id", &handle));
+    int ret = struct_meta_path_apply_batch(&handle, people, 2, sizeof(Person) - 1U, values); // [手順_異常系]
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, ret); // [確認_異常系] - 引数エラーとなること。
+}
+
+TEST(PathHandleTest, RejectsInvalidPathAndEmptyHandle)
+{
+    Person person = {}; // [準備_異常系] - 範囲外の添字と、解決に失敗したハンドルを用意する。
+    struct_meta_path_handle handle;
+    void *value = &person;
+    int compiled = struct_meta_path_compile(&kPersonDescriptor, "addresses[2].zip", &handle); // [手順_異常系]
+    int missing = struct_meta_path_compile(&kPersonDescriptor, "addresses[0].street", &handle);
+    int apply = struct_meta_path_apply(&handle, &person, &value);
+    EXPECT_EQ(COM_UTIL_ERR_OUT_OF_RANGE, compiled); // [確認_異常系] - 解決エラーを報告し、空のハンドルを適用しないこと。
+    EXPECT_EQ(COM_UTIL_ERR_NOT_FOUND, missing);
+    EXPECT_EQ(nullptr, handle.field);
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, apply);
+}
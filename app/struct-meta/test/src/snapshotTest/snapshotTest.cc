@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+#include <struct_meta/snapshot/snapshot.h>
+#include <com_util/base/result.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct Config
+{
+    int interval;
+    int doubled;
+    char *label;
+};
+const struct_meta_field kConfigFields[] = {
+    {"interval", STRUCT_META_FIELD_INT, STRUCT_META_STORAGE_INLINE, offsetof(Config, interval), sizeof(int), 1, 0,
+     nullptr, nullptr, nullptr, 0},
+    {"doubled", STRUCT_META_FIELD_INT, STRUCT_META_STORAGE_INLINE, offsetof(Config, doubled), sizeof(int), 1, 0,
+     nullptr, nullptr, nullptr, 0},
+    {"label", STRUCT_META_FIELD_STRING, STRUCT_META_STORAGE_INLINE, offsetof(Config, label), sizeof(char *), 1, 0,
+     nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kConfigDescriptor = {"Config", sizeof(Config), kConfigFields, 3, nullptr};
+
+// 設定ファイルから読み込む版。ファイルの読み込みは文字列と可変長配列を扱わないため、char 配列とする。
+struct FileConfig
+{
+    int interval;
+    char label[16];
+};
+const struct_meta_field kFileConfigFields[] = {
+    {"interval", STRUCT_META_FIELD_INT, STRUCT_META_STORAGE_INLINE, offsetof(FileConfig, interval), sizeof(int), 1, 0,
+     nullptr, nullptr, nullptr, 0},
+    {"label", STRUCT_META_FIELD_CHAR_ARRAY, STRUCT_META_STORAGE_INLINE, offsetof(FileConfig, label), sizeof(char), 1,
+     sizeof(FileConfig::label), nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kFileConfigDescriptor = {"FileConfig", sizeof(FileConfig), kFileConfigFields, 2, nullptr};
+
+// malloc() で確保した、公開できるインスタンスを作る。
+Config *NewConfig(int interval, const char *label)
+{
+    Config *config = static_cast<Config *>(std::calloc(1U, sizeof(Config)));
+    config->interval = interval;
+    config->doubled = interval * 2;
+    if (label != nullptr)
+    {
+        config->label = static_cast<char *>(std::malloc(std::strlen(label) + 1U));
+        std::strcpy(config->label, label);
+    }
+    return config;
+}
+
+std::string TempPath(const char *name)
+{
+    return testing::TempDir() + name;
+}
+
+void WriteText(const std::string &path, const char *text)
+{
+    FILE *file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(nullptr, file);
+    std::fwrite(text, 1, std::strlen(text), file);
+    std::fclose(file);
+}
+} // namespace
+
+TEST(SnapshotTest, PinsPublishedVersion)
+{
+    struct_meta_snapshot snapshot; // [準備_正常系] - 読み手を 1 個登録する。
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_init(&snapshot, &kConfigDescriptor, 2U));
+    struct_meta_snapshot_reader *reader = nullptr;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_reader_attach(&snapshot, &reader));
+    const void *before = struct_meta_snapshot_pin(reader); // [手順_正常系] - 公開の前後で pin する。
+    struct_meta_snapshot_unpin(reader);
+    Config *first = NewConfig(10, "first");
+    int ret = struct_meta_snapshot_publish(&snapshot, first);
+    const Config *pinned = static_cast<const Config *>(struct_meta_snapshot_pin(reader));
+    EXPECT_EQ(nullptr, before); // [確認_正常系] - 公開前は NULL、公開後は公開した版を得ること。
+    EXPECT_EQ(COM_UTIL_OK, ret);
+    ASSERT_EQ(first, pinned);
+    EXPECT_EQ(10, pinned->interval);
+    EXPECT_STREQ("first", pinned->label);
+    EXPECT_EQ(0U, snapshot.retired_count);
+    struct_meta_snapshot_unpin(reader);
+    struct_meta_snapshot_reader_detach(reader);
+    struct_meta_snapshot_dispose(&snapshot);
+    EXPECT_EQ(nullptr, snapshot.readers);
+}
+
+TEST(SnapshotTest, KeepsOldVersionUntilLastReaderUnpins)
+{
+    struct_meta_snapshot snapshot; // [準備_正常系] - 旧版を pin した読み手と、pin していない読み手を用意する。
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_init(&snapshot, &kConfigDescriptor, 2U));
+    struct_meta_snapshot_reader *slow = nullptr;
+    struct_meta_snapshot_reader *fast = nullptr;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_reader_attach(&snapshot, &slow));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_reader_attach(&snapshot, &fast));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_publish(&snapshot, NewConfig(1, "one")));
+    const Config *old_version = static_cast<const Config *>(struct_meta_snapshot_pin(slow));
+    // [手順_正常系] - pin 中に 2 回公開する。
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_publish(&snapshot, NewConfig(2, "two")));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_publish(&snapshot, NewConfig(3, "three")));
+    const Config *new_version = static_cast<const Config *>(struct_meta_snapshot_pin(fast));
+    struct_meta_snapshot_unpin(fast);
+    // [確認_正常系] - pin した時点より後に置き換えた旧版も、pin の解除まで解放しないこと。
+    EXPECT_EQ(1, old_version->interval);
+    EXPECT_STREQ("one", old_version->label);
+    EXPECT_EQ(3, new_version->interval);
+    EXPECT_EQ(2U, snapshot.retired_count);
+    EXPECT_EQ(2U, struct_meta_snapshot_reclaim(&snapshot));
+    struct_meta_snapshot_unpin(slow); // [確認_正常系] - unpin の後の回収で解放すること。
+    EXPECT_EQ(0U, struct_meta_snapshot_reclaim(&snapshot));
+    struct_meta_snapshot_reader_detach(slow);
+    struct_meta_snapshot_reader_detach(fast);
+    struct_meta_snapshot_dispose(&snapshot);
+}
+
+TEST(SnapshotTest, PlacesReadersOnSeparateCacheLines)
+{
+    struct_meta_snapshot snapshot; // [準備_正常系] - 読み手の枠を 3 個用意する。
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_init(&snapshot, &kConfigDescriptor, 3U));
+    struct_meta_snapshot_reader *readers[3] = {};
+    for (struct_meta_snapshot_reader *&reader : readers) // [手順_正常系] - すべての枠を確保する。
+    {
+        ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_reader_attach(&snapshot, &reader));
+    }
+    for (struct_meta_snapshot_reader *reader : readers) // [確認_正常系] - 各枠が 64 バイト境界から始まること。
+    {
+        EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(reader) % 64U);
+        struct_meta_snapshot_reader_detach(reader);
+    }
+    struct_meta_snapshot_dispose(&snapshot);
+}
+
+TEST(SnapshotTest, LoadsFileIntoNewVersion)
+{
+    std::string path = TempPath("snapshotTest_config.json"); // [準備_正常系] - 設定ファイルを用意する。
+    WriteText(path, "{\"interval\": 30, \"label\": \"loaded\"}");
+    struct_meta_snapshot snapshot;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_init(&snapshot, &kFileConfigDescriptor, 1U));
+    struct_meta_snapshot_reader *reader = nullptr;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_reader_attach(&snapshot, &reader));
+    int ret = struct_meta_snapshot_load_file(&snapshot, path.c_str()); // [手順_正常系]
+    const FileConfig *loaded = static_cast<const FileConfig *>(struct_meta_snapshot_pin(reader));
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 読み込んだ値を新しい版として公開すること。
+    ASSERT_NE(nullptr, loaded);
+    EXPECT_EQ(30, loaded->interval);
+    EXPECT_STREQ("loaded", loaded->label);
+    struct_meta_snapshot_unpin(reader);
+
+    WriteText(path, "{\"interval\": 40, \"label\": \"too long for the label\"}"); // [準備_異常系]
+    ret = struct_meta_snapshot_load_file(&snapshot, path.c_str());                     // [手順_異常系]
+    const FileConfig *kept = static_cast<const FileConfig *>(struct_meta_snapshot_pin(reader));
+    EXPECT_NE(COM_UTIL_OK, ret); // [確認_異常系] - 読み込みに失敗した場合は公開中の版を変えないこと。
+    EXPECT_EQ(loaded, kept);
+    EXPECT_EQ(30, kept->interval);
+    EXPECT_NE(COM_UTIL_OK, struct_meta_snapshot_load_file(&snapshot, TempPath("snapshotTest_missing.json").c_str()));
+    struct_meta_snapshot_unpin(reader);
+    struct_meta_snapshot_reader_detach(reader);
+    struct_meta_snapshot_dispose(&snapshot);
+    std::remove(path.c_str());
+}
+
+TEST(SnapshotTest, ReadersSeeWholeVersionsWhileWriterPublishes)
+{
+    struct_meta_snapshot snapshot; // [準備_正常系] - 複数の読み手スレッドを用意する。
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_init(&snapshot, &kConfigDescriptor, 4U));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_publish(&snapshot, NewConfig(0, "v")));
+    std::atomic<bool> done(false);
+    std::atomic<int> broken(0);
+    std::atomic<int> ready(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++)
+    {
+        threads.emplace_back([&snapshot, &done, &broken, &ready]() {
+            struct_meta_snapshot_reader *reader = nullptr;
+            if (struct_meta_snapshot_reader_attach(&snapshot, &reader) != COM_UTIL_OK)
+            {
+                broken++;
+                return;
+            }
+            ready++;
+            int last = 0;
+            while (!done.load())
+            {
+                const Config *config = static_cast<const Config *>(struct_meta_snapshot_pin(reader));
+                if ((config->doubled != config->interval * 2) || (config->interval < last) ||
+                    (std::strcmp(config->label, "v") != 0))
+                {
+                    broken++;
+                }
+                last = config->interval;
+                struct_meta_snapshot_unpin(reader);
+            }
+            struct_meta_snapshot_reader_detach(reader);
+        });
+    }
+    while (ready.load() < 4) // [手順_正常系] - 読み手がそろってから、並行して公開を繰り返す。
+    {
+        std::this_thread::yield();
+    }
+    for (int i = 1; i <= 2000; i++)
+    {
+        ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_publish(&snapshot, NewConfig(i, "v")));
+    }
+    done.store(true);
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(0, broken.load()); // [確認_正常系] - 読み手は欠けのない版を、公開の順に得ること。
+    EXPECT_EQ(0U, struct_meta_snapshot_reclaim(&snapshot));
+    struct_meta_snapshot_dispose(&snapshot);
+}
+
+TEST(SnapshotTest, RejectsInvalidArgumentsAndFullReaderTable)
+{
+    struct_meta_snapshot snapshot; // [準備_異常系]
+    struct_meta_snapshot_reader *first = nullptr;
+    struct_meta_snapshot_reader *second = nullptr;
+    // [手順_異常系] [確認_異常系] - 引数の不足と、空きの無い読み手の枠を拒否すること。
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, struct_meta_snapshot_init(nullptr, &kConfigDescriptor, 1U));
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, struct_meta_snapshot_init(&snapshot, nullptr, 1U));
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, struct_meta_snapshot_init(&snapshot, &kConfigDescriptor, 0U));
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, struct_meta_snapshot_publish(&snapshot, nullptr));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_init(&snapshot, &kConfigDescriptor, 1U));
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, struct_meta_snapshot_publish(&snapshot, nullptr));
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, struct_meta_snapshot_load_file(&snapshot, nullptr));
+    EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, struct_meta_snapshot_reader_attach(&snapshot, nullptr));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_snapshot_reader_attach(&snapshot, &first));
+    EXPECT_EQ(COM_UTIL_ERR_BUFFER_TOO_SMALL, struct_meta_snapshot_reader_attach(&snapshot, &second));
+    EXPECT_EQ(nullptr, second);
+    struct_meta_snapshot_reader_detach(first); // [確認_正常系] - 返却した枠は再び確保できること。
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_snapshot_reader_attach(&snapshot, &second));
+    EXPECT_EQ(nullptr, struct_meta_snapshot_pin(nullptr));
+    struct_meta_snapshot_reader_detach(second);
+    EXPECT_EQ(0U, struct_meta_snapshot_reclaim(nullptr));
+    struct_meta_snapshot_dispose(&snapshot);
+    struct_meta_snapshot_dispose(nullptr);
+}
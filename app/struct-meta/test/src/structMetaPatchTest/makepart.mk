@@ -5,6 +5,8 @@ TEST_SRCS := \
 ADD_SRCS += \
 	$(MYAPP_DIR)/prod/libsrc/struct_meta/access/access.c \
 	$(MYAPP_DIR)/prod/libsrc/struct_meta/access/path.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/name_index.c \
+	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/registry.c \
 	$(MYAPP_DIR)/prod/libsrc/struct_meta/meta/validate.c
 
 LIBS += mock_com_util mock_libc
@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include <struct_meta/access/access.h>
+#include <struct_meta/binary/binary.h>
+#include <struct_meta/json/json.h>
+#include <struct_meta/json/reader.h>
+#include <struct_meta/json/writer.h>
+#include <com_util/base/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace
+{
+enum Color
+{
+    COLOR_RED = 1,
+    COLOR_GREEN = -2
+};
+struct Wide
+{
+    int8_t i8;
+    uint8_t u8;
+    int16_t i16;
+    uint16_t u16[2];
+    bool flags[2];
+    uint8_t pad[2];
+    Color color;
+    int64_t i64;
+    uint64_t u64;
+};
+const struct_meta_field kWideFields[] = {
+    {"i8", STRUCT_META_FIELD_INT8, 0, offsetof(Wide, i8), sizeof(int8_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"u8", STRUCT_META_FIELD_UINT8, 0, offsetof(Wide, u8), sizeof(uint8_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"i16", STRUCT_META_FIELD_INT16, 0, offsetof(Wide, i16), sizeof(int16_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"u16", STRUCT_META_FIELD_UINT16, 0, offsetof(Wide, u16), sizeof(uint16_t), 2, 0, nullptr, nullptr, nullptr, 0},
+    {"flags", STRUCT_META_FIELD_BOOL, 0, offsetof(Wide, flags), sizeof(bool), 2, 0, nullptr, nullptr, nullptr, 0},
+    {"color", STRUCT_META_FIELD_ENUM, 0, offsetof(Wide, color), sizeof(Color), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"i64", STRUCT_META_FIELD_INT64, 0, offsetof(Wide, i64), sizeof(int64_t), 1, 0, nullptr, nullptr, nullptr, 0},
+    {"u64", STRUCT_META_FIELD_UINT64, 0, offsetof(Wide, u64), sizeof(uint64_t), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kWideDescriptor = {"Wide", sizeof(Wide), kWideFields, 8, nullptr};
+/* INT16 の要素サイズが型の幅と一致しない記述子。 */
+const struct_meta_field kBadWidthFields[] = {
+    {"i16", STRUCT_META_FIELD_INT16, 0, offsetof(Wide, i16), sizeof(int32_t), 1, 0, nullptr, nullptr, nullptr, 0},
+};
+const struct_meta_descriptor kBadWidthDescriptor = {"BadWidth", sizeof(Wide), kBadWidthFields, 1, nullptr};
+
+const char kExtremeJson[] = "{\"i8\":-128,\"u8\":255,\"i16\":-32768,\"u16\":[65535,0],\"flags\":[true,false],"
+                            "\"color\":-2,\"i64\":-9223372036854775808,\"u64\":18446744073709551615}";
+
+Wide MakeExtreme()
+{
+    Wide wide;
+    std::memset(&wide, 0, sizeof(wide));
+    wide.i8 = INT8_MIN;
+    wide.u8 = UINT8_MAX;
+    wide.i16 = INT16_MIN;
+    wide.u16[0] = UINT16_MAX;
+    wide.flags[0] = true;
+    wide.color = COLOR_GREEN;
+    wide.i64 = INT64_MIN;
+    wide.u64 = UINT64_MAX;
+    return wide;
+}
+
+int Decode(const std::string &text, Wide *wide)
+{
+    return struct_meta_json_decode_text(&kWideDescriptor, text.data(), text.size(), wide);
+}
+} // namespace
+
+TEST(WideKindTest, WritesExtremeValuesWithoutPrecisionLoss)
+{
+    Wide wide = MakeExtreme(); // [準備_正常系] - 各型の最小値と最大値を持つ構造体を用意する。
+    struct_meta_buffer buffer;
+    struct_meta_buffer_init(&buffer);
+    int ret = struct_meta_json_write_buffer(&kWideDescriptor, &wide, STRUCT_META_JSON_FORMAT_COMPACT,
+                                            &buffer); // [手順_正常系]
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 64 ビット整数の端の値も 10 進表記のまま書き出すこと。
+    EXPECT_EQ(std::string(kExtremeJson), std::string(reinterpret_cast<const char *>(buffer.data), buffer.length));
+    struct_meta_buffer_dispose(&buffer);
+}
+
+TEST(WideKindTest, EncodesWideIntegersLikeWriter)
+{
+    // [準備_正常系] - 2^53 前後と 16 桁以上の 64 ビット整数の組を用意する。
+    const int64_t signed_values[] = {INT64_MIN, INT64_MAX, INT64_C(9007199254740992), INT64_C(1234567890123450),
+                                     INT64_C(999999999999999), INT64_C(-1234567890123450)};
+    const uint64_t unsigned_values[] = {UINT64_MAX, UINT64_C(9007199254740992), UINT64_C(1234567890123450),
+                                        UINT64_C(1000000000000000), UINT64_C(999999999999999), 0U};
+    for (size_t i = 0; i < sizeof(signed_values) / sizeof(signed_values[0]); i++)
+    {
+        Wide wide;
+        std::memset(&wide, 0, sizeof(wide));
+        wide.i64 = signed_values[i];
+        wide.u64 = unsigned_values[i];
+        struct_meta_buffer buffer;
+        struct_meta_buffer_init(&buffer);
+        cJSON *json = nullptr;
+        // [手順_正常系] - cJSON 版と直接書き出しの両方でテキストにする。
+        ASSERT_EQ(COM_UTIL_OK, struct_meta_json_write_buffer(&kWideDescriptor, &wide, STRUCT_META_JSON_FORMAT_COMPACT,
+                                                             &buffer));
+        ASSERT_EQ(COM_UTIL_OK, struct_meta_json_encode(&kWideDescriptor, &wide, &json));
+        char *printed = cJSON_PrintUnformatted(json);
+        ASSERT_NE(nullptr, printed);
+        // [確認_正常系] - 指数表記にならず、直接書き出しとバイト単位で一致すること。
+        EXPECT_EQ(std::string(reinterpret_cast<const char *>(buffer.data), buffer.length), std::string(printed))
+            << "i64=" << signed_values[i] << " u64=" << unsigned_values[i];
+        cJSON_free(printed);
+        cJSON_Delete(json);
+        struct_meta_buffer_dispose(&buffer);
+    }
+}
+
+TEST(WideKindTest, ReadsExtremeValuesExactly)
+{
+    Wide actual; // [準備_正常系] - 各型の最小値と最大値を表す JSON テキストを用意する。
+    std::memset(&actual, 0x5A, sizeof(actual));
+    int ret = Decode(kExtremeJson, &actual); // [手順_正常系]
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - double を経由せずに、すべての値を正確に復元すること。
+    EXPECT_EQ(INT8_MIN, actual.i8);
+    EXPECT_EQ(UINT8_MAX, actual.u8);
+    EXPECT_EQ(INT16_MIN, actual.i16);
+    EXPECT_EQ(UINT16_MAX, actual.u16[0]);
+    EXPECT_EQ(0U, actual.u16[1]);
+    EXPECT_TRUE(actual.flags[0]);
+    EXPECT_FALSE(actual.flags[1]);
+    EXPECT_EQ(COLOR_GREEN, actual.color);
+    EXPECT_EQ(INT64_MIN, actual.i64);
+    EXPECT_EQ(UINT64_MAX, actual.u64);
+}
+
+TEST(WideKindTest, AcceptsIntegralNumbersWithFractionOrExponent)
+{
+    Wide actual; // [準備_正常系] - 小数点や指数を含むが、整数を表す数値を用意する。
+    std::memset(&actual, 0, sizeof(actual));
+    int ret = Decode("{\"i16\":1.5e2,\"u64\":2.0,\"color\":1}", &actual); // [手順_正常系]
+    EXPECT_EQ(COM_UTIL_OK, ret); // [確認_正常系] - 整数として正確に表せる値は受け付けること。
+    EXPECT_EQ(150, actual.i16);
+    EXPECT_EQ(2U, actual.u64);
+    EXPECT_EQ(COLOR_RED, actual.color);
+}
+
+TEST(WideKindTest, RejectsValuesOutsideFieldRange)
+{
+    const char *const inputs[] = {
+        // [準備_異常系] - 型の範囲外の値、小数、bool 以外の真偽値を用意する。
+        "{\"i8\":128}",
+        "{\"u8\":-1}",
+        "{\"i16\":1.5}",
+        "{\"i64\":9223372036854775808}",
+        "{\"u64\":18446744073709551616}",
+        "{\"flags\":[1,0]}",
+    };
+    for (const char *input : inputs)
+    {
+        Wide actual;
+        std::memset(&actual, 0, sizeof(actual));
+        int ret = Decode(input, &actual); // [手順_異常系]
+        EXPECT_EQ(COM_UTIL_ERR_INVALID_ARGUMENT, ret) << input; // [確認_異常系] - 丸めずにエラーとすること。
+    }
+}
+
+TEST(WideKindTest, BinaryRoundTripsAndNormalizesBool)
+{
+    Wide source = MakeExtreme(); // [準備_正常系] - 0 と 1 以外のバイトを持つ bool を含む構造体を用意する。
+    unsigned char raw_true = 2U;
+    std::memcpy(&source.flags[1], &raw_true, 1U);
+    Wide actual;
+    std::memset(&actual, 0, sizeof(actual));
+    struct_meta_buffer buffer;
+    struct_meta_buffer_init(&buffer);
+    size_t consumed = 0;
+    int encoded = struct_meta_binary_encode(&kWideDescriptor, &source, &buffer); // [手順_正常系]
+    int decoded = struct_meta_binary_decode(&kWideDescriptor, buffer.data, buffer.length, &actual, &consumed);
+    EXPECT_EQ(COM_UTIL_OK, encoded); // [確認_正常系] - 値を復元し、bool は 1 バイトの 0 または 1 として書くこと。
+    EXPECT_EQ(COM_UTIL_OK, decoded);
+    EXPECT_EQ(STRUCT_META_BINARY_HEADER_SIZE + 1U + 1U + 2U + 4U + 2U + sizeof(Color) + 8U + 8U, buffer.length);
+    EXPECT_EQ(buffer.length, consumed);
+    EXPECT_EQ(INT8_MIN, actual.i8);
+    EXPECT_EQ(UINT16_MAX, actual.u16[0]);
+    unsigned char actual_flag = 0U;
+    std::memcpy(&actual_flag, &actual.flags[1], 1U);
+    EXPECT_EQ(1U, actual_flag);
+    EXPECT_EQ(COLOR_GREEN, actual.color);
+    EXPECT_EQ(INT64_MIN, actual.i64);
+    EXPECT_EQ(UINT64_MAX, actual.u64);
+    struct_meta_buffer_dispose(&buffer);
+}
+
+TEST(WideKindTest, PathHandleChecksIntegerRange)
+{
+    Wide wide = MakeExtreme(); // [準備_正常系] - 16 ビット整数と列挙のハンドルを用意する。
+    struct_meta_path_handle i16;
+    struct_meta_path_handle color;
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_path_compile(&kWideDescriptor, "i16", &i16));
+    ASSERT_EQ(COM_UTIL_OK, struct_meta_path_compile(&kWideDescriptor, "color", &color));
+    int too_large = struct_meta_path_set_int64(&i16, &wide, 40000); // [手順_正常系]
+    int stored = struct_meta_path_set_int64(&i16, &wide, -5);
+    int64_t value = 0;
+    int loaded = struct_meta_path_get_int64(&i16, &wide, &value);
+    uint64_t unsigned_value = 0;
+    int negative = struct_meta_path_get_uint64(&color, &wide, &unsigned_value);
+    EXPECT_EQ(COM_UTIL_ERR_OUT_OF_RANGE, too_large); // [確認_正常系] - 範囲外の値は書き込まず、範囲内は読み書きする。
+    EXPECT_EQ(COM_UTIL_OK, stored);
+    EXPECT_EQ(COM_UTIL_OK, loaded);
+    EXPECT_EQ(-5, value);
+    EXPECT_EQ(-5, wide.i16);
+    EXPECT_EQ(COM_UTIL_ERR_OUT_OF_RANGE, negative);
+}
+
+TEST(WideKindTest, ValidateRejectsMismatchedWidth)
+{
+    // [準備_異常系] - INT16 の要素サイズを 4 バイトとした記述子を用意する。
+    int ret = struct_meta_descriptor_validate(&kBadWidthDescriptor); // [手順_異常系]
+    EXPECT_EQ(COM_UTIL_ERR_CORRUPT_DESCRIPTOR, ret); // [確認_異常系] - 種別と要素サイズの不一致を検出すること。
+    EXPECT_EQ(COM_UTIL_OK, struct_meta_descriptor_validate(&kWideDescriptor));
+}